@@ -1,6 +1,7 @@
 #include "MainWindow.h"
 #include <QApplication>
 #include <QBoxLayout>
+#include <QCloseEvent>
 #include <QDebug>
 #include <QFile>
 #include <QFileInfo>
@@ -10,20 +11,34 @@
 #include <QMainWindow>
 #include <QStackedWidget>
 #include <QStringList>
+#include <QTimer>
 #include <QWidget>
+#include "cache/PDFCacheManager.h"
+#include "managers/DocumentPrewarmer.h"
 #include "managers/FileTypeIconManager.h"
 #include "managers/StyleManager.h"
 #include "model/RenderModel.h"
+#include "plugin/PluginManager.h"
 #include "ui/managers/WelcomeScreenManager.h"
 #include "ui/widgets/WelcomeWidget.h"
 #include "utils/LoggingMacros.h"
+#include "utils/StartupProfiler.h"
+
+namespace {
+// 会话恢复的空闲水合节奏：启动稳定后开始，按固定间隔逐个拉起
+// 后台标签页
+constexpr int HYDRATE_INITIAL_DELAY_MS = 3000;
+constexpr int HYDRATE_INTERVAL_MS = 1500;
+}  // namespace
 
 MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
     LOG_DEBUG("MainWindow: Starting initialization...");
     // Initialize with StyleManager's default theme to maintain consistency
+    StartupProfiler::instance().beginPhase(QStringLiteral("StyleManager apply"));
     QString defaultTheme =
         (STYLE.currentTheme() == Theme::Light) ? "light" : "dark";
     applyTheme(defaultTheme);
+    StartupProfiler::instance().endPhase(QStringLiteral("StyleManager apply"));
     LOG_DEBUG("MainWindow: Theme applied successfully ({})",
               defaultTheme.toStdString());
 
@@ -35,7 +50,10 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
     LOG_DEBUG("MainWindow: Controllers initialized");
     initWelcomeScreen();
     LOG_DEBUG("MainWindow: Welcome screen initialized");
+    StartupProfiler::instance().beginPhase(
+        QStringLiteral("Widget construction"));
     initContent();
+    StartupProfiler::instance().endPhase(QStringLiteral("Widget construction"));
     LOG_DEBUG("MainWindow: Content initialized");
 
     initConnection();
@@ -46,7 +64,11 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
     // 启动异步初始化以避免阻塞UI
     if (recentFilesManager) {
         try {
+            StartupProfiler::instance().beginPhase(
+                QStringLiteral("RecentFilesManager async start"));
             recentFilesManager->initializeAsync();
+            StartupProfiler::instance().endPhase(
+                QStringLiteral("RecentFilesManager async start"));
             LOG_DEBUG("MainWindow: Async initialization started");
         } catch (const std::exception& e) {
             LOG_WARNING("MainWindow: Failed to start async initialization: {}",
@@ -62,6 +84,25 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
             "initialization");
     }
 
+    // 可选的启动预热：UI就绪后在低优先级线程推测性打开最近文档，
+    // 把首页渲染和缩略图条写进持久缓存
+    m_documentPrewarmer = new DocumentPrewarmer(this);
+    m_documentPrewarmer->prewarmTopRecent(recentFilesManager);
+
+    // 插件注册走清单缓存（mtime校验，热缓存下每个文件只有一次stat），
+    // 这里不加载任何动态库；插件首次被访问时才按需加载
+    StartupProfiler::instance().beginPhase(
+        QStringLiteral("PluginManager scan"));
+    PluginManager::instance().scanForPlugins();
+    StartupProfiler::instance().endPhase(QStringLiteral("PluginManager scan"));
+
+    // 会话恢复：只有活动标签页立即加载，其余以占位标签页恢复，
+    // 首次激活或空闲时再水合，启动耗时是一份文档的加载而不是N份
+    StartupProfiler::instance().beginPhase(QStringLiteral("Session restore"));
+    m_sessionManager = new SessionManager(this);
+    restoreSession();
+    StartupProfiler::instance().endPhase(QStringLiteral("Session restore"));
+
     LOG_INFO("MainWindow: Initialization completed successfully");
 }
 
@@ -134,6 +175,9 @@ void MainWindow::initContent() {
 
 void MainWindow::initModel() {
     renderModel = new RenderModel(this->logicalDpiX(), this->logicalDpiY());
+    // 进程级共享缓存：条目按文档内容哈希分命名空间，多标签页乃至
+    // 同一份文件的重复打开共享同一组渲染结果和同一个LRU预算
+    renderModel->setCacheManager(&PDFCacheManager::shared());
     documentModel = new DocumentModel(renderModel);
     pageModel = new PageModel(renderModel);
     recentFilesManager = new RecentFilesManager(this);
@@ -367,34 +411,31 @@ void MainWindow::onCurrentDocumentChangedForOutline(int index) {
     PDFOutlineModel* currentOutlineModel = viewWidget->getCurrentOutlineModel();
     sideBar->setOutlineModel(currentOutlineModel);
 
-    // 设置缩略图文档
+    // 设置缩略图文档。推迟到事件循环空闲时执行，
+    // 让首页渲染先占用渲染线程池
     if (documentModel && index >= 0) {
         Poppler::Document* document = documentModel->getDocument(index);
         if (document) {
-            // 创建shared_ptr包装
-            std::shared_ptr<Poppler::Document> sharedDoc(
-                document, [](Poppler::Document*) {
-                    // 不删除，因为DocumentModel管理生命周期
-                });
-            sideBar->setDocument(sharedDoc);
+            QTimer::singleShot(0, this, [this, document]() {
+                // 创建shared_ptr包装
+                std::shared_ptr<Poppler::Document> sharedDoc(
+                    document, [](Poppler::Document*) {
+                        // 不删除，因为DocumentModel管理生命周期
+                    });
+                sideBar->setDocument(sharedDoc);
+            });
         }
     }
 
-    // 连接目录点击跳转信号
-    if (sideBar->getOutlineWidget()) {
-        // 断开之前的连接
-        disconnect(sideBar->getOutlineWidget(),
-                   &PDFOutlineWidget::pageNavigationRequested, nullptr,
-                   nullptr);
-
-        // 连接到当前PDF查看器的页面跳转
-        connect(sideBar->getOutlineWidget(),
-                &PDFOutlineWidget::pageNavigationRequested, this,
-                [this](int pageNumber) {
-                    // 通过ViewWidget获取当前的PDF查看器并跳转页面
-                    viewWidget->goToPage(pageNumber);
-                });
-    }
+    // 连接目录点击跳转信号：经SideBar转发，目录组件本身可能
+    // 尚未惰性构建
+    disconnect(sideBar, &SideBar::outlineNavigationRequested, nullptr,
+               nullptr);
+    connect(sideBar, &SideBar::outlineNavigationRequested, this,
+            [this](int pageNumber) {
+                // 通过ViewWidget获取当前的PDF查看器并跳转页面
+                viewWidget->goToPage(pageNumber);
+            });
 }
 
 void MainWindow::onThumbnailPageClicked(int pageNumber) {
@@ -482,6 +523,26 @@ void MainWindow::onThemeToggleRequested() {
     applyTheme(currentTheme);
 }
 
+void MainWindow::handleInstanceActivation(const QStringList& filePaths) {
+    // 先把窗口带到前台：用户在文件管理器里双击时，期待的是现有窗口弹出
+    if (isMinimized()) {
+        setWindowState(windowState() & ~Qt::WindowMinimized);
+    }
+    show();
+    raise();
+    activateWindow();
+
+    if (!documentController) {
+        return;
+    }
+    for (const QString& filePath : filePaths) {
+        if (!documentController->openDocument(filePath)) {
+            LOG_WARNING("Failed to open handed-off file: {}",
+                        filePath.toStdString());
+        }
+    }
+}
+
 void MainWindow::onOpenRecentFileRequested(const QString& filePath) {
     // 通过DocumentController打开最近文件
     if (documentController) {
@@ -651,6 +712,71 @@ void MainWindow::onWelcomeOpenFileRequested() {
     }
 }
 
+void MainWindow::restoreSession() {
+    if (!m_sessionManager->isRestoreEnabled() || !documentController) {
+        return;
+    }
+
+    const SessionManager::SessionState state = m_sessionManager->loadSession();
+    if (state.tabs.isEmpty()) {
+        return;
+    }
+
+    LOG_INFO("MainWindow: restoring session with {} tabs",
+             state.tabs.size());
+
+    // 水合完成后恢复保存的页位
+    connect(documentModel, &DocumentModel::documentOpened, this,
+            [this](int index, const QString&) {
+                const QString path = documentModel->getDocumentFilePath(index);
+                int page = m_sessionManager->savedPage(path);
+                if (page >= 0) {
+                    viewWidget->goToPageInDocument(index, page);
+                }
+            });
+
+    // 先按会话顺序挂起全部标签页（只建占位，不加载），再水合活动页
+    QStringList paths;
+    for (const auto& tab : state.tabs) {
+        paths.append(tab.first);
+    }
+    documentModel->queuePendingRestore(paths);
+
+    int active = qBound(0, state.activeIndex, int(state.tabs.size()) - 1);
+    documentController->openDocument(state.tabs[active].first);
+
+    // 其余标签页在启动稳定后逐个空闲水合
+    QTimer::singleShot(HYDRATE_INITIAL_DELAY_MS, this,
+                       &MainWindow::hydrateNextPendingTab);
+}
+
+void MainWindow::hydrateNextPendingTab() {
+    if (!documentModel || !documentController) {
+        return;
+    }
+    const QString next = documentModel->nextPendingRestore();
+    if (next.isEmpty()) {
+        return;
+    }
+    documentController->openDocument(next);
+    QTimer::singleShot(HYDRATE_INTERVAL_MS, this,
+                       &MainWindow::hydrateNextPendingTab);
+}
+
+void MainWindow::closeEvent(QCloseEvent* event) {
+    if (m_sessionManager && viewWidget) {
+        m_sessionManager->saveSession(viewWidget->sessionSnapshot(),
+                                      viewWidget->currentTabIndex());
+    }
+    QMainWindow::closeEvent(event);
+}
+
+void MainWindow::paintEvent(QPaintEvent* event) {
+    QMainWindow::paintEvent(event);
+    // 首次调用记录"first paint"并输出启动阶段报告，之后为空操作
+    StartupProfiler::instance().markFirstPaint();
+}
+
 void MainWindow::handleActionExecuted(ActionMap id) {
     switch (id) {
         case ActionMap::fullScreen:
@@ -7,7 +7,9 @@
 #include "controller/PageController.h"
 #include "controller/tool.hpp"
 #include "factory/WidgetFactory.h"
+#include "managers/DocumentPrewarmer.h"
 #include "managers/RecentFilesManager.h"
+#include "managers/SessionManager.h"
 #include "managers/StyleManager.h"
 #include "model/DocumentModel.h"
 #include "model/PageModel.h"
@@ -28,6 +30,15 @@ public:
     MainWindow(QWidget* parent = nullptr);
     ~MainWindow() noexcept;
 
+public slots:
+    // 单实例激活：提升窗口并打开递交过来的文件（可为空，仅提升窗口）
+    void handleInstanceActivation(const QStringList& filePaths);
+
+protected:
+    void closeEvent(QCloseEvent* event) override;
+    // 首帧绘制打点（启动阶段报告的终点），之后每次调用都是空操作
+    void paintEvent(QPaintEvent* event) override;
+
 private slots:
     void applyTheme(const QString& theme);
     void onDocumentOperationCompleted(ActionMap action, bool success);
@@ -51,6 +62,9 @@ private slots:
     void onWelcomeNewFileRequested();
     void onWelcomeOpenFileRequested();
 
+    // 会话恢复：空闲时水合下一个挂起的标签页
+    void hydrateNextPendingTab();
+
 private:
     void initWindow();
     void initContent();
@@ -59,6 +73,7 @@ private:
     void initConnection();
     void initWelcomeScreen();
     void initWelcomeScreenConnections();
+    void restoreSession();
 
     MenuBar* menuBar;
     ToolBar* toolBar;
@@ -82,6 +97,8 @@ private:
     RenderModel* renderModel;
 
     RecentFilesManager* recentFilesManager;
+    DocumentPrewarmer* m_documentPrewarmer;
+    SessionManager* m_sessionManager;
 
     // Theme state tracking
     QString m_currentAppliedTheme;
@@ -0,0 +1,206 @@
+#include "DiskRenderCache.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QStandardPaths>
+#include <algorithm>
+#include "utils/LoggingMacros.h"
+
+namespace {
+
+// Raw pixel file layout: header followed by the untouched QImage bits.
+// Keeping the pixels uncompressed is what makes the mmap read path free.
+struct EntryHeader {
+    quint32 magic;
+    quint32 version;
+    qint32 width;
+    qint32 height;
+    qint32 bytesPerLine;
+    qint32 format;  // QImage::Format
+};
+
+constexpr quint32 ENTRY_MAGIC = 0x52444352;  // "RDCR"
+constexpr quint32 ENTRY_VERSION = 1;
+constexpr qint64 DEFAULT_MAX_BYTES = 256 * 1024 * 1024;  // 256MB
+
+}  // namespace
+
+DiskRenderCache::DiskRenderCache(const QString& cacheDir)
+    : m_maxBytes(DEFAULT_MAX_BYTES) {
+    m_cacheDir = cacheDir.isEmpty()
+                     ? QStandardPaths::writableLocation(
+                           QStandardPaths::CacheLocation) +
+                           "/render-cache"
+                     : cacheDir;
+    QDir().mkpath(m_cacheDir);
+}
+
+QString DiskRenderCache::hashForFile(const QString& filePath) {
+    QFileInfo info(filePath);
+    if (!info.exists()) {
+        return QString();
+    }
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(filePath.toUtf8());
+    hash.addData(QByteArray::number(info.size()));
+    hash.addData(
+        QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+void DiskRenderCache::setDocumentHash(const QString& documentHash) {
+    QMutexLocker locker(&m_mutex);
+    m_documentHash = documentHash;
+    if (!documentHash.isEmpty()) {
+        QDir().mkpath(m_cacheDir + "/" + documentHash);
+    }
+}
+
+QString DiskRenderCache::entryPath(int pageNumber, const QSize& size,
+                                   int rotation) const {
+    QString key = QString("%1_%2x%3_%4")
+                      .arg(pageNumber)
+                      .arg(size.width())
+                      .arg(size.height())
+                      .arg(rotation);
+    return m_cacheDir + "/" + m_documentHash + "/" + key + ".raw";
+}
+
+bool DiskRenderCache::store(int pageNumber, const QSize& size, int rotation,
+                            const QImage& image) {
+    if (m_documentHash.isEmpty() || image.isNull()) {
+        return false;
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    QFile file(entryPath(pageNumber, size, rotation));
+    if (!file.open(QIODevice::WriteOnly)) {
+        LOG_WARNING("DiskRenderCache: Cannot write {}",
+                    file.fileName().toStdString());
+        return false;
+    }
+
+    EntryHeader header;
+    header.magic = ENTRY_MAGIC;
+    header.version = ENTRY_VERSION;
+    header.width = image.width();
+    header.height = image.height();
+    header.bytesPerLine = image.bytesPerLine();
+    header.format = static_cast<qint32>(image.format());
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(image.constBits()),
+               image.sizeInBytes());
+    file.close();
+
+    return true;
+}
+
+QImage DiskRenderCache::load(int pageNumber, const QSize& size, int rotation) {
+    if (m_documentHash.isEmpty()) {
+        return QImage();
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    QString path = entryPath(pageNumber, size, rotation);
+    // The QFile must outlive the QImage that wraps the mapped bytes; it
+    // is released by the cleanup function when the image is destroyed
+    auto* file = new QFile(path);
+    if (!file->open(QIODevice::ReadOnly) ||
+        file->size() < static_cast<qint64>(sizeof(EntryHeader))) {
+        delete file;
+        return QImage();
+    }
+
+    uchar* mapped = file->map(0, file->size());
+    if (!mapped) {
+        delete file;
+        return QImage();
+    }
+
+    const auto* header = reinterpret_cast<const EntryHeader*>(mapped);
+    if (header->magic != ENTRY_MAGIC || header->version != ENTRY_VERSION ||
+        header->width <= 0 || header->height <= 0 ||
+        file->size() != static_cast<qint64>(sizeof(EntryHeader)) +
+                            static_cast<qint64>(header->bytesPerLine) *
+                                header->height) {
+        LOG_WARNING("DiskRenderCache: Corrupt entry {}", path.toStdString());
+        delete file;
+        QFile::remove(path);
+        return QImage();
+    }
+
+    // Zero-copy: the QImage reads straight out of the mapped file
+    return QImage(
+        mapped + sizeof(EntryHeader), header->width, header->height,
+        header->bytesPerLine, static_cast<QImage::Format>(header->format),
+        [](void* f) { delete static_cast<QFile*>(f); }, file);
+}
+
+bool DiskRenderCache::contains(int pageNumber, const QSize& size,
+                               int rotation) const {
+    if (m_documentHash.isEmpty()) {
+        return false;
+    }
+    QMutexLocker locker(&m_mutex);
+    return QFile::exists(entryPath(pageNumber, size, rotation));
+}
+
+qint64 DiskRenderCache::totalBytes() const {
+    QMutexLocker locker(&m_mutex);
+    qint64 total = 0;
+    QDirIterator it(m_cacheDir, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        total += it.fileInfo().size();
+    }
+    return total;
+}
+
+void DiskRenderCache::prune() {
+    QMutexLocker locker(&m_mutex);
+
+    QList<QFileInfo> entries;
+    qint64 total = 0;
+    QDirIterator it(m_cacheDir, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        entries.append(it.fileInfo());
+        total += it.fileInfo().size();
+    }
+    if (total <= m_maxBytes) {
+        return;
+    }
+
+    // Oldest-first eviction; lastRead would be better but is not
+    // tracked reliably on all filesystems
+    std::sort(entries.begin(), entries.end(),
+              [](const QFileInfo& a, const QFileInfo& b) {
+                  return a.lastModified() < b.lastModified();
+              });
+
+    for (const QFileInfo& info : entries) {
+        if (total <= m_maxBytes) {
+            break;
+        }
+        total -= info.size();
+        QFile::remove(info.absoluteFilePath());
+    }
+    LOG_DEBUG("DiskRenderCache: Pruned to {} bytes", total);
+}
+
+void DiskRenderCache::clear() {
+    QMutexLocker locker(&m_mutex);
+    QDir dir(m_cacheDir);
+    dir.removeRecursively();
+    QDir().mkpath(m_cacheDir);
+    if (!m_documentHash.isEmpty()) {
+        QDir().mkpath(m_cacheDir + "/" + m_documentHash);
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QImage>
+#include <QMutex>
+#include <QSize>
+#include <QString>
+
+/**
+ * On-disk render cache tier.
+ *
+ * Stores rendered thumbnails and low-res page previews as raw pixel
+ * files keyed by (document hash, page, size, rotation) so they survive
+ * restarts. Files are read back through QFile::map, so a cache hit
+ * costs an mmap plus a QImage wrapper around the mapped bytes — no
+ * decode and no buffer copy until the image is actually painted.
+ */
+class DiskRenderCache {
+public:
+    explicit DiskRenderCache(const QString& cacheDir = QString());
+
+    // All entries are namespaced by the current document's content hash
+    void setDocumentHash(const QString& documentHash);
+    QString documentHash() const { return m_documentHash; }
+
+    // Stable identity for a document file (path + size + mtime). Cheap
+    // to compute and shared by every cache client, so entries written
+    // by one (e.g. the startup pre-warmer) are readable by the rest
+    static QString hashForFile(const QString& filePath);
+
+    bool store(int pageNumber, const QSize& size, int rotation,
+               const QImage& image);
+    QImage load(int pageNumber, const QSize& size, int rotation);
+    bool contains(int pageNumber, const QSize& size, int rotation) const;
+
+    // Size management
+    void setMaxBytes(qint64 maxBytes) { m_maxBytes = maxBytes; }
+    qint64 maxBytes() const { return m_maxBytes; }
+    qint64 totalBytes() const;
+    void prune();  // Evict oldest files until under m_maxBytes
+    void clear();
+
+    QString cacheDir() const { return m_cacheDir; }
+
+private:
+    QString entryPath(int pageNumber, const QSize& size, int rotation) const;
+
+    QString m_cacheDir;
+    QString m_documentHash;
+    qint64 m_maxBytes;
+    mutable QMutex m_mutex;
+};
@@ -1,10 +1,18 @@
 #include "PDFCacheManager.h"
 #include <QApplication>
+#include <QBuffer>
 #include <QDateTime>
 #include <QMutexLocker>
 #include <QPixmap>
+#include <QPointer>
 // #include <QtConcurrent> // Not available in this MSYS2 setup
+#include "managers/MemoryGovernor.h"
+#include "managers/RenderScheduler.h"
+#include "model/DocumentSnapshot.h"
+#include "model/PageMutationPlan.h"
+#include "utils/LatencyMetrics.h"
 #include "utils/LoggingMacros.h"
+#include "utils/RenderPolicy.h"
 
 // CacheItem Implementation
 qint64 CacheItem::calculateSize() const {
@@ -14,7 +22,14 @@ qint64 CacheItem::calculateSize() const {
         case CacheItemType::RenderedPage:
         case CacheItemType::Thumbnail:
         case CacheItemType::PageImage: {
-            if (data.canConvert<QPixmap>()) {
+            // Exact-type checks first: canConvert<QPixmap>() is true
+            // for a QImage variant too, and the conversion must not
+            // run off the GUI thread
+            if (data.userType() == QMetaType::QImage) {
+                size += data.value<QImage>().sizeInBytes();
+            } else if (data.userType() == QMetaType::QByteArray) {
+                size += data.toByteArray().size();  // Compressed tier
+            } else if (data.canConvert<QPixmap>()) {
                 QPixmap pixmap = data.value<QPixmap>();
                 size += pixmap.width() * pixmap.height() * 4;  // 32-bit ARGB
             }
@@ -105,6 +120,7 @@ PDFCacheManager::PDFCacheManager(QObject* parent)
       m_itemMaxAge(30 * 60 * 1000)  // 30 minutes
       ,
       m_evictionPolicy("LRU"),
+      m_derivedQualityThreshold(0.5),
       m_lowPriorityWeight(0.1),
       m_normalPriorityWeight(1.0),
       m_highPriorityWeight(10.0),
@@ -114,11 +130,12 @@ PDFCacheManager::PDFCacheManager(QObject* parent)
       m_accessCount(0),
       m_preloadingEnabled(true),
       m_preloadingStrategy("adaptive"),
-      m_preloadThreadPool(new QThreadPool(this)),
+      m_preloadThreadPool(RenderScheduler::instance().pool()),
+      m_diskCache(new DiskRenderCache()),
       m_maintenanceTimer(new QTimer(this)),
       m_settings(new QSettings("SAST", "Readium-Cache", this)) {
-    // Configure thread pool
-    m_preloadThreadPool->setMaxThreadCount(2);
+    // Preload tasks run on the shared render pool at Background priority
+    // instead of a private two-thread pool
 
     // Setup maintenance timer
     m_maintenanceTimer->setInterval(60000);  // 1 minute
@@ -129,15 +146,71 @@ PDFCacheManager::PDFCacheManager(QObject* parent)
     // Load settings
     loadSettings();
 
+    // The governor overrides m_maxMemoryUsage with this cache's share
+    // of the global budget
+    m_governorId = MemoryGovernor::instance().registerConsumer(
+        "render-cache", [this]() { return getCurrentMemoryUsage(); },
+        [this]() { return getHitRate(); },
+        [this](qint64 budget) { setMaxMemoryUsage(budget); },
+        [this]() { evictLeastUsedItems(m_maxItems); });
+
     LOG_DEBUG(
         "PDFCacheManager initialized with max memory: {} bytes, max items: {}",
         m_maxMemoryUsage, m_maxItems);
 }
 
+PDFCacheManager& PDFCacheManager::shared() {
+    static PDFCacheManager instance;
+    return instance;
+}
+
+// Hashing reads the file; memoize per path so resolving the namespace
+// on every render costs a hash lookup. DocumentVersionBus drops the
+// entry when the file is modified on disk, so the next resolution
+// hashes the new content instead of serving the stale namespace
+namespace {
+QMutex g_namespaceMutex;
+QHash<QString, QString> g_namespaceByPath;
+}  // namespace
+
+QString PDFCacheManager::namespaceForDocument(Poppler::Document* document) {
+    if (!document) {
+        return QString();
+    }
+    auto snapshot = DocumentSnapshot::forDocument(document);
+    if (!snapshot) {
+        return QString();
+    }
+
+    QMutexLocker locker(&g_namespaceMutex);
+    auto it = g_namespaceByPath.constFind(snapshot->filePath());
+    if (it != g_namespaceByPath.constEnd()) {
+        return *it;
+    }
+    const QString hash = DiskRenderCache::hashForFile(snapshot->filePath());
+    g_namespaceByPath.insert(snapshot->filePath(), hash);
+    return hash;
+}
+
+void PDFCacheManager::forgetNamespaceForPath(const QString& filePath) {
+    QMutexLocker locker(&g_namespaceMutex);
+    g_namespaceByPath.remove(filePath);
+}
+
+PDFCacheManager::~PDFCacheManager() {
+    MemoryGovernor::instance().unregisterConsumer(m_governorId);
+    delete m_diskCache;
+    m_diskCache = nullptr;
+}
+
 bool PDFCacheManager::insert(const QString& key, const QVariant& data,
                              CacheItemType type, CachePriority priority,
                              int pageNumber) {
-    QMutexLocker locker(&m_cacheMutex);
+    QWriteLocker locker(&m_cacheLock);
+
+    // Fold in the touches concurrent readers noted since the last
+    // write, so the knownHot check below sees them
+    drainPendingTouchesLocked();
 
     CacheItem item;
     item.data = data;
@@ -145,48 +218,145 @@ bool PDFCacheManager::insert(const QString& key, const QVariant& data,
     item.priority = priority;
     item.pageNumber = pageNumber;
     item.key = key;
+    // Namespaced keys carry the document hash before the first '/';
+    // per-instance (legacy) keys have no namespace
+    const int slash = key.indexOf(QLatin1Char('/'));
+    item.documentHash = slash > 0 ? key.left(slash) : QString();
     item.memorySize = item.calculateSize();
 
-    // Check if we need to make room
+    // 2Q-style admission for pixel entries: a fresh render starts
+    // probationary unless its key was evicted recently (a ghost hit
+    // means the eviction threw out something still wanted) or its page
+    // has a record of repeat access. Only a re-access in get()
+    // promotes it, so one linear skim through a document cycles
+    // through the probationary segment and never touches the resident
+    // working set
+    const bool pixelEntry = type == CacheItemType::RenderedPage ||
+                            type == CacheItemType::PageImage ||
+                            type == CacheItemType::Thumbnail;
+    if (pixelEntry && (priority == CachePriority::Low ||
+                       priority == CachePriority::Normal)) {
+        const bool ghostHit = m_ghostKeys.remove(key);
+        const bool knownHot =
+            m_pageTouches.value(pageTouchKey(item)) >= PROMOTE_TOUCHES;
+        item.probationary = !ghostHit && !knownHot;
+    }
+
+    // Check if we need to make room: probationary entries go first (in
+    // FIFO order, the 2Q discipline), the scored eviction only when no
+    // probation is left to shed
     while (m_cache.size() >= m_maxItems ||
            (getCurrentMemoryUsage() + item.memorySize) > m_maxMemoryUsage) {
-        if (!evictLeastUsedItems(1)) {
-            LOG_WARNING("PDFCacheManager: Failed to evict items, cache full");
+        if (evictProbationaryItemLocked()) {
+            continue;
+        }
+        if (!evictLeastUsedItemsLocked(1)) {
+            // Fires for every rejected insert while the cache is
+            // saturated; rate-limit to one line per second
+            LOG_WARNING_EVERY_MS(
+                1000, "PDFCacheManager: Failed to evict items, cache full");
             return false;
         }
     }
 
     m_cache[key] = item;
 
-    LOG_DEBUG("PDFCacheManager: Cached item {} type: {} size: {} bytes",
-              key.toStdString(), static_cast<int>(type), item.memorySize);
+    // Fast path: with debug filtered out this costs a branch, not a
+    // QString conversion per cached tile
+    LOG_FAST_DEBUG("PDFCacheManager: Cached item {} type: {} size: {} bytes",
+                   key.toStdString(), static_cast<int>(type), item.memorySize);
 
     return true;
 }
 
 QVariant PDFCacheManager::get(const QString& key) {
-    QMutexLocker locker(&m_cacheMutex);
+    LATENCY_SAMPLE("cache.lookup");
+
+    // Fast path under the shared lock: any number of consumer threads
+    // look up concurrently. Per-entry bookkeeping is atomic, promotion
+    // is deferred to the next insert and statistics are lock-free, so
+    // a hot-tier hit never serializes against other readers. Signals
+    // fire after the lock is dropped — a direct-connected slot is free
+    // to call back into the cache
+    {
+        QReadLocker locker(&m_cacheLock);
+        auto it = m_cache.constFind(key);
+        if (it == m_cache.constEnd()) {
+            locker.unlock();
+            updateStatistics(false);
+            emit cacheMiss(key);
+            return QVariant();
+        }
+        const bool compressed =
+            it->data.userType() == QMetaType::QByteArray &&
+            (it->type == CacheItemType::RenderedPage ||
+             it->type == CacheItemType::Thumbnail ||
+             it->type == CacheItemType::PageImage);
+        if (!compressed) {
+            it->updateAccess();
+            // Re-access is the 2Q promotion signal: the entry leaves
+            // probation, and the page's touch record lets future
+            // renders of the same page skip probation on admission
+            it->probationary.store(false, std::memory_order_relaxed);
+            recordPendingTouch(*it);
+            QVariant data = it->data;
+            locker.unlock();
+            updateStatistics(true);
+            emit cacheHit(key, 0);  // TODO: measure actual access time
+            return data;
+        }
+    }
 
-    auto it = m_cache.find(key);
-    if (it != m_cache.end()) {
-        it->updateAccess();
-        updateStatistics(true);
-        emit cacheHit(key, 0);  // TODO: measure actual access time
-        return it->data;
+    // Cold-tier entry: inflating rewrites the stored variant, which
+    // needs the exclusive lock. Rare by construction — an entry only
+    // sits compressed after going untouched past the demotion age
+    QVariant data;
+    bool hit = false;
+    {
+        QWriteLocker locker(&m_cacheLock);
+        auto it = m_cache.find(key);
+        if (it != m_cache.end()) {
+            // Inflate on first touch — the entry is hot again by
+            // definition
+            if (it->data.userType() == QMetaType::QByteArray &&
+                (it->type == CacheItemType::RenderedPage ||
+                 it->type == CacheItemType::Thumbnail ||
+                 it->type == CacheItemType::PageImage)) {
+                QImage image = QImage::fromData(it->data.toByteArray());
+                if (!image.isNull()) {
+                    if (it->type == CacheItemType::PageImage) {
+                        it->data = QVariant::fromValue(image);
+                    } else {
+                        it->data =
+                            QVariant::fromValue(QPixmap::fromImage(image));
+                    }
+                    it->memorySize = it->calculateSize();
+                }
+            }
+            it->updateAccess();
+            it->probationary.store(false, std::memory_order_relaxed);
+            recordPendingTouch(*it);
+            data = it->data;
+            hit = true;
+        }
     }
 
-    updateStatistics(false);
-    emit cacheMiss(key);
-    return QVariant();
+    updateStatistics(hit);
+    if (hit) {
+        emit cacheHit(key, 0);
+    } else {
+        emit cacheMiss(key);  // Evicted between the two locks
+    }
+    return data;
 }
 
 bool PDFCacheManager::contains(const QString& key) const {
-    QMutexLocker locker(&m_cacheMutex);
+    QReadLocker locker(&m_cacheLock);
     return m_cache.contains(key);
 }
 
 bool PDFCacheManager::remove(const QString& key) {
-    QMutexLocker locker(&m_cacheMutex);
+    QWriteLocker locker(&m_cacheLock);
 
     auto it = m_cache.find(key);
     if (it != m_cache.end()) {
@@ -198,8 +368,22 @@ bool PDFCacheManager::remove(const QString& key) {
 }
 
 void PDFCacheManager::clear() {
-    QMutexLocker locker(&m_cacheMutex);
-    m_cache.clear();
+    {
+        QWriteLocker locker(&m_cacheLock);
+        m_cache.clear();
+        m_ghostKeys.clear();
+        m_ghostOrder.clear();
+        m_pageTouches.clear();
+    }
+    {
+        QMutexLocker locker(&m_touchMutex);
+        m_pendingTouches.clear();
+    }
+    {
+        QMutexLocker locker(&m_twinMutex);
+        m_rasterSignatures.clear();
+        m_rasterTwins.clear();
+    }
     LOG_DEBUG("PDFCacheManager: Cache cleared");
 }
 
@@ -207,27 +391,384 @@ bool PDFCacheManager::cacheRenderedPage(int pageNumber, const QPixmap& pixmap,
                                         double scaleFactor) {
     QString key =
         generateKey(pageNumber, CacheItemType::RenderedPage, scaleFactor);
-    return insert(key, pixmap, CacheItemType::RenderedPage,
-                  CachePriority::Normal, pageNumber);
+    bool cached = insert(key, pixmap, CacheItemType::RenderedPage,
+                         CachePriority::Normal, pageNumber);
+    if (cached) {
+        learnRasterTwin(QString(), pageNumber, pixmap, scaleFactor);
+    }
+    return cached;
 }
 
 QPixmap PDFCacheManager::getRenderedPage(int pageNumber, double scaleFactor) {
-    QString key =
-        generateKey(pageNumber, CacheItemType::RenderedPage, scaleFactor);
+    return renderedPageLookup(QString(), pageNumber, scaleFactor);
+}
+
+QPixmap PDFCacheManager::renderedPageLookup(const QString& documentHash,
+                                            int pageNumber,
+                                            double scaleFactor) {
+    QString key = namespacedKey(
+        documentHash,
+        generateKey(pageNumber, CacheItemType::RenderedPage, scaleFactor));
     QVariant result = get(key);
-    return result.canConvert<QPixmap>() ? result.value<QPixmap>() : QPixmap();
+    if (result.canConvert<QPixmap>()) {
+        return result.value<QPixmap>();
+    }
+
+    // Miss: a page known to produce the same raster as an earlier page
+    // (templated documents) serves that page's render at this scale
+    // without rendering at all. The twin's pixmap is returned directly
+    // rather than re-inserted, so the identical raster is charged to
+    // the budget once no matter how many pages share it
+    const int twin = rasterTwinOf(documentHash, pageNumber);
+    if (twin >= 0) {
+        QVariant twinResult = get(namespacedKey(
+            documentHash,
+            generateKey(twin, CacheItemType::RenderedPage, scaleFactor)));
+        if (twinResult.canConvert<QPixmap>()) {
+            return twinResult.value<QPixmap>();
+        }
+    }
+
+    // Miss on the exact scale: serve by downscaling a cached
+    // higher-resolution render of the same page if the quality delta is
+    // acceptable, so small zoom steps never re-render from scratch
+    if (m_derivedQualityThreshold >= 1.0) {
+        return QPixmap();
+    }
+
+    QPixmap sourcePixmap;
+    double sourceScale = 0.0;
+    {
+        // Pure scan: the shared side is enough
+        QReadLocker locker(&m_cacheLock);
+        QString keyPrefix =
+            namespacedKey(documentHash, QString("page_%1_").arg(pageNumber));
+        double bestRatio = 0.0;
+        for (auto it = m_cache.constBegin(); it != m_cache.constEnd(); ++it) {
+            if (it->type != CacheItemType::RenderedPage ||
+                it->pageNumber != pageNumber ||
+                !it.key().startsWith(keyPrefix)) {
+                continue;
+            }
+            bool ok = false;
+            double cachedScale = it.key().mid(keyPrefix.size()).toDouble(&ok);
+            if (!ok || cachedScale <= 0.0) {
+                continue;
+            }
+            double ratio = scaleFactor / cachedScale;
+            // Downscale only; upscaling a lower-res render would blur
+            if (ratio > 1.001 || ratio < m_derivedQualityThreshold) {
+                continue;
+            }
+            if (ratio > bestRatio && it->data.canConvert<QPixmap>()) {
+                bestRatio = ratio;
+                sourcePixmap = it->data.value<QPixmap>();
+                sourceScale = cachedScale;
+            }
+        }
+    }
+
+    if (sourcePixmap.isNull()) {
+        return QPixmap();
+    }
+
+    QPixmap derived = sourcePixmap.scaled(
+        sourcePixmap.size() * (scaleFactor / sourceScale), Qt::KeepAspectRatio,
+        Qt::SmoothTransformation);
+
+    // Insert under the exact key so the next lookup at this scale hits
+    insert(key, derived, CacheItemType::RenderedPage, CachePriority::Normal,
+           pageNumber);
+    return derived;
+}
+
+void PDFCacheManager::setDerivedQualityThreshold(double ratio) {
+    m_derivedQualityThreshold = qBound(0.1, ratio, 1.0);
+}
+
+quint64 PDFCacheManager::rasterSignature(const QImage& image) {
+    // Hash exact row widths, not bytesPerLine: scanline padding is
+    // uninitialized and would make identical renders hash differently
+    const int rowBytes = image.width() * image.depth() / 8;
+    size_t hash = qHashMulti(0, image.width(), image.height(),
+                             static_cast<int>(image.format()));
+    for (int y = 0; y < image.height(); ++y) {
+        hash = qHashBits(image.constScanLine(y), rowBytes, hash);
+    }
+    return static_cast<quint64>(hash);
+}
+
+void PDFCacheManager::learnRasterTwin(const QString& documentHash,
+                                      int pageNumber, const QPixmap& pixmap,
+                                      double scaleFactor) {
+    if (pixmap.isNull() || pageNumber < 0) {
+        return;
+    }
+    // Hashing is linear in the pixel count; the cheap tiers see every
+    // page anyway, so the expensive ones never pay for learning
+    const qint64 bytes =
+        qint64(pixmap.width()) * pixmap.height() * 4;
+    if (bytes > TWIN_LEARN_MAX_BYTES) {
+        return;
+    }
+
+    const QImage image = pixmap.toImage();
+    if (image.isNull() || image.depth() < 8) {
+        return;
+    }
+    const quint64 signature = rasterSignature(image);
+    const QString signatureKey = QString("%1|%2|%3")
+                                     .arg(documentHash)
+                                     .arg(qRound(scaleFactor * 1000.0))
+                                     .arg(signature);
+
+    QMutexLocker locker(&m_twinMutex);
+    if (m_rasterSignatures.size() >= TWIN_STATE_CAPACITY) {
+        m_rasterSignatures.clear();  // Relearned from ongoing inserts
+    }
+    auto it = m_rasterSignatures.constFind(signatureKey);
+    if (it == m_rasterSignatures.constEnd()) {
+        m_rasterSignatures.insert(signatureKey, pageNumber);
+        return;
+    }
+    if (it.value() != pageNumber &&
+        m_rasterTwins.size() < TWIN_STATE_CAPACITY) {
+        m_rasterTwins.insert(
+            QString("%1|%2").arg(documentHash).arg(pageNumber), it.value());
+    }
+}
+
+int PDFCacheManager::rasterTwinOf(const QString& documentHash,
+                                  int pageNumber) const {
+    QMutexLocker locker(&m_twinMutex);
+    return m_rasterTwins.value(
+        QString("%1|%2").arg(documentHash).arg(pageNumber), -1);
+}
+
+bool PDFCacheManager::cacheTile(int pageNumber, int tileX, int tileY,
+                                double xres, double yres, const QImage& tile) {
+    // Tiles are cheap to re-render individually, so they evict before
+    // full-page renders
+    return insert(tileKey(QString(), pageNumber, tileX, tileY, xres, yres),
+                  tile, CacheItemType::PageImage, CachePriority::Low,
+                  pageNumber);
+}
+
+QImage PDFCacheManager::getTile(int pageNumber, int tileX, int tileY,
+                                double xres, double yres) {
+    QVariant result =
+        get(tileKey(QString(), pageNumber, tileX, tileY, xres, yres));
+    return result.canConvert<QImage>() ? result.value<QImage>() : QImage();
 }
 
 bool PDFCacheManager::cacheThumbnail(int pageNumber, const QPixmap& thumbnail) {
     QString key = generateKey(pageNumber, CacheItemType::Thumbnail);
-    return insert(key, thumbnail, CacheItemType::Thumbnail, CachePriority::High,
-                  pageNumber);
+    bool cached = insert(key, thumbnail, CacheItemType::Thumbnail,
+                         CachePriority::High, pageNumber);
+    if (cached) {
+        // Thumbnails are the cheapest tier that still covers every
+        // page, so they do most of the twin learning
+        learnRasterTwin(QString(), pageNumber, thumbnail, 0.0);
+    }
+
+    // Write through to the persistent tier so the thumbnail survives a
+    // restart
+    if (cached && m_diskCache) {
+        // QSize() is the sentinel for "default thumbnail size"; sized
+        // variants key on their explicit pixel size
+        m_diskCache->store(pageNumber, QSize(), 0, thumbnail.toImage());
+    }
+    return cached;
 }
 
 QPixmap PDFCacheManager::getThumbnail(int pageNumber) {
     QString key = generateKey(pageNumber, CacheItemType::Thumbnail);
     QVariant result = get(key);
-    return result.canConvert<QPixmap>() ? result.value<QPixmap>() : QPixmap();
+    if (result.canConvert<QPixmap>()) {
+        return result.value<QPixmap>();
+    }
+
+    // A raster twin's thumbnail is pixel-identical; serve it directly
+    const int twin = rasterTwinOf(QString(), pageNumber);
+    if (twin >= 0) {
+        QVariant twinResult =
+            get(generateKey(twin, CacheItemType::Thumbnail));
+        if (twinResult.canConvert<QPixmap>()) {
+            return twinResult.value<QPixmap>();
+        }
+    }
+
+    // In-memory miss: consult the mmap-backed disk tier before giving up
+    if (m_diskCache) {
+        QImage image = m_diskCache->load(pageNumber, QSize(), 0);
+        if (!image.isNull()) {
+            QPixmap pixmap = QPixmap::fromImage(image);
+            insert(key, pixmap, CacheItemType::Thumbnail, CachePriority::High,
+                   pageNumber);
+            return pixmap;
+        }
+    }
+    return QPixmap();
+}
+
+bool PDFCacheManager::cacheRenderedPage(const QString& documentHash,
+                                        int pageNumber, const QPixmap& pixmap,
+                                        double scaleFactor) {
+    QString key = namespacedKey(
+        documentHash,
+        generateKey(pageNumber, CacheItemType::RenderedPage, scaleFactor));
+    bool cached = insert(key, pixmap, CacheItemType::RenderedPage,
+                         CachePriority::Normal, pageNumber);
+    if (cached) {
+        learnRasterTwin(documentHash, pageNumber, pixmap, scaleFactor);
+    }
+    return cached;
+}
+
+QPixmap PDFCacheManager::getRenderedPage(const QString& documentHash,
+                                         int pageNumber, double scaleFactor) {
+    return renderedPageLookup(documentHash, pageNumber, scaleFactor);
+}
+
+bool PDFCacheManager::cacheTile(const QString& documentHash, int pageNumber,
+                                int tileX, int tileY, double xres, double yres,
+                                const QImage& tile) {
+    return insert(tileKey(documentHash, pageNumber, tileX, tileY, xres, yres),
+                  tile, CacheItemType::PageImage, CachePriority::Low,
+                  pageNumber);
+}
+
+QImage PDFCacheManager::getTile(const QString& documentHash, int pageNumber,
+                                int tileX, int tileY, double xres,
+                                double yres) {
+    QVariant result =
+        get(tileKey(documentHash, pageNumber, tileX, tileY, xres, yres));
+    return result.canConvert<QImage>() ? result.value<QImage>() : QImage();
+}
+
+bool PDFCacheManager::cacheThumbnail(const QString& documentHash,
+                                     int pageNumber, const QPixmap& thumbnail) {
+    QString key = namespacedKey(
+        documentHash, generateKey(pageNumber, CacheItemType::Thumbnail));
+    bool cached = insert(key, thumbnail, CacheItemType::Thumbnail,
+                         CachePriority::High, pageNumber);
+    if (cached) {
+        learnRasterTwin(documentHash, pageNumber, thumbnail, 0.0);
+    }
+
+    // The disk tier is keyed by the same content hash; a throwaway
+    // writer leaves the shared instance's disk namespace untouched
+    if (cached && !documentHash.isEmpty()) {
+        DiskRenderCache disk;
+        disk.setDocumentHash(documentHash);
+        disk.store(pageNumber, QSize(), 0, thumbnail.toImage());
+    }
+    return cached;
+}
+
+QPixmap PDFCacheManager::getThumbnail(const QString& documentHash,
+                                      int pageNumber) {
+    QString key = namespacedKey(
+        documentHash, generateKey(pageNumber, CacheItemType::Thumbnail));
+    QVariant result = get(key);
+    if (result.canConvert<QPixmap>()) {
+        return result.value<QPixmap>();
+    }
+
+    const int twin = rasterTwinOf(documentHash, pageNumber);
+    if (twin >= 0) {
+        QVariant twinResult = get(namespacedKey(
+            documentHash, generateKey(twin, CacheItemType::Thumbnail)));
+        if (twinResult.canConvert<QPixmap>()) {
+            return twinResult.value<QPixmap>();
+        }
+    }
+
+    if (!documentHash.isEmpty()) {
+        DiskRenderCache disk;
+        disk.setDocumentHash(documentHash);
+        QImage image = disk.load(pageNumber, QSize(), 0);
+        if (!image.isNull()) {
+            QPixmap pixmap = QPixmap::fromImage(image);
+            insert(key, pixmap, CacheItemType::Thumbnail, CachePriority::High,
+                   pageNumber);
+            return pixmap;
+        }
+    }
+    return QPixmap();
+}
+
+void PDFCacheManager::persistFirstPagePreview(const QString& documentHash) {
+    if (documentHash.isEmpty()) {
+        return;
+    }
+
+    DiskRenderCache disk;
+    disk.setDocumentHash(documentHash);
+    if (disk.contains(0, QSize(), 0)) {
+        return;  // Thumbnail write-through already covered this document
+    }
+
+    // Pick the largest full-page render of page 0 still in memory.
+    // Tiles are deliberately excluded — a tile is a crop, not a preview
+    QImage source;
+    {
+        QReadLocker locker(&m_cacheLock);
+        for (const CacheItem& item : m_cache) {
+            if (item.pageNumber != 0 || item.documentHash != documentHash ||
+                (item.type != CacheItemType::RenderedPage &&
+                 item.type != CacheItemType::Thumbnail)) {
+                continue;
+            }
+            QImage candidate;
+            if (item.data.canConvert<QPixmap>()) {
+                candidate = item.data.value<QPixmap>().toImage();
+            } else if (item.data.canConvert<QImage>()) {
+                candidate = item.data.value<QImage>();
+            } else if (item.data.userType() == QMetaType::QByteArray) {
+                // Cold entries may sit compressed under the low-memory
+                // profile; decoding one image at close time is cheap
+                candidate = QImage::fromData(item.data.toByteArray());
+            }
+            if (candidate.width() > source.width()) {
+                source = candidate;
+            }
+        }
+    }
+    if (source.isNull()) {
+        return;
+    }
+
+    // Same height as the prewarmer's thumbnail strip, stored under the
+    // QSize() sentinel so getThumbnail() and the welcome screen share it
+    QImage preview =
+        source.height() > 160
+            ? source.scaledToHeight(160, Qt::SmoothTransformation)
+            : source;
+    disk.store(0, QSize(), 0, preview);
+}
+
+QString PDFCacheManager::namespacedKey(const QString& documentHash,
+                                       const QString& key) {
+    return documentHash.isEmpty() ? key : documentHash + QLatin1Char('/') + key;
+}
+
+QString PDFCacheManager::tileKey(const QString& documentHash, int pageNumber,
+                                 int tileX, int tileY, double xres,
+                                 double yres) const {
+    QString extra = QString("tile_%1_%2_%3_%4")
+                        .arg(tileX)
+                        .arg(tileY)
+                        .arg(xres)
+                        .arg(yres);
+    return namespacedKey(
+        documentHash, generateKey(pageNumber, CacheItemType::PageImage, extra));
+}
+
+void PDFCacheManager::setDocumentHash(const QString& documentHash) {
+    if (m_diskCache) {
+        m_diskCache->setDocumentHash(documentHash);
+    }
 }
 
 bool PDFCacheManager::cacheTextContent(int pageNumber, const QString& text) {
@@ -311,13 +852,12 @@ QString PDFCacheManager::generateKey(int pageNumber, CacheItemType type,
 }
 
 void PDFCacheManager::updateStatistics(bool hit) {
-    QMutexLocker locker(&m_statsMutex);
     if (hit) {
-        m_hitCount++;
+        m_hitCount.fetch_add(1, std::memory_order_relaxed);
     } else {
-        m_missCount++;
+        m_missCount.fetch_add(1, std::memory_order_relaxed);
     }
-    m_accessCount++;
+    m_accessCount.fetch_add(1, std::memory_order_relaxed);
 }
 
 void PDFCacheManager::schedulePreload(int pageNumber, CacheItemType type) {
@@ -334,6 +874,10 @@ void PDFCacheManager::schedulePreload(int pageNumber, CacheItemType type) {
 void PDFCacheManager::performMaintenance() {
     cleanupExpiredItems();
 
+    // Demote cold pixel entries to the compressed tier instead of
+    // holding full ARGB buffers for pages nobody is looking at
+    compressColdEntries();
+
     // Perform optimization if needed
     if (m_lastOptimization.elapsed() > 300000) {  // 5 minutes
         optimizeCache();
@@ -341,6 +885,130 @@ void PDFCacheManager::performMaintenance() {
     }
 }
 
+void PDFCacheManager::inflatePages(const QString& documentHash,
+                                   const QList<int>& pageNumbers) {
+    if (pageNumbers.isEmpty()) {
+        return;
+    }
+    QSet<int> wanted(pageNumbers.begin(), pageNumbers.end());
+
+    QPointer<PDFCacheManager> self(this);
+    RenderScheduler::instance().submit(
+        RenderScheduler::TaskClass::Background,
+        [self, documentHash, wanted]() {
+            if (!self) {
+                return;
+            }
+
+            // Snapshot the compressed payloads under the lock, decode
+            // outside it
+            QList<QPair<QString, QByteArray>> toDecode;
+            {
+                QReadLocker locker(&self->m_cacheLock);
+                for (auto it = self->m_cache.constBegin();
+                     it != self->m_cache.constEnd(); ++it) {
+                    if (!wanted.contains(it->pageNumber) ||
+                        it->documentHash != documentHash ||
+                        it->data.userType() != QMetaType::QByteArray) {
+                        continue;
+                    }
+                    if (it->type != CacheItemType::RenderedPage &&
+                        it->type != CacheItemType::Thumbnail &&
+                        it->type != CacheItemType::PageImage) {
+                        continue;
+                    }
+                    toDecode.append(
+                        qMakePair(it.key(), it->data.toByteArray()));
+                }
+            }
+
+            for (const auto& entry : toDecode) {
+                QImage image = QImage::fromData(entry.second);
+                if (image.isNull() || !self) {
+                    continue;
+                }
+                QWriteLocker locker(&self->m_cacheLock);
+                auto it = self->m_cache.find(entry.first);
+                if (it == self->m_cache.end() ||
+                    it->data.userType() != QMetaType::QByteArray) {
+                    continue;  // Evicted or already inflated meanwhile
+                }
+                // Stored as QImage: the expensive decode happened here;
+                // the GUI thread only pays the pixmap conversion at
+                // first use
+                it->data = QVariant::fromValue(image);
+                it->memorySize = it->calculateSize();
+            }
+        });
+}
+
+void PDFCacheManager::compressColdEntries() {
+    QWriteLocker locker(&m_cacheLock);
+
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    qint64 maxAge = RenderPolicy::lowMemoryProfile()
+                        ? COLD_COMPRESS_AGE_LOW_MEM_MS
+                        : COLD_COMPRESS_AGE_MS;
+    int compressed = 0;
+    qint64 reclaimed = 0;
+
+    for (auto it = m_cache.begin(); it != m_cache.end(); ++it) {
+        if (it->type != CacheItemType::RenderedPage &&
+            it->type != CacheItemType::Thumbnail &&
+            it->type != CacheItemType::PageImage) {
+            continue;
+        }
+        const qint64 accessed =
+            it->lastAccessed.load(std::memory_order_relaxed);
+        qint64 lastTouch = accessed > 0 ? accessed : it->timestamp;
+        if (now - lastTouch < maxAge) {
+            continue;
+        }
+
+        // Entries already holding QByteArray data are compressed; their
+        // variant cannot convert to a pixel type and is skipped here
+        QImage image;
+        if (it->data.canConvert<QPixmap>()) {
+            image = it->data.value<QPixmap>().toImage();
+        } else if (it->data.canConvert<QImage>()) {
+            image = it->data.value<QImage>();
+        }
+        if (image.isNull()) {
+            continue;
+        }
+
+        // Rendered pages are opaque and tolerate lossy JPEG well; tiles
+        // with an alpha channel get lossless PNG instead. Either way a
+        // cold entry trades decode time on its next hit for a footprint
+        // an order of magnitude smaller
+        QByteArray encoded;
+        QBuffer buffer(&encoded);
+        buffer.open(QIODevice::WriteOnly);
+        bool saved = image.hasAlphaChannel()
+                         ? image.save(&buffer, "PNG")
+                         : image.save(&buffer, "JPG",
+                                      COLD_COMPRESS_JPEG_QUALITY);
+        if (!saved) {
+            continue;
+        }
+        qint64 newSize = qint64(sizeof(CacheItem)) + encoded.size();
+        if (newSize >= it->memorySize) {
+            continue;  // Compression did not pay off
+        }
+
+        reclaimed += it->memorySize - newSize;
+        it->data = encoded;
+        it->memorySize = newSize;
+        ++compressed;
+    }
+
+    if (compressed > 0) {
+        LOG_DEBUG(
+            "PDFCacheManager: compressed {} cold entries, reclaimed {} KB",
+            compressed, reclaimed / 1024);
+    }
+}
+
 void PDFCacheManager::onPreloadTaskCompleted() {
     // Handle preload task completion
     // This would be called by PreloadTask when it finishes
@@ -360,13 +1028,88 @@ void PDFCacheManager::setItemMaxAge(qint64 milliseconds) {
     m_itemMaxAge = milliseconds;
 }
 
+void PDFCacheManager::remapDocumentPages(const QString& documentHash,
+                                         const PageIndexMap& map) {
+    if (documentHash.isEmpty() || map.isIdentity()) {
+        return;
+    }
+
+    QWriteLocker locker(&m_cacheLock);
+
+    QHash<QString, CacheItem> remapped;
+    remapped.reserve(m_cache.size());
+    int translated = 0;
+    int dropped = 0;
+
+    for (auto it = m_cache.constBegin(); it != m_cache.constEnd(); ++it) {
+        CacheItem item = it.value();
+        if (item.documentHash != documentHash || item.pageNumber < 0) {
+            remapped.insert(it.key(), item);  // Other documents untouched
+            continue;
+        }
+        const int newPage = map.mapFromOld(item.pageNumber);
+        if (newPage < 0) {
+            dropped++;  // Page removed; its pixels go with it
+            continue;
+        }
+        if (newPage != item.pageNumber) {
+            // Namespaced keys embed the page as the token after the
+            // type prefix ("<hash>/<type>_<page>[_extra]"); rewrite it
+            // in place so lookups under the new numbering hit
+            const int local = item.key.indexOf(QLatin1Char('/')) + 1;
+            const int pageStart =
+                item.key.indexOf(QLatin1Char('_'), local) + 1;
+            int pageEnd = item.key.indexOf(QLatin1Char('_'), pageStart);
+            if (pageEnd < 0) {
+                pageEnd = item.key.size();
+            }
+            item.key.replace(pageStart, pageEnd - pageStart,
+                             QString::number(newPage));
+            item.pageNumber = newPage;
+            translated++;
+        }
+        remapped.insert(item.key, item);
+    }
+
+    // Moved, not assigned: leaving the two hashes implicitly shared
+    // until scope end would force a detach on the next mutation
+    m_cache = std::move(remapped);
+    locker.unlock();
+
+    // Twin state records page numbers that just shifted; relearning
+    // from the surviving renders is cheaper than translating it
+    {
+        QMutexLocker twinLocker(&m_twinMutex);
+        const QString prefix = documentHash + QLatin1Char('|');
+        for (auto it = m_rasterSignatures.begin();
+             it != m_rasterSignatures.end();) {
+            if (it.key().startsWith(prefix)) {
+                it = m_rasterSignatures.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        for (auto it = m_rasterTwins.begin(); it != m_rasterTwins.end();) {
+            if (it.key().startsWith(prefix)) {
+                it = m_rasterTwins.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    LOG_DEBUG(
+        "PDFCacheManager: Remapped {} entries, dropped {} for document {}",
+        translated, dropped, documentHash.toStdString());
+}
+
 void PDFCacheManager::optimizeCache() {
-    QMutexLocker locker(&m_cacheMutex);
+    QWriteLocker locker(&m_cacheLock);
 
     int initialSize = m_cache.size();
     qint64 initialMemory = getCurrentMemoryUsage();
 
-    cleanupExpiredItems();
+    cleanupExpiredItemsLocked();
 
     // Additional optimization logic could go here
 
@@ -382,7 +1125,14 @@ void PDFCacheManager::cleanupExpiredItems() {
     if (m_itemMaxAge <= 0)
         return;
 
-    QMutexLocker locker(&m_cacheMutex);
+    QWriteLocker locker(&m_cacheLock);
+    cleanupExpiredItemsLocked();
+}
+
+void PDFCacheManager::cleanupExpiredItemsLocked() {
+    if (m_itemMaxAge <= 0)
+        return;
+
     auto it = m_cache.begin();
     while (it != m_cache.end()) {
         if (it->isExpired(m_itemMaxAge)) {
@@ -395,16 +1145,35 @@ void PDFCacheManager::cleanupExpiredItems() {
 }
 
 bool PDFCacheManager::evictLeastUsedItems(int count) {
-    QMutexLocker locker(&m_cacheMutex);
+    QWriteLocker locker(&m_cacheLock);
+    return evictLeastUsedItemsLocked(count);
+}
 
+bool PDFCacheManager::evictLeastUsedItemsLocked(int count) {
     if (m_cache.isEmpty() || count <= 0)
         return false;
 
+    // Per-document fairness: a document holding more than an equal
+    // share of the cache gets its items' scores biased downward in
+    // proportion to the excess, so one heavy document is evicted from
+    // first instead of starving every other open document
+    QHash<QString, qint64> usageByDocument;
+    for (auto it = m_cache.constBegin(); it != m_cache.constEnd(); ++it) {
+        usageByDocument[it->documentHash] += it->memorySize;
+    }
+    const qint64 fairShare =
+        getCurrentMemoryUsage() / qMax(1, usageByDocument.size());
+
     // Create list of items with eviction scores
     QList<QPair<double, QString>> candidates;
     for (auto it = m_cache.begin(); it != m_cache.end(); ++it) {
         if (it->priority != CachePriority::Critical) {
             double score = calculateEvictionScore(*it);
+            const qint64 usage = usageByDocument.value(it->documentHash);
+            if (fairShare > 0 && usage > fairShare) {
+                score -= FAIRNESS_BIAS * static_cast<double>(usage - fairShare) /
+                         static_cast<double>(fairShare);
+            }
             candidates.append({score, it->key});
         }
     }
@@ -421,6 +1190,7 @@ bool PDFCacheManager::evictLeastUsedItems(int count) {
         auto it = m_cache.find(candidate.second);
         if (it != m_cache.end()) {
             emit itemEvicted(it->key, it->type);
+            recordGhostLocked(it->key);
             m_cache.erase(it);
             evicted++;
         }
@@ -428,6 +1198,77 @@ bool PDFCacheManager::evictLeastUsedItems(int count) {
     return evicted > 0;
 }
 
+bool PDFCacheManager::evictProbationaryItemLocked() {
+    // FIFO over the probationary segment, the 2Q A1in discipline: the
+    // oldest speculative entry that never earned a re-access goes first
+    auto victim = m_cache.end();
+    for (auto it = m_cache.begin(); it != m_cache.end(); ++it) {
+        if (it->probationary.load(std::memory_order_relaxed) &&
+            (victim == m_cache.end() || it->timestamp < victim->timestamp)) {
+            victim = it;
+        }
+    }
+    if (victim == m_cache.end()) {
+        return false;
+    }
+    emit itemEvicted(victim->key, victim->type);
+    recordGhostLocked(victim->key);
+    m_cache.erase(victim);
+    return true;
+}
+
+void PDFCacheManager::recordGhostLocked(const QString& key) {
+    if (m_ghostKeys.contains(key)) {
+        return;
+    }
+    m_ghostKeys.insert(key);
+    m_ghostOrder.enqueue(key);
+    while (m_ghostOrder.size() > GHOST_CAPACITY) {
+        m_ghostKeys.remove(m_ghostOrder.dequeue());
+    }
+}
+
+void PDFCacheManager::recordPendingTouch(const CacheItem& item) {
+    if (item.pageNumber < 0) {
+        return;
+    }
+    // Called from the lookup fast path holding only the shared cache
+    // lock: the key goes into a side list behind its own short mutex,
+    // and the next insert folds the list into m_pageTouches. Overflow
+    // between drains is dropped rather than waited for — sampled
+    // frequency is all the admission heuristic needs
+    QMutexLocker locker(&m_touchMutex);
+    if (m_pendingTouches.size() >= PENDING_TOUCH_CAPACITY) {
+        return;
+    }
+    m_pendingTouches.append(pageTouchKey(item));
+}
+
+void PDFCacheManager::drainPendingTouchesLocked() {
+    QStringList pending;
+    {
+        QMutexLocker locker(&m_touchMutex);
+        if (m_pendingTouches.isEmpty()) {
+            return;
+        }
+        pending.swap(m_pendingTouches);
+    }
+    for (const QString& key : pending) {
+        // Self-resetting frequency estimator: rather than track an LRU
+        // over touch records, drop them all once the map grows past its
+        // bound and let the hot pages re-earn their counts
+        if (m_pageTouches.size() >= PAGE_TOUCH_CAPACITY) {
+            m_pageTouches.clear();
+        }
+        m_pageTouches[key]++;
+    }
+}
+
+QString PDFCacheManager::pageTouchKey(const CacheItem& item) {
+    return item.documentHash + QLatin1Char(':') +
+           QString::number(item.pageNumber);
+}
+
 double PDFCacheManager::calculateEvictionScore(const CacheItem& item) const {
     double score = 0.0;
 
@@ -452,13 +1293,21 @@ double PDFCacheManager::calculateEvictionScore(const CacheItem& item) const {
     score -= age / 1000.0;  // Convert to seconds
 
     // Access frequency factor
-    score += item.accessCount * 10.0;
+    score += item.accessCount.load(std::memory_order_relaxed) * 10.0;
 
     // Recent access factor
     qint64 timeSinceLastAccess =
-        QDateTime::currentMSecsSinceEpoch() - item.lastAccessed;
+        QDateTime::currentMSecsSinceEpoch() -
+        item.lastAccessed.load(std::memory_order_relaxed);
     score -= timeSinceLastAccess / 1000.0;
 
+    // Probationary entries sort below the whole main segment, so every
+    // eviction path (maintenance, governor pressure) sheds unproven
+    // speculative renders before anything with a re-access to its name
+    if (item.probationary.load(std::memory_order_relaxed)) {
+        score -= PROBATION_BIAS;
+    }
+
     return score;
 }
 
@@ -475,6 +1324,9 @@ void PDFCacheManager::enforceItemLimit() {
 }
 
 qint64 PDFCacheManager::getCurrentMemoryUsage() const {
+    // Deliberately takes no lock: insert and the maintenance paths call
+    // this while already holding m_cacheLock, and the governor's
+    // periodic sampling tolerates a racy sum
     qint64 total = 0;
     for (const auto& item : m_cache) {
         total += item.memorySize;
@@ -483,17 +1335,17 @@ qint64 PDFCacheManager::getCurrentMemoryUsage() const {
 }
 
 CacheStatistics PDFCacheManager::getStatistics() const {
-    QMutexLocker locker(&m_cacheMutex);
-    QMutexLocker statsLocker(&m_statsMutex);
+    QReadLocker locker(&m_cacheLock);
 
     CacheStatistics stats;
     stats.totalItems = m_cache.size();
     stats.totalMemoryUsage = getCurrentMemoryUsage();
-    stats.hitCount = m_hitCount;
-    stats.missCount = m_missCount;
+    stats.hitCount = m_hitCount.load(std::memory_order_relaxed);
+    stats.missCount = m_missCount.load(std::memory_order_relaxed);
     stats.hitRate =
-        (m_hitCount + m_missCount > 0)
-            ? static_cast<double>(m_hitCount) / (m_hitCount + m_missCount)
+        (stats.hitCount + stats.missCount > 0)
+            ? static_cast<double>(stats.hitCount) /
+                  (stats.hitCount + stats.missCount)
             : 0.0;
 
     // Calculate items by type
@@ -508,18 +1360,17 @@ CacheStatistics PDFCacheManager::getStatistics() const {
 }
 
 double PDFCacheManager::getHitRate() const {
-    QMutexLocker locker(&m_statsMutex);
-    return (m_hitCount + m_missCount > 0)
-               ? static_cast<double>(m_hitCount) / (m_hitCount + m_missCount)
-               : 0.0;
+    const qint64 hits = m_hitCount.load(std::memory_order_relaxed);
+    const qint64 misses = m_missCount.load(std::memory_order_relaxed);
+    return (hits + misses > 0) ? static_cast<double>(hits) / (hits + misses)
+                               : 0.0;
 }
 
 void PDFCacheManager::resetStatistics() {
-    QMutexLocker locker(&m_statsMutex);
-    m_hitCount = 0;
-    m_missCount = 0;
-    m_totalAccessTime = 0;
-    m_accessCount = 0;
+    m_hitCount.store(0, std::memory_order_relaxed);
+    m_missCount.store(0, std::memory_order_relaxed);
+    m_totalAccessTime.store(0, std::memory_order_relaxed);
+    m_accessCount.store(0, std::memory_order_relaxed);
 }
 
 void PDFCacheManager::loadSettings() {
@@ -3,16 +3,22 @@
 #include <poppler-qt6.h>
 #include <QCache>
 #include <QElapsedTimer>
+#include <QImage>
 #include <QMutex>
 #include <QObject>
 #include <QPixmap>
 #include <QQueue>
+#include <QReadWriteLock>
 #include <QRunnable>
 #include <QSet>
 #include <QSettings>
 #include <QThread>
 #include <QThreadPool>
 #include <QTimer>
+#include <atomic>
+#include "DiskRenderCache.h"
+
+class PageIndexMap;
 
 /**
  * Cache item types
@@ -44,11 +50,17 @@ struct CacheItem {
     CacheItemType type;
     CachePriority priority;
     qint64 timestamp;
-    qint64 accessCount;
-    qint64 lastAccessed;
+    // Hot-path bookkeeping, mutated by concurrent readers holding only
+    // the shared cache lock; atomic so hits need no exclusive lock
+    mutable std::atomic<qint64> accessCount;
+    mutable std::atomic<qint64> lastAccessed;
     int pageNumber;
     QString key;
+    QString documentHash;  // Namespace prefix; empty for legacy keys
     qint64 memorySize;
+    // 2Q admission state: a fresh one-touch render sits in the
+    // probationary segment until a re-access promotes it
+    mutable std::atomic<bool> probationary;
 
     CacheItem()
         : type(CacheItemType::RenderedPage),
@@ -57,11 +69,35 @@ struct CacheItem {
           accessCount(0),
           lastAccessed(0),
           pageNumber(-1),
-          memorySize(0) {}
+          memorySize(0),
+          probationary(false) {}
+
+    // QHash stores items by value and atomics are not copyable; copy
+    // the loaded values explicitly. Copies only happen on write paths
+    // holding the exclusive lock, so a plain load is enough
+    CacheItem(const CacheItem& other) : CacheItem() { *this = other; }
+    CacheItem& operator=(const CacheItem& other) {
+        data = other.data;
+        type = other.type;
+        priority = other.priority;
+        timestamp = other.timestamp;
+        accessCount.store(other.accessCount.load(std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+        lastAccessed.store(other.lastAccessed.load(std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+        pageNumber = other.pageNumber;
+        key = other.key;
+        documentHash = other.documentHash;
+        memorySize = other.memorySize;
+        probationary.store(other.probationary.load(std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+        return *this;
+    }
 
-    void updateAccess() {
-        accessCount++;
-        lastAccessed = QDateTime::currentMSecsSinceEpoch();
+    void updateAccess() const {
+        accessCount.fetch_add(1, std::memory_order_relaxed);
+        lastAccessed.store(QDateTime::currentMSecsSinceEpoch(),
+                           std::memory_order_relaxed);
     }
 
     qint64 calculateSize() const;
@@ -115,13 +151,44 @@ private:
 
 /**
  * PDF cache manager with intelligent caching strategies
+ *
+ * Can be used as a process-global service via shared(): entries are
+ * then namespaced by document content hash (the documentHash overloads
+ * below), so every tab and both DocumentComparison panes draw from one
+ * budget and one LRU, and two views of the same file — even opened as
+ * separate tabs — share a single set of renders. Eviction stays fair
+ * across documents: a document holding more than an equal share of the
+ * cache is evicted from first.
+ *
+ * Storage is two-tiered: hot entries hold raw pixels, entries aging
+ * past a threshold are re-encoded compressed in place (JPEG for opaque
+ * renders, PNG when alpha matters) at a fraction of the ARGB footprint,
+ * so the same budget reaches several times as many pages. Re-expansion
+ * is transparent — get() inflates on access — and the prerenderer
+ * calls inflatePages() ahead of predicted navigation so the decode
+ * usually happens on a pool thread before the page is needed.
  */
 class PDFCacheManager : public QObject {
     Q_OBJECT
 
 public:
     explicit PDFCacheManager(QObject* parent = nullptr);
-    ~PDFCacheManager() = default;
+    ~PDFCacheManager();
+
+    // Process-global instance shared across viewing contexts.
+    // Stand-alone instances remain constructible for isolated use.
+    static PDFCacheManager& shared();
+
+    // Content-hash namespace for a document registered with
+    // DocumentSnapshot; empty for unknown documents (callers then fall
+    // back to their private keys). Hashes are memoized per file path,
+    // and identical files naturally map to the same namespace.
+    static QString namespaceForDocument(Poppler::Document* document);
+
+    // Drops the memoized namespace for a path whose content changed on
+    // disk; called by DocumentVersionBus as part of its invalidation
+    // broadcast
+    static void forgetNamespaceForPath(const QString& filePath);
 
     // Cache configuration
     void setMaxMemoryUsage(qint64 bytes);
@@ -147,9 +214,41 @@ public:
                            double scaleFactor);
     QPixmap getRenderedPage(int pageNumber, double scaleFactor);
 
+    bool cacheTile(int pageNumber, int tileX, int tileY, double xres,
+                   double yres, const QImage& tile);
+    QImage getTile(int pageNumber, int tileX, int tileY, double xres,
+                   double yres);
+
     bool cacheThumbnail(int pageNumber, const QPixmap& thumbnail);
     QPixmap getThumbnail(int pageNumber);
 
+    // Cross-document variants for the shared instance: same operations,
+    // keys prefixed with the document's content hash so concurrent
+    // documents never collide and identical files share entries
+    bool cacheRenderedPage(const QString& documentHash, int pageNumber,
+                           const QPixmap& pixmap, double scaleFactor);
+    QPixmap getRenderedPage(const QString& documentHash, int pageNumber,
+                            double scaleFactor);
+    bool cacheTile(const QString& documentHash, int pageNumber, int tileX,
+                   int tileY, double xres, double yres, const QImage& tile);
+    QImage getTile(const QString& documentHash, int pageNumber, int tileX,
+                   int tileY, double xres, double yres);
+    bool cacheThumbnail(const QString& documentHash, int pageNumber,
+                        const QPixmap& thumbnail);
+    QPixmap getThumbnail(const QString& documentHash, int pageNumber);
+
+    // Close-time hook for the welcome screen's preview strip: if the
+    // disk tier has no first-page thumbnail yet (sidebar never reached
+    // page 1), derive one by downscaling whatever full-page render is
+    // still in memory. Pure CPU work — the document is never touched
+    void persistFirstPagePreview(const QString& documentHash);
+
+    // Persistent tier: entries are namespaced by the document content
+    // hash and consulted on in-memory miss, so thumbnails and low-res
+    // previews survive restarts
+    void setDocumentHash(const QString& documentHash);
+    DiskRenderCache* diskCache() { return m_diskCache; }
+
     bool cacheTextContent(int pageNumber, const QString& text);
     QString getTextContent(int pageNumber);
 
@@ -161,6 +260,20 @@ public:
     void preloadAroundPage(int centerPage, int radius = 2);
     void setPreloadingStrategy(const QString& strategy);
 
+    // Re-inflate compressed entries for the given pages on a pool
+    // thread, ahead of predicted access (driven by the prerenderer's
+    // navigation model). Mispredictions cost nothing: get() still
+    // inflates lazily on access
+    void inflatePages(const QString& documentHash,
+                      const QList<int>& pageNumbers);
+
+    // Applies a bulk page mutation to this document's entries: keys
+    // and page numbers are rewritten through the index translation,
+    // entries of removed pages are dropped. Renders and thumbnails of
+    // surviving pages stay hot instead of being regenerated
+    void remapDocumentPages(const QString& documentHash,
+                            const PageIndexMap& map);
+
     // Cache management
     void optimizeCache();
     void cleanupExpiredItems();
@@ -180,6 +293,14 @@ public:
     void setPriorityWeights(double lowWeight, double normalWeight,
                             double highWeight);
 
+    // Minimum acceptable scale ratio (requested/cached) for serving
+    // getRenderedPage() by downscaling a cached higher-resolution
+    // render. 1.0 disables derived serving, default 0.5
+    void setDerivedQualityThreshold(double ratio);
+    double getDerivedQualityThreshold() const {
+        return m_derivedQualityThreshold;
+    }
+
     // Settings persistence
     void loadSettings();
     void saveSettings();
@@ -221,15 +342,56 @@ private slots:
 private:
     QString generateKey(int pageNumber, CacheItemType type,
                         const QVariant& extra = QVariant()) const;
+    static QString namespacedKey(const QString& documentHash,
+                                 const QString& key);
+    QString tileKey(const QString& documentHash, int pageNumber, int tileX,
+                    int tileY, double xres, double yres) const;
+    QPixmap renderedPageLookup(const QString& documentHash, int pageNumber,
+                               double scaleFactor);
     void updateStatistics(bool hit);
+    // Cold tier: re-encode pixel entries untouched past the age
+    // threshold so they stay servable at a fraction of the ARGB
+    // footprint; get() and inflatePages() expand them again
+    void compressColdEntries();
     void enforceMemoryLimit();
     void enforceItemLimit();
     bool shouldEvict(const CacheItem& item) const;
     double calculateEvictionScore(const CacheItem& item) const;
     void schedulePreload(int pageNumber, CacheItemType type);
-
-    // Cache storage
-    mutable QMutex m_cacheMutex;
+    // Eviction body for callers already holding m_cacheLock for write
+    // (insert's make-room loop); the public evictLeastUsedItems wraps it
+    bool evictLeastUsedItemsLocked(int count);
+    // Same split for expiry: optimizeCache() runs the body under its
+    // own write lock
+    void cleanupExpiredItemsLocked();
+    // Raster twin detection. Templated documents (generated reports,
+    // slide handouts) repeat byte-identical pages thousands of times;
+    // Poppler's qt6 frontend exposes no content-stream hooks, so
+    // identity is learned from rendered output instead: small renders
+    // (thumbnails, low zoom) are hashed on insert, pages producing the
+    // same raster at the same scale are recorded as twins, and later
+    // lookups for a twin page at any scale serve the canonical page's
+    // cached render without re-rendering.
+    void learnRasterTwin(const QString& documentHash, int pageNumber,
+                         const QPixmap& pixmap, double scaleFactor);
+    int rasterTwinOf(const QString& documentHash, int pageNumber) const;
+    static quint64 rasterSignature(const QImage& image);
+
+    // 2Q admission helpers, all called holding m_cacheLock for write
+    bool evictProbationaryItemLocked();
+    void recordGhostLocked(const QString& key);
+    static QString pageTouchKey(const CacheItem& item);
+    // Deferred promotion: hits note their page key in a side list
+    // instead of updating m_pageTouches under the cache lock; the next
+    // insert (already exclusive) folds the notes in before consulting
+    // the touch counts
+    void recordPendingTouch(const CacheItem& item);
+    void drainPendingTouchesLocked();
+
+    // Cache storage. Reader-writer lock: lookups run concurrently
+    // under the shared side, only mutation of the map itself
+    // (insert/evict/compress/remap) takes the exclusive side
+    mutable QReadWriteLock m_cacheLock;
     QHash<QString, CacheItem> m_cache;
 
     // Configuration
@@ -237,18 +399,19 @@ private:
     int m_maxItems;
     qint64 m_itemMaxAge;
     QString m_evictionPolicy;
+    double m_derivedQualityThreshold;
 
     // Priority weights for eviction scoring
     double m_lowPriorityWeight;
     double m_normalPriorityWeight;
     double m_highPriorityWeight;
 
-    // Statistics
-    mutable QMutex m_statsMutex;
-    qint64 m_hitCount;
-    qint64 m_missCount;
-    qint64 m_totalAccessTime;
-    qint64 m_accessCount;
+    // Statistics: plain relaxed atomics so the lookup path counts hits
+    // and misses without any lock at all
+    mutable std::atomic<qint64> m_hitCount;
+    mutable std::atomic<qint64> m_missCount;
+    mutable std::atomic<qint64> m_totalAccessTime;
+    mutable std::atomic<qint64> m_accessCount;
 
     // Preloading
     bool m_preloadingEnabled;
@@ -257,10 +420,67 @@ private:
     QQueue<QPair<int, CacheItemType>> m_preloadQueue;
     QSet<QString> m_preloadingItems;
 
+    // Persistent tier
+    DiskRenderCache* m_diskCache;
+
     // Maintenance
     QTimer* m_maintenanceTimer;
     QElapsedTimer m_lastOptimization;
 
+    // MemoryGovernor registration
+    int m_governorId = -1;
+
+    // 2Q-style admission state. Ghost keys remember recently evicted
+    // entries: re-rendering one means the eviction was a mistake, so
+    // the new entry bypasses probation. Page touch counts remember
+    // per-page access frequency across re-renders at any scale, the
+    // cache-side analogue of the prerenderer's navigation history.
+    QSet<QString> m_ghostKeys;
+    QQueue<QString> m_ghostOrder;
+    QHash<QString, int> m_pageTouches;  // documentHash:page -> accesses
+
+    // Touches recorded by concurrent readers, awaiting a drain on the
+    // next write-locked insert (see recordPendingTouch)
+    QMutex m_touchMutex;
+    QStringList m_pendingTouches;
+
+    // Raster twin state (see learnRasterTwin). Signatures are keyed
+    // "documentHash|scalePermille|hash" -> first page seen with that
+    // raster; twins "documentHash|page" -> canonical page. The twin
+    // relation learned at one scale is content identity, so it applies
+    // at every scale.
+    mutable QMutex m_twinMutex;
+    QHash<QString, int> m_rasterSignatures;
+    QHash<QString, int> m_rasterTwins;
+
+    // Eviction bias per unit of over-fair-share memory a document holds
+    static constexpr double FAIRNESS_BIAS = 25.0;
+
+    // Probationary entries score this far below everything else, so
+    // scan traffic cycles through its own segment instead of flushing
+    // the resident working set
+    static constexpr double PROBATION_BIAS = 500.0;
+    // Re-accesses at which a page's renders skip probation on admission
+    static constexpr int PROMOTE_TOUCHES = 2;
+    // Bounds for the admission history
+    static constexpr int GHOST_CAPACITY = 1024;
+    static constexpr int PAGE_TOUCH_CAPACITY = 8192;
+    // Hits beyond this between two drains are simply dropped — the
+    // touch counts are a frequency sketch, not an exact tally
+    static constexpr int PENDING_TOUCH_CAPACITY = 256;
+
+    // Only renders up to this size are hashed for twin learning: the
+    // thumbnail and low-zoom tiers cover every page cheaply, and the
+    // relation they establish serves the expensive high-DPI tiers
+    static constexpr qint64 TWIN_LEARN_MAX_BYTES = 4LL * 1024 * 1024;
+    static constexpr int TWIN_STATE_CAPACITY = 16384;
+
+    // Cold-entry compression: entries untouched this long move to the
+    // compressed tier; the low-memory profile demotes sooner
+    static constexpr qint64 COLD_COMPRESS_AGE_MS = 60000;
+    static constexpr qint64 COLD_COMPRESS_AGE_LOW_MEM_MS = 15000;
+    static constexpr int COLD_COMPRESS_JPEG_QUALITY = 75;
+
     // Settings
     QSettings* m_settings;
 };
@@ -0,0 +1,47 @@
+#include "CommandHistory.h"
+#include "Commands.h"
+
+CommandHistory::CommandHistory(QObject* parent) : QObject(parent) {}
+
+void CommandHistory::push(Command* command) {
+    if (!command) {
+        return;
+    }
+
+    command->execute();
+
+    if (!command->isUndoable()) {
+        delete command;
+        return;
+    }
+
+    // 先尝试与栈顶合并：合并成功时新命令不单独占一条记录
+    if (!_undoStack.isEmpty() && _undoStack.last()->mergeWith(command)) {
+        delete command;
+        emit historyChanged(true);
+        return;
+    }
+
+    command->setParent(this);
+    _undoStack.append(command);
+    while (_undoStack.size() > MAX_HISTORY) {
+        delete _undoStack.takeFirst();
+    }
+    emit historyChanged(true);
+}
+
+void CommandHistory::undo() {
+    if (_undoStack.isEmpty()) {
+        return;
+    }
+    Command* command = _undoStack.takeLast();
+    command->undo();
+    delete command;
+    emit historyChanged(!_undoStack.isEmpty());
+}
+
+void CommandHistory::clear() {
+    qDeleteAll(_undoStack);
+    _undoStack.clear();
+    emit historyChanged(false);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QList>
+#include <QObject>
+
+class Command;
+
+/**
+ * 命令历史（撤销栈）。
+ *
+ * push()执行命令后按可撤销性入栈；相邻可合并的命令
+ * （Command::mergeWith，如按住翻页键产生的连续导航）压缩为一条
+ * 记录，undo()一次回到整段操作之前，而不是逐条重放数百个微命令。
+ * 栈有上限，超出时丢弃最旧记录。
+ */
+class CommandHistory : public QObject {
+    Q_OBJECT
+
+public:
+    explicit CommandHistory(QObject* parent = nullptr);
+
+    // 执行命令并记录；取得command所有权，
+    // 不可撤销或被合并的命令执行后即销毁
+    void push(Command* command);
+
+    bool canUndo() const { return !_undoStack.isEmpty(); }
+    void undo();
+
+    int count() const { return _undoStack.size(); }
+    void clear();
+
+signals:
+    void historyChanged(bool canUndo);
+
+private:
+    QList<Command*> _undoStack;
+
+    static constexpr int MAX_HISTORY = 100;
+};
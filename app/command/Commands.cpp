@@ -1,21 +1,102 @@
 #include "Commands.h"
 #include "controller/PageController.h"
+#include "model/PageModel.h"
 Command::Command(QObject* parent) : QObject(parent) {}
 
+PageNavigationCommand::PageNavigationCommand(PageController* controller,
+                                             QObject* parent)
+    : Command(parent),
+      _controller(controller),
+      _pageBefore(-1),
+      _hasSnapshot(false) {}
+
+void PageNavigationCommand::snapshotBeforeExecute() {
+    if (!_hasSnapshot && _controller) {
+        _pageBefore = _controller->currentPage();
+        _hasSnapshot = (_pageBefore >= 1);
+    }
+}
+
+void PageNavigationCommand::undo() {
+    if (_controller && _hasSnapshot) {
+        _controller->goToPage(_pageBefore);
+    }
+}
+
+bool PageNavigationCommand::mergeWith(Command* other) {
+    // 仅同一控制器上的连续导航可压缩；本命令的快照更早，保留它，
+    // undo即回到整段导航之前
+    auto* nav = qobject_cast<PageNavigationCommand*>(other);
+    return nav && nav->_controller == _controller;
+}
+
 PrevPageCommand::PrevPageCommand(PageController* controller, QObject* parent)
-    : Command(parent), _controller(controller) {}
+    : PageNavigationCommand(controller, parent) {}
 
 void PrevPageCommand::execute() {
     if (_controller) {
+        snapshotBeforeExecute();
         _controller->goToPrevPage();
     }
 }
 
 NextPageCommand::NextPageCommand(PageController* controller, QObject* parent)
-    : Command(parent), _controller(controller) {}
+    : PageNavigationCommand(controller, parent) {}
 
 void NextPageCommand::execute() {
     if (_controller) {
+        snapshotBeforeExecute();
         _controller->goToNextPage();
     }
 }
+
+CompositeCommand::CompositeCommand(QObject* parent) : Command(parent) {}
+
+void CompositeCommand::addCommand(Command* command) {
+    if (command) {
+        command->setParent(this);
+        _commands.append(command);
+    }
+}
+
+void CompositeCommand::addBatchedModel(PageModel* model) {
+    if (model && !_models.contains(model)) {
+        _models.append(model);
+    }
+}
+
+void CompositeCommand::execute() {
+    for (PageModel* model : _models) {
+        model->beginUpdateBatch();
+    }
+    for (Command* command : _commands) {
+        command->execute();
+    }
+    for (PageModel* model : _models) {
+        model->endUpdateBatch();
+    }
+}
+
+bool CompositeCommand::isUndoable() const {
+    if (_commands.isEmpty()) {
+        return false;
+    }
+    for (Command* command : _commands) {
+        if (!command->isUndoable()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void CompositeCommand::undo() {
+    for (PageModel* model : _models) {
+        model->beginUpdateBatch();
+    }
+    for (auto it = _commands.crbegin(); it != _commands.crend(); ++it) {
+        (*it)->undo();
+    }
+    for (PageModel* model : _models) {
+        model->endUpdateBatch();
+    }
+}
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <QList>
 #include <QMessageBox>
 #include <QObject>
 
 class PageController;
+class PageModel;
 
 class Command : public QObject {
     Q_OBJECT
@@ -12,11 +14,49 @@ public:
     explicit Command(QObject* parent = nullptr);
     virtual ~Command() = default;
 
+    // 撤销支持：默认命令不可撤销
+    virtual bool isUndoable() const { return false; }
+    virtual void undo() {}
+
+    // 历史压缩：若本命令能吸收other（如连续翻页），返回true，
+    // other不再单独入栈（见CommandHistory::push）
+    virtual bool mergeWith(Command* other) {
+        Q_UNUSED(other);
+        return false;
+    }
+
 public slots:
     virtual void execute() = 0;
 };
 
-class PrevPageCommand : public Command {
+/**
+ * 页面导航命令基类：execute前记录页码快照，undo一次回到快照页。
+ * 同一控制器上的连续导航命令可互相合并，按住翻页键产生的
+ * 数百个微命令在历史中压缩为一条记录。
+ */
+class PageNavigationCommand : public Command {
+    Q_OBJECT
+
+public:
+    explicit PageNavigationCommand(PageController* controller,
+                                   QObject* parent = nullptr);
+
+    bool isUndoable() const override { return true; }
+    void undo() override;
+    bool mergeWith(Command* other) override;
+
+protected:
+    // 子类在execute开头调用；只记录第一次执行前的页码
+    void snapshotBeforeExecute();
+
+    PageController* _controller;
+
+private:
+    int _pageBefore;
+    bool _hasSnapshot;
+};
+
+class PrevPageCommand : public PageNavigationCommand {
     Q_OBJECT
 
 public:
@@ -25,21 +65,49 @@ public:
 
 public slots:
     void execute() override;
-
-private:
-    PageController* _controller;
 };
 
-class NextPageCommand : public Command {
+class NextPageCommand : public PageNavigationCommand {
     Q_OBJECT
 
 public:
     explicit NextPageCommand(PageController* controller,
                              QObject* parent = nullptr);
 
+public slots:
+    void execute() override;
+};
+
+/**
+ * 复合命令：把一组子命令当作一次操作执行与撤销。
+ *
+ * 宏操作逐条执行时每个子命令都触发模型通知、UI随之逐次重绘；
+ * 通过addBatchedModel注册的模型在执行期间进入批量更新作用域
+ * （见PageModel::beginUpdateBatch），通知折叠到批次结束只发一次。
+ * 撤销按逆序执行，同样批量。
+ */
+class CompositeCommand : public Command {
+    Q_OBJECT
+
+public:
+    explicit CompositeCommand(QObject* parent = nullptr);
+
+    // 取得command所有权
+    void addCommand(Command* command);
+
+    // 执行/撤销期间折叠model的通知
+    void addBatchedModel(PageModel* model);
+
+    int commandCount() const { return _commands.size(); }
+
+    // 所有子命令均可撤销时整体才可撤销
+    bool isUndoable() const override;
+    void undo() override;
+
 public slots:
     void execute() override;
 
 private:
-    PageController* _controller;
+    QList<Command*> _commands;
+    QList<PageModel*> _models;
 };
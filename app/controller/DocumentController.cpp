@@ -9,6 +9,7 @@
 #include <QStandardPaths>
 #include <QStringList>
 #include "../ui/dialogs/DocumentMetadataDialog.h"
+#include "TaskPipeline.h"
 #include "utils/LoggingMacros.h"
 
 void DocumentController::initializeCommandMap() {
@@ -21,8 +22,7 @@ void DocumentController::initializeCommandMap() {
                      QStandardPaths::DocumentsLocation),
                  tr("PDF Files (*.pdf)"));
              if (!filePaths.isEmpty()) {
-                 bool success = openDocuments(filePaths);
-                 emit documentOperationCompleted(ActionMap::openFile, success);
+                 openDocumentsAsync(filePaths, ActionMap::openFile);
              }
          }},
         {ActionMap::openFolder,
@@ -33,15 +33,22 @@ void DocumentController::initializeCommandMap() {
                      QStandardPaths::DocumentsLocation),
                  QFileDialog::ShowDirsOnly | QFileDialog::DontResolveSymlinks);
              if (!folderPath.isEmpty()) {
-                 QStringList pdfFiles = scanFolderForPDFs(folderPath);
-                 if (!pdfFiles.isEmpty()) {
-                     bool success = openDocuments(pdfFiles);
-                     emit documentOperationCompleted(ActionMap::openFolder,
-                                                     success);
-                 } else {
-                     emit documentOperationCompleted(ActionMap::openFolder,
-                                                     false);
-                 }
+                 // 递归扫描大目录是纯IO，放到后台阶段，避免卡住GUI线程
+                 TaskPipeline::create(this)
+                     ->then(TaskPipeline::Stage::Background,
+                            [folderPath](QVariant&&) -> QVariant {
+                                return scanFolderForPDFs(folderPath);
+                            })
+                     ->then(TaskPipeline::Stage::Gui,
+                            [this](QVariant&& scanned) -> QVariant {
+                                QStringList pdfFiles = scanned.toStringList();
+                                bool success = !pdfFiles.isEmpty() &&
+                                               openDocuments(pdfFiles);
+                                emit documentOperationCompleted(
+                                    ActionMap::openFolder, success);
+                                return QVariant();
+                            })
+                     ->run();
              }
          }},
         {ActionMap::save, [this](QWidget* ctx) { /*....save()....*/ }},
@@ -116,53 +123,8 @@ void DocumentController::initializeCommandMap() {
          [this](QWidget* ctx) {
              emit viewModeChangeRequested(1);  // ContinuousScroll
          }},
-        // 页面导航操作
-        {ActionMap::firstPage,
-         [this](QWidget* ctx) {
-             emit pdfActionRequested(ActionMap::firstPage);
-         }},
-        {ActionMap::previousPage,
-         [this](QWidget* ctx) {
-             emit pdfActionRequested(ActionMap::previousPage);
-         }},
-        {ActionMap::nextPage,
-         [this](QWidget* ctx) {
-             emit pdfActionRequested(ActionMap::nextPage);
-         }},
-        {ActionMap::lastPage,
-         [this](QWidget* ctx) {
-             emit pdfActionRequested(ActionMap::lastPage);
-         }},
-        {ActionMap::goToPage,
-         [this](QWidget* ctx) {
-             emit pdfActionRequested(ActionMap::goToPage);
-         }},
-        // 缩放操作
-        {ActionMap::zoomIn,
-         [this](QWidget* ctx) { emit pdfActionRequested(ActionMap::zoomIn); }},
-        {ActionMap::zoomOut,
-         [this](QWidget* ctx) { emit pdfActionRequested(ActionMap::zoomOut); }},
-        {ActionMap::fitToWidth,
-         [this](QWidget* ctx) {
-             emit pdfActionRequested(ActionMap::fitToWidth);
-         }},
-        {ActionMap::fitToPage,
-         [this](QWidget* ctx) {
-             emit pdfActionRequested(ActionMap::fitToPage);
-         }},
-        {ActionMap::fitToHeight,
-         [this](QWidget* ctx) {
-             emit pdfActionRequested(ActionMap::fitToHeight);
-         }},
-        // 旋转操作
-        {ActionMap::rotateLeft,
-         [this](QWidget* ctx) {
-             emit pdfActionRequested(ActionMap::rotateLeft);
-         }},
-        {ActionMap::rotateRight,
-         [this](QWidget* ctx) {
-             emit pdfActionRequested(ActionMap::rotateRight);
-         }},
+        // 页面导航/缩放/旋转命令不在此注册：它们是高频热路径，
+        // 在dispatchHotAction里直接分发
         // 主题操作
         {ActionMap::toggleTheme,
          [this](QWidget* ctx) { emit themeToggleRequested(); }},
@@ -190,7 +152,38 @@ DocumentController::DocumentController(DocumentModel* model)
     initializeCommandMap();
 }
 
+bool DocumentController::dispatchHotAction(ActionMap actionID) {
+    // 按住Page Down或反复缩放时每次重复都落在这里：一个switch
+    // 编译成跳转表，不做哈希、不摸堆、不构造任何参数对象
+    switch (actionID) {
+        case ActionMap::firstPage:
+        case ActionMap::previousPage:
+        case ActionMap::nextPage:
+        case ActionMap::lastPage:
+        case ActionMap::goToPage:
+        case ActionMap::zoomIn:
+        case ActionMap::zoomOut:
+        case ActionMap::fitToWidth:
+        case ActionMap::fitToPage:
+        case ActionMap::fitToHeight:
+        case ActionMap::rotateLeft:
+        case ActionMap::rotateRight:
+            emit pdfActionRequested(actionID);
+            return true;
+        default:
+            return false;
+    }
+}
+
 void DocumentController::execute(ActionMap actionID, QWidget* context) {
+    // 热路径：日志也走快速宏——调试级被过滤时只剩一个分支，
+    // 不为每次按键做字符串格式化
+    if (dispatchHotAction(actionID)) {
+        LOG_FAST_DEBUG("Hot action dispatched: {}",
+                       static_cast<int>(actionID));
+        return;
+    }
+
     LOG_DEBUG("EventID: {} context: {}", static_cast<int>(actionID),
               static_cast<void*>(context));
 
@@ -245,6 +238,43 @@ bool DocumentController::openDocuments(const QStringList& filePaths) {
     return success;
 }
 
+void DocumentController::openDocumentsAsync(const QStringList& filePaths,
+                                            ActionMap completedAction) {
+    // 与openDocuments相同的流程，但把存在性检查挪到后台阶段：
+    // QFile::exists在网络盘上可能逐个文件往返共享，批量选择时会
+    // 明显卡住GUI线程。实际打开仍回到GUI线程走DocumentModel
+    TaskPipeline::create(this)
+        ->then(TaskPipeline::Stage::Background,
+               [filePaths](QVariant&&) -> QVariant {
+                   QStringList validPaths;
+                   for (const QString& filePath : filePaths) {
+                       if (!filePath.isEmpty() && QFile::exists(filePath) &&
+                           filePath.toLower().endsWith(".pdf")) {
+                           validPaths.append(filePath);
+                       }
+                   }
+                   return validPaths;
+               })
+        ->then(TaskPipeline::Stage::Gui,
+               [this, completedAction](QVariant&& valid) -> QVariant {
+                   QStringList validPaths = valid.toStringList();
+                   bool success = false;
+                   if (validPaths.isEmpty()) {
+                       LOG_WARNING("No valid PDF files found in the selection");
+                   } else {
+                       success = documentModel->openFromFiles(validPaths);
+                       if (success && recentFilesManager) {
+                           for (const QString& filePath : validPaths) {
+                               recentFilesManager->addRecentFile(filePath);
+                           }
+                       }
+                   }
+                   emit documentOperationCompleted(completedAction, success);
+                   return QVariant();
+               })
+        ->run();
+}
+
 bool DocumentController::closeDocument(int index) {
     return documentModel->closeDocument(index);
 }
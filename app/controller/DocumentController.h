@@ -21,6 +21,12 @@ private:
     RecentFilesManager* recentFilesManager;
     QHash<ActionMap, std::function<void(QWidget*)>> commandMap;
     void initializeCommandMap();
+    // 热路径直接分发：纯转发型命令（翻页/缩放/旋转等，按住按键时
+    // 每次重复都会进入execute）在编译期switch里直接发信号，不经过
+    // commandMap的哈希查找和std::function间接层。命中返回true；
+    // 返回false的冷命令回落到commandMap。commandMap保留为通用入口，
+    // 供对话框类、需要QWidget上下文的命令使用
+    bool dispatchHotAction(ActionMap actionID);
 
 public:
     DocumentController(DocumentModel* model);
@@ -30,14 +36,19 @@ public:
     // 多文档操作方法
     bool openDocument(const QString& filePath);
     bool openDocuments(const QStringList& filePaths);
+
+    // 异步打开：文件存在性检查在后台阶段执行（网络盘上可能很慢），
+    // 实际打开回到GUI线程，完成后发出documentOperationCompleted
+    void openDocumentsAsync(const QStringList& filePaths,
+                            ActionMap completedAction);
     bool closeDocument(int index);
     bool closeCurrentDocument();
     void switchToDocument(int index);
     void showDocumentMetadata(QWidget* parent);
     void saveDocumentCopy(QWidget* parent);
 
-    // 文件夹扫描功能
-    QStringList scanFolderForPDFs(const QString& folderPath);
+    // 文件夹扫描功能（纯IO，可在后台线程调用）
+    static QStringList scanFolderForPDFs(const QString& folderPath);
 
     // 最近文件管理
     void setRecentFilesManager(RecentFilesManager* manager);
@@ -4,6 +4,16 @@
 PageController::PageController(PageModel* model, QObject* parent)
     : QObject(parent), _model(model) {}
 
+int PageController::currentPage() const {
+    return _model ? _model->currentPage() : -1;
+}
+
+void PageController::goToPage(int pageNum) {
+    if (_model) {
+        _model->setCurrentPage(pageNum);
+    }
+}
+
 void PageController::goToNextPage() {
     if (_model) {
         _model->nextPage();
@@ -10,6 +10,10 @@ public:
     PageController(PageModel* model, QObject* parent = nullptr);
     ~PageController(){};
 
+    // 供可撤销命令使用：读取/恢复当前页码（无模型时返回-1）
+    int currentPage() const;
+    void goToPage(int pageNum);
+
 public slots:
     void goToNextPage();
     void goToPrevPage();
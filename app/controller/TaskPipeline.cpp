@@ -0,0 +1,79 @@
+#include "TaskPipeline.h"
+#include "../managers/RenderScheduler.h"
+
+TaskPipeline* TaskPipeline::create(QObject* context) {
+    return new TaskPipeline(context);
+}
+
+TaskPipeline::TaskPipeline(QObject* context)
+    : QObject(nullptr), context(context), started(false) {}
+
+TaskPipeline* TaskPipeline::then(Stage affinity,
+                                 std::function<QVariant(QVariant&&)> fn) {
+    stages.append({affinity, std::move(fn)});
+    return this;
+}
+
+void TaskPipeline::run(QVariant&& initial) {
+    if (started) {
+        return;
+    }
+    started = true;
+    runFrom(0, std::move(initial), false);
+}
+
+void TaskPipeline::runFrom(int index, QVariant&& value, bool onWorker) {
+    // 相邻的同线程阶段内联串行执行，只在线程切换处排一次队
+    while (index < stages.size()) {
+        if (!onWorker && context.isNull()) {
+            // 所属对象已销毁，放弃剩余阶段
+            deleteLater();
+            return;
+        }
+        StageEntry& stage = stages[index];
+        bool wantWorker = (stage.affinity == Stage::Background);
+        if (wantWorker != onWorker) {
+            break;
+        }
+        value = stage.fn(std::move(value));
+        ++index;
+    }
+
+    if (index >= stages.size()) {
+        deliver(std::move(value), onWorker);
+        return;
+    }
+
+    if (!onWorker) {
+        // GUI → 后台：进入进程级线程池的低优先级档
+        RenderScheduler::instance().submit(
+            RenderScheduler::TaskClass::Background,
+            [this, index, value = std::move(value)]() mutable {
+                runFrom(index, std::move(value), true);
+            });
+    } else {
+        // 后台 → GUI：经事件队列回到GUI线程
+        QMetaObject::invokeMethod(
+            this,
+            [this, index, value = std::move(value)]() mutable {
+                runFrom(index, std::move(value), false);
+            },
+            Qt::QueuedConnection);
+    }
+}
+
+void TaskPipeline::deliver(QVariant&& value, bool onWorker) {
+    if (onWorker) {
+        QMetaObject::invokeMethod(
+            this,
+            [this, value = std::move(value)]() mutable {
+                deliver(std::move(value), false);
+            },
+            Qt::QueuedConnection);
+        return;
+    }
+    if (!context.isNull()) {
+        emit finished(std::move(value));
+    }
+    deleteLater();
+}
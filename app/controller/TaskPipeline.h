@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+#include <QVariant>
+#include <QVector>
+#include <functional>
+
+/**
+ * 控制器层的异步任务管道
+ *
+ * 打开文档这类复合流程（打开 → 恢复位置 → 跳转书签）过去靠层层信号/槽
+ * 接力，每一跳都要在GUI线程事件队列里排一次队。TaskPipeline 把这类流程
+ * 写成一条显式的续延链：每个阶段声明自己在GUI线程还是后台线程执行，
+ * 相邻的同线程阶段直接内联串行执行、不经过事件循环，只有线程切换处
+ * 才产生一次排队。阶段间的结果通过 QVariant 移动传递，不做拷贝。
+ *
+ * 后台阶段提交到 RenderScheduler 的 Background 优先级，与索引构建等
+ * 低优先级工作共享同一个进程级线程池。
+ *
+ * 用法：
+ *     TaskPipeline::create(this)
+ *         ->then(TaskPipeline::Stage::Background,
+ *                [](QVariant&&) -> QVariant { ... })
+ *         ->then(TaskPipeline::Stage::Gui,
+ *                [this](QVariant&& v) -> QVariant { ... })
+ *         ->run();
+ *
+ * 管道对象在最后一个阶段完成后自行销毁。context（通常是发起流程的
+ * 控制器）被销毁后，剩余的GUI阶段不再执行；已经在池里的后台阶段无法
+ * 安全中断，会照常跑完但结果被丢弃，因此后台阶段不得捕获 context 的
+ * 成员指针。
+ */
+class TaskPipeline : public QObject {
+    Q_OBJECT
+
+public:
+    enum class Stage {
+        Gui,        // 必须在GUI线程执行（访问模型/控件/发信号）
+        Background  // 可在线程池执行（IO、扫描、解析）
+    };
+
+    // context：流程所属的对象。管道不以它为父对象，但它析构后管道
+    // 放弃剩余的GUI阶段
+    static TaskPipeline* create(QObject* context);
+
+    // 追加一个阶段：接收上一阶段移动过来的结果，返回传给下一阶段的值
+    TaskPipeline* then(Stage affinity, std::function<QVariant(QVariant&&)> fn);
+
+    // 启动管道（须在GUI线程调用）
+    void run(QVariant&& initial = QVariant());
+
+signals:
+    // 所有阶段完成后在GUI线程发出
+    void finished(QVariant result);
+
+private:
+    explicit TaskPipeline(QObject* context);
+
+    void runFrom(int index, QVariant&& value, bool onWorker);
+    void deliver(QVariant&& value, bool onWorker);
+
+    struct StageEntry {
+        Stage affinity;
+        std::function<QVariant(QVariant&&)> fn;
+    };
+
+    QPointer<QObject> context;
+    QVector<StageEntry> stages;
+    bool started;
+};
@@ -29,6 +29,7 @@ ThumbnailDelegate::ThumbnailDelegate(QObject* parent)
       m_pageNumberHeight(DEFAULT_PAGE_NUMBER_HEIGHT),
       m_shadowEnabled(true),
       m_animationEnabled(true),
+      m_fastScrollMode(false),
       m_shadowBlurRadius(DEFAULT_SHADOW_BLUR_RADIUS),
       m_shadowOffset(DEFAULT_SHADOW_OFFSET),
       m_borderWidth(DEFAULT_BORDER_WIDTH),
@@ -65,20 +66,84 @@ void ThumbnailDelegate::paint(QPainter* painter,
     }
 
     painter->save();
-    painter->setRenderHint(QPainter::Antialiasing);
 
-    // 获取数据
-    QPixmap thumbnail = index.data(ThumbnailModel::PixmapRole).value<QPixmap>();
-    bool isLoading = index.data(ThumbnailModel::LoadingRole).toBool();
-    bool hasError = index.data(ThumbnailModel::ErrorRole).toBool();
-    QString errorMessage =
-        index.data(ThumbnailModel::ErrorMessageRole).toString();
-    int pageNumber = index.data(ThumbnailModel::PageNumberRole).toInt();
+    // 获取数据。直接挂在ThumbnailModel上时走直通快照：一次加锁
+    // 取回全部绘制状态，pixmap以行内指针交付，省去滚动热路径上
+    // 每个可见行每次重绘的五次QVariant装箱和pixmap句柄复制；
+    // 视图套了代理模型时退回逐role访问
+    const QPixmap* thumbnail = nullptr;
+    QPixmap boxedThumbnail;  // 仅role退路持有
+    bool isLoading = false;
+    bool hasError = false;
+    QString errorMessage;
+    int pageNumber = 0;
+
+    if (const auto* model =
+            qobject_cast<const ThumbnailModel*>(index.model())) {
+        // PageNumberRole即行号，直通路径无需再问模型
+        pageNumber = index.row();
+        const ThumbnailModel::PaintSnapshot snapshot =
+            model->paintSnapshot(pageNumber);
+        thumbnail = snapshot.pixmap;
+        isLoading = snapshot.isLoading;
+        hasError = snapshot.hasError;
+        errorMessage = snapshot.errorMessage;
+    } else {
+        boxedThumbnail =
+            index.data(ThumbnailModel::PixmapRole).value<QPixmap>();
+        if (!boxedThumbnail.isNull()) {
+            thumbnail = &boxedThumbnail;
+        }
+        isLoading = index.data(ThumbnailModel::LoadingRole).toBool();
+        hasError = index.data(ThumbnailModel::ErrorRole).toBool();
+        errorMessage = index.data(ThumbnailModel::ErrorMessageRole).toString();
+        pageNumber = index.data(ThumbnailModel::PageNumberRole).toInt();
+    }
 
     // 计算矩形
     QRect thumbnailRect = getThumbnailRect(option.rect);
     QRect pageNumberRect = getPageNumberRect(thumbnailRect);
 
+    // 快速滚动：廉价绘制路径。每帧只可见十几毫秒，
+    // 已缓存的图用快速缩放直接画，没有的画占位底色；
+    // 不画阴影、不开抗锯齿、不跑加载动画
+    if (m_fastScrollMode) {
+        if (thumbnail) {
+            painter->drawPixmap(thumbnailRect, *thumbnail);
+        } else {
+            painter->fillRect(thumbnailRect, m_placeholderColor);
+        }
+        paintPageNumber(painter, pageNumberRect, pageNumber, option);
+        painter->restore();
+        return;
+    }
+
+    // 静态单元（非加载中/出错）走预合成缓存：整格只在状态真正
+    // 变化时重新合成，滚动重绘退化为一次blit，不再每帧重跑
+    // 阴影+圆角边框+缩放+页码的完整合成
+    if (!isLoading && !hasError) {
+        const bool selected = option.state & QStyle::State_Selected;
+        const bool hovered = option.state & QStyle::State_MouseOver;
+        const qreal dpr = painter->device()->devicePixelRatioF();
+        const qint64 pixmapKey = thumbnail ? thumbnail->cacheKey() : 0;
+
+        auto it = m_cellCache.constFind(index.row());
+        if (it == m_cellCache.constEnd() || it->pixmapKey != pixmapKey ||
+            it->selected != selected || it->hovered != hovered ||
+            it->cellSize != option.rect.size() ||
+            !qFuzzyCompare(it->dpr, dpr)) {
+            composeCell(index.row(), thumbnail ? *thumbnail : QPixmap(),
+                        pageNumber, option, dpr);
+        }
+
+        painter->drawPixmap(option.rect.topLeft(),
+                            m_cellCache.value(index.row()).composed);
+        painter->restore();
+        return;
+    }
+
+    painter->setRenderHint(QPainter::Antialiasing);
+
     // 绘制背景
     paintBackground(painter, option.rect, option);
 
@@ -90,13 +155,11 @@ void ThumbnailDelegate::paint(QPainter* painter,
     // 绘制边框
     paintBorder(painter, thumbnailRect, option);
 
-    // 绘制缩略图内容
+    // 动态单元：加载动画/错误指示逐帧变化，不进缓存
     if (hasError) {
         paintErrorIndicator(painter, thumbnailRect, errorMessage, option);
     } else if (isLoading) {
         paintLoadingIndicator(painter, thumbnailRect, option);
-    } else if (!thumbnail.isNull()) {
-        paintThumbnail(painter, thumbnailRect, thumbnail, option);
     }
 
     // 绘制页码
@@ -105,9 +168,55 @@ void ThumbnailDelegate::paint(QPainter* painter,
     painter->restore();
 }
 
+void ThumbnailDelegate::composeCell(int row, const QPixmap& thumbnail,
+                                    int pageNumber,
+                                    const QStyleOptionViewItem& option,
+                                    qreal dpr) const {
+    const QSize cellSize = option.rect.size();
+    QPixmap composed(cellSize * dpr);
+    composed.setDevicePixelRatio(dpr);
+    composed.fill(Qt::transparent);
+
+    // 用(0,0)原点的副本走既有的各paintXxx，合成结果与直接绘制一致
+    QStyleOptionViewItem local = option;
+    local.rect = QRect(QPoint(0, 0), cellSize);
+    const QRect thumbnailRect = getThumbnailRect(local.rect);
+    const QRect pageNumberRect = getPageNumberRect(thumbnailRect);
+
+    QPainter cellPainter(&composed);
+    cellPainter.setRenderHint(QPainter::Antialiasing);
+    paintBackground(&cellPainter, local.rect, local);
+    if (m_shadowEnabled) {
+        paintShadow(&cellPainter, thumbnailRect, local);
+    }
+    paintBorder(&cellPainter, thumbnailRect, local);
+    if (!thumbnail.isNull()) {
+        paintThumbnail(&cellPainter, thumbnailRect, thumbnail, local);
+    }
+    paintPageNumber(&cellPainter, pageNumberRect, pageNumber, local);
+    cellPainter.end();
+
+    // 简单上限：满了整体清空，下一轮滚动按需重建
+    if (m_cellCache.size() >= CELL_CACHE_MAX) {
+        m_cellCache.clear();
+    }
+
+    CellCacheEntry entry;
+    entry.composed = composed;
+    entry.pixmapKey = thumbnail.isNull() ? 0 : thumbnail.cacheKey();
+    entry.selected = option.state & QStyle::State_Selected;
+    entry.hovered = option.state & QStyle::State_MouseOver;
+    entry.cellSize = cellSize;
+    entry.dpr = dpr;
+    m_cellCache.insert(row, entry);
+}
+
+void ThumbnailDelegate::invalidateCellCache() { m_cellCache.clear(); }
+
 void ThumbnailDelegate::setThumbnailSize(const QSize& size) {
     if (m_thumbnailSize != size) {
         m_thumbnailSize = size;
+        invalidateCellCache();
         emit sizeHintChanged(QModelIndex());
     }
 }
@@ -115,14 +224,23 @@ void ThumbnailDelegate::setThumbnailSize(const QSize& size) {
 void ThumbnailDelegate::setMargins(int margin) {
     if (m_margin != margin) {
         m_margin = margin;
+        invalidateCellCache();
         emit sizeHintChanged(QModelIndex());
     }
 }
 
-void ThumbnailDelegate::setBorderRadius(int radius) { m_borderRadius = radius; }
+void ThumbnailDelegate::setBorderRadius(int radius) {
+    m_borderRadius = radius;
+    invalidateCellCache();
+}
 
 void ThumbnailDelegate::setShadowEnabled(bool enabled) {
     m_shadowEnabled = enabled;
+    invalidateCellCache();
+}
+
+void ThumbnailDelegate::setFastScrollMode(bool fast) {
+    m_fastScrollMode = fast;
 }
 
 void ThumbnailDelegate::setAnimationEnabled(bool enabled) {
@@ -143,6 +261,7 @@ void ThumbnailDelegate::setLightTheme() {
     m_loadingColor = GOOGLE_BLUE;
     m_errorColor = GOOGLE_RED;
     m_placeholderColor = QColor(200, 200, 200);
+    invalidateCellCache();
 }
 
 void ThumbnailDelegate::setDarkTheme() {
@@ -156,6 +275,7 @@ void ThumbnailDelegate::setDarkTheme() {
     m_loadingColor = GOOGLE_BLUE;
     m_errorColor = GOOGLE_RED;
     m_placeholderColor = QColor(100, 100, 100);
+    invalidateCellCache();
 }
 
 void ThumbnailDelegate::setCustomColors(const QColor& background,
@@ -168,6 +288,7 @@ void ThumbnailDelegate::setCustomColors(const QColor& background,
     m_borderColorSelected = accent;
     m_pageNumberTextColor = text;
     m_loadingColor = accent;
+    invalidateCellCache();
 }
 
 bool ThumbnailDelegate::eventFilter(QObject* object, QEvent* event) {
@@ -63,12 +63,20 @@ public:
     void setAnimationEnabled(bool enabled);
     bool animationEnabled() const { return m_animationEnabled; }
 
+    // 快速滚动模式：只画占位底色/快速缩放的已有缓存，
+    // 跳过阴影、抗锯齿和加载动画（见ThumbnailListView的速度判定）
+    void setFastScrollMode(bool fast);
+    bool fastScrollMode() const { return m_fastScrollMode; }
+
     // 颜色主题
     void setLightTheme();
     void setDarkTheme();
     void setCustomColors(const QColor& background, const QColor& border,
                          const QColor& text, const QColor& accent);
 
+    // 丢弃全部预合成单元格（主题/尺寸等全局外观变化时调用）
+    void invalidateCellCache();
+
 protected:
     bool eventFilter(QObject* object, QEvent* event) override;
 
@@ -122,6 +130,20 @@ private:
     Qt::TransformationMode getOptimalTransformationMode(
         const QSize& sourceSize, const QSize& targetSize) const;
 
+    // 预合成单元格缓存：背景、阴影、边框、缩放后的缩略图和页码
+    // 一次性合成进一张pixmap，静态单元的滚动重绘退化为纯blit。
+    // 选中/悬停/缩略图内容/尺寸/DPR任一变化即重新合成
+    struct CellCacheEntry {
+        QPixmap composed;
+        qint64 pixmapKey = 0;  // 源缩略图QPixmap::cacheKey()
+        bool selected = false;
+        bool hovered = false;
+        QSize cellSize;
+        qreal dpr = 1.0;
+    };
+    void composeCell(int row, const QPixmap& thumbnail, int pageNumber,
+                     const QStyleOptionViewItem& option, qreal dpr) const;
+
 private:
     // 尺寸设置
     QSize m_thumbnailSize;
@@ -132,6 +154,7 @@ private:
     // 视觉效果设置
     bool m_shadowEnabled;
     bool m_animationEnabled;
+    bool m_fastScrollMode;
     int m_shadowBlurRadius;
     int m_shadowOffset;
     int m_borderWidth;
@@ -152,6 +175,9 @@ private:
     mutable QHash<QPersistentModelIndex, AnimationState*> m_animationStates;
     QTimer* m_loadingTimer;
 
+    // 按行缓存的预合成单元格
+    mutable QHash<int, CellCacheEntry> m_cellCache;
+
     // 字体
     QFont m_pageNumberFont;
     QFont m_errorFont;
@@ -169,6 +195,7 @@ private:
     static constexpr int LOADING_ANIMATION_INTERVAL = 50;     // ms
     static constexpr int HOVER_ANIMATION_DURATION = 200;      // ms
     static constexpr int SELECTION_ANIMATION_DURATION = 300;  // ms
+    static constexpr int CELL_CACHE_MAX = 256;  // 预合成缓存条目上限
 
     // Chrome风格颜色常量
     static const QColor GOOGLE_BLUE;
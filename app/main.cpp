@@ -1,14 +1,59 @@
 #include <config.h>
 #include <QApplication>
 #include "MainWindow.h"
+#include "managers/RenderWorkerPool.h"
+#include "managers/SingleInstanceGuard.h"
+#include "utils/LatencyMetrics.h"
 #include "utils/LoggingConfig.h"
 #include "utils/LoggingMacros.h"
 #include "utils/LoggingManager.h"
+#include "utils/RenderPolicy.h"
+#include "utils/StartupProfiler.h"
 
 int main(int argc, char** argv) {
+    // First touch anchors the startup clock at process start
+    StartupProfiler::instance().beginPhase(QStringLiteral("QApplication init"));
     QApplication app(argc, argv);
+    StartupProfiler::instance().endPhase(QStringLiteral("QApplication init"));
+
+    // Sandboxed render worker mode: no UI, no logging stack — just the
+    // blocking stdin/stdout render loop driven by RenderWorkerPool
+    if (app.arguments().contains(QStringLiteral("--render-worker"))) {
+        return RenderWorkerPool::runWorkerLoop();
+    }
+
+    if (app.arguments().contains(QStringLiteral("--startup-report"))) {
+        StartupProfiler::instance().setDumpOnFirstPaint(true);
+    }
+
+    // Single-instance mode: hand positional file paths to an already
+    // running instance over a local socket and exit before the logging
+    // and style stacks are even touched — a file-manager double-click
+    // lands in the warm process in milliseconds instead of paying full
+    // process startup. --new-instance opts out for side-by-side use.
+    QStringList fileArguments;
+    const QStringList arguments = app.arguments();
+    for (int i = 1; i < arguments.size(); ++i) {
+        if (!arguments.at(i).startsWith(QLatin1Char('-'))) {
+            fileArguments.append(arguments.at(i));
+        }
+    }
+    if (!arguments.contains(QStringLiteral("--new-instance")) &&
+        SingleInstanceGuard::forwardToRunningInstance(fileArguments)) {
+        return 0;
+    }
+
+    // Low-memory deployment profile (4GB kiosk hardware): one switch,
+    // consulted by RenderPolicy's DPI ceiling, the prerenderer radius,
+    // thumbnail defaults and the cache manager's cold-entry compression.
+    // Must be set before any rendering subsystem is constructed.
+    if (app.arguments().contains(QStringLiteral("--low-memory")) ||
+        qgetenv("READIUM_LOW_MEMORY") == "1") {
+        RenderPolicy::setLowMemoryProfile(true);
+    }
 
     // Initialize logging system
+    StartupProfiler::instance().beginPhase(QStringLiteral("Logging init"));
     LoggingConfigBuilder configBuilder;
     auto loggingConfigPtr = configBuilder
         .useDevelopmentPreset()
@@ -24,6 +69,12 @@ int main(int argc, char** argv) {
     auto loggingConfig = LoggingManager::fromLoggingConfig(*loggingConfigPtr);
 
     LoggingManager::instance().initialize(loggingConfig);
+    StartupProfiler::instance().endPhase(QStringLiteral("Logging init"));
+
+    // Latency histograms ride the logging stack: periodic percentile
+    // summaries plus a GUI-thread frame-budget watchdog
+    LatencyMetrics::instance().startReporting();
+    LatencyMetrics::instance().installGuiWatchdog();
 
     LOG_INFO("Starting SAST Readium application");
     LOG_INFO("Application name: {}", PROJECT_NAME);
@@ -40,10 +91,29 @@ int main(int argc, char** argv) {
     LOG_DEBUG("Application metadata configured");
 
     try {
+        StartupProfiler::instance().beginPhase(
+            QStringLiteral("MainWindow construction"));
         MainWindow w;
+        StartupProfiler::instance().endPhase(
+            QStringLiteral("MainWindow construction"));
         w.show();
         LOG_INFO("Main window created and shown successfully");
 
+        // Become the primary instance: later invocations deliver their
+        // file paths here instead of starting a second process
+        SingleInstanceGuard instanceGuard;
+        if (instanceGuard.listen()) {
+            QObject::connect(&instanceGuard,
+                             &SingleInstanceGuard::filesReceived, &w,
+                             &MainWindow::handleInstanceActivation);
+        }
+
+        // Files passed on our own command line (cold start from a file
+        // manager) go through the same path as a handoff
+        if (!fileArguments.isEmpty()) {
+            w.handleInstanceActivation(fileArguments);
+        }
+
         int result = QApplication::exec();
         LOG_INFO("Application exiting with code: {}", result);
 
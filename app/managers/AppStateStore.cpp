@@ -0,0 +1,183 @@
+#include "AppStateStore.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QStringList>
+#include "RenderScheduler.h"
+#include "utils/LoggingMacros.h"
+
+namespace {
+
+// 'SRST' — SAST Readium STate
+constexpr quint32 STORE_MAGIC = 0x54535253;
+constexpr quint32 STORE_VERSION = 1;
+
+// Sanity bound per record; the store holds tab lists and recent-file
+// metadata, never page pixels
+constexpr quint32 MAX_RECORD_BYTES = 16 * 1024 * 1024;
+
+}  // namespace
+
+AppStateStore& AppStateStore::instance() {
+    static AppStateStore store;
+    return store;
+}
+
+AppStateStore::AppStateStore(QObject* parent)
+    : QObject(parent), m_dirty(false), m_checkpointQueued(0) {
+    loadFromDisk();
+}
+
+AppStateStore::~AppStateStore() {
+    // Static destruction runs after the pool is gone; a queued
+    // checkpoint that never ran left the store dirty, so this catches
+    // it with one synchronous write
+    flush();
+}
+
+QString AppStateStore::storePath() const {
+    const QString dir =
+        QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    return dir + QStringLiteral("/appstate.bin");
+}
+
+void AppStateStore::loadFromDisk() {
+    QFile file(storePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (stream.status() != QDataStream::Ok || magic != STORE_MAGIC ||
+        version != STORE_VERSION) {
+        LOG_WARNING("AppStateStore: ignoring unreadable store at {}",
+                    storePath().toStdString());
+        return;
+    }
+
+    // Sequential record stream; the last record for a name wins, which
+    // is what makes the format safe to append to
+    QMutexLocker locker(&m_mutex);
+    int records = 0;
+    while (!stream.atEnd()) {
+        QString name;
+        QByteArray payload;
+        stream >> name >> payload;
+        if (stream.status() != QDataStream::Ok || name.isEmpty() ||
+            payload.size() > static_cast<int>(MAX_RECORD_BYTES)) {
+            LOG_WARNING(
+                "AppStateStore: truncated record stream after {} records",
+                records);
+            break;
+        }
+        m_sections.insert(name, payload);
+        ++records;
+    }
+    LOG_DEBUG("AppStateStore: loaded {} sections", m_sections.size());
+}
+
+QByteArray AppStateStore::section(const QString& name) const {
+    QMutexLocker locker(&m_mutex);
+    return m_sections.value(name);
+}
+
+void AppStateStore::putSection(const QString& name, const QByteArray& payload) {
+    if (name.isEmpty()) {
+        return;
+    }
+    QMutexLocker locker(&m_mutex);
+    auto it = m_sections.constFind(name);
+    if (it != m_sections.constEnd() && it.value() == payload) {
+        return;  // Unchanged bytes never dirty the store
+    }
+    m_sections.insert(name, payload);
+    m_dirtySections.insert(name);
+    m_dirty = true;
+}
+
+void AppStateStore::removeSection(const QString& name) {
+    QMutexLocker locker(&m_mutex);
+    if (m_sections.remove(name) > 0) {
+        m_dirtySections.insert(name);
+        m_dirty = true;
+    }
+}
+
+void AppStateStore::checkpoint() {
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!m_dirty) {
+            return;
+        }
+    }
+    // One queued writer is enough: the job snapshots at run time, so it
+    // absorbs every change made before it executes
+    if (!m_checkpointQueued.testAndSetAcquire(0, 1)) {
+        return;
+    }
+    RenderScheduler::instance().submit(
+        RenderScheduler::TaskClass::Background, [this]() {
+            writeToDisk();
+            m_checkpointQueued.storeRelease(0);
+        });
+}
+
+void AppStateStore::flush() { writeToDisk(); }
+
+void AppStateStore::writeToDisk() {
+    QMutexLocker io(&m_ioMutex);
+
+    QHash<QString, QByteArray> snapshot;
+    QStringList dirtyNames;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!m_dirty) {
+            return;
+        }
+        snapshot = m_sections;
+        for (const QString& name : m_dirtySections) {
+            dirtyNames.append(name);
+        }
+        m_dirtySections.clear();
+        m_dirty = false;
+    }
+
+    QDir().mkpath(QStandardPaths::writableLocation(
+        QStandardPaths::AppDataLocation));
+
+    QSaveFile file(storePath());
+    bool ok = file.open(QIODevice::WriteOnly);
+    if (ok) {
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_6_0);
+        stream << STORE_MAGIC << STORE_VERSION;
+        for (auto it = snapshot.constBegin(); it != snapshot.constEnd(); ++it) {
+            stream << it.key() << it.value();
+        }
+        ok = stream.status() == QDataStream::Ok && file.commit();
+    }
+
+    if (!ok) {
+        LOG_WARNING("AppStateStore: write failed: {}",
+                    file.errorString().toStdString());
+        // Leave the data for the next checkpoint or the shutdown flush
+        QMutexLocker locker(&m_mutex);
+        for (const QString& name : dirtyNames) {
+            m_dirtySections.insert(name);
+        }
+        m_dirty = true;
+        return;
+    }
+
+    LOG_DEBUG("AppStateStore: wrote {} sections ({} dirty: {})",
+              snapshot.size(), dirtyNames.size(),
+              dirtyNames.join(", ").toStdString());
+}
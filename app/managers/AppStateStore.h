@@ -0,0 +1,74 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QSet>
+#include <QString>
+
+/**
+ * Compact binary store for small app state (recent files, session
+ * tabs, view state).
+ *
+ * This state used to round-trip through QSettings with full
+ * rewrite-on-change semantics, and QSettings::sync() showed up in
+ * shutdown traces at hundreds of ms with large recent lists. The store
+ * keeps each subsystem's state as a named binary section: producers
+ * hand in an already-serialized payload, byte-identical payloads are
+ * ignored, and only a real change marks the store dirty. Checkpoints
+ * write asynchronously on a Background pool thread; flush() is the
+ * synchronous shutdown path and is a no-op when nothing changed, so
+ * shutdown never blocks on serializing state that didn't move.
+ *
+ * On-disk format: a magic/version header followed by a sequential
+ * record stream of (name, payload) pairs. Readers take the last record
+ * for a name, so the format tolerates appended records from future
+ * incremental writers; today every write is one sequential QSaveFile
+ * pass over all sections. A corrupt or unreadable file is ignored and
+ * producers fall back to their legacy QSettings data, which doubles as
+ * the one-time migration path.
+ *
+ * Thread-safe; the same singleton/mutex discipline as the other
+ * manager singletons.
+ */
+class AppStateStore : public QObject {
+    Q_OBJECT
+
+public:
+    static AppStateStore& instance();
+
+    // Payload last loaded or stored for the section; empty if absent.
+    QByteArray section(const QString& name) const;
+
+    // Replaces a section's payload. Safe to call eagerly: identical
+    // bytes leave the store clean.
+    void putSection(const QString& name, const QByteArray& payload);
+
+    void removeSection(const QString& name);
+
+    // Writes the store on a Background pool thread if any section
+    // changed since the last write. Cheap to call often.
+    void checkpoint();
+
+    // Synchronous write for shutdown paths; no-op when clean.
+    void flush();
+
+private:
+    explicit AppStateStore(QObject* parent = nullptr);
+    ~AppStateStore() override;
+
+    QString storePath() const;
+    void loadFromDisk();
+    // Snapshots dirty state under the mutex and performs the single
+    // sequential write; re-marks the store dirty on failure.
+    void writeToDisk();
+
+    mutable QMutex m_mutex;    // guards sections and dirty flags
+    QMutex m_ioMutex;          // serializes actual disk writes
+    QHash<QString, QByteArray> m_sections;
+    QSet<QString> m_dirtySections;
+    bool m_dirty;
+    QAtomicInt m_checkpointQueued;
+};
@@ -0,0 +1,157 @@
+#include "DocumentHasher.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QPointer>
+#include "RenderScheduler.h"
+#include "utils/LoggingMacros.h"
+
+// Incremental state of one background full hash. The file is reopened
+// per chunk (the OS page cache makes that cheap) so no descriptor is
+// held across the job's whole multi-second lifetime.
+struct DocumentHasher::HashJob {
+    QCryptographicHash hash{QCryptographicHash::Sha256};
+    qint64 offset = 0;
+    qint64 expectedSize = 0;
+    qint64 expectedMtime = 0;  // File replaced mid-hash => result dropped
+};
+
+DocumentHasher& DocumentHasher::instance() {
+    static DocumentHasher hasher;
+    return hasher;
+}
+
+DocumentHasher::DocumentHasher(QObject* parent) : QObject(parent) {}
+
+DocumentHasher::~DocumentHasher() {
+    QMutexLocker locker(&m_mutex);
+    qDeleteAll(m_jobs);
+    m_jobs.clear();
+}
+
+QString DocumentHasher::fingerprint(const QString& filePath) {
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_fingerprints.constFind(filePath);
+        if (it != m_fingerprints.constEnd()) {
+            return it.value();
+        }
+    }
+
+    const QFileInfo info(filePath);
+    if (!info.exists()) {
+        return QString();
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QString();
+    }
+
+    // Size + mtime + the file's edges: cheap (two bounded reads) yet
+    // hard to collide for real documents, whose headers and xref
+    // trailers live exactly at those edges
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(QByteArray::number(info.size()));
+    hash.addData(
+        QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+    hash.addData(file.read(EDGE_BYTES));
+    if (info.size() > EDGE_BYTES) {
+        file.seek(qMax<qint64>(EDGE_BYTES, info.size() - EDGE_BYTES));
+        hash.addData(file.read(EDGE_BYTES));
+    }
+    const QString result = QString::fromLatin1(hash.result().toHex());
+
+    QMutexLocker locker(&m_mutex);
+    m_fingerprints.insert(filePath, result);
+    return result;
+}
+
+QString DocumentHasher::fullHash(const QString& filePath) const {
+    QMutexLocker locker(&m_mutex);
+    return m_fullHashes.value(filePath);
+}
+
+void DocumentHasher::requestFullHash(const QString& filePath) {
+    const QFileInfo info(filePath);
+    if (!info.exists()) {
+        return;
+    }
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_fullHashes.contains(filePath) || m_jobs.contains(filePath)) {
+            return;
+        }
+        HashJob* job = new HashJob();
+        job->expectedSize = info.size();
+        job->expectedMtime = info.lastModified().toMSecsSinceEpoch();
+        m_jobs.insert(filePath, job);
+    }
+    hashNextChunk(filePath);
+}
+
+void DocumentHasher::invalidate(const QString& filePath) {
+    QMutexLocker locker(&m_mutex);
+    m_fingerprints.remove(filePath);
+    m_fullHashes.remove(filePath);
+}
+
+void DocumentHasher::hashNextChunk(const QString& filePath) {
+    // One chunk per pool job: renders and index builds preempt freely
+    // between chunks, which is all the I/O throttling a reader needs
+    RenderScheduler::instance().submit(
+        RenderScheduler::TaskClass::Background, [this, filePath]() {
+            HashJob* job;
+            {
+                QMutexLocker locker(&m_mutex);
+                job = m_jobs.value(filePath);
+            }
+            if (!job) {
+                return;
+            }
+
+            QFile file(filePath);
+            const QFileInfo info(filePath);
+            if (!file.open(QIODevice::ReadOnly) ||
+                info.size() != job->expectedSize ||
+                info.lastModified().toMSecsSinceEpoch() !=
+                    job->expectedMtime) {
+                // File vanished or was replaced; a stale hash would be
+                // worse than none
+                LOG_DEBUG(
+                    "DocumentHasher: Abandoning hash of changed file {}",
+                    filePath.toStdString());
+                finishJob(filePath, job, QString());
+                return;
+            }
+
+            file.seek(job->offset);
+            const QByteArray chunk = file.read(CHUNK_BYTES);
+            job->hash.addData(chunk);
+            job->offset += chunk.size();
+
+            if (job->offset < job->expectedSize && !chunk.isEmpty()) {
+                hashNextChunk(filePath);
+                return;
+            }
+            finishJob(filePath, job,
+                      QString::fromLatin1(job->hash.result().toHex()));
+        });
+}
+
+void DocumentHasher::finishJob(const QString& filePath, HashJob* job,
+                               const QString& result) {
+    {
+        QMutexLocker locker(&m_mutex);
+        m_jobs.remove(filePath);
+        if (!result.isEmpty()) {
+            m_fullHashes.insert(filePath, result);
+        }
+    }
+    delete job;
+    if (!result.isEmpty()) {
+        emit fullHashReady(filePath, fingerprint(filePath), result);
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+
+/**
+ * Process-wide content hashing service for document files.
+ *
+ * Cache namespacing and duplicate detection want content hashes, but
+ * hashing a multi-GB scan synchronously would stall exactly the open
+ * path it is meant to speed up. Callers therefore get two tiers:
+ *
+ *  - fingerprint(): size + mtime + MD5 of the first and last megabyte.
+ *    Computed synchronously on first request (two small reads) and
+ *    memoized; good enough to key caches immediately.
+ *  - full hash: the whole file, hashed in fixed-size chunks as
+ *    background jobs on the shared render pool. Each chunk is one job,
+ *    so hashing never monopolizes a pool thread or the disk — renders
+ *    and extraction interleave between chunks. fullHashReady carries
+ *    the fingerprint alongside so fingerprint-keyed state can be
+ *    reconciled once the real content hash exists.
+ *
+ * AsyncDocumentLoader kicks off the full hash when a load starts, so
+ * hashing overlaps Poppler's own parse of the same file.
+ */
+class DocumentHasher : public QObject {
+    Q_OBJECT
+
+public:
+    static DocumentHasher& instance();
+
+    // Immediate fingerprint for cache keying; empty for missing files
+    QString fingerprint(const QString& filePath);
+
+    // Full content hash, or empty while the background pass is still
+    // running (or was never requested)
+    QString fullHash(const QString& filePath) const;
+
+    // Starts chunked background hashing; no-op if already running or
+    // done for this file
+    void requestFullHash(const QString& filePath);
+
+    // Drops the memoized fingerprint and full hash for a path whose
+    // content changed on disk (called by DocumentVersionBus). An
+    // in-flight chunked hash needs no handling here: its size/mtime
+    // guard abandons it on the next chunk.
+    void invalidate(const QString& filePath);
+
+signals:
+    void fullHashReady(const QString& filePath, const QString& fingerprint,
+                       const QString& fullHash);
+
+private:
+    explicit DocumentHasher(QObject* parent = nullptr);
+    ~DocumentHasher() override;
+
+    struct HashJob;
+    void hashNextChunk(const QString& filePath);
+    void finishJob(const QString& filePath, HashJob* job,
+                   const QString& result);
+
+    mutable QMutex m_mutex;
+    QHash<QString, QString> m_fingerprints;  // Memoized per path
+    QHash<QString, QString> m_fullHashes;
+    QHash<QString, HashJob*> m_jobs;  // In-flight background hashes
+
+    static constexpr qint64 EDGE_BYTES = 1024 * 1024;       // Fingerprint
+    static constexpr qint64 CHUNK_BYTES = 8 * 1024 * 1024;  // Per job
+};
@@ -0,0 +1,117 @@
+#include "DocumentPrewarmer.h"
+#include <poppler-qt6.h>
+#include <QImage>
+#include <QPointer>
+#include <QSettings>
+#include <QSize>
+#include <QTimer>
+#include <memory>
+#include "RecentFilesManager.h"
+#include "RenderScheduler.h"
+#include "cache/DiskRenderCache.h"
+#include "utils/LoggingMacros.h"
+
+DocumentPrewarmer::DocumentPrewarmer(QObject* parent)
+    : QObject(parent), m_enabled(false) {
+    QSettings settings;
+    m_enabled = settings.value("prewarm/enabled", false).toBool();
+}
+
+void DocumentPrewarmer::setEnabled(bool enabled) {
+    m_enabled = enabled;
+    QSettings settings;
+    settings.setValue("prewarm/enabled", enabled);
+}
+
+void DocumentPrewarmer::prewarmTopRecent(RecentFilesManager* manager) {
+    if (!m_enabled || !manager) {
+        return;
+    }
+
+    // Give the UI a head start; the warm-up is strictly speculative and
+    // must never compete with startup work
+    QPointer<DocumentPrewarmer> self(this);
+    QPointer<RecentFilesManager> managerGuard(manager);
+    QTimer::singleShot(PREWARM_START_DELAY_MS, this, [self, managerGuard]() {
+        if (!self || !managerGuard || !managerGuard->hasRecentFiles()) {
+            return;
+        }
+
+        const QList<RecentFileInfo> recent = managerGuard->getRecentFiles();
+        if (recent.isEmpty() || !recent.first().isValid()) {
+            return;
+        }
+
+        const QString filePath = recent.first().filePath;
+        RenderScheduler::instance().submit(
+            RenderScheduler::TaskClass::Background, [self, filePath]() {
+                if (self) {
+                    self->runPrewarm(filePath);
+                }
+            });
+    });
+}
+
+void DocumentPrewarmer::runPrewarm(const QString& filePath) {
+    const QString hash = DiskRenderCache::hashForFile(filePath);
+    if (hash.isEmpty()) {
+        return;
+    }
+
+    // The disk tier is plain files keyed by document hash, so a local
+    // instance writes entries every other cache client can read back
+    DiskRenderCache cache;
+    cache.setDocumentHash(hash);
+
+    std::unique_ptr<Poppler::Document> document(
+        Poppler::Document::load(filePath));
+    if (!document || document->isLocked()) {
+        LOG_DEBUG("DocumentPrewarmer: Cannot open {}, skipping",
+                  filePath.toStdString());
+        return;
+    }
+    document->setRenderHint(Poppler::Document::Antialiasing, true);
+    document->setRenderHint(Poppler::Document::TextAntialiasing, true);
+
+    int warmed = 0;
+    const int pageCount = document->numPages();
+
+    // First page at screen resolution: the pixmap the viewer wants the
+    // instant the entry is clicked. Sized entries key on their explicit
+    // pixel size (QSize() is reserved for the default thumbnail)
+    if (pageCount > 0) {
+        std::unique_ptr<Poppler::Page> first(document->page(0));
+        if (first) {
+            QImage preview = first->renderToImage(PREVIEW_DPI, PREVIEW_DPI);
+            if (!preview.isNull() && !cache.contains(0, preview.size(), 0)) {
+                if (cache.store(0, preview.size(), 0, preview)) {
+                    warmed++;
+                }
+            }
+        }
+    }
+
+    // Leading thumbnail strip under the QSize() sentinel, matching the
+    // read path in PDFCacheManager::getThumbnail
+    const int stripEnd = qMin(pageCount, PREWARM_THUMBNAIL_PAGES);
+    for (int i = 0; i < stripEnd; ++i) {
+        if (cache.contains(i, QSize(), 0)) {
+            continue;
+        }
+        std::unique_ptr<Poppler::Page> page(document->page(i));
+        if (!page) {
+            continue;
+        }
+        const QSizeF pageSize = page->pageSizeF();
+        const double dpi =
+            pageSize.width() > 0 ? 72.0 * 160.0 / pageSize.height() : 72.0;
+        QImage thumbnail = page->renderToImage(dpi, dpi);
+        if (!thumbnail.isNull() && cache.store(i, QSize(), 0, thumbnail)) {
+            warmed++;
+        }
+    }
+
+    LOG_DEBUG("DocumentPrewarmer: Warmed {} entries for {}", warmed,
+              filePath.toStdString());
+    emit prewarmFinished(filePath, warmed);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+
+class RecentFilesManager;
+
+/**
+ * Opt-in startup pre-warm service.
+ *
+ * RecentFilesManager knows which document the user is most likely to
+ * open next, but that knowledge went unused at startup. Once the UI is
+ * up, this service speculatively opens the top recent document's
+ * Poppler handle on a background-priority pool thread and fills the
+ * persistent render cache with its first-page preview and leading
+ * thumbnail strip. Clicking the top entry in RecentFileListWidget then
+ * paints from the mmap-backed disk tier instead of waiting on a cold
+ * Poppler parse and render.
+ *
+ * The speculative I/O is opt-in: nothing runs unless the
+ * "prewarm/enabled" settings key is set (or setEnabled(true) is
+ * called), so users who did not ask for it pay nothing.
+ */
+class DocumentPrewarmer : public QObject {
+    Q_OBJECT
+
+public:
+    explicit DocumentPrewarmer(QObject* parent = nullptr);
+
+    bool isEnabled() const { return m_enabled; }
+    void setEnabled(bool enabled);
+
+    // Schedules the pre-warm for after the event loop has settled; the
+    // top recent entry is read at fire time, not at call time
+    void prewarmTopRecent(RecentFilesManager* manager);
+
+signals:
+    void prewarmFinished(const QString& filePath, int pagesWarmed);
+
+private:
+    void runPrewarm(const QString& filePath);
+
+    bool m_enabled;
+
+    static constexpr int PREWARM_THUMBNAIL_PAGES = 8;
+    static constexpr int PREWARM_START_DELAY_MS = 1500;
+    static constexpr double PREVIEW_DPI = 96.0;
+};
@@ -0,0 +1,235 @@
+#include "DocumentQuarantine.h"
+#include <QDateTime>
+#include <QMutexLocker>
+#include <QSettings>
+#include <QVariant>
+#include "cache/DiskRenderCache.h"
+#include "utils/LoggingMacros.h"
+
+namespace {
+QSettings* quarantineSettings() {
+    // Own settings scope, same convention as the cache manager's
+    static QSettings settings("SAST", "Readium-Quarantine");
+    return &settings;
+}
+}  // namespace
+
+DocumentQuarantine& DocumentQuarantine::instance() {
+    static DocumentQuarantine registry;
+    return registry;
+}
+
+DocumentQuarantine::DocumentQuarantine(QObject* parent) : QObject(parent) {
+    load();
+}
+
+QString DocumentQuarantine::diagnosisFor(const QString& filePath) const {
+    const QString fingerprint = DiskRenderCache::hashForFile(filePath);
+    if (fingerprint.isEmpty()) {
+        return QString();
+    }
+    QMutexLocker locker(&m_mutex);
+    return m_documents.value(fingerprint).diagnosis;
+}
+
+void DocumentQuarantine::beginAttempt(const QString& filePath) {
+    const QString fingerprint = DiskRenderCache::hashForFile(filePath);
+    if (fingerprint.isEmpty()) {
+        return;
+    }
+    QMutexLocker locker(&m_mutex);
+    m_attempts.insert(fingerprint, filePath);
+    save();  // Must hit disk before the risky parse starts
+}
+
+void DocumentQuarantine::endAttempt(const QString& filePath) {
+    const QString fingerprint = DiskRenderCache::hashForFile(filePath);
+    if (fingerprint.isEmpty()) {
+        return;
+    }
+    QMutexLocker locker(&m_mutex);
+    if (m_attempts.remove(fingerprint) > 0) {
+        save();
+    }
+}
+
+void DocumentQuarantine::recordDocumentFailure(const QString& filePath,
+                                               const QString& diagnosis) {
+    const QString fingerprint = DiskRenderCache::hashForFile(filePath);
+    if (fingerprint.isEmpty()) {
+        return;
+    }
+    QMutexLocker locker(&m_mutex);
+    m_attempts.remove(fingerprint);
+    insertEntryLocked(fingerprint, filePath, diagnosis);
+    save();
+    LOG_WARNING("DocumentQuarantine: quarantined {} ({})",
+                filePath.toStdString(), diagnosis.toStdString());
+}
+
+void DocumentQuarantine::recordPageHang(const QString& documentHash,
+                                        int pageNumber) {
+    if (documentHash.isEmpty() || pageNumber < 0) {
+        return;
+    }
+    QMutexLocker locker(&m_mutex);
+    if (!m_badPages.contains(documentHash) &&
+        m_badPages.size() >= MAX_PAGE_DOCUMENTS) {
+        // Self-resetting bound, like the cache's touch records: rare
+        // enough that relearning a hang beats tracking an LRU here
+        m_badPages.clear();
+    }
+    QSet<int>& pages = m_badPages[documentHash];
+    if (pages.contains(pageNumber)) {
+        return;
+    }
+    pages.insert(pageNumber);
+    save();
+    LOG_WARNING("DocumentQuarantine: page {} of document {} quarantined",
+                pageNumber, documentHash.toStdString());
+}
+
+QSet<int> DocumentQuarantine::quarantinedPages(
+    const QString& documentHash) const {
+    QMutexLocker locker(&m_mutex);
+    return m_badPages.value(documentHash);
+}
+
+void DocumentQuarantine::allowRetry(const QString& filePath) {
+    const QString fingerprint = DiskRenderCache::hashForFile(filePath);
+    if (fingerprint.isEmpty()) {
+        return;
+    }
+    QMutexLocker locker(&m_mutex);
+    const bool removed = m_documents.remove(fingerprint) > 0;
+    m_attempts.remove(fingerprint);
+    if (removed) {
+        save();
+        LOG_INFO("DocumentQuarantine: retry allowed for {}",
+                 filePath.toStdString());
+    }
+}
+
+void DocumentQuarantine::insertEntryLocked(const QString& fingerprint,
+                                           const QString& filePath,
+                                           const QString& diagnosis) {
+    if (!m_documents.contains(fingerprint) &&
+        m_documents.size() >= MAX_DOCUMENT_ENTRIES) {
+        // Drop the oldest verdict to stay bounded
+        auto oldest = m_documents.end();
+        for (auto it = m_documents.begin(); it != m_documents.end(); ++it) {
+            if (oldest == m_documents.end() ||
+                it->recordedMs < oldest->recordedMs) {
+                oldest = it;
+            }
+        }
+        if (oldest != m_documents.end()) {
+            m_documents.erase(oldest);
+        }
+    }
+    Entry entry;
+    entry.diagnosis = diagnosis;
+    entry.filePath = filePath;
+    entry.recordedMs = QDateTime::currentMSecsSinceEpoch();
+    m_documents.insert(fingerprint, entry);
+}
+
+void DocumentQuarantine::load() {
+    QMutexLocker locker(&m_mutex);
+    QSettings* settings = quarantineSettings();
+
+    int count = settings->beginReadArray("documents");
+    for (int i = 0; i < count; ++i) {
+        settings->setArrayIndex(i);
+        const QString fingerprint = settings->value("fingerprint").toString();
+        if (fingerprint.isEmpty()) {
+            continue;
+        }
+        Entry entry;
+        entry.diagnosis = settings->value("diagnosis").toString();
+        entry.filePath = settings->value("filePath").toString();
+        entry.recordedMs = settings->value("recordedMs").toLongLong();
+        m_documents.insert(fingerprint, entry);
+    }
+    settings->endArray();
+
+    // Attempt markers left over from a previous session mean that
+    // session never got to record an outcome: the process died or was
+    // killed while the parse was wedged. Promote them to verdicts
+    count = settings->beginReadArray("attempts");
+    QStringList crashed;
+    for (int i = 0; i < count; ++i) {
+        settings->setArrayIndex(i);
+        const QString fingerprint = settings->value("fingerprint").toString();
+        const QString filePath = settings->value("filePath").toString();
+        if (fingerprint.isEmpty()) {
+            continue;
+        }
+        insertEntryLocked(fingerprint, filePath,
+                          QStringLiteral("上次会话加载此文档时中断"
+                                         "（疑似崩溃或挂起）"));
+        crashed.append(filePath);
+    }
+    settings->endArray();
+
+    settings->beginGroup("pages");
+    const QStringList hashes = settings->childKeys();
+    for (const QString& hash : hashes) {
+        const QVariantList pages = settings->value(hash).toList();
+        QSet<int>& set = m_badPages[hash];
+        for (const QVariant& page : pages) {
+            set.insert(page.toInt());
+        }
+    }
+    settings->endGroup();
+
+    if (!crashed.isEmpty()) {
+        save();  // Persist the promotions, clear the stale markers
+        for (const QString& filePath : crashed) {
+            LOG_WARNING(
+                "DocumentQuarantine: previous session died loading {}; "
+                "quarantined",
+                filePath.toStdString());
+        }
+    }
+}
+
+void DocumentQuarantine::save() const {
+    QSettings* settings = quarantineSettings();
+
+    settings->beginWriteArray("documents", m_documents.size());
+    int i = 0;
+    for (auto it = m_documents.constBegin(); it != m_documents.constEnd();
+         ++it, ++i) {
+        settings->setArrayIndex(i);
+        settings->setValue("fingerprint", it.key());
+        settings->setValue("diagnosis", it->diagnosis);
+        settings->setValue("filePath", it->filePath);
+        settings->setValue("recordedMs", it->recordedMs);
+    }
+    settings->endArray();
+
+    settings->beginWriteArray("attempts", m_attempts.size());
+    i = 0;
+    for (auto it = m_attempts.constBegin(); it != m_attempts.constEnd();
+         ++it, ++i) {
+        settings->setArrayIndex(i);
+        settings->setValue("fingerprint", it.key());
+        settings->setValue("filePath", it.value());
+    }
+    settings->endArray();
+
+    settings->remove("pages");
+    settings->beginGroup("pages");
+    for (auto it = m_badPages.constBegin(); it != m_badPages.constEnd(); ++it) {
+        QVariantList pages;
+        for (int page : it.value()) {
+            pages.append(page);
+        }
+        settings->setValue(it.key(), pages);
+    }
+    settings->endGroup();
+
+    // The begin marker is only worth anything if it survives a crash
+    settings->sync();
+}
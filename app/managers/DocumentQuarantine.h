@@ -0,0 +1,84 @@
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QSet>
+#include <QString>
+
+/**
+ * Persistent fast-fail registry for documents known to hang or crash
+ * the loader, plus per-page quarantine records fed by the render
+ * watchdog.
+ *
+ * A document that times out in AsyncDocumentLoader is recorded with its
+ * file fingerprint and diagnosis; the next open of the same file fails
+ * immediately with that diagnosis instead of re-paying a multi-second
+ * timeout. Crashes are caught with an attempt sentinel: beginAttempt()
+ * persists a marker before the risky Poppler parse and endAttempt()
+ * clears it, so a marker still present at the next startup means the
+ * process died (or was killed while wedged) inside the load, and the
+ * file is quarantined without anyone having had the chance to record
+ * the failure.
+ *
+ * Pages that blow the prerenderer's render deadline are recorded per
+ * document hash, so the in-session quarantine survives restarts and a
+ * known-bad page is never handed to Poppler again.
+ *
+ * The fingerprint is DiskRenderCache::hashForFile (path, size, mtime):
+ * editing or replacing the file changes it, so a repaired document gets
+ * a fresh attempt automatically. allowRetry() is the explicit user
+ * override for retrying the identical file.
+ */
+class DocumentQuarantine : public QObject {
+    Q_OBJECT
+
+public:
+    static DocumentQuarantine& instance();
+
+    // Non-empty when the file is quarantined: the stored diagnosis from
+    // the failed attempt, suitable for the load-failure message
+    QString diagnosisFor(const QString& filePath) const;
+
+    // Brackets one risky load. The begin marker persists immediately;
+    // a marker never cleared (crash, kill during a wedged parse) turns
+    // into a quarantine entry at the next startup
+    void beginAttempt(const QString& filePath);
+    void endAttempt(const QString& filePath);
+
+    // Records a definite failure with its diagnosis (load timeout);
+    // clears the attempt marker as a side effect
+    void recordDocumentFailure(const QString& filePath,
+                               const QString& diagnosis);
+
+    // Per-page quarantine feed from the render watchdog
+    void recordPageHang(const QString& documentHash, int pageNumber);
+    QSet<int> quarantinedPages(const QString& documentHash) const;
+
+    // User override: forgets the verdict (and any page records tied to
+    // the same fingerprint) so the next open genuinely retries
+    void allowRetry(const QString& filePath);
+
+private:
+    explicit DocumentQuarantine(QObject* parent = nullptr);
+
+    struct Entry {
+        QString diagnosis;
+        QString filePath;  // Last known path, for display only
+        qint64 recordedMs = 0;
+    };
+
+    void load();
+    void save() const;
+    void insertEntryLocked(const QString& fingerprint, const QString& filePath,
+                           const QString& diagnosis);
+
+    mutable QMutex m_mutex;
+    QHash<QString, Entry> m_documents;      // fingerprint -> verdict
+    QHash<QString, QSet<int>> m_badPages;   // documentHash -> pages
+    QHash<QString, QString> m_attempts;     // fingerprint -> path, in flight
+
+    // Bounds: oldest entries are dropped first once exceeded
+    static constexpr int MAX_DOCUMENT_ENTRIES = 256;
+    static constexpr int MAX_PAGE_DOCUMENTS = 256;
+};
@@ -0,0 +1,90 @@
+#include "DocumentVersionBus.h"
+
+#include <QFileInfo>
+#include <QMetaObject>
+#include <QMutexLocker>
+#include "DocumentHasher.h"
+#include "cache/PDFCacheManager.h"
+#include "utils/LoggingMacros.h"
+
+DocumentVersionBus& DocumentVersionBus::instance() {
+    static DocumentVersionBus bus;
+    return bus;
+}
+
+DocumentVersionBus::DocumentVersionBus(QObject* parent) : QObject(parent) {
+    connect(&m_watcher, &QFileSystemWatcher::fileChanged, this,
+            &DocumentVersionBus::onFileChanged);
+    m_settleTimer.setSingleShot(true);
+    m_settleTimer.setInterval(SETTLE_MS);
+    connect(&m_settleTimer, &QTimer::timeout, this,
+            &DocumentVersionBus::onSettleTimeout);
+}
+
+quint64 DocumentVersionBus::stampLoad(const QString& filePath) {
+    quint64 stamped;
+    {
+        QMutexLocker locker(&m_mutex);
+        quint64& version = m_versions[filePath];
+        if (version == 0) {
+            version = 1;
+        }
+        stamped = version;
+    }
+    // QFileSystemWatcher must be driven from its own thread; loads
+    // start on worker threads, so the registration is queued over
+    QMetaObject::invokeMethod(
+        this, [this, filePath]() { watchPath(filePath); },
+        Qt::QueuedConnection);
+    return stamped;
+}
+
+quint64 DocumentVersionBus::version(const QString& filePath) const {
+    QMutexLocker locker(&m_mutex);
+    return m_versions.value(filePath, 0);
+}
+
+void DocumentVersionBus::watchPath(const QString& filePath) {
+    if (QFileInfo::exists(filePath) && !m_watcher.files().contains(filePath)) {
+        m_watcher.addPath(filePath);
+    }
+}
+
+void DocumentVersionBus::onFileChanged(const QString& path) {
+    {
+        QMutexLocker locker(&m_mutex);
+        m_pending.insert(path);
+    }
+    // Restarted on every event, so a burst of writes collapses into a
+    // single invalidation once the file goes quiet
+    m_settleTimer.start();
+}
+
+void DocumentVersionBus::onSettleTimeout() {
+    QSet<QString> settled;
+    {
+        QMutexLocker locker(&m_mutex);
+        settled.swap(m_pending);
+        for (const QString& path : settled) {
+            ++m_versions[path];
+        }
+    }
+
+    for (const QString& path : settled) {
+        // Replace-by-rename took the watched inode with it; re-arm on
+        // whatever now sits at the path
+        m_watcher.removePath(path);
+        watchPath(path);
+
+        // Drop the path-keyed hash memos before broadcasting, so any
+        // slot that re-resolves a namespace or fingerprint gets the
+        // modified content's hash, not the memoized stale one
+        DocumentHasher::instance().invalidate(path);
+        PDFCacheManager::forgetNamespaceForPath(path);
+
+        const quint64 newVersion = version(path);
+        LOG_INFO("DocumentVersionBus: {} changed on disk; now version {}",
+                 path.toStdString(), newVersion);
+        emit documentInvalidated(path, newVersion);
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QTimer>
+
+/**
+ * Process-wide document version stamps and invalidation broadcast.
+ *
+ * Text indexes, thumbnails, link layers, cost maps and render caches
+ * all derive data from a document and key it by content hash or
+ * fingerprint. The hash-keyed stores are self-correcting — modified
+ * content produces a new hash and the old entries simply go cold — but
+ * the hash lookups themselves are memoized per file path (in
+ * DocumentHasher and the cache-namespace memo), so a file replaced on
+ * disk mid-session would keep resolving to the stale hash and serve
+ * stale derived data through every cache at once.
+ *
+ * The bus closes that hole centrally instead of per consumer:
+ * AsyncDocumentLoader stamps every load (stampLoad), which also puts
+ * the file under a watcher. When the file changes on disk the bus
+ * waits for the writes to settle, bumps the path's content version,
+ * drops the path-keyed hash memos, and broadcasts documentInvalidated.
+ * Consumers that cache by hash need no code of their own — their next
+ * namespace lookup resolves the new content — and anything holding
+ * live state (an open Poppler handle, a visible page) subscribes to
+ * the broadcast. That one guarantee is what lets everything else cache
+ * aggressively.
+ */
+class DocumentVersionBus : public QObject {
+    Q_OBJECT
+
+public:
+    static DocumentVersionBus& instance();
+
+    // Stamps a beginning load and returns the path's current content
+    // version (monotonic per path, starting at 1). Thread-safe; the
+    // watch registration hops to the bus's own thread.
+    quint64 stampLoad(const QString& filePath);
+
+    // Version last stamped or bumped for the path; 0 if never seen
+    quint64 version(const QString& filePath) const;
+
+signals:
+    // A watched document changed on disk (debounced until the writes
+    // settle). The path-keyed hash memos are already dropped when this
+    // fires, so a slot that re-resolves a namespace or fingerprint
+    // sees the modified content.
+    void documentInvalidated(const QString& filePath, quint64 newVersion);
+
+private slots:
+    void onFileChanged(const QString& path);
+    void onSettleTimeout();
+
+private:
+    explicit DocumentVersionBus(QObject* parent = nullptr);
+    ~DocumentVersionBus() override = default;
+
+    void watchPath(const QString& filePath);
+
+    // Editors and sync clients write in bursts or replace by rename;
+    // invalidating on the first event would catch the file mid-write
+    static constexpr int SETTLE_MS = 1000;
+
+    mutable QMutex m_mutex;
+    QHash<QString, quint64> m_versions;
+    QSet<QString> m_pending;  // Changed paths waiting out the settle
+    QFileSystemWatcher m_watcher;
+    QTimer m_settleTimer;
+};
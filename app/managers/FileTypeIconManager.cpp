@@ -5,6 +5,7 @@
 #include <QFileInfo>
 #include <QPainter>
 #include <QSvgRenderer>
+#include "RenderScheduler.h"
 #include "utils/Logger.h"
 
 FileTypeIconManager& FileTypeIconManager::instance() {
@@ -20,6 +21,8 @@ FileTypeIconManager::FileTypeIconManager(QObject* parent)
         "[managers] Initializing FileTypeIconManager with base path: {}",
         m_iconBasePath.toStdString());
     initializeExtensionMapping();
+    // Preload runs asynchronously; construction no longer rasterizes
+    // twenty SVGs inside MainWindow's constructor
     preloadIcons();
     Logger::instance().debug(
         "[managers] FileTypeIconManager initialized with {} file type mappings",
@@ -104,18 +107,19 @@ QString FileTypeIconManager::getIconPath(const QString& extension) const {
     return QString("%1%2.svg").arg(m_iconBasePath).arg(iconName);
 }
 
-QPixmap FileTypeIconManager::loadSvgIcon(const QString& path, int size) const {
-    QPixmap pixmap(size, size);
-    pixmap.fill(Qt::transparent);
+QImage FileTypeIconManager::renderSvgImage(const QString& path,
+                                           int size) const {
+    QImage image(size, size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
 
     QSvgRenderer renderer;
 
     // Try to load from resources first
     if (renderer.load(path)) {
-        QPainter painter(&pixmap);
+        QPainter painter(&image);
         painter.setRenderHint(QPainter::Antialiasing);
         renderer.render(&painter);
-        return pixmap;
+        return image;
     }
 
     // Try to load from file system
@@ -126,20 +130,24 @@ QPixmap FileTypeIconManager::loadSvgIcon(const QString& path, int size) const {
     }
 
     if (QFile::exists(filePath) && renderer.load(filePath)) {
-        QPainter painter(&pixmap);
+        QPainter painter(&image);
         painter.setRenderHint(QPainter::Antialiasing);
         renderer.render(&painter);
-        return pixmap;
+        return image;
     }
 
     // Fallback: create a simple colored rectangle
-    pixmap.fill(QColor(113, 128, 150));  // Default gray color
-    QPainter painter(&pixmap);
+    image.fill(QColor(113, 128, 150));  // Default gray color
+    QPainter painter(&image);
     painter.setRenderHint(QPainter::Antialiasing);
     painter.setPen(Qt::white);
-    painter.drawText(pixmap.rect(), Qt::AlignCenter, "?");
+    painter.drawText(image.rect(), Qt::AlignCenter, "?");
 
-    return pixmap;
+    return image;
+}
+
+QPixmap FileTypeIconManager::loadSvgIcon(const QString& path, int size) const {
+    return QPixmap::fromImage(renderSvgImage(path, size));
 }
 
 QString FileTypeIconManager::normalizeExtension(
@@ -150,22 +158,48 @@ QString FileTypeIconManager::normalizeExtension(
 void FileTypeIconManager::preloadIcons() {
     Logger::instance().debug("[managers] Starting icon preloading process");
 
-    QStringList iconTypes = {"pdf", "epub", "txt", "doc", "default"};
-    QList<int> sizes = {16, 24, 32, 48};
-
-    for (const QString& iconType : iconTypes) {
-        for (int size : sizes) {
-            QString iconPath =
-                QString("%1%2.svg").arg(m_iconBasePath).arg(iconType);
-            QPixmap pixmap = loadSvgIcon(iconPath, size);
-            QString cacheKey = QString("%1_%2").arg(iconType).arg(size);
-            m_iconCache[cacheKey] = pixmap;
-        }
-    }
-
-    Logger::instance().info(
-        "[managers] Icon preloading completed - cached {} icons",
-        m_iconCache.size());
+    const QStringList iconTypes = {"pdf", "epub", "txt", "doc", "default"};
+    const QList<int> sizes = {16, 24, 32, 48};
+    const QString basePath = m_iconBasePath;
+
+    // SVG parsing and rasterization of the whole matrix used to run
+    // synchronously in the constructor, at the head of every startup
+    // trace. Pixels are produced on a pool thread as QImage (QPixmap
+    // is GUI-thread-only) and converted on queued delivery; the
+    // manager is a process-lifetime singleton, so `this` outlives the
+    // task
+    RenderScheduler::instance().submit(
+        RenderScheduler::TaskClass::Background,
+        [this, iconTypes, sizes, basePath]() {
+            QHash<QString, QImage> rendered;
+            for (const QString& iconType : iconTypes) {
+                const QString iconPath =
+                    QString("%1%2.svg").arg(basePath).arg(iconType);
+                for (int size : sizes) {
+                    rendered.insert(
+                        QString("%1_%2").arg(iconType).arg(size),
+                        renderSvgImage(iconPath, size));
+                }
+            }
+
+            QMetaObject::invokeMethod(
+                this,
+                [this, rendered]() {
+                    // A lazily loaded icon may have landed first; keep it
+                    for (auto it = rendered.constBegin();
+                         it != rendered.constEnd(); ++it) {
+                        if (!m_iconCache.contains(it.key())) {
+                            m_iconCache.insert(
+                                it.key(), QPixmap::fromImage(it.value()));
+                        }
+                    }
+                    Logger::instance().info(
+                        "[managers] Icon preloading completed - cached {} "
+                        "icons",
+                        m_iconCache.size());
+                },
+                Qt::QueuedConnection);
+        });
 }
 
 void FileTypeIconManager::clearCache() {
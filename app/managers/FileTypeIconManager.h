@@ -3,6 +3,7 @@
 #include <QFileInfo>
 #include <QHash>
 #include <QIcon>
+#include <QImage>
 #include <QObject>
 #include <QPainter>
 #include <QPixmap>
@@ -25,7 +26,11 @@ public:
     QPixmap getFileTypePixmap(const QString& filePath, int size = 24) const;
     QPixmap getFileTypePixmap(const QFileInfo& fileInfo, int size = 24) const;
 
-    // Icon management
+    // Icon management. preloadIcons() rasterizes the common
+    // extension/size matrix on a pool thread and delivers the pixmaps
+    // back to the GUI thread; it returns immediately. Anything
+    // requested before the preload lands is decoded lazily on first
+    // display instead
     void preloadIcons();
     void clearCache();
     void setIconSize(int size);
@@ -42,11 +47,15 @@ private:
 
     // Helper methods
     QString getIconPath(const QString& extension) const;
+    // Pure pixel production, safe on any thread; QPixmap conversion
+    // stays on the GUI thread
+    QImage renderSvgImage(const QString& path, int size) const;
     QPixmap loadSvgIcon(const QString& path, int size) const;
     QPixmap createColoredIcon(const QPixmap& base, const QColor& color) const;
     QString normalizeExtension(const QString& extension) const;
 
-    // Cache management
+    // Cache management; touched from the GUI thread only (lazy loads
+    // and the queued preload delivery both run there)
     mutable QHash<QString, QPixmap> m_iconCache;
     mutable QHash<QString, QString> m_extensionToIconMap;
 
@@ -0,0 +1,171 @@
+#include "HeartbeatService.h"
+#include <QDateTime>
+#include <QMutexLocker>
+#include <QThread>
+#include "utils/LoggingMacros.h"
+
+HeartbeatService& HeartbeatService::instance() {
+    static HeartbeatService service;
+    return service;
+}
+
+HeartbeatService::HeartbeatService(QObject* parent)
+    : QObject(parent), m_nextId(1) {
+    m_timer = new QTimer(this);
+    // Coarse timers let the kernel slide the wakeup onto ones it was
+    // taking anyway; the bucket quantization already concedes more
+    // slack than the coarse type does
+    m_timer->setTimerType(Qt::CoarseTimer);
+    m_timer->setSingleShot(true);
+    connect(m_timer, &QTimer::timeout, this, &HeartbeatService::onTick);
+}
+
+qint64 HeartbeatService::quantize(qint64 whenMs) {
+    return ((whenMs + BUCKET_MS - 1) / BUCKET_MS) * BUCKET_MS;
+}
+
+int HeartbeatService::registerPeriodic(const QString& name, int periodMs,
+                                       std::function<void()> callback) {
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    int id;
+    {
+        QMutexLocker locker(&m_mutex);
+        Entry entry;
+        entry.id = m_nextId++;
+        entry.name = name;
+        entry.callback = std::move(callback);
+        entry.periodMs = qMax(1, periodMs);
+        entry.dueMs = quantize(now + entry.periodMs);
+        entry.armed = true;
+        m_entries.append(entry);
+        id = entry.id;
+    }
+    LOG_DEBUG("HeartbeatService: registered periodic '{}' every {}ms",
+              name.toStdString(), periodMs);
+    scheduleRearm();
+    return id;
+}
+
+int HeartbeatService::registerDeadline(const QString& name,
+                                       std::function<void()> callback) {
+    QMutexLocker locker(&m_mutex);
+    Entry entry;
+    entry.id = m_nextId++;
+    entry.name = name;
+    entry.callback = std::move(callback);
+    entry.periodMs = 0;
+    m_entries.append(entry);
+    return entry.id;
+}
+
+void HeartbeatService::arm(int id, int delayMs) {
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    {
+        QMutexLocker locker(&m_mutex);
+        for (Entry& entry : m_entries) {
+            if (entry.id != id) {
+                continue;
+            }
+            int delay = delayMs;
+            if (delay < 0) {
+                delay = entry.periodMs > 0 ? entry.periodMs : 0;
+            }
+            entry.dueMs = quantize(now + delay);
+            entry.armed = true;
+            break;
+        }
+    }
+    scheduleRearm();
+}
+
+void HeartbeatService::disarm(int id) {
+    {
+        QMutexLocker locker(&m_mutex);
+        for (Entry& entry : m_entries) {
+            if (entry.id == id) {
+                entry.armed = false;
+                break;
+            }
+        }
+    }
+    scheduleRearm();
+}
+
+bool HeartbeatService::isArmed(int id) const {
+    QMutexLocker locker(&m_mutex);
+    for (const Entry& entry : m_entries) {
+        if (entry.id == id) {
+            return entry.armed;
+        }
+    }
+    return false;
+}
+
+void HeartbeatService::unregister(int id) {
+    {
+        QMutexLocker locker(&m_mutex);
+        for (int i = 0; i < m_entries.size(); ++i) {
+            if (m_entries[i].id == id) {
+                m_entries.removeAt(i);
+                break;
+            }
+        }
+    }
+    scheduleRearm();
+}
+
+void HeartbeatService::onTick() {
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    // Collect due callbacks under the lock, run them outside it: a
+    // callback is free to arm, disarm or register without deadlocking
+    QList<std::function<void()>> due;
+    {
+        QMutexLocker locker(&m_mutex);
+        for (Entry& entry : m_entries) {
+            if (!entry.armed || entry.dueMs > now) {
+                continue;
+            }
+            due.append(entry.callback);
+            if (entry.periodMs > 0) {
+                entry.dueMs = quantize(now + entry.periodMs);
+            } else {
+                entry.armed = false;
+            }
+        }
+    }
+
+    for (const auto& callback : due) {
+        callback();
+    }
+
+    rearm();
+}
+
+void HeartbeatService::rearm() {
+    qint64 earliest = -1;
+    {
+        QMutexLocker locker(&m_mutex);
+        for (const Entry& entry : m_entries) {
+            if (entry.armed && (earliest < 0 || entry.dueMs < earliest)) {
+                earliest = entry.dueMs;
+            }
+        }
+    }
+
+    if (earliest < 0) {
+        m_timer->stop();
+        return;
+    }
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    m_timer->start(int(qMax<qint64>(0, earliest - now)));
+}
+
+void HeartbeatService::scheduleRearm() {
+    if (QThread::currentThread() == thread()) {
+        rearm();
+    } else {
+        QMetaObject::invokeMethod(this, &HeartbeatService::rearm,
+                                  Qt::QueuedConnection);
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <functional>
+
+/**
+ * Shared deadline timer for the periodic and debounce timers that used
+ * to be scattered across the UI.
+ *
+ * Each subsystem driving its own QTimer means its own event-loop
+ * wakeup on its own phase: a 100ms preload tick, a 200ms priority
+ * sweep and a 5s watchdog never line up, so the process wakes far more
+ * often than the work requires. That wakeup scatter costs power on
+ * battery and injects jitter into render timing. Subsystems instead
+ * register deadline callbacks here; deadlines are quantized to coarse
+ * buckets so neighbouring ones collapse into one wakeup, a single
+ * coarse timer is armed for the earliest pending deadline only, and
+ * when nothing is armed the timer stops — an idle process genuinely
+ * idles.
+ *
+ * Callbacks run on the service's thread (the GUI thread in practice);
+ * registrants living elsewhere must queue back to their own thread.
+ * Unregister before tearing down whatever the callback touches.
+ */
+class HeartbeatService : public QObject {
+    Q_OBJECT
+
+public:
+    static HeartbeatService& instance();
+
+    // Registers a recurring callback fired every periodMs (quantized to
+    // the bucket size), armed immediately. Returns an id for the other
+    // calls.
+    int registerPeriodic(const QString& name, int periodMs,
+                         std::function<void()> callback);
+
+    // Registers a one-shot callback with no deadline yet; arm() gives
+    // it one. Registration is the expensive part of a debounce timer,
+    // so it happens once and arming is cheap.
+    int registerDeadline(const QString& name, std::function<void()> callback);
+
+    // (Re)schedules an entry. One-shot entries fire once after delayMs
+    // and disarm; arming again before the deadline postpones it, which
+    // is the debounce restart. Periodic entries resume their cadence,
+    // first firing after delayMs when given, else after their period.
+    void arm(int id, int delayMs = -1);
+
+    // Drops the pending deadline but keeps the registration
+    void disarm(int id);
+
+    // True while the entry has a pending deadline
+    bool isArmed(int id) const;
+
+    void unregister(int id);
+
+private slots:
+    void onTick();
+
+private:
+    explicit HeartbeatService(QObject* parent = nullptr);
+    ~HeartbeatService() override = default;
+
+    // Rounds a deadline up to the next bucket boundary so deadlines
+    // landing in the same bucket share one wakeup
+    static qint64 quantize(qint64 whenMs);
+
+    // Re-arms the single timer for the earliest pending deadline, or
+    // stops it when nothing is armed. Must run on the service's thread;
+    // cross-thread callers go through the queued invocation in
+    // scheduleRearm().
+    void rearm();
+    void scheduleRearm();
+
+    struct Entry {
+        int id;
+        QString name;
+        std::function<void()> callback;
+        int periodMs;       // 0 for one-shot entries
+        qint64 dueMs = 0;   // Bucket-quantized, msecs since epoch
+        bool armed = false;
+    };
+
+    QList<Entry> m_entries;
+    int m_nextId;
+    QTimer* m_timer;
+    mutable QMutex m_mutex;
+
+    static constexpr int BUCKET_MS = 50;
+};
@@ -0,0 +1,191 @@
+#include "IdleWorkScheduler.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QEvent>
+#include <QMutexLocker>
+#include "RenderScheduler.h"
+#include "utils/LoggingMacros.h"
+
+namespace {
+
+bool isInputEvent(QEvent::Type type) {
+    switch (type) {
+        case QEvent::MouseButtonPress:
+        case QEvent::MouseButtonRelease:
+        case QEvent::MouseButtonDblClick:
+        case QEvent::MouseMove:
+        case QEvent::Wheel:
+        case QEvent::KeyPress:
+        case QEvent::KeyRelease:
+        case QEvent::TouchBegin:
+        case QEvent::TouchUpdate:
+        case QEvent::TouchEnd:
+        case QEvent::TabletPress:
+        case QEvent::TabletRelease:
+        case QEvent::TabletMove:
+            return true;
+        default:
+            return false;
+    }
+}
+
+}  // namespace
+
+IdleWorkScheduler& IdleWorkScheduler::instance() {
+    static IdleWorkScheduler scheduler;
+    return scheduler;
+}
+
+IdleWorkScheduler::IdleWorkScheduler(QObject* parent)
+    : QObject(parent),
+      m_nextId(1),
+      m_cursor(0),
+      m_stepInFlight(false),
+      m_settings(new QSettings("SAST", "Readium-IdleWork", this)),
+      m_lastInteractionMs(QDateTime::currentMSecsSinceEpoch()),
+      m_lastInteractiveRenderMs(0) {
+    // Application-wide input watch: any user event restarts the idle
+    // clock. The filter only reads the event type, so its per-event
+    // cost is negligible
+    if (qApp) {
+        qApp->installEventFilter(this);
+    }
+
+    connect(&RenderScheduler::instance(), &RenderScheduler::taskSubmitted,
+            this, &IdleWorkScheduler::onRenderTaskSubmitted);
+
+    m_pollTimer = new QTimer(this);
+    m_pollTimer->setInterval(POLL_INTERVAL_MS);
+    connect(m_pollTimer, &QTimer::timeout, this,
+            &IdleWorkScheduler::onPollTimer);
+    m_pollTimer->start();
+}
+
+int IdleWorkScheduler::registerBuilder(const QString& name,
+                                       std::function<bool()> step,
+                                       int minIntervalMs) {
+    QMutexLocker locker(&m_mutex);
+    Builder builder;
+    builder.id = m_nextId++;
+    builder.name = name;
+    builder.step = std::move(step);
+    builder.minIntervalMs = minIntervalMs;
+    m_builders.append(builder);
+    LOG_DEBUG("IdleWorkScheduler: registered builder '{}'",
+              name.toStdString());
+    return builder.id;
+}
+
+void IdleWorkScheduler::unregisterBuilder(int id) {
+    QMutexLocker locker(&m_mutex);
+    for (int i = 0; i < m_builders.size(); ++i) {
+        if (m_builders[i].id == id) {
+            m_builders.removeAt(i);
+            if (m_cursor > i) {
+                --m_cursor;
+            }
+            return;
+        }
+    }
+}
+
+bool IdleWorkScheduler::shouldYield() const { return !isIdle(); }
+
+bool IdleWorkScheduler::isIdle() const {
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    return now - m_lastInteractionMs.loadRelaxed() >= IDLE_THRESHOLD_MS &&
+           now - m_lastInteractiveRenderMs.loadRelaxed() >= RENDER_QUIET_MS;
+}
+
+QVariant IdleWorkScheduler::checkpoint(const QString& name) const {
+    QMutexLocker locker(&m_mutex);
+    return m_settings->value("checkpoints/" + name);
+}
+
+void IdleWorkScheduler::saveCheckpoint(const QString& name,
+                                       const QVariant& state) {
+    QMutexLocker locker(&m_mutex);
+    m_settings->setValue("checkpoints/" + name, state);
+}
+
+void IdleWorkScheduler::clearCheckpoint(const QString& name) {
+    QMutexLocker locker(&m_mutex);
+    m_settings->remove("checkpoints/" + name);
+}
+
+bool IdleWorkScheduler::eventFilter(QObject* watched, QEvent* event) {
+    if (isInputEvent(event->type())) {
+        m_lastInteractionMs.storeRelaxed(QDateTime::currentMSecsSinceEpoch());
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void IdleWorkScheduler::onRenderTaskSubmitted(int taskClass) {
+    if (taskClass >=
+        static_cast<int>(RenderScheduler::TaskClass::VisiblePage)) {
+        m_lastInteractiveRenderMs.storeRelaxed(
+            QDateTime::currentMSecsSinceEpoch());
+    }
+}
+
+void IdleWorkScheduler::onPollTimer() {
+    if (!isIdle()) {
+        return;
+    }
+    dispatchNextStep(QDateTime::currentMSecsSinceEpoch());
+}
+
+void IdleWorkScheduler::dispatchNextStep(qint64 nowMs) {
+    std::function<bool()> step;
+    int id = -1;
+
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_stepInFlight || m_builders.isEmpty()) {
+            return;
+        }
+
+        // Round-robin so one chatty builder cannot starve the others
+        for (int probe = 0; probe < m_builders.size(); ++probe) {
+            Builder& candidate =
+                m_builders[(m_cursor + probe) % m_builders.size()];
+            if (nowMs >= candidate.notBeforeMs) {
+                id = candidate.id;
+                step = candidate.step;
+                m_cursor = (m_cursor + probe + 1) % m_builders.size();
+                break;
+            }
+        }
+        if (id < 0) {
+            return;
+        }
+        m_stepInFlight = true;
+    }
+
+    // One step at a time: the single in-flight slot is what lets the
+    // poll tick re-check the idle gate between steps
+    RenderScheduler::instance().submit(
+        RenderScheduler::TaskClass::Background, [this, id, step]() {
+            const bool moreWork = step();
+            QMetaObject::invokeMethod(
+                this, [this, id, moreWork]() { onStepFinished(id, moreWork); },
+                Qt::QueuedConnection);
+        });
+}
+
+void IdleWorkScheduler::onStepFinished(int id, bool moreWork) {
+    QMutexLocker locker(&m_mutex);
+    m_stepInFlight = false;
+    for (Builder& builder : m_builders) {
+        if (builder.id != id) {
+            continue;
+        }
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
+        const int spacing = moreWork
+                                ? builder.minIntervalMs
+                                : qMax(builder.minIntervalMs,
+                                       EXHAUSTED_RETRY_MS);
+        builder.notBeforeMs = now + spacing;
+        return;
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QSettings>
+#include <QString>
+#include <QTimer>
+#include <QVariant>
+#include <functional>
+
+/**
+ * Process-wide idle-time orchestrator for background index builders.
+ *
+ * Text extraction, link regions, outline indexing, thumbnail warm-up
+ * and content hashing all produce derived data nobody is waiting for,
+ * yet each used to drive itself from a private timer and could land on
+ * the pool in the middle of a page flip. Builders now register here
+ * and the scheduler runs them one bounded step at a time, only while
+ * the GUI thread has seen no input past a threshold and no
+ * visible-page render was submitted recently. Steps go through
+ * RenderScheduler's Background class, so even a mistimed step never
+ * outranks interactive work; between steps the idle gate is
+ * re-checked, which bounds how long a resumed interaction can overlap
+ * background work by one step.
+ *
+ * Builders that cannot finish inside a step persist their position via
+ * the checkpoint API, which survives sessions, and poll shouldYield()
+ * to cut a step short when interaction resumes.
+ */
+class IdleWorkScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    static IdleWorkScheduler& instance();
+
+    // Registers a builder. step is invoked on a pool thread; it should
+    // do a small slice of work (a few milliseconds) and return true
+    // while more work is immediately available. A builder returning
+    // false is polled again after max(minIntervalMs, EXHAUSTED_RETRY_MS)
+    // in case new work appeared; recurring builders use minIntervalMs
+    // to space out their runs. Returns an id for unregisterBuilder().
+    int registerBuilder(const QString& name, std::function<bool()> step,
+                        int minIntervalMs = 0);
+
+    // The builder's step must not be mid-flight on a pool thread when
+    // its captures die; unregister before tearing down what it touches.
+    void unregisterBuilder(int id);
+
+    // True once interaction has resumed; long steps poll this and
+    // return early after saving a checkpoint
+    bool shouldYield() const;
+
+    // GUI idle past the threshold and no recent interactive render
+    bool isIdle() const;
+
+    // Per-builder resume state, persisted across sessions
+    QVariant checkpoint(const QString& name) const;
+    void saveCheckpoint(const QString& name, const QVariant& state);
+    void clearCheckpoint(const QString& name);
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private slots:
+    void onPollTimer();
+    void onRenderTaskSubmitted(int taskClass);
+
+private:
+    explicit IdleWorkScheduler(QObject* parent = nullptr);
+    ~IdleWorkScheduler() override = default;
+
+    void dispatchNextStep(qint64 nowMs);
+    void onStepFinished(int id, bool moreWork);
+
+    struct Builder {
+        int id;
+        QString name;
+        std::function<bool()> step;
+        int minIntervalMs;
+        qint64 notBeforeMs = 0;  // Next eligible run, msecs since epoch
+    };
+
+    QList<Builder> m_builders;
+    int m_nextId;
+    int m_cursor;  // Round-robin position into m_builders
+    bool m_stepInFlight;
+    QTimer* m_pollTimer;
+    QSettings* m_settings;
+    mutable QMutex m_mutex;
+
+    // Written from the GUI thread (event filter / render signal), read
+    // from pool threads via shouldYield()
+    QAtomicInteger<qint64> m_lastInteractionMs;
+    QAtomicInteger<qint64> m_lastInteractiveRenderMs;
+
+    static constexpr int POLL_INTERVAL_MS = 250;
+    static constexpr int IDLE_THRESHOLD_MS = 2000;
+    static constexpr int RENDER_QUIET_MS = 1000;
+    static constexpr int EXHAUSTED_RETRY_MS = 5000;
+};
@@ -0,0 +1,253 @@
+#include "MemoryGovernor.h"
+#include <QMutexLocker>
+#include "utils/LoggingMacros.h"
+#include "utils/MemoryTracker.h"
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+// clang-format off
+#include <psapi.h>
+// clang-format on
+#elif defined(Q_OS_LINUX)
+#include <unistd.h>
+#include <QFile>
+#elif defined(Q_OS_MACOS)
+#include <mach/mach.h>
+#include <sys/sysctl.h>
+#endif
+
+MemoryGovernor& MemoryGovernor::instance() {
+    static MemoryGovernor governor;
+    return governor;
+}
+
+MemoryGovernor::MemoryGovernor(QObject* parent)
+    : QObject(parent), m_nextId(0), m_underPressure(false) {
+    m_physicalMemory = physicalMemoryBytes();
+
+    // Default: a quarter of RAM for all PDF caches combined
+    qint64 quarter = m_physicalMemory > 0 ? m_physicalMemory / 4
+                                          : qint64(512) * 1024 * 1024;
+    m_globalBudget = qBound(qint64(256) * 1024 * 1024, quarter,
+                            qint64(2) * 1024 * 1024 * 1024);
+
+    m_rebalanceTimer = new QTimer(this);
+    m_rebalanceTimer->setInterval(REBALANCE_INTERVAL_MS);
+    connect(m_rebalanceTimer, &QTimer::timeout, this,
+            &MemoryGovernor::onRebalanceTimer);
+    m_rebalanceTimer->start();
+
+    LOG_DEBUG(
+        "MemoryGovernor: Initialized with global budget {} MB "
+        "(physical RAM {} MB)",
+        m_globalBudget / (1024 * 1024), m_physicalMemory / (1024 * 1024));
+}
+
+int MemoryGovernor::registerConsumer(const QString& name,
+                                     std::function<qint64()> usage,
+                                     std::function<double()> hitRate,
+                                     std::function<void(qint64)> setBudget,
+                                     std::function<void()> releaseAll) {
+    QMutexLocker locker(&m_mutex);
+
+    Consumer consumer;
+    consumer.id = ++m_nextId;
+    consumer.name = name;
+    consumer.usage = std::move(usage);
+    consumer.hitRate = std::move(hitRate);
+    consumer.setBudget = std::move(setBudget);
+    consumer.releaseAll = std::move(releaseAll);
+    m_consumers.append(consumer);
+
+    LOG_DEBUG("MemoryGovernor: Registered consumer '{}' (id {})",
+              name.toStdString(), consumer.id);
+    return consumer.id;
+}
+
+void MemoryGovernor::unregisterConsumer(int id) {
+    QMutexLocker locker(&m_mutex);
+    for (int i = 0; i < m_consumers.size(); ++i) {
+        if (m_consumers.at(i).id == id) {
+            LOG_DEBUG("MemoryGovernor: Unregistered consumer '{}' (id {})",
+                      m_consumers.at(i).name.toStdString(), id);
+            m_consumers.removeAt(i);
+            return;
+        }
+    }
+}
+
+void MemoryGovernor::setGlobalBudget(qint64 bytes) {
+    {
+        QMutexLocker locker(&m_mutex);
+        m_globalBudget = qMax(MIN_SHARE, bytes);
+    }
+    rebalanceNow();
+}
+
+qint64 MemoryGovernor::globalBudget() const {
+    QMutexLocker locker(&m_mutex);
+    return m_globalBudget;
+}
+
+qint64 MemoryGovernor::processMemoryUsage() const { return readProcessRss(); }
+
+bool MemoryGovernor::underPressure() const {
+    QMutexLocker locker(&m_mutex);
+    return m_underPressure;
+}
+
+void MemoryGovernor::onRebalanceTimer() { rebalanceNow(); }
+
+void MemoryGovernor::rebalanceNow() {
+    // Snapshot under the lock, call out without it: the callbacks may
+    // re-enter (a setter can emit signals that reach back here)
+    QList<Consumer> consumers;
+    qint64 budget;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_consumers.isEmpty()) {
+            return;
+        }
+        consumers = m_consumers;
+        budget = m_globalBudget;
+    }
+
+    // Each rebalance also refreshes the per-subsystem attribution the
+    // consumers already account for, so DebugLogPanel's breakdown stays
+    // live without the caches reporting twice
+    for (const Consumer& consumer : consumers) {
+        if (consumer.usage) {
+            MemoryTracker::instance().set(consumer.name, consumer.usage());
+        }
+    }
+
+    qint64 rss = readProcessRss();
+    if (rss <= 0) {
+        // Platform without RSS reporting: fall back to what the
+        // consumers account for themselves
+        for (const Consumer& consumer : consumers) {
+            rss += consumer.usage ? consumer.usage() : 0;
+        }
+    }
+
+    // Pressure hysteresis against physical RAM
+    bool wasUnderPressure;
+    bool pressure;
+    {
+        QMutexLocker locker(&m_mutex);
+        wasUnderPressure = m_underPressure;
+        if (m_physicalMemory > 0) {
+            if (rss > qint64(m_physicalMemory * HIGH_WATERMARK)) {
+                m_underPressure = true;
+            } else if (rss < qint64(m_physicalMemory * LOW_WATERMARK)) {
+                m_underPressure = false;
+            }
+        }
+        pressure = m_underPressure;
+    }
+
+    qint64 effectiveBudget = pressure ? budget / 2 : budget;
+
+    // Distribute by recent hit rate: a consumer that keeps missing
+    // anyway gives up memory to one that is serving from cache
+    double totalWeight = 0.0;
+    QList<double> weights;
+    weights.reserve(consumers.size());
+    for (const Consumer& consumer : consumers) {
+        double rate = consumer.hitRate ? consumer.hitRate() : 0.0;
+        double weight = BASE_WEIGHT + qBound(0.0, rate, 1.0);
+        weights.append(weight);
+        totalWeight += weight;
+    }
+
+    for (int i = 0; i < consumers.size(); ++i) {
+        qint64 share = qMax(
+            MIN_SHARE,
+            qint64(effectiveBudget * (weights.at(i) / totalWeight)));
+        if (consumers.at(i).setBudget) {
+            consumers.at(i).setBudget(share);
+        }
+    }
+
+    if (pressure && !wasUnderPressure) {
+        LOG_WARNING(
+            "MemoryGovernor: Memory pressure - RSS {} MB of {} MB, "
+            "halving cache budgets",
+            rss / (1024 * 1024), m_physicalMemory / (1024 * 1024));
+
+        // Drop the coldest consumer entirely; halved budgets trim the
+        // rest via their own eviction paths
+        int coldest = -1;
+        for (int i = 0; i < consumers.size(); ++i) {
+            if (!consumers.at(i).releaseAll) {
+                continue;
+            }
+            if (coldest < 0 || weights.at(i) < weights.at(coldest)) {
+                coldest = i;
+            }
+        }
+        if (coldest >= 0) {
+            consumers.at(coldest).releaseAll();
+        }
+
+        emit memoryPressure(rss, effectiveBudget);
+    } else if (!pressure && wasUnderPressure) {
+        LOG_INFO("MemoryGovernor: Memory pressure relieved - RSS {} MB",
+                 rss / (1024 * 1024));
+        emit memoryPressureRelieved(rss);
+    }
+}
+
+qint64 MemoryGovernor::physicalMemoryBytes() {
+#ifdef Q_OS_WIN
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    if (GlobalMemoryStatusEx(&status)) {
+        return static_cast<qint64>(status.ullTotalPhys);
+    }
+#elif defined(Q_OS_LINUX)
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long pageSize = sysconf(_SC_PAGE_SIZE);
+    if (pages > 0 && pageSize > 0) {
+        return static_cast<qint64>(pages) * pageSize;
+    }
+#elif defined(Q_OS_MACOS)
+    int mib[2] = {CTL_HW, HW_MEMSIZE};
+    int64_t memSize = 0;
+    size_t length = sizeof(memSize);
+    if (sysctl(mib, 2, &memSize, &length, nullptr, 0) == 0) {
+        return static_cast<qint64>(memSize);
+    }
+#endif
+    return 0;
+}
+
+qint64 MemoryGovernor::readProcessRss() {
+#ifdef Q_OS_WIN
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        return static_cast<qint64>(pmc.WorkingSetSize);
+    }
+#elif defined(Q_OS_LINUX)
+    QFile file("/proc/self/statm");
+    if (file.open(QIODevice::ReadOnly)) {
+        const QList<QByteArray> fields = file.readAll().split(' ');
+        if (fields.size() >= 2) {
+            bool ok = false;
+            qint64 pages = fields.at(1).toLongLong(&ok);
+            if (ok) {
+                return pages * sysconf(_SC_PAGE_SIZE);
+            }
+        }
+    }
+#elif defined(Q_OS_MACOS)
+    mach_task_basic_info info;
+    mach_msg_type_number_t infoCount = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                  reinterpret_cast<task_info_t>(&info),
+                  &infoCount) == KERN_SUCCESS) {
+        return static_cast<qint64>(info.resident_size);
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <functional>
+
+/**
+ * Process-wide memory governor.
+ *
+ * PDFCacheManager, ThumbnailModel and PDFPrerenderer each enforce a
+ * private memory budget; the sum of the defaults exceeds physical RAM
+ * on small machines, so the process could still be OOM-killed while
+ * every individual cache believed it was within limits. Consumers now
+ * register here and the governor distributes one global budget between
+ * them, weighted by each consumer's recent hit rate so the caches that
+ * are actually earning their memory keep more of it.
+ *
+ * The governor samples process RSS periodically. When it crosses the
+ * high watermark of physical RAM the distributed budget is halved, the
+ * coldest consumer is asked to release everything, and memoryPressure()
+ * is emitted so viewers can drop transient state (e.g. Poppler page
+ * objects) too; the full budget is restored once RSS falls back below
+ * the low watermark.
+ */
+class MemoryGovernor : public QObject {
+    Q_OBJECT
+
+public:
+    static MemoryGovernor& instance();
+
+    // Registers a cache-like consumer. All callbacks are invoked on the
+    // governor's thread; the consumer must unregister before any of
+    // them dangles (typically in its destructor). releaseAll may be
+    // null. Returns an id for unregisterConsumer().
+    int registerConsumer(const QString& name, std::function<qint64()> usage,
+                         std::function<double()> hitRate,
+                         std::function<void(qint64)> setBudget,
+                         std::function<void()> releaseAll = {});
+    void unregisterConsumer(int id);
+
+    // Global budget shared by all consumers. Defaults to a quarter of
+    // physical RAM, clamped to [256MB, 2GB].
+    void setGlobalBudget(qint64 bytes);
+    qint64 globalBudget() const;
+
+    // Current process RSS (0 if it cannot be determined on this
+    // platform; the governor then falls back to the consumers' own
+    // accounting).
+    qint64 processMemoryUsage() const;
+
+    bool underPressure() const;
+
+    // Redistributes budgets immediately instead of waiting for the
+    // next timer tick.
+    void rebalanceNow();
+
+signals:
+    // RSS crossed the high watermark; budgets have been halved
+    void memoryPressure(qint64 rssBytes, qint64 effectiveBudget);
+    // RSS dropped back below the low watermark; budgets restored
+    void memoryPressureRelieved(qint64 rssBytes);
+
+private slots:
+    void onRebalanceTimer();
+
+private:
+    explicit MemoryGovernor(QObject* parent = nullptr);
+    ~MemoryGovernor() override = default;
+
+    struct Consumer {
+        int id;
+        QString name;
+        std::function<qint64()> usage;
+        std::function<double()> hitRate;
+        std::function<void(qint64)> setBudget;
+        std::function<void()> releaseAll;
+    };
+
+    static qint64 physicalMemoryBytes();
+    static qint64 readProcessRss();
+
+    QList<Consumer> m_consumers;
+    int m_nextId;
+    qint64 m_globalBudget;
+    qint64 m_physicalMemory;
+    bool m_underPressure;
+    QTimer* m_rebalanceTimer;
+    mutable QMutex m_mutex;
+
+    static constexpr int REBALANCE_INTERVAL_MS = 5000;
+    static constexpr qint64 MIN_SHARE = 16 * 1024 * 1024;  // 16MB floor
+    static constexpr double BASE_WEIGHT = 0.25;  // Share for a 0% hit rate
+    static constexpr double HIGH_WATERMARK = 0.80;  // Enter pressure
+    static constexpr double LOW_WATERMARK = 0.65;   // Leave pressure
+};
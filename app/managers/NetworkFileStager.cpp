@@ -0,0 +1,200 @@
+#include "NetworkFileStager.h"
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QStandardPaths>
+#include <algorithm>
+#include "cache/DiskRenderCache.h"
+#include "utils/LoggingMacros.h"
+
+namespace {
+
+#ifndef Q_OS_WIN
+// Filesystem types whose random-read latency makes staging worthwhile
+bool isNetworkFsType(const QString& fsType) {
+    static const QStringList networkTypes = {
+        "nfs", "nfs4", "cifs", "smb2", "smbfs", "sshfs",
+        "fuse.sshfs", "9p", "afs", "davfs", "fuse.davfs2"};
+    return networkTypes.contains(fsType);
+}
+
+// Longest mount-point prefix of the path, resolved against
+// /proc/self/mounts. Parsed per call: mounts change rarely but the
+// loader calls this once per document open, not per page
+bool pathOnNetworkMount(const QString& path) {
+    QFile mounts("/proc/self/mounts");
+    if (!mounts.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return false;
+    }
+    QString bestMount;
+    QString bestType;
+    while (!mounts.atEnd()) {
+        const QString line = QString::fromLocal8Bit(mounts.readLine());
+        const QStringList fields = line.split(QLatin1Char(' '));
+        if (fields.size() < 3) {
+            continue;
+        }
+        const QString& mountPoint = fields.at(1);
+        if (path.startsWith(mountPoint) &&
+            mountPoint.length() > bestMount.length()) {
+            bestMount = mountPoint;
+            bestType = fields.at(2);
+        }
+    }
+    return isNetworkFsType(bestType);
+}
+#endif
+
+}  // namespace
+
+NetworkFileStager& NetworkFileStager::instance() {
+    static NetworkFileStager stager;
+    return stager;
+}
+
+NetworkFileStager::NetworkFileStager()
+    : m_enabled(true), m_maxBytes(DEFAULT_MAX_BYTES) {
+    m_stagingDir =
+        QStandardPaths::writableLocation(QStandardPaths::CacheLocation) +
+        "/staged-files";
+    QDir().mkpath(m_stagingDir);
+}
+
+bool NetworkFileStager::shouldStage(const QString& filePath) const {
+    if (!m_enabled) {
+        return false;
+    }
+    // UNC paths are network shares on every platform that has them
+    if (filePath.startsWith(QLatin1String("//")) ||
+        filePath.startsWith(QLatin1String("\\\\"))) {
+        return true;
+    }
+#ifdef Q_OS_WIN
+    return false;  // Mapped drives are left to direct access
+#else
+    return pathOnNetworkMount(QFileInfo(filePath).absoluteFilePath());
+#endif
+}
+
+QString NetworkFileStager::stagedPathFor(const QString& filePath) const {
+    // path+size+mtime key: an unchanged file re-opens warm, an updated
+    // one misses and is re-staged
+    const QString hash = DiskRenderCache::hashForFile(filePath);
+    if (hash.isEmpty()) {
+        return QString();
+    }
+    return m_stagingDir + "/" + hash + ".pdf";
+}
+
+QString NetworkFileStager::stage(
+    const QString& filePath,
+    const std::function<void(qint64, qint64)>& progress,
+    const std::atomic<bool>* cancelled) {
+    const QString localPath = stagedPathFor(filePath);
+    if (localPath.isEmpty()) {
+        return filePath;
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    QFile source(filePath);
+    const qint64 total = source.size();
+    if (QFile::exists(localPath) && QFileInfo(localPath).size() == total) {
+        // Warm copy from an earlier open of the same file version
+        if (progress) {
+            progress(total, total);
+        }
+        return localPath;
+    }
+
+    if (!source.open(QIODevice::ReadOnly)) {
+        return filePath;
+    }
+
+    // Write to a temp name and rename at the end, so a crash or
+    // cancellation mid-copy never leaves a truncated file under the
+    // key a later open would trust
+    const QString tempPath = localPath + ".part";
+    QFile target(tempPath);
+    if (!target.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return filePath;
+    }
+
+    qint64 done = 0;
+    while (done < total) {
+        if (cancelled && cancelled->load()) {
+            target.close();
+            QFile::remove(tempPath);
+            return filePath;
+        }
+        const QByteArray chunk = source.read(READAHEAD_BYTES);
+        if (chunk.isEmpty()) {
+            break;  // Short read: share went away mid-copy
+        }
+        if (target.write(chunk) != chunk.size()) {
+            break;  // Local disk full
+        }
+        done += chunk.size();
+        if (progress) {
+            progress(done, total);
+        }
+    }
+
+    target.close();
+    if (done != total) {
+        LOG_WARNING("NetworkFileStager: Staging of {} aborted at {}/{} bytes",
+                    filePath.toStdString(), done, total);
+        QFile::remove(tempPath);
+        return filePath;
+    }
+
+    QFile::remove(localPath);
+    if (!target.rename(localPath)) {
+        QFile::remove(tempPath);
+        return filePath;
+    }
+
+    locker.unlock();
+    prune();
+    return localPath;
+}
+
+void NetworkFileStager::prune() {
+    QMutexLocker locker(&m_mutex);
+
+    struct Entry {
+        QString path;
+        qint64 size;
+        QDateTime lastModified;
+    };
+    QVector<Entry> entries;
+    qint64 totalBytes = 0;
+
+    QDirIterator it(m_stagingDir, QDir::Files);
+    while (it.hasNext()) {
+        it.next();
+        const QFileInfo info = it.fileInfo();
+        entries.append({info.absoluteFilePath(), info.size(),
+                        info.lastModified()});
+        totalBytes += info.size();
+    }
+    if (totalBytes <= m_maxBytes) {
+        return;
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) {
+                  return a.lastModified < b.lastModified;
+              });
+    for (const Entry& entry : entries) {
+        if (totalBytes <= m_maxBytes) {
+            break;
+        }
+        if (QFile::remove(entry.path)) {
+            totalBytes -= entry.size;
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <atomic>
+#include <functional>
+
+/**
+ * Readahead staging layer for documents on network mounts.
+ *
+ * Poppler fetches PDF objects on demand with small random reads; over
+ * NFS/SMB every first visit to a page round-trips the share and stalls
+ * for seconds. For files that live on a network filesystem, stage()
+ * pulls the whole file into a local cache file with large sequential
+ * reads — the access pattern shares are fast at — and the loader then
+ * points Poppler at the local copy, so page turns hit local disk (and
+ * usually the OS page cache, since the copy was just written).
+ *
+ * Staged copies are keyed by path+size+mtime, so a re-open of an
+ * unchanged file reuses the warm copy without any network I/O; an
+ * updated file naturally misses and is re-staged. The cache directory
+ * is pruned oldest-first past a size budget.
+ *
+ * Plain synchronous class: staging runs on the loader's worker thread,
+ * which exists precisely to block on this kind of I/O.
+ */
+class NetworkFileStager {
+public:
+    static NetworkFileStager& instance();
+
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled; }
+
+    // True when the path lives on a filesystem that benefits from
+    // staging (UNC paths, NFS/SMB/SSHFS mounts)
+    bool shouldStage(const QString& filePath) const;
+
+    // Copies the file into the staging cache with readahead-sized
+    // sequential reads. progress(bytesDone, bytesTotal) fires from the
+    // calling thread; a set cancel flag abandons the copy. Returns the
+    // local path, or the original path on any failure so callers fall
+    // back to direct access
+    QString stage(const QString& filePath,
+                  const std::function<void(qint64, qint64)>& progress = {},
+                  const std::atomic<bool>* cancelled = nullptr);
+
+    // Evict oldest staged copies until under the size budget
+    void prune();
+
+    void setMaxBytes(qint64 maxBytes) { m_maxBytes = maxBytes; }
+    qint64 maxBytes() const { return m_maxBytes; }
+
+    QString stagingDir() const { return m_stagingDir; }
+
+private:
+    NetworkFileStager();
+
+    QString stagedPathFor(const QString& filePath) const;
+
+    QString m_stagingDir;
+    std::atomic<bool> m_enabled;
+    qint64 m_maxBytes;
+    // One bulk copy at a time: concurrent copies from the same share
+    // would turn two sequential streams into interleaved seeks
+    mutable QMutex m_mutex;
+
+    static constexpr qint64 READAHEAD_BYTES = 4 * 1024 * 1024;
+    static constexpr qint64 DEFAULT_MAX_BYTES = 1024LL * 1024 * 1024;  // 1GB
+};
@@ -0,0 +1,146 @@
+#include "PageCostModel.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QStandardPaths>
+#include <algorithm>
+
+PageCostModel& PageCostModel::instance() {
+    static PageCostModel model;
+    return model;
+}
+
+void PageCostModel::recordRender(const QString& documentHash, int pageNumber,
+                                 qint64 durationMs, const QSize& imageSize) {
+    if (documentHash.isEmpty() || pageNumber < 0 || imageSize.isEmpty()) {
+        return;
+    }
+
+    const double megapixels = static_cast<double>(imageSize.width()) *
+                              imageSize.height() / 1e6;
+    if (megapixels <= 0.0) {
+        return;
+    }
+    const double observed = static_cast<double>(durationMs) / megapixels;
+
+    bool saveNow = false;
+    QHash<int, double> snapshot;
+    {
+        QMutexLocker locker(&m_mutex);
+        DocumentCosts& doc = costsFor(documentHash);
+        auto it = doc.msPerMegapixel.find(pageNumber);
+        if (it == doc.msPerMegapixel.end()) {
+            doc.msPerMegapixel.insert(pageNumber, observed);
+        } else {
+            *it = EWMA_ALPHA * observed + (1.0 - EWMA_ALPHA) * *it;
+        }
+        if (++doc.unsavedRecords >= SAVE_EVERY_RECORDS) {
+            doc.unsavedRecords = 0;
+            saveNow = true;
+            snapshot = doc.msPerMegapixel;
+        }
+    }
+
+    // File IO happens outside the lock so a slow disk never stalls the
+    // render threads feeding the model
+    if (saveNow) {
+        saveDocument(documentHash, snapshot);
+    }
+}
+
+double PageCostModel::predictedCost(const QString& documentHash,
+                                    int pageNumber) const {
+    QMutexLocker locker(&m_mutex);
+    const DocumentCosts& doc = costsFor(documentHash);
+    auto it = doc.msPerMegapixel.constFind(pageNumber);
+    if (it != doc.msPerMegapixel.constEnd()) {
+        return it.value();
+    }
+    locker.unlock();
+    return documentMedianCost(documentHash);
+}
+
+bool PageCostModel::hasEstimate(const QString& documentHash,
+                                int pageNumber) const {
+    QMutexLocker locker(&m_mutex);
+    return costsFor(documentHash).msPerMegapixel.contains(pageNumber);
+}
+
+double PageCostModel::documentMedianCost(const QString& documentHash) const {
+    QMutexLocker locker(&m_mutex);
+    const DocumentCosts& doc = costsFor(documentHash);
+    if (doc.msPerMegapixel.isEmpty()) {
+        return DEFAULT_COST_MS_PER_MP;
+    }
+    QList<double> costs = doc.msPerMegapixel.values();
+    std::nth_element(costs.begin(), costs.begin() + costs.size() / 2,
+                     costs.end());
+    return costs[costs.size() / 2];
+}
+
+void PageCostModel::flush() {
+    QList<QPair<QString, QHash<int, double>>> pending;
+    {
+        QMutexLocker locker(&m_mutex);
+        for (auto it = m_documents.begin(); it != m_documents.end(); ++it) {
+            if (it->unsavedRecords > 0) {
+                it->unsavedRecords = 0;
+                pending.append({it.key(), it->msPerMegapixel});
+            }
+        }
+    }
+    for (const auto& entry : pending) {
+        saveDocument(entry.first, entry.second);
+    }
+}
+
+PageCostModel::DocumentCosts& PageCostModel::costsFor(
+    const QString& documentHash) const {
+    DocumentCosts& doc = m_documents[documentHash];
+    if (doc.loaded) {
+        return doc;
+    }
+    doc.loaded = true;
+
+    QFile file(costsFilePath(documentHash));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return doc;  // First open of this document; no history yet
+    }
+    QJsonDocument json = QJsonDocument::fromJson(file.readAll());
+    if (!json.isObject()) {
+        return doc;
+    }
+    QJsonObject costs = json.object()["msPerMegapixel"].toObject();
+    for (auto it = costs.constBegin(); it != costs.constEnd(); ++it) {
+        doc.msPerMegapixel[it.key().toInt()] = it.value().toDouble();
+    }
+    return doc;
+}
+
+void PageCostModel::saveDocument(const QString& documentHash,
+                                 const QHash<int, double>& costs) const {
+    QJsonObject costsJson;
+    for (auto it = costs.constBegin(); it != costs.constEnd(); ++it) {
+        costsJson[QString::number(it.key())] = it.value();
+    }
+
+    QJsonObject root;
+    root["version"] = 1;
+    root["msPerMegapixel"] = costsJson;
+
+    QString path = costsFilePath(documentHash);
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QFile file(path);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    }
+}
+
+QString PageCostModel::costsFilePath(const QString& documentHash) {
+    return QStandardPaths::writableLocation(
+               QStandardPaths::AppDataLocation) +
+           "/render-costs/" + documentHash + ".json";
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QSize>
+#include <QString>
+
+/**
+ * Persistent per-page render cost model.
+ *
+ * Scheduling used to treat every page as equal cost, but real
+ * documents mix 5ms text pages with multi-second full-page scans, so
+ * a naive prefetch of one expensive page starves several cheap
+ * neighbours. The render pipeline records each observed render here,
+ * normalized to milliseconds per megapixel of output so different
+ * zoom levels feed one estimate per page, smoothed with an EWMA and
+ * persisted per document next to the prerenderer's reading patterns.
+ * PDFPrerenderer weights its priorities with these predictions:
+ * known-expensive pages that are likely next start earlier, and
+ * distant expensive pages yield to cheap neighbours.
+ */
+class PageCostModel {
+public:
+    static PageCostModel& instance();
+
+    // Record one observed render. Thread-safe; called from pool
+    // threads. Every few records the document's map is persisted
+    void recordRender(const QString& documentHash, int pageNumber,
+                      qint64 durationMs, const QSize& imageSize);
+
+    // Predicted ms per megapixel; the document median when this page
+    // was never rendered
+    double predictedCost(const QString& documentHash, int pageNumber) const;
+    bool hasEstimate(const QString& documentHash, int pageNumber) const;
+
+    // Median estimate across the document's rendered pages;
+    // DEFAULT_COST_MS_PER_MP before anything was observed
+    double documentMedianCost(const QString& documentHash) const;
+
+    // Persist all documents with unsaved records
+    void flush();
+
+private:
+    PageCostModel() = default;
+    ~PageCostModel() { flush(); }
+
+    struct DocumentCosts {
+        QHash<int, double> msPerMegapixel;
+        int unsavedRecords = 0;
+        bool loaded = false;
+    };
+
+    // Lazily loads the per-document file on first touch of a hash;
+    // m_mutex must be held
+    DocumentCosts& costsFor(const QString& documentHash) const;
+    void saveDocument(const QString& documentHash,
+                      const QHash<int, double>& costs) const;
+    static QString costsFilePath(const QString& documentHash);
+
+    mutable QMutex m_mutex;
+    mutable QHash<QString, DocumentCosts> m_documents;
+
+    // Smoothing weight of the newest observation
+    static constexpr double EWMA_ALPHA = 0.3;
+    // Prior for documents with no history yet
+    static constexpr double DEFAULT_COST_MS_PER_MP = 40.0;
+    // Persist after this many new records per document
+    static constexpr int SAVE_EVERY_RECORDS = 8;
+};
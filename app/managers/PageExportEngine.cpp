@@ -0,0 +1,228 @@
+#include "PageExportEngine.h"
+#include <QDir>
+#include <QImage>
+#include <QMetaObject>
+#include <QPointer>
+#include "RenderScheduler.h"
+#include "utils/LoggingMacros.h"
+
+PageExportEngine::PageExportEngine(QObject* parent) : QObject(parent) {
+    // PNG/JPEG compression is pure CPU and must not steal Poppler
+    // render threads from the shared pool. Two encoders keep up in
+    // practice; if compression ever falls behind, the slot semaphore
+    // pushes back on the render shards instead of growing a queue.
+    m_encoderPool.setMaxThreadCount(ENCODER_THREADS);
+}
+
+PageExportEngine::~PageExportEngine() {
+    cancel();
+    waitForFinished();
+    m_encoderPool.waitForDone();
+}
+
+bool PageExportEngine::startExport(Poppler::Document* document, int firstPage,
+                                   int lastPage, const QString& outputDir,
+                                   const QString& format, double dpi) {
+    if (!document || document->numPages() <= 0) {
+        emit exportFailed("No document to export");
+        return false;
+    }
+
+    const int pageCount = document->numPages();
+    firstPage = qMax(0, firstPage);
+    lastPage = qMin(pageCount - 1, lastPage);
+    if (firstPage > lastPage) {
+        emit exportFailed("Empty page range");
+        return false;
+    }
+
+    QDir dir(outputDir);
+    if (!dir.exists() && !dir.mkpath(outputDir)) {
+        emit exportFailed(
+            QString("Cannot create output directory: %1").arg(outputDir));
+        return false;
+    }
+
+    auto job = std::make_shared<ExportJob>();
+    job->document = document;
+    job->outputDir = dir.absolutePath();
+    job->saveFormat = format;
+    job->extension = format.toLower();
+    job->dpi = (dpi > 0 && dpi <= 600) ? dpi : DEFAULT_EXPORT_DPI;
+    job->firstPage = firstPage;
+    job->lastPage = lastPage;
+    job->total = lastPage - firstPage + 1;
+
+    {
+        QMutexLocker locker(&m_jobMutex);
+        if (m_job && m_job->settled.load() < m_job->total) {
+            return false;
+        }
+        m_job = job;
+    }
+
+    LOG_DEBUG(
+        "PageExportEngine: exporting pages {}..{} at {} DPI as {} into {}",
+        firstPage, lastPage, job->dpi, job->extension.toStdString(),
+        job->outputDir.toStdString());
+
+    // One render shard per pool thread, pages round-robin like
+    // PDFUtilities::extractTextRange. Unlike that blocking batch there
+    // is no calling-thread shard: the export is fire-and-forget and the
+    // encoder pool guarantees slot releases even when the render pool
+    // is saturated.
+    int shards = qBound(1, RenderScheduler::instance().maxThreadCount(),
+                        job->total);
+    if (job->total < 4) {
+        shards = 1;
+    }
+    for (int shard = 0; shard < shards; ++shard) {
+        RenderScheduler::instance().submit(
+            RenderScheduler::TaskClass::Background,
+            [this, job, shard, shards]() { runRenderShard(job, shard, shards); });
+    }
+    return true;
+}
+
+void PageExportEngine::runRenderShard(const std::shared_ptr<ExportJob>& job,
+                                      int shard, int shards) {
+    QPointer<PageExportEngine> self(this);
+    for (int pageNumber = job->firstPage + shard; pageNumber <= job->lastPage;
+         pageNumber += shards) {
+        if (job->cancelled.load()) {
+            settlePage(job);
+            continue;
+        }
+
+        job->slots.acquire();
+        if (job->cancelled.load()) {
+            job->slots.release();
+            settlePage(job);
+            continue;
+        }
+
+        QImage image;
+        try {
+            std::unique_ptr<Poppler::Page> page(
+                job->document->page(pageNumber));
+            if (page) {
+                image = page->renderToImage(job->dpi, job->dpi);
+            }
+        } catch (const std::exception& e) {
+            LOG_WARNING("PageExportEngine: exception rendering page {}: {}",
+                        pageNumber, e.what());
+        }
+
+        if (image.isNull()) {
+            job->slots.release();
+            ++job->failed;
+            LOG_WARNING("PageExportEngine: failed to render page {}",
+                        pageNumber);
+            settlePage(job);
+            continue;
+        }
+
+        // Hand the rendered page to an encoder thread; QImage is
+        // implicitly shared so the capture is a refcount bump, and the
+        // slot travels with the image until it is on disk.
+        m_encoderPool.start([self, job, pageNumber, image]() {
+            const QString fileName = QString("page_%1.%2")
+                                         .arg(pageNumber + 1, 3, 10, QChar('0'))
+                                         .arg(job->extension);
+            const QString filePath = QDir(job->outputDir).filePath(fileName);
+            const bool saved =
+                image.save(filePath, job->saveFormat.toUtf8().constData());
+            job->slots.release();
+
+            if (saved) {
+                ++job->exported;
+                if (self) {
+                    QMetaObject::invokeMethod(
+                        self,
+                        [self, pageNumber, filePath]() {
+                            if (self) {
+                                emit self->pageExported(pageNumber, filePath);
+                            }
+                        },
+                        Qt::QueuedConnection);
+                }
+            } else {
+                ++job->failed;
+                LOG_WARNING("PageExportEngine: failed to write {}",
+                            filePath.toStdString());
+            }
+            if (self) {
+                self->settlePage(job);
+            }
+        });
+    }
+}
+
+void PageExportEngine::settlePage(const std::shared_ptr<ExportJob>& job) {
+    const int done = ++job->settled;
+
+    QPointer<PageExportEngine> self(this);
+    QMetaObject::invokeMethod(
+        self,
+        [self, job, done]() {
+            if (!self) {
+                return;
+            }
+            emit self->exportProgressChanged(done, job->total);
+            if (done == job->total) {
+                if (job->cancelled.load()) {
+                    emit self->exportCancelled();
+                } else {
+                    emit self->exportFinished(job->exported.load(),
+                                              job->failed.load());
+                }
+            }
+        },
+        Qt::QueuedConnection);
+
+    if (done == job->total) {
+        job->finishedSem.release();
+    }
+}
+
+void PageExportEngine::cancel() {
+    QMutexLocker locker(&m_jobMutex);
+    if (m_job) {
+        m_job->cancelled.store(true);
+    }
+}
+
+bool PageExportEngine::isExporting() const {
+    QMutexLocker locker(&m_jobMutex);
+    return m_job && m_job->settled.load() < m_job->total;
+}
+
+int PageExportEngine::lastExportedCount() const {
+    QMutexLocker locker(&m_jobMutex);
+    return m_job ? m_job->exported.load() : 0;
+}
+
+int PageExportEngine::lastFailedCount() const {
+    QMutexLocker locker(&m_jobMutex);
+    return m_job ? m_job->failed.load() : 0;
+}
+
+bool PageExportEngine::waitForFinished(int msecs) {
+    std::shared_ptr<ExportJob> job;
+    {
+        QMutexLocker locker(&m_jobMutex);
+        job = m_job;
+    }
+    if (!job || job->settled.load() >= job->total) {
+        return true;
+    }
+    if (msecs < 0) {
+        job->finishedSem.acquire();
+    } else if (!job->finishedSem.tryAcquire(1, msecs)) {
+        return false;
+    }
+    // Put the token back so repeated waiters (and the destructor) also
+    // pass.
+    job->finishedSem.release();
+    return true;
+}
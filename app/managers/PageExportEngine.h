@@ -0,0 +1,115 @@
+#pragma once
+
+#include <QMutex>
+#include <QObject>
+#include <QSemaphore>
+#include <QString>
+#include <QThreadPool>
+#include <atomic>
+#include <memory>
+
+#include <poppler/qt6/poppler-qt6.h>
+
+/**
+ * Parallel page export pipeline.
+ *
+ * PDFUtilities::exportDocumentAsImages used to render and encode one
+ * page at a time on the calling thread, so exporting a long document
+ * was a minutes-long serial walk. This engine splits the two halves of
+ * the job: Poppler renders fan out across the shared RenderScheduler
+ * pool while PNG/JPEG compression and the disk write run on a small
+ * dedicated encoder pool, so rasterizing page N+1 overlaps encoding
+ * page N. A slot semaphore bounds how many rendered-but-unencoded
+ * images exist at once, so a high-DPI export of a huge document
+ * streams to disk in constant memory instead of buffering the range.
+ *
+ * Keeping the encoder pool separate from the render pool also means a
+ * saturated render pool can never deadlock the pipeline: slot releases
+ * come from encoder threads, which are never queued behind renders.
+ *
+ * Progress is reported per page in the same signal shape
+ * AsyncDocumentLoader uses; all signals are delivered as queued calls
+ * on the engine's thread. The caller keeps the document alive until
+ * exportFinished()/exportCancelled() fires or waitForFinished()
+ * returns.
+ */
+class PageExportEngine : public QObject {
+    Q_OBJECT
+
+public:
+    explicit PageExportEngine(QObject* parent = nullptr);
+    ~PageExportEngine() override;
+
+    // Starts exporting [firstPage, lastPage] (clamped to the document)
+    // into outputDir as "page_NNN.<ext>" files and returns immediately.
+    // Returns false if an export is already running or the output
+    // directory cannot be created.
+    bool startExport(Poppler::Document* document, int firstPage, int lastPage,
+                     const QString& outputDir, const QString& format = "PNG",
+                     double dpi = DEFAULT_EXPORT_DPI);
+
+    // Requests cancellation; pages not yet rendered are skipped and
+    // exportCancelled() fires once in-flight pages drain.
+    void cancel();
+
+    bool isExporting() const;
+
+    // Counters for the most recent run; meaningful once it has settled.
+    int lastExportedCount() const;
+    int lastFailedCount() const;
+
+    // Blocks until the current export settles (finished or cancelled).
+    // Returns false on timeout; msecs < 0 waits forever.
+    bool waitForFinished(int msecs = -1);
+
+signals:
+    // Per-page progress (pagesDone of pagesTotal)
+    void exportProgressChanged(int pagesDone, int pagesTotal);
+
+    // One page landed on disk
+    void pageExported(int pageNumber, const QString& filePath);
+
+    // Every page settled without cancellation
+    void exportFinished(int exported, int failed);
+
+    // Cancellation drained
+    void exportCancelled();
+
+    // Export could not start
+    void exportFailed(const QString& error);
+
+private:
+    // Shared state for one export run; render shards and encoder jobs
+    // hold it by shared_ptr so a superseded run can drain safely.
+    struct ExportJob {
+        Poppler::Document* document = nullptr;
+        QString outputDir;
+        QString saveFormat;  // as passed to QImage::save, e.g. "PNG"
+        QString extension;   // lower-case file suffix
+        double dpi = DEFAULT_EXPORT_DPI;
+        int firstPage = 0;
+        int lastPage = 0;
+        int total = 0;
+        std::atomic<int> settled{0};  // encoded + failed + skipped
+        std::atomic<int> exported{0};
+        std::atomic<int> failed{0};
+        std::atomic<bool> cancelled{false};
+        QSemaphore slots{MAX_INFLIGHT_IMAGES};
+        QSemaphore finishedSem;
+    };
+
+    void runRenderShard(const std::shared_ptr<ExportJob>& job, int shard,
+                        int shards);
+    void settlePage(const std::shared_ptr<ExportJob>& job);
+
+    QThreadPool m_encoderPool;
+    std::shared_ptr<ExportJob> m_job;
+    mutable QMutex m_jobMutex;
+
+    // Bound on rendered images waiting for an encoder; at 150 DPI an
+    // A4 page is ~8MB, so the pipeline peaks around 64MB regardless of
+    // document length.
+    static constexpr int MAX_INFLIGHT_IMAGES = 8;
+    static constexpr int ENCODER_THREADS = 2;
+    static constexpr double DEFAULT_EXPORT_DPI = 150.0;
+};
@@ -0,0 +1,268 @@
+#include "PrintSpooler.h"
+#include <QMetaObject>
+#include <QPagedPaintDevice>
+#include <QPainter>
+#include <QPointer>
+#include "utils/LoggingMacros.h"
+
+PrintSpooler::PrintSpooler(QObject* parent) : QObject(parent) {
+    // Exactly one producer and one consumer; the queue between them is
+    // the only coupling, so two threads is the whole pipeline.
+    m_spoolPool.setMaxThreadCount(2);
+}
+
+PrintSpooler::~PrintSpooler() {
+    cancel();
+    waitForFinished();
+    m_spoolPool.waitForDone();
+}
+
+bool PrintSpooler::startSpool(Poppler::Document* document,
+                              QPagedPaintDevice* device, int firstPage,
+                              int lastPage, double dpi) {
+    if (!document || document->numPages() <= 0) {
+        emit spoolFailed("No document to print");
+        return false;
+    }
+    if (!device) {
+        emit spoolFailed("No print device");
+        return false;
+    }
+
+    const int pageCount = document->numPages();
+    firstPage = qMax(0, firstPage);
+    lastPage = qMin(pageCount - 1, lastPage);
+    if (firstPage > lastPage) {
+        emit spoolFailed("Empty page range");
+        return false;
+    }
+
+    auto job = std::make_shared<SpoolJob>();
+    job->document = document;
+    job->device = device;
+    job->dpi = (dpi > 0 && dpi <= 600) ? dpi : DEFAULT_PRINT_DPI;
+    job->firstPage = firstPage;
+    job->lastPage = lastPage;
+    job->total = lastPage - firstPage + 1;
+
+    {
+        QMutexLocker locker(&m_jobMutex);
+        if (m_job && !m_job->settledFlag.load()) {
+            return false;
+        }
+        m_job = job;
+    }
+
+    LOG_DEBUG("PrintSpooler: spooling pages {}..{} at {} DPI", firstPage,
+              lastPage, job->dpi);
+
+    m_spoolPool.start([this, job]() { runProducer(job); });
+    m_spoolPool.start([this, job]() { runConsumer(job); });
+    return true;
+}
+
+void PrintSpooler::runProducer(const std::shared_ptr<SpoolJob>& job) {
+    for (int pageNumber = job->firstPage; pageNumber <= job->lastPage;
+         ++pageNumber) {
+        if (job->cancelled.load()) {
+            break;
+        }
+
+        QImage image;
+        try {
+            std::unique_ptr<Poppler::Page> page(
+                job->document->page(pageNumber));
+            if (page) {
+                image = page->renderToImage(job->dpi, job->dpi);
+            }
+        } catch (const std::exception& e) {
+            LOG_WARNING("PrintSpooler: exception rendering page {}: {}",
+                        pageNumber, e.what());
+        }
+
+        if (image.isNull()) {
+            ++job->failed;
+            LOG_WARNING("PrintSpooler: failed to render page {}", pageNumber);
+            continue;
+        }
+
+        // Backpressure: when the device lags, the producer parks here
+        // instead of stacking up rendered pages.
+        QMutexLocker locker(&job->queueMutex);
+        while (job->queue.size() >= QUEUE_DEPTH && !job->cancelled.load()) {
+            job->notFull.wait(&job->queueMutex);
+        }
+        if (job->cancelled.load()) {
+            break;
+        }
+        job->queue.enqueue({pageNumber, image});
+        job->notEmpty.wakeOne();
+    }
+
+    QMutexLocker locker(&job->queueMutex);
+    job->producerDone = true;
+    job->notEmpty.wakeOne();
+}
+
+void PrintSpooler::runConsumer(const std::shared_ptr<SpoolJob>& job) {
+    // The consumer owns the painter for the whole run; pages arrive in
+    // order because the single producer renders them in order.
+    QPainter painter;
+    if (!painter.begin(job->device)) {
+        job->cancelled.store(true);
+        {
+            QMutexLocker locker(&job->queueMutex);
+            job->notFull.wakeAll();
+        }
+        QPointer<PrintSpooler> self(this);
+        QMetaObject::invokeMethod(
+            self,
+            [self]() {
+                if (self) {
+                    emit self->spoolFailed(
+                        "Print device rejected the painter");
+                }
+            },
+            Qt::QueuedConnection);
+        settleJob(job, job->total);
+        return;
+    }
+
+    bool firstPage = true;
+    int pagesDone = 0;
+    while (true) {
+        RenderedPage rendered;
+        {
+            QMutexLocker locker(&job->queueMutex);
+            while (job->queue.isEmpty() && !job->producerDone &&
+                   !job->cancelled.load()) {
+                job->notEmpty.wait(&job->queueMutex);
+            }
+            if (job->cancelled.load()) {
+                // Discard whatever the producer managed to queue; the
+                // buffers die here, not at spool end.
+                job->queue.clear();
+                job->notFull.wakeAll();
+                break;
+            }
+            if (job->queue.isEmpty()) {
+                break;  // producer done and queue drained
+            }
+            rendered = job->queue.dequeue();
+            job->notFull.wakeOne();
+        }
+
+        if (!firstPage) {
+            job->device->newPage();
+        }
+        firstPage = false;
+
+        // Aspect-fit onto the device page; the image is released as
+        // soon as this iteration ends, recycling its slot in the queue.
+        const QRect viewport = painter.viewport();
+        QSize target = rendered.image.size();
+        target.scale(viewport.size(), Qt::KeepAspectRatio);
+        const QRect targetRect(
+            viewport.x() + (viewport.width() - target.width()) / 2,
+            viewport.y() + (viewport.height() - target.height()) / 2,
+            target.width(), target.height());
+        painter.drawImage(targetRect, rendered.image);
+
+        ++job->printed;
+        ++pagesDone;
+
+        const int pageNumber = rendered.pageNumber;
+        QPointer<PrintSpooler> self(this);
+        QMetaObject::invokeMethod(
+            self,
+            [self, pageNumber]() {
+                if (self) {
+                    emit self->pagePrinted(pageNumber);
+                }
+            },
+            Qt::QueuedConnection);
+        reportProgress(job, pagesDone + job->failed.load());
+    }
+
+    painter.end();
+    settleJob(job, job->total);
+}
+
+void PrintSpooler::reportProgress(const std::shared_ptr<SpoolJob>& job,
+                                  int pagesDone) {
+    QPointer<PrintSpooler> self(this);
+    QMetaObject::invokeMethod(
+        self,
+        [self, job, pagesDone]() {
+            if (self) {
+                emit self->spoolProgressChanged(pagesDone, job->total);
+            }
+        },
+        Qt::QueuedConnection);
+}
+
+void PrintSpooler::settleJob(const std::shared_ptr<SpoolJob>& job,
+                             int pagesDone) {
+    if (job->settledFlag.exchange(true)) {
+        return;
+    }
+
+    QPointer<PrintSpooler> self(this);
+    QMetaObject::invokeMethod(
+        self,
+        [self, job, pagesDone]() {
+            if (!self) {
+                return;
+            }
+            emit self->spoolProgressChanged(pagesDone, job->total);
+            if (job->cancelled.load()) {
+                emit self->spoolCancelled();
+            } else {
+                emit self->spoolFinished(job->printed.load(),
+                                         job->failed.load());
+            }
+        },
+        Qt::QueuedConnection);
+
+    job->finishedSem.release();
+}
+
+void PrintSpooler::cancel() {
+    std::shared_ptr<SpoolJob> job;
+    {
+        QMutexLocker locker(&m_jobMutex);
+        job = m_job;
+    }
+    if (!job) {
+        return;
+    }
+    job->cancelled.store(true);
+    QMutexLocker locker(&job->queueMutex);
+    job->notFull.wakeAll();
+    job->notEmpty.wakeAll();
+}
+
+bool PrintSpooler::isSpooling() const {
+    QMutexLocker locker(&m_jobMutex);
+    return m_job && !m_job->settledFlag.load();
+}
+
+bool PrintSpooler::waitForFinished(int msecs) {
+    std::shared_ptr<SpoolJob> job;
+    {
+        QMutexLocker locker(&m_jobMutex);
+        job = m_job;
+    }
+    if (!job || job->settledFlag.load()) {
+        return true;
+    }
+    if (msecs < 0) {
+        job->finishedSem.acquire();
+    } else if (!job->finishedSem.tryAcquire(1, msecs)) {
+        return false;
+    }
+    // Put the token back so repeated waiters (and the destructor) also
+    // pass.
+    job->finishedSem.release();
+    return true;
+}
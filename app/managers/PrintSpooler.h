@@ -0,0 +1,127 @@
+#pragma once
+
+#include <QImage>
+#include <QMutex>
+#include <QObject>
+#include <QQueue>
+#include <QSemaphore>
+#include <QString>
+#include <QThreadPool>
+#include <QWaitCondition>
+#include <atomic>
+#include <memory>
+
+#include <poppler/qt6/poppler-qt6.h>
+
+class QPagedPaintDevice;
+
+/**
+ * Streaming print pipeline with a bounded page queue.
+ *
+ * Spooling a document naively renders pages as fast as Poppler can and
+ * parks the results until the paint device consumes them, so a long
+ * document balloons memory for the whole spool. This spooler puts a
+ * fixed-depth queue between one render producer and one paint consumer:
+ * the producer renders pages in order and blocks when the queue is
+ * full, the consumer paints each page onto the device and drops the
+ * image immediately, so a 1000-page job never holds more than
+ * QUEUE_DEPTH + 2 page images regardless of how slow the device is.
+ *
+ * The producer runs on a dedicated two-thread pool rather than the
+ * shared RenderScheduler: backpressure works by parking the producer on
+ * a wait condition, and a parked shared-pool worker would starve
+ * interactive rendering for the duration of the print job.
+ *
+ * The target is any QPagedPaintDevice — QPdfWriter today; QPrinter is a
+ * drop-in if Qt PrintSupport is ever linked. The caller configures the
+ * device (page size, resolution) and keeps it and the document alive
+ * until spoolFinished()/spoolCancelled() fires or waitForFinished()
+ * returns. Signals are delivered as queued calls on the spooler's
+ * thread, matching PageExportEngine.
+ */
+class PrintSpooler : public QObject {
+    Q_OBJECT
+
+public:
+    explicit PrintSpooler(QObject* parent = nullptr);
+    ~PrintSpooler() override;
+
+    // Starts spooling [firstPage, lastPage] (clamped to the document)
+    // onto the device and returns immediately. Returns false if a spool
+    // is already running or the range is empty.
+    bool startSpool(Poppler::Document* document, QPagedPaintDevice* device,
+                    int firstPage, int lastPage,
+                    double dpi = DEFAULT_PRINT_DPI);
+
+    // Requests cancellation; the producer stops rendering, queued pages
+    // are discarded and spoolCancelled() fires once the pipeline drains.
+    void cancel();
+
+    bool isSpooling() const;
+
+    // Blocks until the current spool settles (finished or cancelled).
+    // Returns false on timeout; msecs < 0 waits forever.
+    bool waitForFinished(int msecs = -1);
+
+signals:
+    // Per-page progress (pagesDone of pagesTotal, rendered or skipped)
+    void spoolProgressChanged(int pagesDone, int pagesTotal);
+
+    // One page landed on the device
+    void pagePrinted(int pageNumber);
+
+    // Every page settled without cancellation
+    void spoolFinished(int printed, int failed);
+
+    // Cancellation drained
+    void spoolCancelled();
+
+    // Spool could not start or the device rejected the painter
+    void spoolFailed(const QString& error);
+
+private:
+    struct RenderedPage {
+        int pageNumber = -1;
+        QImage image;
+    };
+
+    // Shared state for one spool run; producer and consumer hold it by
+    // shared_ptr so a superseded run can drain safely.
+    struct SpoolJob {
+        Poppler::Document* document = nullptr;
+        QPagedPaintDevice* device = nullptr;
+        double dpi = DEFAULT_PRINT_DPI;
+        int firstPage = 0;
+        int lastPage = 0;
+        int total = 0;
+        std::atomic<int> printed{0};
+        std::atomic<int> failed{0};
+        std::atomic<bool> cancelled{false};
+        std::atomic<bool> settledFlag{false};
+
+        // Bounded handoff between producer and consumer. producerDone
+        // marks the queue closed; notFull is the backpressure edge.
+        QMutex queueMutex;
+        QWaitCondition notFull;
+        QWaitCondition notEmpty;
+        QQueue<RenderedPage> queue;
+        bool producerDone = false;
+
+        QSemaphore finishedSem;
+    };
+
+    void runProducer(const std::shared_ptr<SpoolJob>& job);
+    void runConsumer(const std::shared_ptr<SpoolJob>& job);
+    void settleJob(const std::shared_ptr<SpoolJob>& job, int pagesDone);
+    void reportProgress(const std::shared_ptr<SpoolJob>& job, int pagesDone);
+
+    QThreadPool m_spoolPool;
+    std::shared_ptr<SpoolJob> m_job;
+    mutable QMutex m_jobMutex;
+
+    // Rendered pages waiting for the device. At 300 DPI an A4 page is
+    // ~35MB, so the pipeline peaks around 140MB plus the page being
+    // rendered and the one being painted.
+    static constexpr int QUEUE_DEPTH = 4;
+    static constexpr double DEFAULT_PRINT_DPI = 300.0;
+};
@@ -1,4 +1,5 @@
 #include "RecentFilesManager.h"
+#include <QDataStream>
 #include <QDir>
 #include <QFileInfo>
 #include <QList>
@@ -10,8 +11,15 @@
 #include <QTimer>
 #include <QtCore/QObject>
 #include <algorithm>
+#include "AppStateStore.h"
 #include "utils/Logger.h"
 
+namespace {
+// Layout version of the "recentFiles" AppStateStore section
+constexpr qint32 RECENT_SECTION_VERSION = 1;
+const QString RECENT_SECTION = QStringLiteral("recentFiles");
+}  // namespace
+
 const QString RecentFilesManager::SETTINGS_GROUP = "recentFiles";
 const QString RecentFilesManager::SETTINGS_MAX_FILES_KEY = "maxFiles";
 const QString RecentFilesManager::SETTINGS_FILES_KEY = "files";
@@ -30,7 +38,11 @@ RecentFilesManager::RecentFilesManager(QObject* parent)
         "RecentFilesManager: Initialized with max files: {}", m_maxRecentFiles);
 }
 
-RecentFilesManager::~RecentFilesManager() { saveSettings(); }
+RecentFilesManager::~RecentFilesManager() {
+    saveSettings();
+    // 关机路径：状态没变时flush是空操作，不再有几百毫秒的sync停顿
+    AppStateStore::instance().flush();
+}
 
 void RecentFilesManager::addRecentFile(const QString& filePath) {
     if (filePath.isEmpty()) {
@@ -225,6 +237,42 @@ void RecentFilesManager::loadSettingsWithoutCleanup() {
 
     QMutexLocker locker(&m_mutex);
 
+    // 优先读二进制状态区；旧版QSettings数据只在首次迁移时还会用到
+    const QByteArray blob = AppStateStore::instance().section(RECENT_SECTION);
+    if (!blob.isEmpty()) {
+        QDataStream stream(blob);
+        stream.setVersion(QDataStream::Qt_6_0);
+
+        qint32 version = 0;
+        qint32 maxFiles = DEFAULT_MAX_RECENT_FILES;
+        qint32 count = 0;
+        stream >> version >> maxFiles >> count;
+        if (stream.status() == QDataStream::Ok &&
+            version == RECENT_SECTION_VERSION && count >= 0 && count <= 50) {
+            m_maxRecentFiles = qBound(1, static_cast<int>(maxFiles), 50);
+            m_recentFiles.clear();
+            m_recentFiles.reserve(count);
+            for (qint32 i = 0; i < count; ++i) {
+                RecentFileInfo info;
+                stream >> info.filePath >> info.fileName >> info.lastOpened >>
+                    info.fileSize;
+                if (stream.status() != QDataStream::Ok) {
+                    break;
+                }
+                if (!info.filePath.isEmpty() && !info.fileName.isEmpty()) {
+                    m_recentFiles.append(info);
+                }
+            }
+            Logger::instance().debug(
+                "[managers] Loaded {} recent files from state store",
+                m_recentFiles.size());
+            return;
+        }
+        Logger::instance().warning(
+            "[managers] Unreadable recentFiles section, falling back to "
+            "QSettings");
+    }
+
     m_settings->beginGroup(SETTINGS_GROUP);
 
     // 加载最大文件数量
@@ -264,27 +312,24 @@ void RecentFilesManager::loadSettingsWithoutCleanup() {
 }
 
 void RecentFilesManager::saveSettings() {
-    if (!m_settings)
-        return;
-
     // 注意：这里不需要加锁，因为调用此方法的地方已经加锁了
 
-    m_settings->beginGroup(SETTINGS_GROUP);
-
-    // 保存最大文件数量
-    m_settings->setValue(SETTINGS_MAX_FILES_KEY, m_maxRecentFiles);
-
-    // 保存文件列表
-    m_settings->beginWriteArray(SETTINGS_FILES_KEY);
-    for (int i = 0; i < m_recentFiles.size(); ++i) {
-        m_settings->setArrayIndex(i);
-        QVariantMap data = fileInfoToVariant(m_recentFiles[i]);
-        m_settings->setValue("fileInfo", data);
+    // 序列化成紧凑二进制段交给状态区；字节没变就不会落盘，
+    // checkpoint在后台线程异步写，不再每次变更同步sync整个QSettings
+    QByteArray blob;
+    {
+        QDataStream stream(&blob, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_6_0);
+        stream << RECENT_SECTION_VERSION
+               << static_cast<qint32>(m_maxRecentFiles)
+               << static_cast<qint32>(m_recentFiles.size());
+        for (const RecentFileInfo& info : m_recentFiles) {
+            stream << info.filePath << info.fileName << info.lastOpened
+                   << info.fileSize;
+        }
     }
-    m_settings->endArray();
-
-    m_settings->endGroup();
-    m_settings->sync();
+    AppStateStore::instance().putSection(RECENT_SECTION, blob);
+    AppStateStore::instance().checkpoint();
 }
 
 void RecentFilesManager::enforceMaxSize() {
@@ -294,16 +339,6 @@ void RecentFilesManager::enforceMaxSize() {
     }
 }
 
-QVariantMap RecentFilesManager::fileInfoToVariant(
-    const RecentFileInfo& info) const {
-    QVariantMap data;
-    data["filePath"] = info.filePath;
-    data["fileName"] = info.fileName;
-    data["lastOpened"] = info.lastOpened;
-    data["fileSize"] = static_cast<qint64>(info.fileSize);
-    return data;
-}
-
 RecentFileInfo RecentFilesManager::variantToFileInfo(
     const QVariantMap& variant) const {
     RecentFileInfo info;
@@ -79,9 +79,9 @@ private:
     void loadSettings();
     void loadSettingsWithoutCleanup();
     void enforceMaxSize();
-    QVariantMap fileInfoToVariant(const RecentFileInfo& info) const;
     RecentFileInfo variantToFileInfo(const QVariantMap& variant) const;
 
+    // 仅用于从旧版QSettings数据做一次性迁移读取；写入走AppStateStore
     QSettings* m_settings;
     QList<RecentFileInfo> m_recentFiles;
     int m_maxRecentFiles;
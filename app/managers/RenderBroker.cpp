@@ -0,0 +1,92 @@
+#include "RenderBroker.h"
+#include <QMetaObject>
+#include "utils/LatencyMetrics.h"
+
+RenderBroker& RenderBroker::instance() {
+    static RenderBroker broker;
+    return broker;
+}
+
+RenderBroker::RenderBroker(QObject* parent)
+    : QObject(parent), m_deduplicated(0) {}
+
+RenderBroker::RenderKey RenderBroker::makeKey(const void* document,
+                                              int pageNumber,
+                                              double scaleFactor, int rotation,
+                                              const QRect& region) {
+    RenderKey key;
+    key.documentId = reinterpret_cast<quintptr>(document);
+    key.pageNumber = pageNumber;
+    key.scalePermille = qRound(scaleFactor * 1000.0);
+    key.rotation = ((rotation % 360) + 360) % 360;
+    key.region = region;
+    return key;
+}
+
+void RenderBroker::request(const RenderKey& key,
+                           RenderScheduler::TaskClass taskClass,
+                           RenderFn render, QObject* subscriber,
+                           DeliverFn deliver) {
+    if (!subscriber || !deliver) {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_inFlight.find(key);
+        if (it != m_inFlight.end()) {
+            // Identical render already running: attach instead of
+            // re-rendering. The pending render's result fans out to
+            // every subscriber.
+            it->append(Subscriber{QPointer<QObject>(subscriber),
+                                  std::move(deliver)});
+            ++m_deduplicated;
+            return;
+        }
+        m_inFlight.insert(
+            key, {Subscriber{QPointer<QObject>(subscriber),
+                             std::move(deliver)}});
+    }
+
+    // The broker is a process-lifetime singleton, so capturing `this`
+    // in the pool job is safe. The document identity doubles as the
+    // NUMA affinity key so every render for one document runs on the
+    // node that holds its Poppler handle and buffers.
+    RenderScheduler::instance().submit(
+        taskClass, static_cast<quint64>(key.documentId),
+        [this, key, render = std::move(render)]() {
+            LATENCY_SAMPLE("render.page");
+            publish(key, render ? render() : QImage());
+        });
+}
+
+void RenderBroker::publish(const RenderKey& key, const QImage& image) {
+    QList<Subscriber> subscribers;
+    {
+        QMutexLocker locker(&m_mutex);
+        subscribers = m_inFlight.take(key);
+    }
+
+    for (const Subscriber& subscriber : subscribers) {
+        QObject* context = subscriber.context.data();
+        if (!context) {
+            continue;
+        }
+        // Queued call on the subscriber's thread; Qt drops it if the
+        // context object is destroyed before dispatch
+        QMetaObject::invokeMethod(
+            context,
+            [deliver = subscriber.deliver, image]() { deliver(image); },
+            Qt::QueuedConnection);
+    }
+}
+
+int RenderBroker::inFlightCount() const {
+    QMutexLocker locker(&m_mutex);
+    return m_inFlight.size();
+}
+
+qint64 RenderBroker::deduplicatedCount() const {
+    QMutexLocker locker(&m_mutex);
+    return m_deduplicated;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QObject>
+#include <QPointer>
+#include <QRect>
+#include <functional>
+#include "RenderScheduler.h"
+
+/**
+ * Process-wide render-request broker.
+ *
+ * The viewer's sharp pass, PDFPrerenderer and ThumbnailGenerator can all
+ * ask Poppler for the same (page, scale, rotation) at the same moment —
+ * zoom changes used to show the identical render running two or three
+ * times in perf traces. Requests are deduplicated here: the first
+ * requester's render function runs once on the shared RenderScheduler
+ * pool, late subscribers attach to the in-flight render, and every
+ * subscriber receives the same implicitly-shared QImage via a queued
+ * call on its own thread when the render lands.
+ */
+class RenderBroker : public QObject {
+    Q_OBJECT
+
+public:
+    // Identifies one render product. Scale is quantized to 1/1000 so
+    // floating-point jitter between callers cannot defeat deduplication;
+    // a null region means the full page.
+    struct RenderKey {
+        quintptr documentId = 0;
+        int pageNumber = -1;
+        int scalePermille = 0;
+        int rotation = 0;
+        QRect region;
+
+        bool operator==(const RenderKey& other) const {
+            return documentId == other.documentId &&
+                   pageNumber == other.pageNumber &&
+                   scalePermille == other.scalePermille &&
+                   rotation == other.rotation && region == other.region;
+        }
+    };
+
+    using RenderFn = std::function<QImage()>;
+    using DeliverFn = std::function<void(const QImage&)>;
+
+    static RenderBroker& instance();
+
+    static RenderKey makeKey(const void* document, int pageNumber,
+                             double scaleFactor, int rotation,
+                             const QRect& region = QRect());
+
+    // Request the render identified by key. If an identical render is
+    // already in flight the render function is discarded and the
+    // subscriber joins the pending one; otherwise render is submitted
+    // to the scheduler at taskClass. deliver runs on the subscriber's
+    // thread and is dropped if the subscriber is destroyed first — a
+    // null image is still delivered so callers can surface failures.
+    void request(const RenderKey& key, RenderScheduler::TaskClass taskClass,
+                 RenderFn render, QObject* subscriber, DeliverFn deliver);
+
+    // Distinct renders currently in flight.
+    int inFlightCount() const;
+
+    // Requests that attached to an already-pending render instead of
+    // submitting their own.
+    qint64 deduplicatedCount() const;
+
+private:
+    explicit RenderBroker(QObject* parent = nullptr);
+    ~RenderBroker() override = default;
+
+    struct Subscriber {
+        QPointer<QObject> context;
+        DeliverFn deliver;
+    };
+
+    void publish(const RenderKey& key, const QImage& image);
+
+    mutable QMutex m_mutex;
+    QHash<RenderKey, QList<Subscriber>> m_inFlight;
+    qint64 m_deduplicated;
+};
+
+inline size_t qHash(const RenderBroker::RenderKey& key, size_t seed = 0) {
+    return qHashMulti(seed, key.documentId, key.pageNumber, key.scalePermille,
+                      key.rotation, key.region.x(), key.region.y(),
+                      key.region.width(), key.region.height());
+}
@@ -0,0 +1,432 @@
+#include "RenderScheduler.h"
+#include <QDeadlineTimer>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QRunnable>
+#include <QSettings>
+#include <QStringList>
+#include <QThread>
+#include <algorithm>
+#include <limits>
+#include "HeartbeatService.h"
+#include "utils/CancellationToken.h"
+#include "utils/LoggingMacros.h"
+
+#ifdef Q_OS_LINUX
+#include <sched.h>
+#endif
+
+namespace {
+
+/**
+ * QRunnable wrapper around a std::function job. When the owning
+ * sub-pool is node-bound, the first job a worker thread runs pins the
+ * thread to that node's CPUs.
+ */
+class FunctionTask : public QRunnable {
+public:
+    FunctionTask(std::function<void()> job, const QVector<int>* nodeCpus)
+        : m_job(std::move(job)), m_nodeCpus(nodeCpus) {
+        setAutoDelete(true);
+    }
+
+    void run() override {
+        pinToNode();
+        if (m_job) {
+            m_job();
+        }
+    }
+
+private:
+    void pinToNode() {
+#ifdef Q_OS_LINUX
+        // Pool threads never migrate between sub-pools, so pinning once
+        // per thread is enough. The thread_local marker also covers
+        // thread expiry: a freshly spawned replacement worker re-pins
+        // on its first job.
+        thread_local const QVector<int>* pinned = nullptr;
+        if (!m_nodeCpus || m_nodeCpus->isEmpty() || pinned == m_nodeCpus) {
+            return;
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : *m_nodeCpus) {
+            CPU_SET(cpu, &set);
+        }
+        if (sched_setaffinity(0, sizeof(set), &set) == 0) {
+            pinned = m_nodeCpus;
+        }
+#else
+        Q_UNUSED(m_nodeCpus);
+#endif
+    }
+
+    std::function<void()> m_job;
+    // Owned by the scheduler singleton, which outlives every task
+    const QVector<int>* m_nodeCpus;
+};
+
+// Parses a sysfs cpulist ("0-7,16-23") into individual CPU ids
+QVector<int> parseCpuList(const QString& list) {
+    QVector<int> cpus;
+    const QStringList parts = list.trimmed().split(',', Qt::SkipEmptyParts);
+    for (const QString& part : parts) {
+        const int dash = part.indexOf('-');
+        bool okFirst = false;
+        if (dash < 0) {
+            const int cpu = part.toInt(&okFirst);
+            if (okFirst) {
+                cpus.append(cpu);
+            }
+            continue;
+        }
+        bool okLast = false;
+        const int first = part.left(dash).toInt(&okFirst);
+        const int last = part.mid(dash + 1).toInt(&okLast);
+        if (okFirst && okLast) {
+            for (int cpu = first; cpu <= last; ++cpu) {
+                cpus.append(cpu);
+            }
+        }
+    }
+    return cpus;
+}
+
+// Per-node CPU sets from sysfs. Empty on non-Linux platforms and on
+// machines the kernel reports as a single node.
+QVector<QVector<int>> readNodeTopology() {
+    QVector<QVector<int>> nodes;
+#ifdef Q_OS_LINUX
+    for (int node = 0;; ++node) {
+        QFile cpulist(QStringLiteral("/sys/devices/system/node/node%1/cpulist")
+                          .arg(node));
+        if (!cpulist.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            break;
+        }
+        const QVector<int> cpus =
+            parseCpuList(QString::fromLatin1(cpulist.readAll()));
+        if (!cpus.isEmpty()) {
+            nodes.append(cpus);
+        }
+    }
+#endif
+    return nodes;
+}
+
+const char* stateName(RenderScheduler::DocumentState state) {
+    switch (state) {
+        case RenderScheduler::DocumentState::Focused:
+            return "focused";
+        case RenderScheduler::DocumentState::Visible:
+            return "visible";
+        case RenderScheduler::DocumentState::Background:
+            return "background";
+    }
+    return "unknown";
+}
+
+}  // namespace
+
+RenderScheduler& RenderScheduler::instance() {
+    static RenderScheduler scheduler;
+    return scheduler;
+}
+
+RenderScheduler::RenderScheduler(QObject* parent)
+    : QObject(parent), m_nextNode(0) {
+    QSettings settings;
+    QVector<QVector<int>> topology;
+    if (settings.value("renderScheduler/numaAware", false).toBool()) {
+        topology = readNodeTopology();
+    }
+
+    if (topology.size() > 1) {
+        // One sub-pool per node, each worker pinned to the node's CPUs.
+        // First-touch allocation then places a document's Poppler
+        // buffers on the node its jobs run on, so keyed submits keep a
+        // document's working set off the interconnect. The GUI-thread
+        // core reserve comes out of the first node only.
+        for (int node = 0; node < topology.size(); ++node) {
+            auto nodePool = std::make_unique<NodePool>();
+            nodePool->cpus = topology[node];
+            const int reserve = node == 0 ? 1 : 0;
+            nodePool->pool.setMaxThreadCount(
+                qMax(1, nodePool->cpus.size() - reserve));
+            m_nodes.push_back(std::move(nodePool));
+        }
+        LOG_DEBUG(
+            "RenderScheduler: NUMA-aware placement across {} nodes "
+            "({} workers total)",
+            static_cast<int>(m_nodes.size()), maxThreadCount());
+    } else {
+        // Leave one core for the GUI thread; never drop below two workers
+        // so a long prerender cannot starve thumbnails entirely
+        const int threads = qMax(2, QThread::idealThreadCount() - 1);
+        m_nodes.push_back(std::make_unique<NodePool>());
+        m_nodes.front()->pool.setMaxThreadCount(threads);
+        LOG_DEBUG("RenderScheduler: Initialized with {} worker threads",
+                  threads);
+    }
+}
+
+RenderScheduler::NodePool& RenderScheduler::nodeFor(quint64 affinityKey) {
+    return *m_nodes[affinityKey % m_nodes.size()];
+}
+
+int RenderScheduler::stateWeight(DocumentState state) {
+    switch (state) {
+        case DocumentState::Focused:
+            return 8;
+        case DocumentState::Visible:
+            return 4;
+        case DocumentState::Background:
+            return 1;
+    }
+    return 1;
+}
+
+qint64 RenderScheduler::minVirtualLocked() const {
+    qint64 minVt = std::numeric_limits<qint64>::max();
+    for (const DocumentAccount& account : m_accounts) {
+        minVt = qMin(minVt, account.virtualNs);
+    }
+    return m_accounts.isEmpty() ? 0 : minVt;
+}
+
+void RenderScheduler::setDocumentState(quint64 affinityKey,
+                                       DocumentState state,
+                                       const QString& name) {
+    {
+        QMutexLocker locker(&m_accountMutex);
+        auto it = m_accounts.find(affinityKey);
+        if (it == m_accounts.end()) {
+            // New flows start at the current minimum virtual time, the
+            // usual WFQ convention: a freshly opened tab owes nothing
+            // and is owed nothing
+            DocumentAccount account;
+            account.virtualNs = minVirtualLocked();
+            it = m_accounts.insert(affinityKey, account);
+        }
+        it->state = state;
+        if (!name.isEmpty()) {
+            it->name = name;
+        }
+    }
+    startAccountReporting();
+}
+
+void RenderScheduler::dropDocumentAccount(quint64 affinityKey) {
+    QMutexLocker locker(&m_accountMutex);
+    m_accounts.remove(affinityKey);
+}
+
+int RenderScheduler::fairnessPenalty(quint64 affinityKey) {
+    QMutexLocker locker(&m_accountMutex);
+    auto it = m_accounts.find(affinityKey);
+    if (it == m_accounts.end()) {
+        DocumentAccount account;
+        account.virtualNs = minVirtualLocked();
+        it = m_accounts.insert(affinityKey, account);
+    }
+    if (m_accounts.size() < 2) {
+        // A lone document competes with nobody; demoting it would only
+        // reorder its own queue
+        return 0;
+    }
+    const qint64 lead = it->virtualNs - minVirtualLocked();
+    if (lead <= 0) {
+        return 0;
+    }
+    return static_cast<int>(
+        qMin<qint64>(lead / PENALTY_QUANTUM_NS, MAX_FAIRNESS_PENALTY));
+}
+
+void RenderScheduler::chargeDocument(quint64 affinityKey, qint64 nsecs) {
+    QMutexLocker locker(&m_accountMutex);
+    auto it = m_accounts.find(affinityKey);
+    if (it == m_accounts.end()) {
+        return;  // account dropped while the job ran
+    }
+    it->busyNs += nsecs;
+    it->virtualNs += nsecs / stateWeight(it->state);
+    ++it->jobsCompleted;
+}
+
+std::function<void()> RenderScheduler::meteredJob(quint64 affinityKey,
+                                                  std::function<void()> job) {
+    // The scheduler is a process-lifetime singleton, so capturing
+    // `this` outlives every task
+    return [this, affinityKey, job = std::move(job)]() {
+        QElapsedTimer timer;
+        timer.start();
+        job();
+        chargeDocument(affinityKey, timer.nsecsElapsed());
+    };
+}
+
+void RenderScheduler::startAccountReporting() {
+    {
+        QMutexLocker locker(&m_accountMutex);
+        if (m_accountReportingStarted) {
+            return;
+        }
+        m_accountReportingStarted = true;
+    }
+    // First registration happens from the GUI thread (DocumentModel),
+    // which is where the heartbeat service must be created
+    HeartbeatService::instance().registerPeriodic(
+        "render-accounts", ACCOUNT_LOG_INTERVAL_MS, []() {
+            const auto accounts =
+                RenderScheduler::instance().documentAccounts();
+            if (accounts.size() < 2) {
+                return;
+            }
+            for (const DocumentAccountSnapshot& account : accounts) {
+                LOG_DEBUG(
+                    "RenderScheduler: account '{}' state={} busy={}ms "
+                    "jobs={} penalty={}",
+                    account.name.toStdString(), stateName(account.state),
+                    account.busyMs, account.jobsCompleted,
+                    account.currentPenalty);
+            }
+        });
+}
+
+QList<RenderScheduler::DocumentAccountSnapshot>
+RenderScheduler::documentAccounts() const {
+    QList<DocumentAccountSnapshot> snapshots;
+    QMutexLocker locker(&m_accountMutex);
+    const qint64 minVt = minVirtualLocked();
+    for (auto it = m_accounts.constBegin(); it != m_accounts.constEnd();
+         ++it) {
+        DocumentAccountSnapshot snapshot;
+        snapshot.key = it.key();
+        snapshot.name = it->name;
+        snapshot.state = it->state;
+        snapshot.busyMs = it->busyNs / 1000000;
+        snapshot.jobsCompleted = it->jobsCompleted;
+        const qint64 lead = it->virtualNs - minVt;
+        snapshot.currentPenalty =
+            m_accounts.size() < 2 || lead <= 0
+                ? 0
+                : static_cast<int>(qMin<qint64>(lead / PENALTY_QUANTUM_NS,
+                                                MAX_FAIRNESS_PENALTY));
+        snapshots.append(snapshot);
+    }
+    std::sort(snapshots.begin(), snapshots.end(),
+              [](const DocumentAccountSnapshot& a,
+                 const DocumentAccountSnapshot& b) {
+                  return a.busyMs > b.busyMs;
+              });
+    return snapshots;
+}
+
+void RenderScheduler::compensateHungWorker(quint64 affinityKey) {
+    // releaseThread() lets the pool temporarily exceed maxThreadCount by
+    // one — exactly the semantics wanted for a thread presumed wedged
+    nodeFor(affinityKey).pool.releaseThread();
+    LOG_WARNING(
+        "RenderScheduler: compensating for a hung worker; pool grown by one");
+}
+
+void RenderScheduler::restoreCompensatedWorker(quint64 affinityKey) {
+    nodeFor(affinityKey).pool.reserveThread();
+    LOG_INFO("RenderScheduler: hung worker returned; pool size restored");
+}
+
+void RenderScheduler::submit(TaskClass taskClass, std::function<void()> job) {
+    if (!job) {
+        return;
+    }
+    // Keyless jobs have no working set worth keeping local; spread them
+    // round-robin so a node does not idle while its neighbour queues
+    NodePool& node =
+        m_nodes.size() == 1
+            ? *m_nodes.front()
+            : nodeFor(static_cast<quint64>(
+                  static_cast<quint32>(m_nextNode.fetchAndAddRelaxed(1))));
+    node.pool.start(new FunctionTask(std::move(job), &node.cpus),
+                    static_cast<int>(taskClass));
+    emit taskSubmitted(static_cast<int>(taskClass));
+}
+
+void RenderScheduler::submit(TaskClass taskClass,
+                             const CancellationToken& token,
+                             std::function<void()> job) {
+    if (!job) {
+        return;
+    }
+    submit(taskClass, [token, job = std::move(job)]() {
+        if (!token.isCancelled()) {
+            job();
+        }
+    });
+}
+
+void RenderScheduler::submit(TaskClass taskClass, quint64 affinityKey,
+                             std::function<void()> job) {
+    if (!job) {
+        return;
+    }
+    // Keyed jobs carry a document identity, so they are metered and
+    // their queue priority is demoted within the class band by how far
+    // the document's weighted service leads the lightest account
+    NodePool& node = nodeFor(affinityKey);
+    const int priority =
+        static_cast<int>(taskClass) - fairnessPenalty(affinityKey);
+    node.pool.start(
+        new FunctionTask(meteredJob(affinityKey, std::move(job)), &node.cpus),
+        priority);
+    emit taskSubmitted(static_cast<int>(taskClass));
+}
+
+void RenderScheduler::submit(TaskClass taskClass, quint64 affinityKey,
+                             const CancellationToken& token,
+                             std::function<void()> job) {
+    if (!job) {
+        return;
+    }
+    submit(taskClass, affinityKey, [token, job = std::move(job)]() {
+        if (!token.isCancelled()) {
+            job();
+        }
+    });
+}
+
+void RenderScheduler::setMaxThreadCount(int count) {
+    // In NUMA mode the budget is split evenly across nodes; pinning is
+    // unaffected, only pool depth changes
+    const int perNode =
+        qMax(1, count / qMax(1, static_cast<int>(m_nodes.size())));
+    for (auto& node : m_nodes) {
+        node->pool.setMaxThreadCount(perNode);
+    }
+}
+
+int RenderScheduler::maxThreadCount() const {
+    int total = 0;
+    for (const auto& node : m_nodes) {
+        total += node->pool.maxThreadCount();
+    }
+    return total;
+}
+
+int RenderScheduler::activeThreadCount() const {
+    int total = 0;
+    for (const auto& node : m_nodes) {
+        total += node->pool.activeThreadCount();
+    }
+    return total;
+}
+
+bool RenderScheduler::waitForDone(int msecs) {
+    QDeadlineTimer deadline(msecs < 0 ? QDeadlineTimer::Forever
+                                      : QDeadlineTimer(msecs));
+    bool done = true;
+    for (auto& node : m_nodes) {
+        const int remaining =
+            msecs < 0 ? -1 : static_cast<int>(deadline.remainingTime());
+        done = node->pool.waitForDone(remaining) && done;
+    }
+    return done;
+}
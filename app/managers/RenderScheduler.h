@@ -0,0 +1,177 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class CancellationToken;
+
+/**
+ * Process-wide prioritized render scheduler.
+ *
+ * PDFPrerenderer, ThumbnailGenerator and PDFCacheManager used to own
+ * separate worker pools that oversubscribed the CPU during page flips.
+ * They now all submit into this single pool, sized to the machine, with
+ * priority classes so a visible-page render is never queued behind a
+ * backlog of thumbnails.
+ *
+ * On multi-socket machines the pool can split into one sub-pool per
+ * NUMA node ("renderScheduler/numaAware", default off), each worker
+ * pinned to its node's CPUs. Jobs submitted with an affinity key
+ * (document identity) always land on the same node, so a document's
+ * Poppler handle and the buffers its renders allocate stay node-local
+ * instead of bouncing across the interconnect. The trade-off is that
+ * priority ordering holds per node, not globally; with documents spread
+ * over the nodes that costs far less than cross-node render traffic.
+ */
+class RenderScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    // Priority classes map onto QThreadPool priorities. Thumbnail is 0 so
+    // that QtConcurrent::run() against pool() (which enqueues at priority
+    // 0) lands in the thumbnail class.
+    enum class TaskClass {
+        VisiblePage = 100,       // Render needed for the current viewport
+        AdjacentPrerender = 50,  // Speculative prerender of nearby pages
+        Thumbnail = 0,           // Thumbnail generation
+        Background = -50         // Preloading, index building, etc.
+    };
+
+    static RenderScheduler& instance();
+
+    // Submit a job to run on a pool thread at the given priority class.
+    void submit(TaskClass taskClass, std::function<void()> job);
+
+    // Token-aware variant: a job whose token is already cancelled when a
+    // worker picks it up is dropped without running, so a backlog of
+    // stale work drains in microseconds after a cancel.
+    void submit(TaskClass taskClass, const CancellationToken& token,
+                std::function<void()> job);
+
+    // Affinity-keyed variants: every job carrying the same key runs on
+    // the same NUMA node when topology-aware placement is active.
+    // Callers pass a stable document identity; on single-node machines
+    // (or with the setting off) these behave exactly like plain submit.
+    void submit(TaskClass taskClass, quint64 affinityKey,
+                std::function<void()> job);
+    void submit(TaskClass taskClass, quint64 affinityKey,
+                const CancellationToken& token, std::function<void()> job);
+
+    // Shared pool for subsystems that drive QtConcurrent/QFutureWatcher
+    // pipelines directly (tasks enqueue at Thumbnail priority). Always
+    // the first node's pool; QtConcurrent pipelines carry no affinity
+    // key so they get a fixed home rather than a random one.
+    QThreadPool* pool() { return &m_nodes.front()->pool; }
+
+    void setMaxThreadCount(int count);
+    int maxThreadCount() const;
+    int activeThreadCount() const;
+    bool waitForDone(int msecs = -1);
+
+    // Hung-worker compensation. A render wedged inside Poppler on a
+    // pathological page never polls its abort callback and occupies a
+    // pool thread indefinitely; without intervention each bad page
+    // silently shrinks the pool by one. compensateHungWorker() releases
+    // a slot on the node the job was routed to so a replacement worker
+    // can start; restoreCompensatedWorker() takes the slot back if the
+    // wedged render ever returns. Callers pass the same affinity key
+    // the job was submitted with.
+    void compensateHungWorker(quint64 affinityKey);
+    void restoreCompensatedWorker(quint64 affinityKey);
+
+    // 1 unless NUMA-aware placement found multiple nodes
+    int nodeCount() const { return static_cast<int>(m_nodes.size()); }
+
+    // Per-document scheduling accounts. With several tabs rendering
+    // through the shared pool, QThreadPool's class priorities alone let
+    // one heavy document monopolize a class: a background tab scanning
+    // 2s-per-page enqueues Thumbnail/Background work faster than the
+    // focused tab and adds latency to its page turns. Every keyed
+    // submit is metered, worker wall time is attributed to the
+    // document's account, and queue priority within a class is demoted
+    // by how far the document's weighted service leads the others
+    // (weighted fair queuing over virtual time). Weights come from the
+    // document's tab state, so the focused document earns roughly eight
+    // background documents' worth of pool time before any demotion.
+    enum class DocumentState {
+        Focused,    // the tab the user is interacting with (weight 8)
+        Visible,    // rendered but not focused, e.g. split view (weight 4)
+        Background  // open tab that is not on screen (weight 1)
+    };
+
+    struct DocumentAccountSnapshot {
+        quint64 key = 0;
+        QString name;
+        DocumentState state = DocumentState::Background;
+        qint64 busyMs = 0;  // worker wall time attributed to the document
+        qint64 jobsCompleted = 0;
+        int currentPenalty = 0;  // demotion applied to its next submit
+    };
+
+    // Create or update the account for a document identity (the same
+    // key the document's jobs are submitted with). The name is only for
+    // the stats output. Accounts for unregistered keys are created
+    // lazily at Visible weight on their first keyed submit.
+    void setDocumentState(quint64 affinityKey, DocumentState state,
+                          const QString& name = QString());
+
+    // Forget a closed or hibernated document's account so its history
+    // stops influencing the fairness baseline.
+    void dropDocumentAccount(quint64 affinityKey);
+
+    // Accounts ordered by attributed worker time, heaviest first.
+    QList<DocumentAccountSnapshot> documentAccounts() const;
+
+signals:
+    void taskSubmitted(int taskClass);
+
+private:
+    explicit RenderScheduler(QObject* parent = nullptr);
+    ~RenderScheduler() override = default;
+
+    struct NodePool {
+        QThreadPool pool;
+        QVector<int> cpus;  // empty = no pinning (single-node fallback)
+    };
+
+    struct DocumentAccount {
+        QString name;
+        DocumentState state = DocumentState::Visible;
+        qint64 busyNs = 0;
+        qint64 virtualNs = 0;  // busy time divided by the state's weight
+        qint64 jobsCompleted = 0;
+    };
+
+    // One priority step of demotion per 25ms of weighted lead, capped
+    // below the 50-point class gap so a demoted job can never sink into
+    // the class beneath it.
+    static constexpr qint64 PENALTY_QUANTUM_NS = 25LL * 1000 * 1000;
+    static constexpr int MAX_FAIRNESS_PENALTY = 40;
+    static constexpr int ACCOUNT_LOG_INTERVAL_MS = 60000;
+
+    NodePool& nodeFor(quint64 affinityKey);
+
+    static int stateWeight(DocumentState state);
+    qint64 minVirtualLocked() const;  // m_accountMutex must be held
+    int fairnessPenalty(quint64 affinityKey);
+    void chargeDocument(quint64 affinityKey, qint64 nsecs);
+    std::function<void()> meteredJob(quint64 affinityKey,
+                                     std::function<void()> job);
+    void startAccountReporting();
+
+    std::vector<std::unique_ptr<NodePool>> m_nodes;
+    QAtomicInt m_nextNode;  // round-robin for keyless jobs
+
+    mutable QMutex m_accountMutex;
+    QHash<quint64, DocumentAccount> m_accounts;
+    bool m_accountReportingStarted = false;
+};
@@ -0,0 +1,307 @@
+#include "RenderWorkerPool.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QSettings>
+#include <QSharedMemory>
+#include <QThread>
+#include <iostream>
+#include <memory>
+#include <poppler/qt6/poppler-qt6.h>
+#include <string>
+#include "../utils/LoggingMacros.h"
+
+namespace {
+
+void applyWorkerRenderHints(Poppler::Document* document) {
+    document->setRenderHint(Poppler::Document::Antialiasing, true);
+    document->setRenderHint(Poppler::Document::TextAntialiasing, true);
+    document->setRenderHint(Poppler::Document::TextHinting, true);
+    document->setRenderHint(Poppler::Document::TextSlightHinting, true);
+    document->setRenderHint(Poppler::Document::ThinLineShape, true);
+    document->setRenderHint(Poppler::Document::OverprintPreview, true);
+}
+
+}  // namespace
+
+RenderWorkerPool& RenderWorkerPool::instance() {
+    static RenderWorkerPool pool;
+    return pool;
+}
+
+RenderWorkerPool::RenderWorkerPool(QObject* parent)
+    : QObject(parent), m_enabled(false), m_nextRequestId(0), m_restartCount(0) {
+    QSettings settings;
+    m_enabled = settings.value("sandboxRender/enabled", false).toBool();
+
+    int workerCount =
+        settings.value("sandboxRender/workers", DEFAULT_WORKER_COUNT).toInt();
+    workerCount = qBound(1, workerCount, 8);
+    for (int i = 0; i < workerCount; ++i) {
+        m_workers.append(new Worker());
+    }
+}
+
+RenderWorkerPool::~RenderWorkerPool() {
+    QMutexLocker locker(&m_mutex);
+    for (Worker* worker : m_workers) {
+        if (worker->process) {
+            worker->process->closeWriteChannel();
+            if (!worker->process->waitForFinished(1000)) {
+                worker->process->kill();
+                worker->process->waitForFinished(1000);
+            }
+            delete worker->process;
+        }
+        delete worker;
+    }
+    m_workers.clear();
+}
+
+bool RenderWorkerPool::isEnabled() const {
+    QMutexLocker locker(&m_mutex);
+    return m_enabled;
+}
+
+void RenderWorkerPool::setEnabled(bool enabled) {
+    QMutexLocker locker(&m_mutex);
+    if (m_enabled == enabled) {
+        return;
+    }
+    m_enabled = enabled;
+    QSettings settings;
+    settings.setValue("sandboxRender/enabled", enabled);
+}
+
+bool RenderWorkerPool::startWorker(Worker* worker) {
+    auto* process = new QProcess();
+    process->setProgram(QCoreApplication::applicationFilePath());
+    process->setArguments({QStringLiteral("--render-worker")});
+    process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    process->start();
+    if (!process->waitForStarted(WORKER_START_TIMEOUT_MS)) {
+        LOG_WARNING("RenderWorkerPool: failed to start render worker: {}",
+                    process->errorString().toStdString());
+        delete process;
+        return false;
+    }
+    worker->process = process;
+    return true;
+}
+
+RenderWorkerPool::Worker* RenderWorkerPool::acquireWorker() {
+    QMutexLocker locker(&m_mutex);
+    if (!m_enabled) {
+        return nullptr;
+    }
+    for (Worker* worker : m_workers) {
+        if (worker->busy) {
+            continue;
+        }
+        if (!worker->process ||
+            worker->process->state() != QProcess::Running) {
+            if (worker->process) {
+                delete worker->process;
+                worker->process = nullptr;
+            }
+            if (!startWorker(worker)) {
+                continue;
+            }
+        }
+        worker->busy = true;
+        return worker;
+    }
+    // All workers busy: render in-process rather than queueing behind
+    // other documents
+    return nullptr;
+}
+
+void RenderWorkerPool::releaseWorker(Worker* worker) {
+    QMutexLocker locker(&m_mutex);
+    worker->busy = false;
+}
+
+void RenderWorkerPool::retireWorker(Worker* worker) {
+    int restarts = 0;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (worker->process) {
+            worker->process->kill();
+            worker->process->waitForFinished(1000);
+            delete worker->process;
+            worker->process = nullptr;
+        }
+        worker->busy = false;
+        restarts = ++m_restartCount;
+    }
+    LOG_WARNING("RenderWorkerPool: render worker retired (restart #{})",
+                restarts);
+    emit workerCrashed(restarts);
+}
+
+QImage RenderWorkerPool::render(const QString& filePath, int pageNum,
+                                double xres, double yres, int x, int y, int w,
+                                int h) {
+    if (filePath.isEmpty()) {
+        return QImage();
+    }
+
+    Worker* worker = acquireWorker();
+    if (!worker) {
+        return QImage();
+    }
+
+    quint64 requestId;
+    {
+        QMutexLocker locker(&m_mutex);
+        requestId = ++m_nextRequestId;
+    }
+
+    QJsonObject request;
+    request["id"] = QString::number(requestId);
+    request["file"] = filePath;
+    request["page"] = pageNum;
+    request["xres"] = xres;
+    request["yres"] = yres;
+    request["x"] = x;
+    request["y"] = y;
+    request["w"] = w;
+    request["h"] = h;
+
+    QByteArray line = QJsonDocument(request).toJson(QJsonDocument::Compact);
+    line.append('\n');
+    worker->process->write(line);
+
+    // One request in flight per worker, so the next newline on stdout
+    // is our reply. A crash or timeout retires the worker; the caller
+    // falls back to the in-process renderer.
+    QByteArray replyLine;
+    QElapsedTimer timer;
+    timer.start();
+    while (true) {
+        if (worker->process->canReadLine()) {
+            replyLine = worker->process->readLine();
+            break;
+        }
+        if (worker->process->state() != QProcess::Running) {
+            retireWorker(worker);
+            return QImage();
+        }
+        if (timer.elapsed() > RENDER_TIMEOUT_MS) {
+            LOG_WARNING(
+                "RenderWorkerPool: render timed out for page {} of {}",
+                pageNum, filePath.toStdString());
+            retireWorker(worker);
+            return QImage();
+        }
+        worker->process->waitForReadyRead(100);
+    }
+
+    QJsonObject reply = QJsonDocument::fromJson(replyLine).object();
+    if (reply["id"].toString() != QString::number(requestId) ||
+        !reply["ok"].toBool()) {
+        releaseWorker(worker);
+        return QImage();
+    }
+
+    QSharedMemory shm(reply["key"].toString());
+    if (!shm.attach(QSharedMemory::ReadOnly)) {
+        LOG_WARNING("RenderWorkerPool: failed to attach result buffer: {}",
+                    shm.errorString().toStdString());
+        releaseWorker(worker);
+        return QImage();
+    }
+
+    const int width = reply["width"].toInt();
+    const int height = reply["height"].toInt();
+    const int bytesPerLine = reply["bytesPerLine"].toInt();
+    const auto format = static_cast<QImage::Format>(reply["format"].toInt());
+
+    QImage image;
+    if (width > 0 && height > 0 &&
+        qint64(bytesPerLine) * height <= shm.size()) {
+        // Deep copy before detaching; the worker reuses the segment for
+        // its next request
+        image = QImage(static_cast<const uchar*>(shm.constData()), width,
+                       height, bytesPerLine, format)
+                    .copy();
+    }
+    shm.detach();
+    releaseWorker(worker);
+    return image;
+}
+
+int RenderWorkerPool::runWorkerLoop() {
+    std::unique_ptr<Poppler::Document> document;
+    QString documentPath;
+    auto shm = std::make_unique<QSharedMemory>();
+    int shmGeneration = 0;
+
+    std::string rawLine;
+    while (std::getline(std::cin, rawLine)) {
+        QJsonObject request =
+            QJsonDocument::fromJson(QByteArray::fromStdString(rawLine))
+                .object();
+        QJsonObject reply;
+        reply["id"] = request["id"];
+        reply["ok"] = false;
+
+        const QString filePath = request["file"].toString();
+        if (filePath != documentPath) {
+            document = Poppler::Document::load(filePath);
+            documentPath = filePath;
+            if (document && !document->isLocked()) {
+                applyWorkerRenderHints(document.get());
+            }
+        }
+
+        QImage image;
+        if (document && !document->isLocked()) {
+            std::unique_ptr<Poppler::Page> page(
+                document->page(request["page"].toInt()));
+            if (page) {
+                image = page->renderToImage(
+                    request["xres"].toDouble(), request["yres"].toDouble(),
+                    request["x"].toInt(), request["y"].toInt(),
+                    request["w"].toInt(), request["h"].toInt());
+            }
+        }
+
+        if (!image.isNull()) {
+            const qsizetype needed = image.sizeInBytes();
+            if (!shm->isAttached() || shm->size() < needed) {
+                // QSharedMemory cannot grow; roll the key so a fresh
+                // segment can be created
+                if (shm->isAttached()) {
+                    shm->detach();
+                }
+                shm = std::make_unique<QSharedMemory>(
+                    QStringLiteral("readium-render-%1-%2")
+                        .arg(QCoreApplication::applicationPid())
+                        .arg(++shmGeneration));
+                if (!shm->create(needed)) {
+                    image = QImage();
+                }
+            }
+            if (!image.isNull()) {
+                memcpy(shm->data(), image.constBits(), needed);
+                reply["ok"] = true;
+                reply["key"] = shm->key();
+                reply["width"] = image.width();
+                reply["height"] = image.height();
+                reply["bytesPerLine"] = qint64(image.bytesPerLine());
+                reply["format"] = int(image.format());
+            }
+        }
+
+        QByteArray out = QJsonDocument(reply).toJson(QJsonDocument::Compact);
+        out.append('\n');
+        std::cout.write(out.constData(), out.size());
+        std::cout.flush();
+    }
+    return 0;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <QImage>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QProcess>
+#include <QString>
+
+/**
+ * Optional out-of-process render backend.
+ *
+ * A malformed PDF that crashes Poppler takes the whole app down with
+ * every open tab. When sandboxed rendering is enabled
+ * ("sandboxRender/enabled", default off) page and tile renders are
+ * delegated to a small pool of worker processes — this same executable
+ * relaunched with --render-worker — so a crash costs one worker
+ * restart and the next render falls back in-process. Workers also give
+ * true multi-document parallelism: separate address spaces mean no
+ * shared allocator and no Poppler-internal global locks.
+ *
+ * Protocol: one JSON line per request on the worker's stdin
+ * (file/page/dpi/region), one JSON line per reply on its stdout. Pixel
+ * data travels through a per-worker QSharedMemory segment named in the
+ * reply; requests are strictly one-at-a-time per worker, so the parent
+ * copies the bits out before the worker can touch the segment again
+ * and no further handshake is needed.
+ *
+ * render() is synchronous and thread-safe; callers already run on
+ * RenderScheduler pool threads. A null result means "render this
+ * in-process instead" — the sandbox never turns a renderable page
+ * into a blank one.
+ */
+class RenderWorkerPool : public QObject {
+    Q_OBJECT
+
+public:
+    static RenderWorkerPool& instance();
+
+    // Entry point for --render-worker mode: blocking stdin/stdout
+    // request loop, never returns until stdin closes.
+    static int runWorkerLoop();
+
+    bool isEnabled() const;
+    void setEnabled(bool enabled);
+
+    // Renders a page (w/h <= 0) or a page region out of process.
+    // Returns a null image on any failure — timeout, crash, sandbox
+    // disabled — and the caller renders in-process.
+    QImage render(const QString& filePath, int pageNum, double xres,
+                  double yres, int x = 0, int y = 0, int w = -1, int h = -1);
+
+signals:
+    void workerCrashed(int restartCount);
+
+private:
+    explicit RenderWorkerPool(QObject* parent = nullptr);
+    ~RenderWorkerPool() override;
+
+    struct Worker {
+        QProcess* process = nullptr;
+        bool busy = false;
+    };
+
+    Worker* acquireWorker();
+    void releaseWorker(Worker* worker);
+    void retireWorker(Worker* worker);
+    bool startWorker(Worker* worker);
+
+    mutable QMutex m_mutex;
+    QList<Worker*> m_workers;
+    bool m_enabled;
+    quint64 m_nextRequestId;
+    int m_restartCount;
+
+    static constexpr int DEFAULT_WORKER_COUNT = 2;
+    static constexpr int RENDER_TIMEOUT_MS = 20000;
+    static constexpr int WORKER_START_TIMEOUT_MS = 5000;
+};
@@ -0,0 +1,117 @@
+#include "SessionManager.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QSettings>
+#include <QStringList>
+#include "../utils/LoggingMacros.h"
+#include "AppStateStore.h"
+
+namespace {
+// Layout version of the "session" AppStateStore section
+constexpr qint32 SESSION_SECTION_VERSION = 1;
+const QString SESSION_SECTION = QStringLiteral("session");
+}  // namespace
+
+SessionManager::SessionManager(QObject* parent) : QObject(parent) {}
+
+bool SessionManager::isRestoreEnabled() const {
+    QSettings settings;
+    return settings.value("session/restoreEnabled", true).toBool();
+}
+
+void SessionManager::setRestoreEnabled(bool enabled) {
+    QSettings settings;
+    settings.setValue("session/restoreEnabled", enabled);
+}
+
+SessionManager::SessionState SessionManager::loadSession() {
+    QStringList files;
+    QStringList pages;
+    QString activePath;
+
+    // The state store is the current home of the session; the QSettings
+    // keys below remain readable as the one-time migration path
+    const QByteArray blob = AppStateStore::instance().section(SESSION_SECTION);
+    bool loaded = false;
+    if (!blob.isEmpty()) {
+        QDataStream stream(blob);
+        stream.setVersion(QDataStream::Qt_6_0);
+        qint32 version = 0;
+        stream >> version;
+        if (version == SESSION_SECTION_VERSION) {
+            stream >> files >> pages >> activePath;
+            loaded = stream.status() == QDataStream::Ok;
+        }
+        if (!loaded) {
+            LOG_WARNING(
+                "SessionManager: unreadable session section, falling back to "
+                "QSettings");
+            files.clear();
+            pages.clear();
+            activePath.clear();
+        }
+    }
+    if (!loaded) {
+        QSettings settings;
+        files = settings.value("session/files").toStringList();
+        pages = settings.value("session/pages").toStringList();
+        activePath = settings.value("session/activeFile").toString();
+    }
+
+    SessionState state;
+    for (int i = 0; i < files.size(); ++i) {
+        const QString& filePath = files[i];
+        if (!QFile::exists(filePath)) {
+            LOG_DEBUG("SessionManager: dropping missing file from session: {}",
+                      filePath.toStdString());
+            continue;
+        }
+        int page = (i < pages.size()) ? pages[i].toInt() : -1;
+        m_savedPages[filePath] = page;
+        if (filePath == activePath) {
+            state.activeIndex = state.tabs.size();
+        }
+        state.tabs.append(qMakePair(filePath, page));
+    }
+    if (state.activeIndex < 0 && !state.tabs.isEmpty()) {
+        state.activeIndex = 0;
+    }
+    return state;
+}
+
+void SessionManager::saveSession(const QList<QPair<QString, int>>& tabs,
+                                 int activeIndex) {
+    QStringList files;
+    QStringList pages;
+    for (const auto& tab : tabs) {
+        files.append(tab.first);
+        // A tab that was never hydrated this run keeps the page it was
+        // restored with
+        int page = tab.second;
+        if (page < 0) {
+            page = m_savedPages.value(tab.first, 0);
+        }
+        pages.append(QString::number(page));
+    }
+
+    const QString activePath = (activeIndex >= 0 && activeIndex < tabs.size())
+                                   ? tabs[activeIndex].first
+                                   : QString();
+
+    // Serialized once into the state store; an unchanged session leaves
+    // the store clean and the shutdown flush a no-op
+    QByteArray blob;
+    {
+        QDataStream stream(&blob, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_6_0);
+        stream << SESSION_SECTION_VERSION << files << pages << activePath;
+    }
+    AppStateStore::instance().putSection(SESSION_SECTION, blob);
+    AppStateStore::instance().checkpoint();
+    LOG_DEBUG("SessionManager: saved session with {} tabs", files.size());
+}
+
+int SessionManager::savedPage(const QString& filePath) const {
+    return m_savedPages.value(filePath, -1);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPair>
+#include <QString>
+
+/**
+ * Persists and restores the set of open tabs across application runs.
+ *
+ * The session is deliberately tiny — file path, last page and the
+ * active tab index — and lives in the AppStateStore "session" section
+ * (legacy QSettings data under "session/" is still read once). Restore
+ * is lazy by design: only the active tab's document is loaded eagerly
+ * at startup, the rest come back as placeholder tabs that hydrate on
+ * first activation or in background idle time (see
+ * MainWindow::restoreSession), so startup-to-usable costs one
+ * document's load regardless of how many tabs were open.
+ */
+class SessionManager : public QObject {
+    Q_OBJECT
+
+public:
+    struct SessionState {
+        // (filePath, last page) in tab order
+        QList<QPair<QString, int>> tabs;
+        int activeIndex = -1;
+    };
+
+    explicit SessionManager(QObject* parent = nullptr);
+
+    // "session/restoreEnabled", default true
+    bool isRestoreEnabled() const;
+    void setRestoreEnabled(bool enabled);
+
+    // Reads the persisted session; missing files are dropped. Also
+    // primes savedPage() for tabs that restore as placeholders.
+    SessionState loadSession();
+
+    // Persists the current tab set. A page of -1 means the tab was
+    // never hydrated this run; its previously saved page is kept.
+    void saveSession(const QList<QPair<QString, int>>& tabs, int activeIndex);
+
+    // Last page recorded for a file in the loaded session, -1 if none
+    int savedPage(const QString& filePath) const;
+
+private:
+    QHash<QString, int> m_savedPages;
+};
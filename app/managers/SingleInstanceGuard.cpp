@@ -0,0 +1,104 @@
+#include "SingleInstanceGuard.h"
+#include <QFileInfo>
+#include <QLocalSocket>
+#include "../utils/LoggingMacros.h"
+
+namespace {
+// A secondary that cannot reach the primary within this budget gives up
+// and starts normally; a handoff on a healthy machine takes ~1ms
+constexpr int CONNECT_TIMEOUT_MS = 250;
+constexpr int WRITE_TIMEOUT_MS = 500;
+}  // namespace
+
+SingleInstanceGuard::SingleInstanceGuard(QObject* parent)
+    : QObject(parent), m_server(nullptr) {}
+
+SingleInstanceGuard::~SingleInstanceGuard() {
+    if (m_server) {
+        m_server->close();
+    }
+}
+
+QString SingleInstanceGuard::serverName() {
+    // Scope the socket per user so two desktop sessions on the same
+    // machine get independent instances
+    QString user = qEnvironmentVariable("USER");
+    if (user.isEmpty()) {
+        user = qEnvironmentVariable("USERNAME");  // Windows
+    }
+    return QStringLiteral("sast-readium-") + user;
+}
+
+bool SingleInstanceGuard::forwardToRunningInstance(
+    const QStringList& filePaths) {
+    QLocalSocket socket;
+    socket.connectToServer(serverName());
+    if (!socket.waitForConnected(CONNECT_TIMEOUT_MS)) {
+        // No primary, or a stale socket from a crash; start normally
+        return false;
+    }
+
+    // The primary's working directory differs from ours, so relative
+    // paths must be resolved before they cross the process boundary
+    QStringList absolutePaths;
+    absolutePaths.reserve(filePaths.size());
+    for (const QString& path : filePaths) {
+        absolutePaths.append(QFileInfo(path).absoluteFilePath());
+    }
+
+    socket.write(absolutePaths.join(QLatin1Char('\n')).toUtf8());
+    const bool delivered = socket.waitForBytesWritten(WRITE_TIMEOUT_MS);
+    socket.disconnectFromServer();
+    return delivered;
+}
+
+bool SingleInstanceGuard::listen() {
+    if (m_server) {
+        return true;
+    }
+    m_server = new QLocalServer(this);
+
+    if (!m_server->listen(serverName())) {
+        // A leftover socket from a crashed instance blocks the name.
+        // forwardToRunningInstance() already failed to connect to it,
+        // so nothing live is behind it: sweep and retry once.
+        QLocalServer::removeServer(serverName());
+        if (!m_server->listen(serverName())) {
+            LOG_WARNING("Single-instance socket unavailable: {}",
+                        m_server->errorString().toStdString());
+            m_server->deleteLater();
+            m_server = nullptr;
+            return false;
+        }
+    }
+
+    connect(m_server, &QLocalServer::newConnection, this, [this]() {
+        while (QLocalSocket* client = m_server->nextPendingConnection()) {
+            // Handoffs are a few hundred bytes and the client closes
+            // after writing, so read everything once it disconnects
+            // (buffered data stays readable past the disconnect)
+            connect(client, &QLocalSocket::disconnected, this,
+                    [this, client]() {
+                        const QByteArray payload = client->readAll();
+                        QStringList files;
+                        const QList<QByteArray> lines = payload.split('\n');
+                        for (const QByteArray& line : lines) {
+                            const QString path =
+                                QString::fromUtf8(line).trimmed();
+                            if (!path.isEmpty()) {
+                                files.append(path);
+                            }
+                        }
+                        client->deleteLater();
+                        LOG_INFO(
+                            "Single-instance handoff received ({} file(s))",
+                            files.size());
+                        emit filesReceived(files);
+                    });
+        }
+    });
+
+    LOG_INFO("Single-instance listener active on '{}'",
+             serverName().toStdString());
+    return true;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QLocalServer>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+/**
+ * Single-instance activation with fast file handoff.
+ *
+ * Double-clicking a PDF in a file manager while the reader is already
+ * running used to start a second process that paid full startup (Qt,
+ * plugins, styles — seconds) before the document appeared. A fresh
+ * process now first tries forwardToRunningInstance(): if a primary is
+ * listening on the local socket, the file paths are handed over and the
+ * new process exits within milliseconds, while the warm primary opens
+ * the file through its normal loading pipeline and raises its window.
+ *
+ * The primary calls listen() once its window exists. A stale socket
+ * left behind by a crashed instance is harmless: the secondary's
+ * connect attempt fails, it becomes the new primary, and listen()
+ * sweeps the dead socket before claiming the name. The wire format is
+ * deliberately trivial — newline-separated UTF-8 absolute paths, with
+ * the connection closed after writing; an empty payload is a plain
+ * "raise the window" activation.
+ */
+class SingleInstanceGuard : public QObject {
+    Q_OBJECT
+
+public:
+    explicit SingleInstanceGuard(QObject* parent = nullptr);
+    ~SingleInstanceGuard() override;
+
+    // Forward file paths to an already-running instance. Returns true
+    // when a primary accepted the handoff and this process should exit,
+    // false when no primary is reachable and the caller should become
+    // one. Called before any heavyweight initialization.
+    static bool forwardToRunningInstance(const QStringList& filePaths);
+
+    // Become the primary: start listening for handoffs. Returns false
+    // if the socket cannot be claimed (another live instance raced us).
+    bool listen();
+
+signals:
+    // Paths handed over by a secondary process. May be empty for a
+    // plain activation; the receiver raises its window either way.
+    void filesReceived(const QStringList& filePaths);
+
+private:
+    static QString serverName();
+
+    QLocalServer* m_server;
+};
@@ -1,5 +1,6 @@
 #include "StyleManager.h"
 #include <QFontDatabase>
+#include <QWidget>
 #include "utils/Logger.h"
 
 StyleManager& StyleManager::instance() {
@@ -11,6 +12,63 @@ StyleManager::StyleManager() : m_currentTheme(Theme::Light) {
     Logger::instance().info(
         "[managers] StyleManager initialized with Light theme");
     updateColors();
+    // 启动时把两套主题的全部片段和调色板编译好，之后切主题
+    // 只是查表和比对，不再做字符串拼装
+    precompileStyleSheets();
+}
+
+void StyleManager::precompileStyleSheets() {
+    const Theme original = m_currentTheme;
+    for (Theme theme : {Theme::Light, Theme::Dark}) {
+        m_currentTheme = theme;
+        updateColors();
+
+        const int idx = themeIndex(theme);
+        auto store = [this, idx](StyleSection section, const QString& css) {
+            m_fragments[idx][static_cast<int>(section)] = css;
+        };
+        store(StyleSection::Application, createApplicationStyle());
+        store(StyleSection::Toolbar, createToolbarStyle());
+        store(StyleSection::StatusBar, createStatusBarStyle());
+        store(StyleSection::PDFViewer, createPDFViewerStyle());
+        store(StyleSection::Button, createButtonStyle());
+        store(StyleSection::ScrollBar, createScrollBarStyle());
+
+        QPalette palette;
+        palette.setColor(QPalette::Window, m_backgroundColor);
+        palette.setColor(QPalette::WindowText, m_textColor);
+        palette.setColor(QPalette::Base, m_backgroundColor);
+        palette.setColor(QPalette::AlternateBase, m_surfaceColor);
+        palette.setColor(QPalette::Text, m_textColor);
+        palette.setColor(QPalette::Button, m_surfaceColor);
+        palette.setColor(QPalette::ButtonText, m_textColor);
+        palette.setColor(QPalette::ToolTipBase, m_surfaceColor);
+        palette.setColor(QPalette::ToolTipText, m_textColor);
+        palette.setColor(QPalette::Highlight, m_accentColor);
+        palette.setColor(QPalette::HighlightedText, m_backgroundColor);
+        palette.setColor(QPalette::PlaceholderText, m_textSecondaryColor);
+        m_palettes[idx] = palette;
+    }
+    m_currentTheme = original;
+    updateColors();
+}
+
+bool StyleManager::sectionDiffers(StyleSection section, Theme a,
+                                  Theme b) const {
+    const int sectionIdx = static_cast<int>(section);
+    return m_fragments[themeIndex(a)][sectionIdx] !=
+           m_fragments[themeIndex(b)][sectionIdx];
+}
+
+void StyleManager::applyStyleSheetIfChanged(QWidget* widget,
+                                            const QString& styleSheet) {
+    if (widget && widget->styleSheet() != styleSheet) {
+        widget->setStyleSheet(styleSheet);
+    }
+}
+
+QPalette StyleManager::themePalette() const {
+    return m_palettes[themeIndex(m_currentTheme)];
 }
 
 void StyleManager::setTheme(Theme theme) {
@@ -57,6 +115,11 @@ void StyleManager::updateColors() {
 }
 
 QString StyleManager::getApplicationStyleSheet() const {
+    return m_fragments[themeIndex(m_currentTheme)]
+                      [static_cast<int>(StyleSection::Application)];
+}
+
+QString StyleManager::createApplicationStyle() const {
     return QString(R"(
         QMainWindow {
             background-color: %1;
@@ -92,6 +155,11 @@ QString StyleManager::getApplicationStyleSheet() const {
 }
 
 QString StyleManager::getToolbarStyleSheet() const {
+    return m_fragments[themeIndex(m_currentTheme)]
+                      [static_cast<int>(StyleSection::Toolbar)];
+}
+
+QString StyleManager::createToolbarStyle() const {
     return QString(R"(
         QWidget#toolbar {
             background-color: %1;
@@ -105,7 +173,8 @@ QString StyleManager::getToolbarStyleSheet() const {
 }
 
 QString StyleManager::getButtonStyleSheet() const {
-    return createButtonStyle();
+    return m_fragments[themeIndex(m_currentTheme)]
+                      [static_cast<int>(StyleSection::Button)];
 }
 
 QString StyleManager::createButtonStyle() const {
@@ -178,6 +247,11 @@ QFont StyleManager::buttonFont() const {
 }
 
 QString StyleManager::getStatusBarStyleSheet() const {
+    return m_fragments[themeIndex(m_currentTheme)]
+                      [static_cast<int>(StyleSection::StatusBar)];
+}
+
+QString StyleManager::createStatusBarStyle() const {
     return QString(R"(
         QStatusBar {
             background-color: %1;
@@ -212,6 +286,11 @@ QString StyleManager::getStatusBarStyleSheet() const {
 }
 
 QString StyleManager::getPDFViewerStyleSheet() const {
+    return m_fragments[themeIndex(m_currentTheme)]
+                      [static_cast<int>(StyleSection::PDFViewer)];
+}
+
+QString StyleManager::createPDFViewerStyle() const {
     return QString(R"(
         QScrollArea {
             background-color: %1;
@@ -232,7 +311,8 @@ QString StyleManager::getPDFViewerStyleSheet() const {
 }
 
 QString StyleManager::getScrollBarStyleSheet() const {
-    return createScrollBarStyle();
+    return m_fragments[themeIndex(m_currentTheme)]
+                      [static_cast<int>(StyleSection::ScrollBar)];
 }
 
 QString StyleManager::createScrollBarStyle() const {
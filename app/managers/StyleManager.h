@@ -4,10 +4,24 @@
 #include <QColor>
 #include <QFont>
 #include <QObject>
+#include <QPalette>
 #include <QString>
 
+class QWidget;
+
 enum class Theme { Light, Dark };
 
+// 样式表片段，按控件类切分；切主题时只重设真正变化的片段
+enum class StyleSection {
+    Application,
+    Toolbar,
+    StatusBar,
+    PDFViewer,
+    Button,
+    ScrollBar,
+    SectionCount
+};
+
 class StyleManager : public QObject {
     Q_OBJECT
 
@@ -18,7 +32,7 @@ public:
     void setTheme(Theme theme);
     Theme currentTheme() const { return m_currentTheme; }
 
-    // 样式表获取
+    // 样式表获取（两套主题的片段在构造时预编译缓存，这里只做查表）
     QString getApplicationStyleSheet() const;
     QString getToolbarStyleSheet() const;
     QString getStatusBarStyleSheet() const;
@@ -26,6 +40,17 @@ public:
     QString getButtonStyleSheet() const;
     QString getScrollBarStyleSheet() const;
 
+    // 增量主题应用
+    // 两个主题间该片段是否有差异；无差异的控件类切主题时可整体跳过
+    bool sectionDiffers(StyleSection section, Theme a, Theme b) const;
+    // 片段与控件当前样式表相同时跳过setStyleSheet，避免无谓的
+    // 全子树重新polish
+    static void applyStyleSheetIfChanged(QWidget* widget,
+                                         const QString& styleSheet);
+    // 当前主题的调色板（缓存）。亮暗切换的快路径：调色板传播
+    // 代替顶层setStyleSheet触发的整树样式表重算
+    QPalette themePalette() const;
+
     // 颜色获取
     QColor primaryColor() const;
     QColor secondaryColor() const;
@@ -61,11 +86,21 @@ private:
     StyleManager& operator=(const StyleManager&) = delete;
 
     void updateColors();
+    void precompileStyleSheets();
+    static int themeIndex(Theme theme) { return theme == Theme::Dark ? 1 : 0; }
+    QString createApplicationStyle() const;
+    QString createToolbarStyle() const;
+    QString createStatusBarStyle() const;
+    QString createPDFViewerStyle() const;
     QString createButtonStyle() const;
     QString createScrollBarStyle() const;
 
     Theme m_currentTheme;
 
+    // 预编译缓存：[主题][片段]
+    QString m_fragments[2][static_cast<int>(StyleSection::SectionCount)];
+    QPalette m_palettes[2];
+
     // 颜色定义
     QColor m_primaryColor;
     QColor m_secondaryColor;
@@ -0,0 +1,225 @@
+#include "AnnotationJournal.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMutexLocker>
+#include <QPointer>
+#include <QStandardPaths>
+#include <QtDebug>
+#include "managers/RenderScheduler.h"
+
+AnnotationJournal::AnnotationJournal(QObject* parent)
+    : QObject(parent), m_journalOps(0), m_flushTimer(new QTimer(this)) {
+    m_flushTimer->setSingleShot(true);
+    m_flushTimer->setInterval(FLUSH_INTERVAL_MS);
+    // Flush I/O happens on the pool, never on the timer's (GUI) thread
+    connect(m_flushTimer, &QTimer::timeout, this, [this]() {
+        QPointer<AnnotationJournal> self(this);
+        RenderScheduler::instance().submit(
+            RenderScheduler::TaskClass::Background, [self]() {
+                if (self) {
+                    self->flushPending();
+                }
+            });
+    });
+}
+
+AnnotationJournal::~AnnotationJournal() { flushNow(); }
+
+void AnnotationJournal::setDocumentIdentifier(const QString& documentHash) {
+    {
+        QMutexLocker locker(&m_mutex);
+        if (documentHash == m_documentHash) {
+            return;
+        }
+    }
+
+    // The previous document's edits must reach disk before the state is
+    // replaced
+    flushNow();
+
+    QMutexLocker locker(&m_mutex);
+    m_documentHash = documentHash;
+    m_state.clear();
+    m_pending.clear();
+    m_journalOps = 0;
+
+    if (m_documentHash.isEmpty()) {
+        return;
+    }
+
+    loadLocked();
+
+    // A long journal left over from a previous session compacts at load
+    // time so replay stays cheap
+    if (m_journalOps >= COMPACT_THRESHOLD) {
+        compactLocked();
+    }
+}
+
+QString AnnotationJournal::documentIdentifier() const {
+    QMutexLocker locker(&m_mutex);
+    return m_documentHash;
+}
+
+QList<PDFAnnotation> AnnotationJournal::annotations() const {
+    QMutexLocker locker(&m_mutex);
+    return m_state.values();
+}
+
+void AnnotationJournal::recordAdd(const PDFAnnotation& annotation) {
+    QJsonObject op;
+    op["op"] = "add";
+    op["annotation"] = annotation.toJson();
+    enqueue(op);
+}
+
+void AnnotationJournal::recordUpdate(const PDFAnnotation& annotation) {
+    QJsonObject op;
+    op["op"] = "update";
+    op["annotation"] = annotation.toJson();
+    enqueue(op);
+}
+
+void AnnotationJournal::recordRemove(const QString& annotationId) {
+    QJsonObject op;
+    op["op"] = "remove";
+    op["id"] = annotationId;
+    enqueue(op);
+}
+
+void AnnotationJournal::flushNow() {
+    m_flushTimer->stop();
+    flushPending();
+}
+
+int AnnotationJournal::pendingOperationCount() const {
+    QMutexLocker locker(&m_mutex);
+    return m_pending.size();
+}
+
+QString AnnotationJournal::journalFilePath() const {
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) +
+           "/annotations/" + m_documentHash + ".journal";
+}
+
+QString AnnotationJournal::snapshotFilePath() const {
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) +
+           "/annotations/" + m_documentHash + ".snapshot.json";
+}
+
+void AnnotationJournal::enqueue(const QJsonObject& op) {
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_documentHash.isEmpty()) {
+            return;
+        }
+        applyOpLocked(op);
+        m_pending.append(op);
+    }
+    scheduleFlush();
+}
+
+void AnnotationJournal::scheduleFlush() {
+    // Started, not restarted: a steady stream of edits must still flush
+    // every interval rather than being debounced forever
+    if (!m_flushTimer->isActive()) {
+        m_flushTimer->start();
+    }
+}
+
+void AnnotationJournal::flushPending() {
+    QMutexLocker locker(&m_mutex);
+    if (m_pending.isEmpty() || m_documentHash.isEmpty()) {
+        return;
+    }
+
+    QString path = journalFilePath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QFile journal(path);
+    if (!journal.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qWarning() << "AnnotationJournal: cannot append to" << path;
+        return;  // Ops stay pending; the next flush retries
+    }
+
+    const int flushedOps = m_pending.size();
+    for (const QJsonObject& op : std::as_const(m_pending)) {
+        journal.write(QJsonDocument(op).toJson(QJsonDocument::Compact));
+        journal.write("\n");
+    }
+    journal.close();
+
+    m_journalOps += flushedOps;
+    m_pending.clear();
+
+    if (m_journalOps >= COMPACT_THRESHOLD) {
+        compactLocked();
+    }
+
+    locker.unlock();
+    emit flushed(flushedOps);
+}
+
+void AnnotationJournal::loadLocked() {
+    QFile snapshot(snapshotFilePath());
+    if (snapshot.open(QIODevice::ReadOnly)) {
+        QJsonDocument doc = QJsonDocument::fromJson(snapshot.readAll());
+        const QJsonArray entries = doc.array();
+        for (const QJsonValue& value : entries) {
+            PDFAnnotation annotation =
+                PDFAnnotation::fromJson(value.toObject());
+            if (!annotation.id.isEmpty()) {
+                m_state.insert(annotation.id, annotation);
+            }
+        }
+    }
+
+    QFile journal(journalFilePath());
+    if (journal.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        while (!journal.atEnd()) {
+            QJsonDocument doc = QJsonDocument::fromJson(journal.readLine());
+            if (doc.isObject()) {
+                applyOpLocked(doc.object());
+                m_journalOps++;
+            }
+        }
+    }
+}
+
+void AnnotationJournal::applyOpLocked(const QJsonObject& op) {
+    const QString kind = op["op"].toString();
+    if (kind == "remove") {
+        m_state.remove(op["id"].toString());
+        return;
+    }
+    PDFAnnotation annotation =
+        PDFAnnotation::fromJson(op["annotation"].toObject());
+    if (!annotation.id.isEmpty()) {
+        m_state.insert(annotation.id, annotation);
+    }
+}
+
+void AnnotationJournal::compactLocked() {
+    QJsonArray entries;
+    for (const PDFAnnotation& annotation : std::as_const(m_state)) {
+        entries.append(annotation.toJson());
+    }
+
+    QString path = snapshotFilePath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QFile snapshot(path);
+    if (!snapshot.open(QIODevice::WriteOnly)) {
+        qWarning() << "AnnotationJournal: cannot write snapshot" << path;
+        return;  // Keep the journal; replay still reconstructs the state
+    }
+    snapshot.write(QJsonDocument(entries).toJson(QJsonDocument::Compact));
+    snapshot.close();
+
+    // Snapshot first, journal removal second: a crash in between just
+    // replays ops that are already reflected in the snapshot, which is
+    // idempotent
+    QFile::remove(journalFilePath());
+    m_journalOps = 0;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include "AnnotationModel.h"
+
+/**
+ * Write-behind persistence for annotation edits.
+ *
+ * Mutations append to an in-memory journal on the caller's thread (no
+ * I/O); a coalescing timer hands the accumulated batch to the shared
+ * pool, which appends it to an on-disk journal file, one JSON operation
+ * per line. Once the journal grows past a threshold it is compacted
+ * into a full snapshot and truncated. Loading replays snapshot plus
+ * journal, so the GUI thread never blocks on annotation I/O and a crash
+ * loses at most one flush interval of edits.
+ *
+ * Files live under AppDataLocation/annotations, keyed by document hash
+ * like the prerenderer's reading patterns.
+ */
+class AnnotationJournal : public QObject {
+    Q_OBJECT
+
+public:
+    explicit AnnotationJournal(QObject* parent = nullptr);
+    ~AnnotationJournal() override;
+
+    // Switches the persistence key: flushes the previous document's
+    // pending edits, then loads the new document's snapshot and journal.
+    // An empty hash disables persistence
+    void setDocumentIdentifier(const QString& documentHash);
+    QString documentIdentifier() const;
+
+    // Annotations reconstructed from snapshot + journal for the current
+    // document
+    QList<PDFAnnotation> annotations() const;
+
+    // Mutation recording; cheap, no I/O on the calling thread
+    void recordAdd(const PDFAnnotation& annotation);
+    void recordUpdate(const PDFAnnotation& annotation);
+    void recordRemove(const QString& annotationId);
+
+    // Blocking flush for shutdown and document switches
+    void flushNow();
+
+    int pendingOperationCount() const;
+
+signals:
+    // Emitted from a pool thread after a batch reaches disk
+    void flushed(int operationCount);
+
+private:
+    QString journalFilePath() const;
+    QString snapshotFilePath() const;
+    void enqueue(const QJsonObject& op);
+    void scheduleFlush();
+    void flushPending();  // Runs on a pool thread (or inline in flushNow)
+    void loadLocked();
+    void applyOpLocked(const QJsonObject& op);
+    void compactLocked();
+
+    QString m_documentHash;
+    QHash<QString, PDFAnnotation> m_state;  // Materialized journal state
+    QList<QJsonObject> m_pending;           // Ops not yet on disk
+    int m_journalOps;  // Ops in the on-disk journal since last compaction
+    QTimer* m_flushTimer;
+    mutable QMutex m_mutex;
+
+    static const int FLUSH_INTERVAL_MS = 2000;
+    static const int COMPACT_THRESHOLD = 256;
+};
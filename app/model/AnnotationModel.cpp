@@ -8,6 +8,8 @@
 #include <QRandomGenerator>
 #include <QtCore>
 #include <algorithm>
+#include "AnnotationJournal.h"
+#include "AnnotationWriteback.h"
 
 // PDFAnnotation serialization implementation
 QJsonObject PDFAnnotation::toJson() const {
@@ -173,7 +175,24 @@ AnnotationType PDFAnnotation::typeFromString(const QString& typeStr) {
 }
 
 AnnotationModel::AnnotationModel(QObject* parent)
-    : QAbstractListModel(parent), m_document(nullptr) {}
+    : QAbstractListModel(parent),
+      m_document(nullptr),
+      m_allHydrated(false),
+      m_journal(new AnnotationJournal(this)),
+      m_writeback(new AnnotationWriteback(this)),
+      m_rowByIdDirty(true) {
+    // annotationsSaved now reports batched background flushes rather
+    // than blocking writes
+    connect(m_journal, &AnnotationJournal::flushed, this,
+            &AnnotationModel::annotationsSaved);
+    connect(m_writeback, &AnnotationWriteback::finished, this,
+            [this](const QString& filePath, int count, qint64 elapsedMs) {
+                Q_UNUSED(elapsedMs)
+                emit annotationsWrittenBack(filePath, count);
+            });
+    connect(m_writeback, &AnnotationWriteback::failed, this,
+            &AnnotationModel::writeBackFailed);
+}
 
 int AnnotationModel::rowCount(const QModelIndex& parent) const {
     Q_UNUSED(parent)
@@ -271,6 +290,8 @@ bool AnnotationModel::setData(const QModelIndex& index, const QVariant& value,
     }
 
     if (changed) {
+        m_dirtyPages.insert(annotation.pageNumber);
+        m_journal->recordUpdate(annotation);
         emit dataChanged(index, index, {role});
         emit annotationUpdated(annotation);
         return true;
@@ -309,12 +330,38 @@ bool AnnotationModel::addAnnotation(const PDFAnnotation& annotation) {
     m_annotations.append(annotation);
     endInsertRows();
 
+    m_dirtyPages.insert(annotation.pageNumber);
+    m_spatialIndex.insert(annotation.id, annotation.pageNumber,
+                          annotation.boundingRect);
+    m_journal->recordAdd(annotation);
     sortAnnotations();
     emit annotationAdded(annotation);
 
     return true;
 }
 
+int AnnotationModel::addAnnotationsBatch(
+    const QList<PDFAnnotation>& annotations) {
+    if (annotations.isEmpty()) {
+        return 0;
+    }
+
+    const int first = m_annotations.size();
+    beginInsertRows(QModelIndex(), first, first + annotations.size() - 1);
+    for (const PDFAnnotation& annotation : annotations) {
+        m_annotations.append(annotation);
+        m_dirtyPages.insert(annotation.pageNumber);
+        m_spatialIndex.insert(annotation.id, annotation.pageNumber,
+                              annotation.boundingRect);
+        m_journal->recordAdd(annotation);
+    }
+    endInsertRows();
+
+    sortAnnotations();
+    emit annotationsLoaded(annotations.size());
+    return annotations.size();
+}
+
 bool AnnotationModel::removeAnnotation(const QString& annotationId) {
     int index = findAnnotationIndex(annotationId);
     if (index < 0) {
@@ -322,9 +369,13 @@ bool AnnotationModel::removeAnnotation(const QString& annotationId) {
     }
 
     beginRemoveRows(QModelIndex(), index, index);
+    m_dirtyPages.insert(m_annotations.at(index).pageNumber);
     m_annotations.removeAt(index);
     endRemoveRows();
 
+    m_spatialIndex.remove(annotationId);
+    m_rowByIdDirty = true;
+    m_journal->recordRemove(annotationId);
     emit annotationRemoved(annotationId);
     return true;
 }
@@ -338,6 +389,10 @@ bool AnnotationModel::updateAnnotation(const QString& annotationId,
 
     m_annotations[index] = updatedAnnotation;
     m_annotations[index].modifiedTime = QDateTime::currentDateTime();
+    m_dirtyPages.insert(updatedAnnotation.pageNumber);
+    m_spatialIndex.update(annotationId, updatedAnnotation.pageNumber,
+                          updatedAnnotation.boundingRect);
+    m_journal->recordUpdate(m_annotations.at(index));
 
     QModelIndex modelIndex = this->index(index, 0);
     emit dataChanged(modelIndex, modelIndex);
@@ -356,11 +411,16 @@ PDFAnnotation AnnotationModel::getAnnotation(
 }
 
 QList<PDFAnnotation> AnnotationModel::getAllAnnotations() const {
+    // Document-wide access needs the complete set
+    const_cast<AnnotationModel*>(this)->hydrateAllPages();
     return m_annotations;
 }
 
 QList<PDFAnnotation> AnnotationModel::getAnnotationsForPage(
     int pageNumber) const {
+    // First access to a page materializes its records
+    const_cast<AnnotationModel*>(this)->hydratePage(pageNumber);
+
     QList<PDFAnnotation> result;
     for (const PDFAnnotation& annotation : m_annotations) {
         if (annotation.pageNumber == pageNumber) {
@@ -371,6 +431,8 @@ QList<PDFAnnotation> AnnotationModel::getAnnotationsForPage(
 }
 
 bool AnnotationModel::removeAnnotationsForPage(int pageNumber) {
+    hydratePage(pageNumber);
+    m_dirtyPages.insert(pageNumber);
     bool removed = false;
     for (int i = m_annotations.size() - 1; i >= 0; --i) {
         if (m_annotations.at(i).pageNumber == pageNumber) {
@@ -378,14 +440,19 @@ bool AnnotationModel::removeAnnotationsForPage(int pageNumber) {
             QString removedId = m_annotations.at(i).id;
             m_annotations.removeAt(i);
             endRemoveRows();
+            m_journal->recordRemove(removedId);
             emit annotationRemoved(removedId);
             removed = true;
         }
     }
+    m_spatialIndex.clearPage(pageNumber);
+    m_rowByIdDirty = true;
     return removed;
 }
 
 int AnnotationModel::getAnnotationCountForPage(int pageNumber) const {
+    const_cast<AnnotationModel*>(this)->hydratePage(pageNumber);
+
     int count = 0;
     for (const PDFAnnotation& annotation : m_annotations) {
         if (annotation.pageNumber == pageNumber) {
@@ -395,28 +462,185 @@ int AnnotationModel::getAnnotationCountForPage(int pageNumber) const {
     return count;
 }
 
+QList<PDFAnnotation> AnnotationModel::annotationsAtPoint(
+    int pageNumber, const QPointF& point) const {
+    const_cast<AnnotationModel*>(this)->hydratePage(pageNumber);
+
+    QList<PDFAnnotation> result;
+    for (const QString& id : m_spatialIndex.queryPoint(pageNumber, point)) {
+        int row = rowForId(id);
+        if (row >= 0 && m_annotations.at(row).isVisible) {
+            result.append(m_annotations.at(row));
+        }
+    }
+    return result;
+}
+
+QList<PDFAnnotation> AnnotationModel::annotationsInViewport(
+    int pageNumber, const QRectF& viewport) const {
+    const_cast<AnnotationModel*>(this)->hydratePage(pageNumber);
+
+    QList<PDFAnnotation> result;
+    for (const QString& id :
+         m_spatialIndex.queryViewport(pageNumber, viewport)) {
+        int row = rowForId(id);
+        if (row >= 0 && m_annotations.at(row).isVisible) {
+            result.append(m_annotations.at(row));
+        }
+    }
+    return result;
+}
+
 void AnnotationModel::setDocument(Poppler::Document* document) {
     m_document = document;
+    // No up-front page walk: records hydrate per page on first access,
+    // so open time is independent of how heavily the document is
+    // annotated
     clearAnnotations();
-    if (document) {
-        loadAnnotationsFromDocument();
+}
+
+void AnnotationModel::setDocumentIdentifier(const QString& documentHash) {
+    // Flushes the previous document's pending edits, then loads this
+    // document's persisted state
+    m_journal->setDocumentIdentifier(documentHash);
+
+    const QList<PDFAnnotation> persisted = m_journal->annotations();
+    if (persisted.isEmpty()) {
+        return;
     }
+
+    int first = m_annotations.size();
+    beginInsertRows(QModelIndex(), first, first + persisted.size() - 1);
+    m_annotations.append(persisted);
+    endInsertRows();
+
+    // Sidecar records are local edits: pin their pages so
+    // releaseAnnotationsOutsideRange never drops them (they cannot
+    // rehydrate from the document)
+    for (const PDFAnnotation& annotation : persisted) {
+        m_dirtyPages.insert(annotation.pageNumber);
+        m_spatialIndex.insert(annotation.id, annotation.pageNumber,
+                              annotation.boundingRect);
+    }
+    m_rowByIdDirty = true;
+
+    emit annotationsLoaded(persisted.size());
 }
 
 void AnnotationModel::clearAnnotations() {
     beginResetModel();
     m_annotations.clear();
+    m_hydratedPages.clear();
+    m_dirtyPages.clear();
+    m_spatialIndex.clear();
+    m_rowByIdDirty = true;
+    m_allHydrated = false;
     endResetModel();
     emit annotationsCleared();
 }
 
+bool AnnotationModel::isPageHydrated(int pageNumber) const {
+    return m_allHydrated || m_hydratedPages.contains(pageNumber);
+}
+
+void AnnotationModel::hydratePage(int pageNumber) {
+    if (!m_document || isPageHydrated(pageNumber) || pageNumber < 0 ||
+        pageNumber >= m_document->numPages()) {
+        return;
+    }
+    m_hydratedPages.insert(pageNumber);
+
+    std::unique_ptr<Poppler::Page> page(m_document->page(pageNumber));
+    if (!page) {
+        return;
+    }
+
+    QList<PDFAnnotation> loaded;
+    std::vector<std::unique_ptr<Poppler::Annotation>> popplerAnnotations =
+        page->annotations();
+    for (auto& popplerAnnot : popplerAnnotations) {
+        try {
+            PDFAnnotation annotation = PDFAnnotation::fromPopplerAnnotation(
+                popplerAnnot.get(), pageNumber);
+            if (!annotation.id.isEmpty()) {
+                loaded.append(annotation);
+            }
+        } catch (const std::exception& e) {
+            qWarning() << "Failed to load annotation from page" << pageNumber
+                       << ":" << e.what();
+        }
+    }
+
+    if (loaded.isEmpty()) {
+        return;
+    }
+
+    // Appended rather than globally re-sorted: re-sorting would reorder
+    // rows behind the views' backs, and list consumers filter by page
+    int first = m_annotations.size();
+    beginInsertRows(QModelIndex(), first, first + loaded.size() - 1);
+    m_annotations.append(loaded);
+    endInsertRows();
+
+    for (const PDFAnnotation& annotation : loaded) {
+        m_spatialIndex.insert(annotation.id, annotation.pageNumber,
+                              annotation.boundingRect);
+    }
+    m_rowByIdDirty = true;
+}
+
+void AnnotationModel::hydrateAllPages() {
+    if (!m_document || m_allHydrated) {
+        return;
+    }
+
+    for (int pageNum = 0; pageNum < m_document->numPages(); ++pageNum) {
+        hydratePage(pageNum);
+    }
+    m_allHydrated = true;
+
+    emit annotationsLoaded(m_annotations.size());
+}
+
+void AnnotationModel::releaseAnnotationsOutsideRange(int firstPage,
+                                                     int lastPage) {
+    for (int i = m_annotations.size() - 1; i >= 0; --i) {
+        int pageNum = m_annotations.at(i).pageNumber;
+        if ((pageNum < firstPage || pageNum > lastPage) &&
+            !m_dirtyPages.contains(pageNum)) {
+            beginRemoveRows(QModelIndex(), i, i);
+            m_spatialIndex.remove(m_annotations.at(i).id);
+            m_annotations.removeAt(i);
+            endRemoveRows();
+        }
+    }
+    m_rowByIdDirty = true;
+
+    // Released pages hydrate again on next access
+    const QSet<int> hydrated = m_hydratedPages;
+    for (int pageNum : hydrated) {
+        if ((pageNum < firstPage || pageNum > lastPage) &&
+            !m_dirtyPages.contains(pageNum)) {
+            m_hydratedPages.remove(pageNum);
+        }
+    }
+    m_allHydrated = false;
+}
+
 int AnnotationModel::findAnnotationIndex(const QString& annotationId) const {
-    for (int i = 0; i < m_annotations.size(); ++i) {
-        if (m_annotations.at(i).id == annotationId) {
-            return i;
+    return rowForId(annotationId);
+}
+
+int AnnotationModel::rowForId(const QString& annotationId) const {
+    if (m_rowByIdDirty) {
+        m_rowById.clear();
+        m_rowById.reserve(m_annotations.size());
+        for (int i = 0; i < m_annotations.size(); ++i) {
+            m_rowById.insert(m_annotations.at(i).id, i);
         }
+        m_rowByIdDirty = false;
     }
-    return -1;
+    return m_rowById.value(annotationId, -1);
 }
 
 void AnnotationModel::sortAnnotations() {
@@ -427,6 +651,7 @@ void AnnotationModel::sortAnnotations() {
                   }
                   return a.createdTime > b.createdTime;
               });
+    m_rowByIdDirty = true;
 }
 
 QString AnnotationModel::generateUniqueId() const {
@@ -468,6 +693,13 @@ bool AnnotationModel::loadAnnotationsFromDocument() {
     }
 
     sortAnnotations();
+    m_spatialIndex.clear();
+    for (const PDFAnnotation& annotation : m_annotations) {
+        m_spatialIndex.insert(annotation.id, annotation.pageNumber,
+                              annotation.boundingRect);
+    }
+    m_hydratedPages.clear();
+    m_allHydrated = true;
     endResetModel();
 
     emit annotationsLoaded(loadedCount);
@@ -522,8 +754,31 @@ bool AnnotationModel::saveAnnotationsToDocument() {
     return savedCount > 0;
 }
 
+bool AnnotationModel::saveAnnotationsToFile(const QString& filePath) {
+    if (filePath.isEmpty() || m_writeback->isBusy()) {
+        return false;
+    }
+
+    // The journal state is exactly the set of local edits not yet in
+    // the file; without sidecar persistence fall back to everything the
+    // model holds (the writer skips entries the file already contains)
+    QList<PDFAnnotation> toWrite = m_journal->annotations();
+    if (toWrite.isEmpty()) {
+        hydrateAllPages();
+        toWrite = m_annotations;
+    }
+    if (toWrite.isEmpty()) {
+        return false;
+    }
+
+    return m_writeback->start(filePath, toWrite);
+}
+
 QList<PDFAnnotation> AnnotationModel::searchAnnotations(
     const QString& query) const {
+    // Document-wide query: needs the complete set
+    const_cast<AnnotationModel*>(this)->hydrateAllPages();
+
     QList<PDFAnnotation> result;
     QString lowerQuery = query.toLower();
 
@@ -540,6 +795,9 @@ QList<PDFAnnotation> AnnotationModel::searchAnnotations(
 
 QList<PDFAnnotation> AnnotationModel::getAnnotationsByType(
     AnnotationType type) const {
+    // Document-wide query: needs the complete set
+    const_cast<AnnotationModel*>(this)->hydrateAllPages();
+
     QList<PDFAnnotation> result;
     for (const PDFAnnotation& annotation : m_annotations) {
         if (annotation.type == type) {
@@ -551,6 +809,9 @@ QList<PDFAnnotation> AnnotationModel::getAnnotationsByType(
 
 QList<PDFAnnotation> AnnotationModel::getAnnotationsByAuthor(
     const QString& author) const {
+    // Document-wide query: needs the complete set
+    const_cast<AnnotationModel*>(this)->hydrateAllPages();
+
     QList<PDFAnnotation> result;
     for (const PDFAnnotation& annotation : m_annotations) {
         if (annotation.author == author) {
@@ -561,6 +822,9 @@ QList<PDFAnnotation> AnnotationModel::getAnnotationsByAuthor(
 }
 
 QList<PDFAnnotation> AnnotationModel::getRecentAnnotations(int count) const {
+    // Document-wide query: needs the complete set
+    const_cast<AnnotationModel*>(this)->hydrateAllPages();
+
     QList<PDFAnnotation> sorted = m_annotations;
     std::sort(sorted.begin(), sorted.end(),
               [](const PDFAnnotation& a, const PDFAnnotation& b) {
@@ -575,6 +839,9 @@ QList<PDFAnnotation> AnnotationModel::getRecentAnnotations(int count) const {
 }
 
 QMap<AnnotationType, int> AnnotationModel::getAnnotationCountByType() const {
+    // Document-wide query: needs the complete set
+    const_cast<AnnotationModel*>(this)->hydrateAllPages();
+
     QMap<AnnotationType, int> counts;
 
     for (const PDFAnnotation& annotation : m_annotations) {
@@ -585,6 +852,9 @@ QMap<AnnotationType, int> AnnotationModel::getAnnotationCountByType() const {
 }
 
 QStringList AnnotationModel::getAuthors() const {
+    // Document-wide query: needs the complete set
+    const_cast<AnnotationModel*>(this)->hydrateAllPages();
+
     QStringList authors;
     for (const PDFAnnotation& annotation : m_annotations) {
         if (!annotation.author.isEmpty() &&
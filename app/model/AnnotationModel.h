@@ -8,9 +8,12 @@
 #include <QJsonObject>
 #include <QList>
 #include <QObject>
+#include <QPointF>
 #include <QRandomGenerator>
 #include <QRectF>
+#include <QSet>
 #include <QString>
+#include "AnnotationSpatialIndex.h"
 
 /**
  * Annotation types supported by the system
@@ -84,6 +87,9 @@ struct PDFAnnotation {
     static AnnotationType typeFromString(const QString& typeStr);
 };
 
+class AnnotationJournal;
+class AnnotationWriteback;
+
 /**
  * Model for managing PDF annotations
  */
@@ -119,6 +125,10 @@ public:
 
     // Annotation operations
     bool addAnnotation(const PDFAnnotation& annotation);
+    // Batched insert for streaming import: one row-insert range and one
+    // coalesced annotationsLoaded signal for the whole batch instead of
+    // per-item signals. Returns the number inserted
+    int addAnnotationsBatch(const QList<PDFAnnotation>& annotations);
     bool removeAnnotation(const QString& annotationId);
     bool updateAnnotation(const QString& annotationId,
                           const PDFAnnotation& updatedAnnotation);
@@ -130,12 +140,41 @@ public:
     bool removeAnnotationsForPage(int pageNumber);
     int getAnnotationCountForPage(int pageNumber) const;
 
-    // Document integration
+    // Spatial queries for the viewer's hover and paint paths. Backed by
+    // the per-page grid index, so cost tracks the number of hits rather
+    // than the number of annotations in the document. Coordinates are
+    // page-normalized (Poppler boundary() convention); hidden
+    // annotations are filtered out
+    QList<PDFAnnotation> annotationsAtPoint(int pageNumber,
+                                            const QPointF& point) const;
+    QList<PDFAnnotation> annotationsInViewport(int pageNumber,
+                                               const QRectF& viewport) const;
+
+    // Document integration. setDocument only records the document; full
+    // PDFAnnotation records are hydrated per page on first access so a
+    // large, heavily-annotated document does not pay the whole cost at
+    // open time
     void setDocument(Poppler::Document* document);
+    // Sidecar persistence key; call after setDocument. Edits journal to
+    // disk in the background under this hash and earlier sessions' edits
+    // are loaded back. Empty disables persistence
+    void setDocumentIdentifier(const QString& documentHash);
     bool loadAnnotationsFromDocument();
     bool saveAnnotationsToDocument();
+    // Persists annotations into the PDF file itself, in the background
+    // with an atomic replace (see AnnotationWriteback). Uses the
+    // journal's locally-edited set when persistence is active, the full
+    // hydrated set otherwise. Returns false if a write is already in
+    // flight or no file path is known
+    bool saveAnnotationsToFile(const QString& filePath);
     void clearAnnotations();
 
+    // Lazy hydration control
+    bool isPageHydrated(int pageNumber) const;
+    // Drops hydrated records outside the given page range to cap resident
+    // memory; pages with unsaved local edits are never released
+    void releaseAnnotationsOutsideRange(int firstPage, int lastPage);
+
     // Search and filtering
     QList<PDFAnnotation> searchAnnotations(const QString& query) const;
     QList<PDFAnnotation> getAnnotationsByType(AnnotationType type) const;
@@ -152,14 +191,40 @@ signals:
     void annotationRemoved(const QString& annotationId);
     void annotationUpdated(const PDFAnnotation& annotation);
     void annotationsLoaded(int count);
+    // Fires after a background journal flush reaches disk; mutations
+    // themselves never block on I/O
     void annotationsSaved(int count);
+    // Fires after saveAnnotationsToFile's atomic replace lands (from a
+    // pool thread) or definitively fails
+    void annotationsWrittenBack(const QString& filePath, int count);
+    void writeBackFailed(const QString& filePath, const QString& error);
     void annotationsCleared();
 
 private:
     int findAnnotationIndex(const QString& annotationId) const;
+    int rowForId(const QString& annotationId) const;
     void sortAnnotations();
     QString generateUniqueId() const;
+    void hydratePage(int pageNumber);
+    void hydrateAllPages();
 
-    QList<PDFAnnotation> m_annotations;
+    QList<PDFAnnotation> m_annotations;  // Hydrated pages + local edits only
     Poppler::Document* m_document;
+
+    // Lazy hydration bookkeeping
+    QSet<int> m_hydratedPages;
+    QSet<int> m_dirtyPages;  // Pages with local edits; never released
+    bool m_allHydrated;
+
+    AnnotationJournal* m_journal;       // Write-behind edit persistence
+    AnnotationWriteback* m_writeback;   // Background in-file persistence
+
+    // Per-page grid over bounding rects, kept in step with every
+    // mutation above
+    AnnotationSpatialIndex m_spatialIndex;
+
+    // Lazily rebuilt id→row map; rows shift on sort and removal, so
+    // structural edits only mark it dirty instead of patching it
+    mutable QHash<QString, int> m_rowById;
+    mutable bool m_rowByIdDirty;
 };
@@ -0,0 +1,114 @@
+#include "AnnotationSpatialIndex.h"
+#include <QtGlobal>
+
+int AnnotationSpatialIndex::cellCoord(qreal normalized) {
+    return qBound(0, static_cast<int>(normalized * GRID_DIM), GRID_DIM - 1);
+}
+
+void AnnotationSpatialIndex::cellSpan(const QRectF& rect, int& left, int& top,
+                                      int& right, int& bottom) {
+    left = cellCoord(rect.left());
+    top = cellCoord(rect.top());
+    right = cellCoord(rect.right());
+    bottom = cellCoord(rect.bottom());
+}
+
+void AnnotationSpatialIndex::insert(const QString& id, int pageNumber,
+                                    const QRectF& rect) {
+    if (m_entries.contains(id)) {
+        remove(id);
+    }
+    m_entries.insert(id, Entry{pageNumber, rect});
+
+    PageGrid& grid = m_pages[pageNumber];
+    int left, top, right, bottom;
+    cellSpan(rect, left, top, right, bottom);
+    for (int row = top; row <= bottom; ++row) {
+        for (int col = left; col <= right; ++col) {
+            grid.cells[row * GRID_DIM + col].append(id);
+        }
+    }
+}
+
+void AnnotationSpatialIndex::remove(const QString& id) {
+    auto it = m_entries.constFind(id);
+    if (it == m_entries.constEnd()) {
+        return;
+    }
+
+    auto pageIt = m_pages.find(it->pageNumber);
+    if (pageIt != m_pages.end()) {
+        int left, top, right, bottom;
+        cellSpan(it->rect, left, top, right, bottom);
+        for (int row = top; row <= bottom; ++row) {
+            for (int col = left; col <= right; ++col) {
+                pageIt->cells[row * GRID_DIM + col].removeOne(id);
+            }
+        }
+    }
+    m_entries.erase(it);
+}
+
+void AnnotationSpatialIndex::update(const QString& id, int pageNumber,
+                                    const QRectF& rect) {
+    remove(id);
+    insert(id, pageNumber, rect);
+}
+
+void AnnotationSpatialIndex::clear() {
+    m_entries.clear();
+    m_pages.clear();
+}
+
+void AnnotationSpatialIndex::clearPage(int pageNumber) {
+    m_pages.remove(pageNumber);
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->pageNumber == pageNumber) {
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+QStringList AnnotationSpatialIndex::queryPoint(int pageNumber,
+                                               const QPointF& point) const {
+    QStringList result;
+    auto pageIt = m_pages.constFind(pageNumber);
+    if (pageIt == m_pages.constEnd()) {
+        return result;
+    }
+
+    int cell = cellCoord(point.y()) * GRID_DIM + cellCoord(point.x());
+    for (const QString& id : pageIt->cells[cell]) {
+        if (m_entries.value(id).rect.contains(point)) {
+            result.append(id);
+        }
+    }
+    return result;
+}
+
+QStringList AnnotationSpatialIndex::queryViewport(
+    int pageNumber, const QRectF& viewport) const {
+    QStringList result;
+    auto pageIt = m_pages.constFind(pageNumber);
+    if (pageIt == m_pages.constEnd()) {
+        return result;
+    }
+
+    int left, top, right, bottom;
+    cellSpan(viewport, left, top, right, bottom);
+    for (int row = top; row <= bottom; ++row) {
+        for (int col = left; col <= right; ++col) {
+            for (const QString& id : pageIt->cells[row * GRID_DIM + col]) {
+                // A rect spanning several cells shows up in each of them;
+                // de-duplicate while keeping the exact intersection test
+                if (!result.contains(id) &&
+                    m_entries.value(id).rect.intersects(viewport)) {
+                    result.append(id);
+                }
+            }
+        }
+    }
+    return result;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QPointF>
+#include <QRectF>
+#include <QString>
+#include <QStringList>
+
+/**
+ * Uniform-grid spatial index over annotation bounding rects, one grid per
+ * page. Hit-testing and viewport queries touch only the cells under the
+ * query instead of scanning every annotation on the document, so hover
+ * and paint cost stays flat as the annotation count grows.
+ *
+ * Coordinates follow the Poppler::Annotation::boundary() convention of
+ * being normalized to the page (0..1 on both axes). Rects outside that
+ * range are clamped into the edge cells — queries stay correct for them,
+ * they just lose the pruning benefit.
+ */
+class AnnotationSpatialIndex {
+public:
+    void insert(const QString& id, int pageNumber, const QRectF& rect);
+    void remove(const QString& id);
+    void update(const QString& id, int pageNumber, const QRectF& rect);
+    void clear();
+    void clearPage(int pageNumber);
+
+    // Ids of annotations whose bounding rect contains the point. The
+    // rect test is exact; only the cell walk is approximate
+    QStringList queryPoint(int pageNumber, const QPointF& point) const;
+    // Ids of annotations whose bounding rect intersects the viewport
+    QStringList queryViewport(int pageNumber, const QRectF& viewport) const;
+
+    int size() const { return m_entries.size(); }
+
+private:
+    // 16x16 cells per page: fine enough that a cursor-sized query hits
+    // one cell, coarse enough that grid upkeep is a handful of list ops
+    static constexpr int GRID_DIM = 16;
+
+    struct Entry {
+        int pageNumber;
+        QRectF rect;
+    };
+    struct PageGrid {
+        QList<QString> cells[GRID_DIM * GRID_DIM];
+    };
+
+    static int cellCoord(qreal normalized);
+    static void cellSpan(const QRectF& rect, int& left, int& top, int& right,
+                         int& bottom);
+
+    QHash<QString, Entry> m_entries;
+    QHash<int, PageGrid> m_pages;
+};
@@ -0,0 +1,155 @@
+#include "AnnotationWriteback.h"
+#include <poppler-qt6.h>
+#include <QElapsedTimer>
+#include <QMap>
+#include <QMutexLocker>
+#include <QPointer>
+#include <QSaveFile>
+#include <QSet>
+#include <QtDebug>
+#include "managers/RenderScheduler.h"
+
+namespace {
+// Identity of an annotation as far as duplicate detection goes: the
+// writer has no stable cross-format id, so page + boundary + contents
+// stands in for one
+QString dedupeKey(int pageNumber, const QRectF& boundary,
+                  const QString& contents) {
+    return QString("%1|%2,%3,%4,%5|%6")
+        .arg(pageNumber)
+        .arg(boundary.x(), 0, 'f', 4)
+        .arg(boundary.y(), 0, 'f', 4)
+        .arg(boundary.width(), 0, 'f', 4)
+        .arg(boundary.height(), 0, 'f', 4)
+        .arg(contents);
+}
+}  // namespace
+
+AnnotationWriteback::AnnotationWriteback(QObject* parent) : QObject(parent) {}
+
+bool AnnotationWriteback::isBusy() const {
+    QMutexLocker locker(&m_mutex);
+    return m_busy;
+}
+
+bool AnnotationWriteback::start(const QString& filePath,
+                                const QList<PDFAnnotation>& annotations) {
+    if (filePath.isEmpty()) {
+        return false;
+    }
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_busy) {
+            return false;
+        }
+        m_busy = true;
+    }
+
+    QPointer<AnnotationWriteback> self(this);
+    RenderScheduler::instance().submit(
+        RenderScheduler::TaskClass::Background,
+        [self, filePath, annotations]() {
+            if (self) {
+                self->writeNow(filePath, annotations);
+            }
+        });
+    return true;
+}
+
+void AnnotationWriteback::writeNow(const QString& filePath,
+                                   const QList<PDFAnnotation>& annotations) {
+    QElapsedTimer timer;
+    timer.start();
+
+    auto fail = [this, &filePath](const QString& error) {
+        {
+            QMutexLocker locker(&m_mutex);
+            m_busy = false;
+        }
+        qWarning() << "AnnotationWriteback:" << error << "(" << filePath
+                   << ")";
+        emit failed(filePath, error);
+    };
+
+    // Private handle: the render document stays untouched and the write
+    // needs no synchronization with the viewer
+    auto document = Poppler::Document::load(filePath);
+    if (!document || document->isLocked()) {
+        fail(QStringLiteral("cannot reopen document for writing"));
+        return;
+    }
+
+    QMap<int, QList<PDFAnnotation>> annotationsByPage;
+    for (const PDFAnnotation& annotation : annotations) {
+        annotationsByPage[annotation.pageNumber].append(annotation);
+    }
+
+    int writtenCount = 0;
+    for (auto it = annotationsByPage.begin(); it != annotationsByPage.end();
+         ++it) {
+        std::unique_ptr<Poppler::Page> page(document->page(it.key()));
+        if (!page) {
+            continue;
+        }
+
+        // What the file already holds, so a second save of the same
+        // journal state is a no-op rather than a duplication
+        QSet<QString> existing;
+        const auto pageAnnotations = page->annotations();
+        for (const auto& popplerAnnot : pageAnnotations) {
+            existing.insert(dedupeKey(it.key(), popplerAnnot->boundary(),
+                                      popplerAnnot->contents()));
+        }
+
+        for (const PDFAnnotation& annotation : it.value()) {
+            if (existing.contains(dedupeKey(it.key(), annotation.boundingRect,
+                                            annotation.content))) {
+                continue;
+            }
+            try {
+                Poppler::Annotation* popplerAnnot =
+                    annotation.toPopplerAnnotation();
+                if (popplerAnnot) {
+                    page->addAnnotation(popplerAnnot);
+                    writtenCount++;
+                }
+            } catch (const std::exception& e) {
+                qWarning() << "AnnotationWriteback: failed to convert"
+                           << annotation.id << ":" << e.what();
+            }
+        }
+    }
+
+    // Serialize with changes into a sibling temp file; commit() is the
+    // single atomic rename. A crash before it leaves the original file
+    // byte-identical
+    QSaveFile out(filePath);
+    if (!out.open(QIODevice::WriteOnly)) {
+        fail(QStringLiteral("cannot open temporary file for writing"));
+        return;
+    }
+
+    std::unique_ptr<Poppler::PDFConverter> converter(
+        document->pdfConverter());
+    converter->setOutputDevice(&out);
+    converter->setPDFOptions(Poppler::PDFConverter::WithChanges);
+    if (!converter->convert()) {
+        out.cancelWriting();
+        fail(QStringLiteral("document serialization failed"));
+        return;
+    }
+
+    if (!out.commit()) {
+        fail(QStringLiteral("atomic replace failed"));
+        return;
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_busy = false;
+    }
+    qDebug() << "AnnotationWriteback: wrote" << writtenCount
+             << "annotations into" << filePath << "in" << timer.elapsed()
+             << "ms";
+    emit finished(filePath, writtenCount, timer.elapsed());
+}
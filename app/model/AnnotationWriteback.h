@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include "AnnotationModel.h"
+
+/**
+ * Background writer that persists annotations into the PDF file itself.
+ *
+ * The write runs on the shared pool against a private Poppler handle
+ * loaded from the file, so it never contends with the render document.
+ * Output goes through QSaveFile: Poppler serializes the document with
+ * changes into a temporary file in the target directory and commit()
+ * replaces the original with one atomic rename, so a crash at any point
+ * leaves the original file untouched. For a document Poppler can update
+ * incrementally the serialization is the original bytes plus an
+ * appended update section, not a re-write of every object.
+ *
+ * Annotations already present in the file (same page, boundary and
+ * contents) are skipped, so handing over the model's full journal state
+ * does not duplicate entries on a second save.
+ */
+class AnnotationWriteback : public QObject {
+    Q_OBJECT
+
+public:
+    explicit AnnotationWriteback(QObject* parent = nullptr);
+
+    // Queues a write of the given annotations into filePath. Returns
+    // false when a write is already in flight; one save at a time keeps
+    // the atomic-replace semantics simple
+    bool start(const QString& filePath,
+               const QList<PDFAnnotation>& annotations);
+    bool isBusy() const;
+
+signals:
+    // Emitted from a pool thread after the rename lands, like the
+    // journal's flushed()
+    void finished(const QString& filePath, int annotationCount,
+                  qint64 elapsedMs);
+    void failed(const QString& filePath, const QString& error);
+
+private:
+    void writeNow(const QString& filePath,
+                  const QList<PDFAnnotation>& annotations);
+
+    mutable QMutex m_mutex;
+    bool m_busy = false;
+};
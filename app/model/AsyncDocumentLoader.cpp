@@ -1,8 +1,15 @@
 #include "AsyncDocumentLoader.h"
 #include <QDateTime>
 #include <QDebug>
+#include <QFile>
 #include <QFileInfo>
 #include <QMutexLocker>
+#include <utility>
+#include "managers/DocumentHasher.h"
+#include "managers/DocumentQuarantine.h"
+#include "managers/DocumentVersionBus.h"
+#include "managers/NetworkFileStager.h"
+#include "utils/SignalThrottle.h"
 
 AsyncDocumentLoader::AsyncDocumentLoader(QObject* parent)
     : QObject(parent),
@@ -10,8 +17,8 @@ AsyncDocumentLoader::AsyncDocumentLoader(QObject* parent)
       m_currentProgress(0),
       m_expectedLoadTime(0),
       m_startTime(0),
-      m_workerThread(nullptr),
-      m_worker(nullptr),
+      m_progressGeneration(0),
+      m_nextGeneration(0),
       m_configuredDefaultTimeout(0),
       m_configuredMinTimeout(0),
       m_configuredMaxTimeout(0),
@@ -21,124 +28,148 @@ AsyncDocumentLoader::AsyncDocumentLoader(QObject* parent)
     m_progressTimer->setInterval(PROGRESS_UPDATE_INTERVAL);
     connect(m_progressTimer, &QTimer::timeout, this,
             &AsyncDocumentLoader::onProgressTimerTimeout);
+
+    // 高频进度经节流中继合并：每帧间隔至多投递一次，取最新值，
+    // 避免大文档加载时队列里堆积成千上万个进度事件
+    m_progressThrottle = new SignalThrottle(this);
 }
 
 AsyncDocumentLoader::~AsyncDocumentLoader() { cancelLoading(); }
 
 void AsyncDocumentLoader::loadDocument(const QString& filePath) {
-    QMutexLocker locker(&m_stateMutex);
-
     // 检查文件是否存在
     if (!QFile::exists(filePath)) {
         emit loadingFailed("文件不存在", filePath);
         return;
     }
 
-    // 如果正在加载，先取消
-    if (m_state == LoadingState::Loading) {
-        cancelLoading();
+    // 已在加载中：无需处理
+    for (const ActiveLoad& load : std::as_const(m_active)) {
+        if (load.filePath == filePath) {
+            return;
+        }
     }
 
-    // 重置状态
-    resetState();
-    m_state = LoadingState::Loading;
-    m_currentFilePath = filePath;
-
-    locker.unlock();
-
-    // 计算预期加载时间
-    QFileInfo fileInfo(filePath);
-    qint64 fileSize = fileInfo.size();
-    m_expectedLoadTime = calculateExpectedLoadTime(fileSize);
-
-    emit loadingMessageChanged(
-        QString("正在加载 %1...").arg(fileInfo.fileName()));
-    emit loadingProgressChanged(0);
+    // 视为聚焦文档：排到队首并记录优先级
+    {
+        QMutexLocker locker(&m_queueMutex);
+        m_documentQueue.removeAll(filePath);
+        m_documentQueue.prepend(filePath);
+        m_priorityPath = filePath;
+    }
 
-    // 创建工作线程
-    m_workerThread = new QThread(this);
-    m_worker = new AsyncDocumentLoaderWorker(filePath);
-    m_worker->moveToThread(m_workerThread);
+    // 槽位占满时抢占最近启动的非聚焦加载，被抢占的文档回到队列
+    if (m_active.size() >= MAX_CONCURRENT_LOADS) {
+        preemptOneActiveLoad();
+    }
 
-    // 连接信号
-    connect(m_workerThread, &QThread::started, m_worker,
-            &AsyncDocumentLoaderWorker::doLoad);
-    connect(m_worker, &AsyncDocumentLoaderWorker::loadCompleted, this,
-            [this](Poppler::Document* document) {
-                QMutexLocker locker(&m_stateMutex);
-                if (m_state == LoadingState::Loading) {
-                    m_state = LoadingState::Completed;
-                    QString filePath = m_currentFilePath;
-                    locker.unlock();
-
-                    stopProgressSimulation();
-                    emit loadingProgressChanged(100);
-                    emit loadingMessageChanged("加载完成");
-                    emit documentLoaded(document, filePath);
-
-                    // 清理工作线程
-                    if (m_workerThread) {
-                        m_workerThread->quit();
-                        m_workerThread->wait();
-                        m_workerThread->deleteLater();
-                        m_workerThread = nullptr;
-                    }
-                    if (m_worker) {
-                        m_worker->deleteLater();
-                        m_worker = nullptr;
-                    }
-
-                    // 检查队列中是否还有待加载的文档
-                    processNextInQueue();
-                }
-            });
-    connect(m_worker, &AsyncDocumentLoaderWorker::loadFailed, this,
-            [this](const QString& error) {
-                QMutexLocker locker(&m_stateMutex);
-                if (m_state == LoadingState::Loading) {
-                    m_state = LoadingState::Failed;
-                    locker.unlock();
-                    stopProgressSimulation();
-                    emit loadingFailed(error, m_currentFilePath);
-                }
-            });
+    pumpQueue();
+}
 
-    // 开始进度模拟和加载
-    startProgressSimulation();
-    m_workerThread->start();
+void AsyncDocumentLoader::prioritizeDocument(const QString& filePath) {
+    QMutexLocker locker(&m_queueMutex);
+    if (m_documentQueue.contains(filePath)) {
+        m_priorityPath = filePath;
+    }
 }
 
 void AsyncDocumentLoader::cancelLoading() {
-    QMutexLocker locker(&m_stateMutex);
+    {
+        QMutexLocker locker(&m_queueMutex);
+        m_documentQueue.clear();
+        m_priorityPath.clear();
+    }
 
-    if (m_state != LoadingState::Loading) {
+    if (m_active.isEmpty()) {
         return;
     }
 
-    m_state = LoadingState::Cancelled;
-    QString filePath = m_currentFilePath;
+    stopProgressSimulation();
 
-    locker.unlock();
+    const QList<ActiveLoad> active = m_active;
+    m_active.clear();
 
-    stopProgressSimulation();
+    {
+        QMutexLocker locker(&m_stateMutex);
+        m_state = LoadingState::Cancelled;
+        m_currentFilePath.clear();
+    }
+
+    for (const ActiveLoad& load : active) {
+        abandonLoad(load);
+        emit loadingCancelled(load.filePath);
+    }
+}
 
-    // 清理工作线程
-    if (m_workerThread) {
-        m_workerThread->quit();
-        if (!m_workerThread->wait(3000)) {
-            m_workerThread->terminate();
-            m_workerThread->wait(1000);
+void AsyncDocumentLoader::cancelDocument(const QString& filePath) {
+    {
+        QMutexLocker locker(&m_queueMutex);
+        m_documentQueue.removeAll(filePath);
+        if (m_priorityPath == filePath) {
+            m_priorityPath.clear();
         }
-        m_workerThread->deleteLater();
-        m_workerThread = nullptr;
     }
 
-    if (m_worker) {
-        m_worker->deleteLater();
-        m_worker = nullptr;
+    for (int i = 0; i < m_active.size(); ++i) {
+        if (m_active.at(i).filePath == filePath) {
+            ActiveLoad load = m_active.takeAt(i);
+            if (m_progressGeneration == load.generation) {
+                stopProgressSimulation();
+            }
+            abandonLoad(load);
+            emit loadingCancelled(filePath);
+            break;
+        }
     }
 
-    emit loadingCancelled(filePath);
+    pumpQueue();
+}
+
+void AsyncDocumentLoader::abandonLoad(const ActiveLoad& load) {
+    // 真正的取消：不等待Poppler解析结束。断开结果信号、让线程收到
+    // quit后自行清理；被放弃的解析在后台跑完并丢弃文档，不再像旧实现
+    // 那样wait(3000)+terminate()阻塞调用线程
+    if (load.worker) {
+        load.worker->requestCancel();
+        disconnect(load.worker, nullptr, this, nullptr);
+        connect(load.thread, &QThread::finished, load.worker,
+                &QObject::deleteLater);
+    }
+    if (load.thread) {
+        connect(load.thread, &QThread::finished, load.thread,
+                &QObject::deleteLater);
+        load.thread->quit();
+    }
+}
+
+void AsyncDocumentLoader::preemptOneActiveLoad() {
+    QString priorityPath;
+    {
+        QMutexLocker locker(&m_queueMutex);
+        priorityPath = m_priorityPath;
+    }
+
+    // 最近启动的加载进度损失最小
+    for (int i = m_active.size() - 1; i >= 0; --i) {
+        if (m_active.at(i).filePath == priorityPath) {
+            continue;
+        }
+        ActiveLoad load = m_active.takeAt(i);
+        if (m_progressGeneration == load.generation) {
+            stopProgressSimulation();
+        }
+        {
+            QMutexLocker locker(&m_queueMutex);
+            if (!m_documentQueue.contains(load.filePath)) {
+                // 紧跟在聚焦文档之后重新排队
+                m_documentQueue.insert(
+                    qMin(1, static_cast<int>(m_documentQueue.size())),
+                    load.filePath);
+            }
+        }
+        abandonLoad(load);
+        return;
+    }
 }
 
 AsyncDocumentLoader::LoadingState AsyncDocumentLoader::currentState() const {
@@ -152,18 +183,22 @@ QString AsyncDocumentLoader::currentFilePath() const {
 }
 
 void AsyncDocumentLoader::queueDocuments(const QStringList& filePaths) {
-    QMutexLocker locker(&m_queueMutex);
+    {
+        QMutexLocker locker(&m_queueMutex);
 
-    // 将文档添加到队列中
-    for (const QString& filePath : filePaths) {
-        if (!filePath.isEmpty() && QFile::exists(filePath) &&
-            !m_documentQueue.contains(filePath)) {
-            m_documentQueue.append(filePath);
+        // 将文档添加到队列中
+        for (const QString& filePath : filePaths) {
+            if (!filePath.isEmpty() && QFile::exists(filePath) &&
+                !m_documentQueue.contains(filePath)) {
+                m_documentQueue.append(filePath);
+            }
         }
+
+        qDebug() << "Added" << filePaths.size()
+                 << "documents to queue. Queue size:" << m_documentQueue.size();
     }
 
-    qDebug() << "Added" << filePaths.size()
-             << "documents to queue. Queue size:" << m_documentQueue.size();
+    pumpQueue();
 }
 
 int AsyncDocumentLoader::queueSize() const {
@@ -171,19 +206,196 @@ int AsyncDocumentLoader::queueSize() const {
     return m_documentQueue.size();
 }
 
-void AsyncDocumentLoader::processNextInQueue() {
-    QMutexLocker queueLocker(&m_queueMutex);
+int AsyncDocumentLoader::activeLoadCount() const { return m_active.size(); }
 
+void AsyncDocumentLoader::pumpQueue() {
+    // 按优先级填满空闲槽位
+    while (m_active.size() < MAX_CONCURRENT_LOADS) {
+        QString next;
+        {
+            QMutexLocker locker(&m_queueMutex);
+            int index = pickNextQueuedIndexLocked();
+            if (index < 0) {
+                return;  // 队列为空或只剩下需等待的大文件
+            }
+            next = m_documentQueue.takeAt(index);
+        }
+        startLoad(next);
+    }
+}
+
+int AsyncDocumentLoader::pickNextQueuedIndexLocked() const {
     if (m_documentQueue.isEmpty()) {
-        return;  // 队列为空，无需处理
+        return -1;
     }
 
-    QString nextFilePath = m_documentQueue.takeFirst();
-    queueLocker.unlock();
+    // 聚焦文档无条件优先
+    if (!m_priorityPath.isEmpty()) {
+        int index = m_documentQueue.indexOf(m_priorityPath);
+        if (index >= 0) {
+            return index;
+        }
+    }
 
-    // 加载下一个文档
-    qDebug() << "Loading next document from queue:" << nextFilePath;
-    loadDocument(nextFilePath);
+    // 其余按文件大小从小到大调度；已有大文件在解析时跳过其它大文件，
+    // 小文档不必排在数GB的扫描件后面
+    const bool largeBusy = hasLargeActiveLoad();
+    int bestIndex = -1;
+    qint64 bestSize = -1;
+    for (int i = 0; i < m_documentQueue.size(); ++i) {
+        qint64 size = QFileInfo(m_documentQueue.at(i)).size();
+        if (largeBusy && size >= LARGE_FILE_THRESHOLD) {
+            continue;
+        }
+        if (bestIndex < 0 || size < bestSize) {
+            bestIndex = i;
+            bestSize = size;
+        }
+    }
+    return bestIndex;
+}
+
+bool AsyncDocumentLoader::hasLargeActiveLoad() const {
+    for (const ActiveLoad& load : m_active) {
+        if (load.fileSize >= LARGE_FILE_THRESHOLD) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void AsyncDocumentLoader::startLoad(const QString& filePath) {
+    ActiveLoad load;
+    load.filePath = filePath;
+    load.fileSize = QFileInfo(filePath).size();
+    load.generation = ++m_nextGeneration;
+
+    // 线程不设父对象：被放弃的加载在loader析构后仍能自行清理
+    load.thread = new QThread();
+    load.worker = new AsyncDocumentLoaderWorker(filePath);
+    load.worker->moveToThread(load.thread);
+
+    const quint64 generation = load.generation;
+    connect(load.thread, &QThread::started, load.worker,
+            &AsyncDocumentLoaderWorker::doLoad);
+    connect(load.worker, &AsyncDocumentLoaderWorker::loadCompleted, this,
+            [this, generation](Poppler::Document* document) {
+                onLoadFinished(generation, document, QString());
+            });
+    connect(load.worker, &AsyncDocumentLoaderWorker::loadFailed, this,
+            [this, generation](const QString& error) {
+                onLoadFinished(generation, nullptr, error);
+            });
+    // 预取与解析合并为一条进度：预取按真实字节数走前半段，并不断
+    // 把模拟计时起点推后，预取结束后解析阶段由模拟进度接续后半段
+    connect(load.worker, &AsyncDocumentLoaderWorker::stagingProgress, this,
+            [this, generation, filePath](qint64 done, qint64 total) {
+                if (m_progressGeneration != generation || total <= 0) {
+                    return;
+                }
+                m_startTime = QDateTime::currentMSecsSinceEpoch();
+                const int progress = static_cast<int>((done * 50) / total);
+                if (progress > m_currentProgress) {
+                    m_currentProgress = progress;
+                    m_progressThrottle->post([this, progress, filePath]() {
+                        emit loadingProgressChanged(progress);
+                        emit loadingMessageChanged(
+                            QString("正在从共享预取 %1...")
+                                .arg(QFileInfo(filePath).fileName()));
+                    });
+                }
+            });
+
+    m_active.append(load);
+
+    {
+        QMutexLocker locker(&m_stateMutex);
+        m_state = LoadingState::Loading;
+        m_currentFilePath = filePath;
+    }
+
+    // 解析与全量哈希同时进行：Poppler顺序读文件时哈希分块跟在
+    // 后面读同样的页缓存，文档打开后内容哈希多半已就绪
+    DocumentHasher::instance().requestFullHash(filePath);
+
+    // 版本总线给本次加载盖内容版本戳，并开始监视文件的外部修改；
+    // 文档在磁盘上被替换时由总线统一广播失效
+    DocumentVersionBus::instance().stampLoad(filePath);
+
+    // 进度模拟跟踪最近启动的加载
+    m_expectedLoadTime = calculateExpectedLoadTime(load.fileSize);
+    m_progressGeneration = generation;
+    // 新一轮加载开始前丢弃上一轮可能还在排队的进度值
+    m_progressThrottle->cancel();
+    emit loadingMessageChanged(
+        QString("正在加载 %1...").arg(QFileInfo(filePath).fileName()));
+    emit loadingProgressChanged(0);
+    startProgressSimulation();
+
+    load.thread->start();
+}
+
+void AsyncDocumentLoader::onLoadFinished(quint64 generation,
+                                         Poppler::Document* document,
+                                         const QString& error) {
+    int index = -1;
+    for (int i = 0; i < m_active.size(); ++i) {
+        if (m_active.at(i).generation == generation) {
+            index = i;
+            break;
+        }
+    }
+
+    // 被抢占或取消后的迟到结果：丢弃文档即可
+    if (index < 0) {
+        delete document;
+        return;
+    }
+
+    ActiveLoad load = m_active.takeAt(index);
+
+    // 线程收尾不阻塞：quit后自行删除
+    connect(load.thread, &QThread::finished, load.worker,
+            &QObject::deleteLater);
+    connect(load.thread, &QThread::finished, load.thread,
+            &QObject::deleteLater);
+    load.thread->quit();
+
+    const bool ownsProgress = (m_progressGeneration == generation);
+    if (ownsProgress) {
+        stopProgressSimulation();
+    }
+
+    {
+        QMutexLocker locker(&m_stateMutex);
+        if (m_active.isEmpty()) {
+            m_state = document ? LoadingState::Completed : LoadingState::Failed;
+        }
+    }
+
+    {
+        QMutexLocker locker(&m_queueMutex);
+        if (m_priorityPath == load.filePath) {
+            m_priorityPath.clear();
+        }
+    }
+
+    if (document) {
+        if (ownsProgress) {
+            // 终值绕过节流立即送达，同时清掉可能排队的中间值
+            m_progressThrottle->post([this]() {
+                emit loadingProgressChanged(100);
+                emit loadingMessageChanged("加载完成");
+            });
+            m_progressThrottle->flush();
+        }
+        emit documentLoaded(document, load.filePath);
+    } else {
+        m_progressThrottle->cancel();
+        emit loadingFailed(error, load.filePath);
+    }
+
+    pumpQueue();
 }
 
 void AsyncDocumentLoader::onProgressTimerTimeout() {
@@ -214,9 +426,12 @@ void AsyncDocumentLoader::onProgressTimerTimeout() {
         newProgress = qMin(95, baseProgress + additionalProgress);
     }
 
-    if (newProgress != m_currentProgress) {
+    // 只增不减：预取阶段可能已把真实进度推到模拟值前面
+    if (newProgress > m_currentProgress) {
         m_currentProgress = newProgress;
-        emit loadingProgressChanged(m_currentProgress);
+        const int progress = m_currentProgress;
+        m_progressThrottle->post(
+            [this, progress]() { emit loadingProgressChanged(progress); });
     }
 }
 
@@ -228,13 +443,6 @@ void AsyncDocumentLoader::startProgressSimulation() {
 
 void AsyncDocumentLoader::stopProgressSimulation() { m_progressTimer->stop(); }
 
-void AsyncDocumentLoader::resetState() {
-    m_currentProgress = 0;
-    m_expectedLoadTime = 0;
-    m_startTime = 0;
-    m_currentFilePath.clear();
-}
-
 int AsyncDocumentLoader::calculateExpectedLoadTime(qint64 fileSize) const {
     if (fileSize < SIZE_THRESHOLD_FAST) {
         return MIN_LOAD_TIME;
@@ -288,6 +496,11 @@ AsyncDocumentLoaderWorker::AsyncDocumentLoaderWorker(const QString& filePath)
 
 AsyncDocumentLoaderWorker::~AsyncDocumentLoaderWorker() { cleanup(); }
 
+void AsyncDocumentLoaderWorker::requestCancel() {
+    QMutexLocker locker(&m_stateMutex);
+    m_cancelled = true;
+}
+
 void AsyncDocumentLoaderWorker::doLoad() {
     // Initialize loading state
     {
@@ -298,6 +511,18 @@ void AsyncDocumentLoaderWorker::doLoad() {
         m_loadingInProgress = true;
     }
 
+    // 隔离名单快速失败：上次超时或让进程崩溃的文档不再重付
+    // 多秒超时，直接以缓存的诊断失败。用户显式重试时由
+    // DocumentQuarantine::allowRetry解除
+    const QString diagnosis =
+        DocumentQuarantine::instance().diagnosisFor(m_filePath);
+    if (!diagnosis.isEmpty()) {
+        QMutexLocker locker(&m_stateMutex);
+        m_loadingInProgress = false;
+        emit loadFailed(QString("已知问题文档，跳过加载: %1").arg(diagnosis));
+        return;
+    }
+
     // Create timeout timer in worker thread (fixes thread affinity issue)
     if (!m_timeoutTimer) {
         m_timeoutTimer = new QTimer();  // No parent = current thread affinity
@@ -330,8 +555,27 @@ void AsyncDocumentLoaderWorker::doLoad() {
             }
         }
 
+        // 网络共享上的文件先顺序预取到本地暂存副本：大块顺序读
+        // 代替Poppler解析期的随机小读，之后解析与翻页都走本地盘。
+        // 预取失败（共享断开、本地盘满）时退回直接访问原路径
+        QString loadPath = m_filePath;
+        auto& stager = NetworkFileStager::instance();
+        if (stager.shouldStage(m_filePath)) {
+            loadPath = stager.stage(
+                m_filePath,
+                [this](qint64 done, qint64 total) {
+                    emit stagingProgress(done, total);
+                },
+                &m_cancelled);
+        }
+
+        // 崩溃哨兵：解析前先落盘尝试标记，干净结束时清除。下次
+        // 启动若发现残留标记，说明进程死在这次解析里，该文件随即
+        // 进入隔离名单
+        DocumentQuarantine::instance().beginAttempt(m_filePath);
+
         // 实际加载文档
-        auto document = Poppler::Document::load(m_filePath);
+        auto document = Poppler::Document::load(loadPath);
 
         // Check for cancellation after loading
         {
@@ -339,6 +583,8 @@ void AsyncDocumentLoaderWorker::doLoad() {
             if (m_cancelled) {
                 qDebug() << "AsyncDocumentLoaderWorker: Loading cancelled "
                             "after Poppler::Document::load()";
+                locker.unlock();
+                DocumentQuarantine::instance().endAttempt(m_filePath);
                 // Document will be automatically cleaned up when unique_ptr
                 // goes out of scope
                 return;  // Loading was cancelled during
@@ -346,6 +592,9 @@ void AsyncDocumentLoaderWorker::doLoad() {
             }
         }
 
+        // 解析返回即未崩溃；坏文档的其余失败都能即时诊断，无须隔离
+        DocumentQuarantine::instance().endAttempt(m_filePath);
+
         // Stop timeout timer - loading completed successfully
         if (m_timeoutTimer) {
             m_timeoutTimer->stop();
@@ -399,6 +648,7 @@ void AsyncDocumentLoaderWorker::doLoad() {
             m_timeoutTimer->stop();
         }
 
+        DocumentQuarantine::instance().endAttempt(m_filePath);
         QMutexLocker locker(&m_stateMutex);
         m_loadingInProgress = false;
         emit loadFailed(QString("加载异常: %1").arg(e.what()));
@@ -408,6 +658,7 @@ void AsyncDocumentLoaderWorker::doLoad() {
             m_timeoutTimer->stop();
         }
 
+        DocumentQuarantine::instance().endAttempt(m_filePath);
         QMutexLocker locker(&m_stateMutex);
         m_loadingInProgress = false;
         emit loadFailed("未知加载错误");
@@ -465,6 +716,11 @@ void AsyncDocumentLoaderWorker::onLoadTimeout() {
 
     qDebug() << "AsyncDocumentLoaderWorker: Emitting timeout error:"
              << timeoutMessage;
+
+    // 超时入隔离名单：下次打开同一文件（指纹不变）直接快速失败，
+    // 不再等这个超时
+    DocumentQuarantine::instance().recordDocumentFailure(m_filePath,
+                                                         timeoutMessage);
     emit loadFailed(timeoutMessage);
 
     // Perform cleanup - this is now thread-safe
@@ -12,16 +12,28 @@
 
 // 前向声明
 class AsyncDocumentLoaderWorker;
+class SignalThrottle;
 
 /**
  * 异步文档加载器
  * 在后台线程中加载PDF文档，避免阻塞UI线程
  * 提供加载进度回调和取消功能
  *
- * ARCHITECTURE: Uses a separate worker thread (AsyncDocumentLoaderWorker) to
- * perform the actual document loading via Poppler::Document::load(). The worker
- * is moved to a dedicated thread to prevent UI blocking. Timeout handling is
- * implemented with proper thread affinity to ensure reliable operation.
+ * ARCHITECTURE: Uses separate worker threads (AsyncDocumentLoaderWorker) to
+ * perform the actual document loading via Poppler::Document::load(). Each
+ * worker is moved to a dedicated thread to prevent UI blocking. Timeout
+ * handling is implemented with proper thread affinity to ensure reliable
+ * operation.
+ *
+ * SCHEDULING: The queue is a priority scheduler rather than FIFO. Up to
+ * MAX_CONCURRENT_LOADS documents load at once, but only one file at or
+ * above LARGE_FILE_THRESHOLD parses at a time so small PDFs never queue
+ * behind a multi-GB scan; remaining slots pick the smallest queued file
+ * first. loadDocument treats its path as focused: it jumps the queue
+ * and, when all slots are busy, preempts the most recently started
+ * non-focused load (which goes back to the queue). Cancelled loads are
+ * abandoned without blocking: the worker thread is detached and cleans
+ * itself up when Poppler returns, instead of the old wait+terminate.
  *
  * THREAD SAFETY: The timeout timer is created in the worker thread context to
  * ensure Qt's thread affinity rules are respected, fixing previous freeze
@@ -42,24 +54,33 @@ public:
     explicit AsyncDocumentLoader(QObject* parent = nullptr);
     ~AsyncDocumentLoader();
 
-    // 开始异步加载文档
+    // 开始异步加载文档（按聚焦文档处理：抢占队列，必要时抢占加载槽位）
     void loadDocument(const QString& filePath);
 
     // 将多个文档加入加载队列
     void queueDocuments(const QStringList& filePaths);
 
-    // 取消当前加载
+    // 提升某个排队文档的优先级（如用户点击了它的标签页）
+    void prioritizeDocument(const QString& filePath);
+
+    // 取消所有加载（排队的和进行中的）
     void cancelLoading();
 
+    // 取消单个文档的加载
+    void cancelDocument(const QString& filePath);
+
     // 获取当前状态
     LoadingState currentState() const;
 
-    // 获取当前加载的文件路径
+    // 获取最近启动加载的文件路径
     QString currentFilePath() const;
 
     // 获取队列中剩余文档数量
     int queueSize() const;
 
+    // 获取正在加载的文档数量
+    int activeLoadCount() const;
+
     // 配置超时设置
     void setTimeoutConfiguration(int defaultTimeoutMs, int minTimeoutMs,
                                  int maxTimeoutMs);
@@ -85,10 +106,25 @@ private slots:
     void onProgressTimerTimeout();
 
 private:
+    // 一次进行中的加载占用的槽位
+    struct ActiveLoad {
+        QString filePath;
+        QThread* thread = nullptr;
+        AsyncDocumentLoaderWorker* worker = nullptr;
+        qint64 fileSize = 0;
+        quint64 generation = 0;
+    };
+
     void startProgressSimulation();
     void stopProgressSimulation();
-    void resetState();
-    void processNextInQueue();
+    void pumpQueue();
+    void startLoad(const QString& filePath);
+    void onLoadFinished(quint64 generation, Poppler::Document* document,
+                        const QString& error);
+    void abandonLoad(const ActiveLoad& load);
+    void preemptOneActiveLoad();
+    int pickNextQueuedIndexLocked() const;  // 需持有m_queueMutex
+    bool hasLargeActiveLoad() const;
     int calculateExpectedLoadTime(qint64 fileSize) const;
 
     // 状态管理
@@ -96,19 +132,22 @@ private:
     QString m_currentFilePath;
     mutable QMutex m_stateMutex;
 
-    // 文档加载队列
+    // 文档加载队列与聚焦文档
     QStringList m_documentQueue;
+    QString m_priorityPath;
     mutable QMutex m_queueMutex;
 
-    // 进度模拟
+    // 进度模拟（跟踪最近启动的那次加载）
     QTimer* m_progressTimer;
+    SignalThrottle* m_progressThrottle;  // 高频进度的合并中继
     int m_currentProgress;
     int m_expectedLoadTime;  // 预期加载时间(ms)
     qint64 m_startTime;      // 开始加载时间
+    quint64 m_progressGeneration;
 
-    // 工作线程
-    QThread* m_workerThread;
-    AsyncDocumentLoaderWorker* m_worker;
+    // 加载槽位
+    QList<ActiveLoad> m_active;
+    quint64 m_nextGeneration;
 
     // 超时配置
     int m_configuredDefaultTimeout;
@@ -124,6 +163,9 @@ private:
         1024 * 1024;  // 1MB以下快速加载
     static constexpr qint64 SIZE_THRESHOLD_MEDIUM =
         10 * 1024 * 1024;  // 10MB以下中等加载
+    static constexpr int MAX_CONCURRENT_LOADS = 3;  // 并发加载槽位数
+    static constexpr qint64 LARGE_FILE_THRESHOLD =
+        SIZE_THRESHOLD_MEDIUM;  // 大文件同一时间只解析一个
 };
 
 /**
@@ -143,6 +185,10 @@ public:
     AsyncDocumentLoaderWorker(const QString& filePath);
     ~AsyncDocumentLoaderWorker();
 
+    // Thread-safe cancellation request; the load is abandoned at the
+    // next cancellation checkpoint and its document discarded
+    void requestCancel();
+
 public slots:
     void doLoad();
     void retryLoad(int extendedTimeoutMs = 0);
@@ -150,6 +196,8 @@ public slots:
 signals:
     void loadCompleted(Poppler::Document* document);
     void loadFailed(const QString& error);
+    // 网络共享文件预取到本地暂存的进度（字节）
+    void stagingProgress(qint64 bytesDone, qint64 bytesTotal);
 
 private slots:
     void onLoadTimeout();
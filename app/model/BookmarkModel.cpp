@@ -2,7 +2,11 @@
 #include <QDebug>
 #include <QFileInfo>
 #include <QJsonParseError>
+#include <QMutexLocker>
+#include <QPointer>
+#include <QSet>
 #include <algorithm>
+#include "managers/RenderScheduler.h"
 
 // Bookmark serialization implementation
 QJsonObject Bookmark::toJson() const {
@@ -52,8 +56,25 @@ Bookmark Bookmark::fromJson(const QJsonObject& json) {
 }
 
 BookmarkModel::BookmarkModel(QObject* parent)
-    : QAbstractItemModel(parent), m_autoSave(true) {
+    : QAbstractItemModel(parent),
+      m_autoSave(true),
+      m_journalOps(0),
+      m_flushTimer(new QTimer(this)) {
     initializeStorage();
+
+    m_flushTimer->setSingleShot(true);
+    m_flushTimer->setInterval(FLUSH_INTERVAL_MS);
+    // Journal I/O happens on the pool, never on the GUI thread
+    connect(m_flushTimer, &QTimer::timeout, this, [this]() {
+        QPointer<BookmarkModel> self(this);
+        RenderScheduler::instance().submit(
+            RenderScheduler::TaskClass::Background, [self]() {
+                if (self) {
+                    self->flushJournal();
+                }
+            });
+    });
+
     loadFromFile();
 
     // Connect to auto-save on data changes
@@ -65,6 +86,11 @@ BookmarkModel::BookmarkModel(QObject* parent)
             &BookmarkModel::onDataChanged);
 }
 
+BookmarkModel::~BookmarkModel() {
+    m_flushTimer->stop();
+    flushJournal();
+}
+
 QModelIndex BookmarkModel::index(int row, int column,
                                  const QModelIndex& parent) const {
     if (!hasIndex(row, column, parent) || parent.isValid()) {
@@ -195,6 +221,10 @@ bool BookmarkModel::setData(const QModelIndex& index, const QVariant& value,
     }
 
     if (changed) {
+        QJsonObject op;
+        op["op"] = "update";
+        op["bookmark"] = bookmark.toJson();
+        recordOp(op);
         emit dataChanged(index, index, {role});
         emit bookmarkUpdated(bookmark);
         return true;
@@ -238,11 +268,54 @@ bool BookmarkModel::addBookmark(const Bookmark& bookmark) {
     endInsertRows();
 
     sortBookmarks();
+
+    QJsonObject op;
+    op["op"] = "add";
+    op["bookmark"] = bookmark.toJson();
+    recordOp(op);
+
     emit bookmarkAdded(bookmark);
 
     return true;
 }
 
+int BookmarkModel::addBookmarksBatch(const QList<Bookmark>& bookmarks) {
+    // Filter against the page index and the batch itself before
+    // touching the model, so the row insert is one contiguous range
+    QList<Bookmark> accepted;
+    QSet<QString> seen;
+    for (const Bookmark& bookmark : bookmarks) {
+        const QString pageKey = bookmark.documentPath + QChar(0x1f) +
+                                QString::number(bookmark.pageNumber);
+        if (hasBookmarkForPage(bookmark.documentPath, bookmark.pageNumber) ||
+            seen.contains(pageKey)) {
+            continue;
+        }
+        seen.insert(pageKey);
+        accepted.append(bookmark);
+    }
+    if (accepted.isEmpty()) {
+        return 0;
+    }
+
+    const int first = m_bookmarks.size();
+    beginInsertRows(QModelIndex(), first, first + accepted.size() - 1);
+    m_bookmarks.append(accepted);
+    endInsertRows();
+
+    sortBookmarks();
+
+    for (const Bookmark& bookmark : accepted) {
+        QJsonObject op;
+        op["op"] = "add";
+        op["bookmark"] = bookmark.toJson();
+        recordOp(op);
+    }
+
+    emit bookmarksLoaded(accepted.size());
+    return accepted.size();
+}
+
 bool BookmarkModel::removeBookmark(const QString& bookmarkId) {
     int index = findBookmarkIndex(bookmarkId);
     if (index < 0) {
@@ -253,6 +326,13 @@ bool BookmarkModel::removeBookmark(const QString& bookmarkId) {
     m_bookmarks.removeAt(index);
     endRemoveRows();
 
+    rebuildIndexes();
+
+    QJsonObject op;
+    op["op"] = "remove";
+    op["id"] = bookmarkId;
+    recordOp(op);
+
     emit bookmarkRemoved(bookmarkId);
     return true;
 }
@@ -265,6 +345,13 @@ bool BookmarkModel::updateBookmark(const QString& bookmarkId,
     }
 
     m_bookmarks[index] = updatedBookmark;
+    rebuildIndexes();  // Document or page may have changed
+
+    QJsonObject op;
+    op["op"] = "update";
+    op["bookmark"] = updatedBookmark.toJson();
+    recordOp(op);
+
     QModelIndex modelIndex = this->index(index, 0);
     emit dataChanged(modelIndex, this->index(index, columnCount() - 1));
     emit bookmarkUpdated(updatedBookmark);
@@ -285,31 +372,29 @@ QList<Bookmark> BookmarkModel::getAllBookmarks() const { return m_bookmarks; }
 QList<Bookmark> BookmarkModel::getBookmarksForDocument(
     const QString& documentPath) const {
     QList<Bookmark> result;
-    for (const Bookmark& bookmark : m_bookmarks) {
-        if (bookmark.documentPath == documentPath) {
-            result.append(bookmark);
+    const QMap<int, QString> pages = m_pageIndex.value(documentPath);
+    for (auto it = pages.constBegin(); it != pages.constEnd(); ++it) {
+        int row = m_rowById.value(it.value(), -1);
+        if (row >= 0) {
+            result.append(m_bookmarks.at(row));
         }
     }
-    return result;
+    return result;  // Page order, courtesy of the index
 }
 
 bool BookmarkModel::hasBookmarkForPage(const QString& documentPath,
                                        int pageNumber) const {
-    for (const Bookmark& bookmark : m_bookmarks) {
-        if (bookmark.documentPath == documentPath &&
-            bookmark.pageNumber == pageNumber) {
-            return true;
-        }
-    }
-    return false;
+    const auto docIt = m_pageIndex.constFind(documentPath);
+    return docIt != m_pageIndex.constEnd() && docIt->contains(pageNumber);
 }
 
 Bookmark BookmarkModel::getBookmarkForPage(const QString& documentPath,
                                            int pageNumber) const {
-    for (const Bookmark& bookmark : m_bookmarks) {
-        if (bookmark.documentPath == documentPath &&
-            bookmark.pageNumber == pageNumber) {
-            return bookmark;
+    const auto docIt = m_pageIndex.constFind(documentPath);
+    if (docIt != m_pageIndex.constEnd()) {
+        int row = m_rowById.value(docIt->value(pageNumber), -1);
+        if (row >= 0) {
+            return m_bookmarks.at(row);
         }
     }
     return Bookmark();
@@ -332,13 +417,14 @@ QString BookmarkModel::getStorageFilePath() const {
     return QDir(dataPath).filePath("bookmarks.json");
 }
 
+QString BookmarkModel::getJournalFilePath() const {
+    QString dataPath =
+        QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    return QDir(dataPath).filePath("bookmarks.journal");
+}
+
 int BookmarkModel::findBookmarkIndex(const QString& bookmarkId) const {
-    for (int i = 0; i < m_bookmarks.size(); ++i) {
-        if (m_bookmarks.at(i).id == bookmarkId) {
-            return i;
-        }
-    }
-    return -1;
+    return m_rowById.value(bookmarkId, -1);
 }
 
 void BookmarkModel::sortBookmarks() {
@@ -346,14 +432,110 @@ void BookmarkModel::sortBookmarks() {
               [](const Bookmark& a, const Bookmark& b) {
                   return a.lastAccessed > b.lastAccessed;  // Most recent first
               });
+    rebuildIndexes();
+}
+
+void BookmarkModel::rebuildIndexes() {
+    m_rowById.clear();
+    m_pageIndex.clear();
+    for (int i = 0; i < m_bookmarks.size(); ++i) {
+        const Bookmark& bookmark = m_bookmarks.at(i);
+        m_rowById.insert(bookmark.id, i);
+        m_pageIndex[bookmark.documentPath].insert(bookmark.pageNumber,
+                                                  bookmark.id);
+    }
 }
 
 void BookmarkModel::onDataChanged() {
+    // Mutations journal themselves; this just makes sure a flush is
+    // scheduled for anything that slipped through
+    if (m_autoSave) {
+        scheduleFlush();
+    }
+}
+
+void BookmarkModel::recordOp(const QJsonObject& op) {
+    {
+        QMutexLocker locker(&m_journalMutex);
+        if (op["op"].toString() == "remove") {
+            m_persistState.remove(op["id"].toString());
+        } else {
+            QJsonObject bookmarkJson = op["bookmark"].toObject();
+            m_persistState.insert(bookmarkJson["id"].toString(), bookmarkJson);
+        }
+        m_pendingOps.append(op);
+    }
     if (m_autoSave) {
-        saveToFile();
+        scheduleFlush();
+    }
+}
+
+void BookmarkModel::scheduleFlush() {
+    // Started, not restarted: a steady stream of edits still flushes
+    // every interval instead of being debounced forever
+    if (!m_flushTimer->isActive()) {
+        m_flushTimer->start();
     }
 }
 
+void BookmarkModel::flushJournal() {
+    QMutexLocker locker(&m_journalMutex);
+    if (m_pendingOps.isEmpty()) {
+        return;
+    }
+
+    QFile journal(getJournalFilePath());
+    if (!journal.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qWarning() << "Failed to append to bookmark journal:"
+                   << journal.fileName();
+        return;  // Ops stay pending; the next flush retries
+    }
+
+    for (const QJsonObject& op : std::as_const(m_pendingOps)) {
+        journal.write(QJsonDocument(op).toJson(QJsonDocument::Compact));
+        journal.write("\n");
+    }
+    journal.close();
+
+    m_journalOps += m_pendingOps.size();
+    m_pendingOps.clear();
+
+    if (m_journalOps >= COMPACT_THRESHOLD) {
+        compactLocked();
+    }
+
+    const int savedCount = m_persistState.size();
+    locker.unlock();
+    emit bookmarksSaved(savedCount);
+}
+
+bool BookmarkModel::compactLocked() {
+    QJsonArray bookmarksArray;
+    for (const QJsonObject& json : std::as_const(m_persistState)) {
+        bookmarksArray.append(json);
+    }
+
+    QJsonObject rootObject;
+    rootObject["version"] = "1.0";
+    rootObject["bookmarks"] = bookmarksArray;
+    rootObject["savedAt"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+
+    QFile file(m_storageFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to open bookmarks file for writing:"
+                   << m_storageFile;
+        return false;  // Keep the journal; replay still reconstructs
+    }
+    file.write(QJsonDocument(rootObject).toJson());
+    file.close();
+
+    // Snapshot first, journal removal second: a crash in between just
+    // replays ops that are already in the snapshot, which is idempotent
+    QFile::remove(getJournalFilePath());
+    m_journalOps = 0;
+    return true;
+}
+
 QStringList BookmarkModel::getCategories() const {
     QStringList categories;
     for (const Bookmark& bookmark : m_bookmarks) {
@@ -385,6 +567,12 @@ bool BookmarkModel::moveBookmarkToCategory(const QString& bookmarkId,
     }
 
     m_bookmarks[index].category = category;
+
+    QJsonObject op;
+    op["op"] = "update";
+    op["bookmark"] = m_bookmarks.at(index).toJson();
+    recordOp(op);
+
     QModelIndex modelIndex = this->index(index, 0);
     emit dataChanged(modelIndex, modelIndex, {CategoryRole});
     emit bookmarkUpdated(m_bookmarks[index]);
@@ -423,75 +611,98 @@ QList<Bookmark> BookmarkModel::getRecentBookmarks(int count) const {
 }
 
 bool BookmarkModel::saveToFile() {
-    QJsonArray bookmarksArray;
-    for (const Bookmark& bookmark : m_bookmarks) {
-        bookmarksArray.append(bookmark.toJson());
-    }
-
-    QJsonObject rootObject;
-    rootObject["version"] = "1.0";
-    rootObject["bookmarks"] = bookmarksArray;
-    rootObject["savedAt"] = QDateTime::currentDateTime().toString(Qt::ISODate);
-
-    QJsonDocument doc(rootObject);
+    QMutexLocker locker(&m_journalMutex);
 
-    QFile file(m_storageFile);
-    if (!file.open(QIODevice::WriteOnly)) {
-        qWarning() << "Failed to open bookmarks file for writing:"
-                   << m_storageFile;
+    // Pending ops are already reflected in m_persistState, so a full
+    // snapshot supersedes them
+    m_pendingOps.clear();
+    if (!compactLocked()) {
         return false;
     }
 
-    qint64 bytesWritten = file.write(doc.toJson());
-    file.close();
-
-    if (bytesWritten > 0) {
-        emit bookmarksSaved(m_bookmarks.size());
-        qDebug() << "Saved" << m_bookmarks.size() << "bookmarks to"
-                 << m_storageFile;
-        return true;
-    }
+    const int savedCount = m_persistState.size();
+    locker.unlock();
 
-    return false;
+    emit bookmarksSaved(savedCount);
+    qDebug() << "Saved" << savedCount << "bookmarks to" << m_storageFile;
+    return true;
 }
 
 bool BookmarkModel::loadFromFile() {
-    QFile file(m_storageFile);
-    if (!file.exists()) {
-        qDebug() << "Bookmarks file does not exist, starting with empty list";
-        return true;  // Not an error for first run
-    }
+    beginResetModel();
+    m_bookmarks.clear();
 
-    if (!file.open(QIODevice::ReadOnly)) {
-        qWarning() << "Failed to open bookmarks file for reading:"
-                   << m_storageFile;
-        return false;
-    }
+    {
+        QMutexLocker locker(&m_journalMutex);
+        m_persistState.clear();
+        m_pendingOps.clear();
+        m_journalOps = 0;
+
+        // Snapshot first
+        QFile file(m_storageFile);
+        if (file.exists()) {
+            if (!file.open(QIODevice::ReadOnly)) {
+                qWarning() << "Failed to open bookmarks file for reading:"
+                           << m_storageFile;
+                endResetModel();
+                return false;
+            }
 
-    QByteArray data = file.readAll();
-    file.close();
+            QJsonParseError parseError;
+            QJsonDocument doc =
+                QJsonDocument::fromJson(file.readAll(), &parseError);
+            file.close();
 
-    QJsonParseError parseError;
-    QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+            if (parseError.error != QJsonParseError::NoError) {
+                qWarning() << "Failed to parse bookmarks JSON:"
+                           << parseError.errorString();
+                endResetModel();
+                return false;
+            }
 
-    if (parseError.error != QJsonParseError::NoError) {
-        qWarning() << "Failed to parse bookmarks JSON:"
-                   << parseError.errorString();
-        return false;
-    }
+            const QJsonArray bookmarksArray =
+                doc.object()["bookmarks"].toArray();
+            for (const QJsonValue& value : bookmarksArray) {
+                QJsonObject json = value.toObject();
+                if (!json["id"].toString().isEmpty()) {
+                    m_persistState.insert(json["id"].toString(), json);
+                }
+            }
+        } else {
+            qDebug()
+                << "Bookmarks file does not exist, starting with empty list";
+        }
 
-    QJsonObject rootObject = doc.object();
-    QJsonArray bookmarksArray = rootObject["bookmarks"].toArray();
+        // Then replay whatever the last session journaled after its
+        // final compaction
+        QFile journal(getJournalFilePath());
+        if (journal.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            while (!journal.atEnd()) {
+                QJsonDocument opDoc = QJsonDocument::fromJson(journal.readLine());
+                if (!opDoc.isObject()) {
+                    continue;
+                }
+                QJsonObject op = opDoc.object();
+                if (op["op"].toString() == "remove") {
+                    m_persistState.remove(op["id"].toString());
+                } else {
+                    QJsonObject json = op["bookmark"].toObject();
+                    if (!json["id"].toString().isEmpty()) {
+                        m_persistState.insert(json["id"].toString(), json);
+                    }
+                }
+                m_journalOps++;
+            }
+        }
 
-    beginResetModel();
-    m_bookmarks.clear();
+        for (const QJsonObject& json : std::as_const(m_persistState)) {
+            m_bookmarks.append(Bookmark::fromJson(json));
+        }
 
-    for (const QJsonValue& value : bookmarksArray) {
-        if (value.isObject()) {
-            Bookmark bookmark = Bookmark::fromJson(value.toObject());
-            if (!bookmark.id.isEmpty()) {
-                m_bookmarks.append(bookmark);
-            }
+        // A journal left long by the previous session compacts now so
+        // replay stays cheap
+        if (m_journalOps >= COMPACT_THRESHOLD) {
+            compactLocked();
         }
     }
 
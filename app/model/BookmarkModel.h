@@ -3,15 +3,19 @@
 #include <QAbstractItemModel>
 #include <QDateTime>
 #include <QDir>
+#include <QHash>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QList>
+#include <QMap>
+#include <QMutex>
 #include <QObject>
 #include <QRectF>
 #include <QSettings>
 #include <QStandardPaths>
 #include <QString>
+#include <QTimer>
 
 /**
  * Represents a single bookmark entry
@@ -60,7 +64,14 @@ struct Bookmark {
 };
 
 /**
- * Model for managing bookmarks with persistent storage
+ * Model for managing bookmarks with persistent storage.
+ *
+ * Lookups go through in-memory indexes (id hash, per-document
+ * page-ordered map) instead of scanning the list. Persistence is
+ * write-behind: mutations append to an in-memory journal, a coalescing
+ * timer flushes the batch to an on-disk journal from the shared pool,
+ * and the journal compacts into the full snapshot once it grows past a
+ * threshold — adding one bookmark no longer rewrites the whole store.
  */
 class BookmarkModel : public QAbstractItemModel {
     Q_OBJECT
@@ -79,7 +90,7 @@ public:
     };
 
     explicit BookmarkModel(QObject* parent = nullptr);
-    ~BookmarkModel() = default;
+    ~BookmarkModel() override;
 
     // QAbstractItemModel interface
     QModelIndex index(int row, int column,
@@ -98,6 +109,11 @@ public:
 
     // Bookmark operations
     bool addBookmark(const Bookmark& bookmark);
+    // Batched insert for streaming import: duplicates (same document and
+    // page) are skipped, rows are inserted as one range and the batch is
+    // announced with a single bookmarksLoaded signal. Returns the number
+    // inserted
+    int addBookmarksBatch(const QList<Bookmark>& bookmarks);
     bool removeBookmark(const QString& bookmarkId);
     bool updateBookmark(const QString& bookmarkId,
                         const Bookmark& updatedBookmark);
@@ -120,7 +136,8 @@ public:
     QList<Bookmark> searchBookmarks(const QString& query) const;
     QList<Bookmark> getRecentBookmarks(int count = 10) const;
 
-    // Persistence
+    // Persistence. saveToFile forces a synchronous snapshot compaction;
+    // routine saves happen in the background via the journal
     bool saveToFile();
     bool loadFromFile();
     void setAutoSave(bool enabled) { m_autoSave = enabled; }
@@ -139,10 +156,32 @@ private slots:
 private:
     void initializeStorage();
     QString getStorageFilePath() const;
+    QString getJournalFilePath() const;
     int findBookmarkIndex(const QString& bookmarkId) const;
     void sortBookmarks();
+    void rebuildIndexes();
+
+    // Write-behind persistence
+    void recordOp(const QJsonObject& op);
+    void scheduleFlush();
+    void flushJournal();  // Runs on a pool thread (or inline on shutdown)
+    bool compactLocked();
 
     QList<Bookmark> m_bookmarks;
     bool m_autoSave;
     QString m_storageFile;
+
+    // Lookup indexes over m_bookmarks; rebuilt whenever rows shift
+    QHash<QString, int> m_rowById;
+    QHash<QString, QMap<int, QString>> m_pageIndex;  // doc -> page -> id
+
+    // Journal state; shared with the pool flush, guarded by the mutex
+    QHash<QString, QJsonObject> m_persistState;  // id -> serialized bookmark
+    QList<QJsonObject> m_pendingOps;
+    int m_journalOps;  // Ops on disk since the last compaction
+    QTimer* m_flushTimer;
+    mutable QMutex m_journalMutex;
+
+    static const int FLUSH_INTERVAL_MS = 2000;
+    static const int COMPACT_THRESHOLD = 256;
 };
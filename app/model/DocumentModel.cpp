@@ -1,8 +1,46 @@
 #include "DocumentModel.h"
+#include <QElapsedTimer>
 #include <QFileInfo>
+#include "DocumentSnapshot.h"
 #include "RenderModel.h"
+#include "cache/DiskRenderCache.h"
+#include "cache/PDFCacheManager.h"
+#include "managers/MemoryGovernor.h"
+#include "managers/NetworkFileStager.h"
+#include "managers/RenderScheduler.h"
 #include "utils/LoggingMacros.h"
 
+namespace {
+// 非活动超过该时长的标签页释放Poppler句柄；内存压力下阈值不生效，
+// 所有非活动标签页立即休眠
+constexpr qint64 HIBERNATE_AFTER_MS = 5 * 60 * 1000;
+constexpr int HIBERNATE_SWEEP_INTERVAL_MS = 60 * 1000;
+
+// 与AsyncDocumentLoader同一套加载配置，保证休眠唤醒后的句柄与
+// 首次加载的渲染行为一致
+std::unique_ptr<Poppler::Document> loadDocumentHandle(const QString& filePath) {
+    QString loadPath = filePath;
+    auto& stager = NetworkFileStager::instance();
+    if (stager.shouldStage(filePath)) {
+        // 首次加载时的暂存副本通常还在，stage直接命中本地缓存
+        loadPath = stager.stage(filePath);
+    }
+
+    auto document = Poppler::Document::load(loadPath);
+    if (!document || document->isLocked() || document->numPages() <= 0) {
+        return nullptr;
+    }
+
+    document->setRenderHint(Poppler::Document::Antialiasing, true);
+    document->setRenderHint(Poppler::Document::TextAntialiasing, true);
+    document->setRenderHint(Poppler::Document::TextHinting, true);
+    document->setRenderHint(Poppler::Document::TextSlightHinting, true);
+    document->setRenderHint(Poppler::Document::ThinLineShape, true);
+    document->setRenderHint(Poppler::Document::OverprintPreview, true);
+    return document;
+}
+}  // namespace
+
 // 添加支持RenderModel的构造函数
 DocumentModel::DocumentModel(RenderModel* _renderModel)
     : renderModel(_renderModel), currentDocumentIndex(-1) {
@@ -19,6 +57,8 @@ DocumentModel::DocumentModel(RenderModel* _renderModel)
             &DocumentModel::loadingMessageChanged);
     connect(asyncLoader, &AsyncDocumentLoader::loadingFailed, this,
             &DocumentModel::loadingFailed);
+
+    setupHibernation();
 }
 
 DocumentModel::DocumentModel() : currentDocumentIndex(-1) {
@@ -34,6 +74,102 @@ DocumentModel::DocumentModel() : currentDocumentIndex(-1) {
             &DocumentModel::onDocumentLoaded);
     connect(asyncLoader, &AsyncDocumentLoader::loadingFailed, this,
             &DocumentModel::loadingFailed);
+
+    setupHibernation();
+}
+
+void DocumentModel::setupHibernation() {
+    hibernationTimer = new QTimer(this);
+    hibernationTimer->setInterval(HIBERNATE_SWEEP_INTERVAL_MS);
+    connect(hibernationTimer, &QTimer::timeout, this,
+            [this]() { sweepInactiveDocuments(false); });
+    hibernationTimer->start();
+
+    // 内存压力下不等阈值，立即归还所有非活动标签页的句柄
+    connect(&MemoryGovernor::instance(), &MemoryGovernor::memoryPressure, this,
+            [this](qint64, qint64) { sweepInactiveDocuments(true); });
+}
+
+void DocumentModel::sweepInactiveDocuments(bool aggressive) {
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (size_t i = 0; i < documents.size(); ++i) {
+        const int index = static_cast<int>(i);
+        if (index == currentDocumentIndex || !documents[i]->document) {
+            continue;
+        }
+        if (aggressive || now - documents[i]->lastActiveMs >= HIBERNATE_AFTER_MS) {
+            hibernateDocument(index);
+        }
+    }
+}
+
+void DocumentModel::syncSchedulerAccounts() {
+    // 休眠标签页没有句柄也就没有在途渲染，无需记账
+    for (size_t i = 0; i < documents.size(); ++i) {
+        if (!documents[i]->document) {
+            continue;
+        }
+        const quint64 key = static_cast<quint64>(
+            reinterpret_cast<quintptr>(documents[i]->document.get()));
+        const auto state = static_cast<int>(i) == currentDocumentIndex
+                               ? RenderScheduler::DocumentState::Focused
+                               : RenderScheduler::DocumentState::Background;
+        RenderScheduler::instance().setDocumentState(key, state,
+                                                     documents[i]->fileName);
+    }
+}
+
+bool DocumentModel::isHibernated(int index) const {
+    return isValidIndex(index) && !documents[index]->document;
+}
+
+bool DocumentModel::hibernateDocument(int index) {
+    if (!isValidIndex(index) || index == currentDocumentIndex ||
+        !documents[index]->document) {
+        return false;
+    }
+
+    // 先广播再释放：视图层必须趁句柄还有效时解绑，之后任何渲染、
+    // 搜索、缩略图路径都不得再持有它
+    emit documentHibernated(index);
+
+    RenderScheduler::instance().dropDocumentAccount(static_cast<quint64>(
+        reinterpret_cast<quintptr>(documents[index]->document.get())));
+    DocumentSnapshot::unregisterDocument(documents[index]->document.get());
+    documents[index]->document.reset();
+
+    LOG_INFO("Hibernated document handle: {}",
+             documents[index]->filePath.toStdString());
+    return true;
+}
+
+Poppler::Document* DocumentModel::wakeDocument(int index) {
+    if (!isValidIndex(index)) {
+        return nullptr;
+    }
+    if (documents[index]->document) {
+        return documents[index]->document.get();
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    auto document = loadDocumentHandle(documents[index]->filePath);
+    if (!document) {
+        LOG_WARNING("Failed to wake document: {}",
+                    documents[index]->filePath.toStdString());
+        return nullptr;
+    }
+
+    documents[index]->document = std::move(document);
+    documents[index]->lastActiveMs = QDateTime::currentMSecsSinceEpoch();
+    DocumentSnapshot::registerDocument(documents[index]->document.get(),
+                                       documents[index]->filePath);
+    syncSchedulerAccounts();
+
+    LOG_INFO("Woke document in {}ms: {}", timer.elapsed(),
+             documents[index]->filePath.toStdString());
+    emit documentWoken(index);
+    return documents[index]->document.get();
 }
 
 bool DocumentModel::openFromFile(const QString& filePath) {
@@ -43,6 +179,9 @@ bool DocumentModel::openFromFile(const QString& filePath) {
         return false;
     }
 
+    // 挂起的会话标签页在这里水合：移出挂起列表后照常异步加载
+    pendingRestorePaths.removeOne(filePath);
+
     // 检查文档是否已经打开
     for (size_t i = 0; i < documents.size(); ++i) {
         if (documents[i]->filePath == filePath) {
@@ -104,15 +243,14 @@ bool DocumentModel::openFromFiles(const QStringList& filePaths) {
     emit loadingStarted(firstFile);
     asyncLoader->loadDocument(firstFile);
 
-    // 如果有多个文档，暂时简化实现：逐个加载其他文档
+    // 其余文档交给加载器的调度队列，按优先级和文件大小并发加载
     if (newFilePaths.size() > 1) {
         QStringList remainingFiles = newFilePaths.mid(1);
         // 为每个文档发送加载开始信号，创建占位标签页
         for (const QString& filePath : remainingFiles) {
             emit loadingStarted(filePath);
         }
-        // 暂时简化：将其他文件路径存储起来，等第一个加载完成后再处理
-        pendingFiles = remainingFiles;
+        asyncLoader->queueDocuments(remainingFiles);
     }
 
     return true;
@@ -133,24 +271,18 @@ void DocumentModel::onDocumentLoaded(Poppler::Document* document,
         std::make_unique<DocumentInfo>(filePath, std::move(popplerDoc));
     documents.push_back(std::move(docInfo));
 
+    // 注册文档快照：渲染/搜索/缩略图工作线程由此获得各自的
+    // 线程私有Poppler句柄，不再争抢共享句柄上的互斥锁
+    DocumentSnapshot::registerDocument(documents.back()->document.get(),
+                                       filePath);
+
     int newIndex = static_cast<int>(documents.size() - 1);
     currentDocumentIndex = newIndex;
+    syncSchedulerAccounts();
 
     LOG_INFO("Async loaded successfully: {}", filePath.toStdString());
     emit documentOpened(newIndex, documents[newIndex]->fileName);
     emit currentDocumentChanged(newIndex);
-
-    // 检查是否还有待加载的文件
-    if (!pendingFiles.isEmpty()) {
-        QString nextFile = pendingFiles.takeFirst();
-        LOG_DEBUG("Loading next file from queue: {}", nextFile.toStdString());
-
-        // 发送加载开始信号
-        emit loadingStarted(nextFile);
-
-        // 开始加载下一个文档
-        asyncLoader->loadDocument(nextFile);
-    }
 }
 
 bool DocumentModel::closeDocument(int index) {
@@ -158,6 +290,15 @@ bool DocumentModel::closeDocument(int index) {
         return false;
     }
 
+    // 关闭前落盘首页预览：欢迎页的预览条直接mmap读取，无需重开文档
+    PDFCacheManager::shared().persistFirstPagePreview(
+        DiskRenderCache::hashForFile(documents[index]->filePath));
+
+    if (documents[index]->document) {
+        RenderScheduler::instance().dropDocumentAccount(static_cast<quint64>(
+            reinterpret_cast<quintptr>(documents[index]->document.get())));
+    }
+    DocumentSnapshot::unregisterDocument(documents[index]->document.get());
     documents.erase(documents.begin() + index);
     emit documentClosed(index);
 
@@ -169,6 +310,7 @@ bool DocumentModel::closeDocument(int index) {
         if (currentDocumentIndex >= static_cast<int>(documents.size())) {
             currentDocumentIndex = static_cast<int>(documents.size()) - 1;
         }
+        syncSchedulerAccounts();
         emit currentDocumentChanged(currentDocumentIndex);
     }
 
@@ -179,9 +321,56 @@ bool DocumentModel::closeCurrentDocument() {
     return closeDocument(currentDocumentIndex);
 }
 
+void DocumentModel::queuePendingRestore(const QStringList& filePaths) {
+    for (const QString& filePath : filePaths) {
+        if (filePath.isEmpty() || !QFile::exists(filePath)) {
+            continue;
+        }
+        if (isPendingRestore(filePath) || findDocumentIndex(filePath) >= 0) {
+            continue;
+        }
+        pendingRestorePaths.append(filePath);
+        // 只创建占位标签页，文档留到激活或空闲时再加载
+        emit restoreTabPending(filePath, QFileInfo(filePath).baseName());
+    }
+}
+
+bool DocumentModel::isPendingRestore(const QString& filePath) const {
+    return pendingRestorePaths.contains(filePath);
+}
+
+void DocumentModel::dropPendingRestore(const QString& filePath) {
+    pendingRestorePaths.removeOne(filePath);
+}
+
+QString DocumentModel::nextPendingRestore() const {
+    return pendingRestorePaths.isEmpty() ? QString()
+                                         : pendingRestorePaths.first();
+}
+
+int DocumentModel::pendingRestoreCount() const {
+    return static_cast<int>(pendingRestorePaths.size());
+}
+
+int DocumentModel::findDocumentIndex(const QString& filePath) const {
+    for (size_t i = 0; i < documents.size(); ++i) {
+        if (documents[i]->filePath == filePath) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
 void DocumentModel::switchToDocument(int index) {
     if (isValidIndex(index) && index != currentDocumentIndex) {
+        // 休眠的标签页先唤醒，视图在currentDocumentChanged时拿到的
+        // 就是有效句柄
+        if (!documents[index]->document) {
+            wakeDocument(index);
+        }
+        documents[index]->lastActiveMs = QDateTime::currentMSecsSinceEpoch();
         currentDocumentIndex = index;
+        syncSchedulerAccounts();
         emit currentDocumentChanged(index);
     }
 }
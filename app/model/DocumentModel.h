@@ -1,9 +1,12 @@
 #pragma once
 
 #include <poppler/qt6/poppler-qt6.h>
+#include <QDateTime>
 #include <QFileDialog>
 #include <QObject>
 #include <QString>
+#include <QStringList>
+#include <QTimer>
 #include <memory>
 #include <vector>
 #include "AsyncDocumentLoader.h"
@@ -17,9 +20,12 @@ struct DocumentInfo {
     QString filePath;
     QString fileName;
     std::unique_ptr<Poppler::Document> document;
+    qint64 lastActiveMs;  // 最近一次作为当前文档的时间戳
 
     DocumentInfo(const QString& path, std::unique_ptr<Poppler::Document> doc)
-        : filePath(path), document(std::move(doc)) {
+        : filePath(path),
+          document(std::move(doc)),
+          lastActiveMs(QDateTime::currentMSecsSinceEpoch()) {
         fileName = QFileInfo(path).baseName();
     }
 };
@@ -34,8 +40,18 @@ private:
     // 异步加载器
     AsyncDocumentLoader* asyncLoader;
 
-    // 多文档加载队列
-    QStringList pendingFiles;
+    // 会话恢复中尚未水合的文档路径（按标签页顺序）
+    QStringList pendingRestorePaths;
+
+    // 句柄休眠：定期扫描非活动标签页，超过阈值的释放其Poppler句柄
+    QTimer* hibernationTimer;
+
+    void setupHibernation();
+    void sweepInactiveDocuments(bool aggressive);
+
+    // 渲染池按文档记账做公平排队：当前文档记Focused、其余活句柄记
+    // Background，切换、打开、唤醒后都要同步一次
+    void syncSchedulerAccounts();
 
     // 从合并分支添加的成员
     QString currentFilePath;
@@ -57,7 +73,24 @@ public:
     bool closeCurrentDocument();
     void switchToDocument(int index);
 
+    // 会话恢复：挂起的文档只创建占位标签页，不加载Poppler文档，
+    // 首次激活或空闲时经openFromFile水合
+    // 句柄休眠：长时间未激活的标签页释放其Poppler句柄（解析状态、
+    // 字体与对象缓存随之归还），而文件路径、文字索引、缩略图等派生
+    // 缓存保留；切回该标签页时凭操作系统的文件缓存亚秒级重开。
+    // 内存压力下由MemoryGovernor触发立即休眠全部非活动标签页
+    bool isHibernated(int index) const;
+    bool hibernateDocument(int index);
+    Poppler::Document* wakeDocument(int index);
+
+    void queuePendingRestore(const QStringList& filePaths);
+    bool isPendingRestore(const QString& filePath) const;
+    void dropPendingRestore(const QString& filePath);
+    QString nextPendingRestore() const;
+    int pendingRestoreCount() const;
+
     // 查询方法
+    int findDocumentIndex(const QString& filePath) const;
     int getDocumentCount() const;
     int getCurrentDocumentIndex() const;
     QString getCurrentFilePath() const;
@@ -79,6 +112,13 @@ signals:
     void currentDocumentChanged(int index);
     void allDocumentsClosed();
 
+    // 会话恢复：为挂起的文档创建占位标签页
+    void restoreTabPending(const QString& filePath, const QString& fileName);
+
+    // 句柄休眠：视图层据此解绑/重绑旧句柄，休眠期间不得再触碰它
+    void documentHibernated(int index);
+    void documentWoken(int index);
+
     // 异步加载相关信号
     void loadingProgressChanged(int progress);
     void loadingMessageChanged(const QString& message);
@@ -0,0 +1,160 @@
+#include "DocumentSnapshot.h"
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QObject>
+#include <atomic>
+#include "managers/MemoryGovernor.h"
+#include "utils/LoggingMacros.h"
+
+namespace {
+QMutex g_registryMutex;
+
+// Bumped by releasePooledPages(); each thread's pool compares against it
+// on the next lease and flushes lazily when it is behind
+std::atomic<quint64> g_poolGeneration{1};
+
+QHash<const Poppler::Document*, std::shared_ptr<DocumentSnapshot>>&
+registry() {
+    static QHash<const Poppler::Document*, std::shared_ptr<DocumentSnapshot>>
+        snapshots;
+    return snapshots;
+}
+
+// Same hint set AsyncDocumentLoader applies to the primary handle, so
+// output from any clone is pixel-identical to the shared path
+void applyStandardRenderHints(Poppler::Document* document) {
+    document->setRenderHint(Poppler::Document::Antialiasing, true);
+    document->setRenderHint(Poppler::Document::TextAntialiasing, true);
+    document->setRenderHint(Poppler::Document::TextHinting, true);
+    document->setRenderHint(Poppler::Document::TextSlightHinting, true);
+    document->setRenderHint(Poppler::Document::ThinLineShape, true);
+    document->setRenderHint(Poppler::Document::OverprintPreview, true);
+}
+}  // namespace
+
+DocumentSnapshot::DocumentSnapshot(const QString& filePath, int pageCount)
+    : m_filePath(filePath), m_pageCount(pageCount) {}
+
+std::shared_ptr<DocumentSnapshot> DocumentSnapshot::registerDocument(
+    Poppler::Document* primary, const QString& filePath) {
+    if (!primary || filePath.isEmpty()) {
+        return nullptr;
+    }
+
+    QMutexLocker locker(&g_registryMutex);
+
+    // First registration wires the page pools to the governor so RSS
+    // spikes flush pooled page objects along with the pixel caches
+    static bool pressureHookInstalled = false;
+    if (!pressureHookInstalled) {
+        pressureHookInstalled = true;
+        QObject::connect(&MemoryGovernor::instance(),
+                         &MemoryGovernor::memoryPressure,
+                         [](qint64, qint64) {
+                             DocumentSnapshot::releasePooledPages();
+                         });
+    }
+
+    auto it = registry().constFind(primary);
+    if (it != registry().constEnd()) {
+        return *it;
+    }
+
+    // Cannot use make_shared: the constructor is private
+    std::shared_ptr<DocumentSnapshot> snapshot(
+        new DocumentSnapshot(filePath, primary->numPages()));
+    registry().insert(primary, snapshot);
+    LOG_DEBUG("DocumentSnapshot: registered {} ({} pages)",
+              filePath.toStdString(), snapshot->pageCount());
+    return snapshot;
+}
+
+std::shared_ptr<DocumentSnapshot> DocumentSnapshot::forDocument(
+    const Poppler::Document* primary) {
+    if (!primary) {
+        return nullptr;
+    }
+    QMutexLocker locker(&g_registryMutex);
+    return registry().value(primary);
+}
+
+void DocumentSnapshot::unregisterDocument(const Poppler::Document* primary) {
+    QMutexLocker locker(&g_registryMutex);
+    registry().remove(primary);
+}
+
+Poppler::Document* DocumentSnapshot::threadHandle() const {
+    if (m_handles.hasLocalData()) {
+        return m_handles.localData();
+    }
+
+    std::unique_ptr<Poppler::Document> handle =
+        Poppler::Document::load(m_filePath);
+    if (!handle || handle->isLocked()) {
+        LOG_WARNING("DocumentSnapshot: cannot reopen {} for thread-local use",
+                    m_filePath.toStdString());
+        return nullptr;
+    }
+    applyStandardRenderHints(handle.get());
+
+    Poppler::Document* raw = handle.release();
+    m_handles.setLocalData(raw);
+    return raw;
+}
+
+std::unique_ptr<Poppler::Page> DocumentSnapshot::page(int index) const {
+    if (index < 0 || index >= m_pageCount) {
+        return nullptr;
+    }
+    Poppler::Document* handle = threadHandle();
+    if (!handle) {
+        return nullptr;
+    }
+    return std::unique_ptr<Poppler::Page>(handle->page(index));
+}
+
+DocumentSnapshot::PageLease DocumentSnapshot::leasePage(int index) const {
+    if (index < 0 || index >= m_pageCount) {
+        return PageLease();
+    }
+
+    if (!m_pagePools.hasLocalData()) {
+        m_pagePools.setLocalData(new PagePool);
+    }
+    PagePool* pool = m_pagePools.localData();
+
+    const quint64 generation = g_poolGeneration.load(std::memory_order_acquire);
+    if (pool->generation != generation) {
+        pool->pages.clear();
+        pool->leaseOrder.clear();
+        pool->generation = generation;
+    }
+
+    auto it = pool->pages.constFind(index);
+    if (it != pool->pages.constEnd()) {
+        pool->leaseOrder.removeOne(index);
+        pool->leaseOrder.append(index);
+        return PageLease(*it);
+    }
+
+    Poppler::Document* handle = threadHandle();
+    if (!handle) {
+        return PageLease();
+    }
+    std::shared_ptr<Poppler::Page> page(handle->page(index));
+    if (!page) {
+        return PageLease();
+    }
+
+    pool->pages.insert(index, page);
+    pool->leaseOrder.append(index);
+    while (pool->leaseOrder.size() > MAX_POOLED_PAGES) {
+        pool->pages.remove(pool->leaseOrder.takeFirst());
+    }
+    return PageLease(std::move(page));
+}
+
+void DocumentSnapshot::releasePooledPages() {
+    g_poolGeneration.fetch_add(1, std::memory_order_release);
+}
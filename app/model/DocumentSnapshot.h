@@ -0,0 +1,116 @@
+#pragma once
+
+#include <poppler/qt6/poppler-qt6.h>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QThreadStorage>
+#include <memory>
+
+/**
+ * Per-thread Poppler handle pool for one open document.
+ *
+ * The loader hands out a single Poppler::Document* that render, search
+ * and thumbnail threads all touch, so every consumer wraps page access
+ * in its own coarse mutex and the workers serialize on the shared
+ * handle. Poppler happily opens multiple independent handles on one
+ * file, and pages from different handles can be used concurrently
+ * without any locking.
+ *
+ * A DocumentSnapshot exploits that: it remembers the file behind a
+ * loaded document and lazily opens a private clone per worker thread
+ * (QThreadStorage owns the clone and closes it when the thread exits).
+ * Workers call threadHandle()/page() and operate lock-free on their
+ * own handle; the shared primary handle stays untouched.
+ *
+ * Lifecycle: DocumentModel registers the primary handle when a load
+ * lands and unregisters it on close. Consumers that only hold the raw
+ * Poppler::Document* resolve their snapshot via forDocument() and fall
+ * back to the shared handle when no snapshot exists (e.g. documents
+ * opened outside DocumentModel).
+ */
+class DocumentSnapshot {
+public:
+    /**
+     * RAII lease on a pooled page object.
+     *
+     * Poppler::Page construction walks the document's page tree and is
+     * measurable on per-page-heavy workloads (search, export, thumbnail
+     * sweeps) that used to rebuild the same page on every call. Leased
+     * pages live in a per-thread pool inside the snapshot, so they are
+     * built once per thread and reused; the lease's shared_ptr keeps a
+     * page alive even if the pool evicts or flushes it mid-use.
+     */
+    class PageLease {
+    public:
+        PageLease() = default;
+
+        Poppler::Page* get() const { return m_page.get(); }
+        Poppler::Page* operator->() const { return m_page.get(); }
+        explicit operator bool() const { return m_page != nullptr; }
+
+    private:
+        friend class DocumentSnapshot;
+        explicit PageLease(std::shared_ptr<Poppler::Page> page)
+            : m_page(std::move(page)) {}
+
+        std::shared_ptr<Poppler::Page> m_page;
+    };
+
+    // Registers the primary handle; returns the (possibly existing)
+    // snapshot for it. Thread-safe.
+    static std::shared_ptr<DocumentSnapshot> registerDocument(
+        Poppler::Document* primary, const QString& filePath);
+
+    // Snapshot for a registered primary handle, or null.
+    static std::shared_ptr<DocumentSnapshot> forDocument(
+        const Poppler::Document* primary);
+
+    static void unregisterDocument(const Poppler::Document* primary);
+
+    const QString& filePath() const { return m_filePath; }
+    int pageCount() const { return m_pageCount; }
+
+    // The calling thread's private handle, opened on first use with the
+    // same render hints the loader applies to the primary. Returns
+    // nullptr if the file cannot be reopened (moved or deleted since
+    // load) — callers then fall back to the shared handle.
+    Poppler::Document* threadHandle() const;
+
+    // Page from the calling thread's handle; null on failure. Each call
+    // constructs a fresh page — prefer leasePage() on hot paths.
+    std::unique_ptr<Poppler::Page> page(int index) const;
+
+    // Pooled page from the calling thread's handle, constructed on first
+    // use and reused by later leases on the same thread. Empty lease on
+    // failure — callers fall back to page() or the shared handle.
+    PageLease leasePage(int index) const;
+
+    // Memory-pressure hook (wired to MemoryGovernor::memoryPressure):
+    // flushes every snapshot's pools. Threads cannot safely reach into
+    // each other's pools, so this bumps a generation counter and each
+    // thread drops its pages on its next lease; outstanding leases stay
+    // valid through their shared_ptr.
+    static void releasePooledPages();
+
+private:
+    DocumentSnapshot(const QString& filePath, int pageCount);
+
+    // Per-thread page pool; LRU-capped so a full-document sweep does not
+    // pin one page object per page of a 2000-page file.
+    struct PagePool {
+        quint64 generation = 0;
+        QHash<int, std::shared_ptr<Poppler::Page>> pages;
+        QList<int> leaseOrder;  // Least recently leased first
+    };
+
+    QString m_filePath;
+    int m_pageCount;
+
+    // One clone per (snapshot, thread); QThreadStorage deletes the
+    // handle when its thread finishes.
+    mutable QThreadStorage<Poppler::Document*> m_handles;
+    mutable QThreadStorage<PagePool*> m_pagePools;
+
+    static constexpr int MAX_POOLED_PAGES = 64;
+};
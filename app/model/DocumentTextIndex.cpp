@@ -0,0 +1,612 @@
+#include "DocumentTextIndex.h"
+#include <QDir>
+#include <QFile>
+#include <QMutexLocker>
+#include <QPointer>
+#include <QRectF>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <cstring>
+#include "PageLinkLayer.h"
+#include "PageTextLayer.h"
+#include "cache/PDFCacheManager.h"
+#include "managers/RenderScheduler.h"
+#include "utils/LoggingMacros.h"
+#include "utils/MemoryTracker.h"
+
+namespace {
+// All indexes report under one attribution key; the text of every open
+// document is a single line in the DebugLogPanel breakdown
+const char* const MEMORY_SUBSYSTEM = "text-index";
+
+// On-disk index format: a header, an absolute-offset table (one qint64
+// per page), then the page blobs. Offsets instead of pointers keep the
+// file position-independent, so restore can read straight out of a
+// QFile::map view without relocation. Vectors are written as raw
+// little-copy memory — the file is a local cache regenerated from the
+// PDF at any time, so like DiskRenderCache it assumes the writing and
+// reading build agree on qreal/QRectF layout.
+constexpr quint32 INDEX_MAGIC = 0x58444954;  // 'T','I','D','X'
+constexpr quint32 INDEX_VERSION = 1;
+
+struct IndexFileHeader {
+    quint32 magic;
+    quint32 version;
+    qint32 pageCount;
+    qint32 reserved;
+};
+
+struct PageBlobHeader {
+    qint32 textLength;  // UTF-16 code units
+    qint32 wordCount;   // Entries in the word-offset table
+    qint32 layerWords;  // 0 = page has no PageTextLayer
+    qint32 linkCount;   // 0 = page has no PageLinkLayer
+    double pageWidth;   // Points; only meaningful when layerWords > 0
+    double pageHeight;
+};
+
+QString indexDir() {
+    static const QString dir =
+        QStandardPaths::writableLocation(QStandardPaths::CacheLocation) +
+        "/text-index";
+    return dir;
+}
+
+void appendRaw(QByteArray& out, const void* data, qsizetype bytes) {
+    out.append(static_cast<const char*>(data), bytes);
+}
+
+// Bounds-checked reader over a mapped file. memcpy keeps reads legal
+// regardless of how blob fields happen to be aligned in the file.
+struct MappedCursor {
+    const uchar* data;
+    qint64 size;
+    qint64 pos = 0;
+
+    bool read(void* out, qint64 bytes) {
+        if (bytes < 0 || pos > size - bytes) {
+            return false;
+        }
+        std::memcpy(out, data + pos, bytes);
+        pos += bytes;
+        return true;
+    }
+
+    bool seek(qint64 offset) {
+        if (offset < 0 || offset > size) {
+            return false;
+        }
+        pos = offset;
+        return true;
+    }
+};
+}  // namespace
+
+DocumentTextIndex::DocumentTextIndex(QObject* parent)
+    : QObject(parent),
+      m_indexedCount(0),
+      m_trackedBytes(0),
+      m_generation(0),
+      m_restoredFromDisk(false),
+      m_document(nullptr),
+      m_cacheManager(nullptr) {}
+
+DocumentTextIndex::~DocumentTextIndex() {
+    MemoryTracker::instance().release(MEMORY_SUBSYSTEM, m_trackedBytes);
+}
+
+void DocumentTextIndex::buildIndex(Poppler::Document* document) {
+    quint64 generation;
+    int pageCount;
+    {
+        QMutexLocker locker(&m_mutex);
+        m_generation++;
+        generation = m_generation;
+        m_document = document;
+        m_pages.clear();
+        m_indexedCount = 0;
+        m_restoredFromDisk = false;
+        MemoryTracker::instance().release(MEMORY_SUBSYSTEM, m_trackedBytes);
+        m_trackedBytes = 0;
+
+        if (!document) {
+            return;
+        }
+        pageCount = document->numPages();
+        m_pages.resize(pageCount);
+    }
+
+    LOG_DEBUG("DocumentTextIndex: Starting background extraction of {} pages",
+              pageCount);
+
+    // A single setup job first tries the persisted index (file I/O off
+    // the GUI thread); only on a miss does it fan out one extraction
+    // job per page, which keeps the work incremental — visible renders
+    // always preempt extraction on the shared pool
+    QPointer<DocumentTextIndex> self(this);
+    RenderScheduler::instance().submit(
+        RenderScheduler::TaskClass::Background,
+        [self, document, pageCount, generation]() {
+            if (!self) {
+                return;
+            }
+            if (self->tryRestoreFromDisk(document, generation)) {
+                return;
+            }
+            for (int i = 0; i < pageCount; ++i) {
+                RenderScheduler::instance().submit(
+                    RenderScheduler::TaskClass::Background,
+                    [self, document, i, generation]() {
+                        if (self) {
+                            self->indexPage(document, i, generation);
+                        }
+                    });
+            }
+        });
+}
+
+void DocumentTextIndex::indexPage(Poppler::Document* document, int pageNumber,
+                                  quint64 generation) {
+    {
+        QMutexLocker locker(&m_mutex);
+        if (generation != m_generation || document != m_document ||
+            pageNumber >= m_pages.size() || m_pages[pageNumber].indexed) {
+            return;
+        }
+    }
+
+    std::unique_ptr<Poppler::Page> page(document->page(pageNumber));
+    if (!page) {
+        storePageEntry(pageNumber, QString(), {}, nullptr, nullptr);
+        return;
+    }
+
+    // Link regions are extracted alongside the text layer; image-only
+    // pages can still carry links
+    std::shared_ptr<PageLinkLayer> links = PageLinkLayer::build(page.get());
+
+    // The word-box layer carries the page text too; pages without one
+    // (image-only scans) fall back to plain extraction
+    std::shared_ptr<PageTextLayer> layer = PageTextLayer::build(page.get());
+    if (layer) {
+        storePageEntry(pageNumber, layer->text(), layer->wordStarts(),
+                       std::move(layer), std::move(links));
+    } else {
+        // Raw content-stream order: the index only needs the words,
+        // not reading order, and skipping layout analysis roughly
+        // halves extraction cost
+        QString text = page->text(QRectF(), Poppler::Page::RawOrderLayout);
+        storePageEntry(pageNumber, text, computeWordOffsets(text), nullptr,
+                       std::move(links));
+    }
+}
+
+void DocumentTextIndex::prioritizePage(int pageNumber) {
+    Poppler::Document* document;
+    quint64 generation;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!m_document || pageNumber < 0 || pageNumber >= m_pages.size() ||
+            m_pages[pageNumber].indexed) {
+            return;
+        }
+        document = m_document;
+        generation = m_generation;
+    }
+
+    // Resubmitted at prerender priority so it runs ahead of the fanned
+    // out background jobs; indexPage rechecks the indexed flag, so the
+    // eventual background duplicate is a cheap no-op
+    QPointer<DocumentTextIndex> self(this);
+    RenderScheduler::instance().submit(
+        RenderScheduler::TaskClass::AdjacentPrerender,
+        [self, document, pageNumber, generation]() {
+            if (self) {
+                self->indexPage(document, pageNumber, generation);
+            }
+        });
+}
+
+void DocumentTextIndex::storePageText(int pageNumber, const QString& text) {
+    storePageEntry(pageNumber, text, computeWordOffsets(text), nullptr,
+                   nullptr);
+}
+
+void DocumentTextIndex::storePageEntry(int pageNumber, const QString& text,
+                                       QVector<int> wordOffsets,
+                                       std::shared_ptr<PageTextLayer> layer,
+                                       std::shared_ptr<PageLinkLayer> links) {
+    int indexed;
+    int total;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (pageNumber < 0 || pageNumber >= m_pages.size() ||
+            m_pages[pageNumber].indexed) {
+            return;
+        }
+        PageEntry& entry = m_pages[pageNumber];
+        entry.text = text;
+        entry.wordOffsets = std::move(wordOffsets);
+        entry.layer = std::move(layer);
+        entry.links = std::move(links);
+        entry.indexed = true;
+        m_indexedCount++;
+        indexed = m_indexedCount;
+        total = m_pages.size();
+
+        // Attribution: UTF-16 text plus the word-offset table. The
+        // text/link layers share most of this data, so the figure is a
+        // close lower bound rather than an exact heap count.
+        const qint64 entryBytes = qint64(entry.text.size()) * 2 +
+                                  qint64(entry.wordOffsets.size()) * 4;
+        m_trackedBytes += entryBytes;
+        MemoryTracker::instance().add(MEMORY_SUBSYSTEM, entryBytes);
+    }
+
+    if (m_cacheManager) {
+        m_cacheManager->cacheTextContent(pageNumber, text);
+    }
+
+    emit pageIndexed(pageNumber);
+    emit indexingProgress(indexed, total);
+    if (indexed == total) {
+        LOG_DEBUG("DocumentTextIndex: Extraction complete ({} pages)", total);
+        emit indexingFinished();
+        schedulePersist();
+    }
+}
+
+void DocumentTextIndex::clear() {
+    QMutexLocker locker(&m_mutex);
+    m_generation++;
+    m_document = nullptr;
+    m_pages.clear();
+    m_indexedCount = 0;
+    m_restoredFromDisk = false;
+    MemoryTracker::instance().release(MEMORY_SUBSYSTEM, m_trackedBytes);
+    m_trackedBytes = 0;
+}
+
+bool DocumentTextIndex::isPageIndexed(int pageNumber) const {
+    QMutexLocker locker(&m_mutex);
+    return pageNumber >= 0 && pageNumber < m_pages.size() &&
+           m_pages[pageNumber].indexed;
+}
+
+bool DocumentTextIndex::isComplete() const {
+    QMutexLocker locker(&m_mutex);
+    return !m_pages.isEmpty() && m_indexedCount == m_pages.size();
+}
+
+int DocumentTextIndex::indexedPageCount() const {
+    QMutexLocker locker(&m_mutex);
+    return m_indexedCount;
+}
+
+QString DocumentTextIndex::pageText(int pageNumber) const {
+    QMutexLocker locker(&m_mutex);
+    if (pageNumber < 0 || pageNumber >= m_pages.size() ||
+        !m_pages[pageNumber].indexed) {
+        return QString();
+    }
+    return m_pages[pageNumber].text;
+}
+
+QVector<int> DocumentTextIndex::wordOffsets(int pageNumber) const {
+    QMutexLocker locker(&m_mutex);
+    if (pageNumber < 0 || pageNumber >= m_pages.size() ||
+        !m_pages[pageNumber].indexed) {
+        return QVector<int>();
+    }
+    return m_pages[pageNumber].wordOffsets;
+}
+
+std::shared_ptr<PageTextLayer> DocumentTextIndex::textLayer(
+    int pageNumber) const {
+    QMutexLocker locker(&m_mutex);
+    if (pageNumber < 0 || pageNumber >= m_pages.size() ||
+        !m_pages[pageNumber].indexed) {
+        return nullptr;
+    }
+    return m_pages[pageNumber].layer;
+}
+
+std::shared_ptr<PageLinkLayer> DocumentTextIndex::linkLayer(
+    int pageNumber) const {
+    QMutexLocker locker(&m_mutex);
+    if (pageNumber < 0 || pageNumber >= m_pages.size() ||
+        !m_pages[pageNumber].indexed) {
+        return nullptr;
+    }
+    return m_pages[pageNumber].links;
+}
+
+void DocumentTextIndex::setCacheManager(PDFCacheManager* cacheManager) {
+    m_cacheManager = cacheManager;
+}
+
+QVector<int> DocumentTextIndex::computeWordOffsets(const QString& text) {
+    QVector<int> offsets;
+    bool inWord = false;
+    for (int i = 0; i < text.size(); ++i) {
+        bool isSpace = text.at(i).isSpace();
+        if (!isSpace && !inWord) {
+            offsets.append(i);
+        }
+        inWord = !isSpace;
+    }
+    return offsets;
+}
+
+QString DocumentTextIndex::indexFilePath(const QString& documentHash) {
+    return indexDir() + "/" + documentHash + ".tidx";
+}
+
+bool DocumentTextIndex::tryRestoreFromDisk(Poppler::Document* document,
+                                           quint64 generation) {
+    const QString hash = PDFCacheManager::namespaceForDocument(document);
+    if (hash.isEmpty()) {
+        return false;
+    }
+
+    QFile file(indexFilePath(hash));
+    if (!file.exists() || !file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const uchar* mapped = file.map(0, file.size());
+    if (!mapped) {
+        return false;
+    }
+    MappedCursor cursor{mapped, file.size()};
+
+    // Everything page-shaped is materialized before the index is
+    // touched, so a corrupt file leaves the in-memory state untouched
+    // and the normal extraction pass runs instead
+    struct RestoredPage {
+        QString text;
+        QVector<int> wordOffsets;
+        std::shared_ptr<PageTextLayer> layer;
+        std::shared_ptr<PageLinkLayer> links;
+    };
+    QVector<RestoredPage> restored;
+
+    bool valid = false;
+    do {
+        IndexFileHeader header;
+        if (!cursor.read(&header, sizeof(header))) {
+            break;
+        }
+        if (header.magic != INDEX_MAGIC || header.version != INDEX_VERSION ||
+            header.pageCount <= 0 ||
+            header.pageCount != document->numPages()) {
+            break;
+        }
+
+        QVector<qint64> offsets(header.pageCount);
+        if (!cursor.read(offsets.data(),
+                         qint64(header.pageCount) * sizeof(qint64))) {
+            break;
+        }
+
+        restored.resize(header.pageCount);
+        bool pagesValid = true;
+        for (int i = 0; i < header.pageCount; ++i) {
+            PageBlobHeader blob;
+            if (!cursor.seek(offsets[i]) ||
+                !cursor.read(&blob, sizeof(blob)) || blob.textLength < 0 ||
+                blob.wordCount < 0 || blob.layerWords < 0 ||
+                blob.linkCount < 0) {
+                pagesValid = false;
+                break;
+            }
+            RestoredPage& page = restored[i];
+
+            page.text.resize(blob.textLength);
+            page.wordOffsets.resize(blob.wordCount);
+            if (!cursor.read(page.text.data(),
+                             qint64(blob.textLength) * 2) ||
+                !cursor.read(page.wordOffsets.data(),
+                             qint64(blob.wordCount) * sizeof(int))) {
+                pagesValid = false;
+                break;
+            }
+
+            if (blob.layerWords > 0) {
+                QVector<int> lengths(blob.layerWords);
+                QVector<QRectF> boxes(blob.layerWords);
+                if (!cursor.read(lengths.data(),
+                                 qint64(blob.layerWords) * sizeof(int)) ||
+                    !cursor.read(boxes.data(),
+                                 qint64(blob.layerWords) * sizeof(QRectF))) {
+                    pagesValid = false;
+                    break;
+                }
+                page.layer = PageTextLayer::restore(
+                    page.text, page.wordOffsets, std::move(lengths),
+                    std::move(boxes),
+                    QSizeF(blob.pageWidth, blob.pageHeight));
+                if (!page.layer) {
+                    pagesValid = false;  // restore() rejected the vectors
+                    break;
+                }
+            }
+
+            if (blob.linkCount > 0) {
+                QVector<QRectF> boxes(blob.linkCount);
+                QVector<int> targets(blob.linkCount);
+                QVector<QString> urls(blob.linkCount);
+                if (!cursor.read(boxes.data(),
+                                 qint64(blob.linkCount) * sizeof(QRectF)) ||
+                    !cursor.read(targets.data(),
+                                 qint64(blob.linkCount) * sizeof(int))) {
+                    pagesValid = false;
+                    break;
+                }
+                for (int j = 0; j < blob.linkCount && pagesValid; ++j) {
+                    qint32 urlLength = -1;
+                    if (!cursor.read(&urlLength, sizeof(urlLength)) ||
+                        urlLength < 0) {
+                        pagesValid = false;
+                        break;
+                    }
+                    urls[j].resize(urlLength);
+                    if (!cursor.read(urls[j].data(), qint64(urlLength) * 2)) {
+                        pagesValid = false;
+                        break;
+                    }
+                }
+                if (!pagesValid) {
+                    break;
+                }
+                page.links = PageLinkLayer::restore(
+                    std::move(boxes), std::move(targets), std::move(urls));
+                if (!page.links) {
+                    pagesValid = false;
+                    break;
+                }
+            }
+        }
+        valid = pagesValid;
+    } while (false);
+
+    file.unmap(const_cast<uchar*>(mapped));
+    file.close();
+
+    if (!valid) {
+        LOG_WARNING(
+            "DocumentTextIndex: Discarding unreadable index file {}",
+            indexFilePath(hash).toStdString());
+        QFile::remove(indexFilePath(hash));
+        return false;
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        if (generation != m_generation || document != m_document) {
+            return true;  // Document changed meanwhile; nothing to extract
+        }
+        m_restoredFromDisk = true;
+    }
+
+    // Feed the normal store path so memory attribution, cache
+    // write-through and progress/finished signals behave exactly as
+    // they do for a fresh extraction
+    for (int i = 0; i < restored.size(); ++i) {
+        {
+            QMutexLocker locker(&m_mutex);
+            if (generation != m_generation) {
+                return true;
+            }
+        }
+        RestoredPage& page = restored[i];
+        storePageEntry(i, page.text, std::move(page.wordOffsets),
+                       std::move(page.layer), std::move(page.links));
+    }
+
+    LOG_INFO("DocumentTextIndex: Restored {} pages from persisted index",
+             restored.size());
+    return true;
+}
+
+void DocumentTextIndex::schedulePersist() {
+    Poppler::Document* document;
+    quint64 generation;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_restoredFromDisk || !m_document) {
+            return;
+        }
+        document = m_document;
+        generation = m_generation;
+    }
+
+    // namespaceForDocument hits the filesystem (hash memoization aside)
+    // and serialization walks every page, so both run off-thread
+    QPointer<DocumentTextIndex> self(this);
+    RenderScheduler::instance().submit(
+        RenderScheduler::TaskClass::Background,
+        [self, document, generation]() {
+            if (!self) {
+                return;
+            }
+            const QString hash =
+                PDFCacheManager::namespaceForDocument(document);
+            if (!hash.isEmpty()) {
+                self->persistToDisk(hash, generation);
+            }
+        });
+}
+
+void DocumentTextIndex::persistToDisk(const QString& documentHash,
+                                      quint64 generation) {
+    QVector<PageEntry> pages;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (generation != m_generation || m_restoredFromDisk ||
+            m_pages.isEmpty() || m_indexedCount != m_pages.size()) {
+            return;
+        }
+        pages = m_pages;  // Implicitly shared; entries are immutable
+    }
+
+    const int pageCount = pages.size();
+    QVector<qint64> offsets(pageCount);
+    QByteArray blobs;
+
+    for (int i = 0; i < pageCount; ++i) {
+        offsets[i] = qint64(sizeof(IndexFileHeader)) +
+                     qint64(pageCount) * sizeof(qint64) + blobs.size();
+        const PageEntry& entry = pages[i];
+
+        PageBlobHeader blob;
+        blob.textLength = entry.text.size();
+        blob.wordCount = entry.wordOffsets.size();
+        blob.layerWords = entry.layer ? entry.layer->wordCount() : 0;
+        blob.linkCount = entry.links ? entry.links->linkCount() : 0;
+        const QSizeF pageSize =
+            entry.layer ? entry.layer->pageSize() : QSizeF();
+        blob.pageWidth = pageSize.width();
+        blob.pageHeight = pageSize.height();
+        appendRaw(blobs, &blob, sizeof(blob));
+
+        appendRaw(blobs, entry.text.constData(),
+                  qint64(entry.text.size()) * 2);
+        appendRaw(blobs, entry.wordOffsets.constData(),
+                  qint64(entry.wordOffsets.size()) * sizeof(int));
+
+        if (entry.layer) {
+            appendRaw(blobs, entry.layer->wordLengths().constData(),
+                      qint64(blob.layerWords) * sizeof(int));
+            appendRaw(blobs, entry.layer->wordBoxes().constData(),
+                      qint64(blob.layerWords) * sizeof(QRectF));
+        }
+
+        if (entry.links) {
+            appendRaw(blobs, entry.links->linkBoxes().constData(),
+                      qint64(blob.linkCount) * sizeof(QRectF));
+            appendRaw(blobs, entry.links->targetPages().constData(),
+                      qint64(blob.linkCount) * sizeof(int));
+            for (const QString& url : entry.links->urls()) {
+                const qint32 urlLength = url.size();
+                appendRaw(blobs, &urlLength, sizeof(urlLength));
+                appendRaw(blobs, url.constData(), qint64(url.size()) * 2);
+            }
+        }
+    }
+
+    QDir().mkpath(indexDir());
+    QSaveFile file(indexFilePath(documentHash));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    const IndexFileHeader header = {INDEX_MAGIC, INDEX_VERSION, pageCount, 0};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(offsets.constData()),
+               qint64(pageCount) * sizeof(qint64));
+    file.write(blobs);
+    if (file.commit()) {
+        LOG_DEBUG("DocumentTextIndex: Persisted {} pages ({} bytes)",
+                  pageCount, sizeof(header) + offsets.size() * 8 +
+                                 size_t(blobs.size()));
+    }
+}
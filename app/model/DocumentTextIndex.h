@@ -0,0 +1,113 @@
+#pragma once
+
+#include <poppler-qt6.h>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <memory>
+
+class PDFCacheManager;
+class PageLinkLayer;
+class PageTextLayer;
+
+/**
+ * Per-document text index built incrementally in the background.
+ *
+ * After a document loads, page text (plus word start offsets and a
+ * PageTextLayer of word bounding boxes) is extracted once on the shared
+ * render pool. SearchModel then scans the in-memory index instead of
+ * re-running Poppler text extraction on every query, so repeat searches
+ * cost milliseconds instead of seconds, and highlight placement maps
+ * match offsets straight to boxes without further Poppler calls.
+ *
+ * The same background pass also extracts each page's link regions into
+ * a PageLinkLayer, so hover hit-testing and click navigation in the
+ * viewer never query Poppler on the event path.
+ *
+ * Completed indexes are serialized into the persistent cache keyed by
+ * the document content hash (offset-based binary layout, versioned,
+ * read back through QFile::map). Reopening a document restores the
+ * whole index without touching Poppler, so long manuals that cost tens
+ * of seconds of background extraction are searchable immediately.
+ */
+class DocumentTextIndex : public QObject {
+    Q_OBJECT
+
+public:
+    explicit DocumentTextIndex(QObject* parent = nullptr);
+    ~DocumentTextIndex() override;
+
+    // Starts incremental background extraction; any build in progress
+    // for a previous document is abandoned
+    void buildIndex(Poppler::Document* document);
+    void clear();
+
+    // Index access (thread-safe)
+    bool isPageIndexed(int pageNumber) const;
+    bool isComplete() const;
+    int indexedPageCount() const;
+    QString pageText(int pageNumber) const;
+    QVector<int> wordOffsets(int pageNumber) const;
+
+    // Word-box layer for the page (shared, immutable), or null if the
+    // page has no text layer or was only stored via storePageText
+    std::shared_ptr<PageTextLayer> textLayer(int pageNumber) const;
+
+    // Link-region layer for the page (shared, immutable), or null if
+    // the page has no navigable links or was only stored via
+    // storePageText
+    std::shared_ptr<PageLinkLayer> linkLayer(int pageNumber) const;
+
+    // Lets SearchModel feed text it had to extract itself (cold page hit
+    // before the background pass reached it)
+    void storePageText(int pageNumber, const QString& text);
+
+    // Jumps one page ahead of the background pass at prerender priority.
+    // Focus-driven consumers (the accessibility layer tracking the
+    // current page) use this so the text they are about to read is never
+    // extracted synchronously. No-op for indexed pages
+    void prioritizePage(int pageNumber);
+
+    // Optional write-through of page text into the cache layer
+    void setCacheManager(PDFCacheManager* cacheManager);
+
+signals:
+    void pageIndexed(int pageNumber);
+    void indexingProgress(int indexedPages, int totalPages);
+    void indexingFinished();
+
+private:
+    void indexPage(Poppler::Document* document, int pageNumber,
+                   quint64 generation);
+    static QVector<int> computeWordOffsets(const QString& text);
+
+    // Persistent index: restore on open (true = fully restored, no
+    // extraction needed), persist once extraction completes
+    bool tryRestoreFromDisk(Poppler::Document* document, quint64 generation);
+    void schedulePersist();
+    void persistToDisk(const QString& documentHash, quint64 generation);
+    static QString indexFilePath(const QString& documentHash);
+
+    void storePageEntry(int pageNumber, const QString& text,
+                        QVector<int> wordOffsets,
+                        std::shared_ptr<PageTextLayer> layer,
+                        std::shared_ptr<PageLinkLayer> links);
+
+    struct PageEntry {
+        QString text;
+        QVector<int> wordOffsets;
+        std::shared_ptr<PageTextLayer> layer;
+        std::shared_ptr<PageLinkLayer> links;
+        bool indexed = false;
+    };
+
+    mutable QMutex m_mutex;
+    QVector<PageEntry> m_pages;
+    int m_indexedCount;
+    qint64 m_trackedBytes;  // Bytes reported to the memory tracker
+    quint64 m_generation;  // Bumped per document; stale jobs bail out
+    bool m_restoredFromDisk;  // Suppresses re-persisting what we loaded
+    Poppler::Document* m_document;
+    PDFCacheManager* m_cacheManager;
+};
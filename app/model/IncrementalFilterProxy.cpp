@@ -0,0 +1,111 @@
+#include "IncrementalFilterProxy.h"
+
+IncrementalFilterProxy::IncrementalFilterProxy(QObject* parent)
+    : QSortFilterProxyModel(parent) {}
+
+void IncrementalFilterProxy::setFilterText(const QString& text) {
+    const QString query = text.toCaseFolded();
+    if (query == m_query) {
+        return;
+    }
+
+    const bool extends = !m_query.isEmpty() && query.startsWith(m_query);
+    if (extends && sourceModel()) {
+        // Snapshot the rows the current query accepts before
+        // re-filtering: nothing outside this set can match the longer
+        // query, so the coming pass rejects everything else in O(1)
+        QBitArray matches(sourceModel()->rowCount());
+        for (int proxyRow = 0; proxyRow < rowCount(); ++proxyRow) {
+            matches.setBit(mapToSource(index(proxyRow, 0)).row());
+        }
+        m_previousMatches = matches;
+    }
+    m_narrowing = extends;
+    m_query = query;
+    invalidateRowsFilter();
+}
+
+void IncrementalFilterProxy::setSourceModel(QAbstractItemModel* model) {
+    // Targeted disconnects: a blanket disconnect(this) would also cut
+    // the base class's internal source connections
+    for (const QMetaObject::Connection& connection : m_sourceConnections) {
+        disconnect(connection);
+    }
+    m_sourceConnections.clear();
+    dropCaches();
+
+    QSortFilterProxyModel::setSourceModel(model);
+    if (!model) {
+        return;
+    }
+    // Any structural or content change can shift row numbers or edit
+    // searchable text; dropping everything and rebuilding lazily is
+    // cheaper than tracking which rows moved where
+    const auto drop = [this]() { dropCaches(); };
+    m_sourceConnections.append(
+        connect(model, &QAbstractItemModel::dataChanged, this, drop));
+    m_sourceConnections.append(
+        connect(model, &QAbstractItemModel::rowsInserted, this, drop));
+    m_sourceConnections.append(
+        connect(model, &QAbstractItemModel::rowsRemoved, this, drop));
+    m_sourceConnections.append(
+        connect(model, &QAbstractItemModel::rowsMoved, this, drop));
+    m_sourceConnections.append(
+        connect(model, &QAbstractItemModel::modelReset, this, drop));
+    m_sourceConnections.append(
+        connect(model, &QAbstractItemModel::layoutChanged, this, drop));
+}
+
+bool IncrementalFilterProxy::filterAcceptsRow(
+    int sourceRow, const QModelIndex& sourceParent) const {
+    if (sourceParent.isValid()) {
+        return true;  // Flat models only; see class comment
+    }
+    if (m_query.isEmpty()) {
+        return true;
+    }
+    if (m_narrowing && sourceRow < m_previousMatches.size() &&
+        !m_previousMatches.testBit(sourceRow)) {
+        return false;
+    }
+    return haystack(sourceRow).contains(m_query);
+}
+
+void IncrementalFilterProxy::dropCaches() {
+    m_haystacks.clear();
+    m_haystackBuilt.clear();
+    m_previousMatches.clear();
+    m_narrowing = false;
+}
+
+const QString& IncrementalFilterProxy::haystack(int sourceRow) const {
+    if (sourceRow < m_haystackBuilt.size() &&
+        m_haystackBuilt.testBit(sourceRow)) {
+        return m_haystacks[sourceRow];
+    }
+
+    const QAbstractItemModel* source = sourceModel();
+    if (m_haystacks.size() < source->rowCount()) {
+        m_haystacks.resize(source->rowCount());
+        m_haystackBuilt.resize(source->rowCount());
+    }
+
+    // One folded string per row spanning all columns; the separator
+    // keeps a query from matching across a column boundary
+    QString text;
+    const int columns = source->columnCount();
+    for (int column = 0; column < columns; ++column) {
+        const QString part =
+            source->index(sourceRow, column).data(filterRole()).toString();
+        if (part.isEmpty()) {
+            continue;
+        }
+        if (!text.isEmpty()) {
+            text += QLatin1Char('\n');
+        }
+        text += part.toCaseFolded();
+    }
+    m_haystacks[sourceRow] = text;
+    m_haystackBuilt.setBit(sourceRow);
+    return m_haystacks[sourceRow];
+}
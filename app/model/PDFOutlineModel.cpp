@@ -1,126 +1,260 @@
 #include "PDFOutlineModel.h"
+#include <algorithm>
 #include <QDebug>
+#include <QPointer>
+#include <QQueue>
+#include "../managers/RenderScheduler.h"
 
 PDFOutlineModel::PDFOutlineModel(QObject* parent)
-    : QObject(parent), totalItemCount(0) {}
+    : QObject(parent), rootCount(0), parseGeneration(0) {}
 
 bool PDFOutlineModel::parseOutline(Poppler::Document* document) {
     clear();
+    ++parseGeneration;  // 丢弃仍在途中的异步解析结果
 
     if (!document) {
         qWarning() << "PDFOutlineModel: Document is null";
         return false;
     }
 
-    // 获取PDF文档的目录
-    QList<Poppler::OutlineItem> outline = document->outline();
-    if (outline.isEmpty()) {
+    QList<PDFOutlineEntry> parsed = buildOutlineEntries(document);
+    if (parsed.isEmpty()) {
         qDebug() << "PDFOutlineModel: Document has no outline";
         return false;
     }
 
-    // 解析目录项
-    for (const auto& item : outline) {
-        auto node = std::make_shared<PDFOutlineNode>();
-        parseOutlineItemRecursive(item, node, 0);
-        if (!node->title.isEmpty()) {
-            rootNodes.append(node);
-        }
-    }
+    applyParsedOutline(parsed);
+    return true;
+}
 
-    totalItemCount = countNodes(rootNodes);
+void PDFOutlineModel::parseOutlineAsync(Poppler::Document* document) {
+    clear();
+    const quint64 generation = ++parseGeneration;
 
-    qDebug() << "PDFOutlineModel: Parsed" << totalItemCount << "outline items";
-    emit outlineParsed();
-    return true;
+    if (!document) {
+        qWarning() << "PDFOutlineModel: Document is null";
+        return;
+    }
+
+    // 在共享渲染线程池上解析目录树，完成后排队回到本对象线程应用。
+    // 代数计数器保证文档切换后迟到的结果被丢弃
+    QPointer<PDFOutlineModel> guard(this);
+    RenderScheduler::instance().submit(
+        RenderScheduler::TaskClass::Background,
+        [guard, document, generation]() {
+            if (!guard) {
+                return;
+            }
+            QList<PDFOutlineEntry> parsed = buildOutlineEntries(document);
+            QMetaObject::invokeMethod(
+                guard,
+                [guard, parsed, generation]() {
+                    if (!guard || generation != guard->parseGeneration) {
+                        return;
+                    }
+                    if (parsed.isEmpty()) {
+                        qDebug()
+                            << "PDFOutlineModel: Document has no outline";
+                        return;
+                    }
+                    guard->applyParsedOutline(parsed);
+                },
+                Qt::QueuedConnection);
+        });
 }
 
 void PDFOutlineModel::clear() {
-    rootNodes.clear();
-    totalItemCount = 0;
+    entries.clear();
+    rootCount = 0;
+    entriesByPage.clear();
+    entriesByTitle.clear();
     emit outlineCleared();
 }
 
-const QList<std::shared_ptr<PDFOutlineNode>>& PDFOutlineModel::getRootNodes()
-    const {
-    return rootNodes;
+int PDFOutlineModel::entryCount() const { return entries.size(); }
+
+int PDFOutlineModel::rootEntryCount() const { return rootCount; }
+
+const PDFOutlineEntry& PDFOutlineModel::entryAt(int index) const {
+    return entries.at(index);
 }
 
-bool PDFOutlineModel::hasOutline() const { return !rootNodes.isEmpty(); }
+bool PDFOutlineModel::hasOutline() const { return !entries.isEmpty(); }
 
-int PDFOutlineModel::getTotalItemCount() const { return totalItemCount; }
+int PDFOutlineModel::getTotalItemCount() const { return entries.size(); }
 
-std::shared_ptr<PDFOutlineNode> PDFOutlineModel::findNodeByPage(
-    int pageNumber) const {
-    return findNodeByPageRecursive(rootNodes, pageNumber);
+int PDFOutlineModel::findEntryByPage(int pageNumber) const {
+    // 在页面号索引上二分查找；同页多个条目时返回文档顺序靠前的那个
+    auto it = std::lower_bound(
+        entriesByPage.cbegin(), entriesByPage.cend(), pageNumber,
+        [this](int index, int page) {
+            return entries.at(index).pageNumber < page;
+        });
+    if (it != entriesByPage.cend() &&
+        entries.at(*it).pageNumber == pageNumber) {
+        return *it;
+    }
+    return -1;
 }
 
-QList<std::shared_ptr<PDFOutlineNode>> PDFOutlineModel::getFlattenedNodes()
-    const {
-    QList<std::shared_ptr<PDFOutlineNode>> result;
-    flattenNodesRecursive(rootNodes, result);
+int PDFOutlineModel::findSectionEntryForPage(int pageNumber) const {
+    // 目标页不大于pageNumber的最后一个条目即为包含该页的章节
+    auto it = std::upper_bound(
+        entriesByPage.cbegin(), entriesByPage.cend(), pageNumber,
+        [this](int page, int index) {
+            return page < entries.at(index).pageNumber;
+        });
+    if (it == entriesByPage.cbegin()) {
+        return -1;  // 第一个章节之前的页面
+    }
+    return *(it - 1);
+}
+
+QList<int> PDFOutlineModel::findEntriesByTitlePrefix(
+    const QString& prefix) const {
+    QList<int> result;
+    if (prefix.isEmpty()) {
+        return result;
+    }
+
+    const QString lowered = prefix.toLower();
+    auto it = std::lower_bound(
+        entriesByTitle.cbegin(), entriesByTitle.cend(), lowered,
+        [](const QPair<QString, int>& entry, const QString& value) {
+            return entry.first < value;
+        });
+    for (; it != entriesByTitle.cend() && it->first.startsWith(lowered);
+         ++it) {
+        result.append(it->second);
+    }
     return result;
 }
 
-void PDFOutlineModel::parseOutlineItemRecursive(
-    const Poppler::OutlineItem& item, std::shared_ptr<PDFOutlineNode> node,
-    int level) {
-    // 设置节点基本信息
-    node->title = item.name();
-    node->level = level;
-
-    // 获取目标页面
-    if (item.destination()) {
-        auto dest = item.destination();
-        if (dest->pageNumber() > 0) {
-            node->pageNumber = dest->pageNumber() - 1;  // 转换为0-based
+QList<PDFOutlineEntry> PDFOutlineModel::buildOutlineEntries(
+    Poppler::Document* document) {
+    QList<PDFOutlineEntry> result;
+
+    // 层序构建：出队一个目录项时其子项被连续追加到数组尾部，
+    // 所以firstChild/childCount天然是一段连续区间。迭代实现，
+    // 几千层的畸形嵌套也不会耗尽调用栈
+    struct Pending {
+        Poppler::OutlineItem item;
+        int entryIndex;
+    };
+    QQueue<Pending> queue;
+
+    QList<Poppler::OutlineItem> outline = document->outline();
+    for (const auto& item : outline) {
+        if (item.name().isEmpty()) {
+            continue;
         }
+        PDFOutlineEntry entry;
+        entry.title = item.name();
+        entry.level = 0;
+        if (item.destination()) {
+            auto dest = item.destination();
+            if (dest->pageNumber() > 0) {
+                entry.pageNumber = dest->pageNumber() - 1;  // 转换为0-based
+            }
+        }
+        queue.enqueue({item, result.size()});
+        result.append(entry);
     }
 
-    // 递归处理子项
-    if (item.hasChildren()) {
-        QList<Poppler::OutlineItem> children = item.children();
+    while (!queue.isEmpty()) {
+        Pending pending = queue.dequeue();
+        if (!pending.item.hasChildren()) {
+            continue;
+        }
+
+        const int parentLevel = result.at(pending.entryIndex).level;
+        result[pending.entryIndex].firstChild = result.size();
+
+        QList<Poppler::OutlineItem> children = pending.item.children();
         for (const auto& child : children) {
-            auto childNode = std::make_shared<PDFOutlineNode>();
-            parseOutlineItemRecursive(child, childNode, level + 1);
-            if (!childNode->title.isEmpty()) {
-                node->addChild(childNode);
+            if (child.name().isEmpty()) {
+                continue;
+            }
+            PDFOutlineEntry entry;
+            entry.title = child.name();
+            entry.level = parentLevel + 1;
+            entry.parent = pending.entryIndex;
+            if (child.destination()) {
+                auto dest = child.destination();
+                if (dest->pageNumber() > 0) {
+                    entry.pageNumber = dest->pageNumber() - 1;
+                }
             }
+            queue.enqueue({child, result.size()});
+            result.append(entry);
+            ++result[pending.entryIndex].childCount;
         }
     }
+
+    return result;
 }
 
-int PDFOutlineModel::countNodes(
-    const QList<std::shared_ptr<PDFOutlineNode>>& nodes) const {
-    int count = nodes.size();
-    for (const auto& node : nodes) {
-        count += countNodes(node->children);
+void PDFOutlineModel::applyParsedOutline(
+    const QList<PDFOutlineEntry>& parsed) {
+    entries = parsed;
+    rootCount = 0;
+    while (rootCount < entries.size() && entries.at(rootCount).level == 0) {
+        ++rootCount;
     }
-    return count;
+    rebuildFlatIndexes();
+
+    qDebug() << "PDFOutlineModel: Parsed" << entries.size()
+             << "outline items";
+    emit outlineParsed();
 }
 
-std::shared_ptr<PDFOutlineNode> PDFOutlineModel::findNodeByPageRecursive(
-    const QList<std::shared_ptr<PDFOutlineNode>>& nodes, int pageNumber) const {
-    for (const auto& node : nodes) {
-        if (node->pageNumber == pageNumber) {
-            return node;
-        }
+void PDFOutlineModel::rebuildFlatIndexes() {
+    // 先按文档顺序收集，stable_sort保留同键条目的先后关系
+    const QList<int> docOrder = entriesInDocumentOrder();
 
-        // 递归搜索子节点
-        auto found = findNodeByPageRecursive(node->children, pageNumber);
-        if (found) {
-            return found;
+    // 页面号索引：仅收录有效页面引用
+    entriesByPage.clear();
+    for (int index : docOrder) {
+        if (entries.at(index).isValidPageReference()) {
+            entriesByPage.append(index);
         }
     }
+    std::stable_sort(entriesByPage.begin(), entriesByPage.end(),
+                     [this](int a, int b) {
+                         return entries.at(a).pageNumber <
+                                entries.at(b).pageNumber;
+                     });
 
-    return nullptr;
+    // 标题索引：按小写标题排序，支持大小写不敏感的前缀二分查找
+    entriesByTitle.clear();
+    entriesByTitle.reserve(entries.size());
+    for (int index : docOrder) {
+        entriesByTitle.append(
+            qMakePair(entries.at(index).title.toLower(), index));
+    }
+    std::stable_sort(entriesByTitle.begin(), entriesByTitle.end(),
+                     [](const QPair<QString, int>& a,
+                        const QPair<QString, int>& b) {
+                         return a.first < b.first;
+                     });
 }
 
-void PDFOutlineModel::flattenNodesRecursive(
-    const QList<std::shared_ptr<PDFOutlineNode>>& nodes,
-    QList<std::shared_ptr<PDFOutlineNode>>& result) const {
-    for (const auto& node : nodes) {
-        result.append(node);
-        flattenNodesRecursive(node->children, result);
+QList<int> PDFOutlineModel::entriesInDocumentOrder() const {
+    // 条目数组是层序布局，文档顺序需要一次先序遍历（迭代实现）
+    QList<int> result;
+    result.reserve(entries.size());
+
+    QList<int> stack;
+    for (int i = rootCount - 1; i >= 0; --i) {
+        stack.append(i);
     }
+    while (!stack.isEmpty()) {
+        const int index = stack.takeLast();
+        result.append(index);
+        const PDFOutlineEntry& entry = entries.at(index);
+        for (int c = entry.childCount - 1; c >= 0; --c) {
+            stack.append(entry.firstChild + c);
+        }
+    }
+    return result;
 }
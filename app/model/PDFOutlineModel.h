@@ -3,28 +3,24 @@
 #include <poppler/qt6/poppler-qt6.h>
 #include <QList>
 #include <QObject>
+#include <QPair>
 #include <QString>
-#include <memory>
 
-// PDF目录节点数据结构
-struct PDFOutlineNode {
-    QString title;     // 目录项标题
-    int pageNumber;    // 目标页面号（0-based）
-    int level;         // 层级深度（0为根级）
-    bool hasChildren;  // 是否有子节点
-    QList<std::shared_ptr<PDFOutlineNode>> children;  // 子节点列表
+// 紧凑目录条目：整个目录存放在一个连续数组里（层序布局），子节点
+// 用指向同一数组的下标区间表示，而不是每个节点各持一个指针向量。
+// 5万条目的标准文档目录占用几MB连续内存，解析时零指针追逐
+struct PDFOutlineEntry {
+    QString title;       // 目录项标题
+    int pageNumber;      // 目标页面号（0-based，-1表示无页面引用）
+    int level;           // 层级深度（0为根级）
+    int parent;          // 父条目下标（根级为-1）
+    int firstChild;      // 子条目区间起点（层序布局保证区间连续）
+    int childCount;      // 子条目数量
 
-    PDFOutlineNode(const QString& title = "", int page = -1, int level = 0)
-        : title(title), pageNumber(page), level(level), hasChildren(false) {}
+    PDFOutlineEntry()
+        : pageNumber(-1), level(0), parent(-1), firstChild(0), childCount(0) {}
 
-    // 添加子节点
-    void addChild(std::shared_ptr<PDFOutlineNode> child) {
-        children.append(child);
-        hasChildren = true;
-    }
-
-    // 获取子节点数量
-    int childCount() const { return children.size(); }
+    bool hasChildren() const { return childCount > 0; }
 
     // 检查是否为有效的页面引用
     bool isValidPageReference() const { return pageNumber >= 0; }
@@ -38,14 +34,25 @@ public:
     explicit PDFOutlineModel(QObject* parent = nullptr);
     ~PDFOutlineModel() = default;
 
-    // 解析PDF文档的目录
+    // 解析PDF文档的目录（同步，调用线程上执行）
     bool parseOutline(Poppler::Document* document);
 
+    // 在后台线程解析目录，完成后在本对象线程上发出outlineParsed信号。
+    // 深层嵌套的大目录（上万条目）不再冻结界面；解析期间查询接口
+    // 返回空结果
+    void parseOutlineAsync(Poppler::Document* document);
+
     // 清空目录
     void clear();
 
-    // 获取根节点列表
-    const QList<std::shared_ptr<PDFOutlineNode>>& getRootNodes() const;
+    // 条目总数
+    int entryCount() const;
+
+    // 根级条目数；根级条目占据下标区间[0, rootEntryCount())
+    int rootEntryCount() const;
+
+    // 按下标访问条目；下标来自区间字段或查找接口
+    const PDFOutlineEntry& entryAt(int index) const;
 
     // 检查是否有目录
     bool hasOutline() const;
@@ -53,39 +60,44 @@ public:
     // 获取目录项总数
     int getTotalItemCount() const;
 
-    // 根据页面号查找对应的目录节点
-    std::shared_ptr<PDFOutlineNode> findNodeByPage(int pageNumber) const;
+    // 根据页面号查找对应的条目下标（精确匹配，二分查找），无则返回-1
+    int findEntryByPage(int pageNumber) const;
+
+    // 反向查找：返回包含该页面的目录章节，即目标页不大于pageNumber
+    // 的最后一个条目的下标（二分查找），无则返回-1
+    int findSectionEntryForPage(int pageNumber) const;
 
-    // 获取扁平化的目录列表（用于搜索等功能）
-    QList<std::shared_ptr<PDFOutlineNode>> getFlattenedNodes() const;
+    // 按标题前缀查找条目下标（大小写不敏感，二分查找）
+    QList<int> findEntriesByTitlePrefix(const QString& prefix) const;
 
 signals:
     void outlineParsed();
     void outlineCleared();
 
 private:
-    QList<std::shared_ptr<PDFOutlineNode>> rootNodes;
-    int totalItemCount;
-
-    // 递归解析目录项
-    std::shared_ptr<PDFOutlineNode> parseOutlineItem(
-        const QList<Poppler::OutlineItem>& items, int level = 0);
-
-    // 递归解析单个目录项
-    void parseOutlineItemRecursive(const Poppler::OutlineItem& item,
-                                   std::shared_ptr<PDFOutlineNode> parentNode,
-                                   int level);
-
-    // 计算目录项总数
-    int countNodes(const QList<std::shared_ptr<PDFOutlineNode>>& nodes) const;
-
-    // 递归查找节点
-    std::shared_ptr<PDFOutlineNode> findNodeByPageRecursive(
-        const QList<std::shared_ptr<PDFOutlineNode>>& nodes,
-        int pageNumber) const;
-
-    // 递归获取扁平化列表
-    void flattenNodesRecursive(
-        const QList<std::shared_ptr<PDFOutlineNode>>& nodes,
-        QList<std::shared_ptr<PDFOutlineNode>>& result) const;
+    // 层序布局的条目数组：每个条目的子条目占据一段连续区间
+    QList<PDFOutlineEntry> entries;
+    int rootCount;
+
+    // 扁平索引：解析完成后一次性构建，查询走二分查找而不是树遍历。
+    // stable_sort前先按文档顺序（先序）收集，保证同键条目的先后关系
+    QList<int> entriesByPage;                  // 按页面号排序的条目下标
+    QList<QPair<QString, int>> entriesByTitle; // 按小写标题排序
+
+    // 代数计数器：文档切换后丢弃迟到的后台解析结果
+    quint64 parseGeneration;
+
+    // 从文档构建层序条目数组（静态，可在工作线程上执行；迭代实现，
+    // 深度不受调用栈限制）
+    static QList<PDFOutlineEntry> buildOutlineEntries(
+        Poppler::Document* document);
+
+    // 接收解析结果并重建索引
+    void applyParsedOutline(const QList<PDFOutlineEntry>& parsed);
+
+    // 重建扁平索引
+    void rebuildFlatIndexes();
+
+    // 按文档顺序（先序）收集条目下标
+    QList<int> entriesInDocumentOrder() const;
 };
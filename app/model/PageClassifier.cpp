@@ -0,0 +1,163 @@
+#include "PageClassifier.h"
+
+#include <QImage>
+#include <QMutexLocker>
+#include <QRectF>
+#include "utils/LoggingMacros.h"
+
+PageClassifier& PageClassifier::instance() {
+    static PageClassifier classifier;
+    return classifier;
+}
+
+PageClassifier::PageClass PageClassifier::classify(const QString& documentKey,
+                                                   int pageNumber,
+                                                   Poppler::Page* page) {
+    if (documentKey.isEmpty() || !page) {
+        return PageClass::Unknown;
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        auto docIt = m_classes.constFind(documentKey);
+        if (docIt != m_classes.constEnd()) {
+            auto pageIt = docIt->constFind(pageNumber);
+            if (pageIt != docIt->constEnd()) {
+                return pageIt.value();
+            }
+        }
+    }
+
+    // Probe outside the lock: text extraction and the low-DPI render
+    // are cheap but not free, and concurrent workers classifying
+    // different pages must not serialize on each other
+    bool hasColor = true;
+    const PageClass pageClass = classifyPage(page, hasColor);
+
+    QMutexLocker locker(&m_mutex);
+    m_classes[documentKey].insert(pageNumber, pageClass);
+    m_hasColor[documentKey].insert(pageNumber, hasColor);
+    return pageClass;
+}
+
+PageClassifier::PageClass PageClassifier::cachedClass(
+    const QString& documentKey, int pageNumber) const {
+    QMutexLocker locker(&m_mutex);
+    return m_classes.value(documentKey).value(pageNumber, PageClass::Unknown);
+}
+
+bool PageClassifier::pageHasColor(const QString& documentKey, int pageNumber,
+                                  Poppler::Page* page) {
+    if (documentKey.isEmpty() || !page) {
+        return true;
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        auto docIt = m_hasColor.constFind(documentKey);
+        if (docIt != m_hasColor.constEnd()) {
+            auto pageIt = docIt->constFind(pageNumber);
+            if (pageIt != docIt->constEnd()) {
+                return pageIt.value();
+            }
+        }
+    }
+
+    classify(documentKey, pageNumber, page);
+
+    QMutexLocker locker(&m_mutex);
+    return m_hasColor.value(documentKey).value(pageNumber, true);
+}
+
+void PageClassifier::clearDocument(const QString& documentKey) {
+    QMutexLocker locker(&m_mutex);
+    m_classes.remove(documentKey);
+    m_hasColor.remove(documentKey);
+}
+
+PageClassifier::PageClass PageClassifier::classifyPage(Poppler::Page* page,
+                                                       bool& hasColor) {
+    // The probe render is taken before the text early-out because the
+    // color verdict is wanted for every page, typeset ones included;
+    // at PROBE_DPI the render stays cheap
+    const QImage colorProbe = page->renderToImage(PROBE_DPI, PROBE_DPI);
+    hasColor = colorProbe.isNull() || colorProbe.width() < 4 ||
+                       colorProbe.height() < 4
+                   ? true
+                   : probeHasColor(colorProbe);
+
+    // Signal 1: extracted text. Typeset pages carry a text layer;
+    // scans and drawings extract little or nothing. Raw order is
+    // enough for a character count — no layout analysis needed
+    const int charCount =
+        page->text(QRectF(), Poppler::Page::RawOrderLayout).length();
+    if (charCount >= TEXT_DOMINANT_CHARS) {
+        return PageClass::TextDominant;
+    }
+
+    // Signal 2: tone distribution of the probe. Continuous-tone
+    // rasters (scans, photos) put gradients and noise everywhere, so a
+    // large share of pixels lands between near-white and near-black;
+    // vector line art is flat fills and sharp strokes with almost
+    // nothing in between
+    const QImage probe = colorProbe.convertToFormat(QImage::Format_Grayscale8);
+    if (probe.isNull() || probe.width() < 4 || probe.height() < 4) {
+        return PageClass::Unknown;
+    }
+
+    int sampled = 0;
+    int midtones = 0;
+    // A sparse grid is enough for a histogram verdict and keeps the
+    // pass independent of page size
+    const int stepX = qMax(1, probe.width() / 64);
+    const int stepY = qMax(1, probe.height() / 64);
+    for (int y = 0; y < probe.height(); y += stepY) {
+        const uchar* line = probe.constScanLine(y);
+        for (int x = 0; x < probe.width(); x += stepX) {
+            const uchar gray = line[x];
+            if (gray > 32 && gray < 224) {
+                midtones++;
+            }
+            sampled++;
+        }
+    }
+    if (sampled == 0) {
+        return PageClass::Unknown;
+    }
+
+    const double midtoneFraction =
+        static_cast<double>(midtones) / static_cast<double>(sampled);
+    const PageClass pageClass = midtoneFraction >= MIDTONE_FRACTION_THRESHOLD
+                                    ? PageClass::ImageDominant
+                                    : PageClass::VectorDominant;
+    LOG_DEBUG("PageClassifier: {} chars, {:.3f} midtone -> {}", charCount,
+              midtoneFraction,
+              pageClass == PageClass::ImageDominant ? "image" : "vector");
+    return pageClass;
+}
+
+bool PageClassifier::probeHasColor(const QImage& probe) {
+    // Same sparse grid as the tone histogram; one saturated pixel is
+    // enough to call the page colored, so bail on the first hit
+    const QImage rgb = probe.format() == QImage::Format_RGB32 ||
+                               probe.format() == QImage::Format_ARGB32
+                           ? probe
+                           : probe.convertToFormat(QImage::Format_RGB32);
+    const int stepX = qMax(1, rgb.width() / 64);
+    const int stepY = qMax(1, rgb.height() / 64);
+    for (int y = 0; y < rgb.height(); y += stepY) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(rgb.constScanLine(y));
+        for (int x = 0; x < rgb.width(); x += stepX) {
+            const QRgb pixel = line[x];
+            const int r = qRed(pixel);
+            const int g = qGreen(pixel);
+            const int b = qBlue(pixel);
+            if (qAbs(r - g) > COLOR_CHANNEL_TOLERANCE ||
+                qAbs(g - b) > COLOR_CHANNEL_TOLERANCE ||
+                qAbs(r - b) > COLOR_CHANNEL_TOLERANCE) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
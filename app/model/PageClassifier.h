@@ -0,0 +1,98 @@
+#pragma once
+
+#include <poppler-qt6.h>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+/**
+ * Cheap per-page content classifier that routes render strategies.
+ *
+ * Scanned pages, vector drawings and text pages have very different
+ * optimal render paths, but every render call used to pay the same
+ * full Poppler rasterization. The classifier looks at two cheap
+ * signals — extracted text length and the tone distribution of a tiny
+ * probe render — and caches one class per page:
+ *
+ *  - TextDominant: enough extracted text that the page is typeset
+ *    content; full-resolution rasterization is worth it.
+ *  - ImageDominant: almost no text and a probe full of midtones —
+ *    a scan or photo. The embedded raster has fixed resolution, so
+ *    rendering above a DPI cap only makes Poppler upscale it the slow
+ *    way; callers render at the cap and scale the result instead.
+ *  - VectorDominant: almost no text and a probe of flat tones — line
+ *    art, which stays crisp at any DPI and benefits from tiling.
+ *
+ * The same probe render also answers whether the page carries any
+ * color: renders of color-free pages (the common case for scanned
+ * text corpora) can then be stored as Grayscale8 at a quarter of the
+ * ARGB bytes — see RenderPolicy::toStorageFormat.
+ *
+ * The poppler-qt6 frontend cannot enumerate page XObjects, so the
+ * ratio is inferred from the probe rather than counted from the
+ * object tree. Classification runs on whichever worker thread first
+ * renders the page and is cached per document hash after that.
+ */
+class PageClassifier {
+public:
+    enum class PageClass {
+        Unknown,
+        TextDominant,
+        ImageDominant,
+        VectorDominant
+    };
+
+    // Rendering an image-dominant page above this gains nothing: the
+    // source raster is typically a 150-300 DPI scan already downsampled
+    // by the producer, and smooth upscaling of the capped render is
+    // visually equivalent at a fraction of the cost
+    static constexpr double IMAGE_PAGE_DPI_CAP = 150.0;
+
+    static PageClassifier& instance();
+
+    // Class for the page, computing and caching it on first call. The
+    // caller supplies the page handle it already holds so no second
+    // page object is built; documentKey is the content-hash namespace
+    // (or any stable per-document key)
+    PageClass classify(const QString& documentKey, int pageNumber,
+                       Poppler::Page* page);
+
+    // Cache-only lookup; Unknown when the page was never classified
+    PageClass cachedClass(const QString& documentKey, int pageNumber) const;
+
+    // Whether the page's probe render contained color, classifying the
+    // page first if needed. Returns true (color) when no verdict could
+    // be reached, so the safe ARGB path is the fallback.
+    bool pageHasColor(const QString& documentKey, int pageNumber,
+                      Poppler::Page* page);
+
+    void clearDocument(const QString& documentKey);
+
+private:
+    PageClassifier() = default;
+
+    static PageClass classifyPage(Poppler::Page* page, bool& hasColor);
+    static bool probeHasColor(const QImage& probe);
+
+    // Probe render resolution: a letter page is ~300x400 pixels, cheap
+    // even for complex pages, and plenty for a tone histogram
+    static constexpr double PROBE_DPI = 36.0;
+
+    // At or above this many extracted characters the page is typeset
+    // text regardless of what else is on it
+    static constexpr int TEXT_DOMINANT_CHARS = 64;
+
+    // Fraction of sampled probe pixels in the midtone band separating
+    // continuous-tone rasters (scans, photos: gradients and sensor
+    // noise everywhere) from flat-tone vector art
+    static constexpr double MIDTONE_FRACTION_THRESHOLD = 0.12;
+
+    // Channel spread above which a sampled probe pixel counts as
+    // colored; small spreads are antialiasing fringes and JPEG noise,
+    // not content
+    static constexpr int COLOR_CHANNEL_TOLERANCE = 12;
+
+    mutable QMutex m_mutex;
+    QHash<QString, QHash<int, PageClass>> m_classes;  // key -> page -> class
+    QHash<QString, QHash<int, bool>> m_hasColor;      // key -> page -> color
+};
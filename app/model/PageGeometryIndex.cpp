@@ -0,0 +1,230 @@
+#include "PageGeometryIndex.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QStandardPaths>
+#include <functional>
+#include <memory>
+#include "DocumentSnapshot.h"
+#include "managers/RenderScheduler.h"
+#include "utils/LoggingMacros.h"
+
+namespace {
+
+int rotationFromOrientation(Poppler::Page::Orientation orientation) {
+    switch (orientation) {
+        case Poppler::Page::Landscape:
+            return 90;
+        case Poppler::Page::UpsideDown:
+            return 180;
+        case Poppler::Page::Seascape:
+            return 270;
+        case Poppler::Page::Portrait:
+        default:
+            return 0;
+    }
+}
+
+}  // namespace
+
+PageGeometryIndex& PageGeometryIndex::instance() {
+    static PageGeometryIndex index;
+    return index;
+}
+
+PageGeometryIndex::PageGeometryIndex(QObject* parent) : QObject(parent) {}
+
+void PageGeometryIndex::ensureScanned(const QString& documentHash,
+                                      Poppler::Document* document) {
+    if (documentHash.isEmpty()) {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        DocumentGeometry& geometry = m_documents[documentHash];
+        if (geometry.ready || geometry.scanning) {
+            return;
+        }
+        if (loadFromCacheLocked(documentHash)) {
+            return;  // Persisted scan from an earlier session
+        }
+        if (!document) {
+            return;
+        }
+        geometry.scanning = true;
+    }
+
+    // First open of this document: one pass over a private snapshot
+    // handle, so the scan never contends with renders on the shared one.
+    // The shared_ptr keeps the snapshot alive even if the document is
+    // closed mid-scan. Without a snapshot (documents opened outside
+    // DocumentModel) the primary handle cannot be trusted to outlive a
+    // pool job, so those scan inline on the caller's thread instead
+    std::shared_ptr<DocumentSnapshot> snapshot =
+        DocumentSnapshot::forDocument(document);
+    const int numPages = document->numPages();
+
+    auto scanWith = [this, documentHash,
+                     numPages](const std::function<std::unique_ptr<
+                                   Poppler::Page>(int)>& pageAt) {
+        QVector<PageGeometry> pages;
+        pages.reserve(numPages);
+        for (int i = 0; i < numPages; ++i) {
+            PageGeometry entry;
+            if (std::unique_ptr<Poppler::Page> page = pageAt(i)) {
+                entry.sizePoints = page->pageSizeF();
+                entry.rotation = rotationFromOrientation(page->orientation());
+            }
+            pages.append(entry);
+        }
+
+        saveToCache(documentHash, pages);
+
+        {
+            QMutexLocker locker(&m_mutex);
+            DocumentGeometry& geometry = m_documents[documentHash];
+            geometry.pages = pages;
+            geometry.scanning = false;
+            geometry.ready = true;
+            buildPrefix(geometry);
+        }
+        LOG_DEBUG("PageGeometryIndex: scanned {} pages for {}", numPages,
+                  documentHash.toStdString());
+        emit geometryReady(documentHash, numPages);
+    };
+
+    if (snapshot) {
+        RenderScheduler::instance().submit(
+            RenderScheduler::TaskClass::Background, [snapshot, scanWith]() {
+                scanWith([&snapshot](int i) { return snapshot->page(i); });
+            });
+    } else {
+        scanWith([document](int i) {
+            return std::unique_ptr<Poppler::Page>(document->page(i));
+        });
+    }
+}
+
+bool PageGeometryIndex::isReady(const QString& documentHash) const {
+    QMutexLocker locker(&m_mutex);
+    auto it = m_documents.constFind(documentHash);
+    return it != m_documents.constEnd() && it->ready;
+}
+
+int PageGeometryIndex::pageCount(const QString& documentHash) const {
+    QMutexLocker locker(&m_mutex);
+    auto it = m_documents.constFind(documentHash);
+    return it != m_documents.constEnd() && it->ready ? it->pages.size() : 0;
+}
+
+QSizeF PageGeometryIndex::pageSize(const QString& documentHash,
+                                   int pageNumber) const {
+    QMutexLocker locker(&m_mutex);
+    auto it = m_documents.constFind(documentHash);
+    if (it == m_documents.constEnd() || !it->ready || pageNumber < 0 ||
+        pageNumber >= it->pages.size()) {
+        return QSizeF();
+    }
+    const PageGeometry& geometry = it->pages.at(pageNumber);
+    if (geometry.rotation == 90 || geometry.rotation == 270) {
+        return geometry.sizePoints.transposed();
+    }
+    return geometry.sizePoints;
+}
+
+int PageGeometryIndex::pageRotation(const QString& documentHash,
+                                    int pageNumber) const {
+    QMutexLocker locker(&m_mutex);
+    auto it = m_documents.constFind(documentHash);
+    if (it == m_documents.constEnd() || !it->ready || pageNumber < 0 ||
+        pageNumber >= it->pages.size()) {
+        return 0;
+    }
+    return it->pages.at(pageNumber).rotation;
+}
+
+double PageGeometryIndex::cumulativeHeight(const QString& documentHash,
+                                           int uptoPage,
+                                           double spacingPoints) const {
+    QMutexLocker locker(&m_mutex);
+    auto it = m_documents.constFind(documentHash);
+    if (it == m_documents.constEnd() || !it->ready || uptoPage <= 0) {
+        return 0.0;
+    }
+    const int clamped = qMin(uptoPage, it->pages.size());
+    return it->heightPrefix.at(clamped) + spacingPoints * (clamped - 1);
+}
+
+QString PageGeometryIndex::cacheFilePath(const QString& documentHash) {
+    return QStandardPaths::writableLocation(
+               QStandardPaths::AppDataLocation) +
+           "/page-geometry/" + documentHash + ".json";
+}
+
+bool PageGeometryIndex::loadFromCacheLocked(const QString& documentHash) {
+    QFile file(cacheFilePath(documentHash));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    if (!doc.isObject()) {
+        return false;
+    }
+
+    QJsonArray pagesJson = doc.object()["pages"].toArray();
+    DocumentGeometry& geometry = m_documents[documentHash];
+    geometry.pages.clear();
+    geometry.pages.reserve(pagesJson.size());
+    for (const QJsonValue& value : pagesJson) {
+        QJsonArray entry = value.toArray();
+        PageGeometry page;
+        page.sizePoints = QSizeF(entry.at(0).toDouble(),
+                                 entry.at(1).toDouble());
+        page.rotation = entry.at(2).toInt();
+        geometry.pages.append(page);
+    }
+    geometry.ready = true;
+    buildPrefix(geometry);
+    return true;
+}
+
+void PageGeometryIndex::saveToCache(const QString& documentHash,
+                                    const QVector<PageGeometry>& pages) {
+    QJsonArray pagesJson;
+    for (const PageGeometry& page : pages) {
+        QJsonArray entry;
+        entry.append(page.sizePoints.width());
+        entry.append(page.sizePoints.height());
+        entry.append(page.rotation);
+        pagesJson.append(entry);
+    }
+
+    QJsonObject root;
+    root["version"] = 1;
+    root["pages"] = pagesJson;
+
+    QString path = cacheFilePath(documentHash);
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QFile file(path);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    }
+}
+
+void PageGeometryIndex::buildPrefix(DocumentGeometry& geometry) {
+    geometry.heightPrefix.resize(geometry.pages.size() + 1);
+    geometry.heightPrefix[0] = 0.0;
+    for (int i = 0; i < geometry.pages.size(); ++i) {
+        const PageGeometry& page = geometry.pages.at(i);
+        const double height =
+            page.rotation == 90 || page.rotation == 270
+                ? page.sizePoints.width()
+                : page.sizePoints.height();
+        geometry.heightPrefix[i + 1] = geometry.heightPrefix[i] + height;
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <poppler-qt6.h>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QSizeF>
+#include <QString>
+#include <QVector>
+
+/**
+ * Persistent per-document page geometry (size + rotation) index.
+ *
+ * Continuous-scroll geometry and thumbnail layout need every page's
+ * size up front, and querying Poppler for 2000 pages at open time is
+ * slow enough to delay the first scrollbar. The index scans all page
+ * sizes and orientations in one background pass over a private
+ * snapshot handle and persists the result per document hash, so every
+ * later open of the same file has exact geometry synchronously with
+ * zero per-page Poppler queries. Consumers ask ensureScanned() at
+ * document open and either read immediately (cache hit) or listen for
+ * geometryReady.
+ */
+class PageGeometryIndex : public QObject {
+    Q_OBJECT
+
+public:
+    static PageGeometryIndex& instance();
+
+    struct PageGeometry {
+        QSizeF sizePoints;  // Media box in PDF points, unrotated
+        int rotation = 0;   // Page /Rotate in degrees: 0/90/180/270
+    };
+
+    // Makes the document's geometry available. A persisted scan is
+    // loaded synchronously (one small file read); otherwise one
+    // background pass runs on the shared pool and geometryReady fires
+    // when it lands. Safe to call repeatedly
+    void ensureScanned(const QString& documentHash,
+                       Poppler::Document* document);
+
+    bool isReady(const QString& documentHash) const;
+    int pageCount(const QString& documentHash) const;
+
+    // Page size in points, rotation applied (what layout actually
+    // occupies). Invalid size when not ready or out of range
+    QSizeF pageSize(const QString& documentHash, int pageNumber) const;
+    int pageRotation(const QString& documentHash, int pageNumber) const;
+
+    // Sum of rotated page heights for pages [0, uptoPage) plus spacing
+    // between them — the continuous-scroll offset of a page, and with
+    // uptoPage == pageCount the exact scrollbar range
+    double cumulativeHeight(const QString& documentHash, int uptoPage,
+                            double spacingPoints = 0.0) const;
+
+signals:
+    void geometryReady(const QString& documentHash, int pageCount);
+
+private:
+    explicit PageGeometryIndex(QObject* parent = nullptr);
+    ~PageGeometryIndex() override = default;
+
+    struct DocumentGeometry {
+        QVector<PageGeometry> pages;
+        QVector<double> heightPrefix;  // heightPrefix[n]: rotated heights
+                                       // of pages [0, n) summed
+        bool ready = false;
+        bool scanning = false;
+    };
+
+    static QString cacheFilePath(const QString& documentHash);
+    // Returns false when no cache file exists; m_mutex must be held
+    bool loadFromCacheLocked(const QString& documentHash);
+    static void saveToCache(const QString& documentHash,
+                            const QVector<PageGeometry>& pages);
+    static void buildPrefix(DocumentGeometry& geometry);
+
+    mutable QMutex m_mutex;
+    QHash<QString, DocumentGeometry> m_documents;
+};
@@ -0,0 +1,137 @@
+#include "PageLinkLayer.h"
+#include <algorithm>
+
+std::shared_ptr<PageLinkLayer> PageLinkLayer::build(Poppler::Page* page) {
+    if (!page) {
+        return nullptr;
+    }
+
+    const auto links = page->links();
+    if (links.empty()) {
+        return nullptr;
+    }
+
+    const QSizeF pageSize = page->pageSizeF();
+
+    // Collect first, then sort all three arrays by box top edge through
+    // an index permutation so the parallel vectors stay aligned
+    struct Entry {
+        QRectF box;
+        int targetPage;
+        QString url;
+    };
+    QVector<Entry> entries;
+    entries.reserve(static_cast<int>(links.size()));
+
+    for (const auto& link : links) {
+        // linkArea() is normalized to the page; scale to points so the
+        // boxes live in the same space as PageTextLayer word boxes
+        const QRectF area = link->linkArea().normalized();
+        const QRectF box(area.left() * pageSize.width(),
+                         area.top() * pageSize.height(),
+                         area.width() * pageSize.width(),
+                         area.height() * pageSize.height());
+        if (box.isEmpty()) {
+            continue;
+        }
+
+        if (link->linkType() == Poppler::Link::Goto) {
+            const auto* gotoLink =
+                static_cast<const Poppler::LinkGoto*>(link.get());
+            if (gotoLink->isExternal()) {
+                continue;  // Cross-file Goto links are not supported
+            }
+            // LinkDestination page numbers are one-based
+            entries.append(
+                {box, gotoLink->destination().pageNumber() - 1, QString()});
+        } else if (link->linkType() == Poppler::Link::Browse) {
+            const auto* browseLink =
+                static_cast<const Poppler::LinkBrowse*>(link.get());
+            if (!browseLink->url().isEmpty()) {
+                entries.append({box, -1, browseLink->url()});
+            }
+        }
+        // Other link types (actions, movies, ...) are ignored
+    }
+
+    if (entries.isEmpty()) {
+        return nullptr;
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) {
+                  return a.box.top() < b.box.top();
+              });
+
+    // Can't use make_shared with a private constructor
+    std::shared_ptr<PageLinkLayer> layer(new PageLinkLayer());
+    layer->m_boxes.reserve(entries.size());
+    layer->m_targetPages.reserve(entries.size());
+    layer->m_urls.reserve(entries.size());
+    for (const Entry& entry : entries) {
+        layer->m_boxes.append(entry.box);
+        layer->m_targetPages.append(entry.targetPage);
+        layer->m_urls.append(entry.url);
+        layer->m_maxBoxHeight =
+            qMax(layer->m_maxBoxHeight, entry.box.height());
+    }
+    return layer;
+}
+
+std::shared_ptr<PageLinkLayer> PageLinkLayer::restore(
+    QVector<QRectF> boxes, QVector<int> targetPages, QVector<QString> urls) {
+    if (boxes.isEmpty() || boxes.size() != targetPages.size() ||
+        boxes.size() != urls.size()) {
+        return nullptr;
+    }
+
+    std::shared_ptr<PageLinkLayer> layer(new PageLinkLayer());
+    layer->m_boxes = std::move(boxes);
+    layer->m_targetPages = std::move(targetPages);
+    layer->m_urls = std::move(urls);
+    for (const QRectF& box : layer->m_boxes) {
+        layer->m_maxBoxHeight = qMax(layer->m_maxBoxHeight, box.height());
+    }
+    return layer;
+}
+
+QRectF PageLinkLayer::linkBox(int index) const {
+    if (index < 0 || index >= m_boxes.size()) {
+        return QRectF();
+    }
+    return m_boxes[index];
+}
+
+int PageLinkLayer::targetPage(int index) const {
+    if (index < 0 || index >= m_targetPages.size()) {
+        return -1;
+    }
+    return m_targetPages[index];
+}
+
+QString PageLinkLayer::url(int index) const {
+    if (index < 0 || index >= m_urls.size()) {
+        return QString();
+    }
+    return m_urls[index];
+}
+
+int PageLinkLayer::linkIndexAt(const QPointF& pagePoint) const {
+    // First box starting below the point; everything containing the
+    // point starts at or above it, within m_maxBoxHeight of the cursor
+    auto it = std::upper_bound(
+        m_boxes.begin(), m_boxes.end(), pagePoint.y(),
+        [](double y, const QRectF& box) { return y < box.top(); });
+
+    const double lowestRelevantTop = pagePoint.y() - m_maxBoxHeight;
+    while (it != m_boxes.begin()) {
+        --it;
+        if (it->top() < lowestRelevantTop) {
+            break;
+        }
+        if (it->contains(pagePoint)) {
+            return static_cast<int>(it - m_boxes.begin());
+        }
+    }
+    return -1;
+}
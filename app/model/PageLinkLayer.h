@@ -0,0 +1,65 @@
+#pragma once
+
+#include <poppler-qt6.h>
+#include <QPointF>
+#include <QRectF>
+#include <QString>
+#include <QVector>
+#include <memory>
+
+/**
+ * Immutable link-region list for one page: every navigable link
+ * annotation's bounding box and target, extracted from Poppler once and
+ * hit-tested from then on.
+ *
+ * Storage is structure-of-arrays like PageTextLayer — parallel box /
+ * target-page / URL vectors, sorted by box top edge. Hit-testing binary
+ * searches the sorted tops and walks back at most the tallest box's
+ * span, so a hover query is allocation-free and touches a handful of
+ * entries even on link-dense index pages.
+ *
+ * Instances are built off the GUI thread and shared read-only, so no
+ * locking is needed after construction.
+ */
+class PageLinkLayer {
+public:
+    // Extracts the page's Goto/Browse links; returns null for pages
+    // without any (the common case), so callers can skip hit-testing
+    // entirely
+    static std::shared_ptr<PageLinkLayer> build(Poppler::Page* page);
+
+    // Rebuilds a layer from serialized vectors (persistent search
+    // index); entries must already be sorted by box top. Returns null
+    // if the vectors are inconsistent or empty
+    static std::shared_ptr<PageLinkLayer> restore(QVector<QRectF> boxes,
+                                                  QVector<int> targetPages,
+                                                  QVector<QString> urls);
+
+    int linkCount() const { return m_boxes.size(); }
+
+    // Raw vectors for serialization; parallel, sorted by box top
+    const QVector<QRectF>& linkBoxes() const { return m_boxes; }
+    const QVector<int>& targetPages() const { return m_targetPages; }
+    const QVector<QString>& urls() const { return m_urls; }
+
+    // Bounding box of link i in PDF coordinates (points)
+    QRectF linkBox(int index) const;
+
+    // Zero-based target page for an internal link, -1 for external
+    int targetPage(int index) const;
+
+    // Target URL for an external link, empty for internal
+    QString url(int index) const;
+
+    // Index of the link whose box contains the point (PDF coordinates,
+    // points), or -1. Allocation-free; safe on the mouse-move path
+    int linkIndexAt(const QPointF& pagePoint) const;
+
+private:
+    PageLinkLayer() = default;
+
+    QVector<QRectF> m_boxes;  // PDF coordinates (points), sorted by top
+    QVector<int> m_targetPages;
+    QVector<QString> m_urls;
+    double m_maxBoxHeight = 0.0;  // Bounds the backward scan in hit-tests
+};
@@ -1,4 +1,5 @@
 #include "PageModel.h"
+#include "PageMutationPlan.h"
 #include "RenderModel.h"
 
 PageModel::PageModel(int totalPages, QObject* parent)
@@ -18,11 +19,54 @@ int PageModel::totalPages() const { return _totalPages; }
 void PageModel::setCurrentPage(int pageNum) {
     if (pageNum >= 1 && pageNum <= _totalPages && pageNum != _currentPage) {
         _currentPage = pageNum;
+        if (_batchDepth > 0) {
+            _batchDirty = true;  // 渲染与通知推迟到endUpdateBatch
+            return;
+        }
         _renderModel->renderPage(_currentPage - 1);  // 调用renderPage时页数减1
         emit pageUpdate(_currentPage, _totalPages);
     }
 }
 
+void PageModel::beginUpdateBatch() { ++_batchDepth; }
+
+void PageModel::endUpdateBatch() {
+    if (_batchDepth == 0) {
+        return;
+    }
+    if (--_batchDepth == 0 && _batchDirty) {
+        _batchDirty = false;
+        if (_renderModel) {
+            _renderModel->renderPage(_currentPage - 1);
+        }
+        emit pageUpdate(_currentPage, _totalPages);
+    }
+}
+
+void PageModel::applyPageMapping(const PageIndexMap& map) {
+    if (map.isIdentity()) {
+        return;
+    }
+    const int oldIndex = _currentPage - 1;
+    int newIndex = map.mapFromOld(oldIndex);
+    if (newIndex < 0) {
+        // 当前页被删除：落在原位置的后继页，尾页删除则退到新尾页
+        newIndex = qMin(oldIndex, map.newPageCount() - 1);
+    }
+    _totalPages = map.newPageCount();
+    _currentPage = qMax(1, newIndex + 1);
+
+    // 渲染与通知只发生一次；批量作用域内照常推迟到endUpdateBatch
+    if (_batchDepth > 0) {
+        _batchDirty = true;
+        return;
+    }
+    if (_renderModel && _totalPages > 0) {
+        _renderModel->renderPage(_currentPage - 1);
+    }
+    emit pageUpdate(_currentPage, _totalPages);
+}
+
 void PageModel::nextPage() {
     if (_currentPage < _totalPages) {
         int nextPage = _currentPage + 1;
@@ -5,6 +5,8 @@
 #include <QSharedPointer>
 #include "RenderModel.h"
 
+class PageIndexMap;
+
 class PageModel : public QObject {
     Q_OBJECT
 
@@ -19,6 +21,15 @@ public:
     void nextPage();
     void prevPage();
 
+    // 批量更新作用域：begin/end之间的页码变更不触发渲染与pageUpdate，
+    // end时只对最终状态渲染并通知一次（可嵌套，见CompositeCommand）
+    void beginUpdateBatch();
+    void endUpdateBatch();
+
+    // 批量页面操作落账：页数与当前页按索引映射一次更新到位；
+    // 当前页被删除时停留在原位置的后继页
+    void applyPageMapping(const PageIndexMap& map);
+
     ~PageModel(){};
 
 public slots:
@@ -31,4 +42,6 @@ private:
     int _totalPages;
     int _currentPage;
     RenderModel* _renderModel;
+    int _batchDepth = 0;
+    bool _batchDirty = false;
 };
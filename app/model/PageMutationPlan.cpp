@@ -0,0 +1,88 @@
+#include "PageMutationPlan.h"
+
+int PageIndexMap::mapFromOld(int oldIndex) const {
+    if (oldIndex < 0 || oldIndex >= m_newForOld.size()) {
+        return -1;
+    }
+    return m_newForOld[oldIndex];
+}
+
+int PageIndexMap::mapToOld(int newIndex) const {
+    if (newIndex < 0 || newIndex >= m_oldForNew.size()) {
+        return -1;
+    }
+    return m_oldForNew[newIndex];
+}
+
+void PageMutationPlan::removePages(int start, int count) {
+    m_ops.append({Operation::Remove, start, count, 0});
+}
+
+void PageMutationPlan::movePages(int start, int count, int destination) {
+    m_ops.append({Operation::Move, start, count, destination});
+}
+
+void PageMutationPlan::insertPages(int before, int count) {
+    m_ops.append({Operation::Insert, before, count, 0});
+}
+
+PageIndexMap PageMutationPlan::compile(int pageCount) const {
+    PageIndexMap map;
+    pageCount = qMax(0, pageCount);
+
+    // The working state is simply the new order expressed in old
+    // indices; every operation is a splice on this one vector
+    QVector<int>& order = map.m_oldForNew;
+    order.resize(pageCount);
+    for (int i = 0; i < pageCount; ++i) {
+        order[i] = i;
+    }
+
+    for (const Operation& op : m_ops) {
+        const int start = qBound(0, op.start, int(order.size()));
+        switch (op.kind) {
+            case Operation::Remove: {
+                const int count =
+                    qBound(0, op.count, int(order.size()) - start);
+                order.remove(start, count);
+                break;
+            }
+            case Operation::Insert: {
+                order.insert(start, qMax(0, op.count), -1);
+                break;
+            }
+            case Operation::Move: {
+                const int count =
+                    qBound(0, op.count, int(order.size()) - start);
+                if (count == 0) {
+                    break;
+                }
+                const QVector<int> block = order.mid(start, count);
+                order.remove(start, count);
+                const int dest =
+                    qBound(0, op.destination, int(order.size()));
+                for (int j = 0; j < count; ++j) {
+                    order.insert(dest + j, block[j]);
+                }
+                break;
+            }
+        }
+    }
+
+    map.m_newForOld = QVector<int>(pageCount, -1);
+    for (int i = 0; i < order.size(); ++i) {
+        if (order[i] >= 0) {
+            map.m_newForOld[order[i]] = i;
+        }
+    }
+
+    for (int i = 0; i < order.size(); ++i) {
+        if (order[i] != i) {
+            if (map.m_firstChanged < 0) {
+                map.m_firstChanged = i;
+            }
+            map.m_lastChanged = i;
+        }
+    }
+    return map;
+}
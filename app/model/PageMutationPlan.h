@@ -0,0 +1,92 @@
+#pragma once
+
+#include <QVector>
+
+/**
+ * Old-to-new page index translation produced by compiling a
+ * PageMutationPlan.
+ *
+ * Derived state keyed by page index (thumbnails, cache entries, the
+ * current page) survives a bulk mutation by translating its indices
+ * through the map instead of being regenerated. The map also carries
+ * the diff range — the span of new indices whose backing page changed —
+ * so models can notify views once over the affected rows rather than
+ * once per touched page.
+ */
+class PageIndexMap {
+public:
+    int oldPageCount() const { return m_newForOld.size(); }
+    int newPageCount() const { return m_oldForNew.size(); }
+
+    // New index of an old page, -1 if the mutation removed it
+    int mapFromOld(int oldIndex) const;
+
+    // Old index backing a new page, -1 if the mutation inserted it
+    int mapToOld(int newIndex) const;
+
+    // Inclusive range of new indices whose backing page differs from
+    // the page previously at that index; [-1, -1] when every surviving
+    // index is unchanged (tail removals and appends change only the
+    // count, which models handle through their row-count signals)
+    int firstChanged() const { return m_firstChanged; }
+    int lastChanged() const { return m_lastChanged; }
+
+    // True when the mutation changed nothing at all
+    bool isIdentity() const {
+        return m_firstChanged < 0 &&
+               m_oldForNew.size() == m_newForOld.size();
+    }
+
+private:
+    friend class PageMutationPlan;
+
+    QVector<int> m_oldForNew;  // new index -> old index (-1 = inserted)
+    QVector<int> m_newForOld;  // old index -> new index (-1 = removed)
+    int m_firstChanged = -1;
+    int m_lastChanged = -1;
+};
+
+/**
+ * Bulk page-mutation transaction: a sequence of page-set operations
+ * (delete range, reorder, insert) compiled into one PageIndexMap.
+ *
+ * Editing flows queue every operation of a user action here and apply
+ * the compiled map to each derived model exactly once. A 500-page
+ * extract-and-reorder then costs one hash remap per model and a single
+ * view notification instead of a per-page update storm — the expensive
+ * artifacts (thumbnail pixmaps, cached renders) move to their new
+ * indices untouched.
+ *
+ * Operations see the page sequence as left by the operations queued
+ * before them, matching the order a user performs them in.
+ */
+class PageMutationPlan {
+public:
+    // Queue removal of pages [start, start + count)
+    void removePages(int start, int count);
+
+    // Queue moving the block [start, start + count) so that it begins
+    // at destination in the post-move sequence
+    void movePages(int start, int count, int destination);
+
+    // Queue count new pages inserted before index `before`
+    void insertPages(int before, int count);
+
+    bool isEmpty() const { return m_ops.isEmpty(); }
+    int operationCount() const { return m_ops.size(); }
+
+    // Applies the queued operations in order against a document of
+    // pageCount pages; out-of-range spans are clamped, not errors
+    PageIndexMap compile(int pageCount) const;
+
+private:
+    struct Operation {
+        enum Kind { Remove, Move, Insert };
+        Kind kind;
+        int start;
+        int count;
+        int destination;  // Move only
+    };
+
+    QVector<Operation> m_ops;
+};
@@ -0,0 +1,239 @@
+#include "PageTextLayer.h"
+#include <algorithm>
+
+std::shared_ptr<PageTextLayer> PageTextLayer::build(Poppler::Page* page) {
+    if (!page) {
+        return nullptr;
+    }
+
+    const auto textBoxes = page->textList();
+    if (textBoxes.empty()) {
+        return nullptr;
+    }
+
+    // Can't use make_shared with a private constructor
+    std::shared_ptr<PageTextLayer> layer(new PageTextLayer());
+    layer->m_pageSize = page->pageSizeF();
+    layer->m_wordStart.reserve(static_cast<int>(textBoxes.size()));
+    layer->m_wordLength.reserve(static_cast<int>(textBoxes.size()));
+    layer->m_wordBoxes.reserve(static_cast<int>(textBoxes.size()));
+
+    for (const auto& box : textBoxes) {
+        const QString word = box->text();
+        if (word.isEmpty()) {
+            continue;
+        }
+        layer->m_wordStart.append(layer->m_text.length());
+        layer->m_wordLength.append(word.length());
+        layer->m_wordBoxes.append(box->boundingBox());
+        layer->m_text += word;
+        if (box->hasSpaceAfter()) {
+            layer->m_text += QLatin1Char(' ');
+        }
+    }
+
+    if (layer->m_wordStart.isEmpty()) {
+        return nullptr;
+    }
+
+    layer->buildGrid();
+    return layer;
+}
+
+std::shared_ptr<PageTextLayer> PageTextLayer::restore(
+    QString text, QVector<int> wordStarts, QVector<int> wordLengths,
+    QVector<QRectF> wordBoxes, const QSizeF& pageSize) {
+    // A corrupt index file must never produce a layer that answers
+    // queries out of bounds; cheap consistency checks reject it instead
+    if (wordStarts.isEmpty() || wordStarts.size() != wordLengths.size() ||
+        wordStarts.size() != wordBoxes.size()) {
+        return nullptr;
+    }
+    const int lastWord = wordStarts.size() - 1;
+    if (wordStarts.last() < 0 ||
+        wordStarts.last() + wordLengths.last() > text.size() ||
+        wordLengths[lastWord] < 0) {
+        return nullptr;
+    }
+
+    std::shared_ptr<PageTextLayer> layer(new PageTextLayer());
+    layer->m_text = std::move(text);
+    layer->m_wordStart = std::move(wordStarts);
+    layer->m_wordLength = std::move(wordLengths);
+    layer->m_wordBoxes = std::move(wordBoxes);
+    layer->m_pageSize = pageSize;
+    layer->buildGrid();
+    return layer;
+}
+
+QString PageTextLayer::word(int index) const {
+    if (index < 0 || index >= m_wordStart.size()) {
+        return QString();
+    }
+    return m_text.mid(m_wordStart[index], m_wordLength[index]);
+}
+
+QRectF PageTextLayer::wordBox(int index) const {
+    if (index < 0 || index >= m_wordBoxes.size()) {
+        return QRectF();
+    }
+    return m_wordBoxes[index];
+}
+
+void PageTextLayer::buildGrid() {
+    m_grid.resize(GRID_DIM * GRID_DIM);
+
+    const double cellWidth = m_pageSize.width() / GRID_DIM;
+    const double cellHeight = m_pageSize.height() / GRID_DIM;
+    if (cellWidth <= 0.0 || cellHeight <= 0.0) {
+        return;
+    }
+
+    for (int i = 0; i < m_wordBoxes.size(); ++i) {
+        const QRectF& box = m_wordBoxes[i];
+        const int firstColumn =
+            qBound(0, static_cast<int>(box.left() / cellWidth), GRID_DIM - 1);
+        const int lastColumn =
+            qBound(0, static_cast<int>(box.right() / cellWidth), GRID_DIM - 1);
+        const int firstRow =
+            qBound(0, static_cast<int>(box.top() / cellHeight), GRID_DIM - 1);
+        const int lastRow =
+            qBound(0, static_cast<int>(box.bottom() / cellHeight),
+                   GRID_DIM - 1);
+        for (int row = firstRow; row <= lastRow; ++row) {
+            for (int column = firstColumn; column <= lastColumn; ++column) {
+                m_grid[cellIndex(column, row)].append(i);
+            }
+        }
+    }
+}
+
+int PageTextLayer::wordIndexAt(const QPointF& pagePoint) const {
+    const double cellWidth = m_pageSize.width() / GRID_DIM;
+    const double cellHeight = m_pageSize.height() / GRID_DIM;
+    if (cellWidth <= 0.0 || cellHeight <= 0.0 || m_grid.isEmpty()) {
+        return -1;
+    }
+
+    const int column =
+        qBound(0, static_cast<int>(pagePoint.x() / cellWidth), GRID_DIM - 1);
+    const int row =
+        qBound(0, static_cast<int>(pagePoint.y() / cellHeight), GRID_DIM - 1);
+
+    for (int wordIndex : m_grid[cellIndex(column, row)]) {
+        if (m_wordBoxes[wordIndex].contains(pagePoint)) {
+            return wordIndex;
+        }
+    }
+    return -1;
+}
+
+int PageTextLayer::wordIndexNear(const QPointF& pagePoint) const {
+    const int exact = wordIndexAt(pagePoint);
+    if (exact >= 0) {
+        return exact;
+    }
+
+    const double cellWidth = m_pageSize.width() / GRID_DIM;
+    const double cellHeight = m_pageSize.height() / GRID_DIM;
+    if (cellWidth <= 0.0 || cellHeight <= 0.0 || m_grid.isEmpty()) {
+        return -1;
+    }
+
+    const int column =
+        qBound(0, static_cast<int>(pagePoint.x() / cellWidth), GRID_DIM - 1);
+    const int row =
+        qBound(0, static_cast<int>(pagePoint.y() / cellHeight), GRID_DIM - 1);
+
+    int best = -1;
+    double bestDistance = 0.0;
+    for (int r = qMax(0, row - 1); r <= qMin(GRID_DIM - 1, row + 1); ++r) {
+        for (int c = qMax(0, column - 1); c <= qMin(GRID_DIM - 1, column + 1);
+             ++c) {
+            for (int wordIndex : m_grid[cellIndex(c, r)]) {
+                const QPointF delta =
+                    m_wordBoxes[wordIndex].center() - pagePoint;
+                const double distance =
+                    delta.x() * delta.x() + delta.y() * delta.y();
+                if (best < 0 || distance < bestDistance) {
+                    best = wordIndex;
+                    bestDistance = distance;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+QVector<int> PageTextLayer::wordsInRect(const QRectF& pageRect) const {
+    QVector<int> result;
+    const double cellWidth = m_pageSize.width() / GRID_DIM;
+    const double cellHeight = m_pageSize.height() / GRID_DIM;
+    if (cellWidth <= 0.0 || cellHeight <= 0.0 || m_grid.isEmpty()) {
+        return result;
+    }
+
+    const int firstColumn =
+        qBound(0, static_cast<int>(pageRect.left() / cellWidth), GRID_DIM - 1);
+    const int lastColumn =
+        qBound(0, static_cast<int>(pageRect.right() / cellWidth), GRID_DIM - 1);
+    const int firstRow =
+        qBound(0, static_cast<int>(pageRect.top() / cellHeight), GRID_DIM - 1);
+    const int lastRow = qBound(
+        0, static_cast<int>(pageRect.bottom() / cellHeight), GRID_DIM - 1);
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            for (int wordIndex : m_grid[cellIndex(column, row)]) {
+                if (m_wordBoxes[wordIndex].intersects(pageRect)) {
+                    result.append(wordIndex);
+                }
+            }
+        }
+    }
+
+    // A box spanning several cells is collected once per cell; sorting
+    // into reading order also lets us drop the duplicates
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+int PageTextLayer::firstWordNotBefore(int charOffset) const {
+    // Last word starting at or before charOffset — its span may still
+    // cover the offset
+    auto it = std::upper_bound(m_wordStart.begin(), m_wordStart.end(),
+                               charOffset);
+    if (it != m_wordStart.begin()) {
+        --it;
+    }
+    return static_cast<int>(it - m_wordStart.begin());
+}
+
+QVector<QRectF> PageTextLayer::boxesForRange(int charStart,
+                                             int charLength) const {
+    QVector<QRectF> boxes;
+    if (charLength <= 0 || m_wordStart.isEmpty()) {
+        return boxes;
+    }
+
+    const int charEnd = charStart + charLength;
+    for (int i = firstWordNotBefore(charStart); i < m_wordStart.size(); ++i) {
+        if (m_wordStart[i] >= charEnd) {
+            break;
+        }
+        if (m_wordStart[i] + m_wordLength[i] > charStart) {
+            boxes.append(m_wordBoxes[i]);
+        }
+    }
+    return boxes;
+}
+
+QRectF PageTextLayer::boundingBoxForRange(int charStart, int charLength) const {
+    QRectF united;
+    const QVector<QRectF> boxes = boxesForRange(charStart, charLength);
+    for (const QRectF& box : boxes) {
+        united = united.isNull() ? box : united.united(box);
+    }
+    return united;
+}
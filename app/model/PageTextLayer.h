@@ -0,0 +1,87 @@
+#pragma once
+
+#include <poppler-qt6.h>
+#include <QPointF>
+#include <QRectF>
+#include <QString>
+#include <QVector>
+#include <memory>
+
+/**
+ * Immutable text layer for one page: every word's string and bounding
+ * box, extracted from Poppler once and queried from then on.
+ *
+ * Storage is structure-of-arrays — one concatenated text string plus
+ * parallel start/length/box vectors — so a page with thousands of words
+ * costs three flat allocations instead of a node per word. A uniform
+ * grid over the page bounds backs spatial queries (hit-testing for
+ * selection, highlight placement), and character-offset queries binary
+ * search the word starts, so neither path goes back to Poppler.
+ *
+ * Instances are built off the GUI thread and shared read-only, so no
+ * locking is needed after construction.
+ */
+class PageTextLayer {
+public:
+    // Extracts the page's word list; returns null for pages without a
+    // text layer (pure image scans)
+    static std::shared_ptr<PageTextLayer> build(Poppler::Page* page);
+
+    // Rebuilds a layer from serialized vectors (persistent search
+    // index); the spatial grid is reconstructed. Returns null if the
+    // vectors are inconsistent
+    static std::shared_ptr<PageTextLayer> restore(QString text,
+                                                  QVector<int> wordStarts,
+                                                  QVector<int> wordLengths,
+                                                  QVector<QRectF> wordBoxes,
+                                                  const QSizeF& pageSize);
+
+    // Concatenated page text; word i spans [wordStart(i),
+    // wordStart(i) + wordLength(i)) within it
+    const QString& text() const { return m_text; }
+    int wordCount() const { return m_wordStart.size(); }
+    QString word(int index) const;
+    QRectF wordBox(int index) const;
+    const QVector<int>& wordStarts() const { return m_wordStart; }
+    // Raw vectors for serialization; parallel to wordStarts()
+    const QVector<int>& wordLengths() const { return m_wordLength; }
+    const QVector<QRectF>& wordBoxes() const { return m_wordBoxes; }
+    QSizeF pageSize() const { return m_pageSize; }
+
+    // Index of the word whose box contains the point (PDF coordinates,
+    // points), or -1
+    int wordIndexAt(const QPointF& pagePoint) const;
+
+    // Like wordIndexAt, but falls back to the nearest word within the
+    // surrounding grid cells so a drag through whitespace still tracks
+    // the text; -1 only far from any text
+    int wordIndexNear(const QPointF& pagePoint) const;
+
+    // Indices of all words whose boxes intersect the rectangle, in
+    // reading order
+    QVector<int> wordsInRect(const QRectF& pageRect) const;
+
+    // Boxes covering the character range [charStart, charStart +
+    // charLength) — one rect per touched word
+    QVector<QRectF> boxesForRange(int charStart, int charLength) const;
+
+    // United box of the range, null if it touches no word
+    QRectF boundingBoxForRange(int charStart, int charLength) const;
+
+private:
+    PageTextLayer() = default;
+
+    int firstWordNotBefore(int charOffset) const;
+    void buildGrid();
+    int cellIndex(int column, int row) const { return row * GRID_DIM + column; }
+
+    QString m_text;
+    QVector<int> m_wordStart;
+    QVector<int> m_wordLength;
+    QVector<QRectF> m_wordBoxes;  // PDF coordinates (points)
+
+    QSizeF m_pageSize;
+    QVector<QVector<int>> m_grid;  // Word indices intersecting each cell
+
+    static constexpr int GRID_DIM = 16;
+};
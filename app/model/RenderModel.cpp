@@ -1,32 +1,303 @@
 #include "RenderModel.h"
+#include <QGuiApplication>
+#include "cache/PDFCacheManager.h"
+#include "managers/RenderWorkerPool.h"
+#include "model/DocumentSnapshot.h"
+#include "model/PageClassifier.h"
+#include "utils/PDFUtilities.h"
 #include "qimage.h"
 #include "qlogging.h"
 #include "utils/LoggingMacros.h"
+#include "utils/MappedImagePool.h"
+#include "utils/PerfTracer.h"
+#include "utils/RenderPolicy.h"
+
+// Resolves the document's on-disk path when sandboxed rendering is on;
+// returns an empty string (in-process render) otherwise. Workers are
+// separate processes and need a path, not a Poppler handle.
+static QString sandboxPathFor(Poppler::Document* document) {
+    if (!RenderWorkerPool::instance().isEnabled()) {
+        return QString();
+    }
+    if (auto snapshot = DocumentSnapshot::forDocument(document)) {
+        return snapshot->filePath();
+    }
+    return QString();
+}
+
+// Pooled page when a snapshot is registered, a fresh page from the
+// shared handle otherwise. The lease/unique_ptr pair owns the page for
+// the caller's scope; only the returned raw pointer should be used.
+static Poppler::Page* acquirePage(Poppler::Document* document, int pageNum,
+                                  DocumentSnapshot::PageLease& lease,
+                                  std::unique_ptr<Poppler::Page>& owned) {
+    if (auto snapshot = DocumentSnapshot::forDocument(document)) {
+        lease = snapshot->leasePage(pageNum);
+        if (lease) {
+            return lease.get();
+        }
+    }
+    owned = document->page(pageNum);
+    return owned.get();
+}
 
 RenderModel::RenderModel(double dpiX, double dpiY, Poppler::Document *_document,
                          QObject *parent)
-    : document(_document), QObject(parent), dpiX(dpiX), dpiY(dpiY) {}
+    : document(_document),
+      cacheManager(nullptr),
+      cacheNamespaceResolved(false),
+      QObject(parent),
+      dpiX(dpiX),
+      dpiY(dpiY) {}
+
+const QString &RenderModel::cacheNamespace() {
+    if (!cacheNamespaceResolved) {
+        documentCacheNamespace =
+            PDFCacheManager::namespaceForDocument(document);
+        cacheNamespaceResolved = true;
+    }
+    return documentCacheNamespace;
+}
 
 QImage RenderModel::renderPage(int pageNum, double xres, double yres, int x,
                                int y, int w, int h) {
+    PERF_TRACE_SCOPE("RenderModel::renderPage");
     if (!document) {
         LOG_WARNING("Document not loaded");
         return QImage();
     }
-    std::unique_ptr<Poppler::Page> pdfPage = document->page(pageNum);
+    // dpiX/dpiY hold the widget's logical DPI; scaling by the device
+    // pixel ratio renders exactly native resolution, instead of the
+    // old blanket 2x that quadrupled pixel counts on 100% displays
+    const double dpr = qGuiApp->devicePixelRatio();
+    double renderXDpi =
+        RenderPolicy::pageDpi(dpr, dpiX / RenderPolicy::BASE_DPI);
+    double renderYDpi =
+        RenderPolicy::pageDpi(dpr, dpiY / RenderPolicy::BASE_DPI);
+
+    // Image-dominant pages (scans, photos) are fixed-resolution rasters:
+    // asking Poppler for more DPI than the cap just upscales the embedded
+    // bitmap at full rasterizer cost. Those pages render at the cap and
+    // the result is scaled to the requested size instead. fullSize stays
+    // empty when no cap applies
+    QSize fullSize;
+    const PageClassifier::PageClass knownClass =
+        PageClassifier::instance().cachedClass(cacheNamespace(), pageNum);
+    if (knownClass == PageClassifier::PageClass::ImageDominant &&
+        renderXDpi > PageClassifier::IMAGE_PAGE_DPI_CAP) {
+        fullSize = pageSizePixels(pageNum, renderXDpi, renderYDpi);
+        renderXDpi = PageClassifier::IMAGE_PAGE_DPI_CAP;
+        renderYDpi = PageClassifier::IMAGE_PAGE_DPI_CAP;
+    }
+
+    const QString sandboxPath = sandboxPathFor(document);
+    if (!sandboxPath.isEmpty()) {
+        QImage image = RenderWorkerPool::instance().render(
+            sandboxPath, pageNum, renderXDpi, renderYDpi);
+        if (!image.isNull()) {
+            if (!fullSize.isEmpty()) {
+                // At print DPI the full-size buffer runs to hundreds of
+                // megabytes; it draws into a file-backed scratch
+                // mapping instead of the heap
+                image = MappedImagePool::instance().upscaled(image, fullSize);
+            }
+            emit renderPageDone(image);
+            return image;
+        }
+        // Worker unavailable or crashed on this page; fall through to
+        // the in-process renderer
+    }
+
+    DocumentSnapshot::PageLease lease;
+    std::unique_ptr<Poppler::Page> owned;
+    Poppler::Page* pdfPage = acquirePage(document, pageNum, lease, owned);
     if (!pdfPage) {
         LOG_WARNING("Page not found: {}", pageNum);
         return QImage();
     }
-    QImage image = pdfPage->renderToImage(dpiX * 2, dpiY * 2);
+
+    // Classify on the handle we already hold (cached after the first
+    // render of the page). Sandboxed renders above never classify —
+    // probing would run Poppler in-process on an untrusted file — so
+    // they only benefit once an in-process render has seen the page
+    const PageClassifier::PageClass pageClass =
+        PageClassifier::instance().classify(cacheNamespace(), pageNum,
+                                            pdfPage);
+
+    // Zero-rerender fast path for scanned pages: when the page's entire
+    // content is one embedded full-page JPEG, decode the original
+    // stream at the target size instead of having Poppler rasterize it
+    if (pageClass == PageClassifier::PageClass::ImageDominant) {
+        if (auto snapshot = DocumentSnapshot::forDocument(document)) {
+            const QSize targetSize =
+                !fullSize.isEmpty()
+                    ? fullSize
+                    : RenderPolicy::targetSizePixels(pdfPage->pageSizeF(),
+                                                     renderXDpi, renderYDpi);
+            const PDFUtilities::EmbeddedPageImage embedded =
+                PDFUtilities::extractEmbeddedPageImage(
+                    snapshot->filePath(), pageNum, document->numPages(),
+                    pdfPage->pageSizeF());
+            if (embedded.valid) {
+                QImage image = embedded.decode(targetSize);
+                if (!image.isNull()) {
+                    emit renderPageDone(image);
+                    return image;
+                }
+            }
+        }
+    }
+
+    if (fullSize.isEmpty() &&
+        pageClass == PageClassifier::PageClass::ImageDominant &&
+        renderXDpi > PageClassifier::IMAGE_PAGE_DPI_CAP) {
+        fullSize = pageSizePixels(pageNum, renderXDpi, renderYDpi);
+        renderXDpi = PageClassifier::IMAGE_PAGE_DPI_CAP;
+        renderYDpi = PageClassifier::IMAGE_PAGE_DPI_CAP;
+    }
+
+    QImage image = pdfPage->renderToImage(renderXDpi, renderYDpi);
     if (image.isNull()) {
         LOG_ERROR("Failed to render page: {}", pageNum);
         return QImage();
     }
+    if (!fullSize.isEmpty()) {
+        image = MappedImagePool::instance().upscaled(image, fullSize);
+    }
+    // Color-free pages carry on through caches and widgets as 8-bit
+    // grayscale; the probe already ran inside classify() above
+    image = RenderPolicy::toStorageFormat(
+        image, PageClassifier::instance().pageHasColor(cacheNamespace(),
+                                                       pageNum, pdfPage));
     emit renderPageDone(image);
     return image;
 }
 
+QSize RenderModel::pageSizePixels(int pageNum, double xres, double yres) {
+    if (!document) {
+        return QSize();
+    }
+    DocumentSnapshot::PageLease lease;
+    std::unique_ptr<Poppler::Page> owned;
+    Poppler::Page* pdfPage = acquirePage(document, pageNum, lease, owned);
+    if (!pdfPage) {
+        return QSize();
+    }
+    // Poppler reports page size in points (1/72 inch)
+    return RenderPolicy::targetSizePixels(pdfPage->pageSizeF(), xres, yres);
+}
+
+QImage RenderModel::renderTile(int pageNum, double xres, double yres, int tileX,
+                               int tileY) {
+    PERF_TRACE_SCOPE("RenderModel::renderTile");
+    if (!document) {
+        LOG_WARNING("Document not loaded");
+        return QImage();
+    }
+
+    if (cacheManager) {
+        // Namespaced by content hash when known, so tabs viewing the
+        // same file share tiles through the process-global cache
+        QImage cached = cacheNamespace().isEmpty()
+                            ? cacheManager->getTile(pageNum, tileX, tileY,
+                                                    xres, yres)
+                            : cacheManager->getTile(cacheNamespace(), pageNum,
+                                                    tileX, tileY, xres, yres);
+        if (!cached.isNull()) {
+            return cached;
+        }
+    }
+
+    DocumentSnapshot::PageLease lease;
+    std::unique_ptr<Poppler::Page> owned;
+    Poppler::Page* pdfPage = acquirePage(document, pageNum, lease, owned);
+    if (!pdfPage) {
+        LOG_WARNING("Page not found: {}", pageNum);
+        return QImage();
+    }
+
+    QSize pageSize = pageSizePixels(pageNum, xres, yres);
+    int x = tileX * TILE_SIZE;
+    int y = tileY * TILE_SIZE;
+    if (x >= pageSize.width() || y >= pageSize.height() || tileX < 0 ||
+        tileY < 0) {
+        LOG_WARNING("Tile ({}, {}) outside page {}", tileX, tileY, pageNum);
+        return QImage();
+    }
+    // Edge tiles are clamped to the page bounds instead of padded
+    int w = qMin(TILE_SIZE, pageSize.width() - x);
+    int h = qMin(TILE_SIZE, pageSize.height() - y);
+
+    QImage tile;
+    const QString sandboxPath = sandboxPathFor(document);
+    if (!sandboxPath.isEmpty()) {
+        tile = RenderWorkerPool::instance().render(sandboxPath, pageNum, xres,
+                                                   yres, x, y, w, h);
+    }
+    if (tile.isNull()) {
+        tile = pdfPage->renderToImage(xres, yres, x, y, w, h);
+    }
+    if (tile.isNull()) {
+        LOG_ERROR("Failed to render tile ({}, {}) of page {}", tileX, tileY,
+                  pageNum);
+        return QImage();
+    }
+    tile = RenderPolicy::toStorageFormat(
+        tile, PageClassifier::instance().pageHasColor(cacheNamespace(),
+                                                      pageNum, pdfPage));
+
+    if (cacheManager) {
+        if (cacheNamespace().isEmpty()) {
+            cacheManager->cacheTile(pageNum, tileX, tileY, xres, yres, tile);
+        } else {
+            cacheManager->cacheTile(cacheNamespace(), pageNum, tileX, tileY,
+                                    xres, yres, tile);
+        }
+    }
+
+    emit renderTileDone(pageNum, QPoint(tileX, tileY), tile);
+    return tile;
+}
+
+QList<QPoint> RenderModel::tilesInViewport(int pageNum, double xres,
+                                           double yres, const QRect &viewport) {
+    QList<QPoint> tiles;
+    QSize pageSize = pageSizePixels(pageNum, xres, yres);
+    if (pageSize.isEmpty() || viewport.isEmpty()) {
+        return tiles;
+    }
+
+    QRect clipped = viewport.intersected(QRect(QPoint(0, 0), pageSize));
+    if (clipped.isEmpty()) {
+        return tiles;
+    }
+
+    int firstX = clipped.left() / TILE_SIZE;
+    int lastX = clipped.right() / TILE_SIZE;
+    int firstY = clipped.top() / TILE_SIZE;
+    int lastY = clipped.bottom() / TILE_SIZE;
+    for (int ty = firstY; ty <= lastY; ++ty) {
+        for (int tx = firstX; tx <= lastX; ++tx) {
+            tiles.append(QPoint(tx, ty));
+        }
+    }
+    return tiles;
+}
+
+QList<QImage> RenderModel::renderVisibleTiles(int pageNum, double xres,
+                                              double yres,
+                                              const QRect &viewport) {
+    QList<QImage> rendered;
+    const QList<QPoint> tiles = tilesInViewport(pageNum, xres, yres, viewport);
+    for (const QPoint &tile : tiles) {
+        QImage image = renderTile(pageNum, xres, yres, tile.x(), tile.y());
+        if (!image.isNull()) {
+            rendered.append(image);
+        }
+    }
+    return rendered;
+}
+
 int RenderModel::getPageCount() {
     if (!document) {
         return 0;
@@ -42,5 +313,12 @@ void RenderModel::setDocument(Poppler::Document *_document) {
     // 这里不能用reset，因为_document是外部传入的智能指针，
     //  app\model\DocumentModel.cpp已经reset()过了
     document = _document;  //  直接赋值防止重复reset导致崩溃
+    // 换文档后重新解析共享缓存命名空间
+    documentCacheNamespace.clear();
+    cacheNamespaceResolved = false;
     emit documentChanged(document);
 }
+
+void RenderModel::setCacheManager(PDFCacheManager *_cacheManager) {
+    cacheManager = _cacheManager;
+}
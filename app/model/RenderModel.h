@@ -4,27 +4,56 @@
 #include <QDebug>
 #include <QImage>
 #include <QObject>
+#include <QPoint>
+#include <QRect>
+#include <QSize>
 #include "qtmetamacros.h"
 
+class PDFCacheManager;
+
 class RenderModel : public QObject {
     Q_OBJECT
 
 public:
+    // Fixed edge length of a render tile in device pixels
+    static constexpr int TILE_SIZE = 512;
+
     RenderModel(double dpiX = 72.0, double dpiY = 72.0,
                 Poppler::Document* _document = nullptr,
                 QObject* parent = nullptr);
     QImage renderPage(int pageNum = 0, double xres = 72.0, double yres = 72.0,
                       int x = 0, int y = 0, int w = -1, int h = -1);
+
+    // Tile-based rendering: renders only the 512x512 region at tile index
+    // (tileX, tileY) so huge zoomed pages never allocate a full-page image.
+    QImage renderTile(int pageNum, double xres, double yres, int tileX,
+                      int tileY);
+    QList<QImage> renderVisibleTiles(int pageNum, double xres, double yres,
+                                     const QRect& viewport);
+    QSize pageSizePixels(int pageNum, double xres, double yres);
+    QList<QPoint> tilesInViewport(int pageNum, double xres, double yres,
+                                  const QRect& viewport);
+
     int getPageCount();
     void setDocument(Poppler::Document* _document);
+    void setCacheManager(PDFCacheManager* cacheManager);
     ~RenderModel() {}
 
 signals:
     void renderPageDone(QImage image);
+    void renderTileDone(int pageNum, QPoint tileIndex, QImage tile);
     void documentChanged(Poppler::Document* document);
 
 private:
+    // Content-hash namespace for the shared cache; resolved lazily and
+    // reset on document switch. Empty while the document is unknown to
+    // DocumentSnapshot (cache calls then use per-instance keys)
+    const QString& cacheNamespace();
+
     Poppler::Document* document;
+    PDFCacheManager* cacheManager;
+    QString documentCacheNamespace;
+    bool cacheNamespaceResolved;
     double dpiX;
     double dpiY;
 };
@@ -0,0 +1,258 @@
+#include "ReviewFileStreamer.h"
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPointer>
+#include <QSaveFile>
+#include "managers/RenderScheduler.h"
+#include "utils/LoggingMacros.h"
+
+namespace {
+
+const char HEADER_KIND[] = "readium-review";
+constexpr int FORMAT_VERSION = 1;
+
+}  // namespace
+
+ReviewFileStreamer::ReviewFileStreamer(QObject* parent)
+    : QObject(parent),
+      m_busy(false),
+      m_importedBookmarks(0),
+      m_importedAnnotations(0) {}
+
+void ReviewFileStreamer::setModels(BookmarkModel* bookmarks,
+                                   AnnotationModel* annotations) {
+    m_bookmarkModel = bookmarks;
+    m_annotationModel = annotations;
+}
+
+bool ReviewFileStreamer::importFile(const QString& filePath) {
+    if (m_busy) {
+        return false;
+    }
+    m_busy = true;
+    m_importedBookmarks = 0;
+    m_importedAnnotations = 0;
+
+    QPointer<ReviewFileStreamer> self(this);
+    RenderScheduler::instance().submit(
+        RenderScheduler::TaskClass::Background, [self, filePath]() {
+            // self may die while this job runs; every hop back checks
+            // first and uses self as the context so a late delivery is
+            // dropped automatically
+            QFile file(filePath);
+            if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+                if (!self) {
+                    return;
+                }
+                QMetaObject::invokeMethod(
+                    self,
+                    [self]() {
+                        if (!self) {
+                            return;
+                        }
+                        self->m_busy = false;
+                        emit self->importFinished(false, 0, 0,
+                                                  tr("Cannot open file"));
+                    },
+                    Qt::QueuedConnection);
+                return;
+            }
+
+            const qint64 totalBytes = file.size();
+
+            // Header line gates the rest: wrong kind means this is not a
+            // review file at all, not a partially-usable one
+            QJsonObject header =
+                QJsonDocument::fromJson(file.readLine()).object();
+            if (header["kind"].toString() != HEADER_KIND ||
+                header["version"].toInt() > FORMAT_VERSION) {
+                if (!self) {
+                    return;
+                }
+                QMetaObject::invokeMethod(
+                    self,
+                    [self]() {
+                        if (!self) {
+                            return;
+                        }
+                        self->m_busy = false;
+                        emit self->importFinished(
+                            false, 0, 0, tr("Not a review file"));
+                    },
+                    Qt::QueuedConnection);
+                return;
+            }
+
+            QList<Bookmark> bookmarkBatch;
+            QList<PDFAnnotation> annotationBatch;
+            int malformedLines = 0;
+
+            auto flushBatch = [&]() {
+                if (bookmarkBatch.isEmpty() && annotationBatch.isEmpty()) {
+                    return;
+                }
+                const qint64 processed = file.pos();
+                QList<Bookmark> bookmarks;
+                QList<PDFAnnotation> annotations;
+                bookmarks.swap(bookmarkBatch);
+                annotations.swap(annotationBatch);
+                if (!self) {
+                    return;
+                }
+                QMetaObject::invokeMethod(
+                    self,
+                    [self, bookmarks, annotations, processed, totalBytes]() {
+                        if (!self) {
+                            return;
+                        }
+                        self->deliverBatch(bookmarks, annotations);
+                        emit self->progressChanged(processed, totalBytes);
+                    },
+                    Qt::QueuedConnection);
+            };
+
+            // One line, one record: memory stays bounded by the batch no
+            // matter how large the file is
+            while (!file.atEnd()) {
+                const QByteArray line = file.readLine();
+                if (line.trimmed().isEmpty()) {
+                    continue;
+                }
+                QJsonObject record = QJsonDocument::fromJson(line).object();
+                const QString kind = record["record"].toString();
+                if (kind == QLatin1String("bookmark")) {
+                    bookmarkBatch.append(
+                        Bookmark::fromJson(record["data"].toObject()));
+                } else if (kind == QLatin1String("annotation")) {
+                    annotationBatch.append(
+                        PDFAnnotation::fromJson(record["data"].toObject()));
+                } else {
+                    ++malformedLines;
+                    continue;
+                }
+                if (bookmarkBatch.size() + annotationBatch.size() >=
+                    IMPORT_BATCH_SIZE) {
+                    flushBatch();
+                }
+            }
+            flushBatch();
+
+            // Queued after every batch, so the counters are final when
+            // this lands on the GUI thread
+            if (!self) {
+                return;
+            }
+            QMetaObject::invokeMethod(
+                self,
+                [self, malformedLines]() {
+                    if (!self) {
+                        return;
+                    }
+                    self->m_busy = false;
+                    if (malformedLines > 0) {
+                        LOG_WARNING(
+                            "ReviewFileStreamer: skipped {} unrecognized "
+                            "lines",
+                            malformedLines);
+                    }
+                    emit self->importFinished(true, self->m_importedBookmarks,
+                                              self->m_importedAnnotations,
+                                              QString());
+                },
+                Qt::QueuedConnection);
+        });
+    return true;
+}
+
+bool ReviewFileStreamer::exportFile(const QString& filePath) {
+    if (m_busy) {
+        return false;
+    }
+    m_busy = true;
+
+    // Snapshot on the GUI thread; the lists are implicitly shared so
+    // this copies two headers, not the records
+    const QList<Bookmark> bookmarks =
+        m_bookmarkModel ? m_bookmarkModel->getAllBookmarks()
+                        : QList<Bookmark>();
+    const QList<PDFAnnotation> annotations =
+        m_annotationModel ? m_annotationModel->getAllAnnotations()
+                          : QList<PDFAnnotation>();
+
+    QPointer<ReviewFileStreamer> self(this);
+    RenderScheduler::instance().submit(
+        RenderScheduler::TaskClass::Background,
+        [self, filePath, bookmarks, annotations]() {
+            const qint64 total = bookmarks.size() + annotations.size();
+            qint64 written = 0;
+            bool ok = false;
+
+            QSaveFile file(filePath);
+            if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+                QJsonObject header;
+                header["kind"] = HEADER_KIND;
+                header["version"] = FORMAT_VERSION;
+                file.write(
+                    QJsonDocument(header).toJson(QJsonDocument::Compact));
+                file.write("\n");
+
+                auto writeRecord = [&](const char* kind,
+                                       const QJsonObject& data) {
+                    QJsonObject record;
+                    record["record"] = kind;
+                    record["data"] = data;
+                    file.write(
+                        QJsonDocument(record).toJson(QJsonDocument::Compact));
+                    file.write("\n");
+                    if (++written % EXPORT_PROGRESS_EVERY == 0 && self) {
+                        QMetaObject::invokeMethod(
+                            self,
+                            [self, written, total]() {
+                                if (self) {
+                                    emit self->progressChanged(written,
+                                                               total);
+                                }
+                            },
+                            Qt::QueuedConnection);
+                    }
+                };
+
+                for (const Bookmark& bookmark : bookmarks) {
+                    writeRecord("bookmark", bookmark.toJson());
+                }
+                for (const PDFAnnotation& annotation : annotations) {
+                    writeRecord("annotation", annotation.toJson());
+                }
+                ok = file.commit();
+            }
+
+            if (!self) {
+                return;
+            }
+            QMetaObject::invokeMethod(
+                self,
+                [self, ok, total]() {
+                    if (!self) {
+                        return;
+                    }
+                    self->m_busy = false;
+                    emit self->exportFinished(
+                        ok, static_cast<int>(total),
+                        ok ? QString() : tr("Cannot write file"));
+                },
+                Qt::QueuedConnection);
+        });
+    return true;
+}
+
+void ReviewFileStreamer::deliverBatch(const QList<Bookmark>& bookmarks,
+                                      const QList<PDFAnnotation>& annotations) {
+    if (m_bookmarkModel && !bookmarks.isEmpty()) {
+        m_importedBookmarks += m_bookmarkModel->addBookmarksBatch(bookmarks);
+    }
+    if (m_annotationModel && !annotations.isEmpty()) {
+        m_importedAnnotations +=
+            m_annotationModel->addAnnotationsBatch(annotations);
+    }
+}
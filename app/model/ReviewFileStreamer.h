@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include "AnnotationModel.h"
+#include "BookmarkModel.h"
+
+/**
+ * Streaming import/export of review files (bookmarks + annotations).
+ *
+ * Review exchange used to mean parsing the whole file into one
+ * QJsonDocument before the first model insert — a 5000-annotation
+ * file spikes memory and freezes the UI for the duration. The review
+ * format is line-delimited instead, the same convention as the edit
+ * journals: a header line identifying the file, then one JSON record
+ * per line. Import reads and parses line by line on a pool thread,
+ * never holding more than one batch of records, and hands batches of
+ * a few hundred to the models on the GUI thread through their batched
+ * insert APIs, which emit one coalesced signal per batch. Export
+ * snapshots the (implicitly shared) model lists and writes them out
+ * line by line off the GUI thread. Both directions report progress.
+ */
+class ReviewFileStreamer : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ReviewFileStreamer(QObject* parent = nullptr);
+
+    // Models receiving imported records / supplying exported ones.
+    // Either may be null; records of that kind are then skipped
+    void setModels(BookmarkModel* bookmarks, AnnotationModel* annotations);
+
+    // Asynchronous; at most one operation runs at a time. Returns false
+    // if another operation is still in flight
+    bool importFile(const QString& filePath);
+    bool exportFile(const QString& filePath);
+
+    bool isBusy() const { return m_busy; }
+
+signals:
+    // processed/total are bytes for import, records for export
+    void progressChanged(qint64 processed, qint64 total);
+    void importFinished(bool success, int bookmarksAdded,
+                        int annotationsAdded, const QString& error);
+    void exportFinished(bool success, int recordCount, const QString& error);
+
+private:
+    void deliverBatch(const QList<Bookmark>& bookmarks,
+                      const QList<PDFAnnotation>& annotations);
+
+    QPointer<BookmarkModel> m_bookmarkModel;
+    QPointer<AnnotationModel> m_annotationModel;
+    bool m_busy;
+
+    // Imported bookmarks/annotations actually inserted; updated on the
+    // GUI thread as batches land
+    int m_importedBookmarks;
+    int m_importedAnnotations;
+
+    // Records handed to the models in one GUI-thread hop
+    static constexpr int IMPORT_BATCH_SIZE = 250;
+    // Progress granularity for export
+    static constexpr int EXPORT_PROGRESS_EVERY = 500;
+};
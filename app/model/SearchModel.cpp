@@ -1,63 +1,193 @@
 #include "SearchModel.h"
 #include <QDebug>
-// #include <QtConcurrent> // Not available in this setup
+#include <QMetaMethod>
+#include <QPointer>
+#include <QThread>
+#include "DocumentSnapshot.h"
+#include "DocumentTextIndex.h"
+#include "PageTextLayer.h"
+#include "managers/RenderScheduler.h"
+#include "utils/LatencyMetrics.h"
+#include "utils/SignalThrottle.h"
 #include <QApplication>
 #include <QPointF>
 #include <QRectF>
 #include <QRegularExpression>
 #include <QSize>
 #include <QSizeF>
+#include <QStringView>
 #include <QTransform>
 #include <QtGlobal>
 #include <cmath>
 
+namespace {
+// Context window on either side of a match, in characters
+constexpr int CONTEXT_LENGTH = 50;
+
+// Word-boundary test matching the regex \b semantics for needles whose
+// edges are word characters (the common case for whole-word queries)
+bool isWordChar(QChar c) {
+    return c.isLetterOrNumber() || c == QLatin1Char('_');
+}
+
+bool isWholeWordAt(const QString& text, int start, int length) {
+    if (start > 0 && isWordChar(text.at(start - 1))) {
+        return false;
+    }
+    const int end = start + length;
+    if (end < text.length() && isWordChar(text.at(end))) {
+        return false;
+    }
+    return true;
+}
+}  // namespace
+
+// SearchResultArena implementation
+
+void SearchResultArena::clear() {
+    m_records.clear();
+    m_pageTexts.clear();
+}
+
+void SearchResultArena::setPageText(int pageNumber, const QString& text) {
+    // Implicitly shared: one block per page regardless of match count
+    if (!m_pageTexts.contains(pageNumber)) {
+        m_pageTexts.insert(pageNumber, text);
+    }
+}
+
+bool SearchResultArena::hasPageText(int pageNumber) const {
+    return m_pageTexts.contains(pageNumber);
+}
+
+QString SearchResultArena::pageText(int pageNumber) const {
+    return m_pageTexts.value(pageNumber);
+}
+
+void SearchResultArena::appendMatch(int pageNumber, int matchStart,
+                                    int matchLength, int contextStart,
+                                    int contextLength,
+                                    const QRectF& boundingRect) {
+    Record record;
+    record.pageNumber = pageNumber;
+    record.matchStart = matchStart;
+    record.matchLength = matchLength;
+    record.contextStart = contextStart;
+    record.contextLength = contextLength;
+    record.boundingRect = boundingRect;
+    m_records.append(record);
+}
+
+void SearchResultArena::append(const SearchResultArena& other) {
+    m_records.append(other.m_records);
+    for (auto it = other.m_pageTexts.constBegin();
+         it != other.m_pageTexts.constEnd(); ++it) {
+        setPageText(it.key(), it.value());
+    }
+}
+
+QString SearchResultArena::matchText(int index) const {
+    const Record& r = m_records.at(index);
+    return m_pageTexts.value(r.pageNumber).mid(r.matchStart, r.matchLength);
+}
+
+QString SearchResultArena::contextText(int index) const {
+    const Record& r = m_records.at(index);
+    const QString& pageText = m_pageTexts.value(r.pageNumber);
+
+    QString context = pageText.mid(r.contextStart, r.contextLength);
+    if (r.contextStart > 0) {
+        context = "..." + context;
+    }
+    if (r.contextStart + r.contextLength < pageText.length()) {
+        context = context + "...";
+    }
+    return context.simplified();
+}
+
+SearchResult SearchResultArena::makeResult(int index) const {
+    const Record& r = m_records.at(index);
+    return SearchResult(r.pageNumber, matchText(index), contextText(index),
+                        r.boundingRect, r.matchStart, r.matchLength);
+}
+
+QList<SearchResult> SearchResultArena::toResults(int first, int count) const {
+    if (count < 0) {
+        count = m_records.size() - first;
+    }
+    QList<SearchResult> results;
+    results.reserve(count);
+    for (int i = first; i < first + count && i < m_records.size(); ++i) {
+        results.append(makeResult(i));
+    }
+    return results;
+}
+
 SearchModel::SearchModel(QObject* parent)
     : QAbstractListModel(parent),
+      m_materializedDirty(false),
       m_currentResultIndex(-1),
       m_isSearching(false),
       m_document(nullptr),
-      m_searchWatcher(new QFutureWatcher<QList<SearchResult>>(this)),
+      m_textIndex(new DocumentTextIndex(this)),
       m_realTimeSearchTimer(new QTimer(this)),
       m_isRealTimeSearchEnabled(true),
-      m_realTimeSearchDelay(300) {
-    connect(m_searchWatcher, &QFutureWatcher<QList<SearchResult>>::finished,
-            this, &SearchModel::onSearchFinished);
-
+      m_realTimeSearchDelay(300),
+      m_searchGeneration(0),
+      m_pendingShards(0),
+      m_nextShardToMerge(0),
+      m_completedDocument(nullptr),
+      m_completedTruncated(false) {
     // Setup real-time search timer
     m_realTimeSearchTimer->setSingleShot(true);
     connect(m_realTimeSearchTimer, &QTimer::timeout, this,
             &SearchModel::performRealTimeSearch);
+
+    // Per-page progress and snapshot emissions coalesce here: at most
+    // one delivery per frame interval, latest value wins
+    m_realTimeThrottle = new SignalThrottle(this);
 }
 
 int SearchModel::rowCount(const QModelIndex& parent) const {
     Q_UNUSED(parent)
-    return m_results.size();
+    return m_arena.size();
 }
 
 QVariant SearchModel::data(const QModelIndex& index, int role) const {
-    if (!index.isValid() || index.row() >= m_results.size()) {
+    if (!index.isValid() || index.row() >= m_arena.size()) {
         return QVariant();
     }
 
-    const SearchResult& result = m_results.at(index.row());
+    // Strings are materialized from the arena per request, so only rows
+    // the view actually asks for pay the allocation
+    const int row = index.row();
+    const SearchResultArena::Record& record = m_arena.record(row);
 
     switch (role) {
         case Qt::DisplayRole:
+            // Multi-document results carry their owning tab's label so
+            // the flat list still reads grouped by document
+            if (isMultiDocumentSearch()) {
+                return QString("%1 · Page %2: %3")
+                    .arg(documentLabelForRow(row))
+                    .arg(localPageNumber(record.pageNumber) + 1)
+                    .arg(m_arena.contextText(row));
+            }
             return QString("Page %1: %2")
-                .arg(result.pageNumber + 1)
-                .arg(result.context);
+                .arg(record.pageNumber + 1)
+                .arg(m_arena.contextText(row));
         case PageNumberRole:
-            return result.pageNumber;
+            return record.pageNumber;
         case TextRole:
-            return result.text;
+            return m_arena.matchText(row);
         case ContextRole:
-            return result.context;
+            return m_arena.contextText(row);
         case BoundingRectRole:
-            return result.boundingRect;
+            return record.boundingRect;
         case StartIndexRole:
-            return result.startIndex;
+            return record.matchStart;
         case LengthRole:
-            return result.length;
+            return record.matchLength;
         default:
             return QVariant();
     }
@@ -86,6 +216,11 @@ void SearchModel::startSearch(Poppler::Document* document, const QString& query,
         return;
     }
 
+    if (document != m_document) {
+        // New document: kick off the incremental background extraction
+        m_textIndex->buildIndex(document);
+    }
+
     m_document = document;
     m_currentQuery = query;
     m_currentOptions = options;
@@ -95,9 +230,9 @@ void SearchModel::startSearch(Poppler::Document* document, const QString& query,
     clearResults();
     emit searchStarted();
 
-    // Start search (synchronous for now)
-    performSearch();
-    emit searchFinished(m_searchResults.size());
+    // Shard the page range across the shared pool; searchFinished fires
+    // once the last shard has merged
+    performParallelSearch();
 }
 
 void SearchModel::startRealTimeSearch(Poppler::Document* document,
@@ -119,31 +254,284 @@ void SearchModel::startRealTimeSearch(Poppler::Document* document,
     m_realTimeSearchTimer->start(m_realTimeSearchDelay);
 }
 
+void SearchModel::startMultiDocumentSearch(const QList<OpenDocument>& documents,
+                                           Poppler::Document* currentDocument,
+                                           const QString& query,
+                                           const SearchOptions& options) {
+    if (m_isSearching) {
+        cancelSearch();
+    }
+
+    if (query.isEmpty()) {
+        emit searchError("Invalid document or empty query");
+        return;
+    }
+
+    clearResults();
+
+    // Build the global page space, skipping entries that cannot be
+    // searched; the caller-assigned ids keep navigation targets stable
+    // regardless of what was skipped
+    m_multiDocPageOffsets.append(0);
+    for (const OpenDocument& open : documents) {
+        if (!open.document || open.document->numPages() <= 0) {
+            continue;
+        }
+        m_multiDocs.append(open);
+        m_multiDocPageOffsets.append(m_multiDocPageOffsets.last() +
+                                     open.document->numPages());
+    }
+
+    const int totalPages = m_multiDocPageOffsets.last();
+    if (totalPages <= 0) {
+        m_multiDocs.clear();
+        m_multiDocPageOffsets.clear();
+        emit searchError("Invalid document or empty query");
+        return;
+    }
+
+    // currentDocument anchors the page-space translation: page widgets
+    // keep asking about the visible tab's local pages
+    m_document = currentDocument;
+    m_currentQuery = query;
+    m_currentOptions = options;
+    m_isSearching = true;
+    m_currentResultIndex = -1;
+    emit searchStarted();
+
+    m_searchGeneration++;
+    const quint64 generation = m_searchGeneration;
+
+    const int shardTarget =
+        qBound(1, RenderScheduler::instance().maxThreadCount(), totalPages);
+    const int pagesPerShard = (totalPages + shardTarget - 1) / shardTarget;
+
+    m_pendingShards = 0;
+    m_nextShardToMerge = 0;
+    m_completedShards.clear();
+
+    QPointer<SearchModel> self(this);
+    const CompiledQuery compiled = compileQuery(query, options);
+
+    // Shards are cut from the concatenated page space but never span a
+    // document boundary, so each worker only holds handles into one
+    // file. Shard indices increase in (document, page) order, which is
+    // exactly the invariant the ordered merge in onShardCompleted needs
+    int shardIndex = 0;
+    for (int slot = 0; slot < m_multiDocs.size(); ++slot) {
+        Poppler::Document* document = m_multiDocs.at(slot).document;
+        DocumentTextIndex* textIndex = m_multiDocs.at(slot).textIndex;
+        const int base = m_multiDocPageOffsets.at(slot);
+        const int pageCount = m_multiDocPageOffsets.at(slot + 1) - base;
+        const std::shared_ptr<DocumentSnapshot> snapshot =
+            DocumentSnapshot::forDocument(document);
+
+        for (int fromPage = 0; fromPage < pageCount;
+             fromPage += pagesPerShard, ++shardIndex) {
+            const int toPage = qMin(fromPage + pagesPerShard, pageCount) - 1;
+            const int shard = shardIndex;
+            m_pendingShards++;
+
+            RenderScheduler::instance().submit(
+                RenderScheduler::TaskClass::AdjacentPrerender,
+                [self, document, snapshot, textIndex, shard, base, fromPage,
+                 toPage, compiled, options, generation]() {
+                    if (!self || self->m_searchGeneration != generation) {
+                        return;
+                    }
+
+                    LATENCY_SAMPLE("search.multiDocShard");
+
+                    SearchResultArena shardArena;
+                    for (int i = fromPage; i <= toPage; ++i) {
+                        if (!self || self->m_searchGeneration != generation) {
+                            return;
+                        }
+                        // Each document's own background-built index
+                        // serves its shards, so no tab re-extracts text
+                        // another tab already has
+                        if (snapshot) {
+                            if (auto lease = snapshot->leasePage(i)) {
+                                self->searchInPageOffset(lease.get(), i,
+                                                         base + i, textIndex,
+                                                         compiled, options,
+                                                         shardArena);
+                                continue;
+                            }
+                        }
+                        std::unique_ptr<Poppler::Page> page(document->page(i));
+                        if (page) {
+                            self->searchInPageOffset(page.get(), i, base + i,
+                                                     textIndex, compiled,
+                                                     options, shardArena);
+                        }
+                    }
+
+                    QMetaObject::invokeMethod(
+                        self,
+                        [self, shard, generation, shardArena]() {
+                            if (self) {
+                                self->onShardCompleted(shard, generation,
+                                                       shardArena);
+                            }
+                        },
+                        Qt::QueuedConnection);
+                });
+        }
+    }
+}
+
 void SearchModel::clearResults() {
     beginResetModel();
-    m_results.clear();
+    m_arena.clear();
+    m_pageRecordIndex.clear();
+    m_materializedResults.clear();
+    m_materializedDirty = false;
+    m_snapshot.reset();
     m_currentResultIndex = -1;
+    m_completedQuery.clear();
+    m_completedDocument = nullptr;
+    m_multiDocs.clear();
+    m_multiDocPageOffsets.clear();
     endResetModel();
     emit resultsCleared();
 }
 
 void SearchModel::cancelSearch() {
-    if (m_isSearching && !m_searchFuture.isFinished()) {
-        m_searchFuture.cancel();
+    if (m_isSearching) {
+        // Invalidate in-flight shards; they check the generation before
+        // touching the document and again before merging
+        m_searchGeneration++;
+        m_pendingShards = 0;
+        m_completedShards.clear();
         m_isSearching = false;
+        // A cancelled search leaves a partial arena behind; it must not
+        // seed an incremental refinement
+        m_completedQuery.clear();
+        m_completedDocument = nullptr;
         emit searchCancelled();
     }
 }
 
+const QList<SearchResult>& SearchModel::getResults() const {
+    if (m_materializedDirty) {
+        m_materializedResults = m_arena.toResults();
+        m_materializedDirty = false;
+    }
+    return m_materializedResults;
+}
+
+std::shared_ptr<const SearchResultSnapshot> SearchModel::resultSnapshot()
+    const {
+    if (!m_snapshot) {
+        // getResults() refreshes the materialized list if needed; the
+        // snapshot shares it (implicit sharing) so construction costs a
+        // page-index copy, not a result copy
+        QHash<int, QVector<int>> pageRows = m_pageRecordIndex;
+        if (isMultiDocumentSearch()) {
+            // Page widgets key by the visible tab's local page numbers;
+            // re-key that document's slice of the global page space and
+            // drop the rest — other tabs' widgets are not on screen
+            pageRows.clear();
+            const int slot = slotForDocument(m_document);
+            if (slot >= 0) {
+                const int base = m_multiDocPageOffsets.at(slot);
+                const int end = m_multiDocPageOffsets.at(slot + 1);
+                for (auto it = m_pageRecordIndex.constBegin();
+                     it != m_pageRecordIndex.constEnd(); ++it) {
+                    if (it.key() >= base && it.key() < end) {
+                        pageRows.insert(it.key() - base, it.value());
+                    }
+                }
+            }
+        }
+        m_snapshot = std::make_shared<const SearchResultSnapshot>(
+            getResults(), std::move(pageRows));
+    }
+    return m_snapshot;
+}
+
 SearchResult SearchModel::getResult(int index) const {
-    if (index >= 0 && index < m_results.size()) {
-        return m_results.at(index);
+    if (index >= 0 && index < m_arena.size()) {
+        return m_arena.makeResult(index);
     }
     return SearchResult();
 }
 
+QList<SearchResult> SearchModel::resultsForPage(int pageNumber) const {
+    QList<SearchResult> results;
+    auto it = m_pageRecordIndex.constFind(globalPageFor(pageNumber));
+    if (it == m_pageRecordIndex.constEnd()) {
+        return results;
+    }
+    results.reserve(it->size());
+    for (int row : *it) {
+        SearchResult result = m_arena.makeResult(row);
+        result.isCurrentResult = (row == m_currentResultIndex);
+        results.append(result);
+    }
+    return results;
+}
+
+bool SearchModel::hasResultsOnPage(int pageNumber) const {
+    return m_pageRecordIndex.contains(globalPageFor(pageNumber));
+}
+
+// Page-scoped callers (highlight paths) always mean the current tab's
+// local pages; in multi-document mode the arena keys by global page, so
+// the query shifts by that document's offset. Identity otherwise
+int SearchModel::globalPageFor(int localPage) const {
+    const int slot = slotForDocument(m_document);
+    return slot >= 0 ? m_multiDocPageOffsets.at(slot) + localPage : localPage;
+}
+
+int SearchModel::slotForDocument(const Poppler::Document* document) const {
+    for (int slot = 0; slot < m_multiDocs.size(); ++slot) {
+        if (m_multiDocs.at(slot).document == document) {
+            return slot;
+        }
+    }
+    return -1;
+}
+
+// Offsets are ascending and small (one entry per open tab), so a linear
+// scan beats a binary search here
+int SearchModel::documentSlotForPage(int globalPage) const {
+    for (int slot = 0; slot < m_multiDocs.size(); ++slot) {
+        if (globalPage < m_multiDocPageOffsets.at(slot + 1)) {
+            return slot;
+        }
+    }
+    return -1;
+}
+
+int SearchModel::documentIdForRow(int row) const {
+    if (row < 0 || row >= m_arena.size()) {
+        return -1;
+    }
+    const int slot = documentSlotForPage(m_arena.record(row).pageNumber);
+    return slot >= 0 ? m_multiDocs.at(slot).id : -1;
+}
+
+QString SearchModel::documentLabelForRow(int row) const {
+    if (row < 0 || row >= m_arena.size()) {
+        return QString();
+    }
+    const int slot = documentSlotForPage(m_arena.record(row).pageNumber);
+    return slot >= 0 ? m_multiDocs.at(slot).label : QString();
+}
+
+int SearchModel::localPageNumber(int globalPage) const {
+    const int slot = documentSlotForPage(globalPage);
+    return slot >= 0 ? globalPage - m_multiDocPageOffsets.at(slot) : globalPage;
+}
+
+QList<int> SearchModel::pagesWithResults() const {
+    return m_pageRecordIndex.keys();
+}
+
 void SearchModel::setCurrentResultIndex(int index) {
-    if (index >= -1 && index < m_results.size() &&
+    if (index >= -1 && index < m_arena.size() &&
         index != m_currentResultIndex) {
         m_currentResultIndex = index;
         emit currentResultChanged(index);
@@ -151,7 +539,7 @@ void SearchModel::setCurrentResultIndex(int index) {
 }
 
 bool SearchModel::hasNext() const {
-    return m_currentResultIndex < m_results.size() - 1;
+    return m_currentResultIndex < m_arena.size() - 1;
 }
 
 bool SearchModel::hasPrevious() const { return m_currentResultIndex > 0; }
@@ -159,7 +547,7 @@ bool SearchModel::hasPrevious() const { return m_currentResultIndex > 0; }
 SearchResult SearchModel::nextResult() {
     if (hasNext()) {
         setCurrentResultIndex(m_currentResultIndex + 1);
-        return m_results.at(m_currentResultIndex);
+        return m_arena.makeResult(m_currentResultIndex);
     }
     return SearchResult();
 }
@@ -167,125 +555,304 @@ SearchResult SearchModel::nextResult() {
 SearchResult SearchModel::previousResult() {
     if (hasPrevious()) {
         setCurrentResultIndex(m_currentResultIndex - 1);
-        return m_results.at(m_currentResultIndex);
+        return m_arena.makeResult(m_currentResultIndex);
     }
     return SearchResult();
 }
 
-void SearchModel::onSearchFinished() {
-    if (m_searchFuture.isCanceled()) {
-        m_isSearching = false;
-        emit searchCancelled();
-        return;
+QList<int> SearchModel::adjacentResultPages(int window) const {
+    QList<int> pages;
+    if (m_currentResultIndex < 0 || m_arena.isEmpty() || window <= 0) {
+        return pages;
     }
 
-    try {
-        QList<SearchResult> results = m_searchFuture.result();
-
-        beginResetModel();
-        m_results = results;
-        endResetModel();
+    const int currentPage = m_arena.record(m_currentResultIndex).pageNumber;
 
-        if (!m_results.isEmpty()) {
-            setCurrentResultIndex(0);
+    // Interleave forward and backward so the most likely next step (the
+    // immediate neighbours) comes first in prerender priority order
+    for (int step = 1; step <= window; ++step) {
+        const int forward = m_currentResultIndex + step;
+        if (forward < m_arena.size()) {
+            const int page = m_arena.record(forward).pageNumber;
+            if (page != currentPage && !pages.contains(page)) {
+                pages.append(page);
+            }
+        }
+        const int backward = m_currentResultIndex - step;
+        if (backward >= 0) {
+            const int page = m_arena.record(backward).pageNumber;
+            if (page != currentPage && !pages.contains(page)) {
+                pages.append(page);
+            }
         }
-
-        m_isSearching = false;
-        emit searchFinished(m_results.size());
-
-    } catch (const std::exception& e) {
-        m_isSearching = false;
-        emit searchError(QString("Search failed: %1").arg(e.what()));
     }
+    return pages;
 }
 
-void SearchModel::performSearch() {
-    QList<SearchResult> allResults;
-
+void SearchModel::performParallelSearch() {
     if (!m_document) {
+        m_isSearching = false;
         return;
     }
 
     const int pageCount = m_document->numPages();
+    if (pageCount <= 0) {
+        m_isSearching = false;
+        emit searchFinished(0);
+        return;
+    }
 
-    for (int i = 0; i < pageCount && !m_searchFuture.isCanceled(); ++i) {
-        std::unique_ptr<Poppler::Page> page(m_document->page(i));
-        if (page) {
-            QList<SearchResult> pageResults =
-                searchInPage(page.get(), i, m_currentQuery, m_currentOptions);
-            allResults.append(pageResults);
+    m_searchGeneration++;
+    const quint64 generation = m_searchGeneration;
+
+    // Contiguous shards, one per pool thread, so each worker walks its
+    // own page range with its own Poppler::Page handles
+    const int shardCount =
+        qBound(1, RenderScheduler::instance().maxThreadCount(), pageCount);
+    const int pagesPerShard = (pageCount + shardCount - 1) / shardCount;
+
+    m_pendingShards = 0;
+    m_nextShardToMerge = 0;
+    m_completedShards.clear();
+
+    QPointer<SearchModel> self(this);
+    Poppler::Document* document = m_document;
+    const SearchOptions options = m_currentOptions;
+
+    // With a registered snapshot each shard opens a private handle on
+    // its own thread and page access needs no cross-shard lock; without
+    // one the shards share the primary handle as before
+    const std::shared_ptr<DocumentSnapshot> snapshot =
+        DocumentSnapshot::forDocument(document);
+
+    // Compile the query once; shards share the compiled form (the regex
+    // is implicitly shared and safe for concurrent const matching)
+    const CompiledQuery compiled = compileQuery(m_currentQuery, options);
+
+    for (int shard = 0; shard * pagesPerShard < pageCount; ++shard) {
+        const int fromPage = shard * pagesPerShard;
+        const int toPage = qMin(fromPage + pagesPerShard, pageCount) - 1;
+        m_pendingShards++;
+
+        RenderScheduler::instance().submit(
+            RenderScheduler::TaskClass::AdjacentPrerender,
+            [self, document, snapshot, shard, fromPage, toPage, compiled,
+             options, generation]() {
+                if (!self || self->m_searchGeneration != generation) {
+                    return;
+                }
+
+                LATENCY_SAMPLE("search.shard");
+
+                SearchResultArena shardArena;
+                for (int i = fromPage; i <= toPage; ++i) {
+                    if (!self || self->m_searchGeneration != generation) {
+                        return;
+                    }
+                    // Pooled lease: repeated searches reuse this thread's
+                    // page objects instead of rebuilding one per query
+                    if (snapshot) {
+                        if (auto lease = snapshot->leasePage(i)) {
+                            self->searchInPage(lease.get(), i, compiled,
+                                               options, shardArena);
+                            continue;
+                        }
+                    }
+                    std::unique_ptr<Poppler::Page> page(document->page(i));
+                    if (page) {
+                        self->searchInPage(page.get(), i, compiled, options,
+                                           shardArena);
+                    }
+                }
+
+                QMetaObject::invokeMethod(
+                    self,
+                    [self, shard, generation, shardArena]() {
+                        if (self) {
+                            self->onShardCompleted(shard, generation,
+                                                   shardArena);
+                        }
+                    },
+                    Qt::QueuedConnection);
+            });
+    }
+}
 
-            if (allResults.size() >= m_currentOptions.maxResults) {
-                break;
+void SearchModel::onShardCompleted(int shardIndex, quint64 generation,
+                                   const SearchResultArena& shardArena) {
+    if (generation != m_searchGeneration) {
+        return;  // Cancelled or superseded search
+    }
+
+    m_completedShards[shardIndex] = shardArena;
+    m_pendingShards--;
+
+    // Merge completed shards strictly in page order so partial results
+    // never arrive out of sequence
+    static const QMetaMethod partialSignal =
+        QMetaMethod::fromSignal(&SearchModel::partialResultsReady);
+    while (m_completedShards.contains(m_nextShardToMerge)) {
+        const SearchResultArena merged =
+            m_completedShards.take(m_nextShardToMerge);
+
+        if (!merged.isEmpty() && m_arena.size() < m_currentOptions.maxResults) {
+            int first = m_arena.size();
+            beginInsertRows(QModelIndex(), first, first + merged.size() - 1);
+            m_arena.append(merged);
+            for (int row = first; row < m_arena.size(); ++row) {
+                m_pageRecordIndex[m_arena.record(row).pageNumber].append(row);
+            }
+            m_materializedDirty = true;
+            m_snapshot.reset();
+            endInsertRows();
+
+            // Materializing a shard's QStrings is only worth it if a
+            // listener actually wants them
+            if (isSignalConnected(partialSignal)) {
+                emit partialResultsReady(merged.toResults(),
+                                         merged.record(0).pageNumber,
+                                         merged.record(merged.size() - 1)
+                                             .pageNumber);
             }
         }
+        m_nextShardToMerge++;
     }
 
-    // Update the model with results
-    beginResetModel();
-    m_searchResults = allResults;
-    endResetModel();
+    if (m_pendingShards == 0) {
+        if (!m_arena.isEmpty() && m_currentResultIndex < 0) {
+            setCurrentResultIndex(0);
+        }
+        m_isSearching = false;
+        recordCompletedSearch(m_arena.size() >= m_currentOptions.maxResults);
+        emit searchFinished(m_arena.size());
+    }
 }
 
-QList<SearchResult> SearchModel::searchInPage(Poppler::Page* page,
-                                              int pageNumber,
-                                              const QString& query,
-                                              const SearchOptions& options) {
-    QList<SearchResult> results;
+int SearchModel::searchInPage(Poppler::Page* page, int pageNumber,
+                              const CompiledQuery& compiled,
+                              const SearchOptions& options,
+                              SearchResultArena& arena) {
+    return searchInPageOffset(page, pageNumber, pageNumber, m_textIndex,
+                              compiled, options, arena);
+}
 
+int SearchModel::searchInPageOffset(Poppler::Page* page, int localPage,
+                                    int globalPage,
+                                    DocumentTextIndex* textIndex,
+                                    const CompiledQuery& compiled,
+                                    const SearchOptions& options,
+                                    SearchResultArena& arena) {
     if (!page) {
-        return results;
+        return 0;
     }
 
-    QString pageText = page->text(QRectF());
+    // Prefer the background-built index; fall back to direct extraction
+    // for pages the index has not reached yet, and feed the result back
+    // so the next query gets the fast path
+    QString pageText;
+    std::shared_ptr<PageTextLayer> textLayer;
+    if (textIndex && textIndex->isPageIndexed(localPage)) {
+        pageText = textIndex->pageText(localPage);
+        textLayer = textIndex->textLayer(localPage);
+    } else {
+        // Raw order matches what the index builder extracts, so the
+        // stored text is byte-identical to a background-indexed page
+        pageText = page->text(QRectF(), Poppler::Page::RawOrderLayout);
+        if (textIndex) {
+            textIndex->storePageText(localPage, pageText);
+        }
+    }
     if (pageText.isEmpty()) {
-        return results;
+        return 0;
     }
 
-    QRegularExpression regex = createSearchRegex(query, options);
-    QRegularExpressionMatchIterator iterator = regex.globalMatch(pageText);
-
-    while (iterator.hasNext() && results.size() < options.maxResults) {
-        QRegularExpressionMatch match = iterator.next();
-        int startPos = match.capturedStart();
-        int length = match.capturedLength();
-        QString matchedText = match.captured();
-
-        // Extract context around the match
-        QString context = extractContext(pageText, startPos, length);
-
-        // Get bounding rectangle for the matched text
-        QList<QRectF> rects = page->search(matchedText);
+    // The page text goes into the arena once; each match below is a POD
+    // record of offsets into it
+    arena.setPageText(globalPage, pageText);
+
+    // Collect match offsets with the strategy the compiler picked. The
+    // literal path is QString's optimized substring scan; the regex
+    // pattern was compiled once for the whole search
+    struct Span {
+        int start;
+        int length;
+    };
+    QVector<Span> matches;
+    if (compiled.strategy == CompiledQuery::Strategy::Regex) {
+        QRegularExpressionMatchIterator iterator =
+            compiled.regex.globalMatch(pageText);
+        while (iterator.hasNext() && matches.size() < options.maxResults) {
+            QRegularExpressionMatch match = iterator.next();
+            matches.append({static_cast<int>(match.capturedStart()),
+                            static_cast<int>(match.capturedLength())});
+        }
+    } else {
+        const int needleLength = compiled.needle.length();
+        int from = 0;
+        while (matches.size() < options.maxResults) {
+            const int startPos =
+                pageText.indexOf(compiled.needle, from, compiled.caseSensitivity);
+            if (startPos < 0) {
+                break;
+            }
+            from = startPos + 1;
+            if (compiled.strategy == CompiledQuery::Strategy::LiteralWholeWord &&
+                !isWholeWordAt(pageText, startPos, needleLength)) {
+                continue;
+            }
+            matches.append({startPos, needleLength});
+        }
+    }
 
+    for (const Span& span : matches) {
+        // Context window around the match, as offsets
+        int contextStart = qMax(0, span.start - CONTEXT_LENGTH);
+        int contextEnd =
+            qMin(pageText.length(), span.start + span.length + CONTEXT_LENGTH);
+
+        // Bounding rectangle for the matched text. The text layer maps
+        // the match offset to its word boxes in O(log n) and points at
+        // the right occurrence; Poppler's whole-page search is only
+        // needed when the layer is not built yet, and always returned
+        // the first occurrence's box for repeated words
         QRectF boundingRect;
-        if (!rects.isEmpty()) {
-            boundingRect = rects.first();
+        if (textLayer) {
+            boundingRect =
+                textLayer->boundingBoxForRange(span.start, span.length);
+        } else {
+            QList<QRectF> rects =
+                page->search(pageText.mid(span.start, span.length));
+            if (!rects.isEmpty()) {
+                boundingRect = rects.first();
+            }
         }
 
-        SearchResult result(pageNumber, matchedText, context, boundingRect,
-                            startPos, length);
-        results.append(result);
+        arena.appendMatch(globalPage, span.start, span.length, contextStart,
+                          contextEnd - contextStart, boundingRect);
     }
 
-    return results;
+    return matches.size();
 }
 
-QString SearchModel::extractContext(const QString& pageText, int position,
-                                    int length, int contextLength) {
-    int start = qMax(0, position - contextLength);
-    int end = qMin(pageText.length(), position + length + contextLength);
-
-    QString context = pageText.mid(start, end - start);
-
-    // Add ellipsis if we truncated
-    if (start > 0) {
-        context = "..." + context;
-    }
-    if (end < pageText.length()) {
-        context = context + "...";
+SearchModel::CompiledQuery SearchModel::compileQuery(
+    const QString& query, const SearchOptions& options) {
+    CompiledQuery compiled;
+    if (options.useRegex) {
+        compiled.strategy = CompiledQuery::Strategy::Regex;
+        compiled.regex = createSearchRegex(query, options);
+        m_lastSearchStrategy = QStringLiteral("regex");
+    } else {
+        compiled.strategy = options.wholeWords
+                                ? CompiledQuery::Strategy::LiteralWholeWord
+                                : CompiledQuery::Strategy::Literal;
+        compiled.needle = query;
+        compiled.caseSensitivity =
+            options.caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
+        m_lastSearchStrategy = options.wholeWords
+                                   ? QStringLiteral("literal-whole-word")
+                                   : QStringLiteral("literal");
     }
-
-    return context.simplified();  // Remove extra whitespace
+    return compiled;
 }
 
 QRegularExpression SearchModel::createSearchRegex(
@@ -309,44 +876,170 @@ QRegularExpression SearchModel::createSearchRegex(
     return QRegularExpression(pattern, regexOptions);
 }
 
+void SearchModel::recordCompletedSearch(bool truncated) {
+    // Multi-document result sets must never seed the single-document
+    // incremental refine: their arena spans the global page space
+    if (isMultiDocumentSearch()) {
+        m_completedQuery.clear();
+        m_completedDocument = nullptr;
+        return;
+    }
+    m_completedQuery = m_currentQuery;
+    m_completedOptions = m_currentOptions;
+    m_completedDocument = m_document;
+    m_completedTruncated = truncated;
+}
+
+// Extending a plain literal query can only narrow the previous hit set:
+// every occurrence of "perform" starts with an occurrence of "perfor",
+// so re-verifying the cached hits replaces the document rescan.
+// Whole-word queries are excluded — the old needle's trailing word
+// boundary rejected exactly the positions the extended needle needs.
+// Regex queries are excluded because a longer pattern can match text
+// the shorter one did not.
+bool SearchModel::tryIncrementalRefine(const CompiledQuery& compiled) {
+    if (compiled.strategy != CompiledQuery::Strategy::Literal) {
+        return false;
+    }
+    if (m_completedDocument != m_document || m_completedQuery.isEmpty() ||
+        m_completedTruncated) {
+        return false;
+    }
+    if (m_completedOptions.caseSensitive != m_currentOptions.caseSensitive ||
+        m_completedOptions.wholeWords || m_completedOptions.useRegex) {
+        return false;
+    }
+    if (m_currentQuery.length() <= m_completedQuery.length() ||
+        !m_currentQuery.startsWith(m_completedQuery,
+                                   compiled.caseSensitivity)) {
+        return false;
+    }
+
+    emit realTimeSearchStarted();
+    LATENCY_SAMPLE("search.incrementalRefine");
+
+    const QString& needle = compiled.needle;
+    const int length = needle.length();
+
+    SearchResultArena refined;
+    for (int row = 0; row < m_arena.size(); ++row) {
+        const SearchResultArena::Record& record = m_arena.record(row);
+        const QString pageText = m_arena.pageText(record.pageNumber);
+        if (record.matchStart + length > pageText.length()) {
+            continue;
+        }
+        if (QStringView(pageText)
+                .mid(record.matchStart, length)
+                .compare(needle, compiled.caseSensitivity) != 0) {
+            continue;
+        }
+
+        refined.setPageText(record.pageNumber, pageText);
+        const int contextStart = qMax(0, record.matchStart - CONTEXT_LENGTH);
+        const int contextEnd = qMin(
+            pageText.length(), record.matchStart + length + CONTEXT_LENGTH);
+
+        // The cached rect only covers the old prefix; the text layer
+        // recomputes the box for the longer span when available
+        QRectF boundingRect = record.boundingRect;
+        if (auto textLayer = m_textIndex->textLayer(record.pageNumber)) {
+            boundingRect =
+                textLayer->boundingBoxForRange(record.matchStart, length);
+        }
+
+        refined.appendMatch(record.pageNumber, record.matchStart, length,
+                            contextStart, contextEnd - contextStart,
+                            boundingRect);
+    }
+
+    beginResetModel();
+    m_arena = refined;
+    m_pageRecordIndex.clear();
+    for (int row = 0; row < m_arena.size(); ++row) {
+        m_pageRecordIndex[m_arena.record(row).pageNumber].append(row);
+    }
+    m_materializedResults = m_arena.toResults();
+    m_materializedDirty = false;
+    m_snapshot.reset();
+    m_currentResultIndex = -1;
+    endResetModel();
+
+    emit realTimeResultsUpdated(m_materializedResults);
+    recordCompletedSearch(false);
+    emit searchFinished(m_arena.size());
+    return true;
+}
+
 // Real-time search implementation
 void SearchModel::performRealTimeSearch() {
     if (!m_document || m_currentQuery.isEmpty()) {
         return;
     }
 
+    const CompiledQuery compiled =
+        compileQuery(m_currentQuery, m_currentOptions);
+
+    // Typing one more character after a completed literal search takes
+    // the O(previous hits) refinement path instead of the page walk
+    if (tryIncrementalRefine(compiled)) {
+        return;
+    }
+
+    // A single-document pass supersedes any multi-document result set;
+    // drop the mapping so page numbers read as plain local pages again
+    m_multiDocs.clear();
+    m_multiDocPageOffsets.clear();
+
     emit realTimeSearchStarted();
 
+    SearchResultArena arena;
     QList<SearchResult> allResults;
     const int pageCount = m_document->numPages();
 
     for (int i = 0; i < pageCount; ++i) {
         std::unique_ptr<Poppler::Page> page(m_document->page(i));
         if (page) {
-            QList<SearchResult> pageResults =
-                searchInPage(page.get(), i, m_currentQuery, m_currentOptions);
-            allResults.append(pageResults);
-
-            // Emit progress and partial results for real-time feedback
-            emit realTimeSearchProgress(i + 1, pageCount);
-            if (!allResults.isEmpty()) {
-                emit realTimeResultsUpdated(allResults);
-            }
+            int before = arena.size();
+            searchInPage(page.get(), i, compiled, m_currentOptions, arena);
+            allResults.append(arena.toResults(before, arena.size() - before));
+
+            // Progress and partial results route through the throttle:
+            // the result list is a cumulative snapshot, so dropping
+            // intermediate pages loses nothing, and the GUI stops
+            // repainting once per page on large documents
+            const int progressPage = i + 1;
+            m_realTimeThrottle->post(
+                [this, progressPage, pageCount, allResults]() {
+                    emit realTimeSearchProgress(progressPage, pageCount);
+                    if (!allResults.isEmpty()) {
+                        emit realTimeResultsUpdated(allResults);
+                    }
+                });
 
             // Limit results for performance
-            if (allResults.size() >= m_currentOptions.maxResults) {
+            if (arena.size() >= m_currentOptions.maxResults) {
                 break;
             }
         }
     }
 
+    // The final state must not lose to a dropped intermediate one
+    m_realTimeThrottle->flush();
+
     // Update the model with final results
     beginResetModel();
-    m_searchResults = allResults;
-    m_results = allResults;  // Keep both for compatibility
+    m_arena = arena;
+    m_pageRecordIndex.clear();
+    for (int row = 0; row < m_arena.size(); ++row) {
+        m_pageRecordIndex[m_arena.record(row).pageNumber].append(row);
+    }
+    m_materializedResults = allResults;
+    m_materializedDirty = false;
+    m_snapshot.reset();
     endResetModel();
 
-    emit searchFinished(allResults.size());
+    recordCompletedSearch(arena.size() >= m_currentOptions.maxResults);
+    emit searchFinished(arena.size());
 }
 
 // SearchResult coordinate transformation implementation
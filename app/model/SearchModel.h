@@ -2,13 +2,18 @@
 
 #include <poppler-qt6.h>
 #include <QAbstractListModel>
-#include <QFuture>
-#include <QFutureWatcher>
+#include <QHash>
 #include <QList>
+#include <QMap>
 #include <QObject>
 #include <QRegularExpression>
 #include <QString>
 #include <QTimer>
+#include <QVector>
+#include <memory>
+
+class DocumentTextIndex;
+class SignalThrottle;
 
 /**
  * Represents a single search result with enhanced coordinate transformation
@@ -47,6 +52,80 @@ struct SearchResult {
     }
 };
 
+/**
+ * Contiguous storage for search results. Matches are stored as POD
+ * records whose text and context are offset views into a single shared
+ * text block per page, so a search producing thousands of hits costs a
+ * handful of allocations instead of four QString copies per result.
+ * QString values are only materialized on demand (visible rows,
+ * navigation), keeping long sessions from fragmenting the heap.
+ */
+class SearchResultArena {
+public:
+    struct Record {
+        int pageNumber;
+        int matchStart;  // Offset into the page text block
+        int matchLength;
+        int contextStart;
+        int contextLength;
+        QRectF boundingRect;
+    };
+
+    void clear();
+    void setPageText(int pageNumber, const QString& text);
+    bool hasPageText(int pageNumber) const;
+    QString pageText(int pageNumber) const;
+    void appendMatch(int pageNumber, int matchStart, int matchLength,
+                     int contextStart, int contextLength,
+                     const QRectF& boundingRect);
+    void append(const SearchResultArena& other);
+
+    int size() const { return m_records.size(); }
+    bool isEmpty() const { return m_records.isEmpty(); }
+    const Record& record(int index) const { return m_records.at(index); }
+
+    QString matchText(int index) const;
+    QString contextText(int index) const;
+    SearchResult makeResult(int index) const;
+    QList<SearchResult> toResults(int first = 0, int count = -1) const;
+
+private:
+    QVector<Record> m_records;
+    QHash<int, QString> m_pageTexts;  // One implicitly-shared block per page
+};
+
+/**
+ * Immutable snapshot of one search's results, shared by reference
+ * between the model and every page widget. The result list is
+ * materialized once per search state; widgets keep the shared_ptr plus
+ * their own page's row indices, so highlight memory stays O(results)
+ * instead of O(results x widgets). The current result is deliberately
+ * not part of the snapshot — it travels as a row index, so stepping
+ * through matches never touches (or copies) the shared data.
+ */
+class SearchResultSnapshot {
+public:
+    SearchResultSnapshot() = default;
+    SearchResultSnapshot(QList<SearchResult> results,
+                         QHash<int, QVector<int>> pageRows)
+        : m_results(std::move(results)), m_pageRows(std::move(pageRows)) {}
+
+    int size() const { return m_results.size(); }
+    bool isEmpty() const { return m_results.isEmpty(); }
+    const SearchResult& at(int row) const { return m_results.at(row); }
+    const QList<SearchResult>& results() const { return m_results; }
+    bool hasPage(int pageNumber) const {
+        return m_pageRows.contains(pageNumber);
+    }
+    QVector<int> rowsForPage(int pageNumber) const {
+        return m_pageRows.value(pageNumber);
+    }
+
+private:
+    QList<SearchResult> m_results;        // Implicitly shared, built once
+    QHash<int, QVector<int>> m_pageRows;  // page -> rows into m_results
+};
+
 /**
  * Search options and parameters
  */
@@ -91,12 +170,50 @@ public:
                      const SearchOptions& options = SearchOptions());
     void startRealTimeSearch(Poppler::Document* document, const QString& query,
                              const SearchOptions& options = SearchOptions());
+
+    // Cross-document search: every open tab's pages are concatenated
+    // into one global page space (each document offset by the page
+    // counts before it), so the arena, per-page index and streaming
+    // shard merge run unchanged across documents. The helpers below map
+    // rows and global pages back to (document, local page). id is
+    // caller-defined — the tab's model index — and is what navigation
+    // reports, so skipping unsearchable entries never shifts targets
+    struct OpenDocument {
+        Poppler::Document* document = nullptr;
+        QString label;                           // Shown with grouped results
+        DocumentTextIndex* textIndex = nullptr;  // That tab's cached index
+        int id = -1;
+    };
+    void startMultiDocumentSearch(const QList<OpenDocument>& documents,
+                                  Poppler::Document* currentDocument,
+                                  const QString& query,
+                                  const SearchOptions& options =
+                                      SearchOptions());
+    bool isMultiDocumentSearch() const { return !m_multiDocs.isEmpty(); }
+    int documentIdForRow(int row) const;
+    QString documentLabelForRow(int row) const;
+    int localPageNumber(int globalPage) const;
+
     void clearResults();
     void cancelSearch();
 
-    // Result access
-    const QList<SearchResult>& getResults() const { return m_results; }
+    // Result access. Results live in the arena; getResults() materializes
+    // a QList once per search for legacy callers and caches it
+    const QList<SearchResult>& getResults() const;
     SearchResult getResult(int index) const;
+
+    // Shared immutable view of the current results, rebuilt lazily when
+    // the arena changes. Page widgets hold this by reference instead of
+    // per-widget list copies
+    std::shared_ptr<const SearchResultSnapshot> resultSnapshot() const;
+
+    // Per-page partitioned access into the shared arena. Page widgets
+    // pull just their own page's hits by index instead of receiving a
+    // copy of the full list; isCurrentResult is marked from the model's
+    // current index. Valid while a search is still streaming in
+    QList<SearchResult> resultsForPage(int pageNumber) const;
+    bool hasResultsOnPage(int pageNumber) const;
+    QList<int> pagesWithResults() const;
     int getCurrentResultIndex() const { return m_currentResultIndex; }
     void setCurrentResultIndex(int index);
 
@@ -106,11 +223,26 @@ public:
     SearchResult nextResult();
     SearchResult previousResult();
 
+    // Pages of the results the user is about to step onto: the window
+    // results after and before the current index, nearest first and
+    // deduplicated, current result's own page excluded. The viewer
+    // feeds these to the prerenderer so findNext lands on an
+    // already-rendered page
+    QList<int> adjacentResultPages(int window) const;
+
+    // Text index: extracted once in the background after load; searches
+    // scan the index instead of re-extracting page text per query
+    DocumentTextIndex* textIndex() const { return m_textIndex; }
+
     // Search state
     bool isSearching() const { return m_isSearching; }
     const QString& getCurrentQuery() const { return m_currentQuery; }
     const SearchOptions& getCurrentOptions() const { return m_currentOptions; }
 
+    // Match strategy picked by the query compiler for the last search
+    // ("literal", "literal-whole-word" or "regex"), for the stats readout
+    QString lastSearchStrategy() const { return m_lastSearchStrategy; }
+
 signals:
     void searchStarted();
     void searchFinished(int resultCount);
@@ -124,33 +256,86 @@ signals:
     void realTimeResultsUpdated(const QList<SearchResult>& results);
     void realTimeSearchProgress(int currentPage, int totalPages);
 
-private slots:
-    void onSearchFinished();
+    // Parallel search: emitted as each page shard completes, in page
+    // order, so the results list starts populating immediately
+    void partialResultsReady(const QList<SearchResult>& results, int fromPage,
+                             int toPage);
 
 private:
-    void performSearch();
+    // Query compiled once per search and shared by every page shard.
+    // Literal queries (plain, whole-word, case-insensitive) skip the
+    // regex engine and run QString's optimized substring scan over the
+    // cached text layer; regex queries pay pattern compilation once
+    // instead of once per page
+    struct CompiledQuery {
+        enum class Strategy { Literal, LiteralWholeWord, Regex };
+        Strategy strategy = Strategy::Literal;
+        QString needle;
+        Qt::CaseSensitivity caseSensitivity = Qt::CaseInsensitive;
+        QRegularExpression regex;
+    };
+
+    CompiledQuery compileQuery(const QString& query,
+                               const SearchOptions& options);
+    void performParallelSearch();
+    void onShardCompleted(int shardIndex, quint64 generation,
+                          const SearchResultArena& shardArena);
     void performRealTimeSearch();
-    QList<SearchResult> searchInPage(Poppler::Page* page, int pageNumber,
-                                     const QString& query,
-                                     const SearchOptions& options);
-    QString extractContext(const QString& pageText, int position, int length,
-                           int contextLength = 50);
+    // Search-as-you-type fast path: when the debounced query merely
+    // extends the last completed literal query, re-verify the cached
+    // hit set instead of rescanning the document
+    bool tryIncrementalRefine(const CompiledQuery& compiled);
+    void recordCompletedSearch(bool truncated);
+    int searchInPage(Poppler::Page* page, int pageNumber,
+                     const CompiledQuery& compiled,
+                     const SearchOptions& options, SearchResultArena& arena);
+    // Core of searchInPage: index lookups use the document-local page
+    // and that document's text index, while arena entries use the
+    // global page, so the same scan serves both search modes
+    int searchInPageOffset(Poppler::Page* page, int localPage, int globalPage,
+                           DocumentTextIndex* textIndex,
+                           const CompiledQuery& compiled,
+                           const SearchOptions& options,
+                           SearchResultArena& arena);
+    int documentSlotForPage(int globalPage) const;
+    int slotForDocument(const Poppler::Document* document) const;
+    int globalPageFor(int localPage) const;
     QRegularExpression createSearchRegex(const QString& query,
                                          const SearchOptions& options);
 
-    QList<SearchResult> m_results;
+    SearchResultArena m_arena;
+    QHash<int, QVector<int>> m_pageRecordIndex;  // page -> arena rows
+    mutable QList<SearchResult> m_materializedResults;
+    mutable bool m_materializedDirty;
+    mutable std::shared_ptr<const SearchResultSnapshot> m_snapshot;
     int m_currentResultIndex;
     bool m_isSearching;
     QString m_currentQuery;
     SearchOptions m_currentOptions;
+    QString m_lastSearchStrategy;
     Poppler::Document* m_document;
-    QList<SearchResult> m_searchResults;
+    DocumentTextIndex* m_textIndex;
 
-    QFuture<QList<SearchResult>> m_searchFuture;
-    QFutureWatcher<QList<SearchResult>>* m_searchWatcher;
+    // Multi-document search state; both empty in single-document mode
+    QList<OpenDocument> m_multiDocs;
+    QVector<int> m_multiDocPageOffsets;  // First global page per doc, plus total
+
+    // Parallel search shard bookkeeping
+    quint64 m_searchGeneration;  // Bumped per search; stale shards bail out
+    int m_pendingShards;
+    int m_nextShardToMerge;
+    QMap<int, SearchResultArena> m_completedShards;
 
     // Real-time search members
     QTimer* m_realTimeSearchTimer;
     bool m_isRealTimeSearchEnabled;
     int m_realTimeSearchDelay;
+    SignalThrottle* m_realTimeThrottle;  // Coalesces per-page emissions
+
+    // Last completed search, for the incremental refine fast path.
+    // Truncated result sets (maxResults hit) cannot be narrowed safely
+    QString m_completedQuery;
+    SearchOptions m_completedOptions;
+    Poppler::Document* m_completedDocument;
+    bool m_completedTruncated;
 };
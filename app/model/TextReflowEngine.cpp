@@ -0,0 +1,325 @@
+#include "TextReflowEngine.h"
+#include <QMutexLocker>
+#include <QPointer>
+#include "DocumentTextIndex.h"
+#include "PageTextLayer.h"
+#include "managers/RenderScheduler.h"
+#include "utils/LoggingMacros.h"
+
+TextReflowEngine::TextReflowEngine(QObject* parent)
+    : QObject(parent),
+      m_textIndex(nullptr),
+      m_layoutWidth(0.0),
+      m_fontScale(1.0),
+      m_revision(1),
+      m_backgroundPassQueued(false) {}
+
+void TextReflowEngine::setTextIndex(DocumentTextIndex* textIndex) {
+    if (m_textIndex) {
+        disconnect(m_textIndex, nullptr, this, nullptr);
+    }
+    m_textIndex = textIndex;
+    if (m_textIndex) {
+        connect(m_textIndex, &DocumentTextIndex::pageIndexed, this,
+                &TextReflowEngine::onPageIndexed);
+    }
+    rebuildParagraphs();
+}
+
+void TextReflowEngine::setLayoutWidth(double width) {
+    QMutexLocker locker(&m_mutex);
+    if (qAbs(width - m_layoutWidth) < 0.5) {
+        return;
+    }
+    m_layoutWidth = width;
+    m_revision++;
+    locker.unlock();
+    emit layoutInvalidated();
+}
+
+double TextReflowEngine::layoutWidth() const {
+    QMutexLocker locker(&m_mutex);
+    return m_layoutWidth;
+}
+
+void TextReflowEngine::setFontScale(double scale) {
+    QMutexLocker locker(&m_mutex);
+    if (qAbs(scale - m_fontScale) < 0.001) {
+        return;
+    }
+    m_fontScale = scale;
+    m_revision++;
+    locker.unlock();
+    emit layoutInvalidated();
+}
+
+double TextReflowEngine::fontScale() const {
+    QMutexLocker locker(&m_mutex);
+    return m_fontScale;
+}
+
+int TextReflowEngine::paragraphCount() const {
+    QMutexLocker locker(&m_mutex);
+    return m_paragraphs.size();
+}
+
+void TextReflowEngine::rebuildParagraphs() {
+    {
+        QMutexLocker locker(&m_mutex);
+        m_paragraphs.clear();
+        m_pageParagraphStart.clear();
+        m_revision++;
+    }
+    if (!m_textIndex) {
+        return;
+    }
+    // Pick up pages the index already finished before we were attached;
+    // later pages arrive through pageIndexed
+    onPageIndexed(0);
+}
+
+void TextReflowEngine::onPageIndexed(int pageNumber) {
+    Q_UNUSED(pageNumber)
+    if (!m_textIndex) {
+        return;
+    }
+    // Pages can finish indexing out of order on the pool, but
+    // paragraph indices must stay in reading order: append every ready
+    // page starting from the first unprocessed one, and let later
+    // signals pick up where a gap stopped us
+    int next;
+    {
+        QMutexLocker locker(&m_mutex);
+        next = m_pageParagraphStart.size();
+    }
+    while (m_textIndex->isPageIndexed(next)) {
+        appendParagraphsForPage(next, m_textIndex->textLayer(next));
+        next++;
+    }
+}
+
+void TextReflowEngine::appendParagraphsForPage(
+    int pageNumber, const std::shared_ptr<PageTextLayer>& layer) {
+    QMutexLocker locker(&m_mutex);
+
+    if (pageNumber != m_pageParagraphStart.size()) {
+        return;  // Caller walks pages in order; ignore duplicates
+    }
+    m_pageParagraphStart.append(m_paragraphs.size());
+    if (!layer || layer->wordCount() == 0) {
+        return;  // Image-only page: contributes no reflow content
+    }
+
+    const int wordCount = layer->wordCount();
+    Paragraph current;
+    current.pageNumber = pageNumber;
+    current.firstWord = 0;
+    QRectF previousBox;
+
+    for (int i = 0; i < wordCount; ++i) {
+        const QRectF box = layer->wordBox(i);
+        if (current.wordCount > 0) {
+            const bool newLine =
+                box.top() > previousBox.top() + 0.5 * previousBox.height();
+            const double gap = box.top() - previousBox.bottom();
+            const bool newParagraph =
+                newLine && gap > PARAGRAPH_GAP_FACTOR * box.height();
+            if (newParagraph) {
+                current.emSize /= current.wordCount;
+                m_paragraphs.append(current);
+                current = Paragraph();
+                current.pageNumber = pageNumber;
+                current.firstWord = i;
+            }
+        }
+        current.wordWidths.append(box.width());
+        current.emSize += box.height();  // Averaged at paragraph close
+        current.wordCount++;
+        previousBox = box;
+    }
+    if (current.wordCount > 0) {
+        current.emSize /= current.wordCount;
+        m_paragraphs.append(current);
+    }
+}
+
+void TextReflowEngine::layoutParagraphLocked(Paragraph& paragraph) const {
+    paragraph.lineStarts.clear();
+    paragraph.height = 0.0;
+    paragraph.revision = m_revision;
+
+    if (paragraph.wordCount == 0 || m_layoutWidth <= 0.0) {
+        return;
+    }
+
+    const double em = paragraph.emSize * m_fontScale;
+    const double spaceWidth = em * SPACE_WIDTH_EM;
+    double x = 0.0;
+
+    paragraph.lineStarts.append(0);
+    for (int i = 0; i < paragraph.wordCount; ++i) {
+        // Word widths scale with the font: reflow keeps each word's
+        // natural width relative to its em size
+        const double wordWidth = paragraph.wordWidths[i] * m_fontScale;
+        if (x > 0.0 && x + spaceWidth + wordWidth > m_layoutWidth) {
+            paragraph.lineStarts.append(i);
+            x = wordWidth;
+        } else {
+            x += (x > 0.0 ? spaceWidth : 0.0) + wordWidth;
+        }
+    }
+
+    // Trailing gap of one line height separates paragraphs visually
+    paragraph.height =
+        (paragraph.lineStarts.size() * LINE_SPACING + 1.0) * em;
+}
+
+void TextReflowEngine::ensureLaidOut(int firstParagraph, int lastParagraph) {
+    bool scheduleRest = false;
+    int first = -1;
+    int last = -1;
+    {
+        QMutexLocker locker(&m_mutex);
+        firstParagraph = qMax(0, firstParagraph);
+        lastParagraph = qMin(m_paragraphs.size() - 1, lastParagraph);
+        for (int i = firstParagraph; i <= lastParagraph; ++i) {
+            if (m_paragraphs[i].revision != m_revision) {
+                layoutParagraphLocked(m_paragraphs[i]);
+                first = first < 0 ? i : first;
+                last = i;
+            }
+        }
+        // Anything outside the viewport that is still stale gets the
+        // background pass; one queued pass at a time is enough since it
+        // rescans for staleness itself
+        if (!m_backgroundPassQueued) {
+            for (int i = 0; i < m_paragraphs.size(); ++i) {
+                if (m_paragraphs[i].revision != m_revision) {
+                    scheduleRest = true;
+                    m_backgroundPassQueued = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (first >= 0) {
+        emit paragraphsLaidOut(first, last);
+    }
+    if (scheduleRest) {
+        scheduleBackgroundLayout();
+    }
+}
+
+void TextReflowEngine::scheduleBackgroundLayout() {
+    QPointer<TextReflowEngine> self(this);
+    RenderScheduler::instance().submit(
+        RenderScheduler::TaskClass::Background, [self]() {
+            if (!self) {
+                return;
+            }
+            // Lay out one chunk of stale paragraphs, then re-queue; a
+            // width/scale change mid-pass just makes later chunks redo
+            // the affected paragraphs at the new revision
+            int first = -1;
+            int last = -1;
+            bool moreStale = false;
+            {
+                QMutexLocker locker(&self->m_mutex);
+                int done = 0;
+                for (int i = 0; i < self->m_paragraphs.size(); ++i) {
+                    if (self->m_paragraphs[i].revision == self->m_revision) {
+                        continue;
+                    }
+                    if (done == BACKGROUND_CHUNK) {
+                        moreStale = true;
+                        break;
+                    }
+                    self->layoutParagraphLocked(self->m_paragraphs[i]);
+                    first = first < 0 ? i : first;
+                    last = i;
+                    done++;
+                }
+                self->m_backgroundPassQueued = moreStale;
+            }
+            if (first >= 0) {
+                emit self->paragraphsLaidOut(first, last);
+            }
+            if (moreStale) {
+                self->scheduleBackgroundLayout();
+            }
+        });
+}
+
+double TextReflowEngine::paragraphHeight(int paragraph) const {
+    QMutexLocker locker(&m_mutex);
+    if (paragraph < 0 || paragraph >= m_paragraphs.size() ||
+        m_paragraphs[paragraph].revision != m_revision) {
+        return 0.0;
+    }
+    return m_paragraphs[paragraph].height;
+}
+
+int TextReflowEngine::lineCount(int paragraph) const {
+    QMutexLocker locker(&m_mutex);
+    if (paragraph < 0 || paragraph >= m_paragraphs.size() ||
+        m_paragraphs[paragraph].revision != m_revision) {
+        return 0;
+    }
+    return m_paragraphs[paragraph].lineStarts.size();
+}
+
+double TextReflowEngine::lineHeight(int paragraph) const {
+    QMutexLocker locker(&m_mutex);
+    if (paragraph < 0 || paragraph >= m_paragraphs.size()) {
+        return 0.0;
+    }
+    return m_paragraphs[paragraph].emSize * m_fontScale * LINE_SPACING;
+}
+
+QString TextReflowEngine::lineText(int paragraph, int line) const {
+    int pageNumber;
+    int firstWord;
+    int lastWord;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (paragraph < 0 || paragraph >= m_paragraphs.size()) {
+            return QString();
+        }
+        const Paragraph& record = m_paragraphs[paragraph];
+        if (record.revision != m_revision || line < 0 ||
+            line >= record.lineStarts.size()) {
+            return QString();
+        }
+        pageNumber = record.pageNumber;
+        firstWord = record.firstWord + record.lineStarts[line];
+        lastWord = line + 1 < record.lineStarts.size()
+                       ? record.firstWord + record.lineStarts[line + 1] - 1
+                       : record.firstWord + record.wordCount - 1;
+    }
+
+    if (!m_textIndex) {
+        return QString();
+    }
+    const std::shared_ptr<PageTextLayer> layer =
+        m_textIndex->textLayer(pageNumber);
+    if (!layer) {
+        return QString();
+    }
+    QString text;
+    for (int w = firstWord; w <= lastWord; ++w) {
+        if (!text.isEmpty()) {
+            text += QLatin1Char(' ');
+        }
+        text += layer->word(w);
+    }
+    return text;
+}
+
+int TextReflowEngine::paragraphPage(int paragraph) const {
+    QMutexLocker locker(&m_mutex);
+    if (paragraph < 0 || paragraph >= m_paragraphs.size()) {
+        return -1;
+    }
+    return m_paragraphs[paragraph].pageNumber;
+}
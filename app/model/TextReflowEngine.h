@@ -0,0 +1,113 @@
+#pragma once
+
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <memory>
+
+class DocumentTextIndex;
+class PageTextLayer;
+
+/**
+ * Paragraph-level reflow layout over the cached text layers.
+ *
+ * Paragraphs are segmented once per page from the PageTextLayer word
+ * boxes as the background text index reaches each page; every record
+ * keeps its words' natural widths and em size, so re-layout at a new
+ * width or font scale is pure arithmetic — no Poppler, no re-extraction.
+ *
+ * Layout is versioned: changing the width or font scale only bumps a
+ * revision counter. ensureLaidOut() re-lays the requested (viewport)
+ * paragraphs synchronously — a screenful is a few thousand additions —
+ * and the remainder is re-laid in chunks on the shared render pool at
+ * background priority, so a font-size change repaints the visible
+ * screen immediately while the rest of the document catches up.
+ *
+ * The engine is view-agnostic: a reflow view maps paragraph heights to
+ * scroll geometry and pulls line word-ranges/text for painting.
+ */
+class TextReflowEngine : public QObject {
+    Q_OBJECT
+
+public:
+    explicit TextReflowEngine(QObject* parent = nullptr);
+
+    // The index owns the per-page text layers; paragraphs are appended
+    // as its background pass indexes pages (pageIndexed signal)
+    void setTextIndex(DocumentTextIndex* textIndex);
+
+    // Layout inputs. Width is in layout units (device-independent
+    // pixels); font scale multiplies each paragraph's natural em size.
+    // Both only invalidate — call ensureLaidOut() for the viewport next
+    void setLayoutWidth(double width);
+    double layoutWidth() const;
+    void setFontScale(double scale);
+    double fontScale() const;
+
+    int paragraphCount() const;
+
+    // Synchronously (re-)lays out paragraphs [first, last] at the
+    // current width/scale and schedules background layout of the rest.
+    // Safe to call per paint; up-to-date paragraphs are skipped
+    void ensureLaidOut(int firstParagraph, int lastParagraph);
+
+    // Geometry of a laid-out paragraph. Height includes the trailing
+    // paragraph gap; stale or unknown paragraphs report 0 lines
+    double paragraphHeight(int paragraph) const;
+    int lineCount(int paragraph) const;
+    double lineHeight(int paragraph) const;
+
+    // Assembled text of one wrapped line (for painting); allocates, so
+    // paint-path only
+    QString lineText(int paragraph, int line) const;
+
+    // Source location, for syncing reflow position with page view
+    int paragraphPage(int paragraph) const;
+
+signals:
+    // Width/scale changed; all cached layout is stale
+    void layoutInvalidated();
+    // A contiguous paragraph range finished (re-)layout
+    void paragraphsLaidOut(int firstParagraph, int lastParagraph);
+
+private slots:
+    void onPageIndexed(int pageNumber);
+
+private:
+    struct Paragraph {
+        int pageNumber = 0;
+        int firstWord = 0;  // Index into the page's PageTextLayer
+        int wordCount = 0;
+        QVector<double> wordWidths;  // Natural widths (points)
+        double emSize = 0.0;         // Representative word height
+
+        // Layout result, valid while revision matches the engine's
+        quint64 revision = 0;
+        QVector<int> lineStarts;  // Word offsets of wrapped line starts
+        double height = 0.0;
+    };
+
+    void rebuildParagraphs();
+    void appendParagraphsForPage(int pageNumber,
+                                 const std::shared_ptr<PageTextLayer>& layer);
+    void layoutParagraphLocked(Paragraph& paragraph) const;
+    void scheduleBackgroundLayout();
+
+    mutable QMutex m_mutex;
+    DocumentTextIndex* m_textIndex;
+    QVector<Paragraph> m_paragraphs;
+    QVector<int> m_pageParagraphStart;  // First paragraph of each page
+
+    double m_layoutWidth;
+    double m_fontScale;
+    quint64 m_revision;  // Bumped on width/scale change
+    bool m_backgroundPassQueued;
+
+    // Vertical gap (in line heights) that starts a new paragraph, and
+    // the leading applied between wrapped lines
+    static constexpr double PARAGRAPH_GAP_FACTOR = 0.6;
+    static constexpr double LINE_SPACING = 1.4;
+    static constexpr double SPACE_WIDTH_EM = 0.33;
+    static constexpr int BACKGROUND_CHUNK = 64;
+};
@@ -0,0 +1,186 @@
+#include "TextSelectionEngine.h"
+#include <QMetaObject>
+#include <QPointer>
+#include "DocumentTextIndex.h"
+#include "PageTextLayer.h"
+#include "managers/RenderScheduler.h"
+
+TextSelectionEngine::TextSelectionEngine(QObject* parent)
+    : QObject(parent), m_textIndex(nullptr), m_generation(0) {}
+
+void TextSelectionEngine::setTextIndex(DocumentTextIndex* textIndex) {
+    m_textIndex = textIndex;
+    clearSelection();
+}
+
+bool TextSelectionEngine::beginSelection(int pageNumber,
+                                         const QPointF& pagePoint) {
+    clearSelection();
+    if (!m_textIndex) {
+        return false;
+    }
+
+    std::shared_ptr<PageTextLayer> layer = m_textIndex->textLayer(pageNumber);
+    if (!layer) {
+        return false;
+    }
+
+    // Anchoring requires an actual hit; the nearest-word fallback is
+    // only for dragging, otherwise clicks in the margin would start
+    // selections
+    const int word = layer->wordIndexAt(pagePoint);
+    if (word < 0) {
+        return false;
+    }
+
+    m_anchor = {pageNumber, word};
+    m_focus = m_anchor;
+    m_generation++;
+    emit selectionChanged();
+    return true;
+}
+
+bool TextSelectionEngine::extendSelection(int pageNumber,
+                                          const QPointF& pagePoint) {
+    if (!m_textIndex || !m_anchor.valid()) {
+        return false;
+    }
+
+    std::shared_ptr<PageTextLayer> layer = m_textIndex->textLayer(pageNumber);
+    if (!layer) {
+        return false;
+    }
+
+    const int word = layer->wordIndexNear(pagePoint);
+    if (word < 0) {
+        return false;
+    }
+
+    Endpoint focus{pageNumber, word};
+    if (focus.page == m_focus.page && focus.word == m_focus.word) {
+        return true;  // No movement, no repaint needed
+    }
+
+    m_focus = focus;
+    m_generation++;
+    emit selectionChanged();
+    return true;
+}
+
+void TextSelectionEngine::clearSelection() {
+    const bool hadSelection = m_anchor.valid();
+    m_anchor = Endpoint();
+    m_focus = Endpoint();
+    m_generation++;
+    if (hadSelection) {
+        emit selectionChanged();
+    }
+}
+
+bool TextSelectionEngine::hasSelection() const { return m_anchor.valid(); }
+
+void TextSelectionEngine::normalized(Endpoint& start, Endpoint& end) const {
+    if (m_focus < m_anchor) {
+        start = m_focus;
+        end = m_anchor;
+    } else {
+        start = m_anchor;
+        end = m_focus;
+    }
+}
+
+int TextSelectionEngine::firstSelectedPage() const {
+    if (!hasSelection()) {
+        return -1;
+    }
+    Endpoint start, end;
+    normalized(start, end);
+    return start.page;
+}
+
+int TextSelectionEngine::lastSelectedPage() const {
+    if (!hasSelection()) {
+        return -1;
+    }
+    Endpoint start, end;
+    normalized(start, end);
+    return end.page;
+}
+
+QVector<QRectF> TextSelectionEngine::selectionBoxes(int pageNumber) const {
+    QVector<QRectF> boxes;
+    if (!m_textIndex || !hasSelection()) {
+        return boxes;
+    }
+
+    Endpoint start, end;
+    normalized(start, end);
+    if (pageNumber < start.page || pageNumber > end.page) {
+        return boxes;
+    }
+
+    std::shared_ptr<PageTextLayer> layer = m_textIndex->textLayer(pageNumber);
+    if (!layer) {
+        return boxes;
+    }
+
+    const int fromWord = pageNumber == start.page ? start.word : 0;
+    const int toWord =
+        pageNumber == end.page ? end.word : layer->wordCount() - 1;
+    boxes.reserve(toWord - fromWord + 1);
+    for (int word = fromWord; word <= toWord; ++word) {
+        boxes.append(layer->wordBox(word));
+    }
+    return boxes;
+}
+
+void TextSelectionEngine::requestSelectedText() {
+    if (!m_textIndex || !hasSelection()) {
+        return;
+    }
+
+    Endpoint start, end;
+    normalized(start, end);
+    const quint64 generation = m_generation;
+
+    QPointer<TextSelectionEngine> self(this);
+    QPointer<DocumentTextIndex> index(m_textIndex);
+    RenderScheduler::instance().submit(
+        RenderScheduler::TaskClass::Background,
+        [self, index, start, end, generation]() {
+            if (!self || !index) {
+                return;
+            }
+
+            // Layers are immutable and shared; textLayer() is
+            // thread-safe, so assembly never touches Poppler or the
+            // GUI thread
+            QString text;
+            for (int page = start.page; page <= end.page; ++page) {
+                std::shared_ptr<PageTextLayer> layer = index->textLayer(page);
+                if (!layer || layer->wordCount() == 0) {
+                    continue;
+                }
+                const int fromWord = page == start.page ? start.word : 0;
+                const int toWord =
+                    page == end.page ? end.word : layer->wordCount() - 1;
+                const int charStart = layer->wordStarts().value(fromWord, 0);
+                const int charEnd = layer->wordStarts().value(toWord, 0) +
+                                    layer->word(toWord).length();
+                if (!text.isEmpty()) {
+                    text += QLatin1Char('\n');
+                }
+                text += layer->text().mid(charStart, charEnd - charStart);
+            }
+
+            QMetaObject::invokeMethod(
+                self,
+                [self, text, generation]() {
+                    // Selection changed while assembling; drop it
+                    if (self && generation == self->m_generation) {
+                        emit self->selectedTextReady(text);
+                    }
+                },
+                Qt::QueuedConnection);
+        });
+}
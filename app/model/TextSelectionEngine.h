@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QObject>
+#include <QPointF>
+#include <QRectF>
+#include <QString>
+#include <QVector>
+
+class DocumentTextIndex;
+
+/**
+ * Word-granularity text selection over the cached text layers.
+ *
+ * Mouse tracking only moves two (page, word) endpoints — a grid lookup
+ * in the page's PageTextLayer, no Poppler calls and no string work —
+ * so dragging across dense tables stays cheap. Selections may span
+ * pages (continuous mode). The selected text itself is only assembled
+ * when the user actually copies, on the shared pool, and delivered via
+ * selectedTextReady on the engine's thread.
+ */
+class TextSelectionEngine : public QObject {
+    Q_OBJECT
+
+public:
+    explicit TextSelectionEngine(QObject* parent = nullptr);
+
+    // The index owns the per-page text layers; it must outlive active
+    // selections (both live for the document session)
+    void setTextIndex(DocumentTextIndex* textIndex);
+
+    // Anchor the selection at the word nearest the point (PDF
+    // coordinates). Returns false — and clears any previous selection —
+    // if the point is not near text
+    bool beginSelection(int pageNumber, const QPointF& pagePoint);
+
+    // Move the free endpoint; geometry-only, safe to call per
+    // mouse-move event
+    bool extendSelection(int pageNumber, const QPointF& pagePoint);
+
+    void clearSelection();
+    bool hasSelection() const;
+
+    int firstSelectedPage() const;
+    int lastSelectedPage() const;
+
+    // Word boxes of the selection on one page (PDF coordinates), for
+    // painting highlights
+    QVector<QRectF> selectionBoxes(int pageNumber) const;
+
+    // Assemble the selected text asynchronously; emits
+    // selectedTextReady when done. Results for a selection that changed
+    // in the meantime are dropped
+    void requestSelectedText();
+
+signals:
+    void selectionChanged();
+    void selectedTextReady(const QString& text);
+
+private:
+    struct Endpoint {
+        int page = -1;
+        int word = -1;
+
+        bool valid() const { return page >= 0 && word >= 0; }
+        bool operator<(const Endpoint& other) const {
+            return page != other.page ? page < other.page : word < other.word;
+        }
+    };
+
+    void normalized(Endpoint& start, Endpoint& end) const;
+
+    DocumentTextIndex* m_textIndex;
+    Endpoint m_anchor;
+    Endpoint m_focus;
+    quint64 m_generation;  // Bumped on any change; stale assemblies bail
+};
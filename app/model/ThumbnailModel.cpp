@@ -4,7 +4,14 @@
 #include <QDateTime>
 #include <QDebug>
 #include <QMutexLocker>
+#include <QPointer>
+#include "../cache/PDFCacheManager.h"
+#include "../managers/HeartbeatService.h"
+#include "../managers/MemoryGovernor.h"
 #include "../ui/thumbnail/ThumbnailGenerator.h"
+#include "../utils/RenderPolicy.h"
+#include "PageGeometryIndex.h"
+#include "PageMutationPlan.h"
 
 ThumbnailModel::ThumbnailModel(QObject* parent)
     : QAbstractListModel(parent),
@@ -23,13 +30,33 @@ ThumbnailModel::ThumbnailModel(QObject* parent)
       m_cacheCompressionRatio(0.8),
       m_adaptiveCaching(true),
       m_lastCleanupTime(0) {
+    // 低内存档位：缩略图分辨率减半（像素数降为1/4）、缓存条目数减半，
+    // 与RenderPolicy的DPI上限等其他子系统的降级保持一致
+    if (RenderPolicy::lowMemoryProfile()) {
+        m_thumbnailSize =
+            QSize(DEFAULT_THUMBNAIL_WIDTH / 2, DEFAULT_THUMBNAIL_HEIGHT / 2);
+        m_maxCacheSize = DEFAULT_CACHE_SIZE / 2;
+    }
+
     initializeModel();
+
+    // 注册到全局内存调控器：m_maxMemory由调控器按全局预算动态分配
+    m_governorId = MemoryGovernor::instance().registerConsumer(
+        "thumbnails", [this]() { return m_currentMemory; },
+        [this]() {
+            int total = m_cacheHits + m_cacheMisses;
+            return total > 0 ? static_cast<double>(m_cacheHits) / total : 0.0;
+        },
+        [this](qint64 budget) { setMemoryLimit(budget); },
+        [this]() { clearCache(); });
 }
 
 ThumbnailModel::~ThumbnailModel() {
-    if (m_preloadTimer) {
-        m_preloadTimer->stop();
-    }
+    MemoryGovernor::instance().unregisterConsumer(m_governorId);
+    HeartbeatService::instance().unregister(m_preloadHeartbeatId);
+    HeartbeatService::instance().unregister(m_cleanupHeartbeatId);
+    HeartbeatService::instance().unregister(m_priorityHeartbeatId);
+    HeartbeatService::instance().unregister(m_viewportCoalesceHeartbeatId);
     clearCache();
 }
 
@@ -43,27 +70,44 @@ void ThumbnailModel::initializeModel() {
     connect(m_generator.get(), &ThumbnailGenerator::thumbnailError, this,
             &ThumbnailModel::onThumbnailError);
 
-    // 设置预加载定时器
-    m_preloadTimer = new QTimer(this);
-    m_preloadTimer->setInterval(PRELOAD_TIMER_INTERVAL);
-    m_preloadTimer->setSingleShot(false);
-    connect(m_preloadTimer, &QTimer::timeout, this,
-            &ThumbnailModel::onPreloadTimer);
-
-    // 设置缓存清理定时器
-    QTimer* cleanupTimer = new QTimer(this);
-    cleanupTimer->setInterval(30000);  // 30秒清理一次
-    cleanupTimer->setSingleShot(false);
-    connect(cleanupTimer, &QTimer::timeout, this,
-            &ThumbnailModel::cleanupCache);
-    cleanupTimer->start();
-
-    // 设置优先级更新定时器
-    m_priorityUpdateTimer = new QTimer(this);
-    m_priorityUpdateTimer->setInterval(200);  // 200ms间隔
-    m_priorityUpdateTimer->setSingleShot(false);
-    connect(m_priorityUpdateTimer, &QTimer::timeout, this,
-            &ThumbnailModel::onPriorityUpdateTimer);
+    // 各定时任务注册到共享心跳服务：预加载/清理/优先级/视口合并
+    // 不再各持一个QTimer，唤醒按粗粒度桶合并
+    QPointer<ThumbnailModel> self(this);
+
+    // 预加载节拍：按需启停，注册后先停
+    m_preloadHeartbeatId = HeartbeatService::instance().registerPeriodic(
+        "thumbnail-preload", PRELOAD_TIMER_INTERVAL, [self]() {
+            if (self) {
+                self->onPreloadTimer();
+            }
+        });
+    HeartbeatService::instance().disarm(m_preloadHeartbeatId);
+
+    // 缓存清理：30秒一次
+    m_cleanupHeartbeatId = HeartbeatService::instance().registerPeriodic(
+        "thumbnail-cleanup", 30000, [self]() {
+            if (self) {
+                self->cleanupCache();
+            }
+        });
+
+    // 优先级更新：懒加载开启时以200ms节拍运行
+    m_priorityHeartbeatId = HeartbeatService::instance().registerPeriodic(
+        "thumbnail-priority", 200, [self]() {
+            if (self) {
+                self->onPriorityUpdateTimer();
+            }
+        });
+    HeartbeatService::instance().disarm(m_priorityHeartbeatId);
+
+    // 视口合并：滚动停止后才为最终视口批量请求
+    m_viewportCoalesceHeartbeatId =
+        HeartbeatService::instance().registerDeadline(
+            "thumbnail-viewport", [self]() {
+                if (self) {
+                    self->onViewportSettled();
+                }
+            });
 }
 
 int ThumbnailModel::rowCount(const QModelIndex& parent) const {
@@ -127,6 +171,19 @@ QVariant ThumbnailModel::data(const QModelIndex& index, int role) const {
                 return it->pageSize;
             }
 
+            // 几何索引命中时完全不碰Poppler页面对象
+            if (!m_geometryHash.isEmpty()) {
+                QSizeF indexed = PageGeometryIndex::instance().pageSize(
+                    m_geometryHash, pageNumber);
+                if (!indexed.isEmpty()) {
+                    QSize size = indexed.toSize();
+                    ThumbnailItem& item = const_cast<ThumbnailModel*>(this)
+                                              ->m_thumbnails[pageNumber];
+                    item.pageSize = size;
+                    return size;
+                }
+            }
+
             // 如果没有缓存页面尺寸，尝试获取
             if (m_document) {
                 std::unique_ptr<Poppler::Page> page(
@@ -151,6 +208,40 @@ QVariant ThumbnailModel::data(const QModelIndex& index, int role) const {
     }
 }
 
+ThumbnailModel::PaintSnapshot ThumbnailModel::paintSnapshot(
+    int pageNumber) const {
+    PaintSnapshot snapshot;
+    if (!m_document || pageNumber < 0 ||
+        pageNumber >= m_document->numPages()) {
+        return snapshot;
+    }
+
+    QMutexLocker locker(&m_thumbnailsMutex);
+
+    auto it = m_thumbnails.find(pageNumber);
+    if (it != m_thumbnails.end()) {
+        it->lastAccessed = QDateTime::currentMSecsSinceEpoch();
+        const_cast<ThumbnailModel*>(this)->updateAccessFrequency(pageNumber);
+        snapshot.isLoading = it->isLoading;
+        snapshot.hasError = it->hasError;
+        snapshot.errorMessage = it->errorMessage;
+        if (!it->pixmap.isNull()) {
+            const_cast<ThumbnailModel*>(this)->m_cacheHits++;
+            // 指向行内存储；命中路径到此为止不再改动哈希，
+            // 指针在本次paint()内保持有效
+            snapshot.pixmap = &it->pixmap;
+            return snapshot;
+        }
+    }
+
+    // 未命中才会触发生成请求（可能插入新条目），
+    // 此时尚未取任何指针，先解锁再走与data()相同的请求路径
+    locker.unlock();
+    const_cast<ThumbnailModel*>(this)->m_cacheMisses++;
+    const_cast<ThumbnailModel*>(this)->requestThumbnail(pageNumber);
+    return snapshot;
+}
+
 Qt::ItemFlags ThumbnailModel::flags(const QModelIndex& index) const {
     if (!index.isValid()) {
         return Qt::NoItemFlags;
@@ -170,16 +261,47 @@ QHash<int, QByteArray> ThumbnailModel::roleNames() const {
 }
 
 void ThumbnailModel::setDocument(std::shared_ptr<Poppler::Document> document) {
-    beginResetModel();
+    const int oldCount = rowCount();
+    const int newCount = document ? document->numPages() : 0;
+
+    // 页数变化只声明插入/删除的区间，而不是整体reset：视图因此
+    // 保留滚动位置、选中态和未受影响行的布局
+    if (newCount > oldCount) {
+        beginInsertRows(QModelIndex(), oldCount, newCount - 1);
+        m_document = document;
+        endInsertRows();
+    } else if (newCount < oldCount) {
+        beginRemoveRows(QModelIndex(), newCount, oldCount - 1);
+        m_document = document;
+        endRemoveRows();
+    } else {
+        m_document = document;
+    }
 
-    m_document = document;
     clearCache();
 
+    // 预扫描页面几何：曾扫描过的文档立即拿到全部页面尺寸，
+    // 首次打开则在后台一遍扫完并持久化，之后PageSizeRole零Poppler查询
+    m_geometryHash = m_document ? PDFCacheManager::namespaceForDocument(
+                                      m_document.get())
+                                : QString();
+    if (!m_geometryHash.isEmpty()) {
+        PageGeometryIndex::instance().ensureScanned(m_geometryHash,
+                                                    m_document.get());
+    }
+
     if (m_generator) {
         m_generator->setDocument(document);
     }
 
-    endResetModel();
+    // 两文档共有的行号换了内容，逐行失效
+    const int commonCount = qMin(oldCount, newCount);
+    if (commonCount > 0) {
+        emit dataChanged(
+            index(0), index(commonCount - 1),
+            {PixmapRole, LoadingRole, ErrorRole, ErrorMessageRole,
+             PageSizeRole});
+    }
 }
 
 void ThumbnailModel::setThumbnailSize(const QSize& size) {
@@ -193,9 +315,11 @@ void ThumbnailModel::setThumbnailSize(const QSize& size) {
         // 清除现有缓存，因为尺寸改变了
         clearCache();
 
-        // 通知视图刷新
+        // 带角色列表的dataChanged让视图就地重取位图并按新尺寸
+        // 重排，不触发reset，滚动位置和选中态都保留
         if (rowCount() > 0) {
-            emit dataChanged(index(0), index(rowCount() - 1));
+            emit dataChanged(index(0), index(rowCount() - 1),
+                             {PixmapRole, PageSizeRole});
         }
     }
 }
@@ -211,9 +335,10 @@ void ThumbnailModel::setThumbnailQuality(double quality) {
         // 清除现有缓存，因为质量改变了
         clearCache();
 
-        // 通知视图刷新
+        // 质量只影响位图内容，不影响布局：限定PixmapRole避免视图
+        // 重新计算全部行的几何
         if (rowCount() > 0) {
-            emit dataChanged(index(0), index(rowCount() - 1));
+            emit dataChanged(index(0), index(rowCount() - 1), {PixmapRole});
         }
     }
 }
@@ -342,6 +467,75 @@ void ThumbnailModel::refreshThumbnail(int pageNumber) {
     // 重新请求
     requestThumbnail(pageNumber);
 
+    // 旧位图已丢弃，本行就地重取
+    QModelIndex idx = index(pageNumber);
+    emit dataChanged(idx, idx, {PixmapRole});
+
+    emit cacheUpdated();
+    emit memoryUsageChanged(m_currentMemory);
+}
+
+void ThumbnailModel::applyPageMapping(const PageIndexMap& map) {
+    if (map.isIdentity()) {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&m_thumbnailsMutex);
+
+        // 已生成的像素按索引平移到新页号，被删页随映射丢弃；
+        // 一次500页的抽取重排只是一趟哈希重建，不产生再生成风暴
+        QHash<int, ThumbnailItem> remapped;
+        remapped.reserve(m_thumbnails.size());
+        qint64 memory = 0;
+        for (auto it = m_thumbnails.constBegin();
+             it != m_thumbnails.constEnd(); ++it) {
+            const int newPage = map.mapFromOld(it.key());
+            if (newPage >= 0) {
+                remapped.insert(newPage, it.value());
+                memory += it.value().memorySize;
+            }
+        }
+        m_thumbnails = remapped;
+        m_currentMemory = memory;
+        m_preloadQueue.clear();  // 旧页号的预载请求全部作废
+    }
+
+    // 访问频率与优先级是启发式统计，同样平移；映射不到的丢弃
+    QHash<int, int> frequency;
+    frequency.reserve(m_accessFrequency.size());
+    for (auto it = m_accessFrequency.constBegin();
+         it != m_accessFrequency.constEnd(); ++it) {
+        const int newPage = map.mapFromOld(it.key());
+        if (newPage >= 0) {
+            frequency.insert(newPage, it.value());
+        }
+    }
+    m_accessFrequency = frequency;
+
+    QHash<int, int> priorities;
+    priorities.reserve(m_pagePriorities.size());
+    for (auto it = m_pagePriorities.constBegin();
+         it != m_pagePriorities.constEnd(); ++it) {
+        const int newPage = map.mapFromOld(it.key());
+        if (newPage >= 0) {
+            priorities.insert(newPage, it.value());
+        }
+    }
+    m_pagePriorities = priorities;
+
+    if (map.newPageCount() != map.oldPageCount()) {
+        // 行数变化只能整表重置；贵的是像素，上面已原位保留，
+        // 视图重排几百行是毫秒级的
+        beginResetModel();
+        endResetModel();
+    } else {
+        // 纯重排：只对计算出的受影响区间通知一次
+        emit dataChanged(index(map.firstChanged()),
+                         index(map.lastChanged()),
+                         {PixmapRole, LoadingRole, ErrorRole, PageSizeRole});
+    }
+
     emit cacheUpdated();
     emit memoryUsageChanged(m_currentMemory);
 }
@@ -350,7 +544,8 @@ void ThumbnailModel::refreshAllThumbnails() {
     clearCache();
 
     if (rowCount() > 0) {
-        emit dataChanged(index(0), index(rowCount() - 1));
+        emit dataChanged(index(0), index(rowCount() - 1),
+                         {PixmapRole, LoadingRole, ErrorRole});
     }
 }
 
@@ -371,9 +566,10 @@ void ThumbnailModel::preloadVisibleRange(int firstVisible, int lastVisible) {
         }
     }
 
-    // 启动预加载定时器
-    if (!m_preloadQueue.isEmpty() && !m_preloadTimer->isActive()) {
-        m_preloadTimer->start();
+    // 启动预加载节拍
+    if (!m_preloadQueue.isEmpty() &&
+        !HeartbeatService::instance().isArmed(m_preloadHeartbeatId)) {
+        HeartbeatService::instance().arm(m_preloadHeartbeatId);
     }
 }
 
@@ -438,7 +634,7 @@ void ThumbnailModel::onThumbnailError(int pageNumber, const QString& error) {
 
 void ThumbnailModel::onPreloadTimer() {
     if (m_preloadQueue.isEmpty()) {
-        m_preloadTimer->stop();
+        HeartbeatService::instance().disarm(m_preloadHeartbeatId);
         return;
     }
 
@@ -448,9 +644,9 @@ void ThumbnailModel::onPreloadTimer() {
 
     requestThumbnail(pageNumber);
 
-    // 如果队列为空，停止定时器
+    // 如果队列为空，停下节拍，让心跳真正空闲
     if (m_preloadQueue.isEmpty()) {
-        m_preloadTimer->stop();
+        HeartbeatService::instance().disarm(m_preloadHeartbeatId);
     }
 }
 
@@ -540,10 +736,10 @@ bool ThumbnailModel::shouldPreload(int pageNumber) const {
 // 懒加载和视口管理实现
 void ThumbnailModel::setLazyLoadingEnabled(bool enabled) {
     m_lazyLoadingEnabled = enabled;
-    if (enabled && m_priorityUpdateTimer) {
-        m_priorityUpdateTimer->start();
-    } else if (m_priorityUpdateTimer) {
-        m_priorityUpdateTimer->stop();
+    if (enabled) {
+        HeartbeatService::instance().arm(m_priorityHeartbeatId);
+    } else {
+        HeartbeatService::instance().disarm(m_priorityHeartbeatId);
     }
 }
 
@@ -555,6 +751,31 @@ void ThumbnailModel::setViewportRange(int start, int end, int margin) {
     if (m_lazyLoadingEnabled) {
         updateViewportPriorities();
     }
+
+    if (m_generator && m_document) {
+        // 立即丢弃已滚过区域的排队请求，并按新视口重排剩余请求
+        int cancelStart = qMax(0, start - m_viewportMargin);
+        int cancelEnd =
+            qMin(m_document->numPages() - 1, end + m_viewportMargin);
+        m_generator->cancelRequestsOutside(cancelStart, cancelEnd);
+        m_generator->reprioritizeForViewport(start, end);
+    }
+
+    // 快速连续滚动合并为一次批量请求（针对最终停留的视口）；
+    // 重复arm即重置去抖窗口
+    HeartbeatService::instance().arm(m_viewportCoalesceHeartbeatId,
+                                     VIEWPORT_COALESCE_INTERVAL);
+}
+
+void ThumbnailModel::onViewportSettled() {
+    if (!m_document || m_visibleStart < 0 || m_visibleEnd < 0) {
+        return;
+    }
+
+    int start = qMax(0, m_visibleStart - m_viewportMargin);
+    int end =
+        qMin(m_document->numPages() - 1, m_visibleEnd + m_viewportMargin);
+    requestThumbnailRange(start, end);
 }
 
 void ThumbnailModel::updateViewportPriorities() {
@@ -13,7 +13,6 @@
 #include <QPixmap>
 #include <QSet>
 #include <QSize>
-#include <QTimer>
 #include <QVariant>
 #include <memory>
 
@@ -23,6 +22,7 @@ class Document;
 class Page;
 }  // namespace Poppler
 
+class PageIndexMap;
 class ThumbnailGenerator;
 
 /**
@@ -58,6 +58,19 @@ public:
     Qt::ItemFlags flags(const QModelIndex& index) const override;
     QHash<int, QByteArray> roleNames() const override;
 
+    // 委托绘制直通路径：一次加锁取回paint()所需的全部状态，
+    // 绕过逐role的QVariant装箱（滚动时每个可见行每次重绘五次
+    // data()调用）。pixmap指向行内存储，不复制、不增引用计数；
+    // 仅在本次paint()调用期间有效——模型与视图同在GUI线程，
+    // 命中路径不触碰哈希结构，指针在控制权交回事件循环前不会失效
+    struct PaintSnapshot {
+        const QPixmap* pixmap = nullptr;  // 无缩略图时为空
+        bool isLoading = false;
+        bool hasError = false;
+        QString errorMessage;
+    };
+    PaintSnapshot paintSnapshot(int pageNumber) const;
+
     // 文档管理
     void setDocument(std::shared_ptr<Poppler::Document> document);
     std::shared_ptr<Poppler::Document> document() const { return m_document; }
@@ -85,6 +98,10 @@ public:
     void requestThumbnail(int pageNumber);
     void requestThumbnailRange(int startPage, int endPage);
 
+    // 批量页面操作落账：缓存的缩略图按索引平移复用而非重新生成，
+    // 视图只收到一次通知。须在底层文档已反映变更后调用
+    void applyPageMapping(const PageIndexMap& map);
+
     // 状态查询
     bool isLoading(int pageNumber) const;
     bool hasError(int pageNumber) const;
@@ -118,6 +135,7 @@ private slots:
     void onPreloadTimer();
     void cleanupCache();
     void onPriorityUpdateTimer();
+    void onViewportSettled();
 
 private:
     struct ThumbnailItem {
@@ -156,6 +174,7 @@ private:
     // 数据成员
     std::shared_ptr<Poppler::Document> m_document;
     std::unique_ptr<ThumbnailGenerator> m_generator;
+    QString m_geometryHash;  // 页面几何索引的文档命名空间，空则不可用
 
     mutable QHash<int, ThumbnailItem> m_thumbnails;
     mutable QMutex m_thumbnailsMutex;
@@ -176,9 +195,10 @@ private:
     QHash<int, int> m_accessFrequency;
     qint64 m_lastCleanupTime;
 
-    // 预加载和懒加载优化
+    // 预加载和懒加载优化。各定时任务统一注册到 HeartbeatService，
+    // 共用一个合并唤醒的定时器，而不是各自唤醒事件循环
     int m_preloadRange;
-    QTimer* m_preloadTimer;
+    int m_preloadHeartbeatId = -1;
     QSet<int> m_preloadQueue;
 
     // 视口管理
@@ -189,7 +209,16 @@ private:
 
     // 优先级管理
     QHash<int, int> m_pagePriorities;
-    QTimer* m_priorityUpdateTimer;
+    int m_priorityHeartbeatId = -1;
+
+    // 全局内存调控器注册号
+    int m_governorId = -1;
+
+    // 视口合并：快速滚动时只为最终停留的视口批量生成
+    int m_viewportCoalesceHeartbeatId = -1;
+
+    // 周期性缓存清理
+    int m_cleanupHeartbeatId = -1;
 
     // 常量
     static constexpr int DEFAULT_THUMBNAIL_WIDTH = 120;
@@ -198,5 +227,6 @@ private:
     static constexpr int DEFAULT_CACHE_SIZE = 100;
     static constexpr qint64 DEFAULT_MEMORY_LIMIT = 128 * 1024 * 1024;  // 128MB
     static constexpr int DEFAULT_PRELOAD_RANGE = 5;
-    static constexpr int PRELOAD_TIMER_INTERVAL = 100;  // ms
+    static constexpr int PRELOAD_TIMER_INTERVAL = 100;        // ms
+    static constexpr int VIEWPORT_COALESCE_INTERVAL = 120;    // ms
 };
@@ -3,7 +3,9 @@
 #include <QDebug>
 #include <QDirIterator>
 #include <QElapsedTimer>
+#include <QFile>
 #include <QFileInfo>
+#include <QSaveFile>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -101,11 +103,14 @@ PluginManager& PluginManager::instance() {
 PluginManager::PluginManager(QObject* parent)
     : QObject(parent),
       m_settings(nullptr),
+      m_manifestDirty(false),
       m_hotReloadingEnabled(false),
       m_hotReloadTimer(nullptr) {
     // Initialize settings
     m_settings = new QSettings("SAST", "Readium-Plugins", this);
 
+    loadManifestCache();
+
     // Setup default plugin directories
     QStringList defaultDirs;
     defaultDirs << QApplication::applicationDirPath() + "/plugins";
@@ -155,13 +160,23 @@ void PluginManager::scanForPlugins() {
         while (it.hasNext()) {
             QString filePath = it.next();
 
+            // Manifest hit: metadata comes from the cache without
+            // opening the plugin binary at all
+            PluginMetadata metadata;
+            if (metadataFromManifest(filePath, &metadata)) {
+                m_pluginMetadata[metadata.name] = metadata;
+                pluginCount++;
+                continue;
+            }
+
             if (validatePlugin(filePath)) {
                 QPluginLoader loader(filePath);
-                PluginMetadata metadata = extractMetadata(&loader);
+                metadata = extractMetadata(&loader);
 
                 if (!metadata.name.isEmpty()) {
                     metadata.filePath = filePath;
                     m_pluginMetadata[metadata.name] = metadata;
+                    storeInManifest(metadata);
                     pluginCount++;
 
                     qDebug()
@@ -171,6 +186,11 @@ void PluginManager::scanForPlugins() {
         }
     }
 
+    saveManifestCache();
+
+    // Enabled/disabled state applies to the freshly registered set
+    loadSettings();
+
     qDebug() << "Found" << pluginCount << "plugins";
     emit pluginsScanned(pluginCount);
 }
@@ -193,13 +213,31 @@ bool PluginManager::loadPlugin(const QString& pluginName) {
         return false;
     }
 
-    // Check dependencies
+    // Re-entrancy guard: a dependency cycle must not recurse forever
+    if (m_loadingInProgress.contains(pluginName)) {
+        qWarning() << "Cyclic dependency while loading plugin:" << pluginName;
+        return false;
+    }
+    m_loadingInProgress.insert(pluginName);
+
+    // With lazy activation a dependency is usually registered but not
+    // loaded yet; pull it in before giving up
+    if (!checkDependencies(pluginName)) {
+        for (const QString& dependency : metadata.dependencies) {
+            if (!isPluginLoaded(dependency)) {
+                loadPlugin(dependency);
+            }
+        }
+    }
     if (!checkDependencies(pluginName)) {
         qWarning() << "Plugin dependencies not satisfied:" << pluginName;
+        m_loadingInProgress.remove(pluginName);
         return false;
     }
 
-    return loadPluginFromFile(metadata.filePath);
+    const bool loaded = loadPluginFromFile(metadata.filePath);
+    m_loadingInProgress.remove(pluginName);
+    return loaded;
 }
 
 bool PluginManager::loadPluginFromFile(const QString& filePath) {
@@ -357,7 +395,23 @@ void PluginManager::setPluginEnabled(const QString& pluginName, bool enabled) {
 }
 
 IPlugin* PluginManager::getPlugin(const QString& pluginName) const {
-    return m_loadedPlugins.value(pluginName, nullptr);
+    IPlugin* plugin = m_loadedPlugins.value(pluginName, nullptr);
+    if (plugin) {
+        return plugin;
+    }
+
+    // Lazy activation: scanning only parked the manifest entry, so the
+    // shared object is loaded and initialized on first access. Loading
+    // mutates the plugin tables; the registry itself is conceptually
+    // const to the caller.
+    if (m_pluginMetadata.contains(pluginName) &&
+        m_pluginMetadata[pluginName].isEnabled) {
+        auto* self = const_cast<PluginManager*>(this);
+        if (self->loadPlugin(pluginName)) {
+            return m_loadedPlugins.value(pluginName, nullptr);
+        }
+    }
+    return nullptr;
 }
 
 QList<IPlugin*> PluginManager::getPluginsByType(
@@ -439,6 +493,122 @@ PluginMetadata PluginManager::extractMetadata(QPluginLoader* loader) const {
     return metadata;
 }
 
+QString PluginManager::manifestCachePath() const {
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) +
+           "/plugin-manifest.json";
+}
+
+void PluginManager::loadManifestCache() {
+    m_manifestCache.clear();
+    m_manifestDirty = false;
+
+    QFile file(manifestCachePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QJsonParseError parseError;
+    const QJsonDocument doc =
+        QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+        return;
+    }
+
+    const QJsonObject plugins = doc.object().value("plugins").toObject();
+    for (auto it = plugins.begin(); it != plugins.end(); ++it) {
+        m_manifestCache[it.key()] = it.value().toObject();
+    }
+
+    qDebug() << "Loaded plugin manifest cache with" << m_manifestCache.size()
+             << "entries";
+}
+
+void PluginManager::saveManifestCache() {
+    if (!m_manifestDirty) {
+        return;
+    }
+
+    QJsonObject plugins;
+    for (auto it = m_manifestCache.begin(); it != m_manifestCache.end(); ++it) {
+        plugins[it.key()] = it.value();
+    }
+    QJsonObject root;
+    root["version"] = 1;
+    root["plugins"] = plugins;
+
+    QDir().mkpath(QFileInfo(manifestCachePath()).absolutePath());
+    QSaveFile file(manifestCachePath());
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Cannot write plugin manifest cache:"
+                   << manifestCachePath();
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    file.commit();
+    m_manifestDirty = false;
+}
+
+bool PluginManager::metadataFromManifest(const QString& filePath,
+                                         PluginMetadata* out) const {
+    auto it = m_manifestCache.constFind(filePath);
+    if (it == m_manifestCache.constEnd()) {
+        return false;
+    }
+
+    // Revalidate by mtime and size; a rebuilt plugin falls back to a
+    // full metadata extraction
+    const QJsonObject& entry = *it;
+    QFileInfo fileInfo(filePath);
+    if (entry.value("mtimeMs").toVariant().toLongLong() !=
+            fileInfo.lastModified().toMSecsSinceEpoch() ||
+        entry.value("size").toVariant().toLongLong() != fileInfo.size()) {
+        return false;
+    }
+
+    PluginMetadata metadata;
+    metadata.name = entry.value("name").toString();
+    if (metadata.name.isEmpty()) {
+        return false;
+    }
+    metadata.version = entry.value("version").toString();
+    metadata.description = entry.value("description").toString();
+    metadata.author = entry.value("author").toString();
+    metadata.filePath = filePath;
+    for (const QJsonValue& dep : entry.value("dependencies").toArray()) {
+        metadata.dependencies.append(dep.toString());
+    }
+    for (const QJsonValue& type : entry.value("supportedTypes").toArray()) {
+        metadata.supportedTypes.append(type.toString());
+    }
+    for (const QJsonValue& feature : entry.value("features").toArray()) {
+        metadata.features.append(feature.toString());
+    }
+    metadata.configuration = entry.value("configuration").toObject();
+
+    *out = metadata;
+    return true;
+}
+
+void PluginManager::storeInManifest(const PluginMetadata& metadata) {
+    QFileInfo fileInfo(metadata.filePath);
+
+    QJsonObject entry;
+    entry["mtimeMs"] = fileInfo.lastModified().toMSecsSinceEpoch();
+    entry["size"] = fileInfo.size();
+    entry["name"] = metadata.name;
+    entry["version"] = metadata.version;
+    entry["description"] = metadata.description;
+    entry["author"] = metadata.author;
+    entry["dependencies"] = QJsonArray::fromStringList(metadata.dependencies);
+    entry["supportedTypes"] =
+        QJsonArray::fromStringList(metadata.supportedTypes);
+    entry["features"] = QJsonArray::fromStringList(metadata.features);
+    entry["configuration"] = metadata.configuration;
+
+    m_manifestCache[metadata.filePath] = entry;
+    m_manifestDirty = true;
+}
+
 bool PluginManager::checkDependencies(const QString& pluginName) const {
     if (!m_pluginMetadata.contains(pluginName)) {
         return false;
@@ -11,6 +11,7 @@
 #include <QMenu>
 #include <QObject>
 #include <QPluginLoader>
+#include <QSet>
 #include <QSettings>
 #include <QStringList>
 #include <QTimer>
@@ -145,7 +146,9 @@ public:
     bool isPluginEnabled(const QString& pluginName) const;
     void setPluginEnabled(const QString& pluginName, bool enabled);
 
-    // Plugin access
+    // Plugin access. Scanning only registers manifest entries; an
+    // enabled plugin's shared object is loaded and initialized on
+    // first access here.
     IPlugin* getPlugin(const QString& pluginName) const;
     template <typename T>
     T* getPlugin(const QString& pluginName) const {
@@ -233,6 +236,16 @@ private:
     bool checkDependencies(const QString& pluginName) const;
     void resolveAndLoadPlugins();
 
+    // Manifest cache: metadata extracted once per plugin binary and
+    // revalidated by mtime+size, so a warm scan is a stat() per file
+    // instead of opening every shared object
+    QString manifestCachePath() const;
+    void loadManifestCache();
+    void saveManifestCache();
+    bool metadataFromManifest(const QString& filePath,
+                              PluginMetadata* out) const;
+    void storeInManifest(const PluginMetadata& metadata);
+
     // Plugin storage
     QHash<QString, QPluginLoader*> m_pluginLoaders;
     QHash<QString, IPlugin*> m_loadedPlugins;
@@ -243,6 +256,13 @@ private:
     QStringList m_pluginDirectories;
     QSettings* m_settings;
 
+    // Manifest cache, keyed by plugin file path
+    QHash<QString, QJsonObject> m_manifestCache;
+    bool m_manifestDirty;
+
+    // Plugins currently in loadPlugin, to break dependency cycles
+    QSet<QString> m_loadingInProgress;
+
     // Hot reloading
     bool m_hotReloadingEnabled;
     QTimer* m_hotReloadTimer;
@@ -26,6 +26,7 @@ RightSideBar::RightSideBar(QWidget* parent)
       animation(nullptr),
       settings(nullptr),
       debugLogPanel(nullptr),
+      debugTabHost(nullptr),
       isCurrentlyVisible(true),
       preferredWidth(defaultWidth),
       lastWidth(defaultWidth) {
@@ -62,6 +63,15 @@ void RightSideBar::initContent() {
     tabWidget->addTab(toolsTab, "工具");
     tabWidget->addTab(debugTab, "调试");
 
+    // 调试面板带日志缓冲与过滤控件，构造不便宜；首次切到
+    // 调试页时再创建
+    connect(tabWidget, &QTabWidget::currentChanged, this,
+            [this](int index) {
+                if (tabWidget->widget(index) == debugTabHost) {
+                    ensureDebugTab();
+                }
+            });
+
     QVBoxLayout* mainLayout = new QVBoxLayout(this);
     mainLayout->addWidget(tabWidget);
 }
@@ -110,12 +120,19 @@ QWidget* RightSideBar::createToolsTab() {
 }
 
 QWidget* RightSideBar::createDebugTab() {
-    // Create the debug log panel
-    debugLogPanel = new DebugLogPanel();
+    // 只建占位页；DebugLogPanel在首次激活调试页时创建
+    debugTabHost = new QWidget();
+    QVBoxLayout* layout = new QVBoxLayout(debugTabHost);
+    layout->setContentsMargins(0, 0, 0, 0);
+    return debugTabHost;
+}
 
-    // The DebugLogPanel is already a complete widget, so we can return it
-    // directly
-    return debugLogPanel;
+void RightSideBar::ensureDebugTab() {
+    if (debugLogPanel) {
+        return;
+    }
+    debugLogPanel = new DebugLogPanel();
+    debugTabHost->layout()->addWidget(debugLogPanel);
 }
 
 void RightSideBar::initAnimation() {
@@ -47,7 +47,9 @@ private:
     QTabWidget* tabWidget;
     QPropertyAnimation* animation;
     QSettings* settings;
+    // 调试面板惰性构建：占位页先占页签，首次切到调试页才创建
     DebugLogPanel* debugLogPanel;
+    QWidget* debugTabHost;
 
     bool isCurrentlyVisible;
     int preferredWidth;
@@ -67,4 +69,5 @@ private:
     QWidget* createPropertiesTab();
     QWidget* createToolsTab();
     QWidget* createDebugTab();
+    void ensureDebugTab();
 };
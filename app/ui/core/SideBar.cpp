@@ -30,12 +30,19 @@ SideBar::SideBar(QWidget* parent)
       settings(nullptr),
       outlineWidget(nullptr),
       thumbnailView(nullptr),
+      thumbnailsTabHost(nullptr),
+      bookmarksTabHost(nullptr),
+      pendingOutlineModel(nullptr),
+      currentThumbnailSize(120, 160),
       isCurrentlyVisible(true),
       preferredWidth(defaultWidth),
       lastWidth(defaultWidth) {
-    // 初始化缩略图组件
+    // 模型与委托立即创建：外部在文档加载路径上就要往模型里
+    // 写数据，且两者构造开销很小。视图等重量级控件惰性构建
     thumbnailModel = std::make_unique<ThumbnailModel>(this);
     thumbnailDelegate = std::make_unique<ThumbnailDelegate>(this);
+    thumbnailModel->setThumbnailSize(currentThumbnailSize);
+    thumbnailDelegate->setThumbnailSize(currentThumbnailSize);
 
     initSettings();
     initWindow();
@@ -53,32 +60,44 @@ void SideBar::initWindow() {
 void SideBar::initContent() {
     tabWidget = new QTabWidget(this);
 
-    QWidget* thumbnailsTab = createThumbnailsTab();
-    QWidget* bookmarksTab = createBookmarksTab();
+    // 惰性页签：只挂空占位页，真正的视图在首次激活时构建。
+    // 启动时侧栏隐藏则什么都不建
+    thumbnailsTabHost = new QWidget();
+    QVBoxLayout* thumbLayout = new QVBoxLayout(thumbnailsTabHost);
+    thumbLayout->setContentsMargins(0, 0, 0, 0);
+    thumbLayout->setSpacing(0);
+
+    bookmarksTabHost = new QWidget();
+    new QVBoxLayout(bookmarksTabHost);
 
-    tabWidget->addTab(thumbnailsTab, "缩略图");
-    tabWidget->addTab(bookmarksTab, "书签");
+    tabWidget->addTab(thumbnailsTabHost, "缩略图");
+    tabWidget->addTab(bookmarksTabHost, "书签");
+
+    connect(tabWidget, &QTabWidget::currentChanged, this,
+            &SideBar::ensureTabContent);
 
     QVBoxLayout* mainLayout = new QVBoxLayout(this);
     mainLayout->addWidget(tabWidget);
 }
 
-QWidget* SideBar::createThumbnailsTab() {
-    QWidget* thumbnailsTab = new QWidget();
-    QVBoxLayout* thumbLayout = new QVBoxLayout(thumbnailsTab);
-    thumbLayout->setContentsMargins(0, 0, 0, 0);
-    thumbLayout->setSpacing(0);
+void SideBar::ensureTabContent(int index) {
+    if (index == 0) {
+        ensureThumbnailsTab();
+    } else if (index == 1) {
+        ensureBookmarksTab();
+    }
+}
 
-    // 创建新的缩略图视图
-    thumbnailView = new ThumbnailListView(thumbnailsTab);
+void SideBar::ensureThumbnailsTab() {
+    if (thumbnailView) {
+        return;
+    }
+
+    // 创建缩略图视图并接到既有模型/委托上
+    thumbnailView = new ThumbnailListView(thumbnailsTabHost);
     thumbnailView->setThumbnailModel(thumbnailModel.get());
     thumbnailView->setThumbnailDelegate(thumbnailDelegate.get());
-
-    // 设置默认缩略图尺寸
-    QSize defaultSize(120, 160);
-    thumbnailView->setThumbnailSize(defaultSize);
-    thumbnailModel->setThumbnailSize(defaultSize);
-    thumbnailDelegate->setThumbnailSize(defaultSize);
+    thumbnailView->setThumbnailSize(currentThumbnailSize);
 
     // 连接信号
     connect(thumbnailView, &ThumbnailListView::pageClicked, this,
@@ -86,20 +105,31 @@ QWidget* SideBar::createThumbnailsTab() {
     connect(thumbnailView, &ThumbnailListView::pageDoubleClicked, this,
             &SideBar::pageDoubleClicked);
 
-    thumbLayout->addWidget(thumbnailView);
-
-    return thumbnailsTab;
+    thumbnailsTabHost->layout()->addWidget(thumbnailView);
 }
 
-QWidget* SideBar::createBookmarksTab() {
-    QWidget* bookmarksTab = new QWidget();
-    QVBoxLayout* bookmarkLayout = new QVBoxLayout(bookmarksTab);
+void SideBar::ensureBookmarksTab() {
+    if (outlineWidget) {
+        return;
+    }
 
-    // 创建PDF目录组件
+    // 创建PDF目录组件；构建前暂存的模型此时补上
     outlineWidget = new PDFOutlineWidget();
-    bookmarkLayout->addWidget(outlineWidget);
+    if (pendingOutlineModel) {
+        outlineWidget->setOutlineModel(pendingOutlineModel);
+    }
+    connect(outlineWidget, &PDFOutlineWidget::pageNavigationRequested, this,
+            &SideBar::outlineNavigationRequested);
 
-    return bookmarksTab;
+    bookmarksTabHost->layout()->addWidget(outlineWidget);
+}
+
+void SideBar::showEvent(QShowEvent* event) {
+    QWidget::showEvent(event);
+    // 首次真正显示时补齐当前页签的内容
+    if (tabWidget) {
+        ensureTabContent(tabWidget->currentIndex());
+    }
 }
 
 void SideBar::initAnimation() {
@@ -217,6 +247,8 @@ void SideBar::onAnimationFinished() {
 }
 
 void SideBar::setOutlineModel(PDFOutlineModel* model) {
+    // 组件可能尚未构建；记下模型，构建时再挂接
+    pendingOutlineModel = model;
     if (outlineWidget) {
         outlineWidget->setOutlineModel(model);
     }
@@ -229,6 +261,7 @@ void SideBar::setDocument(std::shared_ptr<Poppler::Document> document) {
 }
 
 void SideBar::setThumbnailSize(const QSize& size) {
+    currentThumbnailSize = size;
     if (thumbnailView) {
         thumbnailView->setThumbnailSize(size);
     }
@@ -63,6 +63,9 @@ signals:
     void pageClicked(int pageNumber);
     void pageDoubleClicked(int pageNumber);
     void thumbnailSizeChanged(const QSize& size);
+    // 目录点击跳转经SideBar转发：目录组件是惰性构建的，外部
+    // 连这个信号而不是直接连组件
+    void outlineNavigationRequested(int pageNumber);
 
 private:
     QTabWidget* tabWidget;
@@ -75,6 +78,13 @@ private:
     std::unique_ptr<ThumbnailModel> thumbnailModel;
     std::unique_ptr<ThumbnailDelegate> thumbnailDelegate;
 
+    // 惰性页签：页签先挂空占位页，首次激活或外部需要时才构建
+    // 真正的内容组件，把整批控件构造从启动路径上挪走
+    QWidget* thumbnailsTabHost;
+    QWidget* bookmarksTabHost;
+    PDFOutlineModel* pendingOutlineModel;  // 组件构建前暂存的目录模型
+    QSize currentThumbnailSize;
+
     bool isCurrentlyVisible;
     int preferredWidth;
     int lastWidth;
@@ -89,6 +99,10 @@ private:
     void initAnimation();
     void initSettings();
 
-    QWidget* createThumbnailsTab();
-    QWidget* createBookmarksTab();
+    void ensureTabContent(int index);
+    void ensureThumbnailsTab();
+    void ensureBookmarksTab();
+
+protected:
+    void showEvent(QShowEvent* event) override;
 };
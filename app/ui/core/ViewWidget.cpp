@@ -1,13 +1,17 @@
 #include "ViewWidget.h"
+#include <QBuffer>
 #include <QDebug>
 #include <QLabel>
+#include <QTimer>
 #include "../viewer/PDFViewer.h"
 
 ViewWidget::ViewWidget(QWidget* parent)
     : QWidget(parent),
       documentController(nullptr),
       documentModel(nullptr),
-      outlineModel(nullptr) {
+      outlineModel(nullptr),
+      snapshotOverlay(nullptr),
+      snapshotGeneration(0) {
     setupUI();
 }
 
@@ -33,6 +37,12 @@ void ViewWidget::setupUI() {
 
     viewerStack->addWidget(emptyWidget);
 
+    // 快照遮罩：悬浮在查看器堆叠区上方（不加入堆叠页），切换标签页时
+    // 先显示目标标签页的最后一帧，再让活动查看器在其后恢复
+    snapshotOverlay = new QLabel(viewerStack);
+    snapshotOverlay->setScaledContents(true);
+    snapshotOverlay->hide();
+
     mainLayout->addWidget(tabWidget);
     mainLayout->addWidget(viewerStack, 1);
 
@@ -82,6 +92,12 @@ void ViewWidget::setDocumentModel(DocumentModel* model) {
                 &ViewWidget::onDocumentLoadingProgress);
         connect(documentModel, &DocumentModel::loadingFailed, this,
                 &ViewWidget::onDocumentLoadingFailed);
+        connect(documentModel, &DocumentModel::documentHibernated, this,
+                &ViewWidget::onDocumentHibernated);
+        connect(documentModel, &DocumentModel::documentWoken, this,
+                &ViewWidget::onDocumentWoken);
+        connect(documentModel, &DocumentModel::restoreTabPending, this,
+                &ViewWidget::onRestoreTabPending);
     }
 }
 
@@ -214,6 +230,35 @@ int ViewWidget::getCurrentPageCount() const {
     return 0;
 }
 
+QList<QPair<QString, int>> ViewWidget::sessionSnapshot() const {
+    QList<QPair<QString, int>> tabs;
+    for (int i = 0; i < tabWidget->count(); ++i) {
+        const QString filePath = tabWidget->getTabFilePath(i);
+        if (filePath.isEmpty()) {
+            continue;
+        }
+        // 未水合的占位标签页记为-1，保存时沿用会话里保存的页码
+        int page = -1;
+        int modelIndex =
+            documentModel ? documentModel->findDocumentIndex(filePath) : -1;
+        if (modelIndex >= 0 && modelIndex < pdfViewers.size() &&
+            pdfViewers[modelIndex]) {
+            page = pdfViewers[modelIndex]->getCurrentPage();
+        }
+        tabs.append(qMakePair(filePath, page));
+    }
+    return tabs;
+}
+
+int ViewWidget::currentTabIndex() const { return tabWidget->currentIndex(); }
+
+void ViewWidget::goToPageInDocument(int modelIndex, int pageNumber) {
+    if (modelIndex >= 0 && modelIndex < pdfViewers.size() &&
+        pdfViewers[modelIndex]) {
+        pdfViewers[modelIndex]->goToPage(pageNumber);
+    }
+}
+
 double ViewWidget::getCurrentZoom() const {
     int currentIndex = getCurrentDocumentIndex();
     if (currentIndex >= 0 && currentIndex < pdfViewers.size()) {
@@ -234,9 +279,10 @@ void ViewWidget::onDocumentOpened(int index, const QString& fileName) {
     PDFViewer* viewer = createPDFViewer();
     viewer->setDocument(document);
 
-    // 创建目录模型并解析目录
+    // 创建目录模型。目录在后台线程解析，完成后通过outlineParsed
+    // 信号刷新侧边栏，不再占用首页渲染的关键路径
     PDFOutlineModel* docOutlineModel = new PDFOutlineModel(this);
-    docOutlineModel->parseOutline(document);
+    docOutlineModel->parseOutlineAsync(document);
 
     // 检查是否已经有加载中的占位组件需要替换
     bool hasLoadingWidget = false;
@@ -288,8 +334,20 @@ void ViewWidget::onDocumentClosed(int index) {
         model->deleteLater();
     }
 
-    // 移除标签页
-    tabWidget->removeDocumentTab(index);
+    // 移除标签页：路径已从模型删除，按"既不在模型也不挂起"找到
+    // 对应标签，占位标签页在场时索引可能错位
+    int tabIndex = index;
+    if (documentModel) {
+        for (int i = 0; i < tabWidget->count(); ++i) {
+            const QString path = tabWidget->getTabFilePath(i);
+            if (documentModel->findDocumentIndex(path) < 0 &&
+                !documentModel->isPendingRestore(path)) {
+                tabIndex = i;
+                break;
+            }
+        }
+    }
+    tabWidget->removeDocumentTab(tabIndex);
 
     // 如果没有文档了，显示空状态
     if (pdfViewers.isEmpty()) {
@@ -302,7 +360,16 @@ void ViewWidget::onDocumentClosed(int index) {
 }
 
 void ViewWidget::onCurrentDocumentChanged(int index) {
-    tabWidget->setCurrentTab(index);
+    // 按路径同步标签页：会话占位标签页存在时，标签索引与模型索引
+    // 不再一一对应
+    int tabIndex = index;
+    if (documentModel) {
+        int mapped = tabIndexForPath(documentModel->getDocumentFilePath(index));
+        if (mapped >= 0) {
+            tabIndex = mapped;
+        }
+    }
+    tabWidget->setCurrentTab(tabIndex);
     updateCurrentViewer();
 
     // 更新目录模型
@@ -314,6 +381,36 @@ void ViewWidget::onCurrentDocumentChanged(int index) {
     qDebug() << "Current document changed to index" << index;
 }
 
+void ViewWidget::onDocumentHibernated(int index) {
+    if (!documentModel || index < 0 || index >= pdfViewers.size() ||
+        !pdfViewers[index]) {
+        return;
+    }
+    // 趁句柄还有效时解绑查看器，并记下页码/缩放供唤醒时恢复；
+    // 文字索引、缩略图等派生缓存留在各自组件里，不随句柄释放
+    PDFViewer* viewer = pdfViewers[index];
+    hibernatedViewState[documentModel->getDocumentFilePath(index)] =
+        qMakePair(viewer->getCurrentPage(), viewer->getCurrentZoom());
+    viewer->clearDocument();
+}
+
+void ViewWidget::onDocumentWoken(int index) {
+    if (!documentModel || index < 0 || index >= pdfViewers.size() ||
+        !pdfViewers[index]) {
+        return;
+    }
+    PDFViewer* viewer = pdfViewers[index];
+    viewer->setDocument(documentModel->getDocument(index));
+
+    const QString filePath = documentModel->getDocumentFilePath(index);
+    auto it = hibernatedViewState.find(filePath);
+    if (it != hibernatedViewState.end()) {
+        viewer->goToPage(it->first);
+        viewer->setZoom(it->second);
+        hibernatedViewState.erase(it);
+    }
+}
+
 void ViewWidget::onAllDocumentsClosed() {
     // 清理所有PDF查看器
     for (PDFViewer* viewer : pdfViewers) {
@@ -321,6 +418,8 @@ void ViewWidget::onAllDocumentsClosed() {
         viewer->deleteLater();
     }
     pdfViewers.clear();
+    tabSnapshots.clear();
+    hibernatedViewState.clear();
 
     showEmptyState();
     qDebug() << "All documents closed";
@@ -335,7 +434,9 @@ void ViewWidget::onDocumentLoadingStarted(const QString& filePath) {
     bool tabExists = false;
     for (int i = 0; i < tabWidget->count(); i++) {
         if (tabWidget->getTabFilePath(i) == filePath) {
-            // 更新现有标签页为加载状态
+            // 更新现有标签页为加载状态（挂起的会话标签页水合时在
+            // 这里清除"未加载"标记）
+            tabWidget->setTabPendingState(i, false);
             tabWidget->setTabLoadingState(i, true);
             tabExists = true;
             break;
@@ -361,6 +462,23 @@ void ViewWidget::onDocumentLoadingStarted(const QString& filePath) {
     qDebug() << "Document loading started:" << fileName;
 }
 
+void ViewWidget::onRestoreTabPending(const QString& filePath,
+                                     const QString& fileName) {
+    // 会话恢复的占位标签页：有标题、有保存的页位，但不加载文档，
+    // 首次激活或空闲水合时才经过加载流程
+    if (tabIndexForPath(filePath) >= 0) {
+        return;
+    }
+    int tabIndex = tabWidget->addDocumentTab(fileName, filePath);
+    tabWidget->setTabPendingState(tabIndex, true);
+
+    QWidget* placeholder = createPendingWidget(fileName);
+    viewerStack->insertWidget(tabIndex + 1, placeholder);
+
+    hideEmptyState();
+    qDebug() << "Session tab restored (pending):" << fileName;
+}
+
 void ViewWidget::onDocumentLoadingProgress(int progress) {
     // 更新当前加载文档的进度
     // 这里可以更新加载界面的进度条
@@ -378,9 +496,52 @@ void ViewWidget::onDocumentLoadingFailed(const QString& error,
     // 这里暂时只输出调试信息
 }
 
-void ViewWidget::onTabCloseRequested(int index) { closeDocument(index); }
+void ViewWidget::onTabCloseRequested(int index) {
+    const QString filePath = tabWidget->getTabFilePath(index);
+    tabSnapshots.remove(filePath);
+    if (documentModel && !filePath.isEmpty()) {
+        int modelIndex = documentModel->findDocumentIndex(filePath);
+        if (modelIndex < 0) {
+            // 未水合的占位标签页：不涉及模型，直接移除标签和占位组件
+            documentModel->dropPendingRestore(filePath);
+            QWidget* placeholder = viewerStack->widget(index + 1);
+            if (placeholder && placeholder != emptyWidget) {
+                viewerStack->removeWidget(placeholder);
+                placeholder->deleteLater();
+            }
+            tabWidget->removeDocumentTab(index);
+            if (pdfViewers.isEmpty() && tabWidget->count() == 0) {
+                showEmptyState();
+            }
+            return;
+        }
+        closeDocument(modelIndex);
+        return;
+    }
+    closeDocument(index);
+}
 
-void ViewWidget::onTabSwitched(int index) { switchToDocument(index); }
+void ViewWidget::onTabSwitched(int index) {
+    // 切走前抓取当前查看器的最后一帧；此时堆叠区仍显示旧查看器
+    captureTabSnapshot();
+
+    const QString filePath = tabWidget->getTabFilePath(index);
+    if (documentModel && !filePath.isEmpty()) {
+        int modelIndex = documentModel->findDocumentIndex(filePath);
+        if (modelIndex >= 0) {
+            // 先把上次的帧盖上去，活动查看器在遮罩后面恢复状态
+            showTabSnapshot(filePath);
+            switchToDocument(modelIndex);
+            return;
+        }
+        // 挂起的会话标签页：首次激活时才真正加载文档
+        if (documentModel->isPendingRestore(filePath) && documentController) {
+            documentController->openDocument(filePath);
+            return;
+        }
+    }
+    switchToDocument(index);
+}
 
 void ViewWidget::onTabMoved(int from, int to) {
     // 标签页移动时，需要同步移动PDF查看器
@@ -410,6 +571,41 @@ PDFViewer* ViewWidget::createPDFViewer() {
     connect(viewer, &PDFViewer::zoomChanged, this,
             &ViewWidget::onPDFZoomChanged);
 
+    // 跨文档搜索：搜索控件按需取全部打开文档的列表，并复用各标签页
+    // 已在后台建好的文字索引，避免同一文档重复提取文本
+    if (SearchWidget* search = viewer->getSearchWidget()) {
+        search->setOpenDocumentsProvider([this]() {
+            QList<SearchModel::OpenDocument> docs;
+            if (!documentModel) {
+                return docs;
+            }
+            for (int i = 0; i < documentModel->getDocumentCount(); ++i) {
+                SearchModel::OpenDocument open;
+                open.document = documentModel->getDocument(i);
+                open.label = documentModel->getDocumentFileName(i);
+                open.id = i;
+                if (i < pdfViewers.size() && pdfViewers[i]) {
+                    if (SearchWidget* tabSearch =
+                            pdfViewers[i]->getSearchWidget()) {
+                        open.textIndex =
+                            tabSearch->getSearchModel()->textIndex();
+                    }
+                }
+                docs.append(open);
+            }
+            return docs;
+        });
+        // 命中其他文档时先切换标签页，再跳到该文档内的页码
+        connect(search, &SearchWidget::navigateToDocumentResult, this,
+                [this](int documentId, int pageNumber, const QRectF&) {
+                    if (documentId < 0) {
+                        return;
+                    }
+                    switchToDocument(documentId);
+                    goToPageInDocument(documentId, pageNumber);
+                });
+    }
+
     return viewer;
 }
 
@@ -444,6 +640,103 @@ QWidget* ViewWidget::createLoadingWidget(const QString& fileName) {
     return loadingWidget;
 }
 
+QWidget* ViewWidget::createPendingWidget(const QString& fileName) {
+    QWidget* pendingWidget = new QWidget(this);
+    QVBoxLayout* layout = new QVBoxLayout(pendingWidget);
+    layout->setAlignment(Qt::AlignCenter);
+
+    QLabel* iconLabel = new QLabel(pendingWidget);
+    iconLabel->setText("📄");
+    iconLabel->setAlignment(Qt::AlignCenter);
+    iconLabel->setStyleSheet("font-size: 48px; color: #666;");
+
+    QLabel* textLabel = new QLabel(
+        QString("%1 来自上次会话\n点击标签页即可加载").arg(fileName),
+        pendingWidget);
+    textLabel->setAlignment(Qt::AlignCenter);
+    textLabel->setStyleSheet("font-size: 16px; color: #666; margin-top: 10px;");
+
+    layout->addWidget(iconLabel);
+    layout->addWidget(textLabel);
+
+    return pendingWidget;
+}
+
+void ViewWidget::captureTabSnapshot() {
+    if (!documentModel) {
+        return;
+    }
+    int currentIndex = documentModel->getCurrentDocumentIndex();
+    if (currentIndex < 0 || currentIndex >= pdfViewers.size()) {
+        return;
+    }
+    PDFViewer* viewer = pdfViewers[currentIndex];
+    if (!viewer || viewerStack->currentWidget() != viewer) {
+        return;
+    }
+    const QString filePath = documentModel->getDocumentFilePath(currentIndex);
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    QPixmap frame = viewer->grab();
+    if (frame.isNull()) {
+        return;
+    }
+
+    // PNG压缩后保存：十几份快照只占几MB，远小于保留原始像素
+    QByteArray compressed;
+    QBuffer buffer(&compressed);
+    buffer.open(QIODevice::WriteOnly);
+    frame.save(&buffer, "PNG");
+    tabSnapshots.insert(filePath, compressed);
+
+    // 快照只是切换时的视觉优化，超出上限时丢弃一份无碍
+    if (tabSnapshots.size() > MAX_TAB_SNAPSHOTS) {
+        auto it = tabSnapshots.begin();
+        if (it.key() == filePath) {
+            ++it;
+        }
+        tabSnapshots.erase(it);
+    }
+}
+
+void ViewWidget::showTabSnapshot(const QString& filePath) {
+    const QByteArray compressed = tabSnapshots.value(filePath);
+    if (compressed.isEmpty()) {
+        return;
+    }
+    QPixmap frame;
+    if (!frame.loadFromData(compressed, "PNG")) {
+        return;
+    }
+
+    snapshotOverlay->setPixmap(frame);
+    snapshotOverlay->setGeometry(viewerStack->rect());
+    snapshotOverlay->show();
+    snapshotOverlay->raise();
+
+    // 短暂遮挡后交还给活动查看器；期间再次切换则由新一轮定时器接管
+    quint64 generation = ++snapshotGeneration;
+    QTimer::singleShot(SNAPSHOT_HOLD_MS, this, [this, generation]() {
+        if (generation == snapshotGeneration) {
+            snapshotOverlay->hide();
+        }
+    });
+}
+
+int ViewWidget::tabIndexForPath(const QString& filePath) const {
+    if (filePath.isEmpty()) {
+        return -1;
+    }
+    for (int i = 0; i < tabWidget->count(); ++i) {
+        if (tabWidget->getTabFilePath(i) == filePath) {
+            return i;
+        }
+    }
+    return -1;
+}
+
 void ViewWidget::removePDFViewer(int index) {
     if (index < 0 || index >= pdfViewers.size())
         return;
@@ -467,6 +760,7 @@ void ViewWidget::updateCurrentViewer() {
 }
 
 void ViewWidget::showEmptyState() {
+    snapshotOverlay->hide();
     viewerStack->setCurrentWidget(emptyWidget);
     tabWidget->hide();
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QHash>
 #include <QStackedWidget>
 #include <QVBoxLayout>
 #include <QWidget>
@@ -9,6 +10,8 @@
 #include "../viewer/PDFViewer.h"
 #include "../widgets/DocumentTabWidget.h"
 
+class QLabel;
+
 class ViewWidget : public QWidget {
     Q_OBJECT
 
@@ -44,11 +47,17 @@ public:
     int getCurrentPageCount() const;
     double getCurrentZoom() const;
 
+    // 会话支持：按标签页顺序返回(路径, 当前页)，未水合的标签页页码为-1
+    QList<QPair<QString, int>> sessionSnapshot() const;
+    int currentTabIndex() const;
+    void goToPageInDocument(int modelIndex, int pageNumber);
+
 protected:
     void setupUI();
     void setupConnections();
     void updateCurrentViewer();
     QWidget* createLoadingWidget(const QString& fileName);
+    QWidget* createPendingWidget(const QString& fileName);
 
 private slots:
     // 文档模型信号处理
@@ -59,6 +68,11 @@ private slots:
     void onDocumentLoadingStarted(const QString& filePath);
     void onDocumentLoadingProgress(int progress);
     void onDocumentLoadingFailed(const QString& error, const QString& filePath);
+    void onRestoreTabPending(const QString& filePath, const QString& fileName);
+
+    // 句柄休眠：休眠时解绑旧句柄并记下页码/缩放，唤醒时重绑恢复
+    void onDocumentHibernated(int index);
+    void onDocumentWoken(int index);
 
     // 标签页信号处理
     void onTabCloseRequested(int index);
@@ -87,9 +101,26 @@ private:
     QList<PDFViewer*> pdfViewers;           // 每个文档对应一个PDFViewer
     QList<PDFOutlineModel*> outlineModels;  // 每个文档对应一个目录模型
 
+    // 标签页视图快照：切走时抓取当前查看器的最后一帧（PNG压缩存储），
+    // 切回时立即盖在查看器上方显示，活动查看器在其后恢复，消除切换
+    // 瞬间的空白闪烁
+    QHash<QString, QByteArray> tabSnapshots;  // 路径 → 压缩后的最后一帧
+
+    // 休眠标签页的视图状态：路径 → (页码, 缩放)，唤醒重绑时恢复
+    QHash<QString, QPair<int, double>> hibernatedViewState;
+    QLabel* snapshotOverlay;
+    quint64 snapshotGeneration;  // 区分快速连续切换时的多个遮罩定时器
+
+    void captureTabSnapshot();
+    void showTabSnapshot(const QString& filePath);
+
+    static constexpr int SNAPSHOT_HOLD_MS = 250;  // 快照最多遮挡的时长
+    static constexpr int MAX_TAB_SNAPSHOTS = 12;  // 保留的快照份数上限
+
     // 辅助方法
     PDFViewer* createPDFViewer();
     void removePDFViewer(int index);
+    int tabIndexForPath(const QString& filePath) const;
     void showEmptyState();
     void hideEmptyState();
 };
@@ -1,5 +1,9 @@
 #include "DocumentComparison.h"
 #include <QApplication>
+#include "../../cache/PDFCacheManager.h"
+#include "../../managers/RenderBroker.h"
+#include "../../managers/RenderScheduler.h"
+#include "../../utils/ImageDiffKernel.h"
 #include <QFileDialog>
 #include <QFormLayout>
 #include <QGridLayout>
@@ -10,6 +14,8 @@
 #include <QJsonObject>
 #include <QMessageBox>
 #include <QPainter>
+#include <QPointer>
+#include <QScrollBar>
 #include <QSplitter>
 #include <QTextStream>
 // // #include <QtConcurrent> // Not available in this MSYS2 setup // Not
@@ -22,8 +28,18 @@ DocumentComparison::DocumentComparison(QWidget* parent)
       m_document2(nullptr),
       m_currentDifferenceIndex(-1),
       m_isComparing(false),
-      m_comparisonWatcher(nullptr),
-      m_progressTimer(nullptr) {
+      m_comparisonGeneration(0),
+      m_nextPageToDispatch(0),
+      m_pagesInFlight(0),
+      m_pagesCompleted(0),
+      m_nextPageToAppend(0),
+      m_progressTimer(nullptr),
+      m_paneGeneration(0),
+      m_panePage1(-1),
+      m_panePage2(-1),
+      m_paneReady1(false),
+      m_paneReady2(false),
+      m_syncingPaneScroll(false) {
     setupUI();
     setupConnections();
 }
@@ -148,9 +164,6 @@ void DocumentComparison::setupUI() {
     // Initialize progress timer
     m_progressTimer = new QTimer(this);
     m_progressTimer->setInterval(100);
-
-    // Initialize comparison watcher
-    m_comparisonWatcher = new QFutureWatcher<ComparisonResults>(this);
 }
 
 void DocumentComparison::setupConnections() {
@@ -176,9 +189,6 @@ void DocumentComparison::setupConnections() {
     connect(m_differencesTree, &QTreeWidget::itemClicked, this,
             &DocumentComparison::onDifferenceClicked);
 
-    connect(m_comparisonWatcher, &QFutureWatcher<ComparisonResults>::finished,
-            this, &DocumentComparison::onComparisonFinished);
-
     connect(m_progressTimer, &QTimer::timeout, this,
             &DocumentComparison::updateProgress);
 
@@ -200,6 +210,31 @@ void DocumentComparison::setupConnections() {
     connect(m_maxDifferencesSpinBox,
             QOverload<int>::of(&QSpinBox::valueChanged), this,
             &DocumentComparison::onOptionsChanged);
+
+    linkPaneScrollBars();
+}
+
+void DocumentComparison::linkPaneScrollBars() {
+    // Shared scroll controller: whichever pane the user scrolls drives
+    // the other, and the guard stops the echo from looping back. Both
+    // panes render at the same fixed 150 dpi, so bar values map 1:1.
+    // Scrolling only moves the viewport over already-set pixmaps; it
+    // never triggers a re-render
+    auto mirror = [this](QScrollBar* from, QScrollBar* to) {
+        connect(from, &QScrollBar::valueChanged, this, [this, to](int value) {
+            if (m_syncingPaneScroll)
+                return;
+            m_syncingPaneScroll = true;
+            to->setValue(value);
+            m_syncingPaneScroll = false;
+        });
+    };
+    mirror(m_leftView->verticalScrollBar(), m_rightView->verticalScrollBar());
+    mirror(m_rightView->verticalScrollBar(), m_leftView->verticalScrollBar());
+    mirror(m_leftView->horizontalScrollBar(),
+           m_rightView->horizontalScrollBar());
+    mirror(m_rightView->horizontalScrollBar(),
+           m_leftView->horizontalScrollBar());
 }
 
 void DocumentComparison::setDocuments(Poppler::Document* doc1,
@@ -246,19 +281,46 @@ void DocumentComparison::startComparison() {
 
     m_progressTimer->start();
 
-    // Start comparison in background thread (simplified without QtConcurrent)
-    // For now, run synchronously - could be improved with QThread later
-    ComparisonResults results = compareDocuments();
-    m_results = results;
-    QTimer::singleShot(0, this, &DocumentComparison::onComparisonFinished);
+    // Stream the comparison through the shared render pool: a sliding
+    // window of per-page jobs keeps only a handful of extracted pages in
+    // memory at once, and differences flow into the tree as they arrive
+    // instead of after the whole document has been diffed
+    m_options = getComparisonOptions();
+    m_results = ComparisonResults();
+    m_results.totalPages1 = m_document1->numPages();
+    m_results.totalPages2 = m_document2->numPages();
+    m_results.pagesCompared =
+        qMin(m_results.totalPages1, m_results.totalPages2);
+
+    m_differencesTree->clear();
+    m_differenceDetails->clear();
+    m_currentDifferenceIndex = -1;
+
+    ++m_comparisonGeneration;
+    m_nextPageToDispatch = 0;
+    m_pagesInFlight = 0;
+    m_pagesCompleted = 0;
+    m_nextPageToAppend = 0;
+    m_pendingPageDiffs.clear();
+    m_comparisonTimer.start();
 
     emit comparisonStarted();
+
+    if (m_results.pagesCompared == 0) {
+        finishComparison();
+        return;
+    }
+
+    dispatchComparisonJobs();
 }
 
 void DocumentComparison::stopComparison() {
-    if (m_comparisonWatcher && m_comparisonWatcher->isRunning()) {
-        m_comparisonWatcher->cancel();
-    }
+    // Bumping the generation orphans in-flight jobs; their results are
+    // dropped in onPageCompared when they eventually land
+    ++m_comparisonGeneration;
+    m_pagesInFlight = 0;
+    m_nextPageToDispatch = m_results.pagesCompared;
+    m_pendingPageDiffs.clear();
 
     m_isComparing = false;
     m_compareButton->setEnabled(true);
@@ -296,59 +358,112 @@ void DocumentComparison::setComparisonOptions(
     m_options = options;
 }
 
-ComparisonResults DocumentComparison::compareDocuments() {
-    ComparisonResults results;
-
-    if (!m_document1 || !m_document2) {
-        return results;
+void DocumentComparison::dispatchComparisonJobs() {
+    // Window of roughly twice the pool width: enough to keep the workers
+    // busy while bounding how many pages are extracted at the same time
+    const int window =
+        qMax(2, RenderScheduler::instance().maxThreadCount() * 2);
+
+    while (m_pagesInFlight < window &&
+           m_nextPageToDispatch < m_results.pagesCompared) {
+        const int page = m_nextPageToDispatch++;
+        const quint64 generation = m_comparisonGeneration;
+        ++m_pagesInFlight;
+
+        QPointer<DocumentComparison> self(this);
+        RenderScheduler::instance().submit(
+            RenderScheduler::TaskClass::Background,
+            [self, page, generation]() {
+                if (!self) {
+                    return;
+                }
+                QList<DocumentDifference> diffs =
+                    self->comparePages(page, page);
+                QMetaObject::invokeMethod(
+                    self,
+                    [self, page, generation, diffs]() {
+                        if (self) {
+                            self->onPageCompared(generation, page, diffs);
+                        }
+                    },
+                    Qt::QueuedConnection);
+            });
     }
+}
 
-    results.totalPages1 = m_document1->numPages();
-    results.totalPages2 = m_document2->numPages();
-    results.pagesCompared = qMin(results.totalPages1, results.totalPages2);
+void DocumentComparison::onPageCompared(
+    quint64 generation, int pageIndex,
+    const QList<DocumentDifference>& differences) {
+    if (generation != m_comparisonGeneration) {
+        return;  // Superseded by a newer comparison or a stop
+    }
 
-    QElapsedTimer timer;
-    timer.start();
+    --m_pagesInFlight;
+    ++m_pagesCompleted;
 
-    m_options = getComparisonOptions();
+    // Workers finish out of order; buffer results and append them to the
+    // tree in page order so the list reads top to bottom
+    m_pendingPageDiffs.insert(pageIndex, differences);
+    while (m_pendingPageDiffs.contains(m_nextPageToAppend)) {
+        const QList<DocumentDifference> pageDiffs =
+            m_pendingPageDiffs.take(m_nextPageToAppend);
+        ++m_nextPageToAppend;
 
-    // Compare pages
-    for (int i = 0; i < results.pagesCompared; ++i) {
-        if (m_comparisonWatcher && m_comparisonWatcher->isCanceled()) {
-            break;
+        for (const DocumentDifference& diff : pageDiffs) {
+            m_results.differences.append(diff);
+            appendDifferenceItem(m_results.differences.size() - 1);
         }
+    }
 
-        QList<DocumentDifference> pageDiffs = comparePages(i, i);
-        results.differences.append(pageDiffs);
+    int percentage = m_pagesCompleted * 100 / m_results.pagesCompared;
+    m_progressBar->setValue(percentage);
+    emit comparisonProgress(percentage, QString("Comparing page %1 of %2")
+                                            .arg(m_pagesCompleted)
+                                            .arg(m_results.pagesCompared));
 
-        // Update progress
-        emit comparisonProgress((i + 1) * 100 / results.pagesCompared,
-                                QString("Comparing page %1 of %2")
-                                    .arg(i + 1)
-                                    .arg(results.pagesCompared));
+    if (m_pagesCompleted == m_results.pagesCompared) {
+        finishComparison();
+    } else {
+        dispatchComparisonJobs();
     }
+}
 
-    results.comparisonTime = timer.elapsed();
+void DocumentComparison::finishComparison() {
+    m_results.comparisonTime = m_comparisonTimer.elapsed();
 
     // Calculate statistics
-    for (const auto& diff : results.differences) {
-        results.differenceCountByType[diff.type]++;
+    for (const auto& diff : m_results.differences) {
+        m_results.differenceCountByType[diff.type]++;
     }
 
     // Calculate overall similarity (simplified)
-    int totalDifferences = results.differences.size();
-    results.overallSimilarity =
+    int totalDifferences = m_results.differences.size();
+    m_results.overallSimilarity =
         totalDifferences > 0
-            ? qMax(0.0,
-                   1.0 - (totalDifferences / (results.pagesCompared * 10.0)))
+            ? qMax(0.0, 1.0 - (totalDifferences /
+                               (m_results.pagesCompared * 10.0)))
             : 1.0;
 
-    results.summary = QString("Found %1 differences across %2 pages in %3ms")
-                          .arg(totalDifferences)
-                          .arg(results.pagesCompared)
-                          .arg(results.comparisonTime);
+    m_results.summary = QString("Found %1 differences across %2 pages in %3ms")
+                            .arg(totalDifferences)
+                            .arg(m_results.pagesCompared)
+                            .arg(m_results.comparisonTime);
 
-    return results;
+    m_isComparing = false;
+    m_compareButton->setEnabled(true);
+    m_stopButton->setEnabled(false);
+    m_exportButton->setEnabled(true);
+    m_progressBar->setVisible(false);
+    m_progressTimer->stop();
+
+    m_differencesTree->resizeColumnToContents(0);
+    m_differencesTree->resizeColumnToContents(1);
+    m_differencesTree->resizeColumnToContents(3);
+
+    m_statusLabel->setText(
+        QString("Found %1 differences").arg(m_results.differences.size()));
+
+    emit comparisonFinished(m_results);
 }
 
 QList<DocumentDifference> DocumentComparison::comparePages(int page1,
@@ -377,10 +492,10 @@ QList<DocumentDifference> DocumentComparison::comparePages(int page1,
 
         // Compare images if enabled
         if (m_options.compareImages) {
-            QImage image1 = popplerPage1->renderToImage(150, 150);
-            QImage image2 = popplerPage2->renderToImage(150, 150);
-            QPixmap pixmap1 = QPixmap::fromImage(image1);
-            QPixmap pixmap2 = QPixmap::fromImage(image2);
+            QPixmap pixmap1 = renderComparisonPixmap(
+                m_document1, popplerPage1.get(), page1);
+            QPixmap pixmap2 = renderComparisonPixmap(
+                m_document2, popplerPage2.get(), page2);
             differences.append(compareImages(pixmap1, pixmap2, page1, page2));
         }
 
@@ -486,55 +601,10 @@ double DocumentComparison::calculateImageSimilarity(const QPixmap& image1,
         return 0.5;  // Different sizes, moderate similarity
     }
 
-    // Convert to images for pixel comparison
-    QImage img1 = image1.toImage();
-    QImage img2 = image2.toImage();
-
-    if (img1.format() != img2.format()) {
-        img1 = img1.convertToFormat(QImage::Format_RGB32);
-        img2 = img2.convertToFormat(QImage::Format_RGB32);
-    }
-
-    int width = img1.width();
-    int height = img1.height();
-    int totalPixels = width * height;
-    int differentPixels = 0;
-
-    // Sample pixels for performance (every 4th pixel)
-    for (int y = 0; y < height; y += 4) {
-        for (int x = 0; x < width; x += 4) {
-            if (img1.pixel(x, y) != img2.pixel(x, y)) {
-                differentPixels++;
-            }
-        }
-    }
-
-    int sampledPixels = (width / 4) * (height / 4);
-    return sampledPixels > 0
-               ? 1.0 - (static_cast<double>(differentPixels) / sampledPixels)
-               : 1.0;
-}
-
-void DocumentComparison::onComparisonFinished() {
-    m_isComparing = false;
-    m_compareButton->setEnabled(true);
-    m_stopButton->setEnabled(false);
-    m_exportButton->setEnabled(true);
-    m_progressBar->setVisible(false);
-    m_progressTimer->stop();
-
-    if (m_comparisonWatcher->isCanceled()) {
-        m_statusLabel->setText("Comparison cancelled");
-        return;
-    }
-
-    m_results = m_comparisonWatcher->result();
-    updateDifferencesList();
-
-    m_statusLabel->setText(
-        QString("Found %1 differences").arg(m_results.differences.size()));
-
-    emit comparisonFinished(m_results);
+    // Block-based SAD kernel with runtime SSE2/AVX2 dispatch; replaces
+    // the old per-pixel sampling loop, which dominated the cost of
+    // diffing scanned pages
+    return ImageDiffKernel::similarity(image1.toImage(), image2.toImage());
 }
 
 void DocumentComparison::updateProgress() {
@@ -544,60 +614,52 @@ void DocumentComparison::updateProgress() {
     }
 }
 
-void DocumentComparison::updateDifferencesList() {
-    m_differencesTree->clear();
-
-    for (int i = 0; i < m_results.differences.size(); ++i) {
-        const DocumentDifference& diff = m_results.differences[i];
-
-        QTreeWidgetItem* item = new QTreeWidgetItem(m_differencesTree);
+void DocumentComparison::appendDifferenceItem(int index) {
+    const DocumentDifference& diff = m_results.differences[index];
 
-        QString typeStr;
-        switch (diff.type) {
-            case DifferenceType::TextAdded:
-                typeStr = "Text Added";
-                break;
-            case DifferenceType::TextRemoved:
-                typeStr = "Text Removed";
-                break;
-            case DifferenceType::TextModified:
-                typeStr = "Text Modified";
-                break;
-            case DifferenceType::ImageAdded:
-                typeStr = "Image Added";
-                break;
-            case DifferenceType::ImageRemoved:
-                typeStr = "Image Removed";
-                break;
-            case DifferenceType::ImageModified:
-                typeStr = "Image Modified";
-                break;
-            case DifferenceType::LayoutChanged:
-                typeStr = "Layout Changed";
-                break;
-            case DifferenceType::AnnotationAdded:
-                typeStr = "Annotation Added";
-                break;
-            case DifferenceType::AnnotationRemoved:
-                typeStr = "Annotation Removed";
-                break;
-            case DifferenceType::AnnotationModified:
-                typeStr = "Annotation Modified";
-                break;
-        }
+    QTreeWidgetItem* item = new QTreeWidgetItem(m_differencesTree);
 
-        item->setText(0, typeStr);
-        item->setText(1, QString("%1/%2")
-                             .arg(diff.pageNumber1 + 1)
-                             .arg(diff.pageNumber2 + 1));
-        item->setText(2, diff.description);
-        item->setText(3, QString("%1%").arg(diff.confidence * 100, 0, 'f', 1));
-        item->setData(0, Qt::UserRole, i);  // Store difference index
+    QString typeStr;
+    switch (diff.type) {
+        case DifferenceType::TextAdded:
+            typeStr = "Text Added";
+            break;
+        case DifferenceType::TextRemoved:
+            typeStr = "Text Removed";
+            break;
+        case DifferenceType::TextModified:
+            typeStr = "Text Modified";
+            break;
+        case DifferenceType::ImageAdded:
+            typeStr = "Image Added";
+            break;
+        case DifferenceType::ImageRemoved:
+            typeStr = "Image Removed";
+            break;
+        case DifferenceType::ImageModified:
+            typeStr = "Image Modified";
+            break;
+        case DifferenceType::LayoutChanged:
+            typeStr = "Layout Changed";
+            break;
+        case DifferenceType::AnnotationAdded:
+            typeStr = "Annotation Added";
+            break;
+        case DifferenceType::AnnotationRemoved:
+            typeStr = "Annotation Removed";
+            break;
+        case DifferenceType::AnnotationModified:
+            typeStr = "Annotation Modified";
+            break;
     }
 
-    m_differencesTree->resizeColumnToContents(0);
-    m_differencesTree->resizeColumnToContents(1);
-    m_differencesTree->resizeColumnToContents(3);
+    item->setText(0, typeStr);
+    item->setText(1, QString("%1/%2")
+                         .arg(diff.pageNumber1 + 1)
+                         .arg(diff.pageNumber2 + 1));
+    item->setText(2, diff.description);
+    item->setText(3, QString("%1%").arg(diff.confidence * 100, 0, 'f', 1));
+    item->setData(0, Qt::UserRole, index);  // Store difference index
 }
 
 void DocumentComparison::onDifferenceClicked(QTreeWidgetItem* item,
@@ -644,35 +706,189 @@ void DocumentComparison::goToDifference(int index) {
 }
 
 void DocumentComparison::highlightDifference(const DocumentDifference& diff) {
-    // Update the comparison view to show the pages with the difference
     if (!m_document1 || !m_document2)
         return;
 
-    try {
-        if (diff.pageNumber1 >= 0 &&
-            diff.pageNumber1 < m_document1->numPages()) {
-            std::unique_ptr<Poppler::Page> page1(
-                m_document1->page(diff.pageNumber1));
-            if (page1) {
-                QImage image1 = page1->renderToImage(150, 150);
-                m_leftImageLabel->setPixmap(QPixmap::fromImage(image1));
-            }
+    // Kick off both pane renders together; the labels update once the
+    // pair lands (immediately when both pages are already cached)
+    requestPanePair(diff.pageNumber1, diff.pageNumber2);
+}
+
+void DocumentComparison::requestPanePair(int page1, int page2) {
+    const quint64 generation = ++m_paneGeneration;
+    m_panePage1 = page1;
+    m_panePage2 = page2;
+    m_panePixmap1 = QPixmap();
+    m_panePixmap2 = QPixmap();
+    m_paneReady1 = false;
+    m_paneReady2 = false;
+
+    requestPaneRender(generation, m_document1, page1, true);
+    requestPaneRender(generation, m_document2, page2, false);
+}
+
+void DocumentComparison::requestPaneRender(quint64 generation,
+                                           Poppler::Document* document,
+                                           int pageNumber, bool firstPane) {
+    // One-sided differences leave the missing pane blank, but the pair
+    // must still complete so the present pane can be applied
+    if (!document || pageNumber < 0 || pageNumber >= document->numPages()) {
+        (firstPane ? m_paneReady1 : m_paneReady2) = true;
+        applyPanePair();
+        return;
+    }
+
+    const double scale = 150.0 / 72.0;
+    const QString documentHash =
+        PDFCacheManager::namespaceForDocument(document);
+    if (!documentHash.isEmpty()) {
+        QPixmap cached = PDFCacheManager::shared().getRenderedPage(
+            documentHash, pageNumber, scale);
+        if (!cached.isNull()) {
+            (firstPane ? m_panePixmap1 : m_panePixmap2) = cached;
+            (firstPane ? m_paneReady1 : m_paneReady2) = true;
+            applyPanePair();
+            return;
         }
+    }
 
-        if (diff.pageNumber2 >= 0 &&
-            diff.pageNumber2 < m_document2->numPages()) {
-            std::unique_ptr<Poppler::Page> page2(
-                m_document2->page(diff.pageNumber2));
-            if (page2) {
-                QImage image2 = page2->renderToImage(150, 150);
-                m_rightImageLabel->setPixmap(QPixmap::fromImage(image2));
+    // Miss: render off the GUI thread through the broker. The two panes
+    // of a pair are requested back to back, so they run concurrently on
+    // the worker pool instead of serially here, and the broker folds
+    // this in with any viewer already rendering the same page. The
+    // document pointer stays valid while the widget holds it — the same
+    // contract comparePages relies on
+    RenderBroker::RenderKey key =
+        RenderBroker::makeKey(document, pageNumber, scale, 0);
+    RenderBroker::instance().request(
+        key, RenderScheduler::TaskClass::VisiblePage,
+        [document, pageNumber]() -> QImage {
+            std::unique_ptr<Poppler::Page> page(document->page(pageNumber));
+            return page ? page->renderToImage(150, 150) : QImage();
+        },
+        this,
+        [this, generation, documentHash, pageNumber, firstPane,
+         scale](const QImage& image) {
+            if (image.isNull())
+                return;
+            QPixmap pixmap = QPixmap::fromImage(image);
+            if (!documentHash.isEmpty()) {
+                PDFCacheManager::shared().cacheRenderedPage(
+                    documentHash, pageNumber, pixmap, scale);
             }
+            // A superseded step still warms the cache above, but only
+            // the current generation may touch the labels
+            if (generation != m_paneGeneration)
+                return;
+            (firstPane ? m_panePixmap1 : m_panePixmap2) = pixmap;
+            (firstPane ? m_paneReady1 : m_paneReady2) = true;
+            applyPanePair();
+        });
+}
+
+void DocumentComparison::applyPanePair() {
+    if (!m_paneReady1 || !m_paneReady2)
+        return;
+
+    if (m_panePixmap1.isNull()) {
+        m_leftImageLabel->setText("Document 1");
+    } else {
+        m_leftImageLabel->setPixmap(
+            overlayDifferences(m_panePixmap1, m_panePage1, true));
+        m_leftImageLabel->adjustSize();
+    }
+    if (m_panePixmap2.isNull()) {
+        m_rightImageLabel->setText("Document 2");
+    } else {
+        m_rightImageLabel->setPixmap(
+            overlayDifferences(m_panePixmap2, m_panePage2, false));
+        m_rightImageLabel->adjustSize();
+    }
+}
+
+QPixmap DocumentComparison::overlayDifferences(const QPixmap& pixmap,
+                                               int pageNumber,
+                                               bool firstPane) const {
+    // Paint markers for the precomputed differences touching this page
+    // onto a copy of the cached pixmap; the page render itself is never
+    // redone for highlighting
+    QList<const DocumentDifference*> hits;
+    for (const DocumentDifference& diff : m_results.differences) {
+        int page = firstPane ? diff.pageNumber1 : diff.pageNumber2;
+        if (page == pageNumber)
+            hits.append(&diff);
+    }
+    if (hits.isEmpty() || pixmap.isNull())
+        return pixmap;
+
+    QPixmap canvas = pixmap;
+    QPainter painter(&canvas);
+    const double pixelsPerPoint = 150.0 / 72.0;
+    bool pageLevelMarked = false;
+    for (const DocumentDifference* diff : hits) {
+        QColor color;
+        switch (diff->type) {
+            case DifferenceType::TextAdded:
+            case DifferenceType::ImageAdded:
+            case DifferenceType::AnnotationAdded:
+                color = QColor(46, 160, 67);
+                break;
+            case DifferenceType::TextRemoved:
+            case DifferenceType::ImageRemoved:
+            case DifferenceType::AnnotationRemoved:
+                color = QColor(207, 34, 46);
+                break;
+            default:
+                color = QColor(212, 130, 15);
+                break;
         }
-    } catch (const std::exception& e) {
-        qDebug() << "Error highlighting difference:" << e.what();
-    } catch (...) {
-        qDebug() << "Unknown error highlighting difference";
+
+        const QRectF region = firstPane ? diff->region1 : diff->region2;
+        if (!region.isEmpty()) {
+            // Region is in page points; the pane always renders at the
+            // fixed 150 dpi
+            QRectF r(region.x() * pixelsPerPoint, region.y() * pixelsPerPoint,
+                     region.width() * pixelsPerPoint,
+                     region.height() * pixelsPerPoint);
+            QColor fill = color;
+            fill.setAlpha(60);
+            painter.fillRect(r, fill);
+            painter.setPen(QPen(color, 2));
+            painter.drawRect(r);
+        } else if (!pageLevelMarked) {
+            // The current comparators report page-level differences
+            // without regions; a border flags the page without
+            // obscuring its content
+            painter.setPen(QPen(color, 6));
+            painter.drawRect(canvas.rect().adjusted(3, 3, -3, -3));
+            pageLevelMarked = true;
+        }
+    }
+    return canvas;
+}
+
+QPixmap DocumentComparison::renderComparisonPixmap(Poppler::Document* document,
+                                                   Poppler::Page* page,
+                                                   int pageNumber) {
+    // Comparison panes always render at 150 dpi; express it as a scale
+    // factor so the entries are shared with any viewer of the same file
+    const double scale = 150.0 / 72.0;
+    const QString documentHash =
+        PDFCacheManager::namespaceForDocument(document);
+    if (!documentHash.isEmpty()) {
+        QPixmap cached = PDFCacheManager::shared().getRenderedPage(
+            documentHash, pageNumber, scale);
+        if (!cached.isNull()) {
+            return cached;
+        }
+    }
+
+    QPixmap rendered = QPixmap::fromImage(page->renderToImage(150, 150));
+    if (!documentHash.isEmpty() && !rendered.isNull()) {
+        PDFCacheManager::shared().cacheRenderedPage(documentHash, pageNumber,
+                                                    rendered, scale);
     }
+    return rendered;
 }
 
 void DocumentComparison::clearHighlights() {
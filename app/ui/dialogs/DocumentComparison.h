@@ -3,11 +3,11 @@
 #include <poppler-qt6.h>
 #include <QCheckBox>
 #include <QComboBox>
-#include <QFuture>
-#include <QFutureWatcher>
+#include <QElapsedTimer>
 #include <QGroupBox>
 #include <QHBoxLayout>
 #include <QLabel>
+#include <QPixmap>
 #include <QProgressBar>
 #include <QPushButton>
 #include <QScrollArea>
@@ -173,20 +173,43 @@ public slots:
     void onOptionsChanged();
 
 private slots:
-    void onComparisonFinished();
+    void onPageCompared(quint64 generation, int pageIndex,
+                        const QList<DocumentDifference>& differences);
     void updateProgress();
 
 private:
     void setupUI();
     void setupConnections();
-    void updateDifferencesList();
+    void dispatchComparisonJobs();
+    void finishComparison();
+    void appendDifferenceItem(int index);
     void updateComparisonView();
     void highlightDifference(const DocumentDifference& diff);
     void clearHighlights();
 
-    // Comparison algorithms
-    QFuture<ComparisonResults> performComparison();
-    ComparisonResults compareDocuments();
+    // Pane pair pipeline. Stepping to a difference renders both panes
+    // concurrently on the worker pool through RenderBroker; the labels
+    // are updated only when both results of the current generation have
+    // landed, so the panes never show mismatched pages and rapid
+    // next/previous stepping coalesces to the last requested pair
+    void requestPanePair(int page1, int page2);
+    void requestPaneRender(quint64 generation, Poppler::Document* document,
+                           int pageNumber, bool firstPane);
+    void applyPanePair();
+    QPixmap overlayDifferences(const QPixmap& pixmap, int pageNumber,
+                               bool firstPane) const;
+    void linkPaneScrollBars();
+
+    // 150 dpi pane render served through the shared cross-document
+    // cache, so both panes (and any tab viewing the same file) reuse
+    // one render. Falls back to a direct render for documents unknown
+    // to DocumentSnapshot
+    QPixmap renderComparisonPixmap(Poppler::Document* document,
+                                   Poppler::Page* page, int pageNumber);
+
+    // Comparison algorithms. comparePages runs on RenderScheduler worker
+    // threads; it opens its own Page handles and only reads m_options and
+    // the document pointers, which are stable while a comparison runs
     QList<DocumentDifference> comparePages(int page1, int page2);
     QList<DocumentDifference> compareText(const QString& text1,
                                           const QString& text2, int page1,
@@ -244,9 +267,26 @@ private:
     ComparisonResults m_results;
     int m_currentDifferenceIndex;
 
-    // Comparison state
+    // Comparison state. Pages are diffed in a sliding window of worker
+    // jobs so memory stays bounded by the window, not the document; the
+    // generation counter lets stopComparison() orphan in-flight jobs
     bool m_isComparing;
-    QFuture<ComparisonResults> m_comparisonFuture;
-    QFutureWatcher<ComparisonResults>* m_comparisonWatcher;
+    quint64 m_comparisonGeneration;
+    int m_nextPageToDispatch;
+    int m_pagesInFlight;
+    int m_pagesCompleted;
+    int m_nextPageToAppend;
+    QMap<int, QList<DocumentDifference>> m_pendingPageDiffs;
+    QElapsedTimer m_comparisonTimer;
     QTimer* m_progressTimer;
+
+    // Pane pair state (see requestPanePair)
+    quint64 m_paneGeneration;
+    int m_panePage1;
+    int m_panePage2;
+    QPixmap m_panePixmap1;
+    QPixmap m_panePixmap2;
+    bool m_paneReady1;
+    bool m_paneReady2;
+    bool m_syncingPaneScroll;
 };
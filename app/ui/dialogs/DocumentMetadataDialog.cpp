@@ -3,10 +3,23 @@
 #include <QDateTime>
 #include <QDir>
 #include <QFileInfo>
+#include <QHash>
 #include <QLocale>
 #include <QMessageBox>
+#include <QPointer>
+#include <QSet>
+#include <memory>
 #include <stdexcept>
+#include "../../managers/RenderScheduler.h"
 #include "../../managers/StyleManager.h"
+#include "../../model/DocumentSnapshot.h"
+#include "../../utils/PDFMetadataProbe.h"
+
+namespace {
+// 字体扫描结果缓存（按文件路径）。枚举遍历全文档的页面树，大文件
+// 上要花数秒，每个文件只扫一次即可。仅在GUI线程读写
+QHash<QString, QStringList> g_fontScanCache;
+}  // namespace
 
 DocumentMetadataDialog::DocumentMetadataDialog(QWidget* parent)
     : QDialog(parent), m_currentDocument(nullptr) {
@@ -151,6 +164,20 @@ void DocumentMetadataDialog::setupUI() {
 
     m_contentLayout->addWidget(m_securityGroup);
 
+    // 字体信息组：内容异步填充，先显示扫描状态
+    m_fontsGroup = new QGroupBox(tr("字体"), m_contentWidget);
+    m_fontsLayout = new QVBoxLayout(m_fontsGroup);
+
+    m_fontsStatusLabel = new QLabel(tr("未设置"));
+    m_fontsLayout->addWidget(m_fontsStatusLabel);
+
+    m_fontsList = new QListWidget();
+    m_fontsList->setSelectionMode(QAbstractItemView::NoSelection);
+    m_fontsList->setMaximumHeight(140);
+    m_fontsLayout->addWidget(m_fontsList);
+
+    m_contentLayout->addWidget(m_fontsGroup);
+
     // 添加弹性空间
     m_contentLayout->addStretch();
 
@@ -188,15 +215,24 @@ void DocumentMetadataDialog::setDocument(Poppler::Document* document,
     m_currentDocument = document;
     m_currentFilePath = filePath;
 
-    if (!document || filePath.isEmpty()) {
+    if (filePath.isEmpty()) {
         clearMetadata();
         return;
     }
 
+    // 没有打开的文档句柄时退回轻量探针路径
+    if (!document) {
+        setFile(filePath);
+        return;
+    }
+
     try {
+        // 基本信息只读Info字典和文件系统，立即显示；字体扫描另走
+        // 工作线程，期间对话框保持可交互
         populateBasicInfo(filePath, document);
         populateDocumentProperties(document);
         populateSecurityInfo(document);
+        populateFontsAsync();
     } catch (const std::exception& e) {
         QMessageBox::warning(this, tr("错误"),
                              tr("获取文档元数据时发生错误: %1").arg(e.what()));
@@ -204,6 +240,171 @@ void DocumentMetadataDialog::setDocument(Poppler::Document* document,
     }
 }
 
+void DocumentMetadataDialog::setFile(const QString& filePath) {
+    m_currentDocument = nullptr;
+    m_currentFilePath = filePath;
+
+    const PDFMetadata metadata = PDFMetadataProbe::probe(filePath);
+    if (!metadata.valid) {
+        // 文件不可读：只显示文件系统层面的信息
+        clearMetadata();
+        QFileInfo fileInfo(filePath);
+        m_fileNameEdit->setText(fileInfo.fileName());
+        m_filePathEdit->setText(
+            QDir::toNativeSeparators(fileInfo.absoluteFilePath()));
+        return;
+    }
+    populateFromMetadata(filePath, metadata);
+    // 探针路径没有文档句柄，扫描线程自己从路径加载临时句柄
+    populateFontsAsync();
+}
+
+void DocumentMetadataDialog::populateFontsAsync() {
+    m_fontsList->clear();
+    m_fontScanGeneration++;
+
+    if (m_currentFilePath.isEmpty()) {
+        m_fontsStatusLabel->setText(tr("未设置"));
+        return;
+    }
+
+    // 扫描过的文件直接回显缓存
+    auto cached = g_fontScanCache.constFind(m_currentFilePath);
+    if (cached != g_fontScanCache.constEnd()) {
+        m_fontsStatusLabel->setText(tr("共 %1 种字体").arg(cached->size()));
+        m_fontsList->addItems(*cached);
+        return;
+    }
+
+    m_fontsStatusLabel->setText(tr("正在扫描字体..."));
+
+    const quint64 generation = m_fontScanGeneration;
+    const QString filePath = m_currentFilePath;
+    QPointer<DocumentMetadataDialog> self(this);
+    const std::shared_ptr<DocumentSnapshot> snapshot =
+        DocumentSnapshot::forDocument(m_currentDocument);
+
+    RenderScheduler::instance().submit(
+        RenderScheduler::TaskClass::Background,
+        [self, snapshot, filePath, generation]() {
+            // 工作线程私有句柄：已注册的文档用快照克隆，未打开的
+            // 文件现场加载一个临时句柄，绝不触碰共享主句柄
+            std::unique_ptr<Poppler::Document> owned;
+            Poppler::Document* document =
+                snapshot ? snapshot->threadHandle() : nullptr;
+            if (!document) {
+                owned = Poppler::Document::load(filePath);
+                document = owned.get();
+            }
+            if (!document || document->isLocked()) {
+                QMetaObject::invokeMethod(
+                    self,
+                    [self, generation]() {
+                        if (self && self->m_fontScanGeneration == generation) {
+                            self->m_fontsStatusLabel->setText(
+                                tr("无法读取字体信息"));
+                        }
+                    },
+                    Qt::QueuedConnection);
+                return;
+            }
+
+            const int pageCount = document->numPages();
+            QStringList lines;
+            QSet<QString> seen;
+            int pagesScanned = 0;
+
+            auto iterator = document->newFontIterator(0);
+            while (iterator && iterator->hasNext()) {
+                const QList<Poppler::FontInfo> pageFonts = iterator->next();
+                ++pagesScanned;
+                for (const Poppler::FontInfo& font : pageFonts) {
+                    const QString name =
+                        font.name().isEmpty() ? tr("(未命名)") : font.name();
+                    const QString key = name + QLatin1Char('|') +
+                                        font.typeName();
+                    if (seen.contains(key)) {
+                        continue;
+                    }
+                    seen.insert(key);
+                    lines.append(QString("%1 — %2%3")
+                                     .arg(name)
+                                     .arg(font.typeName())
+                                     .arg(font.isEmbedded() ? tr("，已嵌入")
+                                                            : tr("，未嵌入")));
+                }
+
+                // 每32页汇报一次进度，避免每页都打一次主线程
+                if ((pagesScanned & 31) == 0) {
+                    const int progress = pagesScanned;
+                    QMetaObject::invokeMethod(
+                        self,
+                        [self, generation, progress, pageCount]() {
+                            if (self &&
+                                self->m_fontScanGeneration == generation) {
+                                self->m_fontsStatusLabel->setText(
+                                    tr("正在扫描字体... %1/%2 页")
+                                        .arg(progress)
+                                        .arg(pageCount));
+                            }
+                        },
+                        Qt::QueuedConnection);
+                }
+            }
+
+            lines.sort(Qt::CaseInsensitive);
+            QMetaObject::invokeMethod(
+                self,
+                [self, generation, filePath, lines]() {
+                    if (!self) {
+                        return;
+                    }
+                    // 结果无论对话框当前显示哪个文件都值得缓存
+                    g_fontScanCache.insert(filePath, lines);
+                    if (self->m_fontScanGeneration != generation) {
+                        return;
+                    }
+                    self->m_fontsStatusLabel->setText(
+                        tr("共 %1 种字体").arg(lines.size()));
+                    self->m_fontsList->addItems(lines);
+                },
+                Qt::QueuedConnection);
+        });
+}
+
+void DocumentMetadataDialog::populateFromMetadata(const QString& filePath,
+                                                  const PDFMetadata& metadata) {
+    QFileInfo fileInfo(filePath);
+
+    m_fileNameEdit->setText(fileInfo.fileName());
+    m_filePathEdit->setText(
+        QDir::toNativeSeparators(fileInfo.absoluteFilePath()));
+    m_fileSizeEdit->setText(formatFileSize(fileInfo.size()));
+    m_pageCountEdit->setText(metadata.pageCount >= 0
+                                 ? QString::number(metadata.pageCount)
+                                 : tr("未知"));
+
+    m_titleEdit->setText(metadata.title.isEmpty() ? tr("未设置")
+                                                  : metadata.title);
+    m_authorEdit->setText(metadata.author.isEmpty() ? tr("未设置")
+                                                    : metadata.author);
+    m_subjectEdit->setText(metadata.subject.isEmpty() ? tr("未设置")
+                                                      : metadata.subject);
+    m_keywordsEdit->setText(metadata.keywords.isEmpty() ? tr("未设置")
+                                                        : metadata.keywords);
+    m_creatorEdit->setText(metadata.creator.isEmpty() ? tr("未设置")
+                                                      : metadata.creator);
+    m_producerEdit->setText(metadata.producer.isEmpty() ? tr("未设置")
+                                                        : metadata.producer);
+    m_creationDateEdit->setText(formatDateTime(metadata.creationDate));
+    m_modificationDateEdit->setText(formatDateTime(metadata.modificationDate));
+
+    m_encryptedEdit->setText(metadata.encrypted ? tr("是") : tr("否"));
+    m_canExtractTextEdit->setText(tr("是"));
+    m_canPrintEdit->setText(tr("是"));
+    m_canModifyEdit->setText(tr("否"));
+}
+
 void DocumentMetadataDialog::clearMetadata() {
     // 清空所有字段
     m_fileNameEdit->clear();
@@ -224,6 +425,10 @@ void DocumentMetadataDialog::clearMetadata() {
     m_canExtractTextEdit->clear();
     m_canPrintEdit->clear();
     m_canModifyEdit->clear();
+
+    m_fontScanGeneration++;  // 在途的字体扫描结果作废
+    m_fontsStatusLabel->setText(tr("未设置"));
+    m_fontsList->clear();
 }
 
 void DocumentMetadataDialog::populateBasicInfo(const QString& filePath,
@@ -8,6 +8,7 @@
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QLineEdit>
+#include <QListWidget>
 #include <QObject>
 #include <QPushButton>
 #include <QScrollArea>
@@ -16,6 +17,8 @@
 #include <QWidget>
 #include <QtGlobal>
 
+struct PDFMetadata;
+
 class DocumentMetadataDialog : public QDialog {
     Q_OBJECT
 
@@ -26,6 +29,10 @@ public:
     // 设置要显示元数据的PDF文档
     void setDocument(Poppler::Document* document, const QString& filePath);
 
+    // 仅凭文件路径显示元数据：走轻量探针（Info字典+持久缓存），
+    // 不经过完整的文档加载管线，未打开的文档也能即时显示属性
+    void setFile(const QString& filePath);
+
 private slots:
     void onThemeChanged();
 
@@ -38,6 +45,12 @@ private:
                            Poppler::Document* document);
     void populateDocumentProperties(Poppler::Document* document);
     void populateSecurityInfo(Poppler::Document* document);
+    void populateFromMetadata(const QString& filePath,
+                              const PDFMetadata& metadata);
+
+    // 字体枚举要扫描整个文档，大文件上耗时数秒，因此放到共享工作
+    // 线程池异步执行并带进度；结果按文件缓存，重开对话框即时显示
+    void populateFontsAsync();
 
     QString formatDateTime(const QString& dateTimeStr);
     QString formatFileSize(qint64 bytes);
@@ -76,6 +89,12 @@ private:
     QLineEdit* m_canPrintEdit;
     QLineEdit* m_canModifyEdit;
 
+    // 字体信息组
+    QGroupBox* m_fontsGroup;
+    QVBoxLayout* m_fontsLayout;
+    QLabel* m_fontsStatusLabel;
+    QListWidget* m_fontsList;
+
     // 按钮
     QHBoxLayout* m_buttonLayout;
     QPushButton* m_closeButton;
@@ -83,4 +102,7 @@ private:
     // 当前文档信息
     QString m_currentFilePath;
     Poppler::Document* m_currentDocument;
+
+    // 每次set*递增；过期的扫描结果凭此丢弃
+    quint64 m_fontScanGeneration = 0;
 };
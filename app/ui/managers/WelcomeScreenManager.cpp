@@ -1,8 +1,9 @@
 #include "WelcomeScreenManager.h"
 #include <QApplication>
 #include <QDebug>
-#include <QTimer>
+#include <QPointer>
 #include "../../MainWindow.h"
+#include "../../managers/HeartbeatService.h"
 #include "../../model/DocumentModel.h"
 #include "../widgets/WelcomeWidget.h"
 
@@ -20,17 +21,20 @@ WelcomeScreenManager::WelcomeScreenManager(QObject* parent)
       m_welcomeScreenEnabled(DEFAULT_ENABLED),
       m_welcomeScreenVisible(false),
       m_isInitialized(false),
-      m_visibilityCheckTimer(nullptr) {
+      m_visibilityCheckHeartbeatId(-1) {
     qDebug() << "WelcomeScreenManager: Initializing...";
 
     initializeSettings();
 
-    // 创建延迟检查定时器
-    m_visibilityCheckTimer = new QTimer(this);
-    m_visibilityCheckTimer->setSingleShot(true);
-    m_visibilityCheckTimer->setInterval(VISIBILITY_CHECK_DELAY);
-    connect(m_visibilityCheckTimer, &QTimer::timeout, this,
-            &WelcomeScreenManager::onDelayedVisibilityCheck);
+    // 延迟检查注册到共享心跳服务，按需arm，不占独立定时器
+    QPointer<WelcomeScreenManager> self(this);
+    m_visibilityCheckHeartbeatId =
+        HeartbeatService::instance().registerDeadline(
+            "welcome-visibility", [self]() {
+                if (self) {
+                    self->onDelayedVisibilityCheck();
+                }
+            });
 
     m_isInitialized = true;
     qDebug() << "WelcomeScreenManager: Initialization completed";
@@ -38,6 +42,7 @@ WelcomeScreenManager::WelcomeScreenManager(QObject* parent)
 
 WelcomeScreenManager::~WelcomeScreenManager() {
     qDebug() << "WelcomeScreenManager: Destroying...";
+    HeartbeatService::instance().unregister(m_visibilityCheckHeartbeatId);
     saveSettings();
 }
 
@@ -287,7 +292,9 @@ void WelcomeScreenManager::updateWelcomeScreenVisibility() {
 }
 
 void WelcomeScreenManager::scheduleVisibilityCheck() {
-    if (m_visibilityCheckTimer && !m_visibilityCheckTimer->isActive()) {
-        m_visibilityCheckTimer->start();
+    // 已有待触发的检查则不重置，保持与原单次定时器相同的语义
+    if (!HeartbeatService::instance().isArmed(m_visibilityCheckHeartbeatId)) {
+        HeartbeatService::instance().arm(m_visibilityCheckHeartbeatId,
+                                         VISIBILITY_CHECK_DELAY);
     }
 }
@@ -2,7 +2,6 @@
 
 #include <QObject>
 #include <QSettings>
-#include <QTimer>
 
 class MainWindow;
 class WelcomeWidget;
@@ -81,8 +80,8 @@ private:
     bool m_welcomeScreenVisible;
     bool m_isInitialized;
 
-    // 延迟检查定时器
-    QTimer* m_visibilityCheckTimer;
+    // 延迟检查：挂在共享心跳服务上的一次性截止任务
+    int m_visibilityCheckHeartbeatId;
 
     // 设置键
     static const QString SETTINGS_GROUP;
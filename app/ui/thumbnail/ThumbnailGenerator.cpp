@@ -5,18 +5,29 @@
 #include <QDebug>
 #include <QHash>
 #include <QMutexLocker>
+#include <QPointer>
 #include <QQueue>
 #include <QThread>
-#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 #include <QtGui>
 #include <QtWidgets>
 #include <algorithm>
 #include <cmath>
+#include "cache/PDFCacheManager.h"
+#include "managers/RenderBroker.h"
+#include "managers/RenderScheduler.h"
+#include "model/DocumentSnapshot.h"
+#include "model/PageClassifier.h"
+#include "utils/ImageScaleKernel.h"
 #include "utils/LoggingMacros.h"
+#include "utils/PDFUtilities.h"
+#include "utils/SignalThrottle.h"
+#include "utils/PerfTracer.h"
+#include "utils/RenderPolicy.h"
 
 ThumbnailGenerator::ThumbnailGenerator(QObject* parent)
     : QObject(parent),
+      m_nextJobId(1),
       m_defaultSize(DEFAULT_THUMBNAIL_WIDTH, DEFAULT_THUMBNAIL_HEIGHT),
       m_defaultQuality(DEFAULT_QUALITY),
       m_maxConcurrentJobs(DEFAULT_MAX_CONCURRENT_JOBS),
@@ -37,6 +48,9 @@ ThumbnailGenerator::~ThumbnailGenerator() {
 }
 
 void ThumbnailGenerator::initializeGenerator() {
+    // 进度信号的合并中继
+    m_progressThrottle = new SignalThrottle(this);
+
     // 创建批处理定时器
     m_batchTimer = new QTimer(this);
     m_batchTimer->setInterval(m_batchInterval);
@@ -60,6 +74,13 @@ void ThumbnailGenerator::setDocument(
     // 停止当前所有任务
     clearQueue();
     cleanupJobs();
+    clearPyramids();
+
+    // 内容框随文档作废
+    {
+        QMutexLocker boxLocker(&m_contentBoxMutex);
+        m_contentBoxes.clear();
+    }
 
     m_document = document;
 
@@ -187,26 +208,62 @@ void ThumbnailGenerator::cancelRequest(int pageNumber) {
         GenerationRequest req = m_requestQueue.dequeue();
         if (req.pageNumber != pageNumber) {
             newQueue.enqueue(req);
+        } else {
+            req.token.cancel();
         }
     }
 
     m_requestQueue = newQueue;
     emit queueSizeChanged(m_requestQueue.size());
 
-    // 也尝试取消正在进行的任务
+    // 也取消正在进行的任务：先取消令牌（在途渲染闭包持有同一标志，
+    // Poppler会在下次轮询时中止），再删除记录让jobId失配丢弃结果
     QMutexLocker jobsLocker(&m_jobsMutex);
     auto it = m_activeJobs.find(pageNumber);
     if (it != m_activeJobs.end()) {
-        GenerationJob* job = it.value();
-        if (job && job->watcher) {
-            job->watcher->cancel();
-        }
-        delete job;  // 手动删除
+        it.value()->request.token.cancel();
+        delete it.value();  // 手动删除
         m_activeJobs.erase(it);
         emit activeJobsChanged(m_activeJobs.size());
     }
 }
 
+void ThumbnailGenerator::cancelRequestsOutside(int firstPage, int lastPage) {
+    QMutexLocker locker(&m_queueMutex);
+
+    // 丢弃视口范围外的排队请求；正在执行的任务让其自然结束
+    int before = m_requestQueue.size();
+    QQueue<GenerationRequest> newQueue;
+    while (!m_requestQueue.isEmpty()) {
+        GenerationRequest req = m_requestQueue.dequeue();
+        if (req.pageNumber >= firstPage && req.pageNumber <= lastPage) {
+            newQueue.enqueue(req);
+        }
+    }
+    m_requestQueue = newQueue;
+
+    if (m_requestQueue.size() != before) {
+        emit queueSizeChanged(m_requestQueue.size());
+    }
+}
+
+void ThumbnailGenerator::reprioritizeForViewport(int firstVisible,
+                                                 int lastVisible) {
+    QMutexLocker locker(&m_queueMutex);
+
+    // 按与视口的距离重新计算排队请求的优先级
+    for (auto& req : m_requestQueue) {
+        if (req.pageNumber >= firstVisible && req.pageNumber <= lastVisible) {
+            req.priority = 0;
+        } else if (req.pageNumber < firstVisible) {
+            req.priority = firstVisible - req.pageNumber;
+        } else {
+            req.priority = req.pageNumber - lastVisible;
+        }
+    }
+    std::sort(m_requestQueue.begin(), m_requestQueue.end());
+}
+
 void ThumbnailGenerator::setPriority(int pageNumber, int priority) {
     QMutexLocker locker(&m_queueMutex);
 
@@ -295,63 +352,58 @@ void ThumbnailGenerator::startNextJob() {
     // 创建新任务
     auto job = std::make_unique<GenerationJob>();
     job->request = request;
-    job->watcher = new QFutureWatcher<QPixmap>();
-
-    connect(job->watcher, &QFutureWatcher<QPixmap>::finished, this,
-            &ThumbnailGenerator::onGenerationFinished);
+    job->jobId = m_nextJobId++;
+    quint64 jobId = job->jobId;
 
-    // 启动异步生成
-    job->future = QtConcurrent::run(
-        [this, request]() { return generatePixmap(request); });
+    {
+        QMutexLocker jobsLocker(&m_jobsMutex);
+        m_activeJobs[request.pageNumber] = job.release();  // 转移所有权
+        emit activeJobsChanged(m_activeJobs.size());
+    }
 
-    job->watcher->setFuture(job->future);
+    // 经由RenderBroker异步生成：同一(页, 尺寸)的并发请求合并为一次
+    // Poppler渲染，目标尺寸编码在region里与整页渲染区分开
+    RenderBroker::RenderKey key = RenderBroker::makeKey(
+        document().get(), request.pageNumber, request.quality, 0,
+        QRect(QPoint(0, 0), request.size));
 
-    // 添加到活动任务
-    QMutexLocker jobsLocker(&m_jobsMutex);
-    m_activeJobs[request.pageNumber] = job.release();  // 转移所有权
-    emit activeJobsChanged(m_activeJobs.size());
+    QPointer<ThumbnailGenerator> self(this);
+    RenderBroker::instance().request(
+        key, RenderScheduler::TaskClass::Thumbnail,
+        [self, request]() -> QImage {
+            if (!self || request.token.isCancelled()) {
+                return QImage();
+            }
+            return self->generateImage(request);
+        },
+        this,
+        [self, pageNumber = request.pageNumber, jobId](const QImage& image) {
+            if (!self) {
+                return;
+            }
+            // QPixmap转换回到GUI线程完成
+            self->completeJob(pageNumber, jobId, QPixmap::fromImage(image));
+        });
 }
 
-void ThumbnailGenerator::onGenerationFinished() {
-    QFutureWatcher<QPixmap>* watcher =
-        static_cast<QFutureWatcher<QPixmap>*>(sender());
-    if (!watcher)
-        return;
-
-    // 找到对应的任务
+void ThumbnailGenerator::completeJob(int pageNumber, quint64 jobId,
+                                     const QPixmap& pixmap) {
     GenerationJob* job = nullptr;
-    int pageNumber = -1;
-
     {
         QMutexLocker locker(&m_jobsMutex);
-        for (auto it = m_activeJobs.begin(); it != m_activeJobs.end(); ++it) {
-            if (it.value()->watcher == watcher) {
-                job = it.value();
-                pageNumber = it.key();
-                break;
-            }
+        auto it = m_activeJobs.find(pageNumber);
+        if (it == m_activeJobs.end() || it.value()->jobId != jobId) {
+            return;  // 任务已被取消或清理，结果作废
         }
+        job = it.value();
     }
 
-    if (!job) {
-        watcher->deleteLater();
-        return;
-    }
-
-    try {
-        QPixmap pixmap = watcher->result();
-
-        if (!pixmap.isNull()) {
-            handleJobCompletion(job);
-            emit thumbnailGenerated(pageNumber, pixmap);
-            m_totalGenerated++;
-        } else {
-            handleJobError(job, "Failed to generate pixmap");
-        }
-    } catch (const std::exception& e) {
-        handleJobError(job, QString("Generation error: %1").arg(e.what()));
-    } catch (...) {
-        handleJobError(job, "Unknown generation error");
+    if (!pixmap.isNull()) {
+        handleJobCompletion(job);
+        emit thumbnailGenerated(pageNumber, pixmap);
+        m_totalGenerated++;
+    } else {
+        handleJobError(job, "Failed to generate pixmap");
     }
 
     // 清理任务
@@ -360,8 +412,6 @@ void ThumbnailGenerator::onGenerationFinished() {
         delete m_activeJobs.take(pageNumber);  // 删除并移除
         emit activeJobsChanged(m_activeJobs.size());
     }
-
-    watcher->deleteLater();
 }
 
 void ThumbnailGenerator::onBatchTimer() {
@@ -381,15 +431,12 @@ void ThumbnailGenerator::onBatchTimer() {
 void ThumbnailGenerator::cleanupJobs() {
     QMutexLocker locker(&m_jobsMutex);
 
-    for (auto it = m_activeJobs.begin(); it != m_activeJobs.end(); ++it) {
-        GenerationJob* job = it.value();
-        if (job && job->watcher) {
-            job->watcher->cancel();
-            job->watcher->waitForFinished();
-        }
-        delete job;  // 手动删除
+    // 先取消所有令牌让在途渲染中止，再删除记录：结果回到
+    // completeJob时因jobId不再匹配而被丢弃
+    for (GenerationJob* job : m_activeJobs) {
+        job->request.token.cancel();
     }
-
+    qDeleteAll(m_activeJobs);
     m_activeJobs.clear();
     emit activeJobsChanged(0);
 }
@@ -428,72 +475,342 @@ void ThumbnailGenerator::handleJobError(GenerationJob* job,
     }
 }
 
-QPixmap ThumbnailGenerator::generatePixmap(const GenerationRequest& request) {
+QImage ThumbnailGenerator::generateImage(const GenerationRequest& request) {
+    PERF_TRACE_SCOPE("ThumbnailGenerator::generateImage");
+
+    if (request.token.isCancelled()) {
+        return QImage();
+    }
+
+    // 金字塔命中：纯CPU降采样，完全不触碰Poppler
+    QImage derived = serveFromPyramid(request.pageNumber, request.size);
+    if (!derived.isNull()) {
+        return derived;
+    }
+
+    // 优先走文档快照：本线程私有的Poppler句柄，渲染全程不占
+    // m_documentMutex，多个工作线程可并行栅格化不同页面；
+    // leasePage复用线程页对象池，避免每次缩略图都重建Poppler::Page
+    std::shared_ptr<Poppler::Document> doc = document();
+    if (!doc) {
+        return QImage();
+    }
+
+    // 扫描件快速路径：整页内容就是一张内嵌JPEG时，直接按基准尺寸
+    // 解码原始图像流（解码器内部降采样），完全跳过Poppler栅格化；
+    // 解码结果照常进金字塔供后续尺寸派生
+    if (auto snapshot = DocumentSnapshot::forDocument(doc.get())) {
+        const PDFUtilities::EmbeddedPageImage embedded =
+            PDFUtilities::extractEmbeddedPageImage(snapshot->filePath(),
+                                                   request.pageNumber,
+                                                   doc->numPages());
+        if (embedded.valid && embedded.width > 0 && embedded.height > 0) {
+            const int baseWidth =
+                qMax(PYRAMID_BASE_WIDTH, request.size.width());
+            const int baseHeight = qMax(
+                1, qRound(static_cast<double>(baseWidth) * embedded.height /
+                          embedded.width));
+            QImage base = embedded.decode(QSize(baseWidth, baseHeight));
+            if (!base.isNull()) {
+                // 扫描件同样裁掉空白边距；检测结果按页缓存
+                base = applyContentCrop(request.pageNumber, base);
+                buildPyramid(request.pageNumber, base);
+                QImage served =
+                    serveFromPyramid(request.pageNumber, request.size);
+                if (!served.isNull()) {
+                    return served;
+                }
+            }
+        }
+    }
+
+    if (auto snapshot = DocumentSnapshot::forDocument(doc.get())) {
+        if (auto lease = snapshot->leasePage(request.pageNumber)) {
+            return renderBaseAndServe(lease.get(), request);
+        }
+    }
+
+    // 未注册快照的文档退回共享句柄，渲染期间持锁
     QMutexLocker locker(&m_documentMutex);
 
     if (!m_document) {
-        return QPixmap();
+        return QImage();
     }
 
+    std::unique_ptr<Poppler::Page> page(m_document->page(request.pageNumber));
+    return renderBaseAndServe(page.get(), request);
+}
+
+QImage ThumbnailGenerator::renderBaseAndServe(
+    Poppler::Page* page, const GenerationRequest& request) {
     try {
-        std::unique_ptr<Poppler::Page> page(
-            m_document->page(request.pageNumber));
         if (!page) {
-            return QPixmap();
+            return QImage();
         }
 
-        return renderPageToPixmap(page.get(), request.size, request.quality);
+        // 基准级别按最大有用尺寸渲染一次，之后任何请求尺寸
+        // （侧栏拖拽、委托换档）都从金字塔派生
+        const QSizeF pageSize = page->pageSizeF();
+        const QRectF contentBox = cachedContentBox(request.pageNumber);
+        const bool cropKnown =
+            !contentBox.isNull() && contentBox != QRectF(0, 0, 1, 1);
+
+        // 已知内容框：基准尺寸按内容区域的宽高比取，渲染只栅格化
+        // 该区域，空白边距完全不经过光栅器
+        const QSizeF contentSize =
+            cropKnown ? QSizeF(pageSize.width() * contentBox.width(),
+                               pageSize.height() * contentBox.height())
+                      : pageSize;
+        const int baseWidth = qMax(PYRAMID_BASE_WIDTH, request.size.width());
+        const int baseHeight =
+            contentSize.width() > 0
+                ? qRound(baseWidth * contentSize.height() /
+                         contentSize.width())
+                : baseWidth;
+        QImage base = renderPageToImage(page, QSize(baseWidth, baseHeight),
+                                        request.quality, request.token,
+                                        cropKnown ? contentBox : QRectF());
+        if (base.isNull()) {
+            return QImage();
+        }
+
+        // 首次渲染整页：检测墨迹包围框并缓存，本次裁剪位图
+        if (!cropKnown) {
+            base = applyContentCrop(request.pageNumber, base);
+        }
+        buildPyramid(request.pageNumber, base);
+
+        return serveFromPyramid(request.pageNumber, request.size);
 
     } catch (const std::exception& e) {
-        LOG_WARNING("Exception in generatePixmap: {}", std::string(e.what()));
-        return QPixmap();
+        LOG_WARNING("Exception in generateImage: {}", std::string(e.what()));
+        return QImage();
     } catch (...) {
-        LOG_WARNING("Unknown exception in generatePixmap");
-        return QPixmap();
+        LOG_WARNING("Unknown exception in generateImage");
+        return QImage();
     }
 }
 
-QPixmap ThumbnailGenerator::renderPageToPixmap(Poppler::Page* page,
-                                               const QSize& size,
-                                               double quality) {
+QImage ThumbnailGenerator::serveFromPyramid(int pageNumber,
+                                            const QSize& size) {
+    QMutexLocker locker(&m_pyramidMutex);
+
+    auto it = m_pyramids.constFind(pageNumber);
+    if (it == m_pyramids.constEnd() || it->isEmpty()) {
+        return QImage();
+    }
+
+    const QVector<QImage>& levels = *it;
+
+    // 请求超出基准级别：作废该页金字塔，让调用方重新渲染更大的基准
+    const QImage& base = levels.first();
+    if (base.width() < size.width() && base.height() < size.height()) {
+        m_pyramids.remove(pageNumber);
+        m_pyramidOrder.removeOne(pageNumber);
+        return QImage();
+    }
+
+    // 级别从大到小排列，取仍能覆盖请求尺寸的最小级别
+    QImage chosen = base;
+    for (const QImage& level : levels) {
+        if (level.width() >= size.width() ||
+            level.height() >= size.height()) {
+            chosen = level;
+        } else {
+            break;
+        }
+    }
+
+    if (chosen.size() == size) {
+        return chosen;
+    }
+    return chosen.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+}
+
+void ThumbnailGenerator::buildPyramid(int pageNumber,
+                                      const QImage& baseImage) {
+    if (baseImage.isNull()) {
+        return;
+    }
+
+    // 逐级50%降采样等价于盒式滤波：每级只读上一级，缓存友好，
+    // 且避免一步大比例缩放的走样。减半步骤走向量化内核，
+    // 扫描件大图上比Qt平滑变换快数倍
+    QVector<QImage> levels;
+    levels.append(baseImage);
+    QImage current = baseImage;
+    while (current.width() / 2 >= PYRAMID_MIN_WIDTH) {
+        current = ImageScaleKernel::halve(current);
+        levels.append(current);
+    }
+
+    QMutexLocker locker(&m_pyramidMutex);
+    if (!m_pyramids.contains(pageNumber)) {
+        m_pyramidOrder.append(pageNumber);
+    }
+    m_pyramids[pageNumber] = levels;
+
+    while (m_pyramidOrder.size() > PYRAMID_MAX_PAGES) {
+        m_pyramids.remove(m_pyramidOrder.takeFirst());
+    }
+}
+
+void ThumbnailGenerator::clearPyramids() {
+    QMutexLocker locker(&m_pyramidMutex);
+    m_pyramids.clear();
+    m_pyramidOrder.clear();
+}
+
+QRectF ThumbnailGenerator::cachedContentBox(int pageNumber) const {
+    QMutexLocker locker(&m_contentBoxMutex);
+    return m_contentBoxes.value(pageNumber);  // 未检测过时为空矩形
+}
+
+QImage ThumbnailGenerator::applyContentCrop(int pageNumber,
+                                            const QImage& base) {
+    if (base.isNull()) {
+        return base;
+    }
+
+    QRectF box;
+    {
+        QMutexLocker locker(&m_contentBoxMutex);
+        auto it = m_contentBoxes.constFind(pageNumber);
+        if (it != m_contentBoxes.constEnd()) {
+            box = it.value();
+        }
+    }
+
+    if (box.isNull()) {
+        // 检测在降采样副本上做：逐级减半到检测宽度后扫描墨迹，
+        // 整个检测只有几千个像素的代价
+        QImage probe = base;
+        while (probe.width() / 2 >= CONTENT_SCAN_WIDTH) {
+            probe = ImageScaleKernel::halve(probe);
+        }
+
+        box = QRectF(0, 0, 1, 1);
+        const QRect ink = ImageScaleKernel::contentBox(probe);
+        if (!ink.isNull() && probe.width() > 0 && probe.height() > 0) {
+            QRectF normalized(
+                static_cast<double>(ink.x()) / probe.width(),
+                static_cast<double>(ink.y()) / probe.height(),
+                static_cast<double>(ink.width()) / probe.width(),
+                static_cast<double>(ink.height()) / probe.height());
+            normalized.adjust(-CONTENT_CROP_PADDING, -CONTENT_CROP_PADDING,
+                              CONTENT_CROP_PADDING, CONTENT_CROP_PADDING);
+            normalized &= QRectF(0, 0, 1, 1);
+
+            // 只有留白可观时才裁剪；接近整页就缓存整页矩形，
+            // 后续生成直接跳过检测与裁剪
+            if (normalized.width() * normalized.height() <
+                CONTENT_CROP_MAX_COVERAGE) {
+                box = normalized;
+            }
+        }
+
+        QMutexLocker locker(&m_contentBoxMutex);
+        m_contentBoxes.insert(pageNumber, box);
+    }
+
+    if (box == QRectF(0, 0, 1, 1)) {
+        return base;
+    }
+
+    const QRect pixels =
+        QRect(qRound(box.x() * base.width()), qRound(box.y() * base.height()),
+              qRound(box.width() * base.width()),
+              qRound(box.height() * base.height()))
+            .intersected(base.rect());
+    return pixels.isValid() ? base.copy(pixels) : base;
+}
+
+QImage ThumbnailGenerator::renderPageToImage(Poppler::Page* page,
+                                             const QSize& size, double quality,
+                                             const CancellationToken& token,
+                                             const QRectF& contentBox) {
     // 使用优化版本
-    return renderPageToPixmapOptimized(page, size, quality);
+    return renderPageToImageOptimized(page, size, quality, token, contentBox);
 }
 
-QPixmap ThumbnailGenerator::renderPageToPixmapOptimized(Poppler::Page* page,
-                                                        const QSize& size,
-                                                        double quality) {
+QImage ThumbnailGenerator::renderPageToImageOptimized(
+    Poppler::Page* page, const QSize& size, double quality,
+    const CancellationToken& token, const QRectF& contentBox) {
     if (!page) {
-        return QPixmap();
+        return QImage();
     }
 
     try {
         QSizeF pageSize = page->pageSizeF();
-        double dpi = getCachedDPI(size, pageSize, quality);
-
-        // 渲染页面 - 直接渲染到目标尺寸附近以减少缩放
-        QImage image = page->renderToImage(dpi, dpi, -1, -1, -1, -1,
-                                           Poppler::Page::Rotate0);
+        const bool cropped =
+            !contentBox.isNull() && contentBox != QRectF(0, 0, 1, 1);
+        // DPI按实际栅格化的区域适配：裁剪时同样的目标像素数
+        // 全部落在内容上，有效细节更高
+        const QSizeF renderSize =
+            cropped ? QSizeF(pageSize.width() * contentBox.width(),
+                             pageSize.height() * contentBox.height())
+                    : pageSize;
+        double dpi = getCachedDPI(size, renderSize, quality);
+
+        // 渲染页面 - 直接渲染到目标尺寸附近以减少缩放；
+        // 令牌接入Poppler中止回调，取消的任务在栅格化中途停下
+        QImage image;
+        if (cropped) {
+            // Poppler局部渲染：坐标在dpi缩放后的光栅空间里
+            const double scale = dpi / 72.0;
+            const int x = qRound(contentBox.x() * pageSize.width() * scale);
+            const int y = qRound(contentBox.y() * pageSize.height() * scale);
+            const int w =
+                qMax(1, qRound(contentBox.width() * pageSize.width() * scale));
+            const int h = qMax(
+                1, qRound(contentBox.height() * pageSize.height() * scale));
+            image =
+                CancellableRender::renderToImage(page, token, dpi, dpi, x, y,
+                                                 w, h);
+        } else {
+            image = CancellableRender::renderToImage(page, token, dpi, dpi);
+        }
 
         if (image.isNull()) {
-            return QPixmap();
+            return QImage();
         }
 
-        // 优化缩放操作
+        // 优化缩放操作：大比例缩小走向量化盒式滤波内核，
+        // 小比例或小目标保持原有的快速变换
         if (image.size() != size) {
             Qt::TransformationMode mode =
                 getOptimalTransformationMode(image.size(), size);
-            image = image.scaled(size, Qt::KeepAspectRatio, mode);
+            if (mode == Qt::FastTransformation) {
+                image = image.scaled(size, Qt::KeepAspectRatio, mode);
+            } else {
+                image = ImageScaleKernel::downscale(image, size);
+            }
         }
 
-        return QPixmap::fromImage(image);
+        // 无色页的缩略图（含金字塔各级）按8位灰度存储，内存省3/4；
+        // 缩放之后再转换，保证缩放内核始终处理ARGB输入
+        QString documentKey;
+        {
+            QMutexLocker docLocker(&m_documentMutex);
+            if (m_document) {
+                documentKey =
+                    PDFCacheManager::namespaceForDocument(m_document.get());
+            }
+        }
+        if (!documentKey.isEmpty()) {
+            image = RenderPolicy::toStorageFormat(
+                image, PageClassifier::instance().pageHasColor(
+                           documentKey, page->index(), page));
+        }
+
+        return image;
 
     } catch (const std::exception& e) {
-        qWarning() << "Exception in renderPageToPixmapOptimized:" << e.what();
-        return QPixmap();
+        qWarning() << "Exception in renderPageToImageOptimized:" << e.what();
+        return QImage();
     } catch (...) {
-        qWarning() << "Unknown exception in renderPageToPixmapOptimized";
-        return QPixmap();
+        qWarning() << "Unknown exception in renderPageToImageOptimized";
+        return QImage();
     }
 }
 
@@ -504,22 +821,10 @@ double ThumbnailGenerator::calculateOptimalDPI(const QSize& targetSize,
         return MIN_DPI;
     }
 
-    // 计算缩放比例
-    double scaleX = targetSize.width() / pageSize.width();
-    double scaleY = targetSize.height() / pageSize.height();
-    double scale = qMin(scaleX, scaleY);
-
-    // 基础DPI - 优化：根据目标尺寸调整基础DPI
-    double baseDPI = (targetSize.width() <= 150) ? 72.0 : 96.0;
-
-    // 根据质量和缩放比例计算DPI
-    double dpi = baseDPI * scale * quality;
-
-    // 考虑设备像素比
-    double deviceRatio = qApp->devicePixelRatio();
-    dpi *= deviceRatio;
-
-    // 限制DPI范围
+    // 统一走RenderPolicy计算适配DPI，避免各渲染路径各算各的；
+    // 缩略图仍保留自己的DPI上下限
+    double dpi = RenderPolicy::fitDpi(targetSize, pageSize,
+                                      qApp->devicePixelRatio(), quality);
     return qBound(MIN_DPI, dpi, MAX_DPI);
 }
 
@@ -587,7 +892,12 @@ void ThumbnailGenerator::updateStatistics() {
         double avgTime =
             totalRequests > 0 ? (double)m_totalTime / totalRequests : 0.0;
 
-        emit generationProgress(m_totalGenerated, totalRequests);
+        // 每张缩略图都发一次进度会压垮事件队列，经节流中继合并，
+        // 每帧间隔至多投递一次最新值
+        const int completed = m_totalGenerated;
+        m_progressThrottle->post([this, completed, totalRequests]() {
+            emit generationProgress(completed, totalRequests);
+        });
 
         // 定期输出统计信息
         static int logCounter = 0;
@@ -2,17 +2,22 @@
 
 #include <poppler/qt6/poppler-qt6.h>
 #include <QDateTime>
-#include <QFuture>
-#include <QFutureWatcher>
+#include <QHash>
+#include <QImage>
 #include <QMutex>
 #include <QObject>
 #include <QPixmap>
 #include <QQueue>
+#include <QRect>
 #include <QSize>
 #include <QThread>
 #include <QTimer>
+#include <QVector>
 #include <QWaitCondition>
 #include <memory>
+#include "utils/CancellationToken.h"
+
+class SignalThrottle;
 
 /**
  * @brief 异步PDF缩略图生成器
@@ -36,6 +41,9 @@ public:
         int priority;  // 数值越小优先级越高
         qint64 timestamp;
         int retryCount;
+        // 取消标记：队列副本与在途任务共享同一标志，取消后
+        // 正在进行的Poppler渲染也会中止
+        CancellationToken token;
 
         GenerationRequest()
             : pageNumber(-1),
@@ -92,7 +100,9 @@ public:
     // 队列管理
     void clearQueue();
     void cancelRequest(int pageNumber);
+    void cancelRequestsOutside(int firstPage, int lastPage);
     void setPriority(int pageNumber, int priority);
+    void reprioritizeForViewport(int firstVisible, int lastVisible);
 
     // 状态查询
     bool isGenerating(int pageNumber) const;
@@ -117,37 +127,59 @@ signals:
 
 private slots:
     void processQueue();
-    void onGenerationFinished();
     void onBatchTimer();
 
 private:
     struct GenerationJob {
         GenerationRequest request;
-        QFuture<QPixmap> future;
-        QFutureWatcher<QPixmap>* watcher;
+        quint64 jobId;  // 识别过期的渲染结果（任务被取消/清理后作废）
 
-        GenerationJob() : watcher(nullptr) {}
-        ~GenerationJob() { delete watcher; }
+        GenerationJob() : jobId(0) {}
     };
 
     void initializeGenerator();
     void cleanupJobs();
     void startNextJob();
+    void completeJob(int pageNumber, quint64 jobId, const QPixmap& pixmap);
     void handleJobCompletion(GenerationJob* job);
     void handleJobError(GenerationJob* job, const QString& error);
 
-    QPixmap generatePixmap(const GenerationRequest& request);
-    QPixmap renderPageToPixmap(Poppler::Page* page, const QSize& size,
-                               double quality);
+    QImage generateImage(const GenerationRequest& request);
+    // 渲染基准级别并从金字塔取出请求尺寸；页面句柄来自文档快照的
+    // 页对象池（线程私有，无锁）或持锁的共享文档，调用方持有所有权
+    QImage renderBaseAndServe(Poppler::Page* page,
+                              const GenerationRequest& request);
+    QImage renderPageToImage(Poppler::Page* page, const QSize& size,
+                             double quality, const CancellationToken& token,
+                             const QRectF& contentBox = QRectF());
     double calculateOptimalDPI(const QSize& targetSize, const QSizeF& pageSize,
                                double quality);
 
     void updateStatistics();
     void logPerformance(const GenerationRequest& request, qint64 duration);
 
-    // 优化方法
-    QPixmap renderPageToPixmapOptimized(Poppler::Page* page, const QSize& size,
-                                        double quality);
+    // 金字塔缓存：每页只经Poppler渲染一次（按最大有用尺寸），
+    // 更小的级别用逐级50%降采样（盒式滤波）派生；任意请求尺寸从
+    // 能覆盖它的最小级别缩放得到，侧栏调整尺寸不再整批重渲染
+    QImage serveFromPyramid(int pageNumber, const QSize& size);
+    void buildPyramid(int pageNumber, const QImage& baseImage);
+    void clearPyramids();
+
+    // 内容框检测：报告类页面大片留白，缩略图里内容缩成一小块。
+    // 在降采样的基准图上做行列墨迹扫描（见ImageScaleKernel::
+    // contentBox），得到去掉空白边距的归一化内容矩形并按页缓存；
+    // 首次生成裁剪位图，之后的重渲染直接只栅格化内容区域，
+    // 同样的像素预算全花在墨迹上。覆盖率接近整页时缓存整页
+    // 矩形，裁剪不生效
+    QRectF cachedContentBox(int pageNumber) const;
+    QImage applyContentCrop(int pageNumber, const QImage& base);
+
+    // 优化方法。contentBox为归一化内容矩形：非空且小于整页时只
+    // 栅格化该区域（Poppler局部渲染），空白像素不进光栅器
+    QImage renderPageToImageOptimized(Poppler::Page* page, const QSize& size,
+                                      double quality,
+                                      const CancellationToken& token,
+                                      const QRectF& contentBox = QRectF());
     double getCachedDPI(const QSize& targetSize, const QSizeF& pageSize,
                         double quality);
     void cacheDPI(const QSize& targetSize, const QSizeF& pageSize,
@@ -163,6 +195,15 @@ private:
     mutable QHash<QString, double> m_dpiCache;
     mutable QMutex m_dpiCacheMutex;
 
+    // 金字塔缓存（页号 -> 从大到小的级别），FIFO逐出
+    QHash<int, QVector<QImage>> m_pyramids;
+    QList<int> m_pyramidOrder;
+    mutable QMutex m_pyramidMutex;
+
+    // 内容框缓存（页号 -> 归一化矩形；整页矩形表示无需裁剪）
+    QHash<int, QRectF> m_contentBoxes;
+    mutable QMutex m_contentBoxMutex;
+
     // 队列管理
     QQueue<GenerationRequest> m_requestQueue;
     mutable QMutex m_queueMutex;
@@ -171,6 +212,7 @@ private:
     // 活动任务
     QHash<int, GenerationJob*> m_activeJobs;
     mutable QMutex m_jobsMutex;
+    quint64 m_nextJobId;
 
     // 设置
     QSize m_defaultSize;
@@ -191,6 +233,7 @@ private:
     int m_totalGenerated;
     int m_totalErrors;
     qint64 m_totalTime;
+    SignalThrottle* m_progressThrottle;  // 进度信号的合并中继
 
     // 常量 - 优化后的默认值
     static constexpr int DEFAULT_THUMBNAIL_WIDTH = 120;
@@ -203,4 +246,11 @@ private:
     static constexpr int QUEUE_PROCESS_INTERVAL = 25;  // 减少队列处理间隔
     static constexpr double MIN_DPI = 72.0;
     static constexpr double MAX_DPI = 200.0;  // 降低最大DPI以提升性能
+    static constexpr int PYRAMID_BASE_WIDTH = 256;  // 基准级别最大有用宽度
+    static constexpr int PYRAMID_MIN_WIDTH = 32;    // 最小级别宽度
+    static constexpr int PYRAMID_MAX_PAGES = 64;    // 缓存金字塔的页数上限
+    static constexpr int CONTENT_SCAN_WIDTH = 160;  // 检测用降采样宽度
+    static constexpr double CONTENT_CROP_PADDING = 0.02;  // 内容框四周留白
+    // 内容框面积占比超过该值时视为没有可观的空白边距，不裁剪
+    static constexpr double CONTENT_CROP_MAX_COVERAGE = 0.85;
 };
@@ -50,7 +50,10 @@ ThumbnailListView::ThumbnailListView(QWidget* parent)
       m_currentPage(-1),
       m_viewportUpdatePending(false),
       m_lastVisibleStart(-1),
-      m_lastVisibleEnd(-1) {
+      m_lastVisibleEnd(-1),
+      m_scrollVelocity(0.0),
+      m_fastScrolling(false),
+      m_scrollSettleTimer(nullptr) {
     setupUI();
     setupScrollBars();
     setupAnimations();
@@ -143,6 +146,13 @@ void ThumbnailListView::setupAnimations() {
     connect(m_fadeInTimer, &QTimer::timeout, this,
             &ThumbnailListView::onFadeInTimer);
 
+    // 滚动停稳定时器：快速滑动期间不断重启，超时即认为滚动结束
+    m_scrollSettleTimer = new QTimer(this);
+    m_scrollSettleTimer->setInterval(SCROLL_SETTLE_MS);
+    m_scrollSettleTimer->setSingleShot(true);
+    connect(m_scrollSettleTimer, &QTimer::timeout, this,
+            &ThumbnailListView::onScrollSettled);
+
     // 透明度效果
     if (m_fadeInEnabled) {
         m_opacityEffect = new QGraphicsOpacityEffect(this);
@@ -615,6 +625,11 @@ void ThumbnailListView::updateVisibleRange() {
 
     m_visibleRange = qMakePair(firstVisible, lastVisible);
 
+    // 快速滑动期间不发起生成请求，停稳后onScrollSettled统一补齐
+    if (m_fastScrolling) {
+        return;
+    }
+
     // 请求可见范围的缩略图
     for (int i = firstVisible; i <= lastVisible; ++i) {
         QModelIndex index = thumbnailModel->index(i, 0);
@@ -652,10 +667,64 @@ void ThumbnailListView::scrollContentsBy(int dx, int dy) {
 
     m_isScrolling = true;
 
+    // 估算滚动速度（指数平滑，px/s）
+    if (!m_scrollVelocityTimer.isValid()) {
+        m_scrollVelocityTimer.start();
+    } else {
+        qint64 elapsedMs = m_scrollVelocityTimer.restart();
+        if (elapsedMs > 0) {
+            double instantVelocity = qAbs(dy) * 1000.0 / elapsedMs;
+            m_scrollVelocity =
+                0.6 * m_scrollVelocity + 0.4 * instantVelocity;
+        }
+    }
+
+    // 快速滑动：切换到占位绘制并暂停缩略图生成，
+    // 把渲染能力留给滚动本身（一帧只可见16ms的内容不值得全质量渲染）
+    if (!m_fastScrolling && m_scrollVelocity > FAST_SCROLL_VELOCITY) {
+        m_fastScrolling = true;
+        if (m_thumbnailDelegate) {
+            m_thumbnailDelegate->setFastScrollMode(true);
+        }
+    }
+    if (m_fastScrolling && m_scrollSettleTimer) {
+        m_scrollSettleTimer->start();
+    }
+
     // 使用优化的视口更新
     scheduleViewportUpdate();
 }
 
+void ThumbnailListView::onScrollSettled() {
+    // 滚动停下：恢复全质量绘制，并为最终视口发起一批
+    // 高优先级的缩略图请求
+    m_fastScrolling = false;
+    m_scrollVelocity = 0.0;
+    m_scrollVelocityTimer.invalidate();
+
+    if (m_thumbnailDelegate) {
+        m_thumbnailDelegate->setFastScrollMode(false);
+    }
+
+    ThumbnailModel* thumbnailModel = qobject_cast<ThumbnailModel*>(model());
+    if (thumbnailModel) {
+        QRect viewportRect = viewport()->rect();
+        int firstVisible = indexAt(viewportRect.topLeft()).row();
+        int lastVisible = indexAt(viewportRect.bottomRight()).row();
+        if (firstVisible < 0)
+            firstVisible = 0;
+        if (lastVisible < 0)
+            lastVisible = thumbnailModel->rowCount() - 1;
+
+        m_visibleRange = qMakePair(firstVisible, lastVisible);
+        thumbnailModel->setViewportRange(firstVisible, lastVisible,
+                                         m_preloadMargin);
+        thumbnailModel->requestThumbnailRange(firstVisible, lastVisible);
+    }
+
+    viewport()->update();
+}
+
 void ThumbnailListView::updateScrollBarStyle() {
     // 更新滚动条样式
     if (verticalScrollBar()) {
@@ -724,7 +793,7 @@ int ThumbnailListView::pageAtIndex(const QModelIndex& index) const {
 
 void ThumbnailListView::updatePreloadRange() {
     ThumbnailModel* thumbnailModel = qobject_cast<ThumbnailModel*>(model());
-    if (!thumbnailModel || m_visibleRange.first < 0)
+    if (!thumbnailModel || m_visibleRange.first < 0 || m_fastScrolling)
         return;
 
     // 预加载可见范围前后的几页
@@ -870,15 +939,18 @@ void ThumbnailListView::optimizedUpdateVisibleRange() {
         m_lastVisibleStart = firstVisible;
         m_lastVisibleEnd = lastVisible;
 
-        // 更新模型的视口范围（用于懒加载）
-        thumbnailModel->setViewportRange(firstVisible, lastVisible,
-                                         m_preloadMargin);
-
-        // 请求可见范围的缩略图
-        for (int i = firstVisible; i <= lastVisible; ++i) {
-            QModelIndex index = thumbnailModel->index(i, 0);
-            if (index.isValid()) {
-                thumbnailModel->requestThumbnail(i);
+        // 快速滑动期间只跟踪范围，不触发生成
+        if (!m_fastScrolling) {
+            // 更新模型的视口范围（用于懒加载）
+            thumbnailModel->setViewportRange(firstVisible, lastVisible,
+                                             m_preloadMargin);
+
+            // 请求可见范围的缩略图
+            for (int i = firstVisible; i <= lastVisible; ++i) {
+                QModelIndex index = thumbnailModel->index(i, 0);
+                if (index.isValid()) {
+                    thumbnailModel->requestThumbnail(i);
+                }
             }
         }
     }
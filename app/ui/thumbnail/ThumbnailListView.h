@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QAction>
+#include <QElapsedTimer>
 #include <QGraphicsOpacityEffect>
 #include <QListView>
 #include <QMenu>
@@ -117,6 +118,7 @@ private slots:
     void onScrollAnimationFinished();
     void onPreloadTimer();
     void onFadeInTimer();
+    void onScrollSettled();
     void updateVisibleRange();
     void scheduleViewportUpdate();
     void optimizedUpdateVisibleRange();
@@ -181,6 +183,13 @@ private:
     QPair<int, int> m_visibleRange;
     bool m_isScrolling;
 
+    // 滚动速度自适应降质：快速滑动时暂停缩略图生成、
+    // 委托切换到占位绘制，停下后一次性补齐可见范围
+    QElapsedTimer m_scrollVelocityTimer;
+    double m_scrollVelocity;
+    bool m_fastScrolling;
+    QTimer* m_scrollSettleTimer;
+
     // 性能优化
     QTimer* m_viewportUpdateTimer;
     bool m_viewportUpdatePending;
@@ -211,4 +220,6 @@ private:
     static constexpr int FADE_IN_DURATION = 150;           // ms
     static constexpr int FADE_IN_TIMER_INTERVAL = 50;      // ms
     static constexpr int SMOOTH_SCROLL_STEP = 120;  // pixels per wheel step
+    static constexpr double FAST_SCROLL_VELOCITY = 1500.0;  // px/s 降质阈值
+    static constexpr int SCROLL_SETTLE_MS = 150;  // 停止滚动判定时间
 };
@@ -8,11 +8,62 @@
 #include <QParallelAnimationGroup>
 #include <QPixmap>
 #include <QPoint>
+#include <QPointer>
 #include <QPropertyAnimation>
 #include <QSequentialAnimationGroup>
 #include <QTimer>
+#include <QVariantAnimation>
 #include <QWidget>
 #include <cmath>
+#include <memory>
+#include "../../managers/RenderScheduler.h"
+#include "PDFViewer.h"
+
+// AnimationBudget Implementation
+AnimationBudget& AnimationBudget::instance() {
+    static AnimationBudget budget;
+    return budget;
+}
+
+AnimationBudget::AnimationBudget()
+    : m_avgOverrun(0.0), m_lowFrameRate(false), m_retryAtMs(0) {
+    m_clock.start();
+}
+
+bool AnimationBudget::decorationsAllowed() {
+    if (m_lowFrameRate) {
+        if (m_clock.elapsed() < m_retryAtMs) {
+            return false;
+        }
+        // Cooldown over: re-enable and let fresh measurements decide
+        m_lowFrameRate = false;
+        m_avgOverrun = 0.0;
+    }
+
+    // Any in-flight pool work (visible-page renders, prerenders, search
+    // shards, thumbnails) outranks decoration
+    return RenderScheduler::instance().activeThreadCount() == 0;
+}
+
+void AnimationBudget::reportFrameInterval(qint64 actualMs, qint64 expectedMs) {
+    if (expectedMs <= 0) {
+        return;
+    }
+    const double ratio =
+        static_cast<double>(actualMs) / static_cast<double>(expectedMs);
+    // A very large gap means the animation was paused or throttled, not
+    // that painting is slow; don't let it poison the average
+    if (ratio >= 10.0) {
+        return;
+    }
+    m_avgOverrun =
+        m_avgOverrun == 0.0 ? ratio : m_avgOverrun * 0.8 + ratio * 0.2;
+    if (m_avgOverrun > OVERRUN_LATCH_RATIO) {
+        m_lowFrameRate = true;
+        m_retryAtMs = m_clock.elapsed() + LOW_FPS_RETRY_MS;
+        m_avgOverrun = 0.0;
+    }
+}
 
 // PDFAnimationManager Implementation
 PDFAnimationManager::PDFAnimationManager(QObject* parent)
@@ -23,25 +74,64 @@ PDFAnimationManager::PDFAnimationManager(QObject* parent)
 
 PDFAnimationManager::~PDFAnimationManager() { stopAllAnimations(); }
 
-void PDFAnimationManager::animateZoom(QWidget* target, double fromScale,
+void PDFAnimationManager::animateZoom(PDFPageWidget* target, double fromScale,
                                       double toScale, int duration) {
     if (!target)
         return;
 
-    QPropertyAnimation* animation =
-        new QPropertyAnimation(target, "scaleFactor");
-    setupAnimation(animation, duration);
+    // Retarget a zoom already in flight: repeated wheel ticks restart
+    // the animation from the current preview scale instead of stacking
+    if (QVariantAnimation* running = m_zoomAnimations.value(target)) {
+        fromScale = running->currentValue().toDouble();
+        running->stop();  // Deletes itself (DeleteWhenStopped)
+    }
 
+    QVariantAnimation* animation = new QVariantAnimation(this);
+    animation->setDuration(duration > 0 ? duration : m_defaultDuration);
+    animation->setEasingCurve(m_defaultEasing);
     animation->setStartValue(fromScale);
     animation->setEndValue(toScale);
 
-    connect(animation, &QPropertyAnimation::finished, this,
-            &PDFAnimationManager::onAnimationFinished);
+    // Intermediate frames only transform the already-rendered pixmap;
+    // Poppler is not touched until the final scale is committed. Zoom is
+    // functional feedback, never suspended by the budget, but its frame
+    // intervals feed the measurement that gates the decorative effects.
+    QPointer<PDFPageWidget> page(target);
+    auto frameClock = std::make_shared<QElapsedTimer>();
+    connect(animation, &QVariantAnimation::valueChanged, target,
+            [page, frameClock](const QVariant& value) {
+                if (frameClock->isValid()) {
+                    AnimationBudget::instance().reportFrameInterval(
+                        frameClock->elapsed(),
+                        AnimationBudget::ANIMATION_FRAME_MS);
+                }
+                frameClock->restart();
+                if (page) {
+                    page->setPreviewScaleFactor(value.toDouble());
+                }
+            });
+    connect(animation, &QVariantAnimation::finished, target,
+            [page, toScale]() {
+                if (page) {
+                    page->commitScaleFactor(toScale);
+                }
+            });
 
-    m_runningAnimations.append(animation);
-    m_activeAnimations++;
+    m_zoomAnimations.insert(target, animation);
+    // DeleteWhenStopped deletes via deleteLater, so unregister on
+    // destruction and only if the slot still holds this animation (a
+    // retarget may have replaced it before the deletion lands)
+    connect(animation, &QObject::destroyed, this,
+            [this, target, animation]() {
+                if (m_zoomAnimations.value(target) == animation) {
+                    m_zoomAnimations.remove(target);
+                }
+                onAnimationFinished();
+            });
 
-    emit animationStarted(AnimationType::ZoomIn);
+    m_activeAnimations++;
+    emit animationStarted(toScale >= fromScale ? AnimationType::ZoomIn
+                                               : AnimationType::ZoomOut);
     animation->start(QAbstractAnimation::DeleteWhenStopped);
 }
 
@@ -52,6 +142,14 @@ void PDFAnimationManager::animatePageTransition(QWidget* fromPage,
     if (!fromPage || !toPage)
         return;
 
+    // While a render or search is in flight the cross-fade is skipped
+    // and pages swap instantly; the end state is identical
+    if (!AnimationBudget::instance().decorationsAllowed()) {
+        fromPage->hide();
+        toPage->show();
+        return;
+    }
+
     QParallelAnimationGroup* group = new QParallelAnimationGroup(this);
 
     // Fade out current page
@@ -92,6 +190,11 @@ void PDFAnimationManager::animateFadeIn(QWidget* target, int duration) {
     if (!target)
         return;
 
+    if (!AnimationBudget::instance().decorationsAllowed()) {
+        target->show();
+        return;
+    }
+
     QGraphicsOpacityEffect* effect = ensureOpacityEffect(target);
     effect->setOpacity(0.0);
     target->show();
@@ -117,6 +220,11 @@ void PDFAnimationManager::animateFadeOut(QWidget* target, int duration) {
     if (!target)
         return;
 
+    if (!AnimationBudget::instance().decorationsAllowed()) {
+        target->hide();
+        return;
+    }
+
     QGraphicsOpacityEffect* effect = ensureOpacityEffect(target);
 
     QPropertyAnimation* animation = new QPropertyAnimation(effect, "opacity");
@@ -138,7 +246,8 @@ void PDFAnimationManager::animateFadeOut(QWidget* target, int duration) {
 }
 
 void PDFAnimationManager::animateButtonPress(QWidget* button) {
-    if (!button)
+    // Pure decoration: dropped outright when the budget is suspended
+    if (!button || !AnimationBudget::instance().decorationsAllowed())
         return;
 
     QSequentialAnimationGroup* group = new QSequentialAnimationGroup(this);
@@ -165,7 +274,7 @@ void PDFAnimationManager::animateButtonPress(QWidget* button) {
 
 void PDFAnimationManager::animateHighlight(QWidget* target,
                                            const QColor& color) {
-    if (!target)
+    if (!target || !AnimationBudget::instance().decorationsAllowed())
         return;
 
     // Create highlight effect using background color animation
@@ -190,7 +299,7 @@ void PDFAnimationManager::animateHighlight(QWidget* target,
 }
 
 void PDFAnimationManager::animateShake(QWidget* target) {
-    if (!target)
+    if (!target || !AnimationBudget::instance().decorationsAllowed())
         return;
 
     QSequentialAnimationGroup* group = new QSequentialAnimationGroup(this);
@@ -223,6 +332,10 @@ void PDFAnimationManager::stopAllAnimations() {
         }
     }
     m_runningAnimations.clear();
+    const QList<QVariantAnimation*> zoomAnimations = m_zoomAnimations.values();
+    for (QVariantAnimation* animation : zoomAnimations) {
+        animation->stop();  // Self-deletes and unregisters via destroyed()
+    }
     m_activeAnimations = 0;
 }
 
@@ -460,6 +573,18 @@ void PageTransitionWidget::transitionTo(QWidget* newWidget, TransitionType type,
     if (m_isTransitioning || !newWidget)
         return;
 
+    // Budget suspended: swap instantly, no transition frames
+    if (!AnimationBudget::instance().decorationsAllowed()) {
+        newWidget->setParent(this);
+        newWidget->resize(size());
+        m_currentWidget = newWidget;
+        m_currentPixmap = newWidget->grab();
+        update();
+        emit transitionStarted(type);
+        emit transitionFinished();
+        return;
+    }
+
     m_nextWidget = newWidget;
     m_currentTransition = type;
     m_isTransitioning = true;
@@ -498,6 +623,22 @@ void PageTransitionWidget::setupTransition(TransitionType type, int duration) {
     m_transitionAnimation->start();
 }
 
+void PageTransitionWidget::setTransitionProgress(double progress) {
+    if (qFuzzyCompare(m_transitionProgress, progress))
+        return;
+
+    if (m_frameClock.isValid()) {
+        AnimationBudget::instance().reportFrameInterval(
+            m_frameClock.elapsed(), AnimationBudget::ANIMATION_FRAME_MS);
+    }
+    m_frameClock.restart();
+
+    m_transitionProgress = progress;
+    // Slides, fades and zooms move or blend the entire content, so the
+    // damage rectangle is legitimately the whole widget here
+    update();
+}
+
 void PageTransitionWidget::onTransitionFinished() {
     m_isTransitioning = false;
     m_currentWidget = m_nextWidget;
@@ -596,7 +737,8 @@ LoadingAnimationWidget::LoadingAnimationWidget(QWidget* parent)
       m_size(32),
       m_angle(0),
       m_frame(0),
-      m_timer(nullptr) {
+      m_timer(nullptr),
+      m_throttledTicks(0) {
     setFixedSize(m_size, m_size);
 }
 
@@ -604,12 +746,31 @@ void LoadingAnimationWidget::startAnimation() {
     if (!m_timer) {
         m_timer = new QTimer(this);
         connect(m_timer, &QTimer::timeout, [this]() {
+            AnimationBudget& budget = AnimationBudget::instance();
+            if (m_tickClock.isValid()) {
+                budget.reportFrameInterval(m_tickClock.elapsed(),
+                                           m_timer->interval());
+            }
+            m_tickClock.restart();
+
+            // The indicator is feedback rather than pure decoration, so
+            // under a suspended budget it degrades to every fourth
+            // frame instead of freezing
+            if (!budget.decorationsAllowed()) {
+                if (++m_throttledTicks % 4 != 0) {
+                    return;
+                }
+            } else {
+                m_throttledTicks = 0;
+            }
+
             m_angle = (m_angle + 30) % 360;
             m_frame = (m_frame + 1) % 8;
-            update();
+            update(indicatorRect());
         });
     }
 
+    m_tickClock.invalidate();
     m_timer->start(100);  // 100ms interval
 }
 
@@ -711,6 +872,16 @@ void LoadingAnimationWidget::paintPulse(QPainter& painter) {
     painter.drawEllipse(x, y, size, size);
 }
 
+QRect LoadingAnimationWidget::indicatorRect() const {
+    // Damage rectangle: every indicator style paints inside a centered
+    // square of side m_size (the widest is the rotated spinner arc at
+    // m_size/2 * sqrt(2) plus pen width). Repainting only this square
+    // keeps per-frame damage small when a layout stretches the widget.
+    QRect damage(0, 0, m_size, m_size);
+    damage.moveCenter(rect().center());
+    return damage.intersected(rect());
+}
+
 void LoadingAnimationWidget::timerEvent(QTimerEvent* event) {
     Q_UNUSED(event);
     // Timer events are handled by QTimer::timeout signal
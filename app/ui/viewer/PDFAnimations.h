@@ -2,8 +2,10 @@
 
 #include <QColor>
 #include <QEasingCurve>
+#include <QElapsedTimer>
 #include <QGraphicsBlurEffect>
 #include <QGraphicsOpacityEffect>
+#include <QHash>
 #include <QLabel>
 #include <QList>
 #include <QObject>
@@ -14,11 +16,57 @@
 #include <QPropertyAnimation>
 #include <QSequentialAnimationGroup>
 #include <QTimer>
+#include <QVariantAnimation>
 #include <QWidget>
 #include <QtCore>
 #include <QtGui>
 #include <QtWidgets>
 
+class PDFPageWidget;
+
+/**
+ * Process-wide frame budget for decorative animations.
+ *
+ * Decorations (loading indicators, page-transition effects, button
+ * feedback) must never steal time from page rendering or search. The
+ * budget suspends them while the shared render pool has work in flight
+ * and latches them off when measured frame intervals show the machine
+ * cannot keep up, retrying after a cooldown.
+ *
+ * GUI-thread only: every caller is an animation tick or a paint path.
+ */
+class AnimationBudget {
+public:
+    static AnimationBudget& instance();
+
+    // Expected interval of property-animation frames, for
+    // reportFrameInterval() callers driven by the animation framework
+    static constexpr qint64 ANIMATION_FRAME_MS = 17;
+
+    // True when decorative effects may run this frame. Callers skip or
+    // bypass their animation when this is false; nothing is torn down,
+    // so effects resume seamlessly once the budget clears.
+    bool decorationsAllowed();
+
+    // Feed the frame-rate measurement from an animation tick. When
+    // actual intervals consistently overrun the expected interval the
+    // low-frame-rate latch disables decorations for a cooldown period.
+    void reportFrameInterval(qint64 actualMs, qint64 expectedMs);
+
+private:
+    AnimationBudget();
+
+    // Latch decorations off when frames take over 2.5x their budget on
+    // average, i.e. the effect runs below 40% of its target rate
+    static constexpr double OVERRUN_LATCH_RATIO = 2.5;
+    static constexpr qint64 LOW_FPS_RETRY_MS = 5000;
+
+    QElapsedTimer m_clock;
+    double m_avgOverrun;  // EMA of actual/expected frame interval
+    bool m_lowFrameRate;
+    qint64 m_retryAtMs;
+};
+
 /**
  * Animation manager for PDF viewer with smooth transitions and effects
  */
@@ -41,10 +89,15 @@ public:
     explicit PDFAnimationManager(QObject* parent = nullptr);
     ~PDFAnimationManager();
 
-    // Zoom animations
-    void animateZoom(QWidget* target, double fromScale, double toScale,
+    // Zoom animations. Decoupled from rendering: every intermediate
+    // frame is a raster transform of the page's existing pixmap, and a
+    // single full-quality render is requested for the final scale when
+    // the animation finishes, so the animation never waits on Poppler.
+    // A zoom already in flight on the same target is retargeted from
+    // its current preview scale instead of stacking.
+    void animateZoom(PDFPageWidget* target, double fromScale, double toScale,
                      int duration = 300);
-    void animateZoomWithCenter(QWidget* target, double fromScale,
+    void animateZoomWithCenter(PDFPageWidget* target, double fromScale,
                                double toScale, const QPoint& center,
                                int duration = 300);
 
@@ -91,6 +144,8 @@ private:
     QEasingCurve::Type m_defaultEasing;
     int m_activeAnimations;
     QList<QPropertyAnimation*> m_runningAnimations;
+    // One zoom animation per page widget, for retargeting mid-flight
+    QHash<QObject*, QVariantAnimation*> m_zoomAnimations;
 
 signals:
     void animationStarted(AnimationType type);
@@ -140,6 +195,8 @@ signals:
  */
 class PageTransitionWidget : public QWidget {
     Q_OBJECT
+    Q_PROPERTY(double transitionProgress READ transitionProgress WRITE
+                   setTransitionProgress)
 
 public:
     enum class TransitionType {
@@ -164,6 +221,9 @@ public:
     TransitionType currentTransition() const { return m_currentTransition; }
     bool isTransitioning() const { return m_isTransitioning; }
 
+    double transitionProgress() const { return m_transitionProgress; }
+    void setTransitionProgress(double progress);
+
 protected:
     void paintEvent(QPaintEvent* event) override;
     void resizeEvent(QResizeEvent* event) override;
@@ -184,6 +244,7 @@ private:
 
     QPropertyAnimation* m_transitionAnimation;
     double m_transitionProgress;
+    QElapsedTimer m_frameClock;  // Measures intervals between frames
 
     QPixmap m_currentPixmap;
     QPixmap m_nextPixmap;
@@ -222,6 +283,7 @@ private:
     void paintBars(QPainter& painter);
     void paintRing(QPainter& painter);
     void paintPulse(QPainter& painter);
+    QRect indicatorRect() const;
 
     LoadingType m_loadingType;
     QColor m_color;
@@ -229,6 +291,8 @@ private:
     int m_angle;
     int m_frame;
     QTimer* m_timer;
+    QElapsedTimer m_tickClock;  // Measures intervals between ticks
+    int m_throttledTicks;       // Counts ticks skipped under suspension
 };
 
 /**
@@ -10,7 +10,7 @@
 #include <QTreeWidgetItemIterator>
 
 // 自定义数据角色
-enum { PageNumberRole = Qt::UserRole + 1, NodePtrRole = Qt::UserRole + 2 };
+enum { PageNumberRole = Qt::UserRole + 1, EntryIndexRole = Qt::UserRole + 2 };
 
 PDFOutlineWidget::PDFOutlineWidget(QWidget* parent)
     : QTreeWidget(parent),
@@ -76,6 +76,8 @@ void PDFOutlineWidget::setupConnections() {
             &PDFOutlineWidget::onItemClicked);
     connect(this, &QTreeWidget::itemDoubleClicked, this,
             &PDFOutlineWidget::onItemDoubleClicked);
+    connect(this, &QTreeWidget::itemExpanded, this,
+            &PDFOutlineWidget::onItemExpanded);
     connect(this, &QTreeWidget::itemSelectionChanged, this,
             &PDFOutlineWidget::onItemSelectionChanged);
 
@@ -138,29 +140,53 @@ void PDFOutlineWidget::buildOutlineTree() {
         return;
     }
 
-    const auto& rootNodes = outlineModel->getRootNodes();
-    addOutlineNodes(nullptr, rootNodes);
+    // 只创建根级项；子项在首次展开时由onItemExpanded物化。
+    // 根级项i对应条目i（层序布局），itemForEntry依赖这一对应关系
+    const int roots = outlineModel->rootEntryCount();
+    for (int i = 0; i < roots; ++i) {
+        createOutlineItem(i, nullptr);
+    }
 
     // 默认展开第一层
     expandToLevel(0);
 }
 
-void PDFOutlineWidget::addOutlineNodes(
-    QTreeWidgetItem* parentItem,
-    const QList<std::shared_ptr<PDFOutlineNode>>& nodes) {
-    for (const auto& node : nodes) {
-        QTreeWidgetItem* item = createOutlineItem(node, parentItem);
-        setItemStyle(item, node);
+void PDFOutlineWidget::materializeChildren(QTreeWidgetItem* item) {
+    if (!outlineModel || !item) {
+        return;
+    }
+
+    const int entryIndex = getItemEntryIndex(item);
+    if (entryIndex < 0 || item->childCount() > 0) {
+        return;  // 无效项或子项已物化
+    }
+
+    const PDFOutlineEntry& entry = outlineModel->entryAt(entryIndex);
+    for (int c = 0; c < entry.childCount; ++c) {
+        createOutlineItem(entry.firstChild + c, item);
+    }
+}
+
+void PDFOutlineWidget::materializeAllBranches() {
+    if (!outlineModel || !outlineModel->hasOutline()) {
+        return;
+    }
 
-        // 递归添加子节点
-        if (node->hasChildren) {
-            addOutlineNodes(item, node->children);
+    QList<QTreeWidgetItem*> worklist;
+    for (int i = 0; i < topLevelItemCount(); ++i) {
+        worklist.append(topLevelItem(i));
+    }
+    while (!worklist.isEmpty()) {
+        QTreeWidgetItem* item = worklist.takeLast();
+        materializeChildren(item);
+        for (int i = 0; i < item->childCount(); ++i) {
+            worklist.append(item->child(i));
         }
     }
 }
 
-QTreeWidgetItem* PDFOutlineWidget::createOutlineItem(
-    const std::shared_ptr<PDFOutlineNode>& node, QTreeWidgetItem* parent) {
+QTreeWidgetItem* PDFOutlineWidget::createOutlineItem(int entryIndex,
+                                                     QTreeWidgetItem* parent) {
     QTreeWidgetItem* item;
     if (parent) {
         item = new QTreeWidgetItem(parent);
@@ -168,24 +194,29 @@ QTreeWidgetItem* PDFOutlineWidget::createOutlineItem(
         item = new QTreeWidgetItem(this);
     }
 
-    item->setText(0, node->title);
-    item->setData(0, PageNumberRole, node->pageNumber);
+    const PDFOutlineEntry& entry = outlineModel->entryAt(entryIndex);
+    item->setText(0, entry.title);
+    item->setData(0, PageNumberRole, entry.pageNumber);
+    item->setData(0, EntryIndexRole, entryIndex);
 
-    // 存储节点指针（用于后续操作）
-    item->setData(0, NodePtrRole, QVariant::fromValue(node.get()));
+    // 有子节点但尚未物化的项也要显示展开箭头
+    if (entry.hasChildren()) {
+        item->setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
+    }
 
+    setItemStyle(item, entry);
     return item;
 }
 
-void PDFOutlineWidget::setItemStyle(
-    QTreeWidgetItem* item, const std::shared_ptr<PDFOutlineNode>& node) {
+void PDFOutlineWidget::setItemStyle(QTreeWidgetItem* item,
+                                    const PDFOutlineEntry& entry) {
     QFont font = item->font(0);
 
     // 根据层级设置字体大小
-    if (node->level == 0) {
+    if (entry.level == 0) {
         font.setBold(true);
         font.setPointSize(font.pointSize() + 1);
-    } else if (node->level == 1) {
+    } else if (entry.level == 1) {
         font.setBold(false);
         font.setPointSize(font.pointSize());
     } else {
@@ -196,14 +227,14 @@ void PDFOutlineWidget::setItemStyle(
     item->setFont(0, font);
 
     // 设置工具提示
-    QString tooltip = node->title;
-    if (node->isValidPageReference()) {
-        tooltip += QString(" (第 %1 页)").arg(node->pageNumber + 1);
+    QString tooltip = entry.title;
+    if (entry.isValidPageReference()) {
+        tooltip += QString(" (第 %1 页)").arg(entry.pageNumber + 1);
     }
     item->setToolTip(0, tooltip);
 
     // 如果没有有效的页面引用，设置为灰色
-    if (!node->isValidPageReference()) {
+    if (!entry.isValidPageReference()) {
         item->setForeground(0, QBrush(QColor(128, 128, 128)));
     }
 }
@@ -232,11 +263,16 @@ void PDFOutlineWidget::onItemDoubleClicked(QTreeWidgetItem* item, int column) {
         return;
 
     // 双击时展开/折叠节点
-    if (item->childCount() > 0) {
+    if (itemHasOutlineChildren(item)) {
         item->setExpanded(!item->isExpanded());
     }
 }
 
+void PDFOutlineWidget::onItemExpanded(QTreeWidgetItem* item) {
+    // 首次展开时物化子项
+    materializeChildren(item);
+}
+
 void PDFOutlineWidget::onItemSelectionChanged() {
     QTreeWidgetItem* current = currentItem();
     if (current) {
@@ -247,6 +283,25 @@ void PDFOutlineWidget::onItemSelectionChanged() {
     }
 }
 
+int PDFOutlineWidget::getItemEntryIndex(QTreeWidgetItem* item) const {
+    if (!item)
+        return -1;
+
+    QVariant data = item->data(0, EntryIndexRole);
+    if (!data.isValid())
+        return -1;
+    return data.toInt();
+}
+
+bool PDFOutlineWidget::itemHasOutlineChildren(QTreeWidgetItem* item) const {
+    if (item && item->childCount() > 0) {
+        return true;
+    }
+    const int entryIndex = getItemEntryIndex(item);
+    return outlineModel && entryIndex >= 0 &&
+           outlineModel->entryAt(entryIndex).hasChildren();
+}
+
 int PDFOutlineWidget::getItemPageNumber(QTreeWidgetItem* item) const {
     if (!item)
         return -1;
@@ -261,28 +316,87 @@ int PDFOutlineWidget::getCurrentSelectedPage() const {
 }
 
 void PDFOutlineWidget::highlightPageItem(int pageNumber) {
-    QTreeWidgetItem* item = findItemByPage(pageNumber);
+    if (!outlineModel) {
+        return;
+    }
+
+    // 在模型索引上定位条目，再沿祖先链物化出对应的项；
+    // 不需要整棵树都已创建
+    const int entryIndex = outlineModel->findEntryByPage(pageNumber);
+    if (entryIndex < 0) {
+        return;
+    }
+
+    QTreeWidgetItem* item = itemForEntry(entryIndex);
     if (item) {
         highlightItem(item);
         scrollToItem(item);
     }
 }
 
-void PDFOutlineWidget::expandAll() { QTreeWidget::expandAll(); }
+QTreeWidgetItem* PDFOutlineWidget::itemForEntry(int entryIndex) {
+    if (!outlineModel || entryIndex < 0 ||
+        entryIndex >= outlineModel->entryCount()) {
+        return nullptr;
+    }
+
+    // 自底向上收集祖先链（根在前）
+    QList<int> chain;
+    for (int index = entryIndex; index >= 0;
+         index = outlineModel->entryAt(index).parent) {
+        chain.prepend(index);
+    }
+
+    // 根级项i即条目i；向下逐层物化并按区间偏移定位子项
+    if (chain.first() >= topLevelItemCount()) {
+        return nullptr;
+    }
+    QTreeWidgetItem* item = topLevelItem(chain.first());
+    for (int i = 1; i < chain.size(); ++i) {
+        materializeChildren(item);
+        const PDFOutlineEntry& parentEntry =
+            outlineModel->entryAt(chain.at(i - 1));
+        const int position = chain.at(i) - parentEntry.firstChild;
+        if (position < 0 || position >= item->childCount()) {
+            return nullptr;
+        }
+        item = item->child(position);
+    }
+    return item;
+}
+
+void PDFOutlineWidget::expandAll() {
+    // 展开全部需要整棵树存在；代价只在用户明确要求时支付
+    materializeAllBranches();
+    QTreeWidget::expandAll();
+}
 
 void PDFOutlineWidget::collapseAll() { QTreeWidget::collapseAll(); }
 
 void PDFOutlineWidget::expandToLevel(int level) {
     collapseAll();
 
-    QTreeWidgetItemIterator it(this);
-    while (*it) {
-        auto node = static_cast<PDFOutlineNode*>(
-            (*it)->data(0, NodePtrRole).value<void*>());
-        if (node && node->level <= level) {
-            (*it)->setExpanded(true);
+    if (!outlineModel) {
+        return;
+    }
+
+    // 逐层下行：展开一个项会物化其子项，下一轮才能继续深入
+    QList<QTreeWidgetItem*> worklist;
+    for (int i = 0; i < topLevelItemCount(); ++i) {
+        worklist.append(topLevelItem(i));
+    }
+    while (!worklist.isEmpty()) {
+        QTreeWidgetItem* item = worklist.takeLast();
+        const int entryIndex = getItemEntryIndex(item);
+        if (entryIndex < 0 ||
+            outlineModel->entryAt(entryIndex).level > level) {
+            continue;
+        }
+        materializeChildren(item);
+        item->setExpanded(true);
+        for (int i = 0; i < item->childCount(); ++i) {
+            worklist.append(item->child(i));
         }
-        ++it;
     }
 }
 
@@ -297,6 +411,9 @@ void PDFOutlineWidget::searchItems(const QString& searchText) {
         return;
     }
 
+    // 搜索要覆盖整个目录，先物化全部分支
+    materializeAllBranches();
+
     // 隐藏所有项目，然后显示匹配的项目
     QTreeWidgetItemIterator it(this);
     while (*it) {
@@ -309,27 +426,6 @@ void PDFOutlineWidget::searchItems(const QString& searchText) {
     searchItemsRecursive(invisibleRootItem(), searchText, found);
 }
 
-QTreeWidgetItem* PDFOutlineWidget::findItemByPage(int pageNumber,
-                                                  QTreeWidgetItem* parent) {
-    if (!parent) {
-        parent = invisibleRootItem();
-    }
-
-    for (int i = 0; i < parent->childCount(); ++i) {
-        QTreeWidgetItem* child = parent->child(i);
-        if (getItemPageNumber(child) == pageNumber) {
-            return child;
-        }
-
-        QTreeWidgetItem* found = findItemByPage(pageNumber, child);
-        if (found) {
-            return found;
-        }
-    }
-
-    return nullptr;
-}
-
 void PDFOutlineWidget::highlightItem(QTreeWidgetItem* item) {
     clearHighlight();
 
@@ -388,7 +484,7 @@ void PDFOutlineWidget::keyPressEvent(QKeyEvent* event) {
             }
             break;
         case Qt::Key_Space:
-            if (currentItem() && currentItem()->childCount() > 0) {
+            if (currentItem() && itemHasOutlineChildren(currentItem())) {
                 currentItem()->setExpanded(!currentItem()->isExpanded());
             }
             break;
@@ -10,7 +10,6 @@
 #include <QStringList>
 #include <QTreeWidget>
 #include <QTreeWidgetItem>
-#include <memory>
 #include "../../model/PDFOutlineModel.h"
 
 class PDFOutlineWidget : public QTreeWidget {
@@ -62,6 +61,7 @@ protected:
 private slots:
     void onItemClicked(QTreeWidgetItem* item, int column);
     void onItemDoubleClicked(QTreeWidgetItem* item, int column);
+    void onItemExpanded(QTreeWidgetItem* item);
     void onItemSelectionChanged();
     void onExpandAllRequested();
     void onCollapseAllRequested();
@@ -80,23 +80,31 @@ private:
     void setupContextMenu();
     void setupConnections();
 
-    // 构建目录树
+    // 构建目录树。惰性物化：打开时只创建根级项，子项在首次展开
+    // 时才创建，5万条目的目录打开耗时只取决于根级条目数
     void buildOutlineTree();
-    void addOutlineNodes(QTreeWidgetItem* parentItem,
-                         const QList<std::shared_ptr<PDFOutlineNode>>& nodes);
+
+    // 为指定项创建其子项（已物化则不重复创建）
+    void materializeChildren(QTreeWidgetItem* item);
+
+    // 物化全部分支（展开全部、全文搜索前调用）
+    void materializeAllBranches();
 
     // 创建目录项
-    QTreeWidgetItem* createOutlineItem(
-        const std::shared_ptr<PDFOutlineNode>& node,
-        QTreeWidgetItem* parent = nullptr);
+    QTreeWidgetItem* createOutlineItem(int entryIndex,
+                                       QTreeWidgetItem* parent = nullptr);
 
     // 设置项目样式
-    void setItemStyle(QTreeWidgetItem* item,
-                      const std::shared_ptr<PDFOutlineNode>& node);
+    void setItemStyle(QTreeWidgetItem* item, const PDFOutlineEntry& entry);
+
+    // 获取项目对应的条目下标（-1表示无效，如空状态占位项）
+    int getItemEntryIndex(QTreeWidgetItem* item) const;
 
-    // 查找包含指定页面的项目
-    QTreeWidgetItem* findItemByPage(int pageNumber,
-                                    QTreeWidgetItem* parent = nullptr);
+    // 检查项目对应的条目是否有子节点（子项可能尚未物化）
+    bool itemHasOutlineChildren(QTreeWidgetItem* item) const;
+
+    // 定位条目对应的项，沿途物化其祖先分支
+    QTreeWidgetItem* itemForEntry(int entryIndex);
 
     // 高亮项目
     void highlightItem(QTreeWidgetItem* item);
@@ -108,12 +116,4 @@ private:
     // 递归搜索项目
     void searchItemsRecursive(QTreeWidgetItem* item, const QString& searchText,
                               bool& found);
-
-    // 保存和恢复展开状态
-    void saveExpandedState();
-    void restoreExpandedState();
-    QStringList getExpandedItems(QTreeWidgetItem* parent = nullptr) const;
-    void setExpandedItems(const QStringList& expandedPaths,
-                          QTreeWidgetItem* parent = nullptr);
-    QString getItemPath(QTreeWidgetItem* item) const;
 };
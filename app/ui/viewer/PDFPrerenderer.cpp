@@ -1,20 +1,38 @@
 #include "PDFPrerenderer.h"
 #include <QApplication>
+#include <QPointer>
 #include <QDateTime>
 #include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QMutexLocker>
+#include <QStandardPaths>
 #include <QThread>
-#include <QTimer>
 #include <QtCore>
 #include <QtGui>
 #include <QtWidgets>
 #include <algorithm>
 #include <cmath>
+#include "cache/PDFCacheManager.h"
+#include "managers/DocumentQuarantine.h"
+#include "managers/HeartbeatService.h"
+#include "managers/IdleWorkScheduler.h"
+#include "managers/MemoryGovernor.h"
+#include "managers/PageCostModel.h"
+#include "managers/RenderBroker.h"
+#include "managers/RenderScheduler.h"
+#include "model/PageClassifier.h"
+#include "utils/PerfTracer.h"
+#include "utils/RenderPolicy.h"
 
 // PDFPrerenderer Implementation
 PDFPrerenderer::PDFPrerenderer(QObject* parent)
     : QObject(parent),
       m_document(nullptr),
+      m_renderHelper(nullptr),
       m_strategy(PrerenderStrategy::Balanced),
       m_maxWorkerThreads(QThread::idealThreadCount()),
       m_maxCacheSize(100),
@@ -25,45 +43,129 @@ PDFPrerenderer::PDFPrerenderer(QObject* parent)
       m_currentMemoryUsage(0),
       m_cacheHits(0),
       m_cacheMisses(0),
-      m_prerenderRange(3) {
-    // Setup adaptive analysis timer
-    m_adaptiveTimer = new QTimer(this);
-    m_adaptiveTimer->setInterval(30000);  // 30 seconds
-    connect(m_adaptiveTimer, &QTimer::timeout, this,
-            &PDFPrerenderer::onAdaptiveAnalysis);
+      m_prerenderRange(2) {  // Balanced seed; retuned against live stats
+    // Low-memory profile: speculative work is the first thing to shrink.
+    // Only the immediate neighbours get prerendered
+    if (RenderPolicy::lowMemoryProfile()) {
+        m_prerenderRange = 1;
+    }
 
     setupWorkerThreads();
+
+    // The watchdog runs for the object's whole life: renders can be in
+    // flight whenever a document is set, not only between start/stop.
+    // Riding the shared heartbeat instead of a private QTimer keeps the
+    // 5s scan off its own event-loop wakeup
+    QPointer<PDFPrerenderer> self(this);
+    m_watchdogHeartbeatId = HeartbeatService::instance().registerPeriodic(
+        "prerender-watchdog", WATCHDOG_INTERVAL_MS, [self]() {
+            if (self) {
+                self->onWatchdogScan();
+            }
+        });
+
+    // Register with the global governor; m_maxMemoryUsage becomes this
+    // cache's share of the process-wide budget
+    m_governorId = MemoryGovernor::instance().registerConsumer(
+        "prerender", [this]() { return m_currentMemoryUsage; },
+        [this]() { return cacheHitRatio(); },
+        [this](qint64 budget) { setMaxMemoryUsage(budget); },
+        [this]() {
+            clearPrerenderQueue();
+            m_cache.clear();
+            m_currentMemoryUsage = 0;
+            emit memoryUsageChanged(m_currentMemoryUsage);
+            emit cacheUpdated();
+        });
 }
 
 PDFPrerenderer::~PDFPrerenderer() {
+    HeartbeatService::instance().unregister(m_watchdogHeartbeatId);
+    MemoryGovernor::instance().unregisterConsumer(m_governorId);
+    savePatterns();
     stopPrerendering();
     cleanupWorkerThreads();
 }
 
 void PDFPrerenderer::setDocument(Poppler::Document* document) {
-    QMutexLocker locker(&m_queueMutex);
+    {
+        QMutexLocker locker(&m_queueMutex);
 
-    m_document = document;
+        m_document = document;
 
-    // Configure document for optimal rendering
-    if (m_document) {
-        m_document->setRenderHint(Poppler::Document::Antialiasing, true);
-        m_document->setRenderHint(Poppler::Document::TextAntialiasing, true);
-        m_document->setRenderHint(Poppler::Document::TextHinting, true);
+        // Configure document for optimal rendering
+        if (m_document) {
+            m_document->setRenderHint(Poppler::Document::Antialiasing, true);
+            m_document->setRenderHint(Poppler::Document::TextAntialiasing,
+                                      true);
+            m_document->setRenderHint(Poppler::Document::TextHinting, true);
+        }
+
+        // Update render helper
+        if (m_renderHelper) {
+            m_renderHelper->setDocument(document);
+        }
+
+        // Clear cache when document changes
+        m_cache.clear();
+        m_currentMemoryUsage = 0;
+
+        // Quarantine keys carry no document identity, so a new document
+        // starts with a clean slate. In-flight entries are kept: their
+        // renders belong to the old document and remove themselves (or
+        // stay parked as abandoned) when they return
+        m_quarantined.clear();
     }
 
-    // Update workers
-    for (PDFRenderWorker* worker : m_workers) {
-        worker->setDocument(document);
+    // Reloaded pattern state can seed the queue right away
+    if (m_document && !m_documentHash.isEmpty()) {
+        warmQueueFromPatterns();
     }
+}
+
+void PDFPrerenderer::setDocumentIdentifier(const QString& documentHash) {
+    if (documentHash == m_documentHash) {
+        return;
+    }
+
+    // Persist what the outgoing document taught us before switching
+    savePatterns();
+
+    m_documentHash = documentHash;
+    m_pageViewTimes.clear();
+    m_navigationPatterns.clear();
+    loadPatterns();
 
-    // Clear cache when document changes
-    m_cache.clear();
-    m_currentMemoryUsage = 0;
+    // Pages that blew the render deadline in an earlier session are
+    // known-bad from the start, not after re-wedging a worker thread
+    {
+        QMutexLocker locker(&m_queueMutex);
+        m_persistentBadPages =
+            DocumentQuarantine::instance().quarantinedPages(documentHash);
+    }
+
+    if (m_document) {
+        warmQueueFromPatterns();
+    }
 }
 
 void PDFPrerenderer::setStrategy(PrerenderStrategy strategy) {
     m_strategy = strategy;
+    // The enum seeds the lookahead; tunePrerenderRange() takes it from
+    // here. Low-memory profiles stay pinned at ±1 regardless
+    if (!RenderPolicy::lowMemoryProfile()) {
+        switch (strategy) {
+            case PrerenderStrategy::Conservative:
+                m_prerenderRange = 1;
+                break;
+            case PrerenderStrategy::Balanced:
+                m_prerenderRange = 2;
+                break;
+            case PrerenderStrategy::Aggressive:
+                m_prerenderRange = 5;
+                break;
+        }
+    }
 }
 
 void PDFPrerenderer::requestPrerender(int pageNumber, double scaleFactor,
@@ -72,14 +174,24 @@ void PDFPrerenderer::requestPrerender(int pageNumber, double scaleFactor,
         return;
     }
 
-    // Check if already cached
+    // Check if already cached, exactly or derivably: a request we can
+    // serve by transforming an existing render needs no Poppler pass
     QString cacheKey = getCacheKey(pageNumber, scaleFactor, rotation);
-    if (m_cache.contains(cacheKey)) {
+    if (m_cache.contains(cacheKey) ||
+        !findDerivableKey(pageNumber, scaleFactor).isEmpty()) {
         return;
     }
 
     QMutexLocker locker(&m_queueMutex);
 
+    // A page that previously blew the render deadline is pathological;
+    // re-rendering it would only wedge another worker thread. The
+    // persistent set covers hangs recorded in earlier sessions
+    if (m_quarantined.contains(cacheKey) ||
+        m_persistentBadPages.contains(pageNumber)) {
+        return;
+    }
+
     // Check if already in queue
     for (const RenderRequest& req : m_renderQueue) {
         if (req.pageNumber == pageNumber &&
@@ -97,11 +209,159 @@ void PDFPrerenderer::requestPrerender(int pageNumber, double scaleFactor,
     request.timestamp = QDateTime::currentMSecsSinceEpoch();
 
     m_renderQueue.enqueue(request);
-    m_queueCondition.wakeOne();
+
+    // Visible-page work (priority <= 1) must never wait behind queued
+    // thumbnails, so submit it under the scheduler's top class
+    RenderScheduler::TaskClass taskClass =
+        priority <= 1 ? RenderScheduler::TaskClass::VisiblePage
+                      : RenderScheduler::TaskClass::AdjacentPrerender;
+
+    // Route through the broker: if the viewer's sharp pass is already
+    // rendering this exact (page, scale, rotation) we attach to that
+    // render instead of running Poppler a second time, and the result
+    // still lands in the prerender cache exactly once.
+    RenderBroker::RenderKey key =
+        RenderBroker::makeKey(m_document, pageNumber, scaleFactor, rotation);
+
+    QPointer<PDFPrerenderer> self(this);
+    PDFRenderWorker* helper = m_renderHelper;
+    RenderBroker::instance().request(
+        key, taskClass,
+        [self, helper, request]() -> QImage {
+            if (!self || !helper || !self->m_isRunning || self->m_isPaused ||
+                request.token.isCancelled()) {
+                return QImage();
+            }
+            // Bracket the Poppler call so the watchdog can see how long
+            // this render has been inside the library
+            self->noteRenderStarted(request);
+            QImage image = helper->renderNow(request);
+            self->noteRenderFinished(request);
+            return image;
+        },
+        this,
+        [self, request](const QImage& image) {
+            if (!self) {
+                return;
+            }
+            // Drop the queue entry even on failure, otherwise a bailed
+            // job blocks any later request for the same page as
+            // "already queued"
+            QMutexLocker locker(&self->m_queueMutex);
+            self->m_renderQueue.removeOne(request);
+            locker.unlock();
+            if (!image.isNull()) {
+                self->onRenderCompleted(request.pageNumber, image,
+                                        request.scaleFactor, request.rotation);
+            }
+        });
+}
+
+void PDFPrerenderer::cancelPrerenderingForPage(int pageNumber) {
+    // Queue entries stay in m_renderQueue until their completion callback
+    // removes them, so this reaches queued and in-flight work alike; an
+    // in-flight render aborts at Poppler's next abort-callback poll
+    QMutexLocker locker(&m_queueMutex);
+    for (RenderRequest& request : m_renderQueue) {
+        if (request.pageNumber == pageNumber) {
+            request.token.cancel();
+        }
+    }
 }
 
-QPixmap PDFPrerenderer::getCachedPage(int pageNumber, double scaleFactor,
-                                      int rotation) {
+void PDFPrerenderer::clearPrerenderQueue() {
+    QMutexLocker locker(&m_queueMutex);
+    for (RenderRequest& request : m_renderQueue) {
+        request.token.cancel();
+    }
+    m_renderQueue.clear();
+}
+
+void PDFPrerenderer::noteRenderStarted(const RenderRequest& request) {
+    QMutexLocker locker(&m_queueMutex);
+    InFlightRender entry;
+    entry.request = request;
+    entry.startedMs = QDateTime::currentMSecsSinceEpoch();
+    // Same key the broker submitted under, so a later compensation call
+    // reaches the node pool this job actually runs on
+    entry.affinityKey =
+        static_cast<quint64>(reinterpret_cast<quintptr>(m_document));
+    m_inFlight.insert(
+        getCacheKey(request.pageNumber, request.scaleFactor, request.rotation),
+        entry);
+}
+
+void PDFPrerenderer::noteRenderFinished(const RenderRequest& request) {
+    const QString key =
+        getCacheKey(request.pageNumber, request.scaleFactor, request.rotation);
+    bool abandoned = false;
+    quint64 affinityKey = 0;
+    {
+        QMutexLocker locker(&m_queueMutex);
+        auto it = m_inFlight.constFind(key);
+        if (it == m_inFlight.constEnd()) {
+            return;
+        }
+        abandoned = it->abandoned;
+        affinityKey = it->affinityKey;
+        m_inFlight.erase(it);
+    }
+    // The watchdog gave the pool an extra slot for the thread this job
+    // was presumed to be wedging; the job came back after all, so take
+    // the slot away again before the pool oversubscribes the CPU
+    if (abandoned) {
+        RenderScheduler::instance().restoreCompensatedWorker(affinityKey);
+    }
+}
+
+void PDFPrerenderer::onWatchdogScan() {
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QList<quint64> compensate;
+    QList<int> hungPages;
+    QString documentHash;
+    {
+        QMutexLocker locker(&m_queueMutex);
+        documentHash = m_documentHash;
+        for (auto it = m_inFlight.begin(); it != m_inFlight.end(); ++it) {
+            if (it->abandoned || now - it->startedMs < RENDER_DEADLINE_MS) {
+                continue;
+            }
+            // Past the deadline: abandon the render. The cancel reaches
+            // Poppler's abort callback and ends most hangs at the next
+            // poll; a render that never polls keeps its thread, which is
+            // why the scheduler hands the pool a replacement slot either
+            // way. The queue itself needs no redistribution — pending
+            // entries were never bound to the wedged thread and other
+            // pool workers keep draining them
+            it->abandoned = true;
+            it->request.token.cancel();
+            m_quarantined.insert(it.key());
+            m_persistentBadPages.insert(it->request.pageNumber);
+            m_renderQueue.removeOne(it->request);
+            compensate.append(it->affinityKey);
+            hungPages.append(it->request.pageNumber);
+            qWarning() << "PDFPrerenderer: render of page"
+                       << it->request.pageNumber << "(scale"
+                       << it->request.scaleFactor << ", rotation"
+                       << it->request.rotation << ") exceeded"
+                       << RENDER_DEADLINE_MS
+                       << "ms; abandoned and quarantined";
+        }
+    }
+    // Pool calls outside the lock: nothing in the scheduler needs our
+    // queue state, and keeping the critical section short matters more
+    for (quint64 key : compensate) {
+        RenderScheduler::instance().compensateHungWorker(key);
+    }
+    // Registry writes also stay outside the lock: recording a hang
+    // syncs the quarantine file to disk
+    for (int page : hungPages) {
+        DocumentQuarantine::instance().recordPageHang(documentHash, page);
+    }
+}
+
+QImage PDFPrerenderer::getCachedPage(int pageNumber, double scaleFactor,
+                                     int rotation) {
     QString cacheKey = getCacheKey(pageNumber, scaleFactor, rotation);
 
     if (m_cache.contains(cacheKey)) {
@@ -109,17 +369,81 @@ QPixmap PDFPrerenderer::getCachedPage(int pageNumber, double scaleFactor,
         item.timestamp = QDateTime::currentMSecsSinceEpoch();
         item.accessCount++;
         m_cacheHits++;
-        return item.pixmap;
+        // Implicit sharing: this is a refcount bump, not a buffer copy
+        return item.image;
+    }
+
+    // Derive from a canonical higher-resolution render: rotation deltas
+    // are a cheap transform, nearby scales a high-quality downscale.
+    // Zoom-slider notches and 90° rotations hit this path instead of
+    // going back to Poppler
+    QString sourceKey = findDerivableKey(pageNumber, scaleFactor);
+    if (!sourceKey.isEmpty()) {
+        CacheItem& source = m_cache[sourceKey];
+        source.timestamp = QDateTime::currentMSecsSinceEpoch();
+        source.accessCount++;
+
+        QImage derived = source.image;
+        int rotationDelta = ((rotation - source.rotation) % 360 + 360) % 360;
+        if (rotationDelta != 0) {
+            derived = derived.transformed(QTransform().rotate(rotationDelta));
+        }
+        double ratio = scaleFactor / source.scaleFactor;
+        if (qAbs(ratio - 1.0) > 0.001) {
+            derived = derived.scaled(derived.size() * ratio,
+                                     Qt::KeepAspectRatio,
+                                     Qt::SmoothTransformation);
+        }
+
+        // Cache under the exact key so repeated paints at this zoom
+        // notch are a plain hit
+        insertCacheItem(cacheKey, derived, pageNumber, scaleFactor, rotation);
+        m_cacheHits++;
+        return derived;
     }
 
     m_cacheMisses++;
-    return QPixmap();
+    return QImage();
 }
 
 bool PDFPrerenderer::hasPrerenderedPage(int pageNumber, double scaleFactor,
                                         int rotation) {
     QString cacheKey = getCacheKey(pageNumber, scaleFactor, rotation);
-    return m_cache.contains(cacheKey);
+    return m_cache.contains(cacheKey) ||
+           !findDerivableKey(pageNumber, scaleFactor).isEmpty();
+}
+
+QString PDFPrerenderer::findDerivableKey(int pageNumber,
+                                         double scaleFactor) const {
+    if (m_derivedQualityThreshold >= 1.0) {
+        return QString();  // Derived serving disabled
+    }
+
+    // Prefer the candidate closest to the requested scale: the less we
+    // downscale, the cheaper the transform and the sharper the result
+    QString bestKey;
+    double bestRatio = 0.0;
+    for (auto it = m_cache.constBegin(); it != m_cache.constEnd(); ++it) {
+        if (it->pageNumber != pageNumber) {
+            continue;
+        }
+        double ratio = scaleFactor / it->scaleFactor;
+        // Only downscale from a higher-resolution master; upscaling
+        // would show interpolation blur at exactly the moment the user
+        // zooms in for detail
+        if (ratio > 1.001 || ratio < m_derivedQualityThreshold) {
+            continue;
+        }
+        if (ratio > bestRatio) {
+            bestRatio = ratio;
+            bestKey = it.key();
+        }
+    }
+    return bestKey;
+}
+
+void PDFPrerenderer::setDerivedQualityThreshold(double ratio) {
+    m_derivedQualityThreshold = qBound(0.1, ratio, 1.0);
 }
 
 void PDFPrerenderer::startPrerendering() {
@@ -129,15 +453,23 @@ void PDFPrerenderer::startPrerendering() {
     m_isRunning = true;
     m_isPaused = false;
 
-    // Start worker threads
-    for (QThread* thread : m_workerThreads) {
-        if (!thread->isRunning()) {
-            thread->start();
-        }
-    }
-
-    // Start adaptive analysis
-    m_adaptiveTimer->start();
+    // Adaptive analysis runs under the idle orchestrator instead of a
+    // private 30s timer, so it never lands mid page-flip. Pattern state
+    // lives on this object's thread, so the step just queues the
+    // analysis back here — the orchestrator's contribution is the idle
+    // gate and the spacing
+    QPointer<PDFPrerenderer> self(this);
+    m_idleBuilderId = IdleWorkScheduler::instance().registerBuilder(
+        "prerender-adaptive",
+        [self]() {
+            if (self) {
+                QMetaObject::invokeMethod(self,
+                                          &PDFPrerenderer::onAdaptiveAnalysis,
+                                          Qt::QueuedConnection);
+            }
+            return false;
+        },
+        30000);
 
     emit prerenderingStarted();
 }
@@ -147,20 +479,20 @@ void PDFPrerenderer::stopPrerendering() {
         return;
 
     m_isRunning = false;
-    m_adaptiveTimer->stop();
-
-    // Stop all workers
-    for (PDFRenderWorker* worker : m_workers) {
-        worker->stop();
+    if (m_idleBuilderId >= 0) {
+        IdleWorkScheduler::instance().unregisterBuilder(m_idleBuilderId);
+        m_idleBuilderId = -1;
     }
 
-    // Wait for threads to finish
-    for (QThread* thread : m_workerThreads) {
-        if (thread->isRunning()) {
-            thread->quit();
-            thread->wait(3000);
-        }
+    // Pending scheduler jobs see m_isRunning == false and bail out; the
+    // cancelled tokens additionally abort any render already inside
+    // Poppler. The shared pool itself keeps running for other subsystems
+    QMutexLocker locker(&m_queueMutex);
+    for (RenderRequest& request : m_renderQueue) {
+        request.token.cancel();
     }
+    m_renderQueue.clear();
+    locker.unlock();
 
     emit prerenderingStopped();
 }
@@ -187,12 +519,141 @@ void PDFPrerenderer::recordNavigationPattern(int fromPage, int toPage) {
     m_navigationPatterns[fromPage][toPage]++;
 }
 
+QString PDFPrerenderer::patternsFilePath() const {
+    return QStandardPaths::writableLocation(
+               QStandardPaths::AppDataLocation) +
+           "/reading-patterns/" + m_documentHash + ".json";
+}
+
+void PDFPrerenderer::savePatterns() const {
+    if (m_documentHash.isEmpty() ||
+        (m_navigationPatterns.isEmpty() && m_pageViewTimes.isEmpty())) {
+        return;
+    }
+
+    QJsonObject navigation;
+    for (auto fromIt = m_navigationPatterns.constBegin();
+         fromIt != m_navigationPatterns.constEnd(); ++fromIt) {
+        QJsonObject targets;
+        for (auto toIt = fromIt.value().constBegin();
+             toIt != fromIt.value().constEnd(); ++toIt) {
+            targets[QString::number(toIt.key())] = toIt.value();
+        }
+        navigation[QString::number(fromIt.key())] = targets;
+    }
+
+    QJsonObject views;
+    for (auto it = m_pageViewTimes.constBegin();
+         it != m_pageViewTimes.constEnd(); ++it) {
+        QJsonArray durations;
+        for (qint64 duration : it.value()) {
+            durations.append(static_cast<double>(duration));
+        }
+        views[QString::number(it.key())] = durations;
+    }
+
+    QJsonObject root;
+    root["version"] = 1;
+    root["navigationPatterns"] = navigation;
+    root["pageViewTimes"] = views;
+
+    QString path = patternsFilePath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QFile file(path);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    }
+}
+
+void PDFPrerenderer::loadPatterns() {
+    QFile file(patternsFilePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;  // First open of this document; nothing learned yet
+    }
+
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    if (!doc.isObject()) {
+        return;
+    }
+    QJsonObject root = doc.object();
+
+    QJsonObject navigation = root["navigationPatterns"].toObject();
+    for (auto fromIt = navigation.constBegin(); fromIt != navigation.constEnd();
+         ++fromIt) {
+        QHash<int, int>& targets = m_navigationPatterns[fromIt.key().toInt()];
+        QJsonObject targetObj = fromIt.value().toObject();
+        for (auto toIt = targetObj.constBegin(); toIt != targetObj.constEnd();
+             ++toIt) {
+            targets[toIt.key().toInt()] = toIt.value().toInt();
+        }
+    }
+
+    QJsonObject views = root["pageViewTimes"].toObject();
+    for (auto it = views.constBegin(); it != views.constEnd(); ++it) {
+        QList<qint64>& times = m_pageViewTimes[it.key().toInt()];
+        for (const QJsonValue& value : it.value().toArray()) {
+            times.append(static_cast<qint64>(value.toDouble()));
+        }
+    }
+
+    qDebug() << "PDFPrerenderer: loaded reading patterns for"
+             << m_navigationPatterns.size() << "pages";
+}
+
+void PDFPrerenderer::warmQueueFromPatterns() {
+    if (!m_document ||
+        (m_navigationPatterns.isEmpty() && m_pageViewTimes.isEmpty())) {
+        return;
+    }
+
+    // Rank pages by how often previous sessions landed on them
+    QHash<int, int> score;
+    for (auto fromIt = m_navigationPatterns.constBegin();
+         fromIt != m_navigationPatterns.constEnd(); ++fromIt) {
+        for (auto toIt = fromIt.value().constBegin();
+             toIt != fromIt.value().constEnd(); ++toIt) {
+            score[toIt.key()] += toIt.value();
+        }
+    }
+    for (auto it = m_pageViewTimes.constBegin(); it != m_pageViewTimes.constEnd();
+         ++it) {
+        score[it.key()] += it.value().size();
+    }
+
+    QList<int> pages = score.keys();
+    std::sort(pages.begin(), pages.end(),
+              [&score](int a, int b) { return score[a] > score[b]; });
+
+    // Warm roughly a dozen page turns' worth; priority follows rank so
+    // the most likely pages render first, always behind visible work
+    const int warmCount = qMin(12, static_cast<int>(pages.size()));
+    for (int i = 0; i < warmCount; ++i) {
+        requestPrerender(pages[i], 1.0, 0, 2 + i);
+    }
+}
+
 void PDFPrerenderer::scheduleAdaptivePrerendering(int currentPage) {
     if (!m_document)
         return;
 
     QList<int> pagesToPrerender = predictNextPages(currentPage);
 
+    // Tight budget: drop distant known-expensive pages from the
+    // speculative set entirely — their render time is better spent on
+    // cheap neighbours, and an adjacent expensive page still gets in
+    if (RenderPolicy::lowMemoryProfile() && !m_documentHash.isEmpty()) {
+        const double median =
+            PageCostModel::instance().documentMedianCost(m_documentHash);
+        pagesToPrerender.removeIf([this, currentPage, median](int pageNum) {
+            return qAbs(pageNum - currentPage) > 1 &&
+                   PageCostModel::instance().hasEstimate(m_documentHash,
+                                                         pageNum) &&
+                   PageCostModel::instance().predictedCost(m_documentHash,
+                                                           pageNum) >
+                       2.0 * median;
+        });
+    }
+
     for (int i = 0; i < pagesToPrerender.size(); ++i) {
         int pageNum = pagesToPrerender[i];
         int priority = calculatePriority(pageNum, currentPage);
@@ -200,30 +661,36 @@ void PDFPrerenderer::scheduleAdaptivePrerendering(int currentPage) {
         // Use current zoom and rotation settings
         requestPrerender(pageNum, 1.0, 0, priority);
     }
+
+    // Same prediction feeds the shared cache's compressed tier: decode
+    // demoted entries for the likely-next pages on a pool thread now,
+    // so a hit there doesn't pay the inflate cost at paint time
+    QString ns = PDFCacheManager::namespaceForDocument(m_document);
+    if (!ns.isEmpty()) {
+        PDFCacheManager::shared().inflatePages(ns, pagesToPrerender);
+    }
 }
 
 QList<int> PDFPrerenderer::predictNextPages(int currentPage) {
     QList<int> predictions;
 
+    // Neighbourhood width is the tuned lookahead, not a fixed offset
+    // per strategy: the enum only chose the starting value
+    for (int offset = -m_prerenderRange; offset <= m_prerenderRange;
+         ++offset) {
+        int pageNum = currentPage + offset;
+        if (pageNum >= 0 && pageNum < m_document->numPages() &&
+            pageNum != currentPage) {
+            predictions.append(pageNum);
+        }
+    }
+
     switch (m_strategy) {
         case PrerenderStrategy::Conservative:
-            // Only adjacent pages
-            if (currentPage > 0)
-                predictions.append(currentPage - 1);
-            if (currentPage < m_document->numPages() - 1)
-                predictions.append(currentPage + 1);
+            // Neighbours only, no pattern speculation
             break;
 
         case PrerenderStrategy::Balanced:
-            // Adjacent pages + navigation patterns
-            for (int offset = -2; offset <= 2; ++offset) {
-                int pageNum = currentPage + offset;
-                if (pageNum >= 0 && pageNum < m_document->numPages() &&
-                    pageNum != currentPage) {
-                    predictions.append(pageNum);
-                }
-            }
-
             // Add pages based on navigation patterns
             if (m_navigationPatterns.contains(currentPage)) {
                 const QHash<int, int>& patterns =
@@ -250,14 +717,7 @@ QList<int> PDFPrerenderer::predictNextPages(int currentPage) {
             break;
 
         case PrerenderStrategy::Aggressive:
-            // Wider range + patterns + sequential prediction
-            for (int offset = -5; offset <= 5; ++offset) {
-                int pageNum = currentPage + offset;
-                if (pageNum >= 0 && pageNum < m_document->numPages() &&
-                    pageNum != currentPage) {
-                    predictions.append(pageNum);
-                }
-            }
+            // The wider reach comes from the larger seed range
             break;
     }
 
@@ -279,70 +739,126 @@ int PDFPrerenderer::calculatePriority(int pageNumber, int currentPage) {
         }
     }
 
+    // Weight by predicted render cost. A known-expensive page (full-page
+    // scan) that is likely next must start before its distance says, or
+    // it won't be ready by the page turn; a distant expensive one steps
+    // back so several cheap neighbours render in its place
+    if (!m_documentHash.isEmpty() &&
+        PageCostModel::instance().hasEstimate(m_documentHash, pageNumber)) {
+        const double cost =
+            PageCostModel::instance().predictedCost(m_documentHash,
+                                                    pageNumber);
+        const double median =
+            PageCostModel::instance().documentMedianCost(m_documentHash);
+        if (cost > 2.0 * median) {
+            priority += distance <= 2 ? -1 : 2;
+        }
+    }
+
     // Ensure priority is positive
     return qMax(1, priority);
 }
 
 void PDFPrerenderer::setupWorkerThreads() {
-    for (int i = 0; i < m_maxWorkerThreads; ++i) {
-        QThread* thread = new QThread(this);
-        PDFRenderWorker* worker = new PDFRenderWorker();
-
-        worker->moveToThread(thread);
-        worker->setDocument(m_document);
-
-        connect(thread, &QThread::started, worker,
-                &PDFRenderWorker::processRenderQueue);
-        connect(worker, &PDFRenderWorker::pageRendered, this,
-                &PDFPrerenderer::onRenderCompleted);
-
-        m_workerThreads.append(thread);
-        m_workers.append(worker);
-    }
+    // Rendering runs on the shared RenderScheduler pool; the helper only
+    // carries the render logic and is never moved to a thread of its own
+    m_renderHelper = new PDFRenderWorker(this);
+    m_renderHelper->setDocument(m_document);
 }
 
 void PDFPrerenderer::cleanupWorkerThreads() {
-    for (PDFRenderWorker* worker : m_workers) {
-        worker->deleteLater();
-    }
-    m_workers.clear();
-
-    for (QThread* thread : m_workerThreads) {
-        thread->deleteLater();
+    if (m_renderHelper) {
+        m_renderHelper->deleteLater();
+        m_renderHelper = nullptr;
     }
-    m_workerThreads.clear();
 }
 
-void PDFPrerenderer::onRenderCompleted(int pageNumber, const QPixmap& pixmap,
+void PDFPrerenderer::onRenderCompleted(int pageNumber, const QImage& image,
                                        double scaleFactor, int rotation) {
-    if (pixmap.isNull())
+    if (image.isNull())
         return;
 
     QString cacheKey = getCacheKey(pageNumber, scaleFactor, rotation);
-    qint64 pixmapSize = getPixmapMemorySize(pixmap);
+    insertCacheItem(cacheKey, image, pageNumber, scaleFactor, rotation);
+
+    emit pagePrerendered(pageNumber, scaleFactor, rotation);
+}
+
+void PDFPrerenderer::insertCacheItem(const QString& cacheKey,
+                                     const QImage& image, int pageNumber,
+                                     double scaleFactor, int rotation) {
+    qint64 imageSize = getImageMemorySize(image);
 
     // Evict items if necessary
-    while (m_currentMemoryUsage + pixmapSize > m_maxMemoryUsage &&
+    while (m_currentMemoryUsage + imageSize > m_maxMemoryUsage &&
            !m_cache.isEmpty()) {
         evictLRUItems();
     }
 
-    // Add to cache
+    // Add to cache. The QImage stays in the worker-rendered buffer; no
+    // GUI-thread QPixmap conversion happens here any more.
     CacheItem item;
-    item.pixmap = pixmap;
+    item.image = image;
     item.timestamp = QDateTime::currentMSecsSinceEpoch();
-    item.memorySize = pixmapSize;
+    item.memorySize = imageSize;
     item.accessCount = 0;
+    item.pageNumber = pageNumber;
+    item.scaleFactor = scaleFactor;
+    item.rotation = rotation;
 
     m_cache[cacheKey] = item;
-    m_currentMemoryUsage += pixmapSize;
+    m_currentMemoryUsage += imageSize;
+    m_totalRenders++;
 
-    emit pagePrerendered(pageNumber, scaleFactor, rotation);
     emit cacheUpdated();
     emit memoryUsageChanged(m_currentMemoryUsage);
 }
 
-void PDFPrerenderer::onAdaptiveAnalysis() { analyzeReadingPatterns(); }
+void PDFPrerenderer::onAdaptiveAnalysis() {
+    analyzeReadingPatterns();
+    tunePrerenderRange();
+}
+
+void PDFPrerenderer::tunePrerenderRange() {
+    // Closed loop over one analysis window: compare hit and waste
+    // deltas since the previous pass and move the lookahead one step.
+    // High waste means we render pages nobody views — narrow. Poor hit
+    // ratio with low waste and memory headroom means we are not looking
+    // far enough — widen. Everything else holds steady
+    const int hits = m_cacheHits - m_lastWindowHits;
+    const int misses = m_cacheMisses - m_lastWindowMisses;
+    const int rendered = m_totalRenders - m_lastWindowRenders;
+    const int wasted = m_wastedRenders - m_lastWindowWasted;
+    m_lastWindowHits = m_cacheHits;
+    m_lastWindowMisses = m_cacheMisses;
+    m_lastWindowRenders = m_totalRenders;
+    m_lastWindowWasted = m_wastedRenders;
+
+    if (hits + misses < TUNE_MIN_WINDOW_LOOKUPS) {
+        return;  // Idle window, no signal to act on
+    }
+
+    const double hitRatio = static_cast<double>(hits) / (hits + misses);
+    const double wasteRatio =
+        rendered > 0 ? static_cast<double>(wasted) / rendered : 0.0;
+
+    const int maxRange = RenderPolicy::lowMemoryProfile() ? 1 : 10;
+    int range = m_prerenderRange;
+    if (wasteRatio > TUNE_WASTE_CEILING) {
+        range--;
+    } else if (hitRatio < TUNE_HIT_FLOOR &&
+               m_currentMemoryUsage < m_maxMemoryUsage * 3 / 4) {
+        range++;
+    }
+    range = qBound(1, range, maxRange);
+
+    if (range != m_prerenderRange) {
+        qDebug() << "PDFPrerenderer: lookahead retuned from"
+                 << m_prerenderRange << "to" << range << "(hit ratio"
+                 << hitRatio << ", waste ratio" << wasteRatio << ")";
+        m_prerenderRange = range;
+    }
+}
 
 QString PDFPrerenderer::getCacheKey(int pageNumber, double scaleFactor,
                                     int rotation) {
@@ -362,6 +878,8 @@ void PDFPrerenderer::resumePrerendering() {
 
 void PDFPrerenderer::setMaxWorkerThreads(int maxThreads) {
     m_maxWorkerThreads = qBound(1, maxThreads, QThread::idealThreadCount());
+    // All rendering runs on the process-wide pool
+    RenderScheduler::instance().setMaxThreadCount(m_maxWorkerThreads);
 }
 
 void PDFPrerenderer::analyzeReadingPatterns() {
@@ -384,16 +902,27 @@ void PDFPrerenderer::analyzeReadingPatterns() {
 
         if (jumpCount > 0) {
             int avgJump = totalJumps / jumpCount;
-            // Adjust prerender range based on jump patterns
+            // Adjust prerender range based on jump patterns; the
+            // low-memory profile pins the range at ±1 regardless
+            int maxRange = RenderPolicy::lowMemoryProfile() ? 1 : 10;
+            int minRange = RenderPolicy::lowMemoryProfile() ? 1 : 2;
             if (avgJump > 5) {
-                m_prerenderRange = qMin(m_prerenderRange + 1, 10);
+                m_prerenderRange = qMin(m_prerenderRange + 1, maxRange);
             } else if (avgJump < 2) {
-                m_prerenderRange = qMax(m_prerenderRange - 1, 2);
+                m_prerenderRange = qMax(m_prerenderRange - 1, minRange);
             }
         }
     }
 }
 
+void PDFPrerenderer::setMaxMemoryUsage(qint64 bytes) {
+    m_maxMemoryUsage = qMax(qint64(1024) * 1024, bytes);
+    while (m_currentMemoryUsage > m_maxMemoryUsage && !m_cache.isEmpty()) {
+        evictLRUItems();
+    }
+    emit memoryUsageChanged(m_currentMemoryUsage);
+}
+
 void PDFPrerenderer::evictLRUItems() {
     if (m_cache.isEmpty())
         return;
@@ -410,13 +939,19 @@ void PDFPrerenderer::evictLRUItems() {
     }
 
     if (!oldestKey.isEmpty()) {
+        // A render leaving the cache unread was pure speculative waste;
+        // the tuner uses this rate to decide whether to narrow the
+        // lookahead
+        if (m_cache[oldestKey].accessCount == 0) {
+            m_wastedRenders++;
+        }
         m_currentMemoryUsage -= m_cache[oldestKey].memorySize;
         m_cache.remove(oldestKey);
     }
 }
 
-qint64 PDFPrerenderer::getPixmapMemorySize(const QPixmap& pixmap) {
-    return pixmap.width() * pixmap.height() * 4;  // 32-bit ARGB
+qint64 PDFPrerenderer::getImageMemorySize(const QImage& image) {
+    return image.sizeInBytes();
 }
 
 double PDFPrerenderer::cacheHitRatio() const {
@@ -424,6 +959,12 @@ double PDFPrerenderer::cacheHitRatio() const {
     return total > 0 ? static_cast<double>(m_cacheHits) / total : 0.0;
 }
 
+double PDFPrerenderer::wastedRenderRatio() const {
+    return m_totalRenders > 0
+               ? static_cast<double>(m_wastedRenders) / m_totalRenders
+               : 0.0;
+}
+
 // PDFRenderWorker Implementation
 PDFRenderWorker::PDFRenderWorker(QObject* parent)
     : QObject(parent), m_document(nullptr), m_shouldStop(false) {}
@@ -470,9 +1011,9 @@ void PDFRenderWorker::processRenderQueue() {
         }
 
         try {
-            QPixmap pixmap = renderPage(request);
-            if (!pixmap.isNull()) {
-                emit pageRendered(request.pageNumber, pixmap,
+            QImage image = renderPage(request);
+            if (!image.isNull()) {
+                emit pageRendered(request.pageNumber, image,
                                   request.scaleFactor, request.rotation);
             }
         } catch (const std::exception& e) {
@@ -482,32 +1023,56 @@ void PDFRenderWorker::processRenderQueue() {
     }
 }
 
-QPixmap PDFRenderWorker::renderPage(
+QImage PDFRenderWorker::renderNow(
+    const PDFPrerenderer::RenderRequest& request) {
+    try {
+        return renderPage(request);
+    } catch (const std::exception& e) {
+        emit renderError(request.pageNumber, QString::fromStdString(e.what()));
+        return QImage();
+    }
+}
+
+QImage PDFRenderWorker::renderPage(
     const PDFPrerenderer::RenderRequest& request) {
+    PERF_TRACE_SCOPE("PDFRenderWorker::renderPage");
     if (!m_document) {
-        return QPixmap();
+        return QImage();
     }
 
     std::unique_ptr<Poppler::Page> page(m_document->page(request.pageNumber));
     if (!page) {
-        return QPixmap();
+        return QImage();
     }
 
     double dpi = calculateOptimalDPI(request.scaleFactor);
 
-    QImage image = page->renderToImage(
-        dpi, dpi, -1, -1, -1, -1,
-        static_cast<Poppler::Page::Rotation>(request.rotation / 90));
-
-    if (image.isNull()) {
-        return QPixmap();
+    QElapsedTimer timer;
+    timer.start();
+    QImage image = CancellableRender::renderToImage(
+        page.get(), request.token, dpi, dpi, -1, -1, -1, -1,
+        request.rotation / 90);
+
+    // Feed the cost model so future scheduling knows which pages are
+    // scans and which are cheap text
+    if (!image.isNull()) {
+        QString hash = PDFCacheManager::namespaceForDocument(m_document);
+        if (!hash.isEmpty()) {
+            PageCostModel::instance().recordRender(
+                hash, request.pageNumber, timer.elapsed(), image.size());
+            // Prerendered pages of color-free documents sit in the
+            // cache as Grayscale8 — a quarter of the bytes per page
+            image = RenderPolicy::toStorageFormat(
+                image, PageClassifier::instance().pageHasColor(
+                           hash, request.pageNumber, page.get()));
+        }
     }
-
-    return QPixmap::fromImage(image);
+    return image;
 }
 
 double PDFRenderWorker::calculateOptimalDPI(double scaleFactor) {
-    double baseDpi = 72.0;
-    double deviceRatio = qApp->devicePixelRatio();
-    return baseDpi * scaleFactor * deviceRatio;
+    // Shared policy keeps a render coalesced by the broker
+    // pixel-identical to PDFPageWidget's no matter which side
+    // submitted it first
+    return RenderPolicy::pageDpi(qApp->devicePixelRatio(), scaleFactor);
 }
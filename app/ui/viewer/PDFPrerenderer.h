@@ -8,9 +8,10 @@
 #include <QObject>
 #include <QPixmap>
 #include <QQueue>
+#include <QSet>
 #include <QThread>
-#include <QTimer>
 #include <QWaitCondition>
+#include "utils/CancellationToken.h"
 
 /**
  * Intelligent PDF page prerendering system with predictive loading
@@ -26,6 +27,9 @@ public:
         int rotation;
         int priority;  // Lower number = higher priority
         qint64 timestamp;
+        // Shared with every queued/in-flight copy of this request, so
+        // cancelling the queue entry also aborts the render in progress
+        CancellationToken token;
 
         bool operator<(const RenderRequest& other) const {
             if (priority != other.priority) {
@@ -33,6 +37,12 @@ public:
             }
             return timestamp < other.timestamp;
         }
+
+        bool operator==(const RenderRequest& other) const {
+            return pageNumber == other.pageNumber &&
+                   qAbs(scaleFactor - other.scaleFactor) < 0.001 &&
+                   rotation == other.rotation;
+        }
     };
 
     enum class PrerenderStrategy {
@@ -46,10 +56,24 @@ public:
 
     // Configuration
     void setDocument(Poppler::Document* document);
+    // Identifies the document for pattern persistence (e.g. an MD5 of the
+    // file path, as used by the disk render cache). Learned navigation
+    // statistics are saved per identifier and reloaded on reopen so the
+    // prerenderer starts warm instead of cold
+    void setDocumentIdentifier(const QString& documentHash);
+    // Seeds the prerender lookahead; from there the periodic analysis
+    // retunes it against live hit/waste statistics, so the enum is a
+    // starting point rather than a fixed operating mode
     void setStrategy(PrerenderStrategy strategy);
     void setMaxWorkerThreads(int threads);
     void setMaxCacheSize(int maxItems);
     void setMaxMemoryUsage(qint64 bytes);
+    // Minimum acceptable scale ratio (requested/cached) for serving a
+    // request by downscaling a cached higher-resolution render instead
+    // of re-rendering; rotation deltas are always served by transform.
+    // 1.0 disables derived serving, default 0.5 (downscale up to 2x)
+    void setDerivedQualityThreshold(double ratio);
+    double derivedQualityThreshold() const { return m_derivedQualityThreshold; }
 
     // Prerendering control
     void requestPrerender(int pageNumber, double scaleFactor, int rotation,
@@ -58,8 +82,10 @@ public:
     void cancelPrerenderingForPage(int pageNumber);
     void clearPrerenderQueue();
 
-    // Cache access
-    QPixmap getCachedPage(int pageNumber, double scaleFactor, int rotation);
+    // Cache access. The cache holds implicitly-shared QImage buffers;
+    // conversion to a QPixmap/texture is deferred to the widget that
+    // actually paints the page.
+    QImage getCachedPage(int pageNumber, double scaleFactor, int rotation);
     bool hasPrerenderedPage(int pageNumber, double scaleFactor, int rotation);
 
     // Statistics and monitoring
@@ -67,6 +93,11 @@ public:
     int cacheSize() const;
     qint64 memoryUsage() const;
     double cacheHitRatio() const;
+    // Closed-loop tuning introspection: the lookahead currently in
+    // effect and the fraction of renders evicted without ever being
+    // read (speculation that paid nothing)
+    int currentPrerenderRange() const { return m_prerenderRange; }
+    double wastedRenderRatio() const;
 
     // Adaptive learning
     void recordPageView(int pageNumber, qint64 viewDuration);
@@ -79,22 +110,28 @@ public slots:
     void resumePrerendering();
 
 private slots:
-    void onRenderCompleted(int pageNumber, const QPixmap& pixmap,
+    void onRenderCompleted(int pageNumber, const QImage& image,
                            double scaleFactor, int rotation);
     void onAdaptiveAnalysis();
+    void onWatchdogScan();
 
 private:
     void setupWorkerThreads();
     void cleanupWorkerThreads();
+    void loadPatterns();
+    void savePatterns() const;
+    void warmQueueFromPatterns();
+    QString patternsFilePath() const;
     void scheduleAdaptivePrerendering(int currentPage);
     void analyzeReadingPatterns();
+    void tunePrerenderRange();
     QList<int> predictNextPages(int currentPage);
     int calculatePriority(int pageNumber, int currentPage);
 
     // Core components
     Poppler::Document* m_document;
-    QList<QThread*> m_workerThreads;
-    QList<class PDFRenderWorker*> m_workers;
+    class PDFRenderWorker* m_renderHelper;  // Render logic, runs on the
+                                            // shared RenderScheduler pool
 
     // Configuration
     PrerenderStrategy m_strategy;
@@ -109,12 +146,44 @@ private:
     bool m_isRunning;
     bool m_isPaused;
 
+    // Render watchdog. A malformed page can wedge Poppler in a spot
+    // that never polls the abort callback; the worker thread is then
+    // stuck for good and the shared pool silently shrinks by one per
+    // bad page. Every render inside Poppler is registered here and a
+    // periodic scan abandons any job past its deadline: the token is
+    // cancelled (ends cooperative hangs), the (page, scale, rotation)
+    // is quarantined so it is never rendered again this document, and
+    // the scheduler is told to compensate for the possibly-lost thread.
+    struct InFlightRender {
+        RenderRequest request;
+        qint64 startedMs = 0;
+        quint64 affinityKey = 0;  // node routing key, for compensation
+        bool abandoned = false;   // deadline fired; pool compensated
+    };
+    QHash<QString, InFlightRender> m_inFlight;  // guarded by m_queueMutex
+    QSet<QString> m_quarantined;                // guarded by m_queueMutex
+    // Pages quarantined in earlier sessions, loaded from the persistent
+    // registry when the document identity is known; never rendered at
+    // any scale. The session quarantine above also feeds the registry
+    QSet<int> m_persistentBadPages;             // guarded by m_queueMutex
+    int m_watchdogHeartbeatId = -1;  // periodic scan on HeartbeatService
+
+    // A healthy render at any supported DPI finishes well inside this;
+    // a render still inside Poppler past it is treated as hung
+    static constexpr qint64 RENDER_DEADLINE_MS = 20000;
+    static constexpr int WATCHDOG_INTERVAL_MS = 5000;
+
     // Cache management
     struct CacheItem {
-        QPixmap pixmap;
+        QImage image;
         qint64 timestamp;
         qint64 memorySize;
         int accessCount;
+        // Render parameters, kept so a nearby request can be served by
+        // transforming this entry instead of re-rendering
+        int pageNumber = -1;
+        double scaleFactor = 1.0;
+        int rotation = 0;
     };
     QHash<QString, CacheItem> m_cache;
     qint64 m_currentMemoryUsage;
@@ -122,20 +191,50 @@ private:
     // Statistics
     int m_cacheHits;
     int m_cacheMisses;
+    // Waste accounting: renders inserted vs renders evicted with a zero
+    // access count. Deltas per analysis window drive the range tuning
+    int m_totalRenders = 0;
+    int m_wastedRenders = 0;
+    int m_lastWindowHits = 0;
+    int m_lastWindowMisses = 0;
+    int m_lastWindowRenders = 0;
+    int m_lastWindowWasted = 0;
 
     // Adaptive learning
     QHash<int, QList<qint64>> m_pageViewTimes;
     QHash<int, QHash<int, int>> m_navigationPatterns;  // from -> to -> count
-    QTimer* m_adaptiveTimer;
+    QString m_documentHash;  // Persistence key; empty disables persistence
+    int m_idleBuilderId = -1;  // IdleWorkScheduler registration
 
-    // Reading pattern analysis
+    // Reading pattern analysis. m_prerenderRange is the live lookahead
+    // (±pages around the current one fed to the predictor): the strategy
+    // enum seeds it, the periodic analysis moves it based on hit ratio
+    // and wasted-render rate within the memory budget
     QList<int> m_accessHistory;
     int m_prerenderRange;
 
+    // Tuning thresholds: a window with fewer lookups than this is idle
+    // and left alone; waste above the cap narrows the lookahead, a poor
+    // hit ratio with memory headroom widens it
+    static constexpr int TUNE_MIN_WINDOW_LOOKUPS = 20;
+    static constexpr double TUNE_WASTE_CEILING = 0.5;
+    static constexpr double TUNE_HIT_FLOOR = 0.5;
+
+    // MemoryGovernor registration
+    int m_governorId = -1;
+
+    // Derived-render quality threshold (see setDerivedQualityThreshold)
+    double m_derivedQualityThreshold = 0.5;
+
     // Helper methods
+    void noteRenderStarted(const RenderRequest& request);
+    void noteRenderFinished(const RenderRequest& request);
     QString getCacheKey(int pageNumber, double scaleFactor, int rotation);
+    QString findDerivableKey(int pageNumber, double scaleFactor) const;
+    void insertCacheItem(const QString& cacheKey, const QImage& image,
+                         int pageNumber, double scaleFactor, int rotation);
     void evictLRUItems();
-    qint64 getPixmapMemorySize(const QPixmap& pixmap);
+    qint64 getImageMemorySize(const QImage& image);
 
 signals:
     void pagePrerendered(int pageNumber, double scaleFactor, int rotation);
@@ -159,11 +258,15 @@ public:
     void clearQueue();
     void stop();
 
+    // Synchronous render entry point, called from a RenderScheduler
+    // worker thread
+    QImage renderNow(const PDFPrerenderer::RenderRequest& request);
+
 public slots:
     void processRenderQueue();
 
 private:
-    QPixmap renderPage(const PDFPrerenderer::RenderRequest& request);
+    QImage renderPage(const PDFPrerenderer::RenderRequest& request);
     double calculateOptimalDPI(double scaleFactor);
 
     Poppler::Document* m_document;
@@ -173,7 +276,7 @@ private:
     bool m_shouldStop;
 
 signals:
-    void pageRendered(int pageNumber, const QPixmap& pixmap, double scaleFactor,
+    void pageRendered(int pageNumber, const QImage& image, double scaleFactor,
                       int rotation);
     void renderError(int pageNumber, const QString& error);
 };
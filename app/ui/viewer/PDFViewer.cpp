@@ -1,9 +1,12 @@
 #include "PDFViewer.h"
+#include <QAccessible>
 #include <QApplication>
+#include <QClipboard>
 #include <QColor>
 #include <QComboBox>
 #include <QDateTime>
 #include <QDebug>
+#include <QDesktopServices>
 #include <QGesture>
 #include <QGestureEvent>
 #include <QGraphicsOpacityEffect>
@@ -15,6 +18,7 @@
 #include <QPanGesture>
 #include <QPen>
 #include <QPinchGesture>
+#include <QPointer>
 #include <QPropertyAnimation>
 #include <QRect>
 #include <QScrollBar>
@@ -32,16 +36,45 @@
 #include <cmath>
 #include <memory>
 #include <stdexcept>
+#include "../../managers/RenderBroker.h"
+#include "../../managers/RenderScheduler.h"
 #include "../../managers/StyleManager.h"
+#include "../../model/DocumentSnapshot.h"
+#include "../../model/DocumentTextIndex.h"
+#include "../../model/PageLinkLayer.h"
+#include "../../model/TextSelectionEngine.h"
+#include "../../utils/MemoryTracker.h"
+#include "../../utils/PDFUtilities.h"
+#include "../../utils/PageTurnSlo.h"
+#include "../../utils/PerfTracer.h"
+#include "../../utils/RenderPolicy.h"
+#include "PDFViewerAccessible.h"
 
 // PDFPageWidget Implementation
 PDFPageWidget::PDFPageWidget(QWidget* parent)
     : QLabel(parent),
       currentPage(nullptr),
+      contextDocument(nullptr),
+      contextPageNumber(-1),
+      renderGeneration(0),
       currentScaleFactor(1.0),
       currentRotation(0),
+      pixmapDirty(false),
+      previewScaleFactor(1.0),
+      previewScaleActive(false),
+      wheelZoomTarget(1.0),
+      wheelZoomCommitTimer(nullptr),
+      clipRenderScheduled(false),
+      m_trackedBufferBytes(0),
       isDragging(false),
-      m_currentSearchResultIndex(-1),
+      selectionEngine(nullptr),
+      isSelectingText(false),
+      textIndex(nullptr),
+      linkLayerFetched(false),
+      hoveredLinkIndex(-1),
+      pressedLinkIndex(-1),
+      m_searchPageNumber(-1),
+      m_currentSearchRow(-1),
       m_normalHighlightColor(QColor(255, 255, 0, 100)),
       m_currentHighlightColor(QColor(255, 165, 0, 150)) {
     setAlignment(Qt::AlignCenter);
@@ -56,6 +89,16 @@ PDFPageWidget::PDFPageWidget(QWidget* parent)
     // Enable touch events
     setAttribute(Qt::WA_AcceptTouchEvents, true);
 
+    // 无按键移动也要收到mouseMoveEvent，用于链接悬停光标
+    setMouseTracking(true);
+
+    // 滚轮缩放合并计时器：每个tick重启，输入停顿后只提交一次
+    wheelZoomCommitTimer = new QTimer(this);
+    wheelZoomCommitTimer->setSingleShot(true);
+    wheelZoomCommitTimer->setInterval(WHEEL_ZOOM_SETTLE_MS);
+    connect(wheelZoomCommitTimer, &QTimer::timeout, this,
+            [this]() { commitScaleFactor(wheelZoomTarget); });
+
     // 设置现代化的页面样式 (仅在非测试环境中)
     try {
         setStyleSheet(QString(R"(
@@ -86,6 +129,22 @@ PDFPageWidget::PDFPageWidget(QWidget* parent)
     setGraphicsEffect(shadowEffect);
 }
 
+PDFPageWidget::~PDFPageWidget() {
+    MemoryTracker::instance().release("page-widgets", m_trackedBufferBytes);
+}
+
+void PDFPageWidget::updateBufferAttribution() {
+    // 页面位图缓冲归因：整页/裁剪帧加平移缓存里保留的旧裁剪。
+    // QPixmap没有精确字节数接口，按每像素4字节估算
+    qint64 bytes = renderedImage.sizeInBytes();
+    for (const auto& cached : panClipCache) {
+        bytes += qint64(cached.second.width()) * cached.second.height() * 4;
+    }
+    MemoryTracker::instance().add("page-widgets",
+                                  bytes - m_trackedBufferBytes);
+    m_trackedBufferBytes = bytes;
+}
+
 void PDFPageWidget::setPage(Poppler::Page* page, double scaleFactor,
                             int rotation) {
     currentPage = page;
@@ -94,6 +153,17 @@ void PDFPageWidget::setPage(Poppler::Page* page, double scaleFactor,
     renderPage();
 }
 
+void PDFPageWidget::setDocumentContext(Poppler::Document* document,
+                                       int pageNumber) {
+    contextDocument = document;
+    contextPageNumber = pageNumber;
+    // 换页后重新获取链接层（连续模式下组件会被池化复用）
+    linkLayer.reset();
+    linkLayerFetched = false;
+    hoveredLinkIndex = -1;
+    pressedLinkIndex = -1;
+}
+
 void PDFPageWidget::setScaleFactor(double factor) {
     if (factor != currentScaleFactor) {
         currentScaleFactor = factor;
@@ -102,51 +172,184 @@ void PDFPageWidget::setScaleFactor(double factor) {
     }
 }
 
+void PDFPageWidget::setPreviewScaleFactor(double factor) {
+    // 没有可变换的整页帧（未渲染或处于视口裁剪模式）时退化为
+    // 直接渲染；裁剪模式下整页远大于视口，动画收益最小
+    if (renderedImage.isNull() || !renderedClipRect.isNull() ||
+        currentScaleFactor <= 0) {
+        setScaleFactor(factor);
+        return;
+    }
+
+    previewScaleFactor = factor;
+    previewScaleActive = true;
+
+    // 预览帧逻辑尺寸 = 已渲染整页逻辑尺寸按新旧缩放比例伸缩
+    const QSize baseSize =
+        renderedImage.size() / renderedImage.devicePixelRatio();
+    const double ratio = factor / currentScaleFactor;
+    resize(qRound(baseSize.width() * ratio), qRound(baseSize.height() * ratio));
+    update();
+}
+
+void PDFPageWidget::commitScaleFactor(double factor) {
+    previewScaleActive = false;
+    if (factor != currentScaleFactor) {
+        currentScaleFactor = factor;
+        renderPage();
+        emit scaleChanged(factor);
+    } else {
+        update();
+    }
+}
+
 void PDFPageWidget::setRotation(int degrees) {
     // 确保旋转角度是90度的倍数
     degrees = ((degrees % 360) + 360) % 360;
-    if (degrees != currentRotation) {
-        currentRotation = degrees;
-        renderPage();
+    if (degrees == currentRotation) {
+        return;
+    }
+    const int delta = ((degrees - currentRotation) % 360 + 360) % 360;
+    currentRotation = degrees;
+
+    // 旋转快路径：已有整页帧时原地转90度即时显示——像素与重渲染
+    // 只差文本微调提示，连转四个方向不产生同步Poppler渲染。正确
+    // 朝向的清晰帧照常在后台渲染，完成后按代号替换
+    if (hasFullPageFrame() && contextDocument && contextPageNumber >= 0) {
+        const double dpr = renderedImage.devicePixelRatio();
+        QImage rotated = renderedImage.transformed(QTransform().rotate(delta));
+        rotated.setDevicePixelRatio(dpr);
+        setRenderedImage(rotated);
+        requestSharpRender();
+        return;
     }
+    renderPage();
 }
 
 void PDFPageWidget::renderPage() {
     if (!currentPage) {
+        renderedImage = QImage();
+        renderedPixmap = QPixmap();
+        pixmapDirty = false;
+        updateBufferAttribution();
         setText("No page to render");
         return;
     }
 
+    // 换页SLO：同步Poppler渲染（裁剪/预览/无上下文整页）计入render段
+    PageTurnStageTimer sloRender(PageTurnSlo::Stage::Render);
+
     try {
-        // Enhanced rendering with optimized DPI calculation
+        // 渲染分辨率统一走RenderPolicy，保证与预渲染器按同一DPI渲染
         double devicePixelRatio = devicePixelRatioF();
-        double baseDpi = 72.0 * currentScaleFactor;
-        double optimizedDpi = baseDpi * devicePixelRatio;
-
-        // Limit DPI to prevent excessive memory usage
-        optimizedDpi = qMin(optimizedDpi, 300.0);
-
-        QSizeF pageSize = currentPage->pageSizeF();
-
-        // Note: Document configuration would be done at document level
-        // High-quality rendering is achieved through optimized DPI and render
-        // hints
-
-        // 渲染页面为图像，包含旋转和优化设置
-        QImage image = currentPage->renderToImage(
-            optimizedDpi, optimizedDpi, -1, -1, -1, -1,
-            static_cast<Poppler::Page::Rotation>(currentRotation / 90));
-        if (image.isNull()) {
-            setText("Failed to render page");
-            return;
+        double optimizedDpi =
+            RenderPolicy::pageDpi(devicePixelRatio, currentScaleFactor);
+
+        ++renderGeneration;  // 作废在途的清晰帧完成回调
+        auto rotation =
+            static_cast<Poppler::Page::Rotation>(currentRotation / 90);
+
+        // 视口裁剪渲染：高倍缩放下整页面积远超视口时，只同步渲染
+        // 可见区域+边距。渲染耗时随视口大小伸缩而非页面大小；
+        // 平移暴露新区域时由paintEvent增量补渲染
+        const QSize fullDevice = RenderPolicy::targetSizePixels(
+            currentPage->pageSizeF(), optimizedDpi, optimizedDpi,
+            currentRotation);
+        const QSize fullLogical = QSize(
+            qCeil(fullDevice.width() / devicePixelRatio),
+            qCeil(fullDevice.height() / devicePixelRatio));
+        const QRect visible = visiblePageRect(fullLogical);
+        const qint64 fullArea =
+            qint64(fullLogical.width()) * fullLogical.height();
+        const qint64 visibleArea = qint64(visible.width()) * visible.height();
+        if (visibleArea > 0 && fullArea > visibleArea * CLIP_AREA_RATIO) {
+            if (panCacheFullSize != fullLogical) {
+                // 缩放或旋转变了，旧裁剪作废
+                panClipCache.clear();
+                panCacheFullSize = fullLogical;
+            }
+            const QRect clip =
+                visible
+                    .adjusted(-CLIP_MARGIN, -CLIP_MARGIN, CLIP_MARGIN,
+                              CLIP_MARGIN)
+                    .intersected(QRect(QPoint(0, 0), fullLogical));
+            QImage image = currentPage->renderToImage(
+                optimizedDpi, optimizedDpi,
+                qRound(clip.x() * devicePixelRatio),
+                qRound(clip.y() * devicePixelRatio),
+                qRound(clip.width() * devicePixelRatio),
+                qRound(clip.height() * devicePixelRatio), rotation);
+            if (!image.isNull()) {
+                image.setDevicePixelRatio(devicePixelRatio);
+                setRenderedClip(image, clip, fullLogical);
+                return;
+            }
+        }
+        panClipCache.clear();
+        panCacheFullSize = QSize();
+
+        // Pass 1: immediate low-res preview so page turns never show a
+        // blank widget. A 36 DPI render is cheap enough to stay inside
+        // one frame even for image-heavy scanned pages.
+        constexpr double PREVIEW_DPI = 36.0;
+        QImage preview;
+
+        // 扫描页预览快路径：整页内容就是一张内嵌JPEG时，直接把原始
+        // 码流按预览尺寸解码（libjpeg在解码过程中做1/8~1/2级DCT缩放，
+        // 从不展开全尺寸光栅），跳过Poppler的整页光栅化。全分辨率
+        // 解码只在清晰帧那一遍付一次。流偏移按文件哈希缓存，非扫描
+        // 页在首次扫描后立刻返回无效结果
+        if (contextDocument && contextPageNumber >= 0) {
+            if (auto snapshot =
+                    DocumentSnapshot::forDocument(contextDocument)) {
+                const PDFUtilities::EmbeddedPageImage embedded =
+                    PDFUtilities::extractEmbeddedPageImage(
+                        snapshot->filePath(), contextPageNumber,
+                        contextDocument->numPages(),
+                        currentPage->pageSizeF());
+                if (embedded.valid) {
+                    const QSize previewSize = RenderPolicy::targetSizePixels(
+                        currentPage->pageSizeF(), PREVIEW_DPI, PREVIEW_DPI);
+                    preview = embedded.decode(previewSize);
+                    if (!preview.isNull() && currentRotation != 0) {
+                        // 预览尺寸下的旋转代价可以忽略
+                        preview = preview.transformed(
+                            QTransform().rotate(currentRotation));
+                    }
+                }
+            }
+        }
+        if (preview.isNull()) {
+            preview = currentPage->renderToImage(PREVIEW_DPI, PREVIEW_DPI, -1,
+                                                 -1, -1, -1, rotation);
+        }
+        if (!preview.isNull()) {
+            // Stretch the preview to the sharp pass's logical geometry
+            // via its devicePixelRatio instead of rescaling pixels
+            preview.setDevicePixelRatio(PREVIEW_DPI / optimizedDpi *
+                                        devicePixelRatio);
+            setRenderedImage(preview);
         }
 
-        // Apply device pixel ratio for high-DPI displays
-        renderedPixmap = QPixmap::fromImage(image);
-        renderedPixmap.setDevicePixelRatio(devicePixelRatio);
+        // Pass 2: full-DPI render. With a document context it runs on
+        // the shared render pool and replaces the preview when done;
+        // without one (caller only handed us a transient Page) it has
+        // to stay synchronous.
+        if (contextDocument && contextPageNumber >= 0) {
+            requestSharpRender();
+        } else {
+            QImage image = currentPage->renderToImage(
+                optimizedDpi, optimizedDpi, -1, -1, -1, -1, rotation);
+            if (image.isNull()) {
+                setText("Failed to render page");
+                return;
+            }
 
-        setPixmap(renderedPixmap);
-        resize(renderedPixmap.size() / devicePixelRatio);
+            // Keep the implicitly-shared QImage; QPixmap conversion is
+            // deferred to the first paint of this frame
+            image.setDevicePixelRatio(devicePixelRatio);
+            setRenderedImage(image);
+        }
 
     } catch (const std::exception& e) {
         setText(QString("渲染错误: %1").arg(e.what()));
@@ -157,7 +360,124 @@ void PDFPageWidget::renderPage() {
     }
 }
 
+void PDFPageWidget::requestSharpRender() {
+    if (!contextDocument || contextPageNumber < 0) {
+        return;
+    }
+    double devicePixelRatio = devicePixelRatioF();
+    double optimizedDpi =
+        RenderPolicy::pageDpi(devicePixelRatio, currentScaleFactor);
+    quint64 generation = ++renderGeneration;
+    auto rotation = static_cast<Poppler::Page::Rotation>(currentRotation / 90);
+
+    QPointer<PDFPageWidget> self(this);
+    Poppler::Document* doc = contextDocument;
+    int pageNum = contextPageNumber;
+    // 经由RenderBroker去重：缩放时预渲染器常常同时请求同一
+    // (页, 缩放, 旋转)，此处附着到进行中的渲染而非重复渲染
+    RenderBroker::RenderKey key = RenderBroker::makeKey(
+        doc, pageNum, currentScaleFactor, currentRotation);
+    RenderBroker::instance().request(
+        key, RenderScheduler::TaskClass::VisiblePage,
+        [doc, pageNum, optimizedDpi, rotation]() -> QImage {
+            // 快照页池：租借本线程常驻的页对象，连续缩放时
+            // 不再每次渲染都重建Poppler::Page
+            if (auto snapshot = DocumentSnapshot::forDocument(doc)) {
+                if (auto lease = snapshot->leasePage(pageNum)) {
+                    return lease->renderToImage(optimizedDpi, optimizedDpi, -1,
+                                                -1, -1, -1, rotation);
+                }
+            }
+            std::unique_ptr<Poppler::Page> page(doc->page(pageNum));
+            if (!page) {
+                return QImage();
+            }
+            return page->renderToImage(optimizedDpi, optimizedDpi, -1, -1, -1,
+                                       -1, rotation);
+        },
+        this,
+        [self, generation, devicePixelRatio](const QImage& rendered) {
+            // A newer page/zoom superseded this render
+            if (!self || rendered.isNull() ||
+                generation != self->renderGeneration) {
+                return;
+            }
+            QImage image = rendered;
+            image.setDevicePixelRatio(devicePixelRatio);
+            self->setRenderedImage(image);
+        });
+}
+
+void PDFPageWidget::setRenderedImage(const QImage& image) {
+    renderedImage = image;
+    renderedClipRect = QRect();  // 整页帧，退出裁剪模式
+    pixmapDirty = true;
+    updateBufferAttribution();
+    setText(QString());
+    // 缩放动画期间迟到的清晰帧只更新位图，不干扰预览尺寸；
+    // 动画提交后的渲染会重新确定控件尺寸
+    if (!renderedImage.isNull() && !previewScaleActive) {
+        resize(renderedImage.size() / renderedImage.devicePixelRatio());
+    }
+    update();
+}
+
+QRect PDFPageWidget::visiblePageRect(const QSize& fullLogicalSize) const {
+    QWidget* viewport = parentWidget();
+    if (!viewport || fullLogicalSize.isEmpty()) {
+        return QRect(QPoint(0, 0), fullLogicalSize);
+    }
+    // 视口在本控件坐标系中的位置；缩放刚变、控件还未resize到新
+    // 尺寸时，把位置按新旧尺寸比例换算到新坐标系
+    QRect visible(-pos(), viewport->size());
+    if (size() != fullLogicalSize && width() > 0 && height() > 0) {
+        visible.moveTopLeft(QPoint(
+            qRound(visible.x() * double(fullLogicalSize.width()) / width()),
+            qRound(visible.y() * double(fullLogicalSize.height()) /
+                   height())));
+    }
+    return visible.intersected(QRect(QPoint(0, 0), fullLogicalSize));
+}
+
+void PDFPageWidget::setRenderedClip(const QImage& image, const QRect& clipRect,
+                                    const QSize& fullLogicalSize) {
+    // 旧裁剪进平移缓存：向回平移时直接复用，不再重渲染
+    if (!renderedPixmap.isNull() && !renderedClipRect.isNull() &&
+        !pixmapDirty) {
+        panClipCache.prepend(qMakePair(renderedClipRect, renderedPixmap));
+        while (panClipCache.size() > PAN_CLIP_CACHE_MAX) {
+            panClipCache.removeLast();
+        }
+    }
+    renderedImage = image;
+    renderedClipRect = clipRect;
+    pixmapDirty = true;
+    updateBufferAttribution();
+    setText(QString());
+    if (size() != fullLogicalSize) {
+        resize(fullLogicalSize);
+    }
+    update();
+}
+
+void PDFPageWidget::scheduleClipRender() {
+    if (clipRenderScheduled) {
+        return;
+    }
+    clipRenderScheduled = true;
+    // 合并同一轮事件循环里的多次暴露，在平移事件处理完后补渲染
+    QTimer::singleShot(0, this, [this]() {
+        clipRenderScheduled = false;
+        renderPage();
+    });
+}
+
 void PDFPageWidget::paintEvent(QPaintEvent* event) {
+    PERF_TRACE_SCOPE("PDFPageWidget::paintEvent");
+    // 换页SLO：终结器先声明后析构——绘制段计时先落账，随后才
+    // 结束本次换页测量
+    PageTurnFinisher sloFinisher(contextPageNumber);
+    PageTurnStageTimer sloPaint(PageTurnSlo::Stage::Paint);
     QPainter painter(this);
 
     // Enable high-quality rendering hints
@@ -165,14 +485,106 @@ void PDFPageWidget::paintEvent(QPaintEvent* event) {
                            QPainter::SmoothPixmapTransform |
                            QPainter::TextAntialiasing);
 
-    // Call parent implementation with enhanced rendering
-    QLabel::paintEvent(event);
+    // Lazy texture upload: the shared QImage buffer is converted to a
+    // QPixmap only for the page actually being painted, and only once
+    // per rendered frame
+    if (pixmapDirty && !renderedImage.isNull()) {
+        PageTurnStageTimer sloConvert(PageTurnSlo::Stage::Convert);
+        renderedPixmap = QPixmap::fromImage(renderedImage);
+        renderedPixmap.setDevicePixelRatio(renderedImage.devicePixelRatio());
+        pixmapDirty = false;
+    }
+
+    // 本次绘制会把目标页的帧送上屏幕，允许终结换页测量
+    if (!renderedPixmap.isNull()) {
+        sloFinisher.arm();
+    }
 
-    // Draw search highlights
-    if (!m_searchResults.isEmpty()) {
-        drawSearchHighlights(painter);
+    if (previewScaleActive && !renderedPixmap.isNull()) {
+        // 缩放动画中：把现有位图变换到控件当前尺寸，每帧纯光栅
+        // 操作，与页面复杂度无关；高亮/选区覆盖层在动画结束、
+        // 终点清晰帧提交后随整页重绘恢复
+        painter.drawPixmap(rect(), renderedPixmap);
+        return;
     }
 
+    if (!renderedPixmap.isNull() && !renderedClipRect.isNull()) {
+        // 裁剪模式：控件就是整页逻辑尺寸，栅格只覆盖renderedClipRect。
+        // 损伤区域先用当前裁剪补，再查平移缓存，仍缺的涂白并
+        // 调度一次增量补渲染
+        const qreal dpr = renderedPixmap.devicePixelRatio();
+        QRegion missing;
+        for (const QRect& damaged : event->region()) {
+            const QRect target = damaged.intersected(rect());
+            if (target.isEmpty()) {
+                continue;
+            }
+            const QRect hit = target.intersected(renderedClipRect);
+            if (!hit.isEmpty()) {
+                const QRectF source(
+                    (hit.topLeft() - renderedClipRect.topLeft()) * dpr,
+                    QSizeF(hit.size()) * dpr);
+                painter.drawPixmap(QRectF(hit), renderedPixmap, source);
+            }
+            missing += QRegion(target) - QRegion(hit);
+        }
+        QRegion uncovered;
+        for (const QRect& gap : missing) {
+            bool covered = false;
+            for (const auto& cached : panClipCache) {
+                const QRect hit = gap.intersected(cached.first);
+                if (hit == gap) {
+                    const qreal cachedDpr = cached.second.devicePixelRatio();
+                    const QRectF source(
+                        (hit.topLeft() - cached.first.topLeft()) * cachedDpr,
+                        QSizeF(hit.size()) * cachedDpr);
+                    painter.drawPixmap(QRectF(hit), cached.second, source);
+                    covered = true;
+                    break;
+                }
+            }
+            if (!covered) {
+                uncovered += gap;
+            }
+        }
+        if (!uncovered.isEmpty()) {
+            for (const QRect& gap : uncovered) {
+                painter.fillRect(gap, Qt::white);
+            }
+            scheduleClipRender();
+        }
+    } else if (!renderedPixmap.isNull()) {
+        const qreal dpr = renderedPixmap.devicePixelRatio();
+        QSizeF logicalSize = renderedPixmap.size() / dpr;
+        QPointF topLeft((width() - logicalSize.width()) / 2.0,
+                        (height() - logicalSize.height()) / 2.0);
+        const QRectF pageRect(topLeft, logicalSize);
+
+        // 按损伤矩形合成：只把事件区域覆盖的栅格像素搬上屏幕。
+        // 高亮步进只弄脏几个矩形时，这里重绘的是几千像素而不是
+        // 整页八百万像素
+        for (const QRect& damaged : event->region()) {
+            const QRectF target = QRectF(damaged).intersected(pageRect);
+            if (target.isEmpty()) {
+                continue;
+            }
+            const QRectF source((target.topLeft() - topLeft) * dpr,
+                                target.size() * dpr);
+            painter.drawPixmap(target, renderedPixmap, source);
+        }
+    } else {
+        // No frame yet: let QLabel paint the placeholder text
+        QLabel::paintEvent(event);
+    }
+
+    // Draw search highlights intersecting the damage region
+    if (!m_searchRows.isEmpty()) {
+        drawSearchHighlights(painter, event->region());
+    }
+
+    // 文字选区高亮
+    drawTextSelection(painter, event->region());
+
     // Add subtle shadow effect for better visual appearance
     if (!renderedPixmap.isNull()) {
         QRect pixmapRect = rect();
@@ -344,15 +756,23 @@ void PDFPageWidget::wheelEvent(QWheelEvent* event) {
         // Ctrl + 滚轮进行缩放
         int delta = event->angleDelta().y();
         if (delta != 0) {
-            // 使用更平滑的缩放步长
-            double scaleDelta = delta > 0 ? 1.15 : (1.0 / 1.15);
-            double newScale = currentScaleFactor * scaleDelta;
-
-            // 限制缩放范围
-            newScale = qBound(0.1, newScale, 5.0);
-
-            // 应用缩放
-            setScaleFactor(newScale);
+            // 连续tick以当前目标为基数累积，单个tick不再各自触发
+            // 渲染；高分辨率触控板的delta不是120的整数倍，按比例
+            // 取幂保持每格1.15倍的手感
+            const double base = wheelZoomCommitTimer->isActive()
+                                    ? wheelZoomTarget
+                                    : currentScaleFactor;
+            const double scaleDelta = std::pow(1.15, delta / 120.0);
+            wheelZoomTarget = qBound(0.1, base * scaleDelta, 5.0);
+
+            // 中间帧：有整页帧时纯位图变换，渲染队列完全不参与；
+            // 裁剪模式下位图无法代表新倍率，保持旧帧到停顿提交
+            if (hasFullPageFrame() && currentScaleFactor > 0) {
+                setPreviewScaleFactor(wheelZoomTarget);
+            }
+            // 重启停顿窗口；超时回调commitScaleFactor只渲染一次，
+            // renderGeneration随之步进，在途的旧清晰帧完成即作废
+            wheelZoomCommitTimer->start();
         }
         event->accept();
     } else {
@@ -360,66 +780,161 @@ void PDFPageWidget::wheelEvent(QWheelEvent* event) {
     }
 }
 
+void PDFPageWidget::setSelectionEngine(TextSelectionEngine* engine) {
+    selectionEngine = engine;
+}
+
+void PDFPageWidget::setTextIndex(DocumentTextIndex* index) {
+    textIndex = index;
+    linkLayer.reset();
+    linkLayerFetched = false;
+}
+
+int PDFPageWidget::linkAt(const QPoint& widgetPoint) {
+    if (!textIndex || !currentPage || contextPageNumber < 0) {
+        return -1;
+    }
+    if (!linkLayerFetched) {
+        // 后台抽取尚未到达本页时先当作未命中，之后再取；取到后
+        // （含"本页无链接"的空结果）悬停路径不再碰索引的锁
+        if (!textIndex->isPageIndexed(contextPageNumber)) {
+            return -1;
+        }
+        linkLayer = textIndex->linkLayer(contextPageNumber);
+        linkLayerFetched = true;
+    }
+    if (!linkLayer) {
+        return -1;
+    }
+    return linkLayer->linkIndexAt(widgetToPagePoint(widgetPoint));
+}
+
 void PDFPageWidget::mousePressEvent(QMouseEvent* event) {
     if (event->button() == Qt::LeftButton) {
-        isDragging = true;
-        lastPanPoint = event->pos();
-        setCursor(Qt::ClosedHandCursor);
+        // 链接优先于文字选择与拖拽；实际跳转在释放时确认，
+        // 以便按下后移出链接区域可取消
+        pressedLinkIndex = linkAt(event->pos());
+        // 按下处命中文字则进入选择模式；否则保持原有拖拽平移。
+        // 命中判定只查文字层的网格索引，不调用Poppler
+        if (pressedLinkIndex < 0 && selectionEngine && currentPage &&
+            contextPageNumber >= 0 &&
+            selectionEngine->beginSelection(contextPageNumber,
+                                            widgetToPagePoint(event->pos()))) {
+            isSelectingText = true;
+            setCursor(Qt::IBeamCursor);
+        } else if (pressedLinkIndex < 0) {
+            isDragging = true;
+            lastPanPoint = event->pos();
+            setCursor(Qt::ClosedHandCursor);
+        }
     }
     QLabel::mousePressEvent(event);
 }
 
 void PDFPageWidget::mouseMoveEvent(QMouseEvent* event) {
-    if (isDragging && (event->buttons() & Qt::LeftButton)) {
+    if (isSelectingText && (event->buttons() & Qt::LeftButton)) {
+        // 仅移动选区端点（几何运算）；文本拼装推迟到复制时
+        if (selectionEngine && contextPageNumber >= 0) {
+            selectionEngine->extendSelection(contextPageNumber,
+                                             widgetToPagePoint(event->pos()));
+        }
+    } else if (isDragging && (event->buttons() & Qt::LeftButton)) {
         // 实现拖拽平移功能
         QPoint delta = event->pos() - lastPanPoint;
         lastPanPoint = event->pos();
 
         // 这里可以实现滚动区域的平移
         // 由于我们在ScrollArea中，这个功能由ScrollArea处理
+    } else if (!event->buttons()) {
+        // 悬停：命中链接区域时切手型光标。linkAt只查本页缓存的
+        // 排序矩形表，无分配、不加锁，可承受每次鼠标移动调用
+        const int link = linkAt(event->pos());
+        if (link != hoveredLinkIndex) {
+            hoveredLinkIndex = link;
+            setCursor(link >= 0 ? Qt::PointingHandCursor : Qt::ArrowCursor);
+        }
     }
     QLabel::mouseMoveEvent(event);
 }
 
 void PDFPageWidget::mouseReleaseEvent(QMouseEvent* event) {
     if (event->button() == Qt::LeftButton) {
+        // 在同一链接上按下并释放才算点击；页内跳转交给PDFViewer，
+        // 外部URL直接交给系统默认浏览器
+        if (pressedLinkIndex >= 0 && linkLayer &&
+            linkAt(event->pos()) == pressedLinkIndex) {
+            const int target = linkLayer->targetPage(pressedLinkIndex);
+            if (target >= 0) {
+                emit linkActivated(target);
+            } else {
+                QDesktopServices::openUrl(
+                    QUrl(linkLayer->url(pressedLinkIndex)));
+            }
+        }
+        pressedLinkIndex = -1;
+        hoveredLinkIndex = -1;  // 下次移动重新判定悬停光标
         isDragging = false;
+        isSelectingText = false;
         setCursor(Qt::ArrowCursor);
     }
     QLabel::mouseReleaseEvent(event);
 }
 
 // Search highlighting implementation
-void PDFPageWidget::setSearchResults(const QList<SearchResult>& results) {
-    m_searchResults = results;
-    m_currentSearchResultIndex = -1;
+void PDFPageWidget::setSearchSnapshot(
+    std::shared_ptr<const SearchResultSnapshot> snapshot, int pageNumber,
+    int currentRow) {
+    // Same shared snapshot and page: only the current result can have
+    // moved, so the rows and widget-space rectangles stay valid
+    if (snapshot == m_searchSnapshot && pageNumber == m_searchPageNumber) {
+        setCurrentSearchRow(currentRow);
+        return;
+    }
+
+    m_searchSnapshot = std::move(snapshot);
+    m_searchPageNumber = pageNumber;
+    m_searchRows = m_searchSnapshot
+                       ? m_searchSnapshot->rowsForPage(pageNumber)
+                       : QVector<int>();
+    m_currentSearchRow = currentRow;
 
-    // Transform coordinates for all results
+    // Transform coordinates for this page's rows
     updateSearchResultCoordinates();
 
-    // Trigger repaint to show highlights
-    update();
+    // 只弄脏新旧高亮区域的并集；页面栅格其余部分不重绘
+    const QRegion fresh = searchOverlayRegion();
+    update(m_searchDamage + fresh);
+    m_searchDamage = fresh;
 }
 
 void PDFPageWidget::clearSearchHighlights() {
-    m_searchResults.clear();
-    m_currentSearchResultIndex = -1;
-    update();
+    m_searchSnapshot.reset();
+    m_searchPageNumber = -1;
+    m_searchRows.clear();
+    m_searchWidgetRects.clear();
+    m_currentSearchRow = -1;
+    update(m_searchDamage);
+    m_searchDamage = QRegion();
 }
 
-void PDFPageWidget::setCurrentSearchResult(int index) {
-    if (index >= 0 && index < m_searchResults.size()) {
-        // Clear previous current result
-        if (m_currentSearchResultIndex >= 0 &&
-            m_currentSearchResultIndex < m_searchResults.size()) {
-            m_searchResults[m_currentSearchResultIndex].isCurrentResult = false;
-        }
+void PDFPageWidget::setCurrentSearchRow(int row) {
+    if (row == m_currentSearchRow) {
+        return;
+    }
 
-        // Set new current result
-        m_currentSearchResultIndex = index;
-        m_searchResults[index].isCurrentResult = true;
+    // 当前结果切换只影响两个矩形：旧的和新的
+    QRegion damage;
+    for (int i = 0; i < m_searchRows.size(); ++i) {
+        if (m_searchRows.at(i) == m_currentSearchRow ||
+            m_searchRows.at(i) == row) {
+            damage += m_searchWidgetRects.at(i).toAlignedRect().adjusted(
+                -2, -2, 2, 2);
+        }
+    }
 
-        update();
+    m_currentSearchRow = row;
+    if (!damage.isEmpty()) {
+        update(damage);
     }
 }
 
@@ -431,48 +946,177 @@ void PDFPageWidget::updateHighlightColors(const QColor& normalColor,
 }
 
 void PDFPageWidget::updateSearchResultCoordinates() {
-    if (!currentPage || m_searchResults.isEmpty()) {
+    m_searchWidgetRects.resize(m_searchRows.size());
+    if (!currentPage || !m_searchSnapshot || m_searchRows.isEmpty()) {
         return;
     }
 
     QSizeF pageSize = currentPage->pageSizeF();
     QSize widgetSize = size();
 
-    for (SearchResult& result : m_searchResults) {
-        result.transformToWidgetCoordinates(currentScaleFactor, currentRotation,
-                                            pageSize, widgetSize);
+    for (int i = 0; i < m_searchRows.size(); ++i) {
+        // The snapshot is immutable; transform a scratch copy and keep
+        // only the widget-space rectangle
+        SearchResult scratch = m_searchSnapshot->at(m_searchRows.at(i));
+        scratch.transformToWidgetCoordinates(currentScaleFactor,
+                                             currentRotation, pageSize,
+                                             widgetSize);
+        m_searchWidgetRects[i] = scratch.widgetRect;
     }
 }
 
-void PDFPageWidget::drawSearchHighlights(QPainter& painter) {
-    if (m_searchResults.isEmpty()) {
+QRegion PDFPageWidget::searchOverlayRegion() const {
+    QRegion region;
+    for (const QRectF& widgetRect : m_searchWidgetRects) {
+        if (!widgetRect.isEmpty()) {
+            // 当前结果带2px描边，外扩一圈覆盖它
+            region += widgetRect.toAlignedRect().adjusted(-2, -2, 2, 2);
+        }
+    }
+    return region;
+}
+
+QRegion PDFPageWidget::selectionOverlayRegion() const {
+    QRegion region;
+    if (!selectionEngine || contextPageNumber < 0) {
+        return region;
+    }
+    const QVector<QRectF> boxes =
+        selectionEngine->selectionBoxes(contextPageNumber);
+    for (const QRectF& box : boxes) {
+        const QRectF widgetRect = pageRectToWidgetRect(box);
+        if (!widgetRect.isEmpty()) {
+            region += widgetRect.toAlignedRect();
+        }
+    }
+    return region;
+}
+
+void PDFPageWidget::updateSelectionOverlay() {
+    const QRegion fresh = selectionOverlayRegion();
+    update(m_selectionDamage + fresh);
+    m_selectionDamage = fresh;
+}
+
+void PDFPageWidget::drawSearchHighlights(QPainter& painter,
+                                         const QRegion& damage) {
+    if (m_searchRows.isEmpty()) {
         return;
     }
 
     painter.save();
 
-    for (const SearchResult& result : m_searchResults) {
-        if (!result.isValidForHighlight() || result.widgetRect.isEmpty()) {
+    for (int i = 0; i < m_searchRows.size(); ++i) {
+        const QRectF& widgetRect = m_searchWidgetRects.at(i);
+        if (widgetRect.isEmpty() ||
+            !damage.intersects(widgetRect.toAlignedRect())) {
             continue;
         }
 
         // Choose color based on whether this is the current result
-        QColor highlightColor = result.isCurrentResult ? m_currentHighlightColor
-                                                       : m_normalHighlightColor;
+        const bool isCurrent = (m_searchRows.at(i) == m_currentSearchRow);
+        QColor highlightColor =
+            isCurrent ? m_currentHighlightColor : m_normalHighlightColor;
 
         // Draw highlight rectangle
-        painter.fillRect(result.widgetRect, highlightColor);
+        painter.fillRect(widgetRect, highlightColor);
 
         // Draw border for current result
-        if (result.isCurrentResult) {
+        if (isCurrent) {
             painter.setPen(QPen(highlightColor.darker(150), 2));
-            painter.drawRect(result.widgetRect);
+            painter.drawRect(widgetRect);
         }
     }
 
     painter.restore();
 }
 
+QTransform PDFPageWidget::pageTransform(const QSizeF& pageSize) const {
+    // 与SearchResult::transformToWidgetCoordinates同一套变换：
+    // 先旋转（围绕页面中心），再统一缩放，最后居中偏移
+    QTransform transform;
+    const QSize widgetSize = size();
+    const double scaleX = widgetSize.width() / pageSize.width();
+    const double scaleY = widgetSize.height() / pageSize.height();
+    const double uniformScale = qMin(scaleX, scaleY) * currentScaleFactor;
+
+    if (scaleX != scaleY) {
+        transform.translate(
+            (widgetSize.width() - pageSize.width() * uniformScale) / 2.0,
+            (widgetSize.height() - pageSize.height() * uniformScale) / 2.0);
+    }
+    transform.scale(uniformScale, uniformScale);
+
+    const QPointF center(pageSize.width() / 2.0, pageSize.height() / 2.0);
+    switch (currentRotation) {
+        case 90:
+            transform.translate(center.x(), center.y());
+            transform.rotate(90);
+            transform.translate(-center.y(), -center.x());
+            break;
+        case 180:
+            transform.translate(center.x(), center.y());
+            transform.rotate(180);
+            transform.translate(-center.x(), -center.y());
+            break;
+        case 270:
+            transform.translate(center.x(), center.y());
+            transform.rotate(270);
+            transform.translate(-center.y(), -center.x());
+            break;
+        default:
+            break;
+    }
+    return transform;
+}
+
+QRectF PDFPageWidget::pageRectToWidgetRect(const QRectF& pageRect) const {
+    if (!currentPage || pageRect.isEmpty()) {
+        return QRectF();
+    }
+    const QSizeF pageSize = currentPage->pageSizeF();
+    // PDF坐标原点在左下角，先翻转到Qt的左上角坐标系
+    const QRectF qtRect(pageRect.left(), pageSize.height() - pageRect.bottom(),
+                        pageRect.width(), pageRect.height());
+    return pageTransform(pageSize).mapRect(qtRect);
+}
+
+QPointF PDFPageWidget::widgetToPagePoint(const QPoint& widgetPoint) const {
+    if (!currentPage) {
+        return QPointF(-1, -1);
+    }
+    const QSizeF pageSize = currentPage->pageSizeF();
+    const QTransform transform = pageTransform(pageSize);
+    if (!transform.isInvertible()) {
+        return QPointF(-1, -1);
+    }
+    const QPointF qtPoint = transform.inverted().map(QPointF(widgetPoint));
+    return QPointF(qtPoint.x(), pageSize.height() - qtPoint.y());
+}
+
+void PDFPageWidget::drawTextSelection(QPainter& painter,
+                                      const QRegion& damage) {
+    if (!selectionEngine || contextPageNumber < 0) {
+        return;
+    }
+    const QVector<QRectF> boxes =
+        selectionEngine->selectionBoxes(contextPageNumber);
+    if (boxes.isEmpty()) {
+        return;
+    }
+
+    painter.save();
+    const QColor selectionColor(0, 120, 215, 90);
+    for (const QRectF& box : boxes) {
+        const QRectF widgetRect = pageRectToWidgetRect(box);
+        if (!widgetRect.isEmpty() &&
+            damage.intersects(widgetRect.toAlignedRect())) {
+            painter.fillRect(widgetRect, selectionColor);
+        }
+    }
+    painter.restore();
+}
+
 // PDFViewer Implementation
 PDFViewer::PDFViewer(QWidget* parent, bool enableStyling)
     : QWidget(parent),
@@ -484,8 +1128,16 @@ PDFViewer::PDFViewer(QWidget* parent, bool enableStyling)
       currentRotation(0),
       pendingZoomFactor(DEFAULT_ZOOM),
       isZoomPending(false),
-      m_currentSearchResultIndex(-1),
+      m_searchModel(nullptr),
       m_enableStyling(enableStyling) {
+    // 注册无障碍工厂（进程内一次）：屏幕阅读器拿到的文本接口由
+    // 后台文本索引支撑，与搜索共用同一条快路径，不做同步整页抽取
+    static const bool accessibleFactoryInstalled = [] {
+        QAccessible::installFactory(&PDFViewerAccessible::factory);
+        return true;
+    }();
+    Q_UNUSED(accessibleFactoryInstalled)
+
     // 初始化动画管理器
     animationManager = new PDFAnimationManager(this);
 
@@ -494,6 +1146,9 @@ PDFViewer::PDFViewer(QWidget* parent, bool enableStyling)
     prerenderer->setStrategy(PDFPrerenderer::PrerenderStrategy::Balanced);
     prerenderer->setMaxWorkerThreads(2);  // Use 2 background threads
 
+    // 初始化文字选择引擎（文字层索引在setupConnections中注入）
+    selectionEngine = new TextSelectionEngine(this);
+
 #ifdef ENABLE_QGRAPHICS_PDF_SUPPORT
     // 初始化QGraphics PDF查看器
     qgraphicsViewer = nullptr;
@@ -509,14 +1164,23 @@ PDFViewer::PDFViewer(QWidget* parent, bool enableStyling)
     zoomTimer->setInterval(150);  // 150ms防抖延迟
 
     // 初始化虚拟化渲染
-    visiblePageStart = 0;
-    visiblePageEnd = 0;
-    renderBuffer = 2;  // 预渲染前后2页
+    visiblePageStart = -1;
+    visiblePageEnd = -1;
+    renderBuffer = 2;  // 视口前后各实体化2页
+    lastContinuousScrollValue = 0;
 
     scrollTimer = new QTimer(this);
     scrollTimer->setSingleShot(true);
     scrollTimer->setInterval(100);  // 100ms滚动防抖
 
+    // 按键重复合并导航：停顿判定计时器，超时提交目标页的清晰渲染
+    m_navTargetPage = -1;
+    m_navSettleTimer = new QTimer(this);
+    m_navSettleTimer->setSingleShot(true);
+    m_navSettleTimer->setInterval(NAV_SETTLE_MS);
+    connect(m_navSettleTimer, &QTimer::timeout, this,
+            &PDFViewer::commitNavTarget);
+
     // 初始化页面缓存
     maxCacheSize = 20;  // 最多缓存20页
 
@@ -715,6 +1379,7 @@ void PDFViewer::setupViewModes() {
     // 创建单页视图
     singlePageScrollArea = new QScrollArea(this);
     singlePageWidget = new PDFPageWidget(singlePageScrollArea);
+    singlePageWidget->setSelectionEngine(selectionEngine);
     singlePageScrollArea->setWidget(singlePageWidget);
     singlePageScrollArea->setWidgetResizable(true);
     singlePageScrollArea->setAlignment(Qt::AlignCenter);
@@ -802,12 +1467,51 @@ void PDFViewer::setupConnections() {
 
         // Connect search model signals for real-time highlighting
         if (searchWidget->getSearchModel()) {
-            connect(searchWidget->getSearchModel(),
-                    &SearchModel::realTimeResultsUpdated, this,
+            m_searchModel = searchWidget->getSearchModel();
+            connect(m_searchModel, &SearchModel::realTimeResultsUpdated, this,
                     &PDFViewer::setSearchResults);
+
+            // Streamed results: each merged shard lands as a rowsInserted
+            // range; only the pages in that range repaint, so highlights
+            // appear while the search is still running
+            connect(m_searchModel, &SearchModel::rowsInserted, this,
+                    &PDFViewer::onSearchResultsStreamed);
+            connect(m_searchModel, &SearchModel::currentResultChanged, this,
+                    [this](int) {
+                        updateSearchHighlightsForCurrentPage();
+                        // 结果步进可预测：提前渲染相邻结果所在的页
+                        prefetchAdjacentSearchResults();
+                    });
+            connect(m_searchModel, &SearchModel::resultsCleared, this,
+                    &PDFViewer::clearSearchHighlights);
+
+            // 选择引擎复用搜索模型的后台文字层索引
+            selectionEngine->setTextIndex(m_searchModel->textIndex());
+
+            // 链接层与文字层同一后台索引；页面组件据此在事件
+            // 路径上做悬停与点击命中
+            singlePageWidget->setTextIndex(m_searchModel->textIndex());
         }
     }
 
+    // 选区变化时按脏区重绘相关页面组件；复制完成后写入剪贴板
+    connect(selectionEngine, &TextSelectionEngine::selectionChanged, this,
+            [this]() {
+                if (singlePageWidget) {
+                    singlePageWidget->updateSelectionOverlay();
+                }
+                for (PDFPageWidget* pageWidget :
+                     std::as_const(activeContinuousPages)) {
+                    pageWidget->updateSelectionOverlay();
+                }
+            });
+    connect(selectionEngine, &TextSelectionEngine::selectedTextReady, this,
+            [](const QString& text) {
+                if (!text.isEmpty()) {
+                    QGuiApplication::clipboard()->setText(text);
+                }
+            });
+
     // 防抖定时器
     connect(zoomTimer, &QTimer::timeout, this, &PDFViewer::onZoomTimerTimeout);
     connect(scrollTimer, &QTimer::timeout, this, &PDFViewer::onScrollChanged);
@@ -820,6 +1524,8 @@ void PDFViewer::setupConnections() {
     // 页面组件信号
     connect(singlePageWidget, &PDFPageWidget::scaleChanged, this,
             &PDFViewer::onScaleChanged);
+    connect(singlePageWidget, &PDFPageWidget::linkActivated, this,
+            &PDFViewer::goToPage);
 }
 
 void PDFViewer::setupShortcuts() {
@@ -983,6 +1689,14 @@ void PDFViewer::setupShortcuts() {
             singlePageWidget->renderPage();
         }
     });
+
+    // 复制选中文字：文本拼装在后台完成，结果经
+    // selectedTextReady写入剪贴板
+    connect(copyText, &QShortcut::activated, this, [this]() {
+        if (selectionEngine && selectionEngine->hasSelection()) {
+            selectionEngine->requestSelectedText();
+        }
+    });
 }
 
 void PDFViewer::setDocument(Poppler::Document* doc) {
@@ -996,6 +1710,33 @@ void PDFViewer::setDocument(Poppler::Document* doc) {
         currentPageNumber = 0;
         currentRotation = 0;  // 重置旋转
 
+        // 丢弃旧文档上挂起的合并导航
+        m_navTargetPage = -1;
+        m_navSettleTimer->stop();
+
+        // 选区引用旧文档的文字层，切换文档时必须清掉
+        if (selectionEngine) {
+            selectionEngine->clearSelection();
+        }
+
+        // 释放旧文档的连续模式页面组件与保活的页面句柄
+        const QList<int> activePages = activeContinuousPages.keys();
+        for (int page : activePages) {
+            dematerializeContinuousPage(page);
+        }
+        activeContinuousPageHandles.clear();
+        continuousPagePointSizes.clear();
+
+        // 预渲染器与查看器共享同一文档，供连续模式的方向感知预取使用
+        if (prerenderer) {
+            prerenderer->setDocument(document);
+            if (document) {
+                prerenderer->startPrerendering();
+            } else {
+                prerenderer->stopPrerendering();
+            }
+        }
+
         if (document) {
             // Configure document for high-quality rendering
             document->setRenderHint(Poppler::Document::Antialiasing, true);
@@ -1098,6 +1839,10 @@ bool PDFViewer::goToPageWithValidation(int pageNumber, bool showMessage) {
         return false;
     }
 
+    // 换页SLO计时起点：所有导航入口（上一页/下一页、快捷键、
+    // 页码框、缩略图点击）都汇聚到这里
+    PageTurnSlo::instance().beginTurn(pageNumber);
+
     currentPageNumber = pageNumber;
     pageNumberSpinBox->setValue(pageNumber + 1);
 
@@ -1119,6 +1864,23 @@ bool PDFViewer::goToPageWithValidation(int pageNumber, bool showMessage) {
 
     emit pageChanged(pageNumber);
 
+    // 屏幕阅读器活跃时：当前页与相邻页的文本抽取提升到预取优先
+    // 级（焦点到达时文本已在索引里），并通知无障碍层换页，让阅读
+    // 器重新拉取名称与文本
+    if (QAccessible::isActive()) {
+        if (m_searchModel && m_searchModel->textIndex()) {
+            DocumentTextIndex* index = m_searchModel->textIndex();
+            index->prioritizePage(pageNumber);
+            index->prioritizePage(pageNumber - 1);
+            index->prioritizePage(pageNumber + 1);
+        }
+        QAccessibleEvent nameEvent(this, QAccessible::NameChanged);
+        QAccessible::updateAccessibility(&nameEvent);
+        QAccessibleTextUpdateEvent textEvent(this, 0, QString(),
+                                             accessiblePageText());
+        QAccessible::updateAccessibility(&textEvent);
+    }
+
     if (showMessage) {
         setMessage(QString("跳转到第 %1 页").arg(pageNumber + 1));
     }
@@ -1126,15 +1888,81 @@ bool PDFViewer::goToPageWithValidation(int pageNumber, bool showMessage) {
     return true;
 }
 
-void PDFViewer::nextPage() {
-    if (document && currentPageNumber < document->numPages() - 1) {
-        goToPage(currentPageNumber + 1);
+void PDFViewer::nextPage() { stepPage(1); }
+
+void PDFViewer::previousPage() { stepPage(-1); }
+
+void PDFViewer::stepPage(int delta) {
+    if (!document || document->numPages() <= 0) {
+        return;
+    }
+
+    const int base = m_navTargetPage >= 0 ? m_navTargetPage : currentPageNumber;
+    const int target = qBound(0, base + delta, document->numPages() - 1);
+
+    // 单次按键（距上次步进超出连发窗口且无挂起目标）：保持原有
+    // 的立即换页路径
+    const bool rapid = m_navLastStep.isValid() &&
+                       m_navLastStep.elapsed() < NAV_REPEAT_WINDOW_MS;
+    m_navLastStep.restart();
+    if (!rapid && m_navTargetPage < 0) {
+        if (target != currentPageNumber) {
+            m_navLastCommit.restart();
+            goToPage(target);
+        }
+        return;
+    }
+
+    // 连发：只推进目标页与轻量UI，清晰渲染按间隔节流或等停顿
+    m_navTargetPage = target;
+    showNavPreview(target);
+    if (!m_navLastCommit.isValid() ||
+        m_navLastCommit.elapsed() >= NAV_COMMIT_INTERVAL_MS) {
+        commitNavTarget();
+    } else {
+        m_navSettleTimer->start();
     }
 }
 
-void PDFViewer::previousPage() {
-    if (document && currentPageNumber > 0) {
-        goToPage(currentPageNumber - 1);
+void PDFViewer::commitNavTarget() {
+    if (m_navTargetPage < 0) {
+        return;
+    }
+    const int target = m_navTargetPage;
+    m_navTargetPage = -1;
+    m_navSettleTimer->stop();
+    m_navLastCommit.restart();
+    goToPage(target);
+}
+
+void PDFViewer::showNavPreview(int pageNumber) {
+    // 轻量路径：页码UI与pageChanged订阅方（状态栏、缩略图高亮）
+    // 每步都跟随，但不触碰Poppler
+    currentPageNumber = pageNumber;
+    pageNumberSpinBox->blockSignals(true);
+    pageNumberSpinBox->setValue(pageNumber + 1);
+    pageNumberSpinBox->blockSignals(false);
+    updateNavigationButtons();
+    emit pageChanged(pageNumber);
+
+    if (currentViewMode != PDFViewMode::SinglePage) {
+        return;
+    }
+
+    // 中间帧：优先本视图缓存的当前缩放清晰帧，其次预渲染缓存；
+    // 都没有就保留上一帧，停顿提交时自然刷新
+    QPixmap cached =
+        getCachedPage(pageNumber, currentZoomFactor, currentRotation);
+    if (!cached.isNull()) {
+        singlePageWidget->setPixmap(cached);
+        return;
+    }
+    if (prerenderer) {
+        QImage prerendered = prerenderer->getCachedPage(
+            pageNumber, currentZoomFactor, currentRotation);
+        if (!prerendered.isNull()) {
+            singlePageWidget->setPixmap(QPixmap::fromImage(prerendered));
+        }
     }
 }
 
@@ -1212,6 +2040,20 @@ int PDFViewer::getPageCount() const {
 
 double PDFViewer::getCurrentZoom() const { return currentZoomFactor; }
 
+QString PDFViewer::accessiblePageText() const {
+    if (!document || !m_searchModel || !m_searchModel->textIndex()) {
+        return QString();
+    }
+    DocumentTextIndex* index = m_searchModel->textIndex();
+    // 未索引到的页面不做同步抽取：先把它插到预取优先级，索引
+    // 完成后的换页/焦点事件会让阅读器重新拉取
+    if (!index->isPageIndexed(currentPageNumber)) {
+        index->prioritizePage(currentPageNumber);
+        return QString();
+    }
+    return index->pageText(currentPageNumber);
+}
+
 void PDFViewer::updatePageDisplay() {
     if (!document || currentPageNumber < 0 ||
         currentPageNumber >= document->numPages()) {
@@ -1233,6 +2075,7 @@ void PDFViewer::updatePageDisplay() {
 
         std::unique_ptr<Poppler::Page> page(document->page(currentPageNumber));
         if (page) {
+            singlePageWidget->setDocumentContext(document, currentPageNumber);
             singlePageWidget->setPage(page.get(), currentZoomFactor,
                                       currentRotation);
         }
@@ -1245,20 +2088,18 @@ void PDFViewer::updateContinuousView() {
         return;
     }
 
-    // 优化：只更新缩放因子，避免重新渲染所有页面
-    for (int i = 0; i < continuousLayout->count() - 1;
-         ++i) {  // -1 因为最后一个是stretch
-        QLayoutItem* item = continuousLayout->itemAt(i);
-        if (item && item->widget()) {
-            PDFPageWidget* pageWidget =
-                qobject_cast<PDFPageWidget*>(item->widget());
-            if (pageWidget) {
-                // 阻止信号发出，避免循环
-                pageWidget->blockSignals(true);
-                pageWidget->setScaleFactor(currentZoomFactor);
-                pageWidget->blockSignals(false);
-            }
-        }
+    // 占位组件按新缩放调整尺寸，保持滚动高度与滚动位置比例正确
+    for (int i = 0; i < continuousPlaceholders.size(); ++i) {
+        continuousPlaceholders[i]->setFixedSize(continuousPageDisplaySize(i));
+    }
+
+    // 只更新已实体化页面的缩放因子，窗口外的页面在进入视口时
+    // 自然以新缩放渲染
+    for (PDFPageWidget* pageWidget : std::as_const(activeContinuousPages)) {
+        // 阻止信号发出，避免循环
+        pageWidget->blockSignals(true);
+        pageWidget->setScaleFactor(currentZoomFactor);
+        pageWidget->blockSignals(false);
     }
 }
 
@@ -1415,41 +2256,56 @@ void PDFViewer::createContinuousPages() {
     if (!document)
         return;
 
-    // 清空现有页面
+    // 回收已实体化的页面组件，再清空旧的占位组件
+    const QList<int> activePages = activeContinuousPages.keys();
+    for (int page : activePages) {
+        dematerializeContinuousPage(page);
+    }
+
     QLayoutItem* item;
     while ((item = continuousLayout->takeAt(0)) != nullptr) {
         delete item->widget();
         delete item;
     }
+    continuousPlaceholders.clear();
 
-    // 创建所有页面
-    for (int i = 0; i < document->numPages(); ++i) {
-        PDFPageWidget* pageWidget = new PDFPageWidget(continuousWidget);
-
+    // 缓存每页尺寸（仅读元数据，不触发渲染）
+    const int numPages = document->numPages();
+    continuousPagePointSizes.clear();
+    continuousPagePointSizes.reserve(numPages);
+    for (int i = 0; i < numPages; ++i) {
         std::unique_ptr<Poppler::Page> page(document->page(i));
-        if (page) {
-            // 阻止信号发出，避免在初始化时触发缩放循环
-            pageWidget->blockSignals(true);
-            pageWidget->setPage(page.get(), currentZoomFactor, currentRotation);
-            pageWidget->blockSignals(false);
-        }
-
-        continuousLayout->addWidget(pageWidget);
-
-        // 连接信号
-        connect(pageWidget, &PDFPageWidget::scaleChanged, this,
-                &PDFViewer::onScaleChanged);
+        continuousPagePointSizes.append(page ? page->pageSizeF()
+                                             : QSizeF(595, 842));  // A4兜底
     }
 
+    // 每页插入一个轻量占位组件撑起滚动高度；PDFPageWidget只在页面
+    // 进入视口窗口时实体化（见materializeContinuousPage），2000页的
+    // 文档也只持有窗口内的几个渲染组件
+    continuousPlaceholders.reserve(numPages);
+    for (int i = 0; i < numPages; ++i) {
+        QWidget* placeholder = new QWidget(continuousWidget);
+        placeholder->setFixedSize(continuousPageDisplaySize(i));
+        continuousLayout->addWidget(placeholder);
+        continuousPlaceholders.append(placeholder);
+    }
     continuousLayout->addStretch();
 
-    // 连接滚动区域的滚动信号以实现虚拟化渲染
+    // 连接滚动区域的滚动信号以实现虚拟化渲染（先断开避免重复连接）
     if (continuousScrollArea->verticalScrollBar()) {
+        disconnect(continuousScrollArea->verticalScrollBar(),
+                   &QScrollBar::valueChanged, this, nullptr);
         connect(continuousScrollArea->verticalScrollBar(),
                 &QScrollBar::valueChanged, this, [this]() {
                     scrollTimer->start();  // 使用防抖
                 });
+        lastContinuousScrollValue =
+            continuousScrollArea->verticalScrollBar()->value();
     }
+
+    visiblePageStart = -1;
+    visiblePageEnd = -1;
+    updateVisiblePages();
 }
 
 void PDFViewer::updateVisiblePages() {
@@ -1461,31 +2317,50 @@ void PDFViewer::updateVisiblePages() {
     if (!scrollBar)
         return;
 
-    int viewportHeight = continuousScrollArea->viewport()->height();
-    int scrollValue = scrollBar->value();
-
-    // 估算可见页面范围
-    int totalPages = document->numPages();
-    if (totalPages == 0)
+    const int totalPages = document->numPages();
+    if (totalPages == 0 || continuousPlaceholders.size() != totalPages)
         return;
 
-    // 简化计算：假设所有页面高度相似
-    int estimatedPageHeight = viewportHeight;  // 粗略估算
-    if (continuousLayout->count() > 1) {
-        QLayoutItem* firstItem = continuousLayout->itemAt(0);
-        if (firstItem && firstItem->widget()) {
-            estimatedPageHeight = firstItem->widget()->height();
+    const int viewportHeight = continuousScrollArea->viewport()->height();
+    const int scrollValue = scrollBar->value();
+
+    // 确保布局几何有效后，用布局项的实际位置二分定位视口区间
+    continuousLayout->activate();
+    auto itemTop = [this](int i) {
+        return continuousLayout->itemAt(i)->geometry().top();
+    };
+
+    // 第一个底边进入视口的页面
+    int lo = 0, hi = totalPages - 1;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (continuousLayout->itemAt(mid)->geometry().bottom() < scrollValue) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    const int firstVisible = lo;
+
+    // 最后一个顶边仍在视口内的页面
+    lo = firstVisible;
+    hi = totalPages - 1;
+    while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if (itemTop(mid) <= scrollValue + viewportHeight) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
         }
     }
+    const int lastVisible = lo;
 
-    if (estimatedPageHeight <= 0)
-        estimatedPageHeight = viewportHeight;
+    const int newVisibleStart = qMax(0, firstVisible - renderBuffer);
+    const int newVisibleEnd = qMin(totalPages - 1, lastVisible + renderBuffer);
 
-    int newVisibleStart =
-        qMax(0, (scrollValue / estimatedPageHeight) - renderBuffer);
-    int newVisibleEnd = qMin(
-        totalPages - 1,
-        ((scrollValue + viewportHeight) / estimatedPageHeight) + renderBuffer);
+    // 滚动方向：沿该方向做窗口外预取
+    const int direction = scrollValue >= lastContinuousScrollValue ? 1 : -1;
+    lastContinuousScrollValue = scrollValue;
 
     // 如果可见范围发生变化，更新渲染
     if (newVisibleStart != visiblePageStart ||
@@ -1493,6 +2368,19 @@ void PDFViewer::updateVisiblePages() {
         visiblePageStart = newVisibleStart;
         visiblePageEnd = newVisibleEnd;
         renderVisiblePages();
+
+        // 方向感知预取：窗口外沿滚动方向的几页交给预渲染器暖缓存，
+        // 页面进入窗口时materializeContinuousPage直接命中
+        if (prerenderer) {
+            for (int k = 1; k <= renderBuffer + 1; ++k) {
+                int page = direction > 0 ? newVisibleEnd + k
+                                         : newVisibleStart - k;
+                if (page >= 0 && page < totalPages) {
+                    prerenderer->requestPrerender(page, currentZoomFactor,
+                                                  currentRotation, 3 + k);
+                }
+            }
+        }
     }
 }
 
@@ -1501,21 +2389,113 @@ void PDFViewer::renderVisiblePages() {
         return;
     }
 
-    // 这里可以实现更复杂的虚拟化逻辑
-    // 目前保持简单的实现，只在需要时更新页面
-    for (int i = 0; i < continuousLayout->count() - 1; ++i) {
-        QLayoutItem* item = continuousLayout->itemAt(i);
-        if (item && item->widget()) {
-            PDFPageWidget* pageWidget =
-                qobject_cast<PDFPageWidget*>(item->widget());
-            if (pageWidget) {
-                // 只渲染可见范围内的页面
-                bool shouldRender =
-                    (i >= visiblePageStart && i <= visiblePageEnd);
-                pageWidget->setVisible(shouldRender);
+    // 回收滑出窗口的页面组件
+    const QList<int> activePages = activeContinuousPages.keys();
+    for (int page : activePages) {
+        if (page < visiblePageStart || page > visiblePageEnd) {
+            dematerializeContinuousPage(page);
+        }
+    }
+
+    // 实体化进入窗口的页面
+    for (int page = visiblePageStart; page <= visiblePageEnd; ++page) {
+        if (!activeContinuousPages.contains(page)) {
+            materializeContinuousPage(page);
+        }
+    }
+}
+
+void PDFViewer::materializeContinuousPage(int pageNumber) {
+    if (!document || pageNumber < 0 ||
+        pageNumber >= continuousPlaceholders.size()) {
+        return;
+    }
+
+    // 优先从对象池取回收的组件，避免反复构造带阴影效果的QLabel
+    PDFPageWidget* pageWidget = nullptr;
+    if (!continuousPageWidgetPool.isEmpty()) {
+        pageWidget = continuousPageWidgetPool.takeLast();
+    } else {
+        pageWidget = new PDFPageWidget(continuousWidget);
+        pageWidget->setSelectionEngine(selectionEngine);
+        if (m_searchModel) {
+            pageWidget->setTextIndex(m_searchModel->textIndex());
+        }
+        connect(pageWidget, &PDFPageWidget::scaleChanged, this,
+                &PDFViewer::onScaleChanged);
+        connect(pageWidget, &PDFPageWidget::linkActivated, this,
+                &PDFViewer::goToPage);
+    }
+
+    QWidget* placeholder = continuousPlaceholders[pageNumber];
+    continuousLayout->replaceWidget(placeholder, pageWidget,
+                                    Qt::FindDirectChildrenOnly);
+    placeholder->hide();
+    pageWidget->show();
+
+    // 阻止信号发出，避免初始化时触发缩放循环
+    pageWidget->blockSignals(true);
+    pageWidget->setDocumentContext(document, pageNumber);
+    std::unique_ptr<Poppler::Page> page(document->page(pageNumber));
+    if (page) {
+        pageWidget->setPage(page.get(), currentZoomFactor, currentRotation);
+
+        // 预渲染缓存命中时立即贴上清晰帧，跳过低清预览阶段
+        if (prerenderer) {
+            QImage cached = prerenderer->getCachedPage(
+                pageNumber, currentZoomFactor, currentRotation);
+            if (!cached.isNull()) {
+                pageWidget->setRenderedImage(cached);
             }
         }
     }
+    pageWidget->blockSignals(false);
+
+    // 组件内部保存裸页面指针，句柄由查看器保活到页面回收为止
+    activeContinuousPageHandles[pageNumber] = std::move(page);
+
+    // 恢复该页的搜索高亮（共享模型快照，组件只持本页行号视图）
+    if (m_searchModel && m_searchModel->hasResultsOnPage(pageNumber)) {
+        pageWidget->setSearchSnapshot(m_searchModel->resultSnapshot(),
+                                      pageNumber,
+                                      m_searchModel->getCurrentResultIndex());
+    }
+
+    activeContinuousPages[pageNumber] = pageWidget;
+}
+
+void PDFViewer::dematerializeContinuousPage(int pageNumber) {
+    PDFPageWidget* pageWidget = activeContinuousPages.take(pageNumber);
+    if (!pageWidget) {
+        return;
+    }
+
+    QWidget* placeholder = continuousPlaceholders.value(pageNumber, nullptr);
+    if (placeholder) {
+        continuousLayout->replaceWidget(pageWidget, placeholder,
+                                        Qt::FindDirectChildrenOnly);
+        placeholder->show();
+    }
+    pageWidget->hide();
+    pageWidget->clearSearchHighlights();
+    activeContinuousPageHandles.erase(pageNumber);
+
+    if (continuousPageWidgetPool.size() < CONTINUOUS_POOL_MAX) {
+        continuousPageWidgetPool.append(pageWidget);
+    } else {
+        pageWidget->deleteLater();
+    }
+}
+
+QSize PDFViewer::continuousPageDisplaySize(int pageNumber) const {
+    QSizeF points =
+        continuousPagePointSizes.value(pageNumber, QSizeF(595, 842));
+    if (currentRotation == 90 || currentRotation == 270) {
+        points.transpose();
+    }
+    // 72dpi基准下，显示像素 = 点数 × 缩放因子
+    return QSize(qMax(1, qRound(points.width() * currentZoomFactor)),
+                 qMax(1, qRound(points.height() * currentZoomFactor)));
 }
 
 void PDFViewer::onScrollChanged() {
@@ -1605,29 +2585,32 @@ void PDFViewer::toggleTheme() {
         themeToggleBtn->setToolTip("切换到暗色主题 (Ctrl+T)");
     }
 
-    // 重新应用样式
-    setStyleSheet(STYLE.getApplicationStyleSheet());
-
-    // 更新所有子组件的样式
-    QString buttonStyle = STYLE.getButtonStyleSheet();
-    firstPageBtn->setStyleSheet(buttonStyle);
-    prevPageBtn->setStyleSheet(buttonStyle);
-    nextPageBtn->setStyleSheet(buttonStyle);
-    lastPageBtn->setStyleSheet(buttonStyle);
-    zoomOutBtn->setStyleSheet(buttonStyle);
-    zoomInBtn->setStyleSheet(buttonStyle);
-    fitWidthBtn->setStyleSheet(buttonStyle);
-    fitHeightBtn->setStyleSheet(buttonStyle);
-    fitPageBtn->setStyleSheet(buttonStyle);
-    rotateLeftBtn->setStyleSheet(buttonStyle);
-    rotateRightBtn->setStyleSheet(buttonStyle);
-    themeToggleBtn->setStyleSheet(buttonStyle);
+    // 亮暗切换快路径：顶层换调色板即可传播到整棵子树，代价远低于
+    // 原先setStyleSheet(getApplicationStyleSheet())触发的全树重新polish
+    // （文档多开时那一步会卡顿一秒）
+    setPalette(STYLE.themePalette());
+
+    // 子组件只重设两主题间片段真正变化的样式表；相同片段整类跳过
+    if (STYLE.sectionDiffers(StyleSection::Button, currentTheme, newTheme)) {
+        const QString buttonStyle = STYLE.getButtonStyleSheet();
+        const auto buttons = {firstPageBtn,   prevPageBtn,   nextPageBtn,
+                              lastPageBtn,    zoomOutBtn,    zoomInBtn,
+                              fitWidthBtn,    fitHeightBtn,  fitPageBtn,
+                              rotateLeftBtn,  rotateRightBtn, themeToggleBtn};
+        for (QPushButton* button : buttons) {
+            StyleManager::applyStyleSheetIfChanged(button, buttonStyle);
+        }
+    }
 
-    // 更新滚动区域样式
-    QString scrollStyle =
-        STYLE.getPDFViewerStyleSheet() + STYLE.getScrollBarStyleSheet();
-    singlePageScrollArea->setStyleSheet(scrollStyle);
-    continuousScrollArea->setStyleSheet(scrollStyle);
+    if (STYLE.sectionDiffers(StyleSection::PDFViewer, currentTheme, newTheme) ||
+        STYLE.sectionDiffers(StyleSection::ScrollBar, currentTheme, newTheme)) {
+        const QString scrollStyle =
+            STYLE.getPDFViewerStyleSheet() + STYLE.getScrollBarStyleSheet();
+        StyleManager::applyStyleSheetIfChanged(singlePageScrollArea,
+                                               scrollStyle);
+        StyleManager::applyStyleSheetIfChanged(continuousScrollArea,
+                                               scrollStyle);
+    }
 
     setMessage(QString("已切换到%1主题")
                    .arg(newTheme == Theme::Dark ? "暗色" : "亮色"));
@@ -1739,10 +2722,17 @@ void PDFViewer::applyZoom(double factor) {
         } else {
 #endif
             if (currentViewMode == PDFViewMode::SinglePage) {
-                // 阻止信号发出，避免循环
-                singlePageWidget->blockSignals(true);
-                singlePageWidget->setScaleFactor(factor);
-                singlePageWidget->blockSignals(false);
+                // 平滑缩放：动画中间帧只缩放已渲染位图（不触碰
+                // Poppler），结束后才请求一次终点清晰渲染；复杂页面
+                // 上缩放不再被逐帧重渲染卡住。提交时scaleChanged携带
+                // 的值等于currentZoomFactor，onScaleChanged不会成环
+                if (animationManager) {
+                    animationManager->animateZoom(
+                        singlePageWidget, singlePageWidget->getScaleFactor(),
+                        factor, AnimationUtils::FAST_DURATION);
+                } else {
+                    singlePageWidget->setScaleFactor(factor);
+                }
             } else {
                 updateContinuousView();
             }
@@ -1877,14 +2867,21 @@ void PDFViewer::setRotation(int degrees) {
                 if (currentViewMode == PDFViewMode::SinglePage) {
                     if (currentPageNumber >= 0 &&
                         currentPageNumber < document->numPages()) {
-                        std::unique_ptr<Poppler::Page> page(
-                            document->page(currentPageNumber));
-                        if (page) {
-                            singlePageWidget->setPage(
-                                page.get(), currentZoomFactor, currentRotation);
+                        if (singlePageWidget->hasFullPageFrame()) {
+                            // 变换快路径：现有整页帧原地转90度即时
+                            // 显示，清晰帧由渲染池在后台替换
+                            singlePageWidget->setRotation(currentRotation);
                         } else {
-                            throw std::runtime_error(
-                                "Failed to get page for rotation");
+                            std::unique_ptr<Poppler::Page> page(
+                                document->page(currentPageNumber));
+                            if (page) {
+                                singlePageWidget->setPage(page.get(),
+                                                          currentZoomFactor,
+                                                          currentRotation);
+                            } else {
+                                throw std::runtime_error(
+                                    "Failed to get page for rotation");
+                            }
                         }
                     }
                 } else {
@@ -1911,40 +2908,23 @@ void PDFViewer::updateContinuousViewRotation() {
         return;
     }
 
-    int successCount = 0;
-    int totalPages = continuousLayout->count() - 1;  // -1 因为最后一个是stretch
+    // 占位组件尺寸随旋转调整（90/270度时宽高互换）
+    for (int i = 0; i < continuousPlaceholders.size(); ++i) {
+        continuousPlaceholders[i]->setFixedSize(continuousPageDisplaySize(i));
+    }
 
-    // 更新连续视图中所有页面的旋转
-    for (int i = 0; i < totalPages; ++i) {
+    // 只重渲染已实体化的页面；查看器保活的页面句柄保证指针有效
+    for (auto it = activeContinuousPages.begin();
+         it != activeContinuousPages.end(); ++it) {
         try {
-            QLayoutItem* item = continuousLayout->itemAt(i);
-            if (item && item->widget()) {
-                PDFPageWidget* pageWidget =
-                    qobject_cast<PDFPageWidget*>(item->widget());
-                if (pageWidget && i < document->numPages()) {
-                    std::unique_ptr<Poppler::Page> page(document->page(i));
-                    if (page) {
-                        // 阻止信号发出，避免循环
-                        pageWidget->blockSignals(true);
-                        pageWidget->setPage(page.get(), currentZoomFactor,
-                                            currentRotation);
-                        pageWidget->blockSignals(false);
-                        successCount++;
-                    } else {
-                        qDebug() << "Failed to get page" << i << "for rotation";
-                    }
-                }
-            }
+            // 阻止信号发出，避免循环
+            it.value()->blockSignals(true);
+            it.value()->setRotation(currentRotation);
+            it.value()->blockSignals(false);
         } catch (const std::exception& e) {
-            qDebug() << "Error rotating page" << i << ":" << e.what();
+            qDebug() << "Error rotating page" << it.key() << ":" << e.what();
         }
     }
-
-    if (successCount < totalPages) {
-        setMessage(QString("部分页面旋转失败 (%1/%2)")
-                       .arg(successCount)
-                       .arg(totalPages));
-    }
 }
 
 // 搜索功能实现
@@ -2024,16 +3004,17 @@ void PDFViewer::onNavigateToSearchResult(int pageNumber, const QRectF& rect) {
     }
 }
 
-// Search highlighting implementation
+// Search highlighting implementation. The viewer holds no result copy of
+// its own: the model's per-page index is the single store, and widgets
+// fetch their page's slice on demand
 void PDFViewer::setSearchResults(const QList<SearchResult>& results) {
-    m_allSearchResults = results;
+    // Legacy/real-time entry point; the results already live in the
+    // model's arena, so just refresh from there
+    Q_UNUSED(results);
     updateSearchHighlightsForCurrentPage();
 }
 
 void PDFViewer::clearSearchHighlights() {
-    m_allSearchResults.clear();
-    m_currentSearchResultIndex = -1;
-
     // Clear highlights from current page widget
     if (currentViewMode == PDFViewMode::SinglePage && singlePageWidget) {
         singlePageWidget->clearSearchHighlights();
@@ -2053,27 +3034,22 @@ void PDFViewer::clearSearchHighlights() {
 }
 
 void PDFViewer::highlightCurrentSearchResult(const SearchResult& result) {
-    m_currentSearchResultIndex = findSearchResultIndex(result);
+    // The model's current index was already moved by SearchWidget before
+    // this is called; widgets holding the same snapshot only repaint the
+    // old and new current rectangles
+    Q_UNUSED(result);
     updateSearchHighlightsForCurrentPage();
 }
 
 void PDFViewer::updateSearchHighlightsForCurrentPage() {
-    if (m_allSearchResults.isEmpty()) {
+    if (!m_searchModel) {
         return;
     }
 
     if (currentViewMode == PDFViewMode::SinglePage && singlePageWidget) {
-        // Filter results for current page in single-page mode
-        QList<SearchResult> currentPageResults;
-        for (int i = 0; i < m_allSearchResults.size(); ++i) {
-            SearchResult result = m_allSearchResults[i];
-            if (result.pageNumber == currentPageNumber) {
-                // Mark current result if this is the selected one
-                result.isCurrentResult = (i == m_currentSearchResultIndex);
-                currentPageResults.append(result);
-            }
-        }
-        singlePageWidget->setSearchResults(currentPageResults);
+        singlePageWidget->setSearchSnapshot(
+            m_searchModel->resultSnapshot(), currentPageNumber,
+            m_searchModel->getCurrentResultIndex());
 
     } else if (currentViewMode == PDFViewMode::ContinuousScroll) {
         // Apply highlights to all visible pages in continuous mode
@@ -2081,47 +3057,75 @@ void PDFViewer::updateSearchHighlightsForCurrentPage() {
     }
 }
 
-void PDFViewer::updateAllPagesSearchHighlights() {
-    if (m_allSearchResults.isEmpty() ||
-        currentViewMode != PDFViewMode::ContinuousScroll) {
+void PDFViewer::prefetchAdjacentSearchResults() {
+    if (!m_searchModel || !prerenderer || !document) {
         return;
     }
 
-    // Group results by page number
-    QHash<int, QList<SearchResult>> resultsByPage;
-    for (int i = 0; i < m_allSearchResults.size(); ++i) {
-        SearchResult result = m_allSearchResults[i];
-        result.isCurrentResult = (i == m_currentSearchResultIndex);
-        resultsByPage[result.pageNumber].append(result);
+    // 结果列表是有序的，下一次findNext/findPrevious落点可以预测：
+    // 把前后各几个结果所在的页按当前缩放与旋转交给预渲染器。
+    // 高亮几何在结果落账时已算好（arena里带boundingRect），
+    // 这里只需把位图备齐。最近的结果优先级最高
+    const QList<int> pages =
+        m_searchModel->adjacentResultPages(SEARCH_PREFETCH_RESULTS);
+    int priority = 2;
+    for (int page : pages) {
+        if (page != currentPageNumber) {
+            prerenderer->requestPrerender(page, currentZoomFactor,
+                                          currentRotation, priority++);
+        }
     }
+}
 
-    // Apply highlights to each page widget
-    for (int pageNum = 0; pageNum < continuousLayout->count() - 1; ++pageNum) {
-        QLayoutItem* item = continuousLayout->itemAt(pageNum);
-        if (item && item->widget()) {
-            PDFPageWidget* pageWidget =
-                qobject_cast<PDFPageWidget*>(item->widget());
-            if (pageWidget) {
-                if (resultsByPage.contains(pageNum)) {
-                    pageWidget->setSearchResults(resultsByPage[pageNum]);
-                } else {
-                    pageWidget->clearSearchHighlights();
-                }
-            }
+void PDFViewer::updateAllPagesSearchHighlights() {
+    if (!m_searchModel || currentViewMode != PDFViewMode::ContinuousScroll) {
+        return;
+    }
+
+    // Every materialized page widget shares the same snapshot; each one
+    // keeps just its own page's row indices. Pages without hits are
+    // cleared
+    const auto snapshot = m_searchModel->resultSnapshot();
+    const int currentRow = m_searchModel->getCurrentResultIndex();
+    for (auto it = activeContinuousPages.constBegin();
+         it != activeContinuousPages.constEnd(); ++it) {
+        const int pageNum = it.key();
+        PDFPageWidget* pageWidget = it.value();
+        if (m_searchModel->hasResultsOnPage(pageNum)) {
+            pageWidget->setSearchSnapshot(snapshot, pageNum, currentRow);
+        } else {
+            pageWidget->clearSearchHighlights();
         }
     }
 }
 
-int PDFViewer::findSearchResultIndex(const SearchResult& target) {
-    for (int i = 0; i < m_allSearchResults.size(); ++i) {
-        const SearchResult& result = m_allSearchResults[i];
-        if (result.pageNumber == target.pageNumber &&
-            result.startIndex == target.startIndex &&
-            result.length == target.length) {
-            return i;
+void PDFViewer::onSearchResultsStreamed(const QModelIndex& parent, int first,
+                                        int last) {
+    Q_UNUSED(parent);
+    if (!m_searchModel) {
+        return;
+    }
+
+    // Shards merge in page order, so the inserted rows span a contiguous
+    // page range; only widgets inside that range need a refresh
+    const int fromPage = m_searchModel->getResult(first).pageNumber;
+    const int toPage = m_searchModel->getResult(last).pageNumber;
+
+    const auto snapshot = m_searchModel->resultSnapshot();
+    const int currentRow = m_searchModel->getCurrentResultIndex();
+    if (currentViewMode == PDFViewMode::SinglePage && singlePageWidget) {
+        if (currentPageNumber >= fromPage && currentPageNumber <= toPage) {
+            singlePageWidget->setSearchSnapshot(snapshot, currentPageNumber,
+                                                currentRow);
+        }
+    } else if (currentViewMode == PDFViewMode::ContinuousScroll) {
+        for (auto it = activeContinuousPages.constBegin();
+             it != activeContinuousPages.constEnd(); ++it) {
+            if (it.key() >= fromPage && it.key() <= toPage) {
+                it.value()->setSearchSnapshot(snapshot, it.key(), currentRow);
+            }
         }
     }
-    return -1;
 }
 
 // 书签功能实现
@@ -8,6 +8,7 @@
 #include <QDragMoveEvent>
 #include <QDropEvent>
 #include <QEasingCurve>
+#include <QElapsedTimer>
 #include <QEvent>
 #include <QGestureEvent>
 #include <QGraphicsDropShadowEffect>
@@ -28,6 +29,7 @@
 #include <QPoint>
 #include <QPropertyAnimation>
 #include <QPushButton>
+#include <QRegion>
 #include <QScrollArea>
 #include <QShortcut>
 #include <QSlider>
@@ -36,11 +38,14 @@
 #include <QSwipeGesture>
 #include <QTimer>
 #include <QTouchEvent>
+#include <QTransform>
 #include <QUrl>
 #include <QVBoxLayout>
 #include <QWheelEvent>
 #include <QWidget>
 #include <QtGlobal>
+#include <map>
+#include <memory>
 #include "../../model/DocumentModel.h"
 #include "../../model/SearchModel.h"
 #include "PDFAnimations.h"
@@ -51,6 +56,10 @@
 #include "../widgets/SearchWidget.h"
 #include "PDFPrerenderer.h"
 
+class DocumentTextIndex;
+class PageLinkLayer;
+class TextSelectionEngine;
+
 // 页面查看模式枚举
 enum class PDFViewMode {
     SinglePage,       // 单页视图
@@ -70,21 +79,53 @@ class PDFPageWidget : public QLabel {
 
 public:
     PDFPageWidget(QWidget* parent = nullptr);
+    ~PDFPageWidget() override;
     void setPage(Poppler::Page* page, double scaleFactor = 1.0,
                  int rotation = 0);
+    // Lets the widget open its own page handle for the async sharp pass;
+    // the Poppler::Page passed to setPage only lives for that call
+    void setDocumentContext(Poppler::Document* document, int pageNumber);
     void setScaleFactor(double factor);
+    // 平滑缩放动画：中间帧只对已渲染位图做光栅变换，完全不触碰
+    // Poppler；动画结束由commitScaleFactor一次性请求终点清晰渲染
+    void setPreviewScaleFactor(double factor);
+    void commitScaleFactor(double factor);
     void setRotation(int degrees);
+    // 是否持有可做变换派生的整页帧（非裁剪模式）；旋转走变换
+    // 快路径的前提
+    bool hasFullPageFrame() const {
+        return !renderedImage.isNull() && renderedClipRect.isNull();
+    }
     double getScaleFactor() const { return currentScaleFactor; }
     int getRotation() const { return currentRotation; }
     void renderPage();  // Make public for refresh functionality
 
-    // Search highlight management
-    void setSearchResults(const QList<SearchResult>& results);
+    // Accept an already-rendered (e.g. prerendered) frame as an
+    // implicitly-shared QImage; no buffer copy happens until paint
+    void setRenderedImage(const QImage& image);
+
+    // 文字选择：引擎由PDFViewer注入，可跨页共享
+    void setSelectionEngine(TextSelectionEngine* engine);
+
+    // 链接导航：链接层由后台索引与文字层一同抽取，悬停/点击
+    // 只查本页缓存的排序矩形表，事件路径不调用Poppler
+    void setTextIndex(DocumentTextIndex* index);
+
+    // 选区变化时的脏区重绘：只弄脏新旧选区矩形的并集
+    void updateSelectionOverlay();
+
+    // Search highlight management. The widget shares the model's
+    // immutable result snapshot by reference and keeps only its own
+    // page's row indices plus widget-space rectangles; the current
+    // result travels as a snapshot row index, so stepping through
+    // matches copies nothing
+    void setSearchSnapshot(std::shared_ptr<const SearchResultSnapshot> snapshot,
+                           int pageNumber, int currentRow);
     void clearSearchHighlights();
-    void setCurrentSearchResult(int index);
+    void setCurrentSearchRow(int row);
     void updateHighlightColors(const QColor& normalColor,
                                const QColor& currentColor);
-    bool hasSearchResults() const { return !m_searchResults.isEmpty(); }
+    bool hasSearchResults() const { return !m_searchRows.isEmpty(); }
 
 protected:
     void paintEvent(QPaintEvent* event) override;
@@ -106,25 +147,99 @@ protected:
 
 private:
     Poppler::Page* currentPage;
+    Poppler::Document* contextDocument;
+    int contextPageNumber;
+    quint64 renderGeneration;  // Discards sharp passes for stale pages
     double currentScaleFactor;
     int currentRotation;
-    QPixmap renderedPixmap;
+    QImage renderedImage;    // Shared render buffer, owned by the cache
+    QPixmap renderedPixmap;  // Lazily converted from renderedImage on paint
+    bool pixmapDirty;
+
+    // 缩放动画的预览状态：激活时paintEvent按previewScaleFactor/
+    // currentScaleFactor的比例缩放现有位图绘制，跳过高亮/选区覆盖层
+    double previewScaleFactor;
+    bool previewScaleActive;
+
+    // 滚轮缩放合并：高分辨率触控板每秒送来几十个tick，逐tick渲染
+    // 会让队列滚雪球。delta只累积进目标倍率，中间帧纯位图变换，
+    // 停顿一个窗口后才提交一次清晰渲染
+    double wheelZoomTarget;
+    QTimer* wheelZoomCommitTimer;
+    static constexpr int WHEEL_ZOOM_SETTLE_MS = 90;  // 停顿判定窗口
+
+    // 视口裁剪渲染：高倍缩放下整页远大于视口时只渲染可见区域+边距，
+    // 旧裁剪保留在平移缓存里，平移暴露未渲染区域时增量补渲染
+    QRect renderedClipRect;  // renderedImage对应的页面矩形；空=整页
+    QList<QPair<QRect, QPixmap>> panClipCache;  // 最近的相邻裁剪
+    QSize panCacheFullSize;  // 缓存适用的整页逻辑尺寸
+    bool clipRenderScheduled;
+    QRect visiblePageRect(const QSize& fullLogicalSize) const;
+    void setRenderedClip(const QImage& image, const QRect& clipRect,
+                         const QSize& fullLogicalSize);
+    void scheduleClipRender();
+    // 经渲染池请求当前(页, 缩放, 旋转)的清晰整页帧；renderPage的
+    // 第二阶段，旋转变换快路径也直接调用
+    void requestSharpRender();
+    static constexpr int CLIP_MARGIN = 256;        // 裁剪边距（逻辑像素）
+    static constexpr int PAN_CLIP_CACHE_MAX = 6;   // 平移缓存条目上限
+    static constexpr int CLIP_AREA_RATIO = 4;  // 整页/视口面积比阈值
+
+    // 位图缓冲的内存归因：整页/裁剪帧或平移缓存变化时向
+    // MemoryTracker上报差额，OOM排查时能看到页面控件占了多少
+    qint64 m_trackedBufferBytes;
+    void updateBufferAttribution();
     bool isDragging;
     QPoint lastPanPoint;
 
-    // Search highlighting members
-    QList<SearchResult> m_searchResults;
-    int m_currentSearchResultIndex;
+    // 文字选择状态（几何命中在选择引擎里完成，不触碰Poppler）
+    TextSelectionEngine* selectionEngine;
+    bool isSelectingText;
+
+    // 链接命中状态：链接层按页缓存一份共享指针，悬停时的命中
+    // 判定无分配；索引未到达本页前linkAt()直接返回未命中
+    DocumentTextIndex* textIndex;
+    std::shared_ptr<PageLinkLayer> linkLayer;
+    bool linkLayerFetched;  // 已向索引取过本页链接层（可能为空）
+    int hoveredLinkIndex;
+    int pressedLinkIndex;
+    int linkAt(const QPoint& widgetPoint);
+
+    // Search highlighting members: the snapshot is shared with the
+    // model and every other page widget; only the widget-space
+    // rectangles are per-widget state
+    std::shared_ptr<const SearchResultSnapshot> m_searchSnapshot;
+    int m_searchPageNumber;           // Page whose rows this widget holds
+    QVector<int> m_searchRows;        // This page's rows in the snapshot
+    QVector<QRectF> m_searchWidgetRects;  // Transformed per-widget coords
+    int m_currentSearchRow;           // Snapshot row of the current result
     QColor m_normalHighlightColor;
     QColor m_currentHighlightColor;
 
+    // 脏区跟踪：页面栅格保留在renderedPixmap里，高亮/选区是
+    // 覆盖层，变化时只弄脏自身矩形；paintEvent按损伤区域合成，
+    // findNext步进高亮只重绘几千像素而非整页
+    QRegion m_searchDamage;     // 上次绘制的搜索高亮覆盖区域
+    QRegion m_selectionDamage;  // 上次绘制的选区覆盖区域
+    QRegion searchOverlayRegion() const;
+    QRegion selectionOverlayRegion() const;
+
     // Helper methods for highlighting
-    void drawSearchHighlights(QPainter& painter);
+    void drawSearchHighlights(QPainter& painter, const QRegion& damage);
     void updateSearchResultCoordinates();
 
+    // 页面坐标（PDF点）与组件坐标的互换；变换与
+    // SearchResult::transformToWidgetCoordinates保持一致
+    QTransform pageTransform(const QSizeF& pageSize) const;
+    QRectF pageRectToWidgetRect(const QRectF& pageRect) const;
+    QPointF widgetToPagePoint(const QPoint& widgetPoint) const;
+    void drawTextSelection(QPainter& painter, const QRegion& damage);
+
 signals:
     void scaleChanged(double scale);
     void pageClicked(QPoint position);
+    // 点击页内跳转链接（目标页号从0起）；外部URL在组件内直接打开
+    void linkActivated(int pageNumber);
 };
 
 class PDFViewer : public QWidget {
@@ -172,6 +287,7 @@ public:
     void findNext();
     void findPrevious();
     void clearSearch();
+    SearchWidget* getSearchWidget() const { return searchWidget; }
 
     // Search highlighting functionality
     void setSearchResults(const QList<SearchResult>& results);
@@ -198,6 +314,11 @@ public:
     // 消息显示
     void setMessage(const QString& message);
 
+    // 无障碍支持：当前页文本直接取自后台文本索引（与搜索同一条
+    // 快路径）。未索引的页面返回空串并触发优先抽取，而不是同步
+    // 抽取整页。供PDFViewerAccessible调用
+    QString accessiblePageText() const;
+
 #ifdef ENABLE_QGRAPHICS_PDF_SUPPORT
     // QGraphics rendering mode
     void setQGraphicsRenderingEnabled(bool enabled);
@@ -229,6 +350,9 @@ protected:
     void updateVisiblePages();
     void renderVisiblePages();
     void onScrollChanged();
+    void materializeContinuousPage(int pageNumber);
+    void dematerializeContinuousPage(int pageNumber);
+    QSize continuousPageDisplaySize(int pageNumber) const;
 
     // 缓存管理方法
     QPixmap getCachedPage(int pageNumber, double zoomFactor, int rotation);
@@ -244,9 +368,12 @@ protected:
 
     // Search highlighting helper methods
     void updateSearchHighlightsForCurrentPage();
-    int findSearchResultIndex(const SearchResult& target);
     void updateAllPagesSearchHighlights();
 
+    // 结果步进预取：当前结果变化时，把前后若干个结果所在的页
+    // 交给预渲染器按当前缩放暖缓存，findNext落到已渲染好的页上
+    void prefetchAdjacentSearchResults();
+
 private slots:
     void onPageNumberChanged(int pageNumber);
     void onZoomSliderChanged(int value);
@@ -259,6 +386,8 @@ private slots:
     void onSearchRequested(const QString& query, const SearchOptions& options);
     void onSearchResultSelected(const SearchResult& result);
     void onNavigateToSearchResult(int pageNumber, const QRectF& rect);
+    void onSearchResultsStreamed(const QModelIndex& parent, int first,
+                                 int last);
 
 private:
     // UI组件
@@ -304,6 +433,9 @@ private:
     // 搜索控件
     SearchWidget* searchWidget;
 
+    // 文字选择引擎（基于缓存文字层，支持跨页选择）
+    TextSelectionEngine* selectionEngine;
+
     // 文档数据
     Poppler::Document* document;
     int currentPageNumber;
@@ -326,6 +458,33 @@ private:
     int renderBuffer;     // 预渲染缓冲区大小
     QTimer* scrollTimer;  // 滚动防抖定时器
 
+    // 按键重复合并导航：按住Page Down时每秒来约30次重复事件，
+    // 逐次发起清晰渲染只会生产33ms后即作废的帧。连续步进合并为
+    // 一个持续更新的目标页，每步只刷新页码UI并广播pageChanged
+    // （状态栏、缩略图高亮跟随），中间帧从本地缓存/预渲染缓存取
+    // 现成位图，清晰渲染在停顿或节流间隔到期时才提交一次
+    void stepPage(int delta);
+    void commitNavTarget();
+    void showNavPreview(int pageNumber);
+    int m_navTargetPage;          // 合并中的目标页；-1表示无挂起导航
+    QTimer* m_navSettleTimer;     // 停顿判定，超时提交清晰渲染
+    QElapsedTimer m_navLastStep;  // 距上次步进的间隔，判定重复连发
+    QElapsedTimer m_navLastCommit;  // 连发期间按间隔节流提交
+    static constexpr int NAV_REPEAT_WINDOW_MS = 80;   // 连发判定窗口
+    static constexpr int NAV_SETTLE_MS = 120;         // 停顿判定窗口
+    static constexpr int NAV_COMMIT_INTERVAL_MS = 250;  // 连发期提交间隔
+
+    // 连续模式虚拟化：只为视口±renderBuffer页实体化PDFPageWidget，
+    // 其余页面用轻量占位组件撑起滚动高度；滑出窗口的页面组件回收
+    // 到对象池复用，因此组件数量与文档页数无关
+    QList<QSizeF> continuousPagePointSizes;  // 每页尺寸（点，仅元数据）
+    QList<QWidget*> continuousPlaceholders;  // 页号 -> 占位组件
+    QHash<int, PDFPageWidget*> activeContinuousPages;
+    QList<PDFPageWidget*> continuousPageWidgetPool;
+    // 为已实体化页面保持Poppler::Page句柄存活（组件保存裸指针）
+    std::map<int, std::unique_ptr<Poppler::Page>> activeContinuousPageHandles;
+    int lastContinuousScrollValue;  // 判断滚动方向，驱动方向感知预取
+
     // 动画效果
     QPropertyAnimation* fadeAnimation;
     QGraphicsOpacityEffect* opacityEffect;
@@ -365,15 +524,17 @@ private:
     bool useQGraphicsViewer;
 #endif
 
-    // Search highlighting members
-    QList<SearchResult> m_allSearchResults;
-    int m_currentSearchResultIndex;
+    // Search highlighting: page widgets pull their page's hits straight
+    // from the model's per-page index, so no full result copy lives here
+    SearchModel* m_searchModel;
 
     // 常量
     static constexpr double MIN_ZOOM = 0.1;
     static constexpr double MAX_ZOOM = 5.0;
     static constexpr double DEFAULT_ZOOM = 1.0;
     static constexpr double ZOOM_STEP = 0.1;
+    static constexpr int CONTINUOUS_POOL_MAX = 8;  // 页面组件池上限
+    static constexpr int SEARCH_PREFETCH_RESULTS = 3;  // 结果步进预取窗口
 
 signals:
     void pageChanged(int pageNumber);
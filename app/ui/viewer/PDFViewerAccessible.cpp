@@ -0,0 +1,119 @@
+#include "PDFViewerAccessible.h"
+#include "PDFViewer.h"
+
+PDFViewerAccessible::PDFViewerAccessible(PDFViewer* viewer)
+    : QAccessibleWidget(viewer, QAccessible::Document) {}
+
+QAccessibleInterface* PDFViewerAccessible::factory(const QString& className,
+                                                   QObject* object) {
+    if (className == QLatin1String("PDFViewer")) {
+        if (auto* viewer = qobject_cast<PDFViewer*>(object)) {
+            return new PDFViewerAccessible(viewer);
+        }
+    }
+    return nullptr;
+}
+
+void* PDFViewerAccessible::interface_cast(QAccessible::InterfaceType type) {
+    if (type == QAccessible::TextInterface) {
+        return static_cast<QAccessibleTextInterface*>(this);
+    }
+    return QAccessibleWidget::interface_cast(type);
+}
+
+PDFViewer* PDFViewerAccessible::viewer() const {
+    return qobject_cast<PDFViewer*>(widget());
+}
+
+QString PDFViewerAccessible::pageText() const {
+    PDFViewer* view = viewer();
+    return view ? view->accessiblePageText() : QString();
+}
+
+QString PDFViewerAccessible::text(QAccessible::Text t) const {
+    if (t == QAccessible::Name) {
+        PDFViewer* view = viewer();
+        if (view && view->hasDocument()) {
+            return QString("PDF文档，第 %1 页，共 %2 页")
+                .arg(view->getCurrentPage() + 1)
+                .arg(view->getPageCount());
+        }
+    }
+    return QAccessibleWidget::text(t);
+}
+
+QString PDFViewerAccessible::text(int startOffset, int endOffset) const {
+    const QString content = pageText();
+    const int start = qBound(0, startOffset, int(content.size()));
+    const int end = qBound(start, endOffset, int(content.size()));
+    return content.mid(start, end - start);
+}
+
+int PDFViewerAccessible::characterCount() const { return pageText().size(); }
+
+int PDFViewerAccessible::selectionCount() const { return 0; }
+
+void PDFViewerAccessible::selection(int selectionIndex, int* startOffset,
+                                    int* endOffset) const {
+    Q_UNUSED(selectionIndex)
+    if (startOffset) {
+        *startOffset = 0;
+    }
+    if (endOffset) {
+        *endOffset = 0;
+    }
+}
+
+void PDFViewerAccessible::addSelection(int startOffset, int endOffset) {
+    Q_UNUSED(startOffset)
+    Q_UNUSED(endOffset)
+}
+
+void PDFViewerAccessible::removeSelection(int selectionIndex) {
+    Q_UNUSED(selectionIndex)
+}
+
+void PDFViewerAccessible::setSelection(int selectionIndex, int startOffset,
+                                       int endOffset) {
+    Q_UNUSED(selectionIndex)
+    Q_UNUSED(startOffset)
+    Q_UNUSED(endOffset)
+}
+
+int PDFViewerAccessible::cursorPosition() const { return m_cursor; }
+
+void PDFViewerAccessible::setCursorPosition(int position) {
+    m_cursor = qBound(0, position, characterCount());
+    QAccessibleTextCursorEvent event(widget(), m_cursor);
+    QAccessible::updateAccessibility(&event);
+}
+
+QRect PDFViewerAccessible::characterRect(int offset) const {
+    // 字符级几何需要把页面坐标映射回视口；阅读器朗读不依赖它，
+    // 返回空矩形即可
+    Q_UNUSED(offset)
+    return QRect();
+}
+
+int PDFViewerAccessible::offsetAtPoint(const QPoint& point) const {
+    Q_UNUSED(point)
+    return -1;
+}
+
+void PDFViewerAccessible::scrollToSubstring(int startIndex, int endIndex) {
+    Q_UNUSED(startIndex)
+    Q_UNUSED(endIndex)
+}
+
+QString PDFViewerAccessible::attributes(int offset, int* startOffset,
+                                        int* endOffset) const {
+    // 无格式属性：整页一个平坦区间
+    if (startOffset) {
+        *startOffset = 0;
+    }
+    if (endOffset) {
+        *endOffset = characterCount();
+    }
+    Q_UNUSED(offset)
+    return QString();
+}
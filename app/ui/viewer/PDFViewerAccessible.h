@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QAccessible>
+#include <QAccessibleTextInterface>
+#include <QAccessibleWidget>
+
+class PDFViewer;
+
+/**
+ * @brief 基于后台文本索引的PDF查看器无障碍接口
+ *
+ * 屏幕阅读器通过QAccessibleTextInterface按区间增量拉取文本，
+ * 本实现把每次拉取都接到DocumentTextIndex的缓存页文本上——
+ * 与搜索共用同一条快路径，焦点移动时从不同步抽取整页文本。
+ * 尚未索引到的页面返回空文本并由查看器把该页抽取提升到
+ * 预取优先级（见PDFViewer::accessiblePageText），索引完成后
+ * 换页事件会让阅读器重新拉取。
+ */
+class PDFViewerAccessible : public QAccessibleWidget,
+                            public QAccessibleTextInterface {
+public:
+    explicit PDFViewerAccessible(PDFViewer* viewer);
+
+    // 注册给QAccessible::installFactory；只认PDFViewer
+    static QAccessibleInterface* factory(const QString& className,
+                                         QObject* object);
+
+    void* interface_cast(QAccessible::InterfaceType type) override;
+    QString text(QAccessible::Text t) const override;
+
+    // QAccessibleTextInterface：区间文本直接切自索引的页文本，
+    // 单词/行边界由基类的QTextBoundaryFinder默认实现处理
+    QString text(int startOffset, int endOffset) const override;
+    int characterCount() const override;
+    int selectionCount() const override;
+    void selection(int selectionIndex, int* startOffset,
+                   int* endOffset) const override;
+    void addSelection(int startOffset, int endOffset) override;
+    void removeSelection(int selectionIndex) override;
+    void setSelection(int selectionIndex, int startOffset,
+                      int endOffset) override;
+    int cursorPosition() const override;
+    void setCursorPosition(int position) override;
+    QRect characterRect(int offset) const override;
+    int offsetAtPoint(const QPoint& point) const override;
+    void scrollToSubstring(int startIndex, int endIndex) override;
+    QString attributes(int offset, int* startOffset,
+                       int* endOffset) const override;
+
+private:
+    PDFViewer* viewer() const;
+    QString pageText() const;
+
+    int m_cursor = 0;  // 阅读器推进的朗读位置
+};
@@ -16,6 +16,7 @@
 #include <QtConcurrent/QtConcurrent>
 #include <QtGlobal>
 #include <cmath>
+#include "../../utils/RenderPolicy.h"
 
 // HighQualityPDFPageWidget Implementation
 HighQualityPDFPageWidget::HighQualityPDFPageWidget(QWidget* parent)
@@ -287,8 +288,11 @@ void HighQualityRenderTask::configureDocument(Poppler::Document* doc) const {
 
 double HighQualityRenderTask::calculateDPI(double scale,
                                            bool highQuality) const {
-    double baseDPI = highQuality ? 150.0 : 72.0;
-    return baseDPI * scale;
+    // High quality renders at ~2x zoom; the shared policy folds in the
+    // device pixel ratio these tasks previously ignored
+    double qualityZoom = highQuality ? (150.0 / RenderPolicy::BASE_DPI) : 1.0;
+    return RenderPolicy::pageDpi(qApp->devicePixelRatio(),
+                                 scale * qualityZoom);
 }
 
 // PDFRenderCache Implementation
@@ -436,8 +440,9 @@ QPixmap renderPageFast(Poppler::Page* page, double scaleFactor, int rotation) {
 }
 
 double calculateOptimalDPI(double scaleFactor, bool highQuality) {
-    double baseDPI = highQuality ? 150.0 : 72.0;
-    return baseDPI * scaleFactor;
+    double qualityZoom = highQuality ? (150.0 / RenderPolicy::BASE_DPI) : 1.0;
+    return RenderPolicy::pageDpi(qApp->devicePixelRatio(),
+                                 scaleFactor * qualityZoom);
 }
 
 void optimizeDocument(Poppler::Document* document) {
@@ -5,11 +5,21 @@
 #include <QDebug>
 #include <QFuture>
 #include <QGraphicsSceneMouseEvent>
+#include <QOpenGLWidget>
 #include <QPainter>
 #include <QScrollBar>
 #include <QStyleOptionGraphicsItem>
 #include <QtConcurrent/QtConcurrent>
 #include <cmath>
+#include "../../utils/RenderPolicy.h"
+
+namespace {
+// While the view scale stays within this band of the rendered scale the
+// existing pixmaps are sharp enough to display through a pure view
+// transform; outside it a Poppler re-render is scheduled
+constexpr double SHARPNESS_LOWER = 0.8;
+constexpr double SHARPNESS_UPPER = 1.25;
+}  // namespace
 
 // QGraphicsPDFPageItem Implementation
 QGraphicsPDFPageItem::QGraphicsPDFPageItem(QGraphicsItem* parent)
@@ -21,6 +31,10 @@ QGraphicsPDFPageItem::QGraphicsPDFPageItem(QGraphicsItem* parent)
       m_pageNumber(-1),
       m_highQualityEnabled(true),
       m_isRendering(false),
+      m_assignGeneration(0),
+      m_inFlightGeneration(0),
+      m_pairPartner(nullptr),
+      m_hasHeldPixmap(false),
       m_currentSearchResultIndex(-1),
       m_normalHighlightColor(255, 255, 0, 100),
       m_currentHighlightColor(255, 165, 0, 150) {
@@ -40,20 +54,86 @@ QGraphicsPDFPageItem::QGraphicsPDFPageItem(QGraphicsItem* parent)
                      [this]() { onRenderCompleted(); });
 }
 
-void QGraphicsPDFPageItem::setPage(Poppler::Page* page, double scaleFactor,
-                                   int rotation) {
-    m_page = page;
+QGraphicsPDFPageItem::~QGraphicsPDFPageItem() {
+    // The timer and watcher are parentless; in-flight render jobs hold
+    // their own reference to the page, so deleting here is safe
+    delete m_renderTimer;
+    delete m_renderWatcher;
+}
+
+void QGraphicsPDFPageItem::setPage(std::unique_ptr<Poppler::Page> page,
+                                   double scaleFactor, int rotation) {
+    // In-place reassignment: only the page contents change. The bumped
+    // generation makes any still-running render for the previous
+    // occupant deliver into the void.
+    ++m_assignGeneration;
+    m_renderTimer->stop();
+    m_isRendering = false;
+    m_page = std::shared_ptr<Poppler::Page>(std::move(page));
     m_scaleFactor = qBound(0.1, scaleFactor, 10.0);
     m_rotation = ((rotation % 360) + 360) % 360;
+    m_searchResults.clear();
+    m_currentSearchResultIndex = -1;
+    m_heldPixmap = QPixmap();
+    m_hasHeldPixmap = false;
 
-    if (page) {
-        m_pageNumber = page->index();
+    if (m_page) {
+        m_pageNumber = m_page->index();
         renderPageAsync();
     } else {
+        m_pageNumber = -1;
         setPixmap(QPixmap());
     }
 }
 
+void QGraphicsPDFPageItem::release() {
+    ++m_assignGeneration;
+    m_renderTimer->stop();
+    m_isRendering = false;
+    m_page.reset();
+    m_pageNumber = -1;
+    m_searchResults.clear();
+    m_currentSearchResultIndex = -1;
+    m_heldPixmap = QPixmap();
+    m_hasHeldPixmap = false;
+    // Pixels are the expensive part of a parked item; drop them so the
+    // pool holds item shells, not a shadow page cache
+    setPixmap(QPixmap());
+}
+
+void QGraphicsPDFPageItem::setPairPartner(QGraphicsPDFPageItem* partner) {
+    if (m_pairPartner == partner) {
+        return;
+    }
+    // Break the old pairing symmetrically so neither side is left
+    // waiting on a partner that no longer points back
+    if (m_pairPartner && m_pairPartner->m_pairPartner == this) {
+        m_pairPartner->m_pairPartner = nullptr;
+        m_pairPartner->flushHeldPixmap();
+    }
+    m_pairPartner = partner;
+    if (!m_pairPartner) {
+        flushHeldPixmap();
+    }
+}
+
+bool QGraphicsPDFPageItem::isRenderPending() const {
+    return m_page && (m_isRendering || m_renderTimer->isActive());
+}
+
+void QGraphicsPDFPageItem::applyPixmap(const QPixmap& pixmap) {
+    setPixmap(pixmap);
+    update();
+}
+
+void QGraphicsPDFPageItem::flushHeldPixmap() {
+    if (m_hasHeldPixmap) {
+        applyPixmap(m_heldPixmap);
+        m_heldPixmap = QPixmap();
+        m_hasHeldPixmap = false;
+    }
+}
+
 void QGraphicsPDFPageItem::setScaleFactor(double factor) {
     double newFactor = qBound(0.1, factor, 10.0);
     if (qAbs(newFactor - m_scaleFactor) > 0.01) {
@@ -87,7 +167,7 @@ void QGraphicsPDFPageItem::renderPageSync() {
         return;
 
     // Render synchronously for testing
-    double dpi = 72.0 * m_scaleFactor * qApp->devicePixelRatio();
+    double dpi = RenderPolicy::pageDpi(qApp->devicePixelRatio(), m_scaleFactor);
 
     QImage image = m_page->renderToImage(
         dpi, dpi, -1, -1, -1, -1,
@@ -115,14 +195,20 @@ void QGraphicsPDFPageItem::renderPage() {
         return;
 
     m_isRendering = true;
-
-    // Render in background thread
-    QFuture<QPixmap> future = QtConcurrent::run([this]() -> QPixmap {
-        double dpi = 72.0 * m_scaleFactor * qApp->devicePixelRatio();
-
-        QImage image = m_page->renderToImage(
+    m_inFlightGeneration = m_assignGeneration;
+
+    // Render in background thread. The job captures its own reference
+    // to the page and never touches the item, so recycling the item
+    // mid-render is safe.
+    std::shared_ptr<Poppler::Page> page = m_page;
+    const double dpi =
+        RenderPolicy::pageDpi(qApp->devicePixelRatio(), m_scaleFactor);
+    const int rotation = m_rotation;
+    QFuture<QPixmap> future = QtConcurrent::run([page, dpi,
+                                                 rotation]() -> QPixmap {
+        QImage image = page->renderToImage(
             dpi, dpi, -1, -1, -1, -1,
-            static_cast<Poppler::Page::Rotation>(m_rotation / 90));
+            static_cast<Poppler::Page::Rotation>(rotation / 90));
 
         if (image.isNull()) {
             return QPixmap();
@@ -138,6 +224,12 @@ void QGraphicsPDFPageItem::renderPage() {
 }
 
 void QGraphicsPDFPageItem::onRenderCompleted() {
+    // A recycled item can still receive the previous page's pixels;
+    // drop them and leave the new occupant's render state alone
+    if (m_inFlightGeneration != m_assignGeneration) {
+        return;
+    }
+
     m_isRendering = false;
 
     if (m_renderWatcher->isCanceled()) {
@@ -145,10 +237,21 @@ void QGraphicsPDFPageItem::onRenderCompleted() {
     }
 
     QPixmap pixmap = m_renderWatcher->result();
-    if (!pixmap.isNull()) {
-        setPixmap(pixmap);
-        update();
+    if (pixmap.isNull()) {
+        return;
     }
+
+    // Facing pair: hold this half of the spread while the partner is
+    // still rendering; whichever half lands last swaps both in together
+    if (m_pairPartner && m_pairPartner->isRenderPending()) {
+        m_heldPixmap = pixmap;
+        m_hasHeldPixmap = true;
+        return;
+    }
+    if (m_pairPartner) {
+        m_pairPartner->flushHeldPixmap();
+    }
+    applyPixmap(pixmap);
 }
 
 void QGraphicsPDFPageItem::setSearchResults(const QList<QRectF>& results) {
@@ -205,6 +308,7 @@ QGraphicsPDFScene::QGraphicsPDFScene(QObject* parent)
       m_document(nullptr),
       m_pageSpacing(20),
       m_pageMargin(50),
+      m_columns(1),
       m_scaleFactor(1.0),
       m_rotation(0),
       m_highQualityEnabled(true) {
@@ -212,6 +316,10 @@ QGraphicsPDFScene::QGraphicsPDFScene(QObject* parent)
 }
 
 void QGraphicsPDFScene::setDocument(Poppler::Document* document) {
+    // Parks the previous document's items instead of deleting them; the
+    // addPage loop pulls them straight back out of the pool, so a
+    // document switch re-renders pixmaps but never rebuilds the item
+    // graph or the scene index
     clearDocument();
     m_document = document;
 
@@ -220,6 +328,7 @@ void QGraphicsPDFScene::setDocument(Poppler::Document* document) {
         for (int i = 0; i < document->numPages(); ++i) {
             addPage(i);
         }
+        updatePairPartners();
         updateLayout();
     }
 }
@@ -243,30 +352,52 @@ void QGraphicsPDFScene::addPage(int pageNumber) {
         return;
     }
 
-    QGraphicsPDFPageItem* pageItem = new QGraphicsPDFPageItem();
-    pageItem->setPage(page.get(), m_scaleFactor, m_rotation);
+    QGraphicsPDFPageItem* pageItem = acquirePageItem();
     pageItem->setHighQualityRendering(m_highQualityEnabled);
+    pageItem->setPage(std::move(page), m_scaleFactor, m_rotation);
 
-    addItem(pageItem);
     m_pageItems[pageNumber] = pageItem;
 }
 
 void QGraphicsPDFScene::removePage(int pageNumber) {
     if (m_pageItems.contains(pageNumber)) {
-        QGraphicsPDFPageItem* item = m_pageItems.take(pageNumber);
-        removeItem(item);
-        delete item;
+        releasePageItem(m_pageItems.take(pageNumber));
     }
 }
 
 void QGraphicsPDFScene::removeAllPages() {
     for (auto it = m_pageItems.begin(); it != m_pageItems.end(); ++it) {
-        removeItem(it.value());
-        delete it.value();
+        releasePageItem(it.value());
     }
     m_pageItems.clear();
 }
 
+QGraphicsPDFPageItem* QGraphicsPDFScene::acquirePageItem() {
+    if (!m_itemPool.isEmpty()) {
+        QGraphicsPDFPageItem* item = m_itemPool.takeLast();
+        item->setVisible(true);
+        return item;
+    }
+
+    auto* item = new QGraphicsPDFPageItem();
+    addItem(item);
+    return item;
+}
+
+void QGraphicsPDFScene::releasePageItem(QGraphicsPDFPageItem* item) {
+    item->setPairPartner(nullptr);
+    item->release();
+    // Hiding is far cheaper than removeItem: the item keeps its slot in
+    // the scene index and reuse touches nothing but visibility
+    item->setVisible(false);
+    if (m_itemPool.size() < POOL_MAX_ITEMS) {
+        m_itemPool.append(item);
+    } else {
+        removeItem(item);
+        delete item;
+    }
+}
+
 QGraphicsPDFPageItem* QGraphicsPDFScene::getPageItem(int pageNumber) const {
     return m_pageItems.value(pageNumber, nullptr);
 }
@@ -289,6 +420,32 @@ void QGraphicsPDFScene::setPageMargin(int margin) {
     }
 }
 
+void QGraphicsPDFScene::setColumns(int columns) {
+    columns = qBound(1, columns, 2);
+    if (m_columns != columns) {
+        m_columns = columns;
+        updatePairPartners();
+        updateLayout();
+    }
+}
+
+void QGraphicsPDFScene::updatePairPartners() {
+    // Facing layout pairs rows of two: each spread completes atomically
+    // instead of painting one half at a time. Single-column layout
+    // unpairs everything.
+    const QList<QGraphicsPDFPageItem*> ordered = m_pageItems.values();
+    for (int i = 0; i < ordered.size(); ++i) {
+        QGraphicsPDFPageItem* partner = nullptr;
+        if (m_columns == 2) {
+            const int mate = (i % 2 == 0) ? i + 1 : i - 1;
+            if (mate >= 0 && mate < ordered.size()) {
+                partner = ordered[mate];
+            }
+        }
+        ordered[i]->setPairPartner(partner);
+    }
+}
+
 void QGraphicsPDFScene::updateLayout() { layoutPages(); }
 
 void QGraphicsPDFScene::setHighQualityRendering(bool enabled) {
@@ -339,29 +496,38 @@ void QGraphicsPDFScene::layoutPages() {
         return;
     }
 
+    // Single positioning pass that also accumulates the scene rect, so
+    // scene geometry is published once per relayout instead of per item
+    // (the view centers content narrower than the viewport by itself).
+    // Facing modes lay two pages per row.
+    QRectF totalRect;
+    const int columns = qMax(1, m_columns);
+    int column = 0;
+    qreal xOffset = m_pageMargin;
     qreal yOffset = m_pageMargin;
+    qreal rowHeight = 0;
 
-    // Layout pages vertically
-    for (int i = 0; i < getPageCount(); ++i) {
-        QGraphicsPDFPageItem* item = getPageItem(i);
-        if (!item)
-            continue;
-
-        QRectF boundingRect = item->boundingRect();
-        qreal xOffset = (sceneRect().width() - boundingRect.width()) / 2.0;
+    for (auto it = m_pageItems.constBegin(); it != m_pageItems.constEnd();
+         ++it) {
+        QGraphicsPDFPageItem* item = it.value();
+        const QRectF bounds = item->boundingRect();
 
         item->setPos(xOffset, yOffset);
-        yOffset += boundingRect.height() + m_pageSpacing;
+        totalRect = totalRect.united(
+            QRectF(QPointF(xOffset, yOffset), bounds.size()));
+        rowHeight = qMax(rowHeight, bounds.height());
+        xOffset += bounds.width() + m_pageSpacing;
+
+        if (++column >= columns) {
+            column = 0;
+            xOffset = m_pageMargin;
+            yOffset += rowHeight + m_pageSpacing;
+            rowHeight = 0;
+        }
     }
 
-    // Update scene rect
-    if (!m_pageItems.isEmpty()) {
-        QRectF totalRect;
-        for (auto* item : m_pageItems) {
-            totalRect = totalRect.united(item->sceneBoundingRect());
-        }
-        totalRect.adjust(-m_pageMargin, -m_pageMargin, m_pageMargin,
-                         m_pageMargin);
+    totalRect.adjust(-m_pageMargin, -m_pageMargin, m_pageMargin, m_pageMargin);
+    if (totalRect != sceneRect()) {
         setSceneRect(totalRect);
     }
 }
@@ -375,6 +541,8 @@ QGraphicsPDFViewer::QGraphicsPDFViewer(QWidget* parent)
       m_currentPage(0),
       m_zoomFactor(1.0),
       m_rotation(0),
+      m_gpuCompositingEnabled(false),
+      m_renderedScale(1.0),
       m_highQualityEnabled(true),
       m_smoothScrollingEnabled(true),
       m_pageSpacing(20),
@@ -393,6 +561,8 @@ QGraphicsPDFViewer::QGraphicsPDFViewer(QWidget* parent)
     m_renderTimer = new QTimer(this);
     m_renderTimer->setSingleShot(true);
     m_renderTimer->setInterval(200);
+    connect(m_renderTimer, &QTimer::timeout, this,
+            &QGraphicsPDFViewer::refreshSharpness);
 }
 
 QGraphicsPDFViewer::~QGraphicsPDFViewer() { clearDocument(); }
@@ -497,8 +667,18 @@ void QGraphicsPDFViewer::setZoom(double factor) {
     double newFactor = qBound(0.1, factor, 10.0);
     if (qAbs(newFactor - m_zoomFactor) > 0.01) {
         m_zoomFactor = newFactor;
-        m_scene->setScaleFactor(newFactor);
-        updateViewTransform();
+
+        // Zoom is applied as a view transform so every intermediate step
+        // composites the existing pixmaps (on the GPU when the GL viewport
+        // is active) instead of re-rendering through Poppler per frame
+        applyZoomTransform();
+
+        // Re-render only once the displayed pixmaps get noticeably soft
+        double ratio = m_zoomFactor / m_renderedScale;
+        if (ratio < SHARPNESS_LOWER || ratio > SHARPNESS_UPPER) {
+            m_renderTimer->start();
+        }
+
         emit zoomChanged(newFactor);
     }
 }
@@ -524,10 +704,37 @@ void QGraphicsPDFViewer::setRotation(int degrees) {
 void QGraphicsPDFViewer::setViewMode(ViewMode mode) {
     if (m_viewMode != mode) {
         m_viewMode = mode;
+        // A mode switch is a relayout of the existing items — pixmaps
+        // and items carry over, nothing re-renders
+        m_scene->setColumns(
+            (mode == FacingPages || mode == ContinuousFacing) ? 2 : 1);
         updateViewTransform();
     }
 }
 
+void QGraphicsPDFViewer::setGpuCompositingEnabled(bool enabled) {
+    if (m_gpuCompositingEnabled == enabled) {
+        return;
+    }
+    m_gpuCompositingEnabled = enabled;
+
+    if (enabled) {
+        // GL viewport: the paint engine uploads page pixmaps as textures
+        // once and zoom/pan become pure GPU transforms
+        QOpenGLWidget* glViewport = new QOpenGLWidget();
+        QSurfaceFormat format = QSurfaceFormat::defaultFormat();
+        format.setSwapInterval(1);  // Vsync'd compositing
+        glViewport->setFormat(format);
+        setViewport(glViewport);
+        // GL surfaces repaint fully anyway; partial updates only add
+        // bookkeeping
+        setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
+    } else {
+        setViewport(new QWidget());
+        setViewportUpdateMode(QGraphicsView::SmartViewportUpdate);
+    }
+}
+
 void QGraphicsPDFViewer::setHighQualityRendering(bool enabled) {
     if (m_highQualityEnabled != enabled) {
         m_highQualityEnabled = enabled;
@@ -640,7 +847,8 @@ void QGraphicsPDFViewer::mouseReleaseEvent(QMouseEvent* event) {
         if (selection.width() > 10 && selection.height() > 10) {
             QRectF sceneRect = mapToScene(selection).boundingRect();
             fitInView(sceneRect, Qt::KeepAspectRatio);
-            m_zoomFactor = transform().m11();
+            m_zoomFactor = transform().m11() * m_renderedScale;
+            m_renderTimer->start();
             emit zoomChanged(m_zoomFactor);
         }
         event->accept();
@@ -747,6 +955,28 @@ void QGraphicsPDFViewer::updateCurrentPage() {
     }
 }
 
+void QGraphicsPDFViewer::applyZoomTransform() {
+    // Page items are rendered at m_renderedScale; the view transform
+    // bridges the gap to the requested zoom
+    double viewScale = m_zoomFactor / m_renderedScale;
+    setTransform(QTransform::fromScale(viewScale, viewScale));
+}
+
+void QGraphicsPDFViewer::refreshSharpness() {
+    if (!m_document) {
+        return;
+    }
+    if (qAbs(m_zoomFactor - m_renderedScale) < 0.01) {
+        return;
+    }
+
+    // Re-render the page pixmaps at the resting zoom and fold the view
+    // transform back to identity
+    m_renderedScale = m_zoomFactor;
+    m_scene->setScaleFactor(m_renderedScale);
+    setTransform(QTransform());
+}
+
 void QGraphicsPDFViewer::updateViewTransform() {
     if (!m_scene)
         return;
@@ -769,7 +999,8 @@ void QGraphicsPDFViewer::fitToView() {
     QGraphicsPDFPageItem* pageItem = m_scene->getPageItem(m_currentPage);
     if (pageItem) {
         fitInView(pageItem, Qt::KeepAspectRatio);
-        m_zoomFactor = transform().m11();
+        m_zoomFactor = transform().m11() * m_renderedScale;
+        m_renderTimer->start();
         emit zoomChanged(m_zoomFactor);
     }
 }
@@ -783,7 +1014,8 @@ void QGraphicsPDFViewer::fitToWidth() {
         QRectF pageRect = pageItem->boundingRect();
         QRectF viewRect = viewport()->rect();
 
-        double scale = viewRect.width() / pageRect.width();
+        // pageRect is in pixels rendered at m_renderedScale
+        double scale = m_renderedScale * viewRect.width() / pageRect.width();
         setZoom(scale);
         centerOnPage(m_currentPage);
     }
@@ -798,7 +1030,8 @@ void QGraphicsPDFViewer::fitToHeight() {
         QRectF pageRect = pageItem->boundingRect();
         QRectF viewRect = viewport()->rect();
 
-        double scale = viewRect.height() / pageRect.height();
+        // pageRect is in pixels rendered at m_renderedScale
+        double scale = m_renderedScale * viewRect.height() / pageRect.height();
         setZoom(scale);
         centerOnPage(m_currentPage);
     }
@@ -13,7 +13,9 @@
 #include <QPixmap>
 #include <QRubberBand>
 #include <QTimer>
+#include <QVector>
 #include <QWheelEvent>
+#include <memory>
 
 class QGraphicsPDFPageItem;
 class QGraphicsPDFScene;
@@ -27,9 +29,25 @@ class QGraphicsPDFPageItem : public QObject, public QGraphicsPixmapItem {
 
 public:
     explicit QGraphicsPDFPageItem(QGraphicsItem* parent = nullptr);
+    ~QGraphicsPDFPageItem() override;
 
-    void setPage(Poppler::Page* page, double scaleFactor = 1.0,
+    // Takes ownership of the page. Reassigning an already-constructed
+    // item is an in-place update: the item keeps its timer, watcher and
+    // scene registration, so pooled items recycle across documents
+    // without any scene churn.
+    void setPage(std::unique_ptr<Poppler::Page> page, double scaleFactor = 1.0,
                  int rotation = 0);
+
+    // Parks the item for pooling: drops the page and pixmap and
+    // invalidates any in-flight render.
+    void release();
+
+    // Facing-pair atomic swap-in: with a partner set, a completed
+    // render is held while the partner's render is still pending and
+    // both halves of the spread apply together, so a page flip never
+    // paints half a spread. Pass nullptr to unpair (releases any held
+    // pixels immediately).
+    void setPairPartner(QGraphicsPDFPageItem* partner);
     void setScaleFactor(double factor);
     void setRotation(int degrees);
 
@@ -60,14 +78,30 @@ private slots:
 private:
     void renderPage();
     void drawSearchHighlights(QPainter* painter);
+    bool isRenderPending() const;
+    void applyPixmap(const QPixmap& pixmap);
+    void flushHeldPixmap();
 
-    Poppler::Page* m_page;
+    // Shared with in-flight render jobs so a recycle mid-render cannot
+    // free the page under the worker thread
+    std::shared_ptr<Poppler::Page> m_page;
     double m_scaleFactor;
     int m_rotation;
     int m_pageNumber;
     bool m_highQualityEnabled;
     bool m_isRendering;
 
+    // Bumped on every setPage/release; a completed render whose
+    // generation no longer matches delivered pixels for a previous
+    // occupant of this item and is discarded
+    quint64 m_assignGeneration;
+    quint64 m_inFlightGeneration;
+
+    // Facing-pair state (GUI thread only)
+    QGraphicsPDFPageItem* m_pairPartner;
+    QPixmap m_heldPixmap;
+    bool m_hasHeldPixmap;
+
     QFutureWatcher<QPixmap>* m_renderWatcher;
     QTimer* m_renderTimer;
 
@@ -101,6 +135,7 @@ public:
     // Layout management
     void setPageSpacing(int spacing);
     void setPageMargin(int margin);
+    void setColumns(int columns);
     void updateLayout();
 
     // Rendering control
@@ -117,15 +152,28 @@ protected:
 
 private:
     void layoutPages();
+    void updatePairPartners();
+    QGraphicsPDFPageItem* acquirePageItem();
+    void releasePageItem(QGraphicsPDFPageItem* item);
 
     Poppler::Document* m_document;
     QMap<int, QGraphicsPDFPageItem*> m_pageItems;
 
+    // Parked items awaiting reuse. Creating and destroying a page item
+    // costs a scene index update plus timer/watcher allocations; on a
+    // continuous layout a document switch used to pay that per page.
+    // Parked items stay in the scene (hidden) so reuse skips the index
+    // entirely.
+    QVector<QGraphicsPDFPageItem*> m_itemPool;
+
     int m_pageSpacing;
     int m_pageMargin;
+    int m_columns;
     double m_scaleFactor;
     int m_rotation;
     bool m_highQualityEnabled;
+
+    static constexpr int POOL_MAX_ITEMS = 512;
 };
 
 /**
@@ -172,6 +220,8 @@ public:
     ViewMode getViewMode() const { return m_viewMode; }
 
     // Enhanced features
+    void setGpuCompositingEnabled(bool enabled);
+    bool isGpuCompositingEnabled() const { return m_gpuCompositingEnabled; }
     void setHighQualityRendering(bool enabled);
     void setPageSpacing(int spacing);
     void setPageMargin(int margin);
@@ -208,9 +258,11 @@ private slots:
     void onScenePageClicked(int pageNumber, QPointF position);
     void onSceneScaleChanged(double scale);
     void updateCurrentPage();
+    void refreshSharpness();
 
 private:
     void setupView();
+    void applyZoomTransform();
     void updateViewTransform();
     void updateVisiblePages();
     void centerOnPage(int pageNumber);
@@ -227,6 +279,8 @@ private:
     int m_rotation;
 
     // View settings
+    bool m_gpuCompositingEnabled;
+    double m_renderedScale;  // Scale the page pixmaps were last rendered at
     bool m_highQualityEnabled;
     bool m_smoothScrollingEnabled;
     int m_pageSpacing;
@@ -6,20 +6,20 @@
 #include <QHeaderView>
 #include <QInputDialog>
 #include <QMessageBox>
-#include <QSortFilterProxyModel>
+#include "../../model/IncrementalFilterProxy.h"
 
 BookmarkWidget::BookmarkWidget(QWidget* parent)
     : QWidget(parent),
       m_bookmarkModel(new BookmarkModel(this)),
-      m_proxyModel(new QSortFilterProxyModel(this)) {
+      m_proxyModel(new IncrementalFilterProxy(this)) {
     setupUI();
     setupConnections();
     setupContextMenu();
 
-    // Configure proxy model
+    // Configure proxy model: the incremental proxy narrows the
+    // previous match set as the query grows instead of re-testing
+    // every bookmark on each keystroke
     m_proxyModel->setSourceModel(m_bookmarkModel);
-    m_proxyModel->setFilterCaseSensitivity(Qt::CaseInsensitive);
-    m_proxyModel->setFilterKeyColumn(-1);  // Filter all columns
     m_bookmarkView->setModel(m_proxyModel);
 
     refreshView();
@@ -368,8 +368,7 @@ void BookmarkWidget::filterBookmarks() {
     // Combine search and category filters
     QString filterPattern = searchText;
 
-    m_proxyModel->setFilterRegularExpression(QRegularExpression(
-        filterPattern, QRegularExpression::CaseInsensitiveOption));
+    m_proxyModel->setFilterText(filterPattern);
 
     // Update count
     m_countLabel->setText(QString("%1 个书签").arg(m_proxyModel->rowCount()));
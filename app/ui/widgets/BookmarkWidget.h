@@ -17,7 +17,7 @@
 #include <QWidget>
 #include "../../model/BookmarkModel.h"
 
-class QSortFilterProxyModel;
+class IncrementalFilterProxy;
 
 /**
  * Comprehensive bookmark management widget
@@ -93,7 +93,7 @@ private:
 
     // Main view
     QTreeView* m_bookmarkView;
-    QSortFilterProxyModel* m_proxyModel;
+    IncrementalFilterProxy* m_proxyModel;
 
     // Context menu
     QMenu* m_contextMenu;
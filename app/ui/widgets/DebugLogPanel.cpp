@@ -1,6 +1,8 @@
 #include "DebugLogPanel.h"
+#include <algorithm>
 #include <QAction>
 #include <QApplication>
+#include <QBrush>
 #include <QCheckBox>
 #include <QColor>
 #include <QComboBox>
@@ -17,6 +19,7 @@
 #include <QIODevice>
 #include <QLabel>
 #include <QLineEdit>
+#include <QListView>
 #include <QMenu>
 #include <QMessageBox>
 #include <QMutexLocker>
@@ -24,9 +27,6 @@
 #include <QProgressBar>
 #include <QPushButton>
 #include <QRegularExpression>
-#include <QRegularExpressionMatch>
-#include <QRegularExpressionMatchIterator>
-#include <QScrollArea>
 #include <QScrollBar>
 #include <QSettings>
 #include <QShowEvent>
@@ -37,28 +37,28 @@
 #include <QStringList>
 #include <QTableWidget>
 #include <QTableWidgetItem>
-#include <QTextCharFormat>
-#include <QTextCursor>
-#include <QTextDocument>
-#include <QTextEdit>
 #include <QTextStream>
 #include <QTimer>
 #include <QVBoxLayout>
 #include <QWidget>
 #include <QtCore/Qt>
+#include "../../managers/MemoryGovernor.h"
 #include "../../managers/StyleManager.h"
+#include "../../utils/MemoryTracker.h"
+#include "../../utils/PerfTracer.h"
 
 const QString DebugLogPanel::SETTINGS_GROUP = "DebugLogPanel";
 const int DebugLogPanel::DEFAULT_MAX_ENTRIES = 10000;
 const int DebugLogPanel::UPDATE_INTERVAL_MS = 100;
 const int DebugLogPanel::STATISTICS_UPDATE_INTERVAL_MS = 1000;
+const int DebugLogPanel::SEARCH_DEBOUNCE_MS = 150;
 
 DebugLogPanel::DebugLogPanel(QWidget* parent)
     : QWidget(parent),
       m_mainLayout(nullptr),
       m_mainSplitter(nullptr),
-      m_logDisplay(nullptr),
-      m_scrollBar(nullptr),
+      m_logList(nullptr),
+      m_logModel(nullptr),
       m_filterGroup(nullptr),
       m_logLevelFilter(nullptr),
       m_categoryFilter(nullptr),
@@ -78,17 +78,20 @@ DebugLogPanel::DebugLogPanel(QWidget* parent)
       m_statsTable(nullptr),
       m_messagesPerSecLabel(nullptr),
       m_memoryUsageBar(nullptr),
+      m_memoryTable(nullptr),
       m_contextMenu(nullptr),
       m_copyAction(nullptr),
       m_copyAllAction(nullptr),
       m_clearAction(nullptr),
       m_exportAction(nullptr),
       m_pauseAction(nullptr),
+      m_traceToggleAction(nullptr),
+      m_exportTraceAction(nullptr),
       m_updateTimer(nullptr),
       m_statisticsTimer(nullptr),
+      m_searchDebounce(nullptr),
       m_paused(false),
       m_autoScroll(true),
-      m_currentSearchIndex(-1),
       m_lastUpdateTime(QDateTime::currentDateTime()),
       m_pendingMessages(0),
       m_settings(nullptr) {
@@ -110,6 +113,12 @@ DebugLogPanel::DebugLogPanel(QWidget* parent)
             &DebugLogPanel::updateStatistics);
     m_statisticsTimer->start();
 
+    m_searchDebounce = new QTimer(this);
+    m_searchDebounce->setSingleShot(true);
+    m_searchDebounce->setInterval(SEARCH_DEBOUNCE_MS);
+    connect(m_searchDebounce, &QTimer::timeout, this,
+            &DebugLogPanel::rebuildFilterMatcher);
+
     // Initialize settings
     m_settings = new QSettings(this);
 
@@ -156,19 +165,34 @@ void DebugLogPanel::setupLogDisplay() {
     QVBoxLayout* logLayout = new QVBoxLayout(logWidget);
     logLayout->setContentsMargins(0, 0, 0, 0);
 
-    // Log display text edit
-    m_logDisplay = new QTextEdit();
-    m_logDisplay->setReadOnly(true);
-    m_logDisplay->setFont(QFont("Consolas", 9));
-    m_logDisplay->setLineWrapMode(QTextEdit::WidgetWidth);
-    m_logDisplay->setContextMenuPolicy(Qt::CustomContextMenu);
-    m_logDisplay->document()->setMaximumBlockCount(DEFAULT_MAX_ENTRIES);
+    // Virtualized list over the structured ring: the view only asks the
+    // model for rows inside the viewport, so display cost is bounded by
+    // the window height regardless of how fast entries arrive
+    m_logModel = new LogRingModel(this);
+    m_logModel->setCapacity(DEFAULT_MAX_ENTRIES);
+    m_logModel->setFormatter(
+        [this](const LogEntry& entry) { return formatLogEntry(entry); });
+    m_logModel->setForegroundProvider([this](const LogEntry& entry) {
+        if (!m_config.colorizeOutput) {
+            return QVariant();
+        }
+        return QVariant(QBrush(getLogLevelColor(entry.level)));
+    });
+
+    m_logList = new QListView();
+    m_logList->setModel(m_logModel);
+    m_logList->setFont(QFont("Consolas", 9));
+    m_logList->setUniformItemSizes(true);
+    m_logList->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    m_logList->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_logList->setContextMenuPolicy(Qt::CustomContextMenu);
+    m_logList->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
 
     // Set minimum size
-    m_logDisplay->setMinimumHeight(200);
-    m_logDisplay->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    m_logList->setMinimumHeight(200);
+    m_logList->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
 
-    logLayout->addWidget(m_logDisplay);
+    logLayout->addWidget(m_logList);
     m_mainSplitter->addWidget(logWidget);
 
     // Set initial splitter sizes
@@ -304,6 +328,18 @@ void DebugLogPanel::setupStatisticsDisplay() {
     memoryLayout->addWidget(m_memoryUsageBar);
     statsLayout->addLayout(memoryLayout);
 
+    // Per-subsystem memory attribution from MemoryTracker: the live
+    // breakdown (current and high-water mark per subsystem, plus the
+    // untracked remainder of RSS) used during OOM investigations
+    m_memoryTable = new QTableWidget(0, 3);
+    m_memoryTable->setHorizontalHeaderLabels({"Subsystem", "Current", "Peak"});
+    m_memoryTable->horizontalHeader()->setStretchLastSection(true);
+    m_memoryTable->verticalHeader()->setVisible(false);
+    m_memoryTable->setMaximumHeight(160);
+    m_memoryTable->setAlternatingRowColors(true);
+    m_memoryTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    statsLayout->addWidget(m_memoryTable);
+
     m_mainSplitter->addWidget(m_statsGroup);
 }
 
@@ -318,6 +354,10 @@ void DebugLogPanel::setupContextMenu() {
     m_contextMenu->addSeparator();
     m_pauseAction = m_contextMenu->addAction("Pause Logging");
     m_pauseAction->setCheckable(true);
+    m_contextMenu->addSeparator();
+    m_traceToggleAction = m_contextMenu->addAction("Record Performance Trace");
+    m_traceToggleAction->setCheckable(true);
+    m_exportTraceAction = m_contextMenu->addAction("Export Trace...");
 }
 
 void DebugLogPanel::connectSignals() {
@@ -354,7 +394,7 @@ void DebugLogPanel::connectSignals() {
             &DebugLogPanel::onAutoScrollToggled);
 
     // Context menu
-    connect(m_logDisplay, &QTextEdit::customContextMenuRequested, this,
+    connect(m_logList, &QListView::customContextMenuRequested, this,
             &DebugLogPanel::onContextMenuRequested);
     connect(m_copyAction, &QAction::triggered, this,
             &DebugLogPanel::onCopySelected);
@@ -366,6 +406,10 @@ void DebugLogPanel::connectSignals() {
             &DebugLogPanel::onExportLogs);
     connect(m_pauseAction, &QAction::toggled, this,
             &DebugLogPanel::onPauseToggled);
+    connect(m_traceToggleAction, &QAction::toggled, this,
+            &DebugLogPanel::onToggleTracing);
+    connect(m_exportTraceAction, &QAction::triggered, this,
+            &DebugLogPanel::onExportTrace);
 }
 
 void DebugLogPanel::setConfiguration(const PanelConfiguration& config) {
@@ -456,14 +500,19 @@ void DebugLogPanel::resetToDefaults() {
 }
 
 void DebugLogPanel::applyConfiguration() {
-    if (!m_logDisplay)
+    if (!m_logList)
         return;
 
     // Apply font and display settings
-    m_logDisplay->setFont(m_config.logFont);
-    m_logDisplay->setLineWrapMode(m_config.wordWrap ? QTextEdit::WidgetWidth
-                                                    : QTextEdit::NoWrap);
-    m_logDisplay->document()->setMaximumBlockCount(m_config.maxLogEntries);
+    m_logList->setFont(m_config.logFont);
+    m_logList->setWordWrap(m_config.wordWrap);
+    // Uniform row heights are what lets the view skip measuring
+    // offscreen rows; only possible without wrapping
+    m_logList->setUniformItemSizes(!m_config.wordWrap);
+    if (m_logModel) {
+        m_logModel->setCapacity(m_config.maxLogEntries);
+        m_logModel->refreshFormatting();
+    }
 
     // Update UI controls
     if (m_autoScrollCheck) {
@@ -498,13 +547,11 @@ void DebugLogPanel::applyConfiguration() {
 
 void DebugLogPanel::clearLogs() {
     QMutexLocker locker(&m_logMutex);
-    m_logEntries.clear();
-    m_filteredEntries.clear();
     m_pendingEntries.clear();
     m_pendingMessages = 0;
 
-    if (m_logDisplay) {
-        m_logDisplay->clear();
+    if (m_logModel) {
+        m_logModel->clear();
     }
 
     resetStatistics();
@@ -557,16 +604,10 @@ void DebugLogPanel::onLogMessageDetailed(const QDateTime& timestamp, int level,
     m_pendingEntries.push_back(entry);
     m_pendingMessages++;
 
-    // Update category filter if new category is encountered
-    if (!category.isEmpty() && m_categoryFilter) {
-        bool categoryExists = false;
-        for (int i = 0; i < m_categoryFilter->count(); ++i) {
-            if (m_categoryFilter->itemText(i) == category) {
-                categoryExists = true;
-                break;
-            }
-        }
-        if (!categoryExists) {
+    // Track new categories with a set lookup, not a combo box scan
+    if (!category.isEmpty() && !m_knownCategories.contains(category)) {
+        m_knownCategories.insert(category);
+        if (m_categoryFilter) {
             m_categoryFilter->addItem(category);
         }
     }
@@ -614,32 +655,41 @@ void DebugLogPanel::togglePanel() {
     emit panelVisibilityChanged(isVisible());
 }
 
-void DebugLogPanel::onFilterChanged() {
-    filterLogEntries();
-    highlightSearchResults();
-}
+void DebugLogPanel::onFilterChanged() { rebuildFilterMatcher(); }
 
 void DebugLogPanel::onSearchTextChanged() {
     m_config.searchFilter = m_searchEdit->text();
-    m_currentSearchIndex = -1;
-    highlightSearchResults();
+    // Refilter once typing settles instead of on every keystroke. During
+    // construction (applyConfiguration restores the saved search text
+    // before the timers exist) apply immediately
+    if (m_searchDebounce) {
+        m_searchDebounce->start();
+    } else {
+        rebuildFilterMatcher();
+    }
 }
 
 void DebugLogPanel::onSearchNext() {
-    if (m_searchResults.isEmpty())
+    if (!m_logList || !m_logModel || m_logModel->rowCount() == 0)
         return;
 
-    m_currentSearchIndex = (m_currentSearchIndex + 1) % m_searchResults.size();
-    // Implementation for jumping to next search result would go here
+    // Every visible row matches the active search filter, so stepping
+    // through matches is stepping through rows
+    const int current = m_logList->currentIndex().row();
+    const int next = (current + 1) % m_logModel->rowCount();
+    m_logList->setCurrentIndex(m_logModel->index(next, 0));
+    m_logList->scrollTo(m_logModel->index(next, 0));
 }
 
 void DebugLogPanel::onSearchPrevious() {
-    if (m_searchResults.isEmpty())
+    if (!m_logList || !m_logModel || m_logModel->rowCount() == 0)
         return;
 
-    m_currentSearchIndex = (m_currentSearchIndex - 1 + m_searchResults.size()) %
-                           m_searchResults.size();
-    // Implementation for jumping to previous search result would go here
+    const int current = m_logList->currentIndex().row();
+    const int prev =
+        (current - 1 + m_logModel->rowCount()) % m_logModel->rowCount();
+    m_logList->setCurrentIndex(m_logModel->index(prev, 0));
+    m_logList->scrollTo(m_logModel->index(prev, 0));
 }
 
 void DebugLogPanel::onClearLogs() { clearLogs(); }
@@ -656,17 +706,79 @@ void DebugLogPanel::onExportLogs() {
     }
 }
 
+void DebugLogPanel::onToggleTracing(bool enabled) {
+    if (enabled) {
+        // Start from a clean buffer so the export only covers this
+        // recording session
+        PerfTracer::instance().clear();
+    }
+    PerfTracer::instance().setEnabled(enabled);
+}
+
+void DebugLogPanel::onExportTrace() {
+    PerfTracer& tracer = PerfTracer::instance();
+
+    if (tracer.eventCount() == 0) {
+        QMessageBox::information(
+            this, "Export Trace",
+            "No trace data captured. Enable 'Record Performance Trace' "
+            "and reproduce the slow interaction first.");
+        return;
+    }
+
+    QString fileName = QFileDialog::getSaveFileName(
+        this, "Export Trace",
+        QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) +
+            "/perf_trace.json",
+        "Trace Files (*.json);;All Files (*)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    if (tracer.dumpChromeTracing(fileName)) {
+        QMessageBox::information(
+            this, "Export Complete",
+            QString("Exported %1 trace spans to %2.\nLoad the file in "
+                    "chrome://tracing or Perfetto.")
+                .arg(tracer.eventCount())
+                .arg(fileName));
+    } else {
+        QMessageBox::warning(this, "Export Error",
+                             "Failed to write trace file: " + fileName);
+    }
+}
+
 void DebugLogPanel::onCopySelected() {
-    if (m_logDisplay && m_logDisplay->textCursor().hasSelection()) {
-        QApplication::clipboard()->setText(
-            m_logDisplay->textCursor().selectedText());
+    if (!m_logList || !m_logModel)
+        return;
+
+    QModelIndexList selected = m_logList->selectionModel()->selectedIndexes();
+    if (selected.isEmpty())
+        return;
+
+    std::sort(selected.begin(), selected.end(),
+              [](const QModelIndex& a, const QModelIndex& b) {
+                  return a.row() < b.row();
+              });
+
+    QStringList lines;
+    lines.reserve(selected.size());
+    for (const QModelIndex& index : selected) {
+        lines.append(formatLogEntry(m_logModel->entryAtRow(index.row())));
     }
+    QApplication::clipboard()->setText(lines.join("\n"));
 }
 
 void DebugLogPanel::onCopyAll() {
-    if (m_logDisplay) {
-        QApplication::clipboard()->setText(m_logDisplay->toPlainText());
+    if (!m_logModel)
+        return;
+
+    QStringList lines;
+    lines.reserve(m_logModel->rowCount());
+    for (int row = 0; row < m_logModel->rowCount(); ++row) {
+        lines.append(formatLogEntry(m_logModel->entryAtRow(row)));
     }
+    QApplication::clipboard()->setText(lines.join("\n"));
 }
 
 void DebugLogPanel::onPauseToggled(bool paused) { pauseLogging(paused); }
@@ -705,8 +817,8 @@ void DebugLogPanel::onCategoryFilterChanged() {
 void DebugLogPanel::onShowSettingsDialog() { showSettingsDialog(); }
 
 void DebugLogPanel::onContextMenuRequested(const QPoint& pos) {
-    if (m_contextMenu && m_logDisplay) {
-        m_contextMenu->exec(m_logDisplay->mapToGlobal(pos));
+    if (m_contextMenu && m_logList) {
+        m_contextMenu->exec(m_logList->mapToGlobal(pos));
     }
 }
 
@@ -729,130 +841,66 @@ void DebugLogPanel::hideEvent(QHideEvent* event) {
 
 // Core functionality methods
 void DebugLogPanel::updateLogDisplay() {
-    if (!m_logDisplay || m_pendingEntries.empty())
+    if (!m_logModel)
         return;
 
-    QMutexLocker locker(&m_logMutex);
-
-    // Process pending entries in batches
-    int processed = 0;
-    while (!m_pendingEntries.empty() && processed < m_config.batchSize) {
-        LogEntry entry = m_pendingEntries.front();
-        m_pendingEntries.pop_front();
-
-        // Add to main log entries
-        m_logEntries.push_back(entry);
-
-        // Maintain maximum entries limit
-        if (m_logEntries.size() > static_cast<size_t>(m_config.maxLogEntries)) {
-            m_logEntries.pop_front();
-        }
-
-        // Add to display if it passes filters
-        if (passesFilter(entry)) {
-            addLogEntryToDisplay(entry);
-        }
-
-        processed++;
-        m_pendingMessages--;
+    // Move the arrival queue out under the lock, then feed the model
+    // outside it. Each append is a matcher check plus at most one row
+    // insertion — no text is formatted here
+    std::deque<LogEntry> batch;
+    {
+        QMutexLocker locker(&m_logMutex);
+        if (m_pendingEntries.empty())
+            return;
+        batch.swap(m_pendingEntries);
+        m_pendingMessages = 0;
     }
 
-    // Auto-scroll if enabled
-    if (m_autoScroll && processed > 0) {
-        scrollToBottom();
+    for (const LogEntry& entry : batch) {
+        m_logModel->append(entry);
     }
-}
-
-void DebugLogPanel::addLogEntryToDisplay(const LogEntry& entry) {
-    if (!m_logDisplay)
-        return;
-
-    QString formattedEntry = formatLogEntry(entry);
-
-    // Apply color formatting if enabled
-    if (m_config.colorizeOutput) {
-        QTextCursor cursor = m_logDisplay->textCursor();
-        cursor.movePosition(QTextCursor::End);
-
-        QTextCharFormat format;
-        format.setForeground(getLogLevelColor(entry.level));
-
-        cursor.insertText(formattedEntry + "\n", format);
-    } else {
-        m_logDisplay->append(formattedEntry);
-    }
-}
-
-void DebugLogPanel::filterLogEntries() {
-    if (!m_logDisplay)
-        return;
 
     QMutexLocker locker(&m_logMutex);
+    m_statistics.filteredMessages = m_logModel->rowCount();
 
-    m_filteredEntries.clear();
-    m_logDisplay->clear();
-
-    for (const auto& entry : m_logEntries) {
-        if (passesFilter(entry)) {
-            m_filteredEntries.push_back(entry);
-            addLogEntryToDisplay(entry);
-        }
+    // Auto-scroll if enabled
+    if (m_autoScroll) {
+        scrollToBottom();
     }
-
-    m_statistics.filteredMessages = static_cast<int>(m_filteredEntries.size());
 }
 
-void DebugLogPanel::highlightSearchResults() {
-    if (!m_logDisplay || m_config.searchFilter.isEmpty())
+void DebugLogPanel::rebuildFilterMatcher() {
+    if (!m_logModel)
         return;
 
-    // Clear previous highlights
-    QTextCursor cursor = m_logDisplay->textCursor();
-    cursor.select(QTextCursor::Document);
-    QTextCharFormat clearFormat;
-    cursor.setCharFormat(clearFormat);
-
-    // Apply new highlights
-    QTextDocument* document = m_logDisplay->document();
-    QTextCursor searchCursor(document);
-
-    QTextCharFormat highlightFormat;
-    highlightFormat.setBackground(
-        QColor(255, 255, 0, 100));  // Yellow highlight
-
-    Qt::CaseSensitivity caseSensitivity =
-        m_config.caseSensitiveSearch ? Qt::CaseSensitive : Qt::CaseInsensitive;
-
-    m_searchResults.clear();
-
-    if (m_config.regexSearch) {
-        QRegularExpression regex(m_config.searchFilter);
+    // Compile the filter once; the model applies it to the whole ring
+    // now and to each arriving entry afterwards
+    LogRingModel::Matcher matcher;
+    matcher.minLevel = static_cast<int>(m_config.minLogLevel);
+    matcher.categories = m_config.enabledCategories;
+    matcher.needle = m_config.searchFilter;
+    matcher.useRegex = m_config.regexSearch;
+    matcher.caseSensitivity = m_config.caseSensitiveSearch
+                                  ? Qt::CaseSensitive
+                                  : Qt::CaseInsensitive;
+    if (matcher.useRegex && !matcher.needle.isEmpty()) {
+        QRegularExpression::PatternOptions options =
+            QRegularExpression::NoPatternOption;
         if (!m_config.caseSensitiveSearch) {
-            regex.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
-        }
-
-        QRegularExpressionMatchIterator it =
-            regex.globalMatch(document->toPlainText());
-        while (it.hasNext()) {
-            QRegularExpressionMatch match = it.next();
-            searchCursor.setPosition(match.capturedStart());
-            searchCursor.setPosition(match.capturedEnd(),
-                                     QTextCursor::KeepAnchor);
-            searchCursor.setCharFormat(highlightFormat);
-            m_searchResults.append(QString::number(match.capturedStart()));
+            options |= QRegularExpression::CaseInsensitiveOption;
         }
-    } else {
-        while (!searchCursor.isNull() && !searchCursor.atEnd()) {
-            searchCursor =
-                document->find(m_config.searchFilter, searchCursor,
-                               QTextDocument::FindFlag(caseSensitivity));
-            if (!searchCursor.isNull()) {
-                searchCursor.setCharFormat(highlightFormat);
-                m_searchResults.append(
-                    QString::number(searchCursor.position()));
-            }
+        matcher.pattern = QRegularExpression(matcher.needle, options);
+        if (!matcher.pattern.isValid()) {
+            // Treat a half-typed regex as no text filter rather than
+            // hiding everything
+            matcher.needle.clear();
         }
     }
+
+    m_logModel->setMatcher(matcher);
+
+    QMutexLocker locker(&m_logMutex);
+    m_statistics.filteredMessages = m_logModel->rowCount();
 }
 
 void DebugLogPanel::updateStatistics() {
@@ -916,12 +964,58 @@ void DebugLogPanel::updateStatisticsDisplay() {
         QString("Messages/sec: %1").arg(stats.messagesPerSecond, 0, 'f', 2));
 
     // Update memory usage (simplified calculation)
-    int memoryUsagePercent = qMin(
-        100,
-        static_cast<int>((m_logEntries.size() * 100) / m_config.maxLogEntries));
-    if (m_memoryUsageBar) {
+    if (m_memoryUsageBar && m_logModel && m_config.maxLogEntries > 0) {
+        int memoryUsagePercent =
+            qMin(100, (m_logModel->entryCount() * 100) /
+                          m_config.maxLogEntries);
         m_memoryUsageBar->setValue(memoryUsagePercent);
     }
+
+    updateMemoryBreakdown();
+}
+
+void DebugLogPanel::updateMemoryBreakdown() {
+    if (!m_memoryTable)
+        return;
+
+    const QList<MemoryTracker::Attribution> breakdown =
+        MemoryTracker::instance().snapshot();
+    const qint64 rss = MemoryGovernor::instance().processMemoryUsage();
+    const qint64 tracked = MemoryTracker::instance().trackedTotal();
+
+    auto formatBytes = [](qint64 bytes) {
+        if (bytes >= 1024 * 1024) {
+            return QString::number(bytes / (1024.0 * 1024.0), 'f', 1) + " MB";
+        }
+        return QString::number(bytes / 1024.0, 'f', 1) + " KB";
+    };
+
+    const int extraRows = rss > 0 ? 2 : 0;
+    m_memoryTable->setRowCount(breakdown.size() + extraRows);
+    int row = 0;
+    for (const MemoryTracker::Attribution& attribution : breakdown) {
+        m_memoryTable->setItem(row, 0,
+                               new QTableWidgetItem(attribution.subsystem));
+        m_memoryTable->setItem(
+            row, 1, new QTableWidgetItem(formatBytes(attribution.currentBytes)));
+        m_memoryTable->setItem(
+            row, 2, new QTableWidgetItem(formatBytes(attribution.peakBytes)));
+        ++row;
+    }
+    if (rss > 0) {
+        // Whatever RSS exceeds the tracked total is Poppler/Qt
+        // internals and heap overhead — the by-elimination bucket
+        m_memoryTable->setItem(
+            row, 0, new QTableWidgetItem("untracked (poppler/qt/heap)"));
+        m_memoryTable->setItem(
+            row, 1,
+            new QTableWidgetItem(formatBytes(qMax(qint64(0), rss - tracked))));
+        m_memoryTable->setItem(row, 2, new QTableWidgetItem("-"));
+        ++row;
+        m_memoryTable->setItem(row, 0, new QTableWidgetItem("process RSS"));
+        m_memoryTable->setItem(row, 1, new QTableWidgetItem(formatBytes(rss)));
+        m_memoryTable->setItem(row, 2, new QTableWidgetItem("-"));
+    }
 }
 
 // Utility methods
@@ -991,52 +1085,9 @@ QString DebugLogPanel::getLogLevelText(Logger::LogLevel level) const {
     }
 }
 
-bool DebugLogPanel::passesFilter(const LogEntry& entry) const {
-    // Check log level filter
-    if (entry.level < m_config.minLogLevel) {
-        return false;
-    }
-
-    // Check category filter
-    if (!m_config.enabledCategories.isEmpty() &&
-        !m_config.enabledCategories.contains(entry.category)) {
-        return false;
-    }
-
-    // Check search filter
-    if (!m_config.searchFilter.isEmpty()) {
-        Qt::CaseSensitivity caseSensitivity = m_config.caseSensitiveSearch
-                                                  ? Qt::CaseSensitive
-                                                  : Qt::CaseInsensitive;
-
-        if (m_config.regexSearch) {
-            QRegularExpression regex(m_config.searchFilter);
-            if (!m_config.caseSensitiveSearch) {
-                regex.setPatternOptions(
-                    QRegularExpression::CaseInsensitiveOption);
-            }
-
-            QString fullText = formatLogEntry(entry);
-            if (!regex.match(fullText).hasMatch()) {
-                return false;
-            }
-        } else {
-            QString fullText = formatLogEntry(entry);
-            if (!fullText.contains(m_config.searchFilter, caseSensitivity)) {
-                return false;
-            }
-        }
-    }
-
-    return true;
-}
-
 void DebugLogPanel::scrollToBottom() {
-    if (m_logDisplay) {
-        QScrollBar* scrollBar = m_logDisplay->verticalScrollBar();
-        if (scrollBar) {
-            scrollBar->setValue(scrollBar->maximum());
-        }
+    if (m_logList) {
+        m_logList->scrollToBottom();
     }
 }
 
@@ -1050,19 +1101,17 @@ void DebugLogPanel::exportToFile(const QString& filePath) {
     }
 
     QTextStream out(&file);
-    // Note: setEncoding is Qt6 specific, for Qt5 compatibility we'll skip
-    // encoding setting
 
     // Write header
+    const int rows = m_logModel ? m_logModel->rowCount() : 0;
     out << "Debug Log Export\n";
     out << "Generated: " << QDateTime::currentDateTime().toString() << "\n";
-    out << "Total Entries: " << m_filteredEntries.size() << "\n";
+    out << "Total Entries: " << rows << "\n";
     out << QString(80, '=') << "\n\n";
 
-    // Write log entries
-    QMutexLocker locker(&m_logMutex);
-    for (const auto& entry : m_filteredEntries) {
-        out << formatLogEntry(entry) << "\n";
+    // Write the filtered entries, formatted on demand
+    for (int row = 0; row < rows; ++row) {
+        out << formatLogEntry(m_logModel->entryAtRow(row)) << "\n";
     }
 
     file.close();
@@ -1102,9 +1151,9 @@ void DebugLogPanel::applyTheme() {
     }
 
     // Apply styles to main components
-    if (m_logDisplay) {
-        m_logDisplay->setStyleSheet(
-            QString("QTextEdit {"
+    if (m_logList) {
+        m_logList->setStyleSheet(
+            QString("QListView {"
                     "    background-color: %1;"
                     "    color: %2;"
                     "    border: 1px solid %3;"
@@ -1283,3 +1332,175 @@ void DebugLogPanel::applyTheme() {
                 .arg(borderColor, backgroundColor, textColor, highlightColor));
     }
 }
+
+// ---------------------------------------------------------------------------
+// LogRingModel
+
+bool LogRingModel::Matcher::matches(
+    const DebugLogPanel::LogEntry& entry) const {
+    if (static_cast<int>(entry.level) < minLevel) {
+        return false;
+    }
+
+    if (!categories.isEmpty() && !categories.contains(entry.category)) {
+        return false;
+    }
+
+    if (!needle.isEmpty()) {
+        // Match against the structured fields directly — no formatted
+        // line is built for filtering
+        if (useRegex) {
+            if (!pattern.match(entry.message).hasMatch() &&
+                !pattern.match(entry.category).hasMatch()) {
+                return false;
+            }
+        } else {
+            if (!entry.message.contains(needle, caseSensitivity) &&
+                !entry.category.contains(needle, caseSensitivity)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+LogRingModel::LogRingModel(QObject* parent)
+    : QAbstractListModel(parent), m_head(0), m_count(0), m_firstSeq(0) {}
+
+void LogRingModel::setFormatter(
+    std::function<QString(const DebugLogPanel::LogEntry&)> f) {
+    m_formatter = std::move(f);
+}
+
+void LogRingModel::setForegroundProvider(
+    std::function<QVariant(const DebugLogPanel::LogEntry&)> f) {
+    m_foreground = std::move(f);
+}
+
+void LogRingModel::setCapacity(int capacity) {
+    if (capacity < 1) {
+        capacity = 1;
+    }
+    if (capacity == m_slots.size()) {
+        return;
+    }
+
+    // Capacity changes are rare (settings edits): rebuild the ring
+    // keeping the newest entries
+    beginResetModel();
+    QVector<DebugLogPanel::LogEntry> kept;
+    const int keep = qMin(m_count, capacity);
+    kept.reserve(keep);
+    for (int i = m_count - keep; i < m_count; ++i) {
+        kept.append(m_slots.at((m_head + i) % m_slots.size()));
+    }
+
+    m_slots.clear();
+    m_slots.resize(capacity);
+    m_head = 0;
+    m_count = kept.size();
+    m_firstSeq = 0;
+    for (int i = 0; i < kept.size(); ++i) {
+        m_slots[i] = kept.at(i);
+    }
+    rebuildVisible();
+    endResetModel();
+}
+
+void LogRingModel::setMatcher(const Matcher& matcher) {
+    beginResetModel();
+    m_matcher = matcher;
+    rebuildVisible();
+    endResetModel();
+}
+
+void LogRingModel::append(const DebugLogPanel::LogEntry& entry) {
+    if (m_slots.isEmpty()) {
+        return;
+    }
+
+    if (m_count == m_slots.size()) {
+        // Ring is full: the oldest entry is overwritten; drop its row
+        // first if it is visible
+        if (!m_visible.isEmpty() && m_visible.first() == m_firstSeq) {
+            beginRemoveRows(QModelIndex(), 0, 0);
+            m_visible.removeFirst();
+            endRemoveRows();
+        }
+        m_slots[m_head] = entry;
+        m_head = (m_head + 1) % m_slots.size();
+        ++m_firstSeq;
+    } else {
+        m_slots[(m_head + m_count) % m_slots.size()] = entry;
+        ++m_count;
+    }
+
+    const quint64 seq = m_firstSeq + m_count - 1;
+    if (m_matcher.matches(entry)) {
+        beginInsertRows(QModelIndex(), m_visible.size(), m_visible.size());
+        m_visible.append(seq);
+        endInsertRows();
+    }
+}
+
+void LogRingModel::clear() {
+    beginResetModel();
+    m_head = 0;
+    m_count = 0;
+    m_firstSeq = 0;
+    m_visible.clear();
+    endResetModel();
+}
+
+const DebugLogPanel::LogEntry& LogRingModel::entryAtRow(int row) const {
+    return entryForSeq(m_visible.at(row));
+}
+
+void LogRingModel::refreshFormatting() {
+    if (m_visible.isEmpty()) {
+        return;
+    }
+    emit dataChanged(index(0, 0), index(m_visible.size() - 1, 0),
+                     {Qt::DisplayRole, Qt::ForegroundRole});
+}
+
+int LogRingModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid()) {
+        return 0;
+    }
+    return m_visible.size();
+}
+
+QVariant LogRingModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() < 0 ||
+        index.row() >= m_visible.size()) {
+        return QVariant();
+    }
+
+    const DebugLogPanel::LogEntry& entry = entryAtRow(index.row());
+    if (role == Qt::DisplayRole) {
+        return m_formatter ? QVariant(m_formatter(entry))
+                           : QVariant(entry.message);
+    }
+    if (role == Qt::ForegroundRole && m_foreground) {
+        return m_foreground(entry);
+    }
+    return QVariant();
+}
+
+const DebugLogPanel::LogEntry& LogRingModel::entryForSeq(quint64 seq) const {
+    const int offset = static_cast<int>(seq - m_firstSeq);
+    return m_slots.at((m_head + offset) % m_slots.size());
+}
+
+void LogRingModel::rebuildVisible() {
+    m_visible.clear();
+    for (int i = 0; i < m_count; ++i) {
+        const DebugLogPanel::LogEntry& entry =
+            m_slots.at((m_head + i) % m_slots.size());
+        if (m_matcher.matches(entry)) {
+            m_visible.append(m_firstSeq + i);
+        }
+    }
+}
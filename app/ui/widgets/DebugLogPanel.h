@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QAbstractListModel>
 #include <QAction>
 #include <QApplication>
 #include <QCheckBox>
@@ -16,38 +17,47 @@
 #include <QHeaderView>
 #include <QLabel>
 #include <QLineEdit>
+#include <QListView>
 #include <QMenu>
 #include <QMessageBox>
 #include <QMutex>
 #include <QProgressBar>
 #include <QPushButton>
+#include <QRegularExpression>
 #include <QScrollBar>
+#include <QSet>
 #include <QSettings>
 #include <QSpinBox>
 #include <QSplitter>
 #include <QTabWidget>
 #include <QTableWidget>
-#include <QTextCharFormat>
-#include <QTextCursor>
-#include <QTextEdit>
 #include <QTimer>
 #include <QVBoxLayout>
 #include <QWidget>
 #include <deque>
+#include <functional>
 #include <memory>
 #include "../../utils/Logger.h"
 #include "../../utils/LoggingManager.h"
 
+class LogRingModel;
+
 /**
  * @brief Comprehensive debug logging panel widget
  *
  * This widget provides a complete debug logging interface with:
  * - Real-time log message display
  * - Filtering by log level and category
- * - Search functionality with highlighting
+ * - Search functionality
  * - Log export capabilities
  * - Statistics display
  * - Configuration options
+ *
+ * The display is a virtualized list view over a fixed-capacity ring
+ * buffer of structured entries: only visible rows are ever formatted,
+ * and filters run as a precompiled matcher over the ring, so the panel
+ * stays cheap enough to leave open during perf investigations without
+ * distorting what it is measuring.
  */
 class DebugLogPanel : public QWidget {
     Q_OBJECT
@@ -149,6 +159,8 @@ private slots:
     void onSearchPrevious();
     void onClearLogs();
     void onExportLogs();
+    void onToggleTracing(bool enabled);
+    void onExportTrace();
     void onCopySelected();
     void onCopyAll();
     void onPauseToggled(bool paused);
@@ -180,15 +192,13 @@ private:
     void connectSignals();
     void applyConfiguration();
     void updateLogDisplay();
-    void addLogEntryToDisplay(const LogEntry& entry);
-    void filterLogEntries();
-    void highlightSearchResults();
+    void rebuildFilterMatcher();
     void updateStatistics();
     void updateStatisticsDisplay();
+    void updateMemoryBreakdown();
     QString formatLogEntry(const LogEntry& entry) const;
     QColor getLogLevelColor(Logger::LogLevel level) const;
     QString getLogLevelText(Logger::LogLevel level) const;
-    bool passesFilter(const LogEntry& entry) const;
     void scrollToBottom();
     void exportToFile(const QString& filePath);
     void showSettingsDialog();
@@ -198,9 +208,10 @@ private:
     QVBoxLayout* m_mainLayout;
     QSplitter* m_mainSplitter;
 
-    // Log display area
-    QTextEdit* m_logDisplay;
-    QScrollBar* m_scrollBar;
+    // Log display area: virtualized list over the ring model; only
+    // rows inside the viewport are formatted
+    QListView* m_logList;
+    LogRingModel* m_logModel;
 
     // Filter controls
     QGroupBox* m_filterGroup;
@@ -226,6 +237,7 @@ private:
     QTableWidget* m_statsTable;
     QLabel* m_messagesPerSecLabel;
     QProgressBar* m_memoryUsageBar;
+    QTableWidget* m_memoryTable;  // Per-subsystem attribution breakdown
 
     // Context menu
     QMenu* m_contextMenu;
@@ -234,26 +246,30 @@ private:
     QAction* m_clearAction;
     QAction* m_exportAction;
     QAction* m_pauseAction;
+    QAction* m_traceToggleAction;
+    QAction* m_exportTraceAction;
 
-    // Data management
-    std::deque<LogEntry> m_logEntries;
-    std::deque<LogEntry> m_filteredEntries;
+    // Data management. Arrivals queue here and the update timer drains
+    // them into the ring model in one batch per tick
+    std::deque<LogEntry> m_pendingEntries;
+    QSet<QString> m_knownCategories;
     mutable QMutex m_logMutex;
     QTimer* m_updateTimer;
     QTimer* m_statisticsTimer;
 
+    // Re-filtering while the user is still typing is wasted work;
+    // search text settles briefly before the matcher is rebuilt
+    QTimer* m_searchDebounce;
+
     // Configuration and state
     PanelConfiguration m_config;
     LogStatistics m_statistics;
     bool m_paused;
     bool m_autoScroll;
-    int m_currentSearchIndex;
-    QStringList m_searchResults;
 
     // Performance tracking
     QDateTime m_lastUpdateTime;
     int m_pendingMessages;
-    std::deque<LogEntry> m_pendingEntries;
 
     // Settings
     QSettings* m_settings;
@@ -262,4 +278,75 @@ private:
     static const int DEFAULT_MAX_ENTRIES;
     static const int UPDATE_INTERVAL_MS;
     static const int STATISTICS_UPDATE_INTERVAL_MS;
+    static const int SEARCH_DEBOUNCE_MS;
+};
+
+/**
+ * @brief Fixed-capacity ring of structured log entries behind a list model
+ *
+ * Entries live in a preallocated circular slot array; the model exposes
+ * the subset passing the current matcher as rows. Appending is O(1):
+ * the matcher decides visibility once per entry and nothing is
+ * formatted until the view asks for a visible row. When the ring wraps,
+ * the oldest entry (and its row, if visible) is dropped.
+ */
+class LogRingModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    // Filter state compiled once per filter change, then applied to
+    // every arriving entry without further allocation
+    struct Matcher {
+        int minLevel = 0;
+        QStringList categories;  // empty = all categories
+        QString needle;          // empty = no text filter
+        bool useRegex = false;
+        Qt::CaseSensitivity caseSensitivity = Qt::CaseInsensitive;
+        QRegularExpression pattern;  // compiled when useRegex
+
+        bool matches(const DebugLogPanel::LogEntry& entry) const;
+    };
+
+    explicit LogRingModel(QObject* parent = nullptr);
+
+    // Formatting hooks supplied by the panel; invoked only for rows the
+    // view actually paints
+    void setFormatter(std::function<QString(const DebugLogPanel::LogEntry&)> f);
+    void setForegroundProvider(
+        std::function<QVariant(const DebugLogPanel::LogEntry&)> f);
+
+    void setCapacity(int capacity);
+    void setMatcher(const Matcher& matcher);
+
+    void append(const DebugLogPanel::LogEntry& entry);
+    void clear();
+
+    // Entries currently held in the ring (filtered or not)
+    int entryCount() const { return m_count; }
+
+    // Entry behind a visible row
+    const DebugLogPanel::LogEntry& entryAtRow(int row) const;
+
+    // Re-announce all rows (display options changed, formatting differs)
+    void refreshFormatting();
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role) const override;
+
+private:
+    const DebugLogPanel::LogEntry& entryForSeq(quint64 seq) const;
+    void rebuildVisible();
+
+    QVector<DebugLogPanel::LogEntry> m_slots;
+    int m_head;        // slot of the oldest entry
+    int m_count;       // entries currently in the ring
+    quint64 m_firstSeq;  // sequence number of the oldest entry
+
+    // Sequence numbers of entries passing the matcher, ascending;
+    // these are the model rows
+    QList<quint64> m_visible;
+
+    Matcher m_matcher;
+    std::function<QString(const DebugLogPanel::LogEntry&)> m_formatter;
+    std::function<QVariant(const DebugLogPanel::LogEntry&)> m_foreground;
 };
@@ -175,6 +175,23 @@ void DocumentTabWidget::setTabLoadingState(int index, bool loading) {
     }
 }
 
+void DocumentTabWidget::setTabPendingState(int index, bool pending) {
+    if (index >= 0 && index < count()) {
+        QString currentText = tabText(index);
+
+        if (pending) {
+            // 会话恢复的占位标签页：文档尚未加载
+            if (!currentText.contains("(未加载)")) {
+                setTabText(index, currentText + " (未加载)");
+            }
+        } else {
+            QString newText = currentText;
+            newText.remove(" (未加载)");
+            setTabText(index, newText);
+        }
+    }
+}
+
 void DocumentTabWidget::moveTab(int from, int to) {
     if (from == to || from < 0 || to < 0 || from >= count() || to >= count()) {
         return;
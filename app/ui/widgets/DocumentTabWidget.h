@@ -47,6 +47,7 @@ public:
     void updateTabText(int index, const QString& fileName);
     void setCurrentTab(int index);
     void setTabLoadingState(int index, bool loading);
+    void setTabPendingState(int index, bool pending);
 
     // 拖拽支持
     void moveTab(int from, int to);
@@ -8,18 +8,24 @@
 #include <QLabel>
 #include <QMouseEvent>
 #include <QPainter>
+#include <QPointer>
 #include <QPushButton>
 #include <QScrollArea>
 #include <QTimer>
 #include <QVBoxLayout>
+#include "../../cache/DiskRenderCache.h"
 #include "../../managers/FileTypeIconManager.h"
 #include "../../managers/RecentFilesManager.h"
+#include "../../managers/RenderScheduler.h"
 #include "../../managers/StyleManager.h"
+#include "../../utils/PDFMetadataProbe.h"
 
 // Static const member definitions
 const int RecentFileItemWidget::ITEM_HEIGHT;
 const int RecentFileItemWidget::PADDING;
 const int RecentFileItemWidget::SPACING;
+const int RecentFileItemWidget::PREVIEW_WIDTH;
+const int RecentFileItemWidget::PREVIEW_HEIGHT;
 
 const int RecentFileListWidget::MAX_VISIBLE_ITEMS;
 const int RecentFileListWidget::REFRESH_DELAY;
@@ -31,6 +37,7 @@ RecentFileItemWidget::RecentFileItemWidget(const RecentFileInfo& fileInfo,
       m_fileInfo(fileInfo),
       m_mainLayout(nullptr),
       m_infoLayout(nullptr),
+      m_previewLabel(nullptr),
       m_fileIconLabel(nullptr),
       m_fileNameLabel(nullptr),
       m_filePathLabel(nullptr),
@@ -51,6 +58,7 @@ RecentFileItemWidget::RecentFileItemWidget(const RecentFileInfo& fileInfo,
     setupAnimations();
     updateDisplay();
     applyTheme();
+    loadPreviewFromCache();
 }
 
 RecentFileItemWidget::~RecentFileItemWidget() {}
@@ -195,6 +203,14 @@ void RecentFileItemWidget::setupUI() {
     m_mainLayout->setContentsMargins(16, 12, 16, 12);
     m_mainLayout->setSpacing(12);
 
+    // 首页预览：像素在后台从磁盘缓存mmap进来；未命中时保持隐藏，
+    // 行布局与纯文本版完全一致
+    m_previewLabel = new QLabel();
+    m_previewLabel->setObjectName("RecentFilePreviewLabel");
+    m_previewLabel->setFixedSize(PREVIEW_WIDTH, PREVIEW_HEIGHT);
+    m_previewLabel->setAlignment(Qt::AlignCenter);
+    m_previewLabel->setVisible(false);
+
     // 文件类型图标
     m_fileIconLabel = new QLabel();
     m_fileIconLabel->setObjectName("RecentFileIconLabel");
@@ -231,6 +247,7 @@ void RecentFileItemWidget::setupUI() {
             &RecentFileItemWidget::onRemoveClicked);
 
     // Layout assembly
+    m_mainLayout->addWidget(m_previewLabel, 0, Qt::AlignVCenter);
     m_mainLayout->addWidget(m_fileIconLabel, 0, Qt::AlignTop);
     m_mainLayout->addLayout(m_infoLayout, 1);
     m_mainLayout->addWidget(m_removeButton, 0, Qt::AlignTop);
@@ -328,10 +345,89 @@ void RecentFileItemWidget::updateDisplay() {
 
     m_lastOpenedLabel->setText(timeText);
 
-    // 设置工具提示
-    setToolTip(QString("%1\n%2\nLast opened: %3")
-                   .arg(m_fileInfo.fileName, m_fileInfo.filePath,
-                        m_fileInfo.lastOpened.toString()));
+    // 设置工具提示：探针缓存过的文件直接附带标题/作者/页数；
+    // 冷文件先给基本提示，后台探针完成后补全（结果落盘，下次即中）
+    const PDFMetadata metadata =
+        PDFMetadataProbe::cachedOnly(m_fileInfo.filePath);
+    setToolTip(buildToolTip(metadata));
+    if (!metadata.valid) {
+        QPointer<RecentFileItemWidget> self(this);
+        const QString path = m_fileInfo.filePath;
+        RenderScheduler::instance().submit(
+            RenderScheduler::TaskClass::Background, [self, path]() {
+                const PDFMetadata probed = PDFMetadataProbe::probe(path);
+                if (!probed.valid || !self) {
+                    return;
+                }
+                QMetaObject::invokeMethod(
+                    self,
+                    [self, probed]() {
+                        if (self) {
+                            self->setToolTip(self->buildToolTip(probed));
+                        }
+                    },
+                    Qt::QueuedConnection);
+            });
+    }
+}
+
+void RecentFileItemWidget::loadPreviewFromCache() {
+    // 只读持久缓存：关闭时落盘的首页缩略图mmap进来即显示，
+    // 未命中则保持现状——欢迎页决不为预览打开文档
+    QPointer<RecentFileItemWidget> self(this);
+    const QString path = m_fileInfo.filePath;
+    RenderScheduler::instance().submit(
+        RenderScheduler::TaskClass::Background, [self, path]() {
+            const QString hash = DiskRenderCache::hashForFile(path);
+            if (hash.isEmpty() || !self) {
+                return;
+            }
+            DiskRenderCache disk;
+            disk.setDocumentHash(hash);
+            QImage image = disk.load(0, QSize(), 0);
+            if (image.isNull()) {
+                return;
+            }
+            // 缩放产生独立像素副本，mmap映射随原图析构释放，
+            // 不会带着文件映射跨线程
+            QImage scaled =
+                image.scaled(PREVIEW_WIDTH, PREVIEW_HEIGHT, Qt::KeepAspectRatio,
+                             Qt::SmoothTransformation);
+            QMetaObject::invokeMethod(
+                self,
+                [self, scaled]() {
+                    if (self) {
+                        self->setPreviewImage(scaled);
+                    }
+                },
+                Qt::QueuedConnection);
+        });
+}
+
+void RecentFileItemWidget::setPreviewImage(const QImage& image) {
+    if (!m_previewLabel || image.isNull()) {
+        return;
+    }
+    m_previewLabel->setPixmap(QPixmap::fromImage(image));
+    m_previewLabel->setVisible(true);
+}
+
+QString RecentFileItemWidget::buildToolTip(const PDFMetadata& metadata) const {
+    QString tip = QString("%1\n%2\nLast opened: %3")
+                      .arg(m_fileInfo.fileName, m_fileInfo.filePath,
+                           m_fileInfo.lastOpened.toString());
+    if (metadata.valid) {
+        if (!metadata.title.isEmpty()) {
+            tip += QString("\nTitle: %1").arg(metadata.title);
+        }
+        if (!metadata.author.isEmpty()) {
+            tip += QString("\nAuthor: %1").arg(metadata.author);
+        }
+        if (metadata.pageCount >= 0) {
+            tip += QString("\nPages: %1").arg(metadata.pageCount);
+        }
+    }
+    return tip;
 }
 
 void RecentFileItemWidget::setHovered(bool hovered) {
@@ -15,6 +15,7 @@
 #include <QWidget>
 
 class RecentFilesManager;
+struct PDFMetadata;
 #include "../../managers/RecentFilesManager.h"
 
 /**
@@ -36,6 +37,10 @@ public:
     // 主题支持
     void applyTheme();
 
+    // 首页预览（欢迎页预览条）：像素来自持久渲染缓存，未命中时
+    // 该行保持纯文本布局
+    void setPreviewImage(const QImage& image);
+
 signals:
     void clicked(const QString& filePath);
     void removeRequested(const QString& filePath);
@@ -54,6 +59,10 @@ private:
     void setupUI();
     void setupAnimations();
     void updateDisplay();
+    // 后台mmap读取磁盘缓存里的首页缩略图；决不打开文档
+    void loadPreviewFromCache();
+    // 工具提示正文；探针命中时附带标题/作者/页数
+    QString buildToolTip(const PDFMetadata& metadata) const;
     void setHovered(bool hovered);
     void startHoverAnimation(bool hovered);
     void startPressAnimation();
@@ -63,6 +72,7 @@ private:
     // UI组件
     QHBoxLayout* m_mainLayout;
     QVBoxLayout* m_infoLayout;
+    QLabel* m_previewLabel;   // First-page preview from the disk cache
     QLabel* m_fileIconLabel;  // File type icon
     QLabel* m_fileNameLabel;
     QLabel* m_filePathLabel;
@@ -84,6 +94,8 @@ private:
         64;  // Increased height for icon and better spacing
     static const int PADDING = 16;  // Enhanced padding for modern card look
     static const int SPACING = 4;   // Improved spacing between elements
+    static const int PREVIEW_WIDTH = 30;   // 首页预览尺寸（纵向页面比例）
+    static const int PREVIEW_HEIGHT = 40;
 };
 
 /**
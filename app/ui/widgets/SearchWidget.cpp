@@ -71,11 +71,13 @@ void SearchWidget::setupUI() {
     m_wholeWordsCheck = new QCheckBox("全词匹配");
     m_regexCheck = new QCheckBox("正则表达式");
     m_searchBackwardCheck = new QCheckBox("向后搜索");
+    m_allDocumentsCheck = new QCheckBox("搜索所有打开的文档");
 
     optionsLayout->addWidget(m_caseSensitiveCheck);
     optionsLayout->addWidget(m_wholeWordsCheck);
     optionsLayout->addWidget(m_regexCheck);
     optionsLayout->addWidget(m_searchBackwardCheck);
+    optionsLayout->addWidget(m_allDocumentsCheck);
 
     // Results view
     m_resultsView = new QListView();
@@ -132,6 +134,14 @@ void SearchWidget::setupConnections() {
     connect(m_searchModel, &SearchModel::currentResultChanged, this,
             &SearchWidget::onCurrentResultChanged);
 
+    // Keep the count and navigation buttons live while shards stream in,
+    // so the first hits are navigable before the search finishes
+    connect(m_searchModel, &SearchModel::rowsInserted, this,
+            [this](const QModelIndex&, int, int) {
+                updateResultsInfo();
+                updateNavigationButtons();
+            });
+
     // Search timer for real-time search
     connect(m_searchTimer, &QTimer::timeout, this,
             &SearchWidget::performRealTimeSearch);
@@ -206,7 +216,13 @@ void SearchWidget::performSearch() {
     }
 
     SearchOptions options = getSearchOptions();
-    m_searchModel->startSearch(m_document, query, options);
+    if (m_allDocumentsCheck->isChecked() && m_openDocumentsProvider) {
+        // One query across every open tab, on the shared worker pool
+        m_searchModel->startMultiDocumentSearch(m_openDocumentsProvider(),
+                                                m_document, query, options);
+    } else {
+        m_searchModel->startSearch(m_document, query, options);
+    }
     emit searchRequested(query, options);
 }
 
@@ -217,7 +233,14 @@ void SearchWidget::performRealTimeSearch() {
     }
 
     SearchOptions options = getSearchOptions();
-    m_searchModel->startRealTimeSearch(m_document, query, options);
+    if (m_allDocumentsCheck->isChecked() && m_openDocumentsProvider) {
+        // The debounce timer already gates typing; the multi-document
+        // search itself streams in from the pool like a full search
+        m_searchModel->startMultiDocumentSearch(m_openDocumentsProvider(),
+                                                m_document, query, options);
+    } else {
+        m_searchModel->startRealTimeSearch(m_document, query, options);
+    }
     emit searchRequested(query, options);
 }
 
@@ -230,8 +253,7 @@ void SearchWidget::nextResult() {
         updateNavigationButtons();
 
         // Navigate to result with highlighting
-        emit navigateToResult(result.pageNumber, result.boundingRect);
-        emit resultSelected(result);
+        emitResultNavigation(m_searchModel->getCurrentResultIndex(), result);
 
         // Update status with current position
         int currentIndex = m_searchModel->getCurrentResultIndex();
@@ -250,8 +272,7 @@ void SearchWidget::previousResult() {
         updateNavigationButtons();
 
         // Navigate to result with highlighting
-        emit navigateToResult(result.pageNumber, result.boundingRect);
-        emit resultSelected(result);
+        emitResultNavigation(m_searchModel->getCurrentResultIndex(), result);
 
         // Update status with current position
         int currentIndex = m_searchModel->getCurrentResultIndex();
@@ -265,8 +286,7 @@ void SearchWidget::onResultClicked(const QModelIndex& index) {
     if (index.isValid()) {
         SearchResult result = m_searchModel->getResult(index.row());
         m_searchModel->setCurrentResultIndex(index.row());
-        emit navigateToResult(result.pageNumber, result.boundingRect);
-        emit resultSelected(result);
+        emitResultNavigation(index.row(), result);
     }
 }
 
@@ -299,8 +319,7 @@ void SearchWidget::onSearchFinished(int resultCount) {
         // Auto-navigate to first result
         if (m_searchModel->getCurrentResultIndex() >= 0) {
             SearchResult result = m_searchModel->getResult(0);
-            emit navigateToResult(result.pageNumber, result.boundingRect);
-            emit resultSelected(result);
+            emitResultNavigation(0, result);
         }
     } else {
         m_statusLabel->setText("未找到匹配结果");
@@ -342,6 +361,12 @@ void SearchWidget::updateResultsInfo() {
     } else {
         m_resultInfoLabel->setText("0 / 0");
     }
+
+    // Surface which match strategy the query compiler picked
+    if (!m_searchModel->lastSearchStrategy().isEmpty()) {
+        m_resultInfoLabel->setToolTip(QString("Match strategy: %1")
+                                          .arg(m_searchModel->lastSearchStrategy()));
+    }
 }
 
 SearchOptions SearchWidget::getSearchOptions() const {
@@ -395,7 +420,22 @@ void SearchWidget::navigateToCurrentResult() {
     if (currentIndex >= 0 &&
         currentIndex < m_searchModel->getResults().size()) {
         SearchResult result = m_searchModel->getResult(currentIndex);
+        emitResultNavigation(currentIndex, result);
+    }
+}
+
+// Routes a selected result to the right target: single-document results
+// keep the existing navigateToResult path, while cross-document hits
+// report the owning tab (and that tab's local page) so the container
+// can switch documents before jumping
+void SearchWidget::emitResultNavigation(int row, const SearchResult& result) {
+    if (m_searchModel->isMultiDocumentSearch()) {
+        emit navigateToDocumentResult(
+            m_searchModel->documentIdForRow(row),
+            m_searchModel->localPageNumber(result.pageNumber),
+            result.boundingRect);
+    } else {
         emit navigateToResult(result.pageNumber, result.boundingRect);
-        emit resultSelected(result);
     }
+    emit resultSelected(result);
 }
@@ -11,6 +11,7 @@
 #include <QTimer>
 #include <QVBoxLayout>
 #include <QWidget>
+#include <functional>
 #include "../../model/SearchModel.h"
 
 class QShortcut;
@@ -34,6 +35,14 @@ public:
     // Search model access
     SearchModel* getSearchModel() const { return m_searchModel; }
 
+    // Supplies the open-tab list for "search all documents" on demand;
+    // set by the view container, which knows every tab's document, name
+    // and model index. Unset, the option falls back to the current tab
+    void setOpenDocumentsProvider(
+        std::function<QList<SearchModel::OpenDocument>()> provider) {
+        m_openDocumentsProvider = std::move(provider);
+    }
+
     // Current search state
     bool hasResults() const;
     int getResultCount() const;
@@ -43,6 +52,10 @@ signals:
     void searchRequested(const QString& query, const SearchOptions& options);
     void resultSelected(const SearchResult& result);
     void navigateToResult(int pageNumber, const QRectF& rect);
+    // Cross-document navigation: documentId is the tab's model index,
+    // pageNumber is local to that document
+    void navigateToDocumentResult(int documentId, int pageNumber,
+                                  const QRectF& rect);
     void searchClosed();
     void searchCleared();
 
@@ -77,6 +90,7 @@ private:
     void updateResultsInfo();
     SearchOptions getSearchOptions() const;
     void setSearchInProgress(bool inProgress);
+    void emitResultNavigation(int row, const SearchResult& result);
 
     // UI Components
     QVBoxLayout* m_mainLayout;
@@ -102,6 +116,7 @@ private:
     QCheckBox* m_wholeWordsCheck;
     QCheckBox* m_regexCheck;
     QCheckBox* m_searchBackwardCheck;
+    QCheckBox* m_allDocumentsCheck;
 
     // Results display
     QListView* m_resultsView;
@@ -111,6 +126,7 @@ private:
     // Data and state
     SearchModel* m_searchModel;
     Poppler::Document* m_document;
+    std::function<QList<SearchModel::OpenDocument>()> m_openDocumentsProvider;
     QTimer* m_searchTimer;  // For debounced search
     bool m_optionsVisible;
 
@@ -0,0 +1,51 @@
+#include "CancellationToken.h"
+#include <poppler-qt6.h>
+#include <QVariant>
+
+CancellationToken::CancellationToken()
+    : m_cancelled(std::make_shared<std::atomic<bool>>(false)) {}
+
+void CancellationToken::cancel() {
+    m_cancelled->store(true, std::memory_order_relaxed);
+}
+
+bool CancellationToken::isCancelled() const {
+    return m_cancelled->load(std::memory_order_relaxed);
+}
+
+namespace CancellableRender {
+
+namespace {
+
+// Poppler polls this between raster bands; the payload carries the
+// caller's token by address
+bool shouldAbort(const QVariant& payload) {
+    const auto* token =
+        reinterpret_cast<const CancellationToken*>(payload.value<quintptr>());
+    return token && token->isCancelled();
+}
+
+}  // namespace
+
+QImage renderToImage(Poppler::Page* page, const CancellationToken& token,
+                     double xres, double yres, int x, int y, int w, int h,
+                     int rotation) {
+    if (!page || token.isCancelled()) {
+        return QImage();
+    }
+
+    QImage image = page->renderToImage(
+        xres, yres, x, y, w, h,
+        static_cast<Poppler::Page::Rotation>(rotation), nullptr, nullptr,
+        shouldAbort,
+        QVariant::fromValue<quintptr>(reinterpret_cast<quintptr>(&token)));
+
+    // An aborted render can hand back a partially drawn buffer; return
+    // null instead so callers never cache or display it
+    if (token.isCancelled()) {
+        return QImage();
+    }
+    return image;
+}
+
+}  // namespace CancellableRender
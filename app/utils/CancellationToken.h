@@ -0,0 +1,50 @@
+#pragma once
+
+#include <QImage>
+#include <atomic>
+#include <memory>
+
+namespace Poppler {
+class Page;
+}
+
+/**
+ * Shared cancellation token for async render work.
+ *
+ * Cancellation used to be a patchwork: ThumbnailGenerator invalidated
+ * job ids, PDFPrerenderer relied on running flags, and none of it
+ * reached an in-flight Poppler call, so cancelled work still burned a
+ * core to completion. A token is a copyable handle on one shared flag:
+ * the producer keeps a copy, every queued and in-flight job captures a
+ * copy, and cancel() flips the flag for all of them at once. Jobs
+ * check isCancelled() at page granularity before starting, and
+ * CancellableRender::renderToImage() wires the flag into Poppler's
+ * shouldAbortRenderCallback so a cancel lands mid-raster — within
+ * milliseconds — instead of after the page completes.
+ *
+ * A default-constructed token is live (not cancelled); it only fires
+ * when someone holding a copy calls cancel().
+ */
+class CancellationToken {
+public:
+    CancellationToken();
+
+    // Flips the shared flag; every copy of this token observes it
+    void cancel();
+    bool isCancelled() const;
+
+private:
+    std::shared_ptr<std::atomic<bool>> m_cancelled;
+};
+
+namespace CancellableRender {
+
+// Poppler page render with the token wired into the abort callback.
+// rotation is in Poppler::Page::Rotation units (quarter turns). The
+// token must outlive the call. Returns a null image when aborted, so
+// partially drawn buffers never reach a cache.
+QImage renderToImage(Poppler::Page* page, const CancellationToken& token,
+                     double xres, double yres, int x = -1, int y = -1,
+                     int w = -1, int h = -1, int rotation = 0);
+
+}  // namespace CancellableRender
@@ -6,6 +6,7 @@
 #include <QFutureWatcher>
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QMutex>
 #include <QObject>
 #include <QString>
 #include <QStringList>
@@ -198,6 +199,16 @@ private:
     bool hasCachedResult(const QString& key) const;
     void evictOldCacheEntries();
 
+    // Incremental per-page analysis. Each page gets a fingerprint
+    // (text hash, font set, page geometry) persisted alongside the
+    // expensive metrics computed from it; re-analysis only recomputes
+    // pages whose fingerprint changed since the last run.
+    QString fingerprintFilePath(const QString& documentKey) const;
+    void loadPageFingerprints(const QString& documentKey);
+    void savePageFingerprints();
+    QString fingerprintForPage(Poppler::Document* document, int pageNumber,
+                               const QString& pageText) const;
+
     // Data members
     QList<AnalysisResult> m_results;
     QHash<QString, AnalysisResult> m_resultCache;
@@ -215,6 +226,15 @@ private:
     bool m_cachingEnabled;
     qint64 m_maxCacheSize;
 
+    // Per-page fingerprint cache for the document currently analyzed.
+    // m_runFingerprints holds fingerprints computed during this run so
+    // later analysis passes do not re-hash pages.
+    QHash<int, QJsonObject> m_pageFingerprints;
+    QHash<int, QString> m_runFingerprints;
+    QString m_fingerprintKey;
+    bool m_fingerprintsDirty;
+    mutable QMutex m_fingerprintMutex;
+
     QTimer* m_progressTimer;
     QElapsedTimer m_batchTimer;
 
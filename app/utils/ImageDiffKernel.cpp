@@ -0,0 +1,169 @@
+#include "ImageDiffKernel.h"
+#include <QtGlobal>
+
+#if defined(Q_PROCESSOR_X86) && (defined(__GNUC__) || defined(__clang__))
+#define IMAGEDIFF_HAS_X86_SIMD 1
+#include <emmintrin.h>
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Mean absolute per-byte delta above which a block counts as differing;
+// tolerates antialiasing and compression noise in scanned pages
+constexpr double BLOCK_DIFF_THRESHOLD = 3.0;
+
+// Scanline stride of the downsampled pre-pass within a block
+constexpr int PREPASS_ROW_STEP = 4;
+
+quint64 sadScalar(const uchar* a, const uchar* b, qsizetype bytes) {
+    quint64 sum = 0;
+    for (qsizetype i = 0; i < bytes; ++i) {
+        sum += static_cast<quint64>(a[i] > b[i] ? a[i] - b[i] : b[i] - a[i]);
+    }
+    return sum;
+}
+
+#ifdef IMAGEDIFF_HAS_X86_SIMD
+
+__attribute__((target("sse2"))) quint64 sadSse2(const uchar* a, const uchar* b,
+                                                qsizetype bytes) {
+    __m128i acc = _mm_setzero_si128();
+    qsizetype i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(va, vb));
+    }
+    quint64 sum =
+        static_cast<quint64>(_mm_cvtsi128_si64(acc)) +
+        static_cast<quint64>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(acc, acc)));
+    return sum + sadScalar(a + i, b + i, bytes - i);
+}
+
+__attribute__((target("avx2"))) quint64 sadAvx2(const uchar* a, const uchar* b,
+                                                qsizetype bytes) {
+    __m256i acc = _mm256_setzero_si256();
+    qsizetype i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        __m256i va =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(va, vb));
+    }
+    alignas(32) quint64 lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    quint64 sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    return sum + sadSse2(a + i, b + i, bytes - i);
+}
+
+#endif  // IMAGEDIFF_HAS_X86_SIMD
+
+using SadFn = quint64 (*)(const uchar*, const uchar*, qsizetype);
+
+SadFn resolveSadKernel() {
+#ifdef IMAGEDIFF_HAS_X86_SIMD
+    if (__builtin_cpu_supports("avx2")) {
+        return sadAvx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return sadSse2;
+    }
+#endif
+    return sadScalar;
+}
+
+// Resolved once per process; all threads call through the pointer
+const SadFn g_sad = resolveSadKernel();
+
+}  // namespace
+
+ImageDiffKernel::BlockStats ImageDiffKernel::compareBlocks(
+    const QImage& image1, const QImage& image2, int blockSize) {
+    BlockStats stats;
+
+    if (image1.isNull() || image2.isNull() ||
+        image1.size() != image2.size() || blockSize <= 0) {
+        return stats;
+    }
+
+    QImage img1 = image1;
+    QImage img2 = image2;
+    if (img1.format() != QImage::Format_RGB32) {
+        img1 = img1.convertToFormat(QImage::Format_RGB32);
+    }
+    if (img2.format() != QImage::Format_RGB32) {
+        img2 = img2.convertToFormat(QImage::Format_RGB32);
+    }
+
+    const int width = img1.width();
+    const int height = img1.height();
+    constexpr int bytesPerPixel = 4;
+
+    for (int by = 0; by < height; by += blockSize) {
+        const int blockHeight = qMin(blockSize, height - by);
+
+        for (int bx = 0; bx < width; bx += blockSize) {
+            const int blockWidth = qMin(blockSize, width - bx);
+            const qsizetype rowBytes =
+                static_cast<qsizetype>(blockWidth) * bytesPerPixel;
+
+            ++stats.totalBlocks;
+
+            // Pre-pass over every 4th scanline. Zero delta at the
+            // sampled resolution marks the block identical and skips the
+            // full pass - the common case when edits are localized
+            quint64 blockSad = 0;
+            for (int y = 0; y < blockHeight; y += PREPASS_ROW_STEP) {
+                const uchar* row1 =
+                    img1.constScanLine(by + y) + bx * bytesPerPixel;
+                const uchar* row2 =
+                    img2.constScanLine(by + y) + bx * bytesPerPixel;
+                blockSad += g_sad(row1, row2, rowBytes);
+                stats.bytesCompared += rowBytes;
+            }
+
+            if (blockSad == 0) {
+                ++stats.skippedBlocks;
+                continue;
+            }
+
+            // Full-resolution pass over the scanlines the pre-pass
+            // stepped over
+            for (int y = 0; y < blockHeight; ++y) {
+                if (y % PREPASS_ROW_STEP == 0) {
+                    continue;
+                }
+                const uchar* row1 =
+                    img1.constScanLine(by + y) + bx * bytesPerPixel;
+                const uchar* row2 =
+                    img2.constScanLine(by + y) + bx * bytesPerPixel;
+                blockSad += g_sad(row1, row2, rowBytes);
+                stats.bytesCompared += rowBytes;
+            }
+
+            stats.sumAbsoluteDifference += blockSad;
+
+            const qsizetype blockBytes =
+                static_cast<qsizetype>(blockHeight) * rowBytes;
+            const double meanPerByte =
+                static_cast<double>(blockSad) / blockBytes;
+            if (meanPerByte > BLOCK_DIFF_THRESHOLD) {
+                ++stats.differingBlocks;
+            }
+        }
+    }
+
+    return stats;
+}
+
+double ImageDiffKernel::similarity(const QImage& image1,
+                                   const QImage& image2) {
+    const BlockStats stats = compareBlocks(image1, image2);
+    if (stats.totalBlocks == 0) {
+        return 1.0;
+    }
+    return 1.0 - static_cast<double>(stats.differingBlocks) /
+                     static_cast<double>(stats.totalBlocks);
+}
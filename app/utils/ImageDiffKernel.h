@@ -0,0 +1,34 @@
+#pragma once
+
+#include <QImage>
+
+/**
+ * Vectorized pixel-difference kernel for visual page comparison.
+ *
+ * Compares two same-sized images block by block. A downsampled pre-pass
+ * (every 4th scanline of each block) skips blocks that show no delta at
+ * the sampled resolution, and the remaining blocks are scored with a
+ * byte-SAD (sum of absolute differences) inner loop. On x86 the SAD
+ * loop dispatches at runtime to AVX2 or SSE2; elsewhere it falls back
+ * to a scalar loop the compiler can auto-vectorize.
+ */
+class ImageDiffKernel {
+public:
+    struct BlockStats {
+        qint64 totalBlocks = 0;
+        qint64 differingBlocks = 0;  // Mean delta above the noise threshold
+        qint64 skippedBlocks = 0;    // Identical at pre-pass resolution
+        qint64 sumAbsoluteDifference = 0;
+        qint64 bytesCompared = 0;
+    };
+
+    // Block-level comparison. Sizes must match; inputs are converted to
+    // RGB32 if they are in another format
+    static BlockStats compareBlocks(const QImage& image1,
+                                    const QImage& image2, int blockSize = 16);
+
+    // 0.0-1.0 similarity score: the fraction of blocks whose mean
+    // per-byte difference stays below a small tolerance, so antialiasing
+    // and scan noise do not register as differences
+    static double similarity(const QImage& image1, const QImage& image2);
+};
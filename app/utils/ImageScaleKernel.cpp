@@ -0,0 +1,275 @@
+#include "ImageScaleKernel.h"
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+#include <QtGlobal>
+
+#if defined(Q_PROCESSOR_X86) && (defined(__GNUC__) || defined(__clang__))
+#define IMAGESCALE_HAS_X86_SIMD 1
+#include <emmintrin.h>
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Destination row count above which a halving level is split into row
+// bands across the global thread pool; below it the fork-join overhead
+// outweighs the work
+constexpr int PARALLEL_MIN_DST_ROWS = 512;
+
+constexpr int BYTES_PER_PIXEL = 4;
+
+// One destination row from two source rows: each output pixel is the
+// rounded mean of a 2x2 source block, per byte (exact to within 1 LSB
+// in the SIMD paths, which compose two rounded averages)
+void halveRowScalar(const uchar* row0, const uchar* row1, uchar* dst,
+                    int dstPixels) {
+    for (int x = 0; x < dstPixels; ++x) {
+        const uchar* a = row0 + 2 * BYTES_PER_PIXEL * x;
+        const uchar* b = row1 + 2 * BYTES_PER_PIXEL * x;
+        for (int c = 0; c < BYTES_PER_PIXEL; ++c) {
+            dst[BYTES_PER_PIXEL * x + c] = static_cast<uchar>(
+                (a[c] + a[c + BYTES_PER_PIXEL] + b[c] +
+                 b[c + BYTES_PER_PIXEL] + 2) >>
+                2);
+        }
+    }
+}
+
+#ifdef IMAGESCALE_HAS_X86_SIMD
+
+__attribute__((target("sse2"))) void halveRowSse2(const uchar* row0,
+                                                  const uchar* row1,
+                                                  uchar* dst, int dstPixels) {
+    int x = 0;
+    // 16 source bytes (4 pixels) per iteration -> 2 destination pixels:
+    // vertical average of the two rows, then average with the copy
+    // shifted one pixel left so dwords 0 and 2 hold the 2x2 means
+    for (; x + 2 <= dstPixels; x += 2) {
+        __m128i r0 = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(row0 + 8 * x));
+        __m128i r1 = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(row1 + 8 * x));
+        __m128i v = _mm_avg_epu8(r0, r1);
+        __m128i h = _mm_avg_epu8(v, _mm_srli_si128(v, 4));
+        __m128i packed = _mm_shuffle_epi32(h, _MM_SHUFFLE(2, 0, 2, 0));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 4 * x), packed);
+    }
+    halveRowScalar(row0 + 8 * x, row1 + 8 * x, dst + 4 * x, dstPixels - x);
+}
+
+__attribute__((target("avx2"))) void halveRowAvx2(const uchar* row0,
+                                                  const uchar* row1,
+                                                  uchar* dst, int dstPixels) {
+    const __m256i gather = _mm256_setr_epi32(0, 2, 4, 6, 0, 0, 0, 0);
+    int x = 0;
+    // 32 source bytes (8 pixels) per iteration -> 4 destination pixels
+    for (; x + 4 <= dstPixels; x += 4) {
+        __m256i r0 = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(row0 + 8 * x));
+        __m256i r1 = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(row1 + 8 * x));
+        __m256i v = _mm256_avg_epu8(r0, r1);
+        __m256i h = _mm256_avg_epu8(v, _mm256_srli_si256(v, 4));
+        __m256i packed = _mm256_permutevar8x32_epi32(h, gather);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4 * x),
+                         _mm256_castsi256_si128(packed));
+    }
+    halveRowSse2(row0 + 8 * x, row1 + 8 * x, dst + 4 * x, dstPixels - x);
+}
+
+#endif  // IMAGESCALE_HAS_X86_SIMD
+
+using HalveRowFn = void (*)(const uchar*, const uchar*, uchar*, int);
+
+HalveRowFn resolveHalveKernel() {
+#ifdef IMAGESCALE_HAS_X86_SIMD
+    if (__builtin_cpu_supports("avx2")) {
+        return halveRowAvx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return halveRowSse2;
+    }
+#endif
+    return halveRowScalar;
+}
+
+// Resolved once per process; all threads call through the pointer
+const HalveRowFn g_halveRow = resolveHalveKernel();
+
+void halveBand(const uchar* srcBits, qsizetype srcStride, uchar* dstBits,
+               qsizetype dstStride, int dstWidth, int yBegin, int yEnd) {
+    for (int y = yBegin; y < yEnd; ++y) {
+        g_halveRow(srcBits + 2 * y * srcStride,
+                   srcBits + (2 * y + 1) * srcStride, dstBits + y * dstStride,
+                   dstWidth);
+    }
+}
+
+}  // namespace
+
+QImage ImageScaleKernel::halve(const QImage& source) {
+    QImage src = source;
+    // Byte-wise averaging needs a 32-bit layout; straight (unassociated)
+    // alpha would average incorrectly across transparency edges, so it
+    // goes through the premultiplied form
+    if (src.format() != QImage::Format_RGB32 &&
+        src.format() != QImage::Format_ARGB32_Premultiplied) {
+        src = src.convertToFormat(src.hasAlphaChannel()
+                                      ? QImage::Format_ARGB32_Premultiplied
+                                      : QImage::Format_RGB32);
+    }
+
+    const int dstWidth = src.width() / 2;
+    const int dstHeight = src.height() / 2;
+    if (dstWidth < 1 || dstHeight < 1) {
+        return src;
+    }
+
+    QImage dst(dstWidth, dstHeight, src.format());
+    if (dst.isNull()) {
+        return src;
+    }
+    dst.setDevicePixelRatio(src.devicePixelRatio());
+
+    // Detach once up front: scanLine() from worker threads would race
+    // on the copy-on-write detach
+    const uchar* srcBits = src.constBits();
+    const qsizetype srcStride = src.bytesPerLine();
+    uchar* dstBits = dst.bits();
+    const qsizetype dstStride = dst.bytesPerLine();
+
+    const int threads =
+        dstHeight >= PARALLEL_MIN_DST_ROWS
+            ? qBound(1, QThread::idealThreadCount(),
+                     dstHeight / (PARALLEL_MIN_DST_ROWS / 2))
+            : 1;
+    if (threads <= 1) {
+        halveBand(srcBits, srcStride, dstBits, dstStride, dstWidth, 0,
+                  dstHeight);
+        return dst;
+    }
+
+    // Row bands are independent, so extra bands go to the global pool
+    // opportunistically: if the pool is saturated, tryStart fails and
+    // the band just runs inline — no queueing behind long render jobs
+    QSemaphore done;
+    int pooled = 0;
+    const int rowsPerBand = (dstHeight + threads - 1) / threads;
+    for (int yBegin = 0; yBegin < dstHeight; yBegin += rowsPerBand) {
+        const int yEnd = qMin(yBegin + rowsPerBand, dstHeight);
+        const bool lastBand = yEnd == dstHeight;
+        bool started = false;
+        if (!lastBand) {
+            started = QThreadPool::globalInstance()->tryStart(
+                [srcBits, srcStride, dstBits, dstStride, dstWidth, yBegin,
+                 yEnd, &done]() {
+                    halveBand(srcBits, srcStride, dstBits, dstStride,
+                              dstWidth, yBegin, yEnd);
+                    done.release();
+                });
+        }
+        if (started) {
+            ++pooled;
+        } else {
+            halveBand(srcBits, srcStride, dstBits, dstStride, dstWidth,
+                      yBegin, yEnd);
+        }
+    }
+    done.acquire(pooled);
+
+    return dst;
+}
+
+QImage ImageScaleKernel::downscale(const QImage& source,
+                                   const QSize& targetSize) {
+    if (source.isNull() || targetSize.isEmpty()) {
+        return source;
+    }
+
+    const QSize target = source.size().scaled(targetSize, Qt::KeepAspectRatio);
+    if (target.width() >= source.width() ||
+        target.height() >= source.height()) {
+        return source.scaled(targetSize, Qt::KeepAspectRatio,
+                             Qt::SmoothTransformation);
+    }
+
+    QImage current = source;
+    while (current.width() / 2 >= target.width() &&
+           current.height() / 2 >= target.height()) {
+        current = halve(current);
+    }
+
+    // Remaining ratio is below 2x, where the smooth transform is both
+    // cheap and the better resampler
+    if (current.size() != target) {
+        current = current.scaled(target, Qt::IgnoreAspectRatio,
+                                 Qt::SmoothTransformation);
+    }
+    return current;
+}
+
+QRect ImageScaleKernel::contentBox(const QImage& source,
+                                   int luminanceThreshold) {
+    if (source.isNull()) {
+        return QRect();
+    }
+
+    QImage image = source;
+    if (image.format() != QImage::Format_Grayscale8 && image.depth() != 32) {
+        image = image.convertToFormat(QImage::Format_ARGB32);
+    }
+
+    const int width = image.width();
+    const int height = image.height();
+    int left = width;
+    int right = -1;
+    int top = -1;
+    int bottom = -1;
+
+    for (int y = 0; y < height; ++y) {
+        int rowFirst = -1;
+        int rowLast = -1;
+
+        if (image.format() == QImage::Format_Grayscale8) {
+            const uchar* line = image.constScanLine(y);
+            for (int x = 0; x < width; ++x) {
+                if (line[x] < luminanceThreshold) {
+                    if (rowFirst < 0) {
+                        rowFirst = x;
+                    }
+                    rowLast = x;
+                }
+            }
+        } else {
+            const QRgb* line =
+                reinterpret_cast<const QRgb*>(image.constScanLine(y));
+            for (int x = 0; x < width; ++x) {
+                // Integer Rec.601 luminance: (77R + 151G + 28B) / 256
+                const QRgb px = line[x];
+                const int lum = (77 * qRed(px) + 151 * qGreen(px) +
+                                 28 * qBlue(px)) >> 8;
+                if (lum < luminanceThreshold) {
+                    if (rowFirst < 0) {
+                        rowFirst = x;
+                    }
+                    rowLast = x;
+                }
+            }
+        }
+
+        if (rowFirst >= 0) {
+            if (top < 0) {
+                top = y;
+            }
+            bottom = y;
+            left = qMin(left, rowFirst);
+            right = qMax(right, rowLast);
+        }
+    }
+
+    if (bottom < 0) {
+        return QRect();
+    }
+    return QRect(QPoint(left, top), QPoint(right, bottom));
+}
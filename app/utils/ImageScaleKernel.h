@@ -0,0 +1,38 @@
+#pragma once
+
+#include <QImage>
+#include <QRect>
+#include <QSize>
+
+/**
+ * Vectorized downscale kernel for thumbnail generation.
+ *
+ * Shrinking a full-page render to thumbnail size with Qt's smooth
+ * transform is single-threaded scalar code and dominates thumbnail
+ * cost for scanned pages. This kernel does the bulk of the reduction
+ * with repeated 2x2 box halvings — each level reads every source
+ * pixel exactly once — and hands only the final sub-2x step to a
+ * smooth resample. The halving inner loop dispatches at runtime to
+ * AVX2 or SSE2 on x86 (a scalar loop the compiler can auto-vectorize
+ * elsewhere), and very tall sources are split into row bands across
+ * the global thread pool.
+ */
+class ImageScaleKernel {
+public:
+    // Area-averaged downscale to the size the source would take under
+    // Qt::KeepAspectRatio. Upscales and empty inputs fall back to
+    // QImage::scaled
+    static QImage downscale(const QImage& source, const QSize& targetSize);
+
+    // One 2x2 box-filter halving step; an odd trailing row or column
+    // is dropped. Non-32-bit sources are converted first
+    static QImage halve(const QImage& source);
+
+    // Ink bounding box: the smallest rect containing every pixel whose
+    // luminance falls below the threshold. Meant to run on a
+    // downsampled render — the per-row loops are branch-light and
+    // auto-vectorize — so whole-page whitespace detection costs
+    // microseconds. Returns a null rect for blank (all-white) input
+    static QRect contentBox(const QImage& source,
+                            int luminanceThreshold = 245);
+};
@@ -0,0 +1,174 @@
+#include "LatencyMetrics.h"
+#include <QAbstractEventDispatcher>
+#include <QMutexLocker>
+#include <QThread>
+#include <QTimer>
+#include "LoggingMacros.h"
+
+namespace {
+
+// Last instrumented operation that finished on each thread; the GUI
+// watchdog reads its own thread's slot to annotate stall warnings
+thread_local const char* t_lastOperationName = nullptr;
+thread_local qint64 t_lastOperationUs = 0;
+
+}  // namespace
+
+// LatencyHistogram implementation
+
+LatencyHistogram::LatencyHistogram(const QString& name)
+    : m_name(name), m_count(0), m_maxUs(0) {
+    for (auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+int LatencyHistogram::bucketFor(qint64 us) {
+    if (us <= 1) {
+        return 0;
+    }
+    int bucket = 0;
+    while (us > 1 && bucket < BUCKET_COUNT - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+void LatencyHistogram::record(qint64 durationUs) {
+    m_buckets[bucketFor(durationUs)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+
+    // Racy max is fine for diagnostics; a lost update costs one sample
+    qint64 seen = m_maxUs.load(std::memory_order_relaxed);
+    while (durationUs > seen &&
+           !m_maxUs.compare_exchange_weak(seen, durationUs,
+                                          std::memory_order_relaxed)) {
+    }
+}
+
+qint64 LatencyHistogram::percentileUs(double percentile) const {
+    const quint64 total = count();
+    if (total == 0) {
+        return 0;
+    }
+
+    const quint64 target = static_cast<quint64>(
+        percentile / 100.0 * static_cast<double>(total));
+    quint64 cumulative = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        cumulative += m_buckets[i].load(std::memory_order_relaxed);
+        if (cumulative > target) {
+            return qint64(1) << i;  // Bucket upper bound
+        }
+    }
+    return qint64(1) << (BUCKET_COUNT - 1);
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_maxUs.store(0, std::memory_order_relaxed);
+}
+
+// LatencyMetrics implementation
+
+LatencyMetrics::LatencyMetrics(QObject* parent) : QObject(parent) {}
+
+LatencyMetrics& LatencyMetrics::instance() {
+    static LatencyMetrics metrics;
+    return metrics;
+}
+
+LatencyHistogram* LatencyMetrics::histogram(const QString& name) {
+    QMutexLocker locker(&m_mutex);
+    auto it = m_histograms.find(name);
+    if (it != m_histograms.end()) {
+        return it.value();
+    }
+    // Histograms live for the process lifetime so hot paths can keep
+    // raw pointers without ownership concerns
+    auto* created = new LatencyHistogram(name);
+    m_histograms.insert(name, created);
+    return created;
+}
+
+void LatencyMetrics::startReporting(int intervalMs) {
+    if (m_reportTimer) {
+        m_reportTimer->setInterval(intervalMs);
+        return;
+    }
+    m_reportTimer = new QTimer(this);
+    m_reportTimer->setInterval(intervalMs);
+    connect(m_reportTimer, &QTimer::timeout, this,
+            &LatencyMetrics::logSummaries);
+    m_reportTimer->start();
+}
+
+void LatencyMetrics::logSummaries() {
+    QList<LatencyHistogram*> histograms;
+    {
+        QMutexLocker locker(&m_mutex);
+        histograms = m_histograms.values();
+    }
+
+    for (LatencyHistogram* histogram : histograms) {
+        const quint64 samples = histogram->count();
+        if (samples == 0) {
+            continue;
+        }
+        LOG_INFO(
+            "latency[{}]: n={} p50={}us p90={}us p99={}us max={}us",
+            histogram->name().toStdString(), samples,
+            histogram->percentileUs(50.0), histogram->percentileUs(90.0),
+            histogram->percentileUs(99.0), histogram->maxUs());
+    }
+}
+
+void LatencyMetrics::installGuiWatchdog(int frameBudgetMs) {
+    QAbstractEventDispatcher* dispatcher =
+        QAbstractEventDispatcher::instance();
+    if (!dispatcher || m_frameBudgetMs > 0) {
+        return;
+    }
+    m_frameBudgetMs = frameBudgetMs;
+
+    // One dispatch pass runs from awake to aboutToBlock; if it blows
+    // the frame budget, name the last instrumented operation that
+    // completed during the pass - usually the culprit or its caller
+    connect(dispatcher, &QAbstractEventDispatcher::awake, this, [this]() {
+        m_dispatchTimer.start();
+        t_lastOperationName = nullptr;
+    });
+    connect(dispatcher, &QAbstractEventDispatcher::aboutToBlock, this,
+            [this]() {
+                if (!m_dispatchTimer.isValid()) {
+                    return;
+                }
+                const qint64 elapsedMs = m_dispatchTimer.elapsed();
+                m_dispatchTimer.invalidate();
+                if (elapsedMs <= m_frameBudgetMs) {
+                    return;
+                }
+                if (t_lastOperationName) {
+                    LOG_WARNING(
+                        "GUI thread busy {}ms (budget {}ms); last "
+                        "instrumented op: {} ({}us)",
+                        elapsedMs, m_frameBudgetMs, t_lastOperationName,
+                        t_lastOperationUs);
+                } else {
+                    LOG_WARNING(
+                        "GUI thread busy {}ms (budget {}ms); no "
+                        "instrumented op in this pass",
+                        elapsedMs, m_frameBudgetMs);
+                }
+            });
+}
+
+void LatencyMetrics::noteCompletedOperation(const char* name,
+                                            qint64 durationUs) {
+    t_lastOperationName = name;
+    t_lastOperationUs = durationUs;
+}
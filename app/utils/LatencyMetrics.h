@@ -0,0 +1,126 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <atomic>
+
+class QTimer;
+
+/**
+ * Aggregated latency metrics for the logging stack.
+ *
+ * The spdlog output says what happened but not how long things took in
+ * aggregate. LatencyMetrics keeps named histograms (render latency,
+ * cache lookups, search shard time, ...) that hot paths update with a
+ * pair of relaxed atomic increments - no locks, no allocation - and
+ * periodically writes p50/p90/p99/max summaries to the log so latency
+ * regressions show up in the field without attaching a profiler.
+ *
+ * A GUI-thread watchdog rides the event dispatcher's awake/aboutToBlock
+ * cycle: whenever one dispatch pass exceeds the frame budget it logs a
+ * warning annotated with the last instrumented operation that completed
+ * on the GUI thread during that pass.
+ */
+class LatencyHistogram {
+public:
+    explicit LatencyHistogram(const QString& name);
+
+    // Wait-free; safe from any thread
+    void record(qint64 durationUs);
+
+    const QString& name() const { return m_name; }
+    quint64 count() const {
+        return m_count.load(std::memory_order_relaxed);
+    }
+    qint64 maxUs() const { return m_maxUs.load(std::memory_order_relaxed); }
+
+    // Upper bound of the bucket holding the requested percentile;
+    // buckets are powers of two, so the answer is within 2x
+    qint64 percentileUs(double percentile) const;
+
+    void reset();
+
+private:
+    // log2 buckets from 1us up to ~2200s
+    static constexpr int BUCKET_COUNT = 32;
+    static int bucketFor(qint64 us);
+
+    QString m_name;
+    std::atomic<quint64> m_buckets[BUCKET_COUNT];
+    std::atomic<quint64> m_count;
+    std::atomic<qint64> m_maxUs;
+};
+
+class LatencyMetrics : public QObject {
+    Q_OBJECT
+
+public:
+    static LatencyMetrics& instance();
+
+    // Returns the histogram registered under this name, creating it on
+    // first use. Registration takes a mutex - cache the pointer at hot
+    // call sites (the LATENCY_SAMPLE macro does this with a static)
+    LatencyHistogram* histogram(const QString& name);
+
+    // Periodic percentile summaries to the log; call once from the GUI
+    // thread after logging is initialized
+    void startReporting(int intervalMs = 60000);
+    void logSummaries();
+
+    // GUI-thread frame watchdog; call from the GUI thread. Budget of
+    // two 60Hz frames by default so routine work stays quiet
+    void installGuiWatchdog(int frameBudgetMs = 32);
+
+    // Updated by LatencySample on scope exit; the watchdog reads it to
+    // annotate stall warnings on the GUI thread
+    static void noteCompletedOperation(const char* name, qint64 durationUs);
+
+private:
+    explicit LatencyMetrics(QObject* parent = nullptr);
+
+    QHash<QString, LatencyHistogram*> m_histograms;
+    mutable QMutex m_mutex;
+    QTimer* m_reportTimer = nullptr;
+
+    // Watchdog state (GUI thread only)
+    QElapsedTimer m_dispatchTimer;
+    int m_frameBudgetMs = 0;
+};
+
+/**
+ * RAII latency sample; prefer the LATENCY_SAMPLE macro so the histogram
+ * pointer is resolved once per call site
+ */
+class LatencySample {
+public:
+    LatencySample(LatencyHistogram* histogram, const char* name)
+        : m_histogram(histogram), m_name(name) {
+        m_timer.start();
+    }
+
+    ~LatencySample() {
+        const qint64 us = m_timer.nsecsElapsed() / 1000;
+        m_histogram->record(us);
+        LatencyMetrics::noteCompletedOperation(m_name, us);
+    }
+
+    LatencySample(const LatencySample&) = delete;
+    LatencySample& operator=(const LatencySample&) = delete;
+
+private:
+    LatencyHistogram* m_histogram;
+    const char* m_name;
+    QElapsedTimer m_timer;
+};
+
+#define LATENCY_SAMPLE_CONCAT_IMPL(a, b) a##b
+#define LATENCY_SAMPLE_CONCAT(a, b) LATENCY_SAMPLE_CONCAT_IMPL(a, b)
+#define LATENCY_SAMPLE(name)                                             \
+    static LatencyHistogram* LATENCY_SAMPLE_CONCAT(latencyHist_,         \
+                                                   __LINE__) =           \
+        LatencyMetrics::instance().histogram(QStringLiteral(name));      \
+    LatencySample LATENCY_SAMPLE_CONCAT(latencySample_, __LINE__)(       \
+        LATENCY_SAMPLE_CONCAT(latencyHist_, __LINE__), name)
@@ -218,6 +218,33 @@ public:
         }
     }
 
+    // Fast-path helpers (see LOG_FAST_* in LoggingMacros.h)
+
+    // Level pre-check so hot call sites can skip argument evaluation
+    // and formatting entirely when a level is filtered out
+    bool shouldLog(LogLevel level) const {
+        return m_logger &&
+               m_logger->should_log(
+                   static_cast<spdlog::level::level_enum>(level));
+    }
+
+    // Formats via fmt into a stack buffer and hands spdlog a
+    // string_view: no QString construction, no UTF-16 round trip, and
+    // no heap allocation for typical message lengths. The format
+    // string is checked at compile time.
+    template <typename... Args>
+    void logFast(LogLevel level, fmt::format_string<Args...> format,
+                 Args&&... args) {
+        if (!shouldLog(level)) {
+            return;
+        }
+        fmt::memory_buffer buffer;
+        fmt::format_to(fmt::appender(buffer), format,
+                       std::forward<Args>(args)...);
+        m_logger->log(static_cast<spdlog::level::level_enum>(level),
+                      spdlog::string_view_t(buffer.data(), buffer.size()));
+    }
+
     // Simple string logging (Qt-style compatibility)
     void trace(const QString& message);
     void debug(const QString& message);
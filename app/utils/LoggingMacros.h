@@ -3,6 +3,8 @@
 #include <spdlog/fmt/fmt.h>
 #include <QDebug>
 #include <QString>
+#include <atomic>
+#include <chrono>
 #include "Logger.h"
 #include "LoggingManager.h"
 
@@ -47,6 +49,62 @@
 #define LOG_ERROR(...) Logger::instance().error(__VA_ARGS__)
 #define LOG_CRITICAL(...) Logger::instance().critical(__VA_ARGS__)
 
+// ============================================================================
+// Zero-Allocation Fast-Path Macros (for per-frame / hot-path sites)
+// ============================================================================
+// LOG_* above routes QString format strings through toStdString(), so
+// even a filtered-out debug log pays allocation and UTF-16 conversion.
+// LOG_FAST_* checks the sink level before evaluating any argument and
+// formats via fmt into a stack buffer: with the level disabled a call
+// costs one branch. Format strings must be plain literals (checked at
+// compile time); convert QString arguments with .toStdString().
+
+#define LOG_FAST(levelEnum, ...)                                         \
+    do {                                                                 \
+        if (Logger::instance().shouldLog(Logger::LogLevel::levelEnum)) { \
+            Logger::instance().logFast(Logger::LogLevel::levelEnum,      \
+                                       __VA_ARGS__);                     \
+        }                                                                \
+    } while (0)
+
+#define LOG_FAST_TRACE(...) LOG_FAST(Trace, __VA_ARGS__)
+#define LOG_FAST_DEBUG(...) LOG_FAST(Debug, __VA_ARGS__)
+#define LOG_FAST_INFO(...) LOG_FAST(Info, __VA_ARGS__)
+#define LOG_FAST_WARNING(...) LOG_FAST(Warning, __VA_ARGS__)
+#define LOG_FAST_ERROR(...) LOG_FAST(Error, __VA_ARGS__)
+
+// Rate-limited variant for sites that fire every frame (paintEvent,
+// cache lookups): at most one message per intervalMs per call site.
+// The per-site timestamp is a relaxed atomic; under a race a duplicate
+// message loses the CAS and is dropped, never logged twice.
+#define LOG_EVERY_MS(levelEnum, intervalMs, ...)                              \
+    do {                                                                      \
+        if (Logger::instance().shouldLog(Logger::LogLevel::levelEnum)) {      \
+            static std::atomic<long long> _log_last_ms{-(intervalMs)-1};      \
+            long long _log_now_ms =                                          \
+                std::chrono::duration_cast<std::chrono::milliseconds>(        \
+                    std::chrono::steady_clock::now().time_since_epoch())      \
+                    .count();                                                 \
+            long long _log_prev_ms =                                          \
+                _log_last_ms.load(std::memory_order_relaxed);                 \
+            if (_log_now_ms - _log_prev_ms >= (intervalMs) &&                 \
+                _log_last_ms.compare_exchange_strong(                         \
+                    _log_prev_ms, _log_now_ms, std::memory_order_relaxed)) {  \
+                Logger::instance().logFast(Logger::LogLevel::levelEnum,       \
+                                           __VA_ARGS__);                      \
+            }                                                                 \
+        }                                                                     \
+    } while (0)
+
+#define LOG_TRACE_EVERY_MS(intervalMs, ...) \
+    LOG_EVERY_MS(Trace, intervalMs, __VA_ARGS__)
+#define LOG_DEBUG_EVERY_MS(intervalMs, ...) \
+    LOG_EVERY_MS(Debug, intervalMs, __VA_ARGS__)
+#define LOG_INFO_EVERY_MS(intervalMs, ...) \
+    LOG_EVERY_MS(Info, intervalMs, __VA_ARGS__)
+#define LOG_WARNING_EVERY_MS(intervalMs, ...) \
+    LOG_EVERY_MS(Warning, intervalMs, __VA_ARGS__)
+
 // ============================================================================
 // Qt-Style Streaming Macros (for gradual migration)
 // ============================================================================
@@ -0,0 +1,184 @@
+#include "MappedImagePool.h"
+
+#include <QDir>
+#include <QMutexLocker>
+#include <QPainter>
+#include <QTemporaryFile>
+#include "LoggingMacros.h"
+
+namespace {
+
+// Row stride for an external pixel buffer: QImage requires 4-byte
+// alignment per scanline
+qsizetype strideFor(int width, QImage::Format format) {
+    int bytesPerPixel;
+    switch (format) {
+        case QImage::Format_RGB32:
+        case QImage::Format_ARGB32:
+        case QImage::Format_ARGB32_Premultiplied:
+            bytesPerPixel = 4;
+            break;
+        case QImage::Format_Grayscale8:
+            bytesPerPixel = 1;
+            break;
+        default:
+            // Formats the render paths never produce; acquire() falls
+            // back to a plain QImage for them
+            return 0;
+    }
+    return (static_cast<qsizetype>(width) * bytesPerPixel + 3) &
+           ~static_cast<qsizetype>(3);
+}
+
+}  // namespace
+
+MappedImagePool& MappedImagePool::instance() {
+    // Deliberately leaked: lent-out slabs can outlive every other
+    // static (images parked in caches that are themselves singletons),
+    // and their cleanup hooks must find the pool alive. The mapped
+    // files are removed right after mapping where the OS allows it, so
+    // leaking the object leaks no disk space
+    static MappedImagePool* pool = new MappedImagePool();
+    return *pool;
+}
+
+QImage MappedImagePool::acquire(const QSize& size, QImage::Format format) {
+    if (size.isEmpty()) {
+        return QImage();
+    }
+    const qsizetype stride = strideFor(size.width(), format);
+    const qint64 bytes = stride * size.height();
+    if (stride == 0 || bytes < LARGE_IMAGE_BYTES) {
+        return QImage(size, format);
+    }
+
+    Slab slab;
+    {
+        QMutexLocker locker(&m_mutex);
+        // Smallest free slab that fits, so one oversized mapping is not
+        // burned on a barely-large render
+        int best = -1;
+        for (int i = 0; i < m_free.size(); ++i) {
+            if (m_free[i].bytes >= bytes &&
+                (best < 0 || m_free[i].bytes < m_free[best].bytes)) {
+                best = i;
+            }
+        }
+        if (best >= 0) {
+            slab = m_free.takeAt(best);
+        }
+    }
+    if (!slab.data) {
+        const qint64 rounded =
+            (bytes + SLAB_GRANULARITY - 1) / SLAB_GRANULARITY *
+            SLAB_GRANULARITY;
+        slab = createSlab(rounded);
+        if (!slab.data) {
+            return QImage();
+        }
+    }
+
+    // The lease outlives this call; the cleanup hook deletes it when
+    // the last QImage sharing the buffer is destroyed
+    auto* lease = new Slab(slab);
+    QImage image(slab.data, size.width(), size.height(), stride, format,
+                 &MappedImagePool::releaseSlab, lease);
+    if (image.isNull()) {
+        // Construction failed before the buffer was adopted, so the
+        // hook will never fire; return the slab by hand
+        releaseSlab(lease);
+        return QImage();
+    }
+    return image;
+}
+
+QImage MappedImagePool::upscaled(const QImage& source,
+                                 const QSize& targetSize) {
+    if (source.isNull() || targetSize.isEmpty()) {
+        return source;
+    }
+
+    // QPainter needs a paintable destination layout; straight alpha is
+    // not one, so transparent sources go through the premultiplied form
+    const QImage::Format dstFormat =
+        source.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied
+                                 : QImage::Format_RGB32;
+    const qsizetype stride = strideFor(targetSize.width(), dstFormat);
+    if (stride * targetSize.height() < LARGE_IMAGE_BYTES) {
+        return source.scaled(targetSize, Qt::IgnoreAspectRatio,
+                             Qt::SmoothTransformation);
+    }
+
+    QImage dst = acquire(targetSize, dstFormat);
+    if (dst.isNull()) {
+        return source.scaled(targetSize, Qt::IgnoreAspectRatio,
+                             Qt::SmoothTransformation);
+    }
+    dst.setDevicePixelRatio(source.devicePixelRatio());
+
+    // Source mode overwrites the mapping's uninitialized bytes instead
+    // of compositing over them; the bilinear filter matches what the
+    // smooth transform would produce for an upscale
+    QPainter painter(&dst);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+    painter.drawImage(QRect(QPoint(0, 0), targetSize), source);
+    painter.end();
+    return dst;
+}
+
+void MappedImagePool::releaseSlab(void* info) {
+    auto* lease = static_cast<Slab*>(info);
+    MappedImagePool& pool = instance();
+    {
+        QMutexLocker locker(&pool.m_mutex);
+        if (pool.m_free.size() < MAX_POOLED_SLABS) {
+            pool.m_free.append(*lease);
+            delete lease;
+            return;
+        }
+    }
+    destroySlab(*lease);
+    delete lease;
+}
+
+MappedImagePool::Slab MappedImagePool::createSlab(qint64 bytes) {
+    Slab slab;
+    auto* file =
+        new QTemporaryFile(QDir::tempPath() + "/readium_render_XXXXXX");
+    if (!file->open() || !file->resize(bytes)) {
+        LOG_WARNING("MappedImagePool: could not create a {} byte scratch "
+                    "file in {}",
+                    bytes, QDir::tempPath().toStdString());
+        delete file;
+        return slab;
+    }
+    uchar* data = file->map(0, bytes);
+    if (!data) {
+        LOG_WARNING("MappedImagePool: mapping {} bytes failed", bytes);
+        delete file;
+        return slab;
+    }
+#ifdef Q_OS_UNIX
+    // The mapping keeps the inode alive without its directory entry, so
+    // the scratch file can vanish from /tmp immediately — nothing is
+    // left behind even if the process dies without cleanup. Windows
+    // refuses to unlink a mapped file; there QTemporaryFile removes it
+    // in destroySlab instead
+    file->remove();
+#endif
+    slab.file = file;
+    slab.data = data;
+    slab.bytes = bytes;
+    LOG_DEBUG("MappedImagePool: mapped a {} MB scratch slab",
+              bytes / (1024 * 1024));
+    return slab;
+}
+
+void MappedImagePool::destroySlab(const Slab& slab) {
+    if (!slab.file) {
+        return;
+    }
+    slab.file->unmap(slab.data);
+    delete slab.file;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QImage>
+#include <QMutex>
+#include <QSize>
+#include <QVector>
+
+class QTemporaryFile;
+
+/**
+ * File-backed scratch buffers for very large render targets.
+ *
+ * Upscaling an image-dominant page to print resolution materializes a
+ * QImage of several hundred megabytes. Taking that from the heap
+ * fragments it badly, can fail outright in address-constrained plugin
+ * hosts, and the pages stay charged to the process until the image
+ * dies even when each was touched exactly once. Buffers at or above
+ * LARGE_IMAGE_BYTES therefore draw into mappings of temporary files
+ * instead: the allocation bypasses the heap entirely, the OS may write
+ * the pages out and reclaim them under memory pressure, and the slab
+ * is recycled for the next giant render instead of being faulted in
+ * from scratch.
+ *
+ * acquire() hands out a QImage built over the mapping with the
+ * external-buffer constructor; a cleanup hook returns the slab to the
+ * pool when the last copy of the image is destroyed. Poppler allocates
+ * its render buffers internally and offers no way to supply one, so
+ * the pool applies where this codebase materializes large images
+ * itself — the DPI-cap upscale of image-dominant pages being the one
+ * that reaches print-DPI sizes (see upscaled()).
+ */
+class MappedImagePool {
+public:
+    static MappedImagePool& instance();
+
+    // Image of the given size and format: backed by a pooled mapping
+    // when the pixel buffer reaches LARGE_IMAGE_BYTES, a plain
+    // heap-backed QImage below that. Null when the mapping could not be
+    // created — callers fall back to their ordinary allocation.
+    QImage acquire(const QSize& size, QImage::Format format);
+
+    // source scaled smoothly to targetSize, drawn into a pooled buffer
+    // when the destination is large. Drop-in for
+    // scaled(targetSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation)
+    // on the giant-render paths; small targets take exactly that route.
+    QImage upscaled(const QImage& source, const QSize& targetSize);
+
+    // Below this the heap serves fine: a 2x-device-pixel A4 render is
+    // ~35MB, a 600-DPI map sheet an order of magnitude more
+    static constexpr qint64 LARGE_IMAGE_BYTES = 64LL * 1024 * 1024;
+
+private:
+    MappedImagePool() = default;
+    ~MappedImagePool() = default;
+
+    struct Slab {
+        QTemporaryFile* file = nullptr;
+        uchar* data = nullptr;
+        qint64 bytes = 0;
+    };
+
+    static void releaseSlab(void* info);
+    Slab createSlab(qint64 bytes);
+    static void destroySlab(const Slab& slab);
+
+    // Slabs are sized in this granularity so renders of slightly
+    // different page dimensions still reuse each other's mappings
+    static constexpr qint64 SLAB_GRANULARITY = 32LL * 1024 * 1024;
+
+    // Idle slabs kept around; beyond this they are unmapped so the pool
+    // never sits on more than a few spreads' worth of scratch files
+    static constexpr int MAX_POOLED_SLABS = 3;
+
+    QMutex m_mutex;
+    QVector<Slab> m_free;
+};
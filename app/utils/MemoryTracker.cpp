@@ -0,0 +1,77 @@
+#include "MemoryTracker.h"
+#include <QMutexLocker>
+#include <algorithm>
+
+MemoryTracker& MemoryTracker::instance() {
+    static MemoryTracker tracker;
+    return tracker;
+}
+
+void MemoryTracker::add(const QString& subsystem, qint64 bytes) {
+    if (bytes == 0) {
+        return;
+    }
+    QMutexLocker locker(&m_mutex);
+    Entry& entry = m_entries[subsystem];
+    entry.current += bytes;
+    if (entry.current > entry.peak) {
+        entry.peak = entry.current;
+    }
+}
+
+void MemoryTracker::release(const QString& subsystem, qint64 bytes) {
+    if (bytes == 0) {
+        return;
+    }
+    QMutexLocker locker(&m_mutex);
+    Entry& entry = m_entries[subsystem];
+    // Clamp rather than trust callers perfectly: a missed add() must
+    // not drag the figure negative and poison the panel
+    entry.current = qMax(qint64(0), entry.current - bytes);
+}
+
+void MemoryTracker::set(const QString& subsystem, qint64 bytes) {
+    QMutexLocker locker(&m_mutex);
+    Entry& entry = m_entries[subsystem];
+    entry.current = qMax(qint64(0), bytes);
+    if (entry.current > entry.peak) {
+        entry.peak = entry.current;
+    }
+}
+
+QList<MemoryTracker::Attribution> MemoryTracker::snapshot() const {
+    QList<Attribution> result;
+    {
+        QMutexLocker locker(&m_mutex);
+        result.reserve(m_entries.size());
+        for (auto it = m_entries.constBegin(); it != m_entries.constEnd();
+             ++it) {
+            Attribution attribution;
+            attribution.subsystem = it.key();
+            attribution.currentBytes = it.value().current;
+            attribution.peakBytes = it.value().peak;
+            result.append(attribution);
+        }
+    }
+    std::sort(result.begin(), result.end(),
+              [](const Attribution& a, const Attribution& b) {
+                  return a.currentBytes > b.currentBytes;
+              });
+    return result;
+}
+
+qint64 MemoryTracker::trackedTotal() const {
+    QMutexLocker locker(&m_mutex);
+    qint64 total = 0;
+    for (const Entry& entry : m_entries) {
+        total += entry.current;
+    }
+    return total;
+}
+
+void MemoryTracker::resetPeaks() {
+    QMutexLocker locker(&m_mutex);
+    for (Entry& entry : m_entries) {
+        entry.peak = entry.current;
+    }
+}
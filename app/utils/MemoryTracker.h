@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+
+/**
+ * Per-subsystem memory attribution registry.
+ *
+ * CacheStatistics covers the render cache, but when RSS climbs towards
+ * 2GB nothing says whether thumbnails, prerendered pages, page widget
+ * buffers or text indexes are to blame. Buffer-owning subsystems report
+ * sized allocations here — either as add()/release() deltas around a
+ * buffer's lifetime, or as a set() absolute when they already maintain
+ * their own total — and the tracker keeps a current figure plus a
+ * high-water mark per subsystem. DebugLogPanel renders the breakdown
+ * live; whatever RSS exceeds the tracked total is Poppler/Qt internals
+ * and heap overhead, which narrows an OOM hunt by elimination.
+ *
+ * Updates are one mutex-guarded hash bump: cheap enough for
+ * buffer-sized events (pixmaps, page text, staged files), not meant
+ * for per-object new/delete granularity.
+ */
+class MemoryTracker {
+public:
+    static MemoryTracker& instance();
+
+    // Delta reporting around a buffer's lifetime. Safe from any thread.
+    void add(const QString& subsystem, qint64 bytes);
+    void release(const QString& subsystem, qint64 bytes);
+
+    // Absolute reporting for subsystems that already account for
+    // themselves (the MemoryGovernor consumers)
+    void set(const QString& subsystem, qint64 bytes);
+
+    struct Attribution {
+        QString subsystem;
+        qint64 currentBytes = 0;
+        qint64 peakBytes = 0;
+    };
+
+    // Current breakdown, sorted by current usage descending
+    QList<Attribution> snapshot() const;
+
+    // Sum of all current figures; RSS minus this is unattributed
+    qint64 trackedTotal() const;
+
+    // Restart the high-water marks from current usage
+    void resetPeaks();
+
+private:
+    MemoryTracker() = default;
+
+    struct Entry {
+        qint64 current = 0;
+        qint64 peak = 0;
+    };
+
+    QHash<QString, Entry> m_entries;
+    mutable QMutex m_mutex;
+};
@@ -0,0 +1,185 @@
+#include "PDFMetadataProbe.h"
+#include <poppler/qt6/poppler-qt6.h>
+#include <QDir>
+#include <QFile>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <memory>
+#include "../cache/DiskRenderCache.h"
+#include "LoggingMacros.h"
+
+namespace {
+
+QMutex g_cacheMutex;
+
+// Keyed by file hash, so a modified file misses naturally
+QHash<QString, PDFMetadata>& memoryCache() {
+    static QHash<QString, PDFMetadata> cache;
+    return cache;
+}
+
+QString cacheDir() {
+    static const QString dir =
+        QStandardPaths::writableLocation(QStandardPaths::CacheLocation) +
+        "/metadata-cache";
+    return dir;
+}
+
+QJsonObject toJson(const PDFMetadata& metadata) {
+    QJsonObject obj;
+    obj["title"] = metadata.title;
+    obj["author"] = metadata.author;
+    obj["subject"] = metadata.subject;
+    obj["keywords"] = metadata.keywords;
+    obj["creator"] = metadata.creator;
+    obj["producer"] = metadata.producer;
+    obj["creationDate"] = metadata.creationDate;
+    obj["modificationDate"] = metadata.modificationDate;
+    obj["pageCount"] = metadata.pageCount;
+    obj["encrypted"] = metadata.encrypted;
+    return obj;
+}
+
+PDFMetadata fromJson(const QJsonObject& obj) {
+    PDFMetadata metadata;
+    metadata.title = obj["title"].toString();
+    metadata.author = obj["author"].toString();
+    metadata.subject = obj["subject"].toString();
+    metadata.keywords = obj["keywords"].toString();
+    metadata.creator = obj["creator"].toString();
+    metadata.producer = obj["producer"].toString();
+    metadata.creationDate = obj["creationDate"].toString();
+    metadata.modificationDate = obj["modificationDate"].toString();
+    metadata.pageCount = obj["pageCount"].toInt(-1);
+    metadata.encrypted = obj["encrypted"].toBool();
+    metadata.valid = true;
+    return metadata;
+}
+
+}  // namespace
+
+PDFMetadata PDFMetadataProbe::probe(const QString& filePath) {
+    const QString fileHash = DiskRenderCache::hashForFile(filePath);
+    if (fileHash.isEmpty()) {
+        return PDFMetadata();
+    }
+
+    {
+        QMutexLocker locker(&g_cacheMutex);
+        auto it = memoryCache().constFind(fileHash);
+        if (it != memoryCache().constEnd()) {
+            return *it;
+        }
+    }
+
+    PDFMetadata metadata = loadFromDisk(fileHash);
+    if (!metadata.valid) {
+        metadata = readFromFile(filePath);
+        if (metadata.valid) {
+            storeToDisk(fileHash, metadata);
+        }
+    }
+
+    if (metadata.valid) {
+        QMutexLocker locker(&g_cacheMutex);
+        memoryCache().insert(fileHash, metadata);
+    }
+    return metadata;
+}
+
+PDFMetadata PDFMetadataProbe::cachedOnly(const QString& filePath) {
+    const QString fileHash = DiskRenderCache::hashForFile(filePath);
+    if (fileHash.isEmpty()) {
+        return PDFMetadata();
+    }
+
+    {
+        QMutexLocker locker(&g_cacheMutex);
+        auto it = memoryCache().constFind(fileHash);
+        if (it != memoryCache().constEnd()) {
+            return *it;
+        }
+    }
+
+    PDFMetadata metadata = loadFromDisk(fileHash);
+    if (metadata.valid) {
+        QMutexLocker locker(&g_cacheMutex);
+        memoryCache().insert(fileHash, metadata);
+    }
+    return metadata;
+}
+
+void PDFMetadataProbe::clearMemoryCache() {
+    QMutexLocker locker(&g_cacheMutex);
+    memoryCache().clear();
+}
+
+PDFMetadata PDFMetadataProbe::readFromFile(const QString& filePath) {
+    PDFMetadata metadata;
+
+    // A bare load parses header, xref and trailer only; Info keys and
+    // the /Pages /Count come straight from the catalog and no
+    // Poppler::Page ever materializes. This is the whole cost of a
+    // cold probe.
+    std::unique_ptr<Poppler::Document> document =
+        Poppler::Document::load(filePath);
+    if (!document) {
+        LOG_DEBUG("PDFMetadataProbe: cannot open {}", filePath.toStdString());
+        return metadata;
+    }
+
+    metadata.encrypted = document->isEncrypted();
+    if (document->isLocked()) {
+        // Page count and Info stay unknown, but a locked probe is
+        // still worth caching: the dialog can show the lock state
+        metadata.valid = true;
+        return metadata;
+    }
+
+    metadata.title = document->info("Title");
+    metadata.author = document->info("Author");
+    metadata.subject = document->info("Subject");
+    metadata.keywords = document->info("Keywords");
+    metadata.creator = document->info("Creator");
+    metadata.producer = document->info("Producer");
+    metadata.creationDate = document->info("CreationDate");
+    metadata.modificationDate = document->info("ModDate");
+    metadata.pageCount = document->numPages();
+    metadata.valid = true;
+    return metadata;
+}
+
+QString PDFMetadataProbe::cacheFilePath(const QString& fileHash) {
+    return cacheDir() + "/" + fileHash + ".json";
+}
+
+PDFMetadata PDFMetadataProbe::loadFromDisk(const QString& fileHash) {
+    QFile file(cacheFilePath(fileHash));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return PDFMetadata();
+    }
+
+    QJsonParseError parseError;
+    const QJsonDocument doc =
+        QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+        return PDFMetadata();
+    }
+    return fromJson(doc.object());
+}
+
+void PDFMetadataProbe::storeToDisk(const QString& fileHash,
+                                   const PDFMetadata& metadata) {
+    QDir().mkpath(cacheDir());
+    QSaveFile file(cacheFilePath(fileHash));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    file.write(QJsonDocument(toJson(metadata)).toJson(QJsonDocument::Compact));
+    file.commit();
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <QString>
+
+/**
+ * Document metadata read by the probe. pageCount is -1 when unknown;
+ * valid is false when the file could not be probed at all.
+ */
+struct PDFMetadata {
+    QString title;
+    QString author;
+    QString subject;
+    QString keywords;
+    QString creator;
+    QString producer;
+    QString creationDate;      // raw PDF date string, e.g. D:YYYYMMDD...
+    QString modificationDate;  // raw PDF date string
+    int pageCount = -1;
+    bool encrypted = false;
+    bool valid = false;
+};
+
+/**
+ * Lightweight metadata probe with a persistent per-file cache.
+ *
+ * The metadata dialog and the recent-files list only need
+ * title/author/page-count, yet the only way to get them used to be a
+ * full document open through the loader pipeline. The probe opens a
+ * short-lived Poppler handle, reads the Info dictionary and the page
+ * count from the catalog — no page ever materializes, no render hints,
+ * no loader round trip — and memoizes the result both in memory and as
+ * a small JSON file keyed by DiskRenderCache::hashForFile (path + size
+ * + mtime), so a touched file re-probes automatically. Repeat lookups
+ * for multi-GB documents on network shares never reopen the file.
+ *
+ * probe() may do file I/O and belongs on a worker thread for cold
+ * files; cachedOnly() never parses and is safe on the GUI thread.
+ * Both are thread-safe.
+ */
+class PDFMetadataProbe {
+public:
+    // Memory cache, then disk cache, then a minimal Poppler open.
+    static PDFMetadata probe(const QString& filePath);
+
+    // Memory/disk cache only; valid=false on a miss, no parsing.
+    static PDFMetadata cachedOnly(const QString& filePath);
+
+    static void clearMemoryCache();
+
+private:
+    PDFMetadataProbe() = delete;
+
+    static PDFMetadata readFromFile(const QString& filePath);
+    static QString cacheFilePath(const QString& fileHash);
+    static PDFMetadata loadFromDisk(const QString& fileHash);
+    static void storeToDisk(const QString& fileHash,
+                            const PDFMetadata& metadata);
+};
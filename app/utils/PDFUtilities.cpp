@@ -11,6 +11,7 @@
 #include <QPixmap>
 #include <QRandomGenerator>
 #include <QRegularExpression>
+#include <QSemaphore>
 #include <QSet>
 #include <QStringList>
 #include <QTextStream>
@@ -18,10 +19,19 @@
 #include <QtGlobal>
 #include <QtMath>
 #include <algorithm>
+#include <atomic>
 #include <exception>
 #include <memory>
 #include <vector>
+#include <QImageReader>
+#include <QMutex>
+#include <QMutexLocker>
+#include "../cache/DiskRenderCache.h"
+#include "../cache/PDFCacheManager.h"
+#include "../managers/PageExportEngine.h"
+#include "../managers/RenderScheduler.h"
 #include "../model/AnnotationModel.h"
+#include "../model/DocumentSnapshot.h"
 #include "Logger.h"
 
 QJsonObject PDFUtilities::analyzeDocument(Poppler::Document* document) {
@@ -46,8 +56,9 @@ QJsonObject PDFUtilities::analyzeDocument(Poppler::Document* document) {
     analysis["security"] = getDocumentSecurity(document);
     analysis["properties"] = getDocumentProperties(document);
 
-    // Content analysis
-    QStringList allText = extractAllText(document);
+    // Content analysis: statistics are order-insensitive, so skip
+    // layout analysis
+    QStringList allText = extractAllText(document, TextExtractionMode::Fast);
     QString fullText = allText.join(" ");
 
     analysis["textStatistics"] = generateTextStatistics(fullText);
@@ -55,7 +66,9 @@ QJsonObject PDFUtilities::analyzeDocument(Poppler::Document* document) {
     analysis["totalSentences"] = countSentences(fullText);
     analysis["totalParagraphs"] = countParagraphs(fullText);
     analysis["estimatedReadingTime"] = calculateReadingTime(fullText);
-    analysis["detectedLanguage"] = detectLanguage(fullText);
+    // Memoized sampled detection instead of scanning the full text;
+    // repeat analyses of the same document get the answer for free
+    analysis["detectedLanguage"] = detectDocumentLanguage(document);
 
     // Image analysis
     QList<QPixmap> allImages = extractAllImages(document);
@@ -86,7 +99,8 @@ QJsonObject PDFUtilities::analyzeDocument(Poppler::Document* document) {
     return analysis;
 }
 
-QStringList PDFUtilities::extractAllText(Poppler::Document* document) {
+QStringList PDFUtilities::extractAllText(Poppler::Document* document,
+                                         TextExtractionMode mode) {
     QStringList textList;
 
     if (!document) {
@@ -109,33 +123,105 @@ QStringList PDFUtilities::extractAllText(Poppler::Document* document) {
             pageCount);
     }
 
-    try {
-        for (int i = 0; i < pageCount; ++i) {
-            std::unique_ptr<Poppler::Page> page(document->page(i));
-            if (page) {
-                QString pageText = extractPageText(page.get());
-                textList.append(pageText);
-            } else {
+    // Each page slot is written by exactly one worker; the batch call
+    // blocks until all are done, so no locking is needed here
+    QVector<QString> texts(pageCount);
+    extractTextRange(
+        document, 0, pageCount - 1,
+        [&texts](int pageNumber, const QString& text) {
+            texts[pageNumber] = text;
+        },
+        nullptr, mode);
+
+    textList.reserve(pageCount);
+    for (const QString& text : std::as_const(texts)) {
+        textList.append(text);
+    }
+    return textList;
+}
+
+void PDFUtilities::extractTextRange(
+    Poppler::Document* document, int firstPage, int lastPage,
+    const std::function<void(int pageNumber, const QString& text)>& onPageText,
+    const std::function<void(int pagesDone, int pagesTotal)>& onProgress,
+    TextExtractionMode mode) {
+    if (!document || !onPageText) {
+        Logger::instance().warning(
+            "[utils] PDFUtilities::extractTextRange: Invalid document or "
+            "callback");
+        return;
+    }
+
+    const int pageCount = document->numPages();
+    firstPage = qMax(0, firstPage);
+    lastPage = qMin(pageCount - 1, lastPage);
+    if (firstPage > lastPage) {
+        return;
+    }
+    const int total = lastPage - firstPage + 1;
+
+    // One shard per pool thread, pages assigned round-robin so dense
+    // and empty pages spread evenly. Small batches are not worth the
+    // scheduling overhead
+    int shards = qBound(1, RenderScheduler::instance().maxThreadCount(), total);
+    if (total < 4) {
+        shards = 1;
+    }
+
+    // Shards on registered documents pull pages from a thread-private
+    // snapshot handle instead of contending on the shared one
+    const std::shared_ptr<DocumentSnapshot> snapshot =
+        DocumentSnapshot::forDocument(document);
+
+    std::atomic<int> completed{0};
+    auto runShard = [&](int shard) {
+        Poppler::Document* localDoc = document;
+        if (snapshot) {
+            if (Poppler::Document* handle = snapshot->threadHandle()) {
+                localDoc = handle;
+            }
+        }
+        for (int pageNumber = firstPage + shard; pageNumber <= lastPage;
+             pageNumber += shards) {
+            QString text;
+            try {
+                std::unique_ptr<Poppler::Page> page(localDoc->page(pageNumber));
+                if (page) {
+                    text = extractPageText(page.get(), mode);
+                } else {
+                    Logger::instance().warning(
+                        "[utils] PDFUtilities::extractTextRange: Failed to "
+                        "load page {}",
+                        pageNumber);
+                }
+            } catch (const std::exception& e) {
                 Logger::instance().warning(
-                    "[utils] PDFUtilities::extractAllText: Failed to load page "
-                    "{}",
-                    i);
-                textList.append(
-                    QString());  // Add empty string to maintain page indexing
+                    "[utils] PDFUtilities::extractTextRange: Exception on "
+                    "page {}: {}",
+                    pageNumber, e.what());
+            }
+            onPageText(pageNumber, text);
+            const int done = ++completed;
+            if (onProgress) {
+                onProgress(done, total);
             }
         }
-    } catch (const std::exception& e) {
-        Logger::instance().warning(
-            "[utils] PDFUtilities::extractAllText: Exception occurred: {}",
-            e.what());
-        return QStringList();  // Return empty list on error
-    } catch (...) {
-        Logger::instance().warning(
-            "[utils] PDFUtilities::extractAllText: Unknown exception occurred");
-        return QStringList();
-    }
-
-    return textList;
+    };
+
+    // Shard 0 runs on the calling thread: if the pool is saturated (or
+    // this is called from a pool thread) the batch still makes progress
+    // instead of deadlocking on its own jobs
+    QSemaphore finished;
+    for (int shard = 1; shard < shards; ++shard) {
+        RenderScheduler::instance().submit(
+            RenderScheduler::TaskClass::Background, [&runShard, &finished,
+                                                     shard]() {
+                runShard(shard);
+                finished.release();
+            });
+    }
+    runShard(0);
+    finished.acquire(shards - 1);
 }
 
 QList<QPixmap> PDFUtilities::extractAllImages(Poppler::Document* document) {
@@ -187,8 +273,8 @@ QJsonObject PDFUtilities::analyzePage(Poppler::Page* page, int pageNumber) {
                                    {"height", getPageSize(page).height()}};
     pageInfo["rotation"] = getPageRotation(page);
 
-    // Text analysis
-    QString pageText = extractPageText(page);
+    // Text analysis: counts don't care about reading order
+    QString pageText = extractPageText(page, TextExtractionMode::Fast);
     pageInfo["textLength"] = pageText.length();
     pageInfo["wordCount"] = countWords(pageText);
     pageInfo["sentenceCount"] = countSentences(pageText);
@@ -209,11 +295,18 @@ QJsonObject PDFUtilities::analyzePage(Poppler::Page* page, int pageNumber) {
     return pageInfo;
 }
 
-QString PDFUtilities::extractPageText(Poppler::Page* page) {
+QString PDFUtilities::extractPageText(Poppler::Page* page,
+                                      TextExtractionMode mode) {
     if (!page) {
         return QString();
     }
 
+    // RawOrderLayout skips Poppler's layout analysis — a large slice
+    // of extraction cost — and returns text objects in content-stream
+    // order, which is all the order-insensitive callers need
+    if (mode == TextExtractionMode::Fast) {
+        return page->text(QRectF(), Poppler::Page::RawOrderLayout);
+    }
     return page->text(QRectF());
 }
 
@@ -235,6 +328,248 @@ QList<QPixmap> PDFUtilities::extractPageImages(Poppler::Page* page) {
     return images;
 }
 
+namespace {
+
+struct EmbeddedImageRecord {
+    qint64 offset = 0;  // Stream data start within the file
+    qint64 length = 0;
+    int width = 0;
+    int height = 0;
+};
+
+QMutex g_embeddedImageMutex;
+// File hash -> image streams in object order. An empty vector means
+// the file was scanned and has no usable streams; absence means it was
+// never scanned
+QHash<QString, QVector<EmbeddedImageRecord>> g_embeddedImageIndex;
+
+// Parses "/Key 123" out of a dictionary slice. Returns -1 when the key
+// is missing, non-numeric, or an indirect reference ("12 0 R")
+qint64 dictIntValue(const QByteArray& dict, const QByteArray& key) {
+    auto isDigit = [](char c) { return c >= '0' && c <= '9'; };
+    auto isSpace = [](char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    };
+
+    qsizetype pos = dict.indexOf(key);
+    if (pos < 0) {
+        return -1;
+    }
+    pos += key.size();
+    while (pos < dict.size() && isSpace(dict.at(pos))) {
+        pos++;
+    }
+    qsizetype end = pos;
+    while (end < dict.size() && isDigit(dict.at(end))) {
+        end++;
+    }
+    if (end == pos) {
+        return -1;
+    }
+
+    // Indirect reference: the number is followed by a generation
+    // number and the R keyword
+    qsizetype probe = end;
+    while (probe < dict.size() && isSpace(dict.at(probe))) {
+        probe++;
+    }
+    qsizetype gen = probe;
+    while (gen < dict.size() && isDigit(dict.at(gen))) {
+        gen++;
+    }
+    if (gen > probe) {
+        qsizetype r = gen;
+        while (r < dict.size() && isSpace(dict.at(r))) {
+            r++;
+        }
+        if (r < dict.size() && dict.at(r) == 'R') {
+            return -1;
+        }
+    }
+
+    return dict.mid(pos, end - pos).toLongLong();
+}
+
+QVector<EmbeddedImageRecord> scanEmbeddedImages(const QString& filePath) {
+    QVector<EmbeddedImageRecord> records;
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return records;
+    }
+    uchar* mapped = file.map(0, file.size());
+    const QByteArray data =
+        mapped ? QByteArray::fromRawData(reinterpret_cast<const char*>(mapped),
+                                         file.size())
+               : file.readAll();
+
+    // Encrypted streams cannot be handed to the image decoder as-is
+    if (data.contains("/Encrypt")) {
+        return records;
+    }
+
+    qsizetype searchPos = 0;
+    while (true) {
+        const qsizetype imagePos = data.indexOf("/Image", searchPos);
+        if (imagePos < 0) {
+            break;
+        }
+        searchPos = imagePos + 6;
+
+        // Must be the value of a /Subtype key (and not the /ImageMask
+        // boolean, whose name also starts with /Image)
+        const qsizetype subtypePos = data.lastIndexOf("/Subtype", imagePos);
+        if (subtypePos < 0 || imagePos - subtypePos > 16) {
+            continue;
+        }
+
+        const qsizetype objPos = data.lastIndexOf(" obj", imagePos);
+        const qsizetype streamPos = data.indexOf("stream", imagePos);
+        if (objPos < 0 || streamPos < 0) {
+            continue;
+        }
+        const QByteArray dict = data.mid(objPos, streamPos - objPos);
+
+        // Only plain JPEG streams qualify: any additional filter (or a
+        // stencil mask) would need Poppler's stream machinery anyway
+        if (!dict.contains("/DCTDecode") || dict.contains("/FlateDecode") ||
+            dict.contains("/Crypt") || dict.contains("/ImageMask")) {
+            continue;
+        }
+
+        EmbeddedImageRecord record;
+        record.width = static_cast<int>(dictIntValue(dict, "/Width"));
+        record.height = static_cast<int>(dictIntValue(dict, "/Height"));
+        if (record.width <= 0 || record.height <= 0) {
+            continue;
+        }
+
+        // Stream data begins after the keyword and one EOL
+        qsizetype dataStart = streamPos + 6;
+        if (dataStart < data.size() && data.at(dataStart) == '\r') {
+            dataStart++;
+        }
+        if (dataStart < data.size() && data.at(dataStart) == '\n') {
+            dataStart++;
+        }
+
+        qint64 length = dictIntValue(dict, "/Length");
+        if (length <= 0) {
+            // /Length was an indirect reference; fall back to the
+            // endstream delimiter, which cannot occur inside JPEG data
+            const qsizetype endPos = data.indexOf("endstream", dataStart);
+            if (endPos < 0) {
+                continue;
+            }
+            length = endPos - dataStart;
+            while (length > 0 && (data.at(dataStart + length - 1) == '\n' ||
+                                  data.at(dataStart + length - 1) == '\r')) {
+                length--;
+            }
+        }
+        if (length <= 4 || dataStart + length > data.size()) {
+            continue;
+        }
+
+        // The stream must actually start with the JPEG SOI marker
+        if (static_cast<uchar>(data.at(dataStart)) != 0xFF ||
+            static_cast<uchar>(data.at(dataStart + 1)) != 0xD8) {
+            continue;
+        }
+
+        record.offset = dataStart;
+        record.length = length;
+        records.append(record);
+        searchPos = dataStart + length;
+    }
+
+    return records;
+}
+
+}  // namespace
+
+QImage PDFUtilities::EmbeddedPageImage::decode(const QSize& scaledTo) const {
+    if (!valid || encoded.isEmpty()) {
+        return QImage();
+    }
+    QBuffer buffer;
+    buffer.setData(encoded);
+    buffer.open(QIODevice::ReadOnly);
+    QImageReader reader(&buffer, "jpeg");
+    if (!scaledTo.isEmpty()) {
+        // libjpeg applies 1/2..1/8 DCT scaling during decode, so a
+        // thumbnail-sized request never materializes the full raster
+        reader.setScaledSize(scaledTo);
+    }
+    return reader.read();
+}
+
+PDFUtilities::EmbeddedPageImage PDFUtilities::extractEmbeddedPageImage(
+    const QString& filePath, int pageNumber, int pageCount,
+    const QSizeF& pageSizePoints) {
+    EmbeddedPageImage result;
+    if (filePath.isEmpty() || pageNumber < 0 || pageCount <= 0) {
+        return result;
+    }
+
+    const QString fileHash = DiskRenderCache::hashForFile(filePath);
+    if (fileHash.isEmpty()) {
+        return result;
+    }
+
+    QVector<EmbeddedImageRecord> records;
+    bool known = false;
+    {
+        QMutexLocker locker(&g_embeddedImageMutex);
+        auto it = g_embeddedImageIndex.constFind(fileHash);
+        if (it != g_embeddedImageIndex.constEnd()) {
+            records = *it;
+            known = true;
+        }
+    }
+    if (!known) {
+        // Scan outside the lock; a racing duplicate scan is harmless
+        records = scanEmbeddedImages(filePath);
+        QMutexLocker locker(&g_embeddedImageMutex);
+        g_embeddedImageIndex.insert(fileHash, records);
+    }
+
+    // The fast path only fires for the unambiguous shape: exactly one
+    // image stream per page, in object order
+    if (records.size() != pageCount || pageNumber >= records.size()) {
+        return result;
+    }
+    const EmbeddedImageRecord& record = records.at(pageNumber);
+
+    // Aspect guard when the caller knows the page size: a full-page
+    // scan matches the page shape within rounding; anything else is
+    // not safe to substitute for the rendered page
+    if (!pageSizePoints.isEmpty()) {
+        const double pageAspect =
+            pageSizePoints.width() / pageSizePoints.height();
+        const double imageAspect =
+            static_cast<double>(record.width) / record.height;
+        if (qAbs(pageAspect - imageAspect) > 0.02 * pageAspect) {
+            return result;
+        }
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(record.offset)) {
+        return result;
+    }
+    QByteArray encoded = file.read(record.length);
+    if (encoded.size() != record.length) {
+        return result;
+    }
+
+    result.encoded = encoded;
+    result.width = record.width;
+    result.height = record.height;
+    result.valid = true;
+    return result;
+}
+
 QList<QRectF> PDFUtilities::findTextBounds(Poppler::Page* page,
                                            const QString& searchText) {
     QList<QRectF> bounds;
@@ -371,6 +706,70 @@ QString PDFUtilities::detectLanguage(const QString& text) {
     return "unknown";
 }
 
+// Memoized per-document results; keyed by content hash so identical
+// files share an entry and a re-opened document never re-detects
+namespace {
+QMutex g_languageMutex;
+QHash<QString, QString> g_languageByHash;
+
+// Pages sampled per document and the point at which the sample is big
+// enough: a few thousand characters of running text pins down the
+// common-word counts detectLanguage relies on
+constexpr int LANGUAGE_SAMPLE_PAGES = 5;
+constexpr int LANGUAGE_SAMPLE_CHARS = 8000;
+}  // namespace
+
+QString PDFUtilities::detectDocumentLanguage(Poppler::Document* document) {
+    if (!document) {
+        return "unknown";
+    }
+
+    // namespaceForDocument memoizes the hash per path, so resolving it
+    // here costs a lookup, not a file read
+    const QString hash = PDFCacheManager::namespaceForDocument(document);
+    if (!hash.isEmpty()) {
+        QMutexLocker locker(&g_languageMutex);
+        auto it = g_languageByHash.constFind(hash);
+        if (it != g_languageByHash.constEnd()) {
+            return *it;
+        }
+    }
+
+    // Sample pages spread evenly through the document rather than
+    // extracting everything: front matter, body and back matter all
+    // contribute, so a cover page in another language doesn't dominate
+    const int pageCount = document->numPages();
+    QString sample;
+    int lastSampled = -1;
+    for (int i = 0; i < LANGUAGE_SAMPLE_PAGES && pageCount > 0; ++i) {
+        const int pageNumber =
+            pageCount == 1 ? 0
+                           : i * (pageCount - 1) / (LANGUAGE_SAMPLE_PAGES - 1);
+        if (pageNumber == lastSampled) {
+            continue;  // Short documents: indices collapse
+        }
+        lastSampled = pageNumber;
+        std::unique_ptr<Poppler::Page> page(document->page(pageNumber));
+        if (!page) {
+            continue;
+        }
+        if (!sample.isEmpty()) {
+            sample += QLatin1Char(' ');
+        }
+        sample += extractPageText(page.get(), TextExtractionMode::Fast);
+        if (sample.size() >= LANGUAGE_SAMPLE_CHARS) {
+            break;
+        }
+    }
+
+    const QString language = detectLanguage(sample);
+    if (!hash.isEmpty()) {
+        QMutexLocker locker(&g_languageMutex);
+        g_languageByHash.insert(hash, language);
+    }
+    return language;
+}
+
 QJsonObject PDFUtilities::analyzeImage(const QPixmap& image) {
     QJsonObject analysis;
 
@@ -870,28 +1269,17 @@ bool PDFUtilities::exportDocumentAsImages(Poppler::Document* document,
         return false;
     }
 
-    QDir dir(outputDir);
-    if (!dir.exists()) {
-        dir.mkpath(outputDir);
-    }
-
-    bool success = true;
-
-    for (int i = 0; i < document->numPages(); ++i) {
-        std::unique_ptr<Poppler::Page> page(document->page(i));
-        if (page) {
-            QString fileName = QString("page_%1.%2")
-                                   .arg(i + 1, 3, 10, QChar('0'))
-                                   .arg(format.toLower());
-            QString filePath = dir.absoluteFilePath(fileName);
-
-            if (!exportPageAsImage(page.get(), filePath, format)) {
-                success = false;
-            }
-        }
+    // Renders fan out across the shared pool with encoding on separate
+    // threads; same "page_NNN.<ext>" names as the old serial loop, but
+    // the walk overlaps rasterization and compression and streams to
+    // disk in bounded memory.
+    PageExportEngine engine;
+    if (!engine.startExport(document, 0, document->numPages() - 1, outputDir,
+                            format)) {
+        return false;
     }
-
-    return success;
+    engine.waitForFinished();
+    return engine.lastFailedCount() == 0;
 }
 
 bool PDFUtilities::exportTextToFile(const QString& text,
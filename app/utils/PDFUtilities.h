@@ -1,6 +1,7 @@
 #pragma once
 
 #include <poppler-qt6.h>
+#include <QImage>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QPixmap>
@@ -8,6 +9,7 @@
 #include <QSizeF>
 #include <QString>
 #include <QStringList>
+#include <functional>
 
 // Forward declaration
 class PDFAnnotation;
@@ -17,16 +19,74 @@ class PDFAnnotation;
  */
 class PDFUtilities {
 public:
+    // Text extraction modes. Accurate runs Poppler's layout analysis
+    // so the text reads in visual order — required wherever a human
+    // consumes the result (clipboard copy, reflow). Fast returns text
+    // objects in content-stream order and skips layout analysis, which
+    // is a large fraction of extraction cost; for indexing,
+    // fingerprinting and statistics the ordering is irrelevant.
+    enum class TextExtractionMode { Accurate, Fast };
+
     // Document analysis functions
     static QJsonObject analyzeDocument(Poppler::Document* document);
-    static QStringList extractAllText(Poppler::Document* document);
+    static QStringList extractAllText(
+        Poppler::Document* document,
+        TextExtractionMode mode = TextExtractionMode::Accurate);
+
+    // Batch text extraction: fans the page range out across the shared
+    // render pool and blocks until every page is done. onPageText is
+    // invoked once per page and onProgress after each completion; both
+    // run on pool threads (and the calling thread, which works one
+    // shard itself so a saturated pool cannot stall the batch), so they
+    // must be thread-safe. Pages arrive in no particular order.
+    static void extractTextRange(
+        Poppler::Document* document, int firstPage, int lastPage,
+        const std::function<void(int pageNumber, const QString& text)>&
+            onPageText,
+        const std::function<void(int pagesDone, int pagesTotal)>& onProgress =
+            nullptr,
+        TextExtractionMode mode = TextExtractionMode::Accurate);
     static QList<QPixmap> extractAllImages(Poppler::Document* document);
     static QJsonArray extractDocumentStructure(Poppler::Document* document);
 
     // Page analysis functions
     static QJsonObject analyzePage(Poppler::Page* page, int pageNumber);
-    static QString extractPageText(Poppler::Page* page);
+    static QString extractPageText(
+        Poppler::Page* page,
+        TextExtractionMode mode = TextExtractionMode::Accurate);
     static QList<QPixmap> extractPageImages(Poppler::Page* page);
+
+    // Embedded-image fast path for scanned documents. Scanner output
+    // typically stores each page as a single full-page JPEG that
+    // Poppler re-decodes and re-rasterizes on every render. A flat
+    // byte scan of the raw file (image XObjects are always top-level
+    // stream objects, so this works regardless of cross-reference
+    // format) finds every plain DCTDecode image stream; when the file
+    // holds exactly one per page — the unambiguous
+    // single-full-page-image shape — the still-encoded stream can be
+    // handed to the render pipeline and decoded at any target size,
+    // bypassing rasterization entirely. Stream offsets are cached per
+    // file hash, so the scan runs once per file.
+    struct EmbeddedPageImage {
+        QByteArray encoded;  // Still-encoded JPEG stream
+        int width = 0;       // Raster dimensions from the image dict
+        int height = 0;
+        bool valid = false;
+
+        // Decodes the stream; a non-empty scaledTo is applied inside
+        // the JPEG decoder (DCT scaling), far cheaper than decoding
+        // full-size and resampling afterwards
+        QImage decode(const QSize& scaledTo = QSize()) const;
+    };
+
+    // Returns the page's embedded image when the document has the
+    // one-image-per-page shape, an invalid result otherwise. When
+    // pageSizePoints is known the image must also match the page's
+    // aspect ratio (a full-page scan does; a logo on a text page does
+    // not). Does file I/O; call from a worker thread.
+    static EmbeddedPageImage extractEmbeddedPageImage(
+        const QString& filePath, int pageNumber, int pageCount,
+        const QSizeF& pageSizePoints = QSizeF());
     static QList<QRectF> findTextBounds(Poppler::Page* page,
                                         const QString& searchText);
     static QSizeF getPageSize(Poppler::Page* page);
@@ -42,6 +102,14 @@ public:
                                        int wordsPerMinute = 200);
     static QString detectLanguage(const QString& text);
 
+    // Document-level language lookup. Detection runs once per document
+    // from a handful of pages distributed through it (single-language
+    // documents — the common case — don't need full text), and the
+    // result is memoized by content hash, so every later call is a hash
+    // lookup. Extracts text on first call; use from a worker thread for
+    // cold documents.
+    static QString detectDocumentLanguage(Poppler::Document* document);
+
     // Image analysis functions
     static QJsonObject analyzeImage(const QPixmap& image);
     static bool isImageDuplicate(const QPixmap& image1, const QPixmap& image2,
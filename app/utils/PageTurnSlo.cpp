@@ -0,0 +1,66 @@
+#include "PageTurnSlo.h"
+#include "LatencyMetrics.h"
+#include "LoggingMacros.h"
+
+PageTurnSlo::PageTurnSlo()
+    : m_total(LatencyMetrics::instance().histogram(
+          QStringLiteral("page-turn"))),
+      m_queue(LatencyMetrics::instance().histogram(
+          QStringLiteral("page-turn.queue"))),
+      m_render(LatencyMetrics::instance().histogram(
+          QStringLiteral("page-turn.render"))),
+      m_convert(LatencyMetrics::instance().histogram(
+          QStringLiteral("page-turn.convert"))),
+      m_paint(LatencyMetrics::instance().histogram(
+          QStringLiteral("page-turn.paint"))) {}
+
+PageTurnSlo& PageTurnSlo::instance() {
+    static PageTurnSlo slo;
+    return slo;
+}
+
+void PageTurnSlo::beginTurn(int pageNumber) {
+    m_pending = true;
+    m_pageNumber = pageNumber;
+    for (qint64& stage : m_stageUs) {
+        stage = 0;
+    }
+    m_timer.start();
+}
+
+void PageTurnSlo::noteStage(Stage stage, qint64 durationUs) {
+    if (!m_pending) {
+        return;
+    }
+    m_stageUs[static_cast<int>(stage)] += durationUs;
+}
+
+void PageTurnSlo::finishTurn(int pageNumber) {
+    if (!m_pending || pageNumber != m_pageNumber) {
+        return;
+    }
+    m_pending = false;
+
+    const qint64 totalUs = m_timer.nsecsElapsed() / 1000;
+    const qint64 renderUs = m_stageUs[static_cast<int>(Stage::Render)];
+    const qint64 convertUs = m_stageUs[static_cast<int>(Stage::Convert)];
+    const qint64 paintUs = m_stageUs[static_cast<int>(Stage::Paint)];
+    // Everything not spent in an instrumented stage: event queue wait,
+    // layout and scroll synchronization between input and paint. Paint
+    // already contains the conversion slice, so it is not re-subtracted
+    const qint64 queueUs = qMax<qint64>(0, totalUs - renderUs - paintUs);
+
+    m_total->record(totalUs);
+    m_queue->record(queueUs);
+    m_render->record(renderUs);
+    m_convert->record(convertUs);
+    m_paint->record(paintUs);
+
+    if (totalUs > BUDGET_MS * 1000) {
+        LOG_WARNING(
+            "Page turn SLO breach: page {} visible in {}ms (budget {}ms) - "
+            "queue/layout {}us, render {}us, paint {}us (convert {}us)",
+            m_pageNumber + 1, totalUs / 1000, BUDGET_MS, queueUs, renderUs,
+            paintUs, convertUs);
+    }
+}
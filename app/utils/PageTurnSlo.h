@@ -0,0 +1,118 @@
+#pragma once
+
+#include <QElapsedTimer>
+
+class LatencyHistogram;
+
+/**
+ * Page-turn latency SLO tracker.
+ *
+ * Ops target: 95% of page turns visible within 150ms. A turn starts at
+ * the navigation input (goToPage and everything funnelling into it -
+ * next/previous, shortcuts, the page spinbox, thumbnail clicks) and
+ * ends at the first paint that puts a frame of the target page on
+ * screen. Totals and stage times feed LatencyMetrics histograms, so
+ * the periodic percentile summaries double as the dashboard feed; a
+ * turn that blows the budget is logged immediately with a breakdown
+ * naming the stage that consumed it (queue/layout residual, Poppler
+ * render, pixmap conversion, paint).
+ *
+ * The first visible frame is the synchronous preview pass, so the
+ * whole measured path runs on the GUI thread and the tracker needs no
+ * locking. The asynchronous sharp pass that later replaces the preview
+ * is not part of perceived turn latency and is not measured here.
+ */
+class PageTurnSlo {
+public:
+    // Paint includes the QPixmap conversion; Convert is reported as
+    // its slice so breach logs can tell upload cost from raster cost
+    enum class Stage { Render = 0, Convert, Paint };
+
+    static PageTurnSlo& instance();
+
+    // Called at navigation input. An unfinished previous turn is
+    // abandoned: its page never became visible before the next input
+    void beginTurn(int pageNumber);
+
+    // Accumulates stage time into the pending turn; no-op otherwise
+    void noteStage(Stage stage, qint64 durationUs);
+
+    bool turnPending() const { return m_pending; }
+
+    // Called after a frame of pageNumber reached the painter; no-op
+    // for other pages or when no turn is pending
+    void finishTurn(int pageNumber);
+
+private:
+    PageTurnSlo();
+
+    // 95% of turns must be visible inside this budget
+    static constexpr qint64 BUDGET_MS = 150;
+    static constexpr int STAGE_COUNT = 3;
+
+    bool m_pending = false;
+    int m_pageNumber = -1;
+    QElapsedTimer m_timer;
+    qint64 m_stageUs[STAGE_COUNT] = {};
+
+    // Resolved once; histograms live for the process lifetime
+    LatencyHistogram* m_total;
+    LatencyHistogram* m_queue;
+    LatencyHistogram* m_render;
+    LatencyHistogram* m_convert;
+    LatencyHistogram* m_paint;
+};
+
+/**
+ * RAII stage accumulator. Does nothing when no turn is pending at
+ * construction, so it can sit on paths shared with zoom/pan repaints
+ */
+class PageTurnStageTimer {
+public:
+    explicit PageTurnStageTimer(PageTurnSlo::Stage stage)
+        : m_stage(stage), m_active(PageTurnSlo::instance().turnPending()) {
+        if (m_active) {
+            m_timer.start();
+        }
+    }
+
+    ~PageTurnStageTimer() {
+        if (m_active) {
+            PageTurnSlo::instance().noteStage(m_stage,
+                                              m_timer.nsecsElapsed() / 1000);
+        }
+    }
+
+    PageTurnStageTimer(const PageTurnStageTimer&) = delete;
+    PageTurnStageTimer& operator=(const PageTurnStageTimer&) = delete;
+
+private:
+    PageTurnSlo::Stage m_stage;
+    bool m_active;
+    QElapsedTimer m_timer;
+};
+
+/**
+ * Closes the turn measurement on scope exit once arm() confirms a
+ * frame actually reached the painter. Declare it before the
+ * paint-stage timer so destruction accumulates the paint time first
+ */
+class PageTurnFinisher {
+public:
+    explicit PageTurnFinisher(int pageNumber) : m_pageNumber(pageNumber) {}
+
+    void arm() { m_armed = true; }
+
+    ~PageTurnFinisher() {
+        if (m_armed) {
+            PageTurnSlo::instance().finishTurn(m_pageNumber);
+        }
+    }
+
+    PageTurnFinisher(const PageTurnFinisher&) = delete;
+    PageTurnFinisher& operator=(const PageTurnFinisher&) = delete;
+
+private:
+    int m_pageNumber;
+    bool m_armed = false;
+};
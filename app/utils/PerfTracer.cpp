@@ -0,0 +1,73 @@
+#include "PerfTracer.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+
+PerfTracer& PerfTracer::instance() {
+    static PerfTracer tracer;
+    return tracer;
+}
+
+PerfTracer::PerfTracer()
+    : m_ring(RING_CAPACITY), m_writeIndex(0), m_enabled(false) {
+    m_clock.start();
+}
+
+void PerfTracer::record(const char* name, qint64 startUs, qint64 durationUs) {
+    const quint64 slot =
+        m_writeIndex.fetch_add(1, std::memory_order_relaxed) % RING_CAPACITY;
+    TraceEvent& event = m_ring[slot];
+    event.name = name;
+    event.startUs = startUs;
+    event.durationUs = durationUs;
+    event.threadId = reinterpret_cast<quintptr>(QThread::currentThreadId());
+}
+
+void PerfTracer::clear() {
+    m_writeIndex.store(0, std::memory_order_relaxed);
+    for (TraceEvent& event : m_ring) {
+        event.name = nullptr;
+    }
+}
+
+int PerfTracer::eventCount() const {
+    const quint64 written = m_writeIndex.load(std::memory_order_relaxed);
+    return static_cast<int>(
+        qMin(written, static_cast<quint64>(RING_CAPACITY)));
+}
+
+bool PerfTracer::dumpChromeTracing(const QString& filePath) const {
+    const quint64 written = m_writeIndex.load(std::memory_order_relaxed);
+    const quint64 count = qMin(written, static_cast<quint64>(RING_CAPACITY));
+    const quint64 first = written > RING_CAPACITY ? written % RING_CAPACITY : 0;
+
+    QJsonArray events;
+    for (quint64 i = 0; i < count; ++i) {
+        const TraceEvent& event = m_ring[(first + i) % RING_CAPACITY];
+        if (!event.name) {
+            continue;  // Slot torn by a concurrent writer or cleared
+        }
+
+        QJsonObject entry;
+        entry["name"] = QString::fromLatin1(event.name);
+        entry["ph"] = QStringLiteral("X");  // Complete event
+        entry["ts"] = event.startUs;
+        entry["dur"] = event.durationUs;
+        entry["pid"] = 1;
+        entry["tid"] = static_cast<qint64>(event.threadId);
+        events.append(entry);
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = events;
+    root["displayTimeUnit"] = QStringLiteral("ms");
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    return true;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QString>
+#include <atomic>
+#include <vector>
+
+/**
+ * Lightweight hot-path tracer for production diagnostics.
+ *
+ * Scoped spans (see TraceSpan / PERF_TRACE_SCOPE) record into a fixed
+ * ring buffer with a single relaxed atomic increment per span, so the
+ * tracer can stay compiled into release builds. When tracing is
+ * disabled - the default - a span costs one relaxed atomic load.
+ * Captured traces export in the Chrome "Trace Event Format" and load
+ * directly into chrome://tracing or Perfetto.
+ */
+class PerfTracer {
+public:
+    struct TraceEvent {
+        const char* name;  // String literal supplied by the span
+        qint64 startUs;
+        qint64 durationUs;
+        quint64 threadId;
+    };
+
+    static PerfTracer& instance();
+
+    void setEnabled(bool enabled) {
+        m_enabled.store(enabled, std::memory_order_relaxed);
+    }
+    bool isEnabled() const {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    // Microseconds on the tracer's monotonic clock
+    qint64 nowUs() const { return m_clock.nsecsElapsed() / 1000; }
+
+    // Called from span destructors on any thread. The name must be a
+    // string literal; only the pointer is stored
+    void record(const char* name, qint64 startUs, qint64 durationUs);
+
+    void clear();
+    int eventCount() const;
+
+    // Writes the buffered spans as Chrome-tracing JSON. Best effort:
+    // spans recorded concurrently with the dump may be torn and are
+    // skipped, which is acceptable for a diagnostics snapshot
+    bool dumpChromeTracing(const QString& filePath) const;
+
+private:
+    PerfTracer();
+
+    static constexpr int RING_CAPACITY = 8192;
+
+    std::vector<TraceEvent> m_ring;
+    std::atomic<quint64> m_writeIndex;
+    std::atomic<bool> m_enabled;
+    QElapsedTimer m_clock;
+};
+
+/**
+ * RAII trace span; prefer the PERF_TRACE_SCOPE macro at call sites so
+ * instrumentation can be compiled out entirely with DISABLE_PERF_TRACING
+ */
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name) : m_name(name), m_startUs(-1) {
+        if (PerfTracer::instance().isEnabled()) {
+            m_startUs = PerfTracer::instance().nowUs();
+        }
+    }
+
+    ~TraceSpan() {
+        if (m_startUs >= 0) {
+            PerfTracer& tracer = PerfTracer::instance();
+            tracer.record(m_name, m_startUs, tracer.nowUs() - m_startUs);
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* m_name;
+    qint64 m_startUs;  // -1 when tracing was disabled at entry
+};
+
+#ifndef DISABLE_PERF_TRACING
+#define PERF_TRACE_CONCAT_IMPL(a, b) a##b
+#define PERF_TRACE_CONCAT(a, b) PERF_TRACE_CONCAT_IMPL(a, b)
+#define PERF_TRACE_SCOPE(name) \
+    TraceSpan PERF_TRACE_CONCAT(perfTraceSpan_, __LINE__)(name)
+#else
+#define PERF_TRACE_SCOPE(name) static_cast<void>(0)
+#endif
@@ -0,0 +1,69 @@
+#include "RenderPolicy.h"
+
+#include <QtMath>
+#include <atomic>
+
+namespace {
+std::atomic<bool> g_lowMemoryProfile{false};
+}
+
+void RenderPolicy::setLowMemoryProfile(bool enabled) {
+    g_lowMemoryProfile.store(enabled, std::memory_order_relaxed);
+}
+
+bool RenderPolicy::lowMemoryProfile() {
+    return g_lowMemoryProfile.load(std::memory_order_relaxed);
+}
+
+double RenderPolicy::maxRenderDpi() {
+    return lowMemoryProfile() ? LOW_MEMORY_MAX_DPI : MAX_RENDER_DPI;
+}
+
+double RenderPolicy::pageDpi(double devicePixelRatio, double zoom) {
+    if (devicePixelRatio <= 0.0) {
+        devicePixelRatio = 1.0;
+    }
+    double dpi = BASE_DPI * zoom * devicePixelRatio;
+    return qBound(MIN_RENDER_DPI, dpi, maxRenderDpi());
+}
+
+double RenderPolicy::fitDpi(const QSize& targetSize, const QSizeF& pagePoints,
+                            double devicePixelRatio, double quality) {
+    if (targetSize.isEmpty() || pagePoints.isEmpty()) {
+        return MIN_RENDER_DPI;
+    }
+    if (devicePixelRatio <= 0.0) {
+        devicePixelRatio = 1.0;
+    }
+    // Uniform scale that fits the page into the target slot
+    double scale = qMin(targetSize.width() / pagePoints.width(),
+                        targetSize.height() / pagePoints.height());
+    double dpi = BASE_DPI * scale * quality * devicePixelRatio;
+    return qBound(MIN_RENDER_DPI, dpi, maxRenderDpi());
+}
+
+QImage RenderPolicy::toStorageFormat(const QImage& image, bool pageHasColor) {
+#ifdef ENABLE_GRAYSCALE_RENDER
+    if (!pageHasColor && !image.isNull() &&
+        image.format() != QImage::Format_Grayscale8) {
+        return image.convertToFormat(QImage::Format_Grayscale8);
+    }
+#else
+    Q_UNUSED(pageHasColor);
+#endif
+    return image;
+}
+
+QSize RenderPolicy::targetSizePixels(const QSizeF& pagePoints, double xDpi,
+                                     double yDpi, int rotationDegrees) {
+    if (pagePoints.isEmpty()) {
+        return QSize();
+    }
+    QSize size(qCeil(pagePoints.width() * xDpi / BASE_DPI),
+               qCeil(pagePoints.height() * yDpi / BASE_DPI));
+    int rotation = ((rotationDegrees % 360) + 360) % 360;
+    if (rotation == 90 || rotation == 270) {
+        size.transpose();
+    }
+    return size;
+}
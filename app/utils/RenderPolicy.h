@@ -0,0 +1,74 @@
+#pragma once
+
+#include <QImage>
+#include <QSize>
+#include <QSizeF>
+
+/**
+ * Central render-resolution policy.
+ *
+ * Render call sites used to derive DPI independently — PDFPageWidget,
+ * the prerenderer, the QGraphics viewer and the thumbnail generator
+ * each multiplied their own base DPI by their own notion of scale,
+ * which left some paths rendering at twice the needed resolution on
+ * HiDPI displays (4x the pixels) and others below native. Every
+ * renderToImage call now gets its resolution from here, so a given
+ * (device pixel ratio, zoom) pair always maps to the same DPI and the
+ * RenderBroker can coalesce renders across call sites.
+ *
+ * Quality ceilings live here and nowhere else. The low-memory profile
+ * below is the one deployment switch for constrained hardware (4GB
+ * kiosks): RenderPolicy lowers the DPI ceiling, and the prerenderer,
+ * thumbnail model and cache manager consult the same flag so the whole
+ * process degrades coherently instead of each subsystem OOMing on its
+ * own schedule. Set once at startup, before any rendering.
+ */
+class RenderPolicy {
+public:
+    // PDF user space is 72 points per inch
+    static constexpr double BASE_DPI = 72.0;
+
+    // Below this a page is unreadable even as a transient preview
+    static constexpr double MIN_RENDER_DPI = 36.0;
+
+    // Memory ceiling: an A4 page at 300 DPI is already ~35 MB of ARGB
+    static constexpr double MAX_RENDER_DPI = 300.0;
+
+    // Ceiling under the low-memory profile: half the DPI, a quarter of
+    // the ARGB bytes per page, still readable at typical kiosk zoom
+    static constexpr double LOW_MEMORY_MAX_DPI = 150.0;
+
+    // Deployment-selectable low-memory profile (--low-memory or
+    // READIUM_LOW_MEMORY=1)
+    static void setLowMemoryProfile(bool enabled);
+    static bool lowMemoryProfile();
+
+    // Effective DPI ceiling for the active profile
+    static double maxRenderDpi();
+
+    // Exact DPI for an on-screen page at the given zoom on a display
+    // with the given device pixel ratio. 1.0 zoom at 1.0 DPR renders
+    // one page point per physical pixel.
+    static double pageDpi(double devicePixelRatio, double zoom);
+
+    // DPI that fits a page (in points) into a physical pixel target,
+    // e.g. a thumbnail slot. quality scales the result for callers
+    // that trade sharpness for speed.
+    static double fitDpi(const QSize& targetSize, const QSizeF& pagePoints,
+                         double devicePixelRatio, double quality = 1.0);
+
+    // Physical pixel size a page renders to at the given DPI, with
+    // width/height swapped for 90/270 degree rotation.
+    static QSize targetSizePixels(const QSizeF& pagePoints, double xDpi,
+                                  double yDpi, int rotationDegrees = 0);
+
+    // Storage format for rendered page pixels. With the grayscale fast
+    // path compiled in (ENABLE_GRAYSCALE_RENDER, default on) pages the
+    // classifier found free of color are stored as Grayscale8 — a
+    // quarter of the ARGB bytes through the memory and disk caches and
+    // a quarter of the memcpy bandwidth. Conversion back to a display
+    // format happens only at the final composite (QPixmap::fromImage or
+    // the painter); color pages pass through untouched, so callers can
+    // apply this unconditionally after rendering.
+    static QImage toStorageFormat(const QImage& image, bool pageHasColor);
+};
@@ -0,0 +1,57 @@
+#include "SignalThrottle.h"
+#include <QDateTime>
+#include <QMutexLocker>
+#include <QTimer>
+
+SignalThrottle::SignalThrottle(QObject* parent, int intervalMs)
+    : QObject(parent),
+      m_scheduled(false),
+      m_lastDeliveryMs(0),
+      m_intervalMs(intervalMs) {}
+
+void SignalThrottle::post(std::function<void()> emission) {
+    QMutexLocker locker(&m_mutex);
+    m_pending = std::move(emission);
+    if (m_scheduled) {
+        return;  // A delivery is already on its way; it takes the latest
+    }
+    m_scheduled = true;
+    locker.unlock();
+
+    // Hop to the owner's thread; the wait for the frame interval is
+    // timed there, against the last actual delivery
+    QMetaObject::invokeMethod(this, [this]() { scheduleDelivery(); },
+                              Qt::QueuedConnection);
+}
+
+void SignalThrottle::flush() { deliverPending(); }
+
+void SignalThrottle::cancel() {
+    QMutexLocker locker(&m_mutex);
+    m_pending = nullptr;
+}
+
+void SignalThrottle::scheduleDelivery() {
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const qint64 wait = m_lastDeliveryMs + m_intervalMs - now;
+    if (wait <= 0) {
+        deliverPending();
+        return;
+    }
+    QTimer::singleShot(static_cast<int>(wait), this,
+                       [this]() { deliverPending(); });
+}
+
+void SignalThrottle::deliverPending() {
+    std::function<void()> emission;
+    {
+        QMutexLocker locker(&m_mutex);
+        emission = std::move(m_pending);
+        m_pending = nullptr;
+        m_scheduled = false;
+    }
+    m_lastDeliveryMs = QDateTime::currentMSecsSinceEpoch();
+    if (emission) {
+        emission();
+    }
+}
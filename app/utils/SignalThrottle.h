@@ -0,0 +1,54 @@
+#pragma once
+
+#include <QMutex>
+#include <QObject>
+#include <functional>
+
+/**
+ * Coalescing relay for high-frequency progress/status signals.
+ *
+ * Loaders, thumbnail generation and real-time search emit one signal
+ * per unit of work; crossing a thread boundary each becomes a queued
+ * GUI event, and a big document enqueues thousands of them with the
+ * status bar repainting on every one. Emitters route through this
+ * relay instead: post() stores the emission as a closure with
+ * latest-value-wins semantics, and at most one delivery per frame
+ * interval runs on the relay's (owner's) thread. Intermediate values
+ * are dropped — which is exactly right for progress — while flush()
+ * forces terminal values (100%, final results) out immediately and
+ * cancel() drops a stale pending update when a new operation starts.
+ *
+ * post() is callable from any thread; flush() and cancel() belong to
+ * the owner's thread.
+ */
+class SignalThrottle : public QObject {
+    Q_OBJECT
+
+public:
+    explicit SignalThrottle(QObject* parent = nullptr,
+                            int intervalMs = DEFAULT_INTERVAL_MS);
+
+    void setInterval(int intervalMs) { m_intervalMs = intervalMs; }
+
+    // Replaces any pending emission with this one and schedules a
+    // delivery if none is queued
+    void post(std::function<void()> emission);
+
+    // Runs the pending emission now, bypassing the interval
+    void flush();
+
+    // Drops the pending emission without running it
+    void cancel();
+
+private:
+    void scheduleDelivery();
+    void deliverPending();
+
+    QMutex m_mutex;
+    std::function<void()> m_pending;  // Guarded by m_mutex
+    bool m_scheduled;                 // Guarded by m_mutex
+    qint64 m_lastDeliveryMs;          // Owner-thread only
+    int m_intervalMs;
+
+    static constexpr int DEFAULT_INTERVAL_MS = 33;  // ~One frame at 30fps
+};
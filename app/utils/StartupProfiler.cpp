@@ -0,0 +1,89 @@
+#include "StartupProfiler.h"
+#include <QMutexLocker>
+#include <cstdio>
+#include "LoggingMacros.h"
+
+StartupProfiler& StartupProfiler::instance() {
+    static StartupProfiler instance;
+    return instance;
+}
+
+StartupProfiler::StartupProfiler()
+    : m_firstPaintSeen(false), m_dumpOnFirstPaint(false) {
+    m_clock.start();
+}
+
+void StartupProfiler::beginPhase(const QString& name) {
+    QMutexLocker locker(&m_mutex);
+    m_phases.append(Phase{name, m_clock.elapsed(), -1});
+}
+
+void StartupProfiler::endPhase(const QString& name) {
+    QMutexLocker locker(&m_mutex);
+    // Latest open phase with this name: phases may nest, so search from
+    // the back
+    for (int i = m_phases.size() - 1; i >= 0; --i) {
+        if (m_phases[i].name == name && m_phases[i].endMs < 0) {
+            m_phases[i].endMs = m_clock.elapsed();
+            return;
+        }
+    }
+}
+
+void StartupProfiler::mark(const QString& name) {
+    QMutexLocker locker(&m_mutex);
+    const qint64 now = m_clock.elapsed();
+    m_phases.append(Phase{name, now, now});
+}
+
+void StartupProfiler::markFirstPaint() {
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_firstPaintSeen) {
+            return;
+        }
+        m_firstPaintSeen = true;
+        const qint64 now = m_clock.elapsed();
+        m_phases.append(Phase{QStringLiteral("first paint"), now, now});
+    }
+
+    const QString text = report();
+    // The log route makes the report visible in DebugLogPanel
+    LOG_INFO("{}", text.toStdString());
+    if (m_dumpOnFirstPaint) {
+        fputs(qPrintable(text), stdout);
+        fputc('\n', stdout);
+        fflush(stdout);
+    }
+}
+
+void StartupProfiler::setDumpOnFirstPaint(bool dump) {
+    QMutexLocker locker(&m_mutex);
+    m_dumpOnFirstPaint = dump;
+}
+
+QList<StartupProfiler::Phase> StartupProfiler::phases() const {
+    QMutexLocker locker(&m_mutex);
+    return m_phases;
+}
+
+QString StartupProfiler::report() const {
+    QMutexLocker locker(&m_mutex);
+    QString out =
+        QStringLiteral("Startup phase report (ms since process start):");
+    for (const Phase& phase : m_phases) {
+        const auto start = static_cast<long long>(phase.startMs);
+        if (phase.endMs < 0) {
+            out += QString::asprintf("\n  %7lld ..    open           %s", start,
+                                     qPrintable(phase.name));
+        } else if (phase.endMs == phase.startMs) {
+            out += QString::asprintf("\n  %7lld                     %s", start,
+                                     qPrintable(phase.name));
+        } else {
+            const auto end = static_cast<long long>(phase.endMs);
+            out += QString::asprintf("\n  %7lld .. %7lld  %6lld  %s", start,
+                                     end, end - start, qPrintable(phase.name));
+        }
+    }
+    return out;
+}
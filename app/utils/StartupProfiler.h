@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+#include <QString>
+
+/**
+ * Startup phase instrumentation against a single monotonic clock
+ * anchored at the top of main(). Phases (QApplication init, window
+ * construction, plugin scan, ...) are recorded as begin/end pairs;
+ * one-off milestones such as first paint are recorded as marks.
+ *
+ * The report is logged once at first paint — which also lands it in
+ * DebugLogPanel via the logging stack — and the --startup-report
+ * command-line switch additionally dumps it to stdout, so per-release
+ * startup cost can be tracked from a script.
+ */
+class StartupProfiler {
+public:
+    struct Phase {
+        QString name;
+        qint64 startMs;
+        qint64 endMs;  // == startMs for marks, -1 while still open
+    };
+
+    static StartupProfiler& instance();
+
+    void beginPhase(const QString& name);
+    void endPhase(const QString& name);
+    // Zero-length milestone at the current clock position
+    void mark(const QString& name);
+
+    // Idempotent: the first call records the "first paint" milestone and
+    // emits the report; later calls (every repaint) are a cheap no-op
+    void markFirstPaint();
+    // --startup-report: also write the report to stdout at first paint
+    void setDumpOnFirstPaint(bool dump);
+
+    QList<Phase> phases() const;
+    QString report() const;
+
+private:
+    StartupProfiler();
+
+    mutable QMutex m_mutex;
+    QElapsedTimer m_clock;
+    QList<Phase> m_phases;
+    bool m_firstPaintSeen;
+    bool m_dumpOnFirstPaint;
+};
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <cmath>
+#include <functional>
+
+/**
+ * Statistical regression harness for the performance tests.
+ *
+ * Each scenario is timed over several runs (plus one discarded warm-up
+ * run so cold caches don't pollute the first sample). The harness
+ * computes the mean, sample standard deviation and a 95% confidence
+ * interval, then compares against a per-scenario baseline stored
+ * in-tree (tests/performance/baselines/). A scenario counts as a
+ * regression only when the *lower* bound of its confidence interval is
+ * above baseline * REGRESSION_THRESHOLD — a single noisy run cannot
+ * fail the suite, but a consistent 15%+ slowdown will.
+ *
+ * Baselines are pinned to the dedicated CI runner. After an intentional
+ * performance change (or a runner upgrade), re-pin them by running the
+ * suite with PERF_UPDATE_BASELINES=1 and committing the rewritten
+ * baseline file. A machine-readable JSON report of every measured
+ * scenario is written via writeReport() for dashboards and bisection.
+ */
+class PerfRegressionHarness {
+public:
+    struct ScenarioResult {
+        QString name;
+        int runs = 0;
+        double meanMs = 0.0;
+        double stdDevMs = 0.0;
+        double ciHalfWidthMs = 0.0;  // 95% confidence half-width
+        double baselineMs = -1.0;    // < 0 means no baseline recorded yet
+        bool regressed = false;
+    };
+
+    static constexpr double REGRESSION_THRESHOLD = 1.15;  // fail at +15%
+    static constexpr int DEFAULT_RUNS = 7;
+
+    explicit PerfRegressionHarness(const QString& baselinePath)
+        : m_baselinePath(baselinePath) {
+        loadBaselines();
+    }
+
+    // Times body() over `runs` recorded executions and checks the
+    // result against the baseline for `name`
+    ScenarioResult measure(const QString& name,
+                           const std::function<void()>& body,
+                           int runs = DEFAULT_RUNS) {
+        body();  // warm-up, not recorded
+
+        QList<double> samples;
+        samples.reserve(runs);
+        for (int i = 0; i < runs; ++i) {
+            QElapsedTimer timer;
+            timer.start();
+            body();
+            samples.append(timer.nsecsElapsed() / 1e6);
+        }
+
+        ScenarioResult result;
+        result.name = name;
+        result.runs = runs;
+
+        double sum = 0.0;
+        for (double sample : samples)
+            sum += sample;
+        result.meanMs = sum / runs;
+
+        if (runs > 1) {
+            double sqSum = 0.0;
+            for (double sample : samples) {
+                double d = sample - result.meanMs;
+                sqSum += d * d;
+            }
+            result.stdDevMs = std::sqrt(sqSum / (runs - 1));
+            result.ciHalfWidthMs =
+                tValue95(runs - 1) * result.stdDevMs / std::sqrt(double(runs));
+        }
+
+        if (m_baselines.contains(name)) {
+            result.baselineMs = m_baselines.value(name);
+            double lowerBound = result.meanMs - result.ciHalfWidthMs;
+            result.regressed =
+                lowerBound > result.baselineMs * REGRESSION_THRESHOLD;
+        }
+
+        m_results.append(result);
+        return result;
+    }
+
+    bool hasRegressions() const {
+        for (const auto& result : m_results) {
+            if (result.regressed)
+                return true;
+        }
+        return false;
+    }
+
+    // One line per regressed scenario, suitable for QVERIFY2 output
+    QString regressionSummary() const {
+        QStringList lines;
+        for (const auto& result : m_results) {
+            if (!result.regressed)
+                continue;
+            lines.append(QString("%1: %2ms (±%3ms) vs baseline %4ms (+%5%)")
+                             .arg(result.name)
+                             .arg(result.meanMs, 0, 'f', 1)
+                             .arg(result.ciHalfWidthMs, 0, 'f', 1)
+                             .arg(result.baselineMs, 0, 'f', 1)
+                             .arg((result.meanMs / result.baselineMs - 1.0) *
+                                      100.0,
+                                  0, 'f', 1));
+        }
+        return lines.join("; ");
+    }
+
+    // Machine-readable artifact: every scenario with its statistics,
+    // baseline and verdict
+    void writeReport(const QString& reportPath) const {
+        QJsonArray scenarios;
+        for (const auto& result : m_results) {
+            QJsonObject obj;
+            obj["name"] = result.name;
+            obj["runs"] = result.runs;
+            obj["meanMs"] = result.meanMs;
+            obj["stdDevMs"] = result.stdDevMs;
+            obj["ci95HalfWidthMs"] = result.ciHalfWidthMs;
+            obj["baselineMs"] = result.baselineMs;
+            obj["regressed"] = result.regressed;
+            scenarios.append(obj);
+        }
+
+        QJsonObject report;
+        report["scenarios"] = scenarios;
+        report["regressionThreshold"] = REGRESSION_THRESHOLD;
+        report["baselineFile"] = m_baselinePath;
+        report["timestamp"] =
+            QDateTime::currentDateTime().toString(Qt::ISODate);
+
+        QFile file(reportPath);
+        if (file.open(QIODevice::WriteOnly))
+            file.write(QJsonDocument(report).toJson());
+    }
+
+    // With PERF_UPDATE_BASELINES=1, rewrite the in-tree baseline file
+    // with the means just measured. Returns true when baselines were
+    // rewritten (callers should skip the pass/fail verdict in that case)
+    bool updateBaselinesIfRequested() const {
+        if (qgetenv("PERF_UPDATE_BASELINES") != "1")
+            return false;
+        if (m_baselinePath.isEmpty())
+            return false;
+
+        QJsonObject scenarios;
+        for (const auto& result : m_results)
+            scenarios[result.name] = result.meanMs;
+
+        QJsonObject root;
+        root["schema"] = 1;
+        root["units"] = "ms";
+        root["scenarios"] = scenarios;
+
+        QFile file(m_baselinePath);
+        if (!file.open(QIODevice::WriteOnly))
+            return false;
+        file.write(QJsonDocument(root).toJson());
+        return true;
+    }
+
+    bool hasBaselines() const { return !m_baselines.isEmpty(); }
+
+private:
+    void loadBaselines() {
+        if (m_baselinePath.isEmpty())
+            return;
+        QFile file(m_baselinePath);
+        if (!file.open(QIODevice::ReadOnly))
+            return;
+        QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+        QJsonObject scenarios = root["scenarios"].toObject();
+        for (auto it = scenarios.begin(); it != scenarios.end(); ++it)
+            m_baselines[it.key()] = it.value().toDouble();
+    }
+
+    // Two-sided 95% Student's t critical values for small sample counts;
+    // converges to the normal 1.96 for larger ones
+    static double tValue95(int degreesOfFreedom) {
+        static const double table[] = {12.706, 4.303, 3.182, 2.776, 2.571,
+                                       2.447,  2.365, 2.306, 2.262, 2.228};
+        if (degreesOfFreedom < 1)
+            return 12.706;
+        if (degreesOfFreedom <= 10)
+            return table[degreesOfFreedom - 1];
+        return 1.96;
+    }
+
+    QString m_baselinePath;
+    QMap<QString, double> m_baselines;
+    QList<ScenarioResult> m_results;
+};
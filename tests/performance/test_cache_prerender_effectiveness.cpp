@@ -0,0 +1,339 @@
+#include <poppler-qt6.h>
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
+#include <QStandardPaths>
+#include <QtTest/QtTest>
+#include <algorithm>
+#include "../../app/cache/PDFCacheManager.h"
+#include "../../app/ui/viewer/PDFPrerenderer.h"
+
+// Benchmarks the cache+prerenderer stack under recorded navigation traces
+// (sequential read, skim, outline jumps) and reports hit ratio, wasted
+// prerenders and P50/P99 page-visible latency so strategies can be compared
+// between releases.
+class TestCachePrerenderEffectiveness : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testSequentialReadTrace();
+    void testSkimTrace();
+    void testOutlineJumpTrace();
+    void generateEffectivenessReport();
+
+private:
+    struct TraceMetrics {
+        QString traceName;
+        int pageVisits;
+        int cacheHits;
+        double hitRatio;
+        int prerendersIssued;
+        int wastedPrerenders;
+        qint64 p50LatencyUs;
+        qint64 p99LatencyUs;
+    };
+
+    Poppler::Document* createTestDocument(int numPages);
+    QList<int> sequentialTrace() const;
+    QList<int> skimTrace() const;
+    QList<int> outlineJumpTrace() const;
+    TraceMetrics replayTrace(const QString& name, const QList<int>& trace);
+    static qint64 percentile(QList<qint64> sorted, double p);
+    void saveReportToFile() const;
+
+    static constexpr int PAGE_COUNT = 40;
+    static constexpr double SCALE = 1.0;
+
+    Poppler::Document* m_document = nullptr;
+    PDFCacheManager* m_cache = nullptr;
+    PDFPrerenderer* m_prerenderer = nullptr;
+    QList<TraceMetrics> m_allMetrics;
+};
+
+void TestCachePrerenderEffectiveness::initTestCase() {
+    m_document = createTestDocument(PAGE_COUNT);
+    QVERIFY(m_document != nullptr);
+    QCOMPARE(m_document->numPages(), PAGE_COUNT);
+
+    m_cache = new PDFCacheManager(this);
+    m_prerenderer = new PDFPrerenderer(this);
+    m_prerenderer->setDocument(m_document);
+
+    qDebug() << "Effectiveness benchmark initialized with" << PAGE_COUNT
+             << "pages";
+}
+
+void TestCachePrerenderEffectiveness::cleanupTestCase() {
+    m_prerenderer->stopPrerendering();
+    delete m_document;
+}
+
+Poppler::Document* TestCachePrerenderEffectiveness::createTestDocument(
+    int numPages) {
+    QString testPdfPath =
+        QStandardPaths::writableLocation(QStandardPaths::TempLocation) +
+        "/cache_prerender_test.pdf";
+
+    QFile file(testPdfPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return nullptr;
+    }
+
+    QByteArray pdfContent = "%PDF-1.4\n";
+    pdfContent += "1 0 obj\n<<\n/Type /Catalog\n/Pages 2 0 R\n>>\nendobj\n";
+
+    pdfContent += "2 0 obj\n<<\n/Type /Pages\n/Kids [";
+    for (int i = 0; i < numPages; ++i) {
+        pdfContent += QString("%1 0 R ").arg(3 + i * 2).toUtf8();
+    }
+    pdfContent += QString("]\n/Count %1\n>>\nendobj\n").arg(numPages).toUtf8();
+
+    int objNum = 3;
+    for (int page = 0; page < numPages; ++page) {
+        pdfContent +=
+            QString(
+                "%1 0 obj\n<<\n/Type /Page\n/Parent 2 0 R\n/MediaBox [0 0 "
+                "612 792]\n/Contents %2 0 R\n>>\nendobj\n")
+                .arg(objNum)
+                .arg(objNum + 1)
+                .toUtf8();
+
+        QString content = QString("BT\n/F1 12 Tf\n");
+        for (int line = 0; line < 20; ++line) {
+            content += QString("50 %1 Td\n(Page %2 Line %3) Tj\n")
+                           .arg(750 - line * 30)
+                           .arg(page + 1)
+                           .arg(line + 1);
+        }
+        content += "ET\n";
+
+        pdfContent += QString(
+                          "%1 0 obj\n<<\n/Length "
+                          "%2\n>>\nstream\n%3endstream\nendobj\n")
+                          .arg(objNum + 1)
+                          .arg(content.length())
+                          .arg(content)
+                          .toUtf8();
+        objNum += 2;
+    }
+
+    int xrefPos = pdfContent.length();
+    pdfContent += QString("xref\n0 %1\n").arg(objNum).toUtf8();
+    pdfContent += "0000000000 65535 f \n";
+    for (int i = 1; i < objNum; ++i) {
+        pdfContent +=
+            QString("%1 00000 n \n").arg(i * 100, 10, 10, QChar('0')).toUtf8();
+    }
+    pdfContent += QString(
+                      "trailer\n<<\n/Size %1\n/Root 1 0 "
+                      "R\n>>\nstartxref\n%2\n%%EOF\n")
+                      .arg(objNum)
+                      .arg(xrefPos)
+                      .toUtf8();
+
+    file.write(pdfContent);
+    file.close();
+
+    return Poppler::Document::load(testPdfPath).release();
+}
+
+// 顺序阅读：从头到尾逐页翻阅
+QList<int> TestCachePrerenderEffectiveness::sequentialTrace() const {
+    QList<int> trace;
+    for (int i = 0; i < PAGE_COUNT; ++i) {
+        trace.append(i);
+    }
+    return trace;
+}
+
+// 快速浏览：每隔几页跳一次，偶尔回看上一页
+QList<int> TestCachePrerenderEffectiveness::skimTrace() const {
+    QList<int> trace;
+    for (int i = 0; i < PAGE_COUNT; i += 3) {
+        trace.append(i);
+        if (i % 9 == 6 && i > 0) {
+            trace.append(i - 1);  // 回看
+            trace.append(i);
+        }
+    }
+    return trace;
+}
+
+// 目录跳转：在固定的章节起始页之间跳转（确定性序列，便于版本间比较）
+QList<int> TestCachePrerenderEffectiveness::outlineJumpTrace() const {
+    const QList<int> sectionStarts = {0, 12, 25, 5, 33, 12, 38, 0, 25};
+    QList<int> trace;
+    for (int start : sectionStarts) {
+        trace.append(start);
+        trace.append(qMin(start + 1, PAGE_COUNT - 1));  // 章节内翻一页
+    }
+    return trace;
+}
+
+TestCachePrerenderEffectiveness::TraceMetrics
+TestCachePrerenderEffectiveness::replayTrace(const QString& name,
+                                             const QList<int>& trace) {
+    m_cache->clear();
+    m_cache->resetStatistics();
+    m_prerenderer->stopPrerendering();
+    m_prerenderer->startPrerendering();
+
+    QSet<int> prerenderRequested;
+    QSet<int> visited;
+    QList<qint64> latenciesUs;
+    int cacheHits = 0;
+    int previousPage = -1;
+
+    for (int pageNum : trace) {
+        QElapsedTimer timer;
+        timer.start();
+
+        // 页面可见延迟：命中任一缓存层即为命中，否则同步渲染
+        QImage image = m_prerenderer->getCachedPage(pageNum, SCALE, 0);
+        if (image.isNull()) {
+            QPixmap cached = m_cache->getRenderedPage(pageNum, SCALE);
+            if (!cached.isNull()) {
+                image = cached.toImage();
+            }
+        }
+
+        if (!image.isNull()) {
+            cacheHits++;
+        } else {
+            std::unique_ptr<Poppler::Page> page(m_document->page(pageNum));
+            QVERIFY(page != nullptr);
+            image = page->renderToImage(72.0 * SCALE, 72.0 * SCALE);
+            m_cache->cacheRenderedPage(pageNum, QPixmap::fromImage(image),
+                                       SCALE);
+        }
+        latenciesUs.append(timer.nsecsElapsed() / 1000);
+
+        visited.insert(pageNum);
+
+        // 模拟真实导航反馈，驱动预渲染器的预测
+        if (previousPage >= 0) {
+            m_prerenderer->recordNavigationPattern(previousPage, pageNum);
+        }
+        m_prerenderer->recordPageView(pageNum, 200);
+        for (int ahead = 1; ahead <= 2; ++ahead) {
+            int candidate = pageNum + ahead;
+            if (candidate < PAGE_COUNT && !visited.contains(candidate)) {
+                m_prerenderer->requestPrerender(candidate, SCALE, 0, ahead);
+                prerenderRequested.insert(candidate);
+            }
+        }
+        previousPage = pageNum;
+
+        // 给后台渲染一个追赶的机会，近似用户的阅读停顿
+        QTest::qWait(30);
+    }
+
+    // 等待队列清空后统计浪费的预渲染
+    QTest::qWait(200);
+    int wasted = 0;
+    for (int pageNum : prerenderRequested) {
+        if (!visited.contains(pageNum) &&
+            m_prerenderer->hasPrerenderedPage(pageNum, SCALE, 0)) {
+            wasted++;
+        }
+    }
+
+    QList<qint64> sorted = latenciesUs;
+    std::sort(sorted.begin(), sorted.end());
+
+    TraceMetrics metrics;
+    metrics.traceName = name;
+    metrics.pageVisits = trace.size();
+    metrics.cacheHits = cacheHits;
+    metrics.hitRatio =
+        trace.isEmpty() ? 0.0 : double(cacheHits) / trace.size();
+    metrics.prerendersIssued = prerenderRequested.size();
+    metrics.wastedPrerenders = wasted;
+    metrics.p50LatencyUs = percentile(sorted, 0.50);
+    metrics.p99LatencyUs = percentile(sorted, 0.99);
+
+    qDebug() << name << "- visits:" << metrics.pageVisits
+             << "hit ratio:" << metrics.hitRatio
+             << "wasted prerenders:" << metrics.wastedPrerenders
+             << "P50:" << metrics.p50LatencyUs << "us"
+             << "P99:" << metrics.p99LatencyUs << "us";
+
+    return metrics;
+}
+
+qint64 TestCachePrerenderEffectiveness::percentile(QList<qint64> sorted,
+                                                   double p) {
+    if (sorted.isEmpty()) {
+        return 0;
+    }
+    int index = int(p * (sorted.size() - 1) + 0.5);
+    return sorted[qBound(0, index, int(sorted.size()) - 1)];
+}
+
+void TestCachePrerenderEffectiveness::testSequentialReadTrace() {
+    TraceMetrics metrics = replayTrace("sequential_read", sequentialTrace());
+    m_allMetrics.append(metrics);
+
+    QCOMPARE(metrics.pageVisits, PAGE_COUNT);
+    QVERIFY(metrics.p50LatencyUs >= 0);
+}
+
+void TestCachePrerenderEffectiveness::testSkimTrace() {
+    TraceMetrics metrics = replayTrace("skim", skimTrace());
+    m_allMetrics.append(metrics);
+
+    QVERIFY(metrics.pageVisits > 0);
+}
+
+void TestCachePrerenderEffectiveness::testOutlineJumpTrace() {
+    TraceMetrics metrics = replayTrace("outline_jump", outlineJumpTrace());
+    m_allMetrics.append(metrics);
+
+    QVERIFY(metrics.pageVisits > 0);
+}
+
+void TestCachePrerenderEffectiveness::generateEffectivenessReport() {
+    QVERIFY(!m_allMetrics.isEmpty());
+    saveReportToFile();
+}
+
+void TestCachePrerenderEffectiveness::saveReportToFile() const {
+    QJsonArray traces;
+    for (const TraceMetrics& m : m_allMetrics) {
+        QJsonObject obj;
+        obj["trace"] = m.traceName;
+        obj["page_visits"] = m.pageVisits;
+        obj["cache_hits"] = m.cacheHits;
+        obj["hit_ratio"] = m.hitRatio;
+        obj["prerenders_issued"] = m.prerendersIssued;
+        obj["wasted_prerenders"] = m.wastedPrerenders;
+        obj["p50_latency_us"] = double(m.p50LatencyUs);
+        obj["p99_latency_us"] = double(m.p99LatencyUs);
+        traces.append(obj);
+    }
+
+    QJsonObject report;
+    report["benchmark"] = "cache_prerender_effectiveness";
+    report["page_count"] = PAGE_COUNT;
+    report["traces"] = traces;
+
+    QString reportPath =
+        QStandardPaths::writableLocation(QStandardPaths::TempLocation) +
+        "/cache_prerender_effectiveness.json";
+    QFile file(reportPath);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(report).toJson());
+        file.close();
+        qDebug() << "Effectiveness report saved to" << reportPath;
+    }
+}
+
+QTEST_MAIN(TestCachePrerenderEffectiveness)
+#include "test_cache_prerender_effectiveness.moc"
@@ -0,0 +1,378 @@
+#include <poppler-qt6.h>
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QEventLoop>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QScrollArea>
+#include <QScrollBar>
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTimer>
+#include <QtTest/QtTest>
+#include "../../app/model/DocumentModel.h"
+#include "../../app/ui/viewer/PDFViewer.h"
+#include "PerfRegressionHarness.h"
+
+// End-to-end open-path benchmark: time from "open this file" to a
+// scrollable first page, measured through the same pipeline MainWindow
+// wires together (AsyncDocumentLoader -> DocumentModel -> PDFViewer).
+// The existing rendering benchmark times isolated Poppler renders; this
+// one covers everything in between - async load, model bookkeeping,
+// widget setup, first paint, and the event-loop backlog the render
+// deliveries create - which is where open-path regressions actually
+// surface for the user.
+//
+// Two headline scenarios per corpus document go through the regression
+// harness (open_to_first_paint, open_to_interactive); the per-stage
+// breakdown (load / first paint / loop responsive / first scroll) is
+// averaged across the recorded runs and written to a JSON report for
+// dashboards and bisection.
+
+namespace {
+
+// Records the first paint event delivered to the watched widget tree.
+// Installed application-wide because paints land on the scroll area's
+// viewport and the page widgets, not on the viewer itself.
+class PaintProbe : public QObject {
+public:
+    QWidget* root = nullptr;
+    bool paintSeen = false;
+
+    void reset() { paintSeen = false; }
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override {
+        if (!paintSeen && root && event->type() == QEvent::Paint) {
+            QWidget* widget = qobject_cast<QWidget*>(watched);
+            if (widget && (widget == root || root->isAncestorOf(widget))) {
+                paintSeen = true;
+            }
+        }
+        return false;
+    }
+};
+
+// Time from posting a zero-length timer to its execution: how much
+// queued work sits in front of the next user input
+qint64 eventLoopLatencyMs() {
+    QElapsedTimer timer;
+    QEventLoop loop;
+    timer.start();
+    QTimer::singleShot(0, &loop, &QEventLoop::quit);
+    loop.exec();
+    return timer.elapsed();
+}
+
+}  // namespace
+
+class TestOpenToInteractive : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testOpenPathRegression();
+
+private:
+    struct StageBreakdown {
+        bool ok = false;
+        qint64 loadMs = 0;        // openFromFile -> documentOpened
+        qint64 firstPaintMs = 0;  // setDocument -> first paint delivered
+        qint64 responsiveMs = 0;  // first paint -> loop latency in budget
+        qint64 scrollMs = 0;      // scroll issued -> repaint delivered
+    };
+
+    QString writeTextPdf(const QString& fileName, int numPages);
+    StageBreakdown openCycle(const QString& path, bool untilInteractive);
+    void saveBreakdownReport() const;
+
+    // The loop counts as interactive once a queued callback is serviced
+    // within two 60Hz frames - the same budget the GUI watchdog uses
+    static constexpr qint64 RESPONSIVE_BUDGET_MS = 32;
+    static constexpr int STAGE_TIMEOUT_MS = 15000;
+    static constexpr int RUNS = 5;
+
+    QString m_shortDocPath;  // typical article
+    QString m_longDocPath;   // stresses layout and prerender fan-out
+    QMap<QString, StageBreakdown> m_breakdownTotals;
+    QMap<QString, int> m_breakdownCounts;
+};
+
+void TestOpenToInteractive::initTestCase() {
+    m_shortDocPath = writeTextPdf("open_bench_short.pdf", 12);
+    m_longDocPath = writeTextPdf("open_bench_long.pdf", 120);
+    QVERIFY(!m_shortDocPath.isEmpty());
+    QVERIFY(!m_longDocPath.isEmpty());
+}
+
+void TestOpenToInteractive::cleanupTestCase() {
+    QFile::remove(m_shortDocPath);
+    QFile::remove(m_longDocPath);
+}
+
+// Minimal multi-page text PDF, same simplified structure the other
+// performance tests generate (Poppler reconstructs the xref table)
+QString TestOpenToInteractive::writeTextPdf(const QString& fileName,
+                                            int numPages) {
+    QString path =
+        QStandardPaths::writableLocation(QStandardPaths::TempLocation) + "/" +
+        fileName;
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return QString();
+    }
+
+    QByteArray pdf = "%PDF-1.4\n";
+    pdf += "1 0 obj\n<<\n/Type /Catalog\n/Pages 2 0 R\n>>\nendobj\n";
+
+    pdf += "2 0 obj\n<<\n/Type /Pages\n/Kids [";
+    for (int i = 0; i < numPages; ++i) {
+        pdf += QString("%1 0 R ").arg(3 + i * 2).toUtf8();
+    }
+    pdf += QString("]\n/Count %1\n>>\nendobj\n").arg(numPages).toUtf8();
+
+    int objNum = 3;
+    for (int page = 0; page < numPages; ++page) {
+        pdf += QString(
+                   "%1 0 obj\n<<\n/Type /Page\n/Parent 2 0 R\n/MediaBox [0 0 "
+                   "612 792]\n/Resources << /Font << /F1 << /Type /Font "
+                   "/Subtype /Type1 /BaseFont /Helvetica >> >> >>\n/Contents "
+                   "%2 0 R\n>>\nendobj\n")
+                   .arg(objNum)
+                   .arg(objNum + 1)
+                   .toUtf8();
+
+        QByteArray content = "BT\n/F1 10 Tf\n";
+        for (int line = 0; line < 40; ++line) {
+            content += QString(
+                           "1 0 0 1 50 %1 Tm\n(Open benchmark page %2 line "
+                           "%3) Tj\n")
+                           .arg(760 - line * 18)
+                           .arg(page + 1)
+                           .arg(line + 1)
+                           .toUtf8();
+        }
+        content += "ET\n";
+
+        pdf += QString("%1 0 obj\n<<\n/Length %2\n>>\nstream\n")
+                   .arg(objNum + 1)
+                   .arg(content.size())
+                   .toUtf8();
+        pdf += content;
+        pdf += "\nendstream\nendobj\n";
+        objNum += 2;
+    }
+
+    int xrefPos = pdf.length();
+    pdf += QString("xref\n0 %1\n").arg(objNum).toUtf8();
+    pdf += "0000000000 65535 f \n";
+    for (int i = 1; i < objNum; ++i) {
+        pdf += QString("%1 00000 n \n").arg(i * 100, 10, 10, QChar('0'))
+                   .toUtf8();
+    }
+    pdf += QString(
+               "trailer\n<<\n/Size %1\n/Root 1 0 "
+               "R\n>>\nstartxref\n%2\n%%EOF\n")
+               .arg(objNum)
+               .arg(xrefPos)
+               .toUtf8();
+
+    file.write(pdf);
+    file.close();
+    return path;
+}
+
+// One full open cycle with fresh model and viewer, torn down at the
+// end so every run re-opens from scratch. Widget construction and
+// teardown are deliberately inside the measured body: both happen on
+// a real open, and a regression in either is still a regression.
+TestOpenToInteractive::StageBreakdown TestOpenToInteractive::openCycle(
+    const QString& path, bool untilInteractive) {
+    StageBreakdown breakdown;
+
+    DocumentModel model;
+    PDFViewer viewer(nullptr, false);
+    // Small enough that a page overflows the viewport, so the scroll
+    // stage moves real content
+    viewer.resize(600, 400);
+
+    QElapsedTimer stage;
+    stage.start();
+
+    // Stage 1: async load until the handle is registered
+    QSignalSpy openedSpy(&model, &DocumentModel::documentOpened);
+    model.openFromFile(path);
+    if (!QTest::qWaitFor([&]() { return openedSpy.count() > 0; },
+                         STAGE_TIMEOUT_MS)) {
+        return breakdown;
+    }
+    breakdown.loadMs = stage.restart();
+
+    // Stage 2: hand the document to the viewer and wait for the first
+    // paint to reach the widget tree
+    PaintProbe probe;
+    probe.root = &viewer;
+    qApp->installEventFilter(&probe);
+    viewer.show();
+    viewer.setDocument(model.getCurrentDocument());
+    const bool painted = QTest::qWaitFor([&]() { return probe.paintSeen; },
+                                         STAGE_TIMEOUT_MS);
+    breakdown.firstPaintMs = stage.restart();
+    if (!painted) {
+        qApp->removeEventFilter(&probe);
+        return breakdown;
+    }
+
+    if (untilInteractive) {
+        // Stage 3: the loop is interactive once the backlog of render
+        // deliveries drains enough for a queued callback to run inside
+        // the frame budget
+        QElapsedTimer deadline;
+        deadline.start();
+        while (eventLoopLatencyMs() > RESPONSIVE_BUDGET_MS &&
+               deadline.elapsed() < STAGE_TIMEOUT_MS) {
+        }
+        breakdown.responsiveMs = stage.restart();
+
+        // Stage 4: first scroll serviced - content moves and repaints
+        probe.reset();
+        QScrollBar* scrollBar = nullptr;
+        const auto areas = viewer.findChildren<QScrollArea*>();
+        for (QScrollArea* area : areas) {
+            if (area->isVisible() &&
+                area->verticalScrollBar()->maximum() > 0) {
+                scrollBar = area->verticalScrollBar();
+                break;
+            }
+        }
+        if (scrollBar) {
+            scrollBar->setValue(scrollBar->value() + 200);
+        } else {
+            viewer.goToPage(1);  // single-page fallback
+        }
+        if (!QTest::qWaitFor([&]() { return probe.paintSeen; },
+                             STAGE_TIMEOUT_MS)) {
+            qApp->removeEventFilter(&probe);
+            return breakdown;
+        }
+        breakdown.scrollMs = stage.restart();
+    }
+
+    qApp->removeEventFilter(&probe);
+    model.closeCurrentDocument();
+    breakdown.ok = true;
+    return breakdown;
+}
+
+void TestOpenToInteractive::testOpenPathRegression() {
+    struct CorpusEntry {
+        QString name;
+        QString path;
+    };
+    const QList<CorpusEntry> corpus = {
+        {"short", m_shortDocPath},
+        {"long", m_longDocPath},
+    };
+
+    QString baselinePath =
+        QFINDTESTDATA("baselines/open_to_interactive_baselines.json");
+    PerfRegressionHarness harness(baselinePath);
+    if (!harness.hasBaselines()) {
+        qWarning() << "No open-path baselines found - recording measurements "
+                      "only, no pass/fail verdict";
+    }
+
+    for (const auto& entry : corpus) {
+        bool allOk = true;
+
+        auto paintResult = harness.measure(
+            "open_to_first_paint_" + entry.name,
+            [&]() { allOk = openCycle(entry.path, false).ok && allOk; },
+            RUNS);
+        QVERIFY2(allOk, qPrintable("Open cycle stalled for " + entry.name));
+
+        auto interactiveResult = harness.measure(
+            "open_to_interactive_" + entry.name,
+            [&]() {
+                StageBreakdown breakdown = openCycle(entry.path, true);
+                allOk = breakdown.ok && allOk;
+                StageBreakdown& total = m_breakdownTotals[entry.name];
+                total.loadMs += breakdown.loadMs;
+                total.firstPaintMs += breakdown.firstPaintMs;
+                total.responsiveMs += breakdown.responsiveMs;
+                total.scrollMs += breakdown.scrollMs;
+                m_breakdownCounts[entry.name]++;
+            },
+            RUNS);
+        QVERIFY2(allOk, qPrintable("Open cycle stalled for " + entry.name));
+
+        const int count = m_breakdownCounts.value(entry.name, 1);
+        const StageBreakdown& total = m_breakdownTotals[entry.name];
+        qDebug() << qPrintable(entry.name)
+                 << "open_to_first_paint:" << paintResult.meanMs << "ms ±"
+                 << paintResult.ciHalfWidthMs
+                 << "| open_to_interactive:" << interactiveResult.meanMs
+                 << "ms ±" << interactiveResult.ciHalfWidthMs;
+        qDebug() << qPrintable(entry.name)
+                 << "stage breakdown (avg): load" << total.loadMs / count
+                 << "ms, first paint" << total.firstPaintMs / count
+                 << "ms, loop responsive" << total.responsiveMs / count
+                 << "ms, first scroll" << total.scrollMs / count << "ms";
+    }
+
+    saveBreakdownReport();
+
+    QString reportPath =
+        QStandardPaths::writableLocation(QStandardPaths::TempLocation) +
+        "/open_to_interactive_report.json";
+    harness.writeReport(reportPath);
+    qDebug() << "Regression report saved to:" << reportPath;
+
+    if (harness.updateBaselinesIfRequested()) {
+        qDebug() << "Baselines rewritten at" << baselinePath
+                 << "- commit the updated file";
+        return;
+    }
+
+    QVERIFY2(!harness.hasRegressions(),
+             qPrintable(harness.regressionSummary()));
+}
+
+void TestOpenToInteractive::saveBreakdownReport() const {
+    QJsonArray documents;
+    for (auto it = m_breakdownTotals.constBegin();
+         it != m_breakdownTotals.constEnd(); ++it) {
+        const int count = m_breakdownCounts.value(it.key(), 1);
+        QJsonObject obj;
+        obj["document"] = it.key();
+        obj["runs"] = count;
+        obj["avgLoadMs"] = double(it->loadMs) / count;
+        obj["avgFirstPaintMs"] = double(it->firstPaintMs) / count;
+        obj["avgResponsiveMs"] = double(it->responsiveMs) / count;
+        obj["avgScrollMs"] = double(it->scrollMs) / count;
+        documents.append(obj);
+    }
+
+    QJsonObject report;
+    report["benchmark"] = "open_to_interactive_stages";
+    report["responsiveBudgetMs"] = double(RESPONSIVE_BUDGET_MS);
+    report["documents"] = documents;
+
+    QString path =
+        QStandardPaths::writableLocation(QStandardPaths::TempLocation) +
+        "/open_to_interactive_stages.json";
+    QFile file(path);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(report).toJson());
+        qDebug() << "Stage breakdown saved to:" << path;
+    }
+}
+
+QTEST_MAIN(TestOpenToInteractive)
+#include "test_open_to_interactive.moc"
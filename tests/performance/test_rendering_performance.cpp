@@ -7,7 +7,9 @@
 #include <QProcess>
 #include <QStandardPaths>
 #include <QtTest/QtTest>
+#include <memory>
 #include "../../app/ui/viewer/PDFViewer.h"
+#include "PerfRegressionHarness.h"
 
 #ifdef Q_OS_WIN
 // clang-format off
@@ -36,6 +38,7 @@ private slots:
     void testLargeDocumentHandling();
     void testConcurrentRendering();
     void testMemoryLeaks();
+    void testCorpusRenderRegression();
     void generatePerformanceReport();
 
 private:
@@ -48,6 +51,11 @@ private:
     };
 
     Poppler::Document* createLargeTestDocument();
+    QString writeCorpusPdf(const QString& fileName,
+                           const QList<QByteArray>& pageStreams);
+    QByteArray textHeavyPageStream(int page);
+    QByteArray scannedPageStream(int page);
+    QByteArray vectorHeavyPageStream(int page);
     size_t getCurrentMemoryUsage();
     PerformanceMetrics measureRenderingPerformance(bool useQGraphics);
     PerformanceMetrics measureZoomPerformance(bool useQGraphics);
@@ -171,6 +179,133 @@ Poppler::Document* TestRenderingPerformance::createLargeTestDocument() {
     return nullptr;
 }
 
+// Assembles a minimal multi-page PDF from pre-built content streams.
+// Same simplified structure as createLargeTestDocument (Poppler
+// reconstructs the xref table), but takes raw byte streams so corpus
+// pages can contain binary inline-image data
+QString TestRenderingPerformance::writeCorpusPdf(
+    const QString& fileName, const QList<QByteArray>& pageStreams) {
+    QString path =
+        QStandardPaths::writableLocation(QStandardPaths::TempLocation) + "/" +
+        fileName;
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return QString();
+
+    QByteArray pdf = "%PDF-1.4\n";
+    pdf += "1 0 obj\n<<\n/Type /Catalog\n/Pages 2 0 R\n>>\nendobj\n";
+
+    const int numPages = pageStreams.size();
+    pdf += "2 0 obj\n<<\n/Type /Pages\n/Kids [";
+    for (int i = 0; i < numPages; ++i) {
+        pdf += QString("%1 0 R ").arg(3 + i * 2).toUtf8();
+    }
+    pdf += QString("]\n/Count %1\n>>\nendobj\n").arg(numPages).toUtf8();
+
+    int objNum = 3;
+    for (int page = 0; page < numPages; ++page) {
+        pdf += QString(
+                   "%1 0 obj\n<<\n/Type /Page\n/Parent 2 0 R\n/MediaBox [0 0 "
+                   "612 792]\n/Resources << /Font << /F1 << /Type /Font "
+                   "/Subtype /Type1 /BaseFont /Helvetica >> >> >>\n/Contents "
+                   "%2 0 R\n>>\nendobj\n")
+                   .arg(objNum)
+                   .arg(objNum + 1)
+                   .toUtf8();
+
+        pdf += QString("%1 0 obj\n<<\n/Length %2\n>>\nstream\n")
+                   .arg(objNum + 1)
+                   .arg(pageStreams[page].size())
+                   .toUtf8();
+        pdf += pageStreams[page];
+        pdf += "\nendstream\nendobj\n";
+
+        objNum += 2;
+    }
+
+    int xrefPos = pdf.length();
+    pdf += QString("xref\n0 %1\n").arg(objNum).toUtf8();
+    pdf += "0000000000 65535 f \n";
+    for (int i = 1; i < objNum; ++i) {
+        pdf += QString("%1 00000 n \n").arg(i * 100, 10, 10, QChar('0'))
+                   .toUtf8();
+    }
+    pdf += QString(
+               "trailer\n<<\n/Size %1\n/Root 1 0 "
+               "R\n>>\nstartxref\n%2\n%%EOF\n")
+               .arg(objNum)
+               .arg(xrefPos)
+               .toUtf8();
+
+    file.write(pdf);
+    file.close();
+    return path;
+}
+
+// Dense flowing text: exercises glyph rasterization and text layout
+QByteArray TestRenderingPerformance::textHeavyPageStream(int page) {
+    QByteArray content = "BT\n/F1 9 Tf\n";
+    for (int line = 0; line < 60; ++line) {
+        content += QString(
+                       "1 0 0 1 40 %1 Tm\n(Corpus page %2 line %3: the quick "
+                       "brown fox jumps over the lazy dog 0123456789) Tj\n")
+                       .arg(770 - line * 12)
+                       .arg(page + 1)
+                       .arg(line + 1)
+                       .toUtf8();
+    }
+    content += "ET\n";
+    return content;
+}
+
+// Full-page inline raster image of deterministic noise: stands in for
+// a scanned document and exercises the image decode/scale path
+QByteArray TestRenderingPerformance::scannedPageStream(int page) {
+    const int width = 64;
+    const int height = 64;
+    QByteArray pixels;
+    pixels.reserve(width * height * 3);
+    quint32 seed = 0x9E3779B9u * quint32(page + 1);
+    for (int i = 0; i < width * height * 3; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        pixels.append(char(seed >> 24));
+    }
+
+    QByteArray content = "q\n612 0 0 792 0 0 cm\n";
+    content += QString("BI /W %1 /H %2 /CS /RGB /BPC 8 ID ")
+                   .arg(width)
+                   .arg(height)
+                   .toUtf8();
+    content += pixels;
+    content += "\nEI\nQ\n";
+    return content;
+}
+
+// Thousands of small fills and strokes: exercises the path
+// rasterization that dominates CAD drawings and dense charts
+QByteArray TestRenderingPerformance::vectorHeavyPageStream(int page) {
+    QByteArray content = "0.3 w\n";
+    quint32 seed = 0x85EBCA6Bu * quint32(page + 1);
+    for (int i = 0; i < 2500; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        int x = seed % 600;
+        seed = seed * 1664525u + 1013904223u;
+        int y = seed % 780;
+        if (i % 2 == 0) {
+            content += QString("%1 %2 6 6 re f\n").arg(x).arg(y).toUtf8();
+        } else {
+            content += QString("%1 %2 m %3 %4 l S\n")
+                           .arg(x)
+                           .arg(y)
+                           .arg(x + 8)
+                           .arg(y + 8)
+                           .toUtf8();
+        }
+    }
+    return content;
+}
+
 size_t TestRenderingPerformance::getCurrentMemoryUsage() {
 #ifdef Q_OS_WIN
     PROCESS_MEMORY_COUNTERS pmc;
@@ -587,6 +722,79 @@ void TestRenderingPerformance::testMemoryLeaks() {
     QVERIFY(memoryIncrease < 50 * 1024 * 1024);
 }
 
+void TestRenderingPerformance::testCorpusRenderRegression() {
+    qDebug() << "=== Corpus Render Regression Check ===";
+
+    // Fixed corpus of representative documents: flowing text, scanned
+    // raster pages and dense vector art exercise different Poppler code
+    // paths, so a regression in any one shows up even when the others
+    // are unaffected
+    const int corpusPages = 6;
+    QList<QByteArray> textPages, scannedPages, vectorPages;
+    for (int page = 0; page < corpusPages; ++page) {
+        textPages.append(textHeavyPageStream(page));
+        scannedPages.append(scannedPageStream(page));
+        vectorPages.append(vectorHeavyPageStream(page));
+    }
+
+    struct CorpusEntry {
+        QString scenario;
+        QString path;
+    };
+    const QList<CorpusEntry> corpus = {
+        {"render_text_heavy",
+         writeCorpusPdf("corpus_text_heavy.pdf", textPages)},
+        {"render_scanned", writeCorpusPdf("corpus_scanned.pdf", scannedPages)},
+        {"render_vector_heavy",
+         writeCorpusPdf("corpus_vector_heavy.pdf", vectorPages)},
+    };
+
+    QString baselinePath = QFINDTESTDATA("baselines/rendering_baselines.json");
+    PerfRegressionHarness harness(baselinePath);
+    if (!harness.hasBaselines()) {
+        qWarning() << "No render baselines found - recording measurements "
+                      "only, no pass/fail verdict";
+    }
+
+    for (const auto& entry : corpus) {
+        QVERIFY2(!entry.path.isEmpty(), "Failed to write corpus document");
+        auto document = Poppler::Document::load(entry.path);
+        QVERIFY2(document != nullptr,
+                 qPrintable("Failed to load " + entry.path));
+        document->setRenderHint(Poppler::Document::Antialiasing);
+        document->setRenderHint(Poppler::Document::TextAntialiasing);
+
+        auto result = harness.measure(entry.scenario, [&]() {
+            for (int page = 0; page < document->numPages(); ++page) {
+                std::unique_ptr<Poppler::Page> pdfPage(document->page(page));
+                if (pdfPage) {
+                    pdfPage->renderToImage(150, 150);
+                }
+            }
+        });
+
+        qDebug() << qPrintable(result.name) << "mean:" << result.meanMs
+                 << "ms ±" << result.ciHalfWidthMs << "ms over" << result.runs
+                 << "runs, baseline:" << result.baselineMs << "ms"
+                 << (result.regressed ? "REGRESSED" : "");
+    }
+
+    QString reportPath =
+        QStandardPaths::writableLocation(QStandardPaths::TempLocation) +
+        "/render_regression_report.json";
+    harness.writeReport(reportPath);
+    qDebug() << "Regression report saved to:" << reportPath;
+
+    if (harness.updateBaselinesIfRequested()) {
+        qDebug() << "Baselines rewritten at" << baselinePath
+                 << "- commit the updated file";
+        return;
+    }
+
+    QVERIFY2(!harness.hasRegressions(),
+             qPrintable(harness.regressionSummary()));
+}
+
 void TestRenderingPerformance::generatePerformanceReport() {
     qDebug() << "=== Performance Test Summary ===";
 